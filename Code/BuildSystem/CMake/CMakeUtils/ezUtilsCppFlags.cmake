@@ -71,6 +71,10 @@ function(ez_set_build_flags_msvc TARGET_NAME)
 		target_compile_options(${TARGET_NAME} PRIVATE "/arch:SSE2")
 	endif()
 
+	if(EZ_ENABLE_AVX2 AND EZ_CMAKE_ARCHITECTURE_X86)
+		target_compile_options(${TARGET_NAME} PRIVATE "/arch:AVX2")
+	endif()
+
 	# /Zo: Improved debugging of optimized code
 	target_compile_options(${TARGET_NAME} PRIVATE "$<$<CONFIG:${EZ_BUILDTYPENAME_RELEASE_UPPER}>:/Zo>")
 	target_compile_options(${TARGET_NAME} PRIVATE "$<$<CONFIG:${EZ_BUILDTYPENAME_DEV_UPPER}>:/Zo>")
@@ -174,6 +178,11 @@ function(ez_set_build_flags_clang TARGET_NAME)
 
 	if(EZ_CMAKE_ARCHITECTURE_X86)
 		target_compile_options(${TARGET_NAME} PRIVATE "-msse4.1")
+
+		if(EZ_ENABLE_AVX2)
+			# Don't contract separate multiplies and adds into FMA instructions so results match the SSE and MSVC builds exactly.
+			target_compile_options(${TARGET_NAME} PRIVATE -mavx2 -mfma -mf16c -ffp-contract=off)
+		endif()
 	endif()
 
 	if(EZ_CMAKE_PLATFORM_LINUX)
@@ -257,6 +266,11 @@ function(ez_set_build_flags_gcc TARGET_NAME)
 
 	if(EZ_CMAKE_ARCHITECTURE_X86)
 		target_compile_options(${TARGET_NAME} PRIVATE -msse4.1)
+
+		if(EZ_ENABLE_AVX2)
+			# Don't contract separate multiplies and adds into FMA instructions so results match the SSE and MSVC builds exactly.
+			target_compile_options(${TARGET_NAME} PRIVATE -mavx2 -mfma -mf16c -ffp-contract=off)
+		endif()
 	endif()
 
 	# Disable warning: multi-character character constant
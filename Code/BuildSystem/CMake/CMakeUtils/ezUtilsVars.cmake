@@ -35,6 +35,13 @@ set(EZ_ENABLE_COMPILER_STATIC_ANALYSIS OFF CACHE BOOL "Enables static analysis i
 
 mark_as_advanced(FORCE EZ_ENABLE_COMPILER_STATIC_ANALYSIS)
 
+# #####################################
+# ## AVX2 support
+# #####################################
+set(EZ_ENABLE_AVX2 OFF CACHE BOOL "Compiles for CPUs with AVX2 and FMA. Enables the native 8-wide SIMD types. The binaries won't run on CPUs without these instruction sets.")
+
+mark_as_advanced(FORCE EZ_ENABLE_AVX2)
+
 # #####################################
 # ## vcpkg
 # #####################################
@@ -165,7 +165,7 @@ ezStatus ezProcGenGraphAssetDocument::WriteAsset(ezStreamWriter& inout_stream, c
   };
 
   {
-    chunk.BeginChunk("PlacementOutputs", 6);
+    chunk.BeginChunk("PlacementOutputs", 7);
 
     if (!bDebug)
     {
@@ -267,6 +267,17 @@ void ezProcGenGraphAssetDocument::UpdateAssetDocumentInfo(ezAssetDocumentInfo* p
         }
       }
 
+      ezUInt32 uiNumMeshes = typeAccessor.GetCount("InstancedMeshes");
+      for (ezUInt32 i = 0; i < uiNumMeshes; ++i)
+      {
+        ezVariant mesh = typeAccessor.GetValue("InstancedMeshes", i);
+        if (mesh.IsA<ezString>())
+        {
+          pInfo->m_PackageDependencies.Insert(mesh.Get<ezString>());
+          pInfo->m_ThumbnailDependencies.Insert(mesh.Get<ezString>());
+        }
+      }
+
       ezVariant colorGradient = typeAccessor.GetValue("ColorGradient");
       if (colorGradient.IsA<ezString>())
       {
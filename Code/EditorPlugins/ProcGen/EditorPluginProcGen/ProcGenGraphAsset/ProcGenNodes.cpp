@@ -124,6 +124,7 @@ EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezProcGen_PlacementOutput, 1, ezRTTIDefaultAlloc
   EZ_BEGIN_PROPERTIES
   {
     EZ_ARRAY_MEMBER_PROPERTY("Objects", m_ObjectsToPlace)->AddAttributes(new ezAssetBrowserAttribute("CompatibleAsset_Prefab")),
+    EZ_ARRAY_MEMBER_PROPERTY("InstancedMeshes", m_MeshesToPlace)->AddAttributes(new ezAssetBrowserAttribute("CompatibleAsset_Mesh_Static")),
     EZ_MEMBER_PROPERTY("Footprint", m_fFootprint)->AddAttributes(new ezDefaultValueAttribute(1.0f), new ezClampValueAttribute(0.0f, ezVariant())),
     EZ_MEMBER_PROPERTY("MinOffset", m_vMinOffset),
     EZ_MEMBER_PROPERTY("MaxOffset", m_vMaxOffset),
@@ -206,7 +207,10 @@ ezExpressionAST::Node* ezProcGen_PlacementOutput::GenerateExpressionASTNode(ezTe
     }
 
     pObjectIndex = out_ast.CreateUnaryOperator(ezExpressionAST::NodeType::Saturate, pObjectIndex);
-    pObjectIndex = out_ast.CreateBinaryOperator(ezExpressionAST::NodeType::Multiply, pObjectIndex, out_ast.CreateConstant(m_ObjectsToPlace.GetCount() - 1));
+    // instanced meshes replace the prefabs, if there are any
+    const ezUInt32 uiNumObjects = m_MeshesToPlace.IsEmpty() ? m_ObjectsToPlace.GetCount() : m_MeshesToPlace.GetCount();
+
+    pObjectIndex = out_ast.CreateBinaryOperator(ezExpressionAST::NodeType::Multiply, pObjectIndex, out_ast.CreateConstant(uiNumObjects - 1));
     pObjectIndex = out_ast.CreateBinaryOperator(ezExpressionAST::NodeType::Add, pObjectIndex, out_ast.CreateConstant(0.5f));
 
     out_ast.m_OutputNodes.PushBack(out_ast.CreateOutput({ezProcGenInternal::ExpressionOutputs::s_sOutObjectIndex, ezProcessingStream::DataType::Byte}, pObjectIndex));
@@ -244,6 +248,9 @@ void ezProcGen_PlacementOutput::Save(ezStreamWriter& inout_stream)
 
   // chunk version 5
   inout_stream << m_PlacementMode;
+
+  // chunk version 7
+  inout_stream.WriteArray(m_MeshesToPlace).IgnoreResult();
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -55,6 +55,7 @@ public:
   void Save(ezStreamWriter& inout_stream);
 
   ezHybridArray<ezString, 4> m_ObjectsToPlace;
+  ezHybridArray<ezString, 4> m_MeshesToPlace;
 
   float m_fFootprint = 1.0f;
 
@@ -2,12 +2,10 @@
 
 #include <EnginePluginScene/Baking/BakeSceneWorkerOp.h>
 
-#ifdef BUILDSYSTEM_ENABLE_EMBREE_SUPPORT
-
-#  include <BakingPlugin/BakingScene.h>
-#  include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
-#  include <Foundation/Utilities/Progress.h>
-#  include <ToolsFoundation/Document/DocumentManager.h>
+#include <BakingPlugin/BakingScene.h>
+#include <EditorEngineProcessFramework/EngineProcess/EngineProcessDocumentContext.h>
+#include <Foundation/Utilities/Progress.h>
+#include <ToolsFoundation/Document/DocumentManager.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezLongOpWorker_BakeScene, 1, ezRTTIDefaultAllocator<ezLongOpWorker_BakeScene>);
@@ -38,5 +36,3 @@ ezResult ezLongOpWorker_BakeScene::Execute(ezProgress& progress, ezStreamWriter&
 
   return EZ_SUCCESS;
 }
-
-#endif
@@ -6,6 +6,7 @@
 #include <Core/Interfaces/FrameCaptureInterface.h>
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Core/System/Window.h>
+#include <Core/Utils/Blackboard.h>
 #include <Foundation/Communication/GlobalEvent.h>
 #include <Foundation/Communication/Telemetry.h>
 #include <Foundation/Configuration/Singleton.h>
@@ -490,6 +491,8 @@ void ezGameApplicationBase::Run_AfterWorldUpdate()
     m_pGameState->AfterWorldUpdate();
   }
 
+  ezBlackboard::BroadcastPendingEntryEventsOfGlobalBlackboards();
+
   {
     ezGameApplicationExecutionEvent e;
     e.m_Type = ezGameApplicationExecutionEvent::Type::AfterWorldUpdates;
@@ -521,6 +524,8 @@ void ezGameApplicationBase::Run_Present() {}
 void ezGameApplicationBase::Run_FinishFrame()
 {
   ezTelemetry::PerFrameUpdate();
+  // picks up files that were added or removed at runtime, before resources get reloaded
+  ezFileSystem::UpdateAllDataDirectoryFileIndices();
   ezResourceManager::PerFrameUpdate();
   ezTaskSystem::FinishFrameTasks();
   ezFrameAllocator::Swap();
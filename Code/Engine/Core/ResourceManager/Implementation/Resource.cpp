@@ -4,6 +4,7 @@
 #include <Core/ResourceManager/ResourceManager.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <Foundation/System/StackTracer.h>
+#include <Foundation/Types/ScopeExit.h>
 
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezResource, 1, ezRTTINoAllocator)
@@ -142,6 +143,13 @@ void ezResource::CallUnloadData(Unload WhatToUnload)
   m_uiQualityLevelsLoadable = ld.m_uiQualityLevelsLoadable;
 }
 
+thread_local ezArrayPtr<const ezUInt8> g_CurrentlyUpdatingFileData;
+
+ezArrayPtr<const ezUInt8> ezResource::GetUpdateContentFileData()
+{
+  return g_CurrentlyUpdatingFileData;
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 thread_local const ezResource* g_pCurrentlyUpdatingContent = nullptr;
 
@@ -151,12 +159,16 @@ const ezResource* ezResource::GetCurrentlyUpdatingContent()
 }
 #endif
 
-void ezResource::CallUpdateContent(ezStreamReader* Stream)
+void ezResource::CallUpdateContent(ezStreamReader* Stream, ezArrayPtr<const ezUInt8> fileData)
 {
   EZ_PROFILE_SCOPE("CallUpdateContent");
 
   EZ_LOG_BLOCK("ezResource::UpdateContent", GetResourceID().GetData());
 
+  const ezArrayPtr<const ezUInt8> previousFileData = g_CurrentlyUpdatingFileData;
+  g_CurrentlyUpdatingFileData = fileData;
+  EZ_SCOPE_EXIT(g_CurrentlyUpdatingFileData = previousFileData);
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   const ezResource* pPreviouslyUpdatingContent = g_pCurrentlyUpdatingContent;
   g_pCurrentlyUpdatingContent = this;
@@ -8,10 +8,47 @@
 #include <Foundation/IO/OSFile.h>
 #include <Foundation/Profiling/Profiling.h>
 
+/// Reads the data that the loader prepended (the file path) and then the file content directly from the memory-mapped file.
+class ezMappedFileResourceStreamReader : public ezStreamReader
+{
+public:
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    ezUInt64 uiBytesRead = m_Prefix.ReadBytes(pReadBuffer, uiBytesToRead);
+
+    if (uiBytesRead < uiBytesToRead)
+    {
+      void* pContentBuffer = pReadBuffer != nullptr ? ezMemoryUtils::AddByteOffset(pReadBuffer, static_cast<ptrdiff_t>(uiBytesRead)) : nullptr;
+      uiBytesRead += m_Content.ReadBytes(pContentBuffer, uiBytesToRead - uiBytesRead);
+    }
+
+    return uiBytesRead;
+  }
+
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override
+  {
+    ezUInt64 uiBytesSkipped = m_Prefix.SkipBytes(uiBytesToSkip);
+
+    if (uiBytesSkipped < uiBytesToSkip)
+    {
+      uiBytesSkipped += m_Content.SkipBytes(uiBytesToSkip - uiBytesSkipped);
+    }
+
+    return uiBytesSkipped;
+  }
+
+  ezRawMemoryStreamReader m_Prefix;
+  ezRawMemoryStreamReader m_Content;
+};
+
 struct FileResourceLoadData
 {
   ezBlob m_Storage;
   ezRawMemoryStreamReader m_Reader;
+
+  // only used for files that are mapped into memory, the file stays open until the resource is done with the data
+  ezFileReader m_MappedFile;
+  ezMappedFileResourceStreamReader m_MappedReader;
 };
 
 ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pResource)
@@ -20,9 +57,14 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   ezResourceLoadData res;
 
-  ezFileReader File;
+  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+
+  ezFileReader& File = pData->m_MappedFile;
   if (File.Open(pResource->GetResourceID().GetData()).Failed())
+  {
+    EZ_DEFAULT_DELETE(pData);
     return res;
+  }
 
   res.m_sResourceDescription = File.GetFilePathRelative().GetData();
 
@@ -35,9 +77,10 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
 #endif
 
-  FileResourceLoadData* pData = EZ_DEFAULT_NEW(FileResourceLoadData);
+  const ezArrayPtr<const ezUInt8> mappedData = File.GetMappedFileData();
 
-  const ezUInt64 uiFileSize = File.GetFileSize();
+  // if the file data is already in memory, only the path is stored in the blob
+  const ezUInt64 uiFileSize = mappedData.IsEmpty() ? File.GetFileSize() : 0;
 
   const ezUInt64 uiBlobCapacity = uiFileSize + File.GetFilePathAbsolute().GetElementCount() + 8; // +8 for the string overhead
   pData->m_Storage.SetCountUninitialized(uiBlobCapacity);
@@ -51,10 +94,24 @@ ezResourceLoadData ezResourceLoaderFromFile::OpenDataStream(const ezResource* pR
 
   const ezUInt64 uiOffset = w.GetNumWrittenBytes();
 
-  File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+  if (!mappedData.IsEmpty())
+  {
+    pData->m_MappedReader.m_Prefix.Reset(pBlobPtr, uiOffset);
+    pData->m_MappedReader.m_Content.Reset(mappedData.GetPtr(), mappedData.GetCount());
+
+    res.m_pDataStream = &pData->m_MappedReader;
+    res.m_FileData = mappedData;
+  }
+  else
+  {
+    const ezUInt64 uiBytesRead = File.ReadBytes(pBlobPtr + uiOffset, uiFileSize);
+    File.Close();
+
+    pData->m_Reader.Reset(pBlobPtr, uiOffset + uiFileSize);
+    res.m_pDataStream = &pData->m_Reader;
+    res.m_FileData = ezArrayPtr<const ezUInt8>(pBlobPtr + uiOffset, static_cast<ezUInt32>(uiBytesRead));
+  }
 
-  pData->m_Reader.Reset(pBlobPtr, w.GetNumWrittenBytes() + uiFileSize);
-  res.m_pDataStream = &pData->m_Reader;
   res.m_pCustomLoaderData = pData;
 
   return res;
@@ -118,7 +118,7 @@ void ezResourceManagerWorkerUpdateContent::Execute()
   if (!m_LoaderData.m_sResourceDescription.IsEmpty())
     m_pResourceToLoad->SetResourceDescription(m_LoaderData.m_sResourceDescription);
 
-  m_pResourceToLoad->CallUpdateContent(m_LoaderData.m_pDataStream);
+  m_pResourceToLoad->CallUpdateContent(m_LoaderData.m_pDataStream, m_LoaderData.m_FileData);
 
   if (m_pResourceToLoad->m_uiQualityLevelsLoadable > 0)
   {
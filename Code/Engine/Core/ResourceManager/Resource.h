@@ -145,7 +145,7 @@ private:
   /// is going to be deleted afterwards.
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) = 0;
 
-  void CallUpdateContent(ezStreamReader* Stream);
+  void CallUpdateContent(ezStreamReader* Stream, ezArrayPtr<const ezUInt8> fileData = {});
 
   /// \brief Called whenever more data for the resource is available. The resource must read the stream to update it's data.
   ///
@@ -182,6 +182,12 @@ protected:
   /// \brief Used internally by the code injection macros
   void SetHasLoadingFallback(bool bHasLoadingFallback) { m_Flags.AddOrRemove(ezResourceFlags::ResourceHasFallback, bHasLoadingFallback); }
 
+  /// \brief May be called from within UpdateContent() to access the loaded file content in place, instead of reading it from the stream.
+  ///
+  /// See ezResourceLoadData::m_FileData. Returns an empty view, if the resource loader does not provide the data in memory.
+  /// The data is only valid until UpdateContent() returns.
+  static ezArrayPtr<const ezUInt8> GetUpdateContentFileData();
+
 private:
   template <typename ResourceType>
   friend class ezTypedResourceHandle;
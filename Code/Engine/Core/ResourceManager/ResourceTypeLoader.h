@@ -17,6 +17,12 @@ struct EZ_CORE_DLL ezResourceLoadData
   /// All loaded data should be stored in a memory stream. This stream reader allows the resource to read the memory stream.
   ezStreamReader* m_pDataStream = nullptr;
 
+  /// Optional read-only view of the loaded file content (without any additional data that the loader writes into m_pDataStream, such as the file path).
+  ///
+  /// ezResourceLoaderFromFile points this directly into the memory-mapped archive, if the file is stored uncompressed in an ezArchive.
+  /// Resources may use this data in place instead of reading it from m_pDataStream. It stays valid until the loader's CloseDataStream() is called.
+  ezArrayPtr<const ezUInt8> m_FileData;
+
   /// Custom loader data, e.g. a pointer to a custom memory block, that needs to be freed when the resource is done updating.
   void* m_pCustomLoaderData = nullptr;
 };
@@ -55,6 +61,8 @@ public:
 ///
 /// The loader will interpret the ezResource 'resource ID' as a path, read that full file into a memory stream.
 /// The file modification data is stored as well.
+/// Files that are stored uncompressed in a memory-mapped ezArchive are not copied, instead the stream reads directly from the mapped archive
+/// and ezResourceLoadData::m_FileData points to the mapped data. The file is kept open until CloseDataStream() is called.
 /// Resources that use this loader can update their data as if they were reading the file directly.
 class EZ_CORE_DLL ezResourceLoaderFromFile : public ezResourceTypeLoader
 {
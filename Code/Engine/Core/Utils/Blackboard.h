@@ -54,6 +54,16 @@ struct EZ_CORE_DLL ezBlackboardEntryFlags
 EZ_DECLARE_FLAGS_OPERATORS(ezBlackboardEntryFlags);
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_CORE_DLL, ezBlackboardEntryFlags);
 
+/// \brief A handle to a named entry of an ezBlackboard, see ezBlackboard::ResolveSlot().
+struct ezBlackboardSlot
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezUInt32 m_uiIndex = ezInvalidIndex;
+
+  bool IsValid() const { return m_uiIndex != ezInvalidIndex; }
+};
+
 
 /// \brief A blackboard is a key/value store that provides OnChange events to be informed when a value changes.
 ///
@@ -165,6 +175,41 @@ public:
   /// Comparing this value to a previous known value allows to quickly detect whether any entry has changed recently.
   ezUInt32 GetBlackboardEntryChangeCounter() const { return m_uiBlackboardEntryChangeCounter; }
 
+  /// \brief Returns a slot for the named entry, through which the entry can be accessed without any name lookups.
+  ///
+  /// Resolving the same name again returns the same slot. The slot stays valid for the lifetime of the blackboard, even if the entry
+  /// doesn't exist yet or gets unregistered. Accessing such a slot behaves like accessing a non-existing entry by name.
+  ezBlackboardSlot ResolveSlot(const ezHashedString& sName);
+
+  /// \brief Returns the entry that the slot refers to, or nullptr if no such entry is currently registered.
+  const Entry* GetSlotEntry(ezBlackboardSlot slot) const;
+
+  /// \brief Returns the value of the slot's entry, or the fallback, if the entry doesn't exist or can't be converted to T.
+  ///
+  /// Meant for simple types like bool, ezInt32, float and ezVec3. No ezVariant is copied, if the entry stores a value of type T.
+  template <typename T>
+  T GetSlotValue(ezBlackboardSlot slot, const T& fallback = T()) const;
+
+  /// \brief Sets the value of the slot's entry. Returns EZ_FAILURE, if the entry doesn't exist.
+  ///
+  /// In contrast to SetEntryValue() no event is broadcast right away. Instead, entries with the 'OnChangeEvent' flag are queued
+  /// and one event per entry is broadcast in BroadcastPendingEntryEvents(), with the value from before the first change as the old value.
+  /// If the entry currently stores a different type than T, this falls back to SetEntryValue().
+  template <typename T>
+  ezResult SetSlotValue(ezBlackboardSlot slot, const T& value, bool bForce = false);
+
+  /// \brief Whether any slot changes are waiting to be broadcast through OnEntryEvent().
+  bool HasPendingEntryEvents() const { return !m_PendingEventSlots.IsEmpty(); }
+
+  /// \brief Broadcasts OnEntryEvent() for all entries that were modified through SetSlotValue() since the last call.
+  ///
+  /// Entries whose value ended up being the same as before aren't broadcast. This is typically called once per frame by the owner of
+  /// the blackboard, e.g. ezBlackboardComponent. Global blackboards are handled by BroadcastPendingEntryEventsOfGlobalBlackboards().
+  void BroadcastPendingEntryEvents();
+
+  /// \brief Calls BroadcastPendingEntryEvents() on all global blackboards. Called once per frame by the game application.
+  static void BroadcastPendingEntryEventsOfGlobalBlackboards();
+
   /// \brief Stores all entries that have the 'Save' flag in the stream.
   ezResult Serialize(ezStreamWriter& inout_stream) const;
 
@@ -183,12 +228,28 @@ private:
   bool Reflection_SetEntryValue(ezStringView sName, const ezVariant& value);
   ezVariant Reflection_GetEntryValue(ezStringView sName, const ezVariant& fallback) const;
 
+  Entry* GetWritableSlotEntry(ezBlackboardSlot slot);
+  void UpdateSlotEntries();
+  void QueueEntryEvent(ezBlackboardSlot slot);
+
   ezHashedString m_sName;
   ezEvent<EntryEvent> m_EntryEvents;
   ezUInt32 m_uiBlackboardChangeCounter = 0;
   ezUInt32 m_uiBlackboardEntryChangeCounter = 0;
   ezHashTable<ezHashedString, Entry> m_Entries;
 
+  struct Slot
+  {
+    ezHashedString m_sName;
+    Entry* m_pEntry = nullptr; ///< updated whenever entries are added or removed, since that may move entries in m_Entries
+    ezVariant m_PendingEventOldValue;
+    bool m_bEventPending = false;
+  };
+
+  ezDynamicArray<Slot> m_Slots;
+  ezHashTable<ezHashedString, ezUInt32> m_SlotIndices;
+  ezDynamicArray<ezUInt32> m_PendingEventSlots;
+
   EZ_MAKE_SUBSYSTEM_STARTUP_FRIEND(Core, Blackboard);
   static ezMutex s_GlobalBlackboardsMutex;
   static ezHashTable<ezHashedString, ezSharedPtr<ezBlackboard>> s_GlobalBlackboards;
@@ -196,6 +257,8 @@ private:
 
 EZ_DECLARE_REFLECTABLE_TYPE(EZ_CORE_DLL, ezBlackboard);
 
+#include <Core/Utils/Implementation/Blackboard_inl.h>
+
 //////////////////////////////////////////////////////////////////////////
 
 struct EZ_CORE_DLL ezBlackboardCondition
@@ -106,6 +106,11 @@ void ezBlackboard::RegisterEntry(const ezHashedString& sName, const ezVariant& i
     entry.m_Flags |= flags;
   }
 
+  if (!bExisted)
+  {
+    UpdateSlotEntries();
+  }
+
   if (!bExisted && entry.m_Value != initialValue)
   {
     // broadcasts the change event, in case we overwrite an existing entry
@@ -118,6 +123,7 @@ void ezBlackboard::UnregisterEntry(const ezHashedString& sName)
   if (m_Entries.Remove(sName))
   {
     ++m_uiBlackboardChangeCounter;
+    UpdateSlotEntries();
   }
 }
 
@@ -129,6 +135,7 @@ void ezBlackboard::UnregisterAllEntries()
   }
 
   m_Entries.Clear();
+  UpdateSlotEntries();
 }
 
 ezResult ezBlackboard::SetEntryValue(const ezTempHashedString& sName, const ezVariant& value, bool bForce /*= false*/)
@@ -195,6 +202,96 @@ ezBitflags<ezBlackboardEntryFlags> ezBlackboard::GetEntryFlags(const ezTempHashe
   return itEntry.Value().m_Flags;
 }
 
+ezBlackboardSlot ezBlackboard::ResolveSlot(const ezHashedString& sName)
+{
+  bool bExisted = false;
+  ezUInt32& uiSlotIndex = m_SlotIndices.FindOrAdd(sName, &bExisted);
+
+  if (!bExisted)
+  {
+    uiSlotIndex = m_Slots.GetCount();
+
+    Slot& slot = m_Slots.ExpandAndGetRef();
+    slot.m_sName = sName;
+    slot.m_pEntry = m_Entries.GetValue(sName);
+  }
+
+  ezBlackboardSlot result;
+  result.m_uiIndex = uiSlotIndex;
+  return result;
+}
+
+void ezBlackboard::UpdateSlotEntries()
+{
+  for (Slot& slot : m_Slots)
+  {
+    slot.m_pEntry = m_Entries.GetValue(slot.m_sName);
+  }
+}
+
+void ezBlackboard::QueueEntryEvent(ezBlackboardSlot slot)
+{
+  Slot& slotData = m_Slots[slot.m_uiIndex];
+
+  if (slotData.m_bEventPending)
+    return;
+
+  slotData.m_bEventPending = true;
+  slotData.m_PendingEventOldValue = slotData.m_pEntry->m_Value;
+  m_PendingEventSlots.PushBack(slot.m_uiIndex);
+}
+
+void ezBlackboard::BroadcastPendingEntryEvents()
+{
+  if (m_PendingEventSlots.IsEmpty())
+    return;
+
+  // event handlers may modify the blackboard again, those changes are broadcast during the next call
+  ezHybridArray<ezUInt32, 32> pendingEventSlots;
+  pendingEventSlots = m_PendingEventSlots;
+  m_PendingEventSlots.Clear();
+
+  for (ezUInt32 uiSlotIndex : pendingEventSlots)
+  {
+    // don't hold a reference, handlers may resolve new slots
+    EntryEvent e;
+    e.m_sName = m_Slots[uiSlotIndex].m_sName;
+    e.m_OldValue = std::move(m_Slots[uiSlotIndex].m_PendingEventOldValue);
+    e.m_pEntry = m_Slots[uiSlotIndex].m_pEntry;
+
+    m_Slots[uiSlotIndex].m_PendingEventOldValue = ezVariant();
+    m_Slots[uiSlotIndex].m_bEventPending = false;
+
+    if (e.m_pEntry == nullptr || !e.m_pEntry->m_Flags.IsSet(ezBlackboardEntryFlags::OnChangeEvent) || e.m_pEntry->m_Value == e.m_OldValue)
+      continue;
+
+    m_EntryEvents.Broadcast(e, 1); // limited recursion is allowed
+  }
+}
+
+// static
+void ezBlackboard::BroadcastPendingEntryEventsOfGlobalBlackboards()
+{
+  ezHybridArray<ezSharedPtr<ezBlackboard>, 8> blackboards;
+
+  {
+    EZ_LOCK(s_GlobalBlackboardsMutex);
+
+    for (auto it : s_GlobalBlackboards)
+    {
+      if (it.Value()->HasPendingEntryEvents())
+      {
+        blackboards.PushBack(it.Value());
+      }
+    }
+  }
+
+  for (auto& pBlackboard : blackboards)
+  {
+    pBlackboard->BroadcastPendingEntryEvents();
+  }
+}
+
 ezResult ezBlackboard::Serialize(ezStreamWriter& inout_stream) const
 {
   inout_stream.WriteVersion(1);
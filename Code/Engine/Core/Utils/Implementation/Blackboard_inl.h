@@ -0,0 +1,52 @@
+EZ_ALWAYS_INLINE const ezBlackboard::Entry* ezBlackboard::GetSlotEntry(ezBlackboardSlot slot) const
+{
+  return slot.m_uiIndex < m_Slots.GetCount() ? m_Slots[slot.m_uiIndex].m_pEntry : nullptr;
+}
+
+EZ_ALWAYS_INLINE ezBlackboard::Entry* ezBlackboard::GetWritableSlotEntry(ezBlackboardSlot slot)
+{
+  return slot.m_uiIndex < m_Slots.GetCount() ? m_Slots[slot.m_uiIndex].m_pEntry : nullptr;
+}
+
+template <typename T>
+T ezBlackboard::GetSlotValue(ezBlackboardSlot slot, const T& fallback /*= T()*/) const
+{
+  const Entry* pEntry = GetSlotEntry(slot);
+  if (pEntry == nullptr)
+    return fallback;
+
+  if (pEntry->m_Value.IsA<T>())
+    return pEntry->m_Value.Get<T>();
+
+  ezResult conversionStatus = EZ_FAILURE;
+  T value = pEntry->m_Value.ConvertTo<T>(&conversionStatus);
+  return conversionStatus.Succeeded() ? value : fallback;
+}
+
+template <typename T>
+ezResult ezBlackboard::SetSlotValue(ezBlackboardSlot slot, const T& value, bool bForce /*= false*/)
+{
+  Entry* pEntry = GetWritableSlotEntry(slot);
+  if (pEntry == nullptr)
+    return EZ_FAILURE;
+
+  if (!pEntry->m_Value.IsA<T>())
+    return SetEntryValue(m_Slots[slot.m_uiIndex].m_sName, value, bForce);
+
+  T& storedValue = pEntry->m_Value.GetWritable<T>();
+
+  if (!bForce && storedValue == value)
+    return EZ_SUCCESS;
+
+  if (pEntry->m_Flags.IsSet(ezBlackboardEntryFlags::OnChangeEvent))
+  {
+    QueueEntryEvent(slot);
+  }
+
+  storedValue = value;
+
+  ++m_uiBlackboardEntryChangeCounter;
+  ++pEntry->m_uiChangeCounter;
+
+  return EZ_SUCCESS;
+}
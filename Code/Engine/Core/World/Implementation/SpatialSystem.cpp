@@ -45,6 +45,28 @@ void ezSpatialSystem::FindObjectsInBox(const ezBoundingBox& box, const QueryPara
     });
 }
 
+ezUInt64 ezSpatialSystem::GetModificationCounter(ezUInt32 uiCategoryBitmask) const
+{
+  // every counter only ever increases, so the sum changes whenever one of them changes
+  ezUInt64 uiCounter = 0;
+  while (uiCategoryBitmask > 0)
+  {
+    uiCounter += m_ModificationCounters[ezMath::FirstBitLow(uiCategoryBitmask)];
+    uiCategoryBitmask &= uiCategoryBitmask - 1;
+  }
+
+  return uiCounter;
+}
+
+void ezSpatialSystem::MarkModified(ezUInt32 uiCategoryBitmask)
+{
+  while (uiCategoryBitmask > 0)
+  {
+    ++m_ModificationCounters[ezMath::FirstBitLow(uiCategoryBitmask)];
+    uiCategoryBitmask &= uiCategoryBitmask - 1;
+  }
+}
+
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
 void ezSpatialSystem::GetInternalStats(ezStringBuilder& ref_sSb) const
 {
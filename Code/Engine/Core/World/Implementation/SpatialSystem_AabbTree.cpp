@@ -0,0 +1,1300 @@
+#include <Core/CorePCH.h>
+
+#include <Core/World/SpatialSystem_AabbTree.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  enum
+  {
+    NUM_SAH_BINS = 8,
+    MAX_SAH_DEPTH = 48,        ///< Below this depth the rebuild falls back to splitting in the middle to guarantee a bounded tree height.
+    MIN_CHANGES_FOR_REBUILD = 64,
+    OCCLUSION_MIN_NODE_HEIGHT = 3, ///< Inner nodes are only tested for occlusion when they are the root of a reasonably large subtree.
+    INSIDE_QUERY_FLAG = EZ_BIT(31) ///< Marks nodes on the traversal stack that are entirely inside the query shape.
+  };
+
+  EZ_ALWAYS_INLINE bool FilterByTags(const ezTagSet& tags, const ezTagSet& includeTags, const ezTagSet& excludeTags)
+  {
+    if (!excludeTags.IsEmpty() && excludeTags.IsAnySet(tags))
+      return true;
+
+    if (!includeTags.IsEmpty() && !includeTags.IsAnySet(tags))
+      return true;
+
+    return false;
+  }
+
+  EZ_ALWAYS_INLINE float GetHalfSurfaceArea(const ezSimdBBox& box)
+  {
+    const ezSimdVec4f vExtents = box.GetExtents();
+    return vExtents.CompMul(vExtents.Get<ezSwizzle::YZXW>()).HorizontalSum<3>();
+  }
+
+  EZ_ALWAYS_INLINE ezSimdBBox GetUnion(const ezSimdBBox& a, const ezSimdBBox& b)
+  {
+    return ezSimdBBox(a.m_Min.CompMin(b.m_Min), a.m_Max.CompMax(b.m_Max));
+  }
+
+  /// All queries test against the bounding sphere, so the leaf bounds have to enclose the sphere.
+  EZ_ALWAYS_INLINE ezSimdBBox ComputeLeafBounds(const ezSimdBSphere& sphere)
+  {
+    return ezSimdBBox::MakeFromCenterAndHalfExtents(sphere.GetCenter(), sphere.m_CenterAndRadius.Get<ezSwizzle::WWWW>());
+  }
+
+  EZ_ALWAYS_INLINE bool ShapeContainsBox(const ezSimdBBox& shape, const ezSimdBBox& box)
+  {
+    return shape.Contains(box);
+  }
+
+  EZ_ALWAYS_INLINE bool ShapeContainsBox(const ezSimdBSphere& shape, const ezSimdBBox& box)
+  {
+    const ezSimdVec4f vCenter = shape.GetCenter();
+    const ezSimdVec4f vFarthestCorner = (box.m_Min - vCenter).Abs().CompMax((box.m_Max - vCenter).Abs());
+    return vFarthestCorner.GetLengthSquared<3>() <= shape.GetRadius() * shape.GetRadius();
+  }
+
+  struct PlaneData
+  {
+    ezSimdVec4f m_x0x1x2x3;
+    ezSimdVec4f m_y0y1y2y3;
+    ezSimdVec4f m_z0z1z2z3;
+    ezSimdVec4f m_w0w1w2w3;
+
+    ezSimdVec4f m_x4x5x4x5;
+    ezSimdVec4f m_y4y5y4y5;
+    ezSimdVec4f m_z4z5z4z5;
+    ezSimdVec4f m_w4w5w4w5;
+  };
+
+  EZ_FORCE_INLINE bool SphereFrustumIntersect(const ezSimdBSphere& sphere, const PlaneData& planeData)
+  {
+    ezSimdVec4f pos_xxxx(sphere.m_CenterAndRadius.x());
+    ezSimdVec4f pos_yyyy(sphere.m_CenterAndRadius.y());
+    ezSimdVec4f pos_zzzz(sphere.m_CenterAndRadius.z());
+    ezSimdVec4f pos_rrrr(sphere.m_CenterAndRadius.w());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4b cmp_0123 = dot_0123 > pos_rrrr;
+    ezSimdVec4b cmp_4545 = dot_4545 > pos_rrrr;
+    return (cmp_0123 || cmp_4545).NoneSet<4>();
+  }
+
+  enum class FrustumTestResult
+  {
+    Outside,
+    Intersecting,
+    Inside
+  };
+
+  /// Tests all six planes at once by projecting the box extents onto the plane normals.
+  EZ_FORCE_INLINE FrustumTestResult BoxFrustumIntersect(const ezSimdBBox& box, const PlaneData& planeData)
+  {
+    const ezSimdVec4f vCenter = box.GetCenter();
+    const ezSimdVec4f vHalfExtents = box.GetHalfExtents();
+
+    ezSimdVec4f pos_xxxx(vCenter.x());
+    ezSimdVec4f pos_yyyy(vCenter.y());
+    ezSimdVec4f pos_zzzz(vCenter.z());
+
+    ezSimdVec4f ext_xxxx(vHalfExtents.x());
+    ezSimdVec4f ext_yyyy(vHalfExtents.y());
+    ezSimdVec4f ext_zzzz(vHalfExtents.z());
+
+    ezSimdVec4f dot_0123;
+    dot_0123 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x0x1x2x3, planeData.m_w0w1w2w3);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y0y1y2y3, dot_0123);
+    dot_0123 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z0z1z2z3, dot_0123);
+
+    ezSimdVec4f rad_0123;
+    rad_0123 = ext_xxxx.CompMul(planeData.m_x0x1x2x3.Abs());
+    rad_0123 = ezSimdVec4f::MulAdd(ext_yyyy, planeData.m_y0y1y2y3.Abs(), rad_0123);
+    rad_0123 = ezSimdVec4f::MulAdd(ext_zzzz, planeData.m_z0z1z2z3.Abs(), rad_0123);
+
+    ezSimdVec4f dot_4545;
+    dot_4545 = ezSimdVec4f::MulAdd(pos_xxxx, planeData.m_x4x5x4x5, planeData.m_w4w5w4w5);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_yyyy, planeData.m_y4y5y4y5, dot_4545);
+    dot_4545 = ezSimdVec4f::MulAdd(pos_zzzz, planeData.m_z4z5z4z5, dot_4545);
+
+    ezSimdVec4f rad_4545;
+    rad_4545 = ext_xxxx.CompMul(planeData.m_x4x5x4x5.Abs());
+    rad_4545 = ezSimdVec4f::MulAdd(ext_yyyy, planeData.m_y4y5y4y5.Abs(), rad_4545);
+    rad_4545 = ezSimdVec4f::MulAdd(ext_zzzz, planeData.m_z4z5z4z5.Abs(), rad_4545);
+
+    if ((dot_0123 > rad_0123 || dot_4545 > rad_4545).AnySet<4>())
+      return FrustumTestResult::Outside;
+
+    const ezSimdVec4f vZero = ezSimdVec4f::MakeZero();
+    if ((dot_0123 + rad_0123 < vZero && dot_4545 + rad_4545 < vZero).AllSet<4>())
+      return FrustumTestResult::Inside;
+
+    return FrustumTestResult::Intersecting;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+struct ezSpatialSystem_AabbTree::Node
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdBBox m_Bounds;
+
+  // Only valid for leaves. Stored here instead of in the data table, so that queries without tag filter never touch the data table.
+  ezSimdBSphere m_Sphere;
+  ezGameObject* m_pObject;
+  mutable ezInt64 m_iLastVisibleFrameIdxAndVisType;
+
+  ezUInt32 m_uiParent;
+  ezUInt32 m_uiChildren[2]; ///< For leaves the first child is invalid and the second one is the index of the spatial data.
+  ezInt32 m_iHeight;        ///< 0 for leaves, -1 for nodes in the free list.
+
+  EZ_ALWAYS_INLINE bool IsLeaf() const { return m_uiChildren[0] == ezInvalidIndex; }
+  EZ_ALWAYS_INLINE ezUInt32 GetDataIndex() const { return m_uiChildren[1]; }
+};
+
+struct ezSpatialSystem_AabbTree::Tree
+{
+  Tree(ezAllocatorBase* pAlignedAllocator, ezAllocatorBase* pAllocator)
+    : m_Nodes(pAlignedAllocator)
+    , m_TempNodes(pAlignedAllocator)
+    , m_DataToLeaf(pAllocator)
+    , m_AlwaysVisibleData(pAllocator)
+    , m_TempLeaves(pAlignedAllocator)
+  {
+  }
+
+  void AddSpatialData(ezUInt32 uiDataIndex, const ezSimdBSphere& sphere, ezGameObject* pObject)
+  {
+    const ezUInt32 uiLeaf = AllocateNode();
+
+    Node& leaf = m_Nodes[uiLeaf];
+    leaf.m_Bounds = ComputeLeafBounds(sphere);
+    leaf.m_Sphere = sphere;
+    leaf.m_pObject = pObject;
+    leaf.m_iLastVisibleFrameIdxAndVisType = 0;
+    leaf.m_uiChildren[0] = ezInvalidIndex;
+    leaf.m_uiChildren[1] = uiDataIndex;
+    leaf.m_iHeight = 0;
+
+    GetDataToLeafMapping(uiDataIndex) = uiLeaf;
+
+    InsertLeaf(uiLeaf);
+
+    ++m_uiNumLeaves;
+    ++m_uiNumChangesSinceRebuild;
+  }
+
+  void RemoveSpatialData(ezUInt32 uiDataIndex)
+  {
+    ezUInt32& uiLeaf = m_DataToLeaf[uiDataIndex];
+
+    RemoveLeaf(uiLeaf);
+    FreeNode(uiLeaf);
+    uiLeaf = ezInvalidIndex;
+
+    --m_uiNumLeaves;
+    ++m_uiNumChangesSinceRebuild;
+  }
+
+  void UpdateSpatialData(ezUInt32 uiDataIndex, const ezSimdBSphere& sphere, float fFatBoundsMargin)
+  {
+    const ezUInt32 uiLeaf = m_DataToLeaf[uiDataIndex];
+
+    Node& leaf = m_Nodes[uiLeaf];
+    const ezSimdVec4f vDisplacement = sphere.GetCenter() - leaf.m_Sphere.GetCenter();
+    leaf.m_Sphere = sphere;
+
+    ezSimdBBox leafBounds = ComputeLeafBounds(sphere);
+    if (leaf.m_Bounds.Contains(leafBounds))
+      return;
+
+    // Enlarge the bounds by a fixed margin and additionally in the direction of the movement,
+    // so that objects that move steadily don't need to be re-inserted every frame.
+    leafBounds.Grow(ezSimdVec4f(fFatBoundsMargin));
+    ezSimdBBox predictedBounds = leafBounds;
+    predictedBounds.Translate(vDisplacement);
+    leafBounds.ExpandToInclude(predictedBounds);
+
+    RemoveLeaf(uiLeaf);
+    m_Nodes[uiLeaf].m_Bounds = leafBounds;
+    InsertLeaf(uiLeaf);
+
+    ++m_uiNumChangesSinceRebuild;
+  }
+
+  void AddAlwaysVisibleData(ezUInt32 uiDataIndex)
+  {
+    m_AlwaysVisibleData.PushBack(uiDataIndex);
+  }
+
+  void RemoveAlwaysVisibleData(ezUInt32 uiDataIndex)
+  {
+    m_AlwaysVisibleData.RemoveAndSwap(uiDataIndex);
+  }
+
+  EZ_ALWAYS_INLINE bool NeedsRebuild() const
+  {
+    return m_uiNumChangesSinceRebuild >= ezMath::Max<ezUInt32>(MIN_CHANGES_FOR_REBUILD, m_uiNumLeaves / 4);
+  }
+
+  void Rebuild()
+  {
+    m_uiNumChangesSinceRebuild = 0;
+
+    if (m_uiRootIndex == ezInvalidIndex)
+      return;
+
+    m_TempLeaves.Clear();
+    m_TempLeaves.Reserve(m_uiNumLeaves);
+
+    for (ezUInt32 i = 0; i < m_Nodes.GetCount(); ++i)
+    {
+      const Node& node = m_Nodes[i];
+      if (node.m_iHeight < 0)
+        continue;
+
+      if (node.IsLeaf())
+      {
+        BuildLeaf& leaf = m_TempLeaves.ExpandAndGetRef();
+        leaf.m_Bounds = node.m_Bounds;
+        leaf.m_uiNodeIndex = i;
+        node.m_Bounds.GetCenter().Store<3>(leaf.m_fCenter);
+      }
+      else
+      {
+        FreeNode(i);
+      }
+    }
+
+    m_uiRootIndex = BuildSubtree(m_TempLeaves.GetData(), m_TempLeaves.GetCount(), 0);
+    m_Nodes[m_uiRootIndex].m_uiParent = ezInvalidIndex;
+
+    SortNodesDepthFirst();
+  }
+
+  /// Re-orders the nodes so that every subtree is stored in one contiguous block, which makes traversal a lot more cache friendly.
+  void SortNodesDepthFirst()
+  {
+    struct StackEntry
+    {
+      EZ_DECLARE_POD_TYPE();
+
+      ezUInt32 m_uiOldIndex;
+      ezUInt32 m_uiNewParent;
+    };
+
+    m_TempNodes.Clear();
+    m_TempNodes.Reserve(m_uiNumLeaves * 2);
+
+    ezHybridArray<StackEntry, 128> stack;
+    stack.PushBack({m_uiRootIndex, ezInvalidIndex});
+
+    while (!stack.IsEmpty())
+    {
+      const StackEntry entry = stack.PeekBack();
+      stack.PopBack();
+
+      const ezUInt32 uiNewIndex = m_TempNodes.GetCount();
+      Node& node = m_TempNodes.ExpandAndGetRef();
+      node = m_Nodes[entry.m_uiOldIndex];
+      node.m_uiParent = entry.m_uiNewParent;
+
+      if (entry.m_uiNewParent != ezInvalidIndex)
+      {
+        Node& parent = m_TempNodes[entry.m_uiNewParent];
+        parent.m_uiChildren[parent.m_uiChildren[0] == entry.m_uiOldIndex ? 0 : 1] = uiNewIndex;
+      }
+
+      if (node.IsLeaf())
+      {
+        m_DataToLeaf[node.GetDataIndex()] = uiNewIndex;
+      }
+      else
+      {
+        stack.PushBack({node.m_uiChildren[1], uiNewIndex});
+        stack.PushBack({node.m_uiChildren[0], uiNewIndex});
+      }
+    }
+
+    m_Nodes.Swap(m_TempNodes);
+    m_TempNodes.Clear();
+
+    m_uiRootIndex = 0;
+    m_uiFreeListIndex = ezInvalidIndex;
+  }
+
+  ezUInt32 AllocateNode()
+  {
+    if (m_uiFreeListIndex != ezInvalidIndex)
+    {
+      const ezUInt32 uiIndex = m_uiFreeListIndex;
+      m_uiFreeListIndex = m_Nodes[uiIndex].m_uiParent;
+      return uiIndex;
+    }
+
+    m_Nodes.ExpandAndGetRef();
+    return m_Nodes.GetCount() - 1;
+  }
+
+  void FreeNode(ezUInt32 uiIndex)
+  {
+    Node& node = m_Nodes[uiIndex];
+    node.m_uiParent = m_uiFreeListIndex;
+    node.m_iHeight = -1;
+
+    m_uiFreeListIndex = uiIndex;
+  }
+
+  ezUInt32& GetDataToLeafMapping(ezUInt32 uiDataIndex)
+  {
+    if (uiDataIndex >= m_DataToLeaf.GetCount())
+    {
+      m_DataToLeaf.SetCount(uiDataIndex + 1, ezInvalidIndex);
+    }
+
+    return m_DataToLeaf[uiDataIndex];
+  }
+
+  void InsertLeaf(ezUInt32 uiLeaf)
+  {
+    if (m_uiRootIndex == ezInvalidIndex)
+    {
+      m_uiRootIndex = uiLeaf;
+      m_Nodes[uiLeaf].m_uiParent = ezInvalidIndex;
+      return;
+    }
+
+    const ezSimdBBox leafBounds = m_Nodes[uiLeaf].m_Bounds;
+
+    // Find the best sibling by descending the tree with the surface area heuristic
+    ezUInt32 uiIndex = m_uiRootIndex;
+    while (!m_Nodes[uiIndex].IsLeaf())
+    {
+      const Node& node = m_Nodes[uiIndex];
+
+      const float fArea = GetHalfSurfaceArea(node.m_Bounds);
+      const float fCombinedArea = GetHalfSurfaceArea(GetUnion(node.m_Bounds, leafBounds));
+
+      // Cost of creating a new parent for this node and the new leaf
+      const float fCost = 2.0f * fCombinedArea;
+
+      // Minimum cost of pushing the leaf further down the tree
+      const float fInheritanceCost = 2.0f * (fCombinedArea - fArea);
+
+      float fChildCosts[2];
+      for (ezUInt32 i = 0; i < 2; ++i)
+      {
+        const Node& child = m_Nodes[node.m_uiChildren[i]];
+
+        fChildCosts[i] = GetHalfSurfaceArea(GetUnion(child.m_Bounds, leafBounds)) + fInheritanceCost;
+        if (!child.IsLeaf())
+        {
+          fChildCosts[i] -= GetHalfSurfaceArea(child.m_Bounds);
+        }
+      }
+
+      if (fCost < fChildCosts[0] && fCost < fChildCosts[1])
+        break;
+
+      uiIndex = node.m_uiChildren[fChildCosts[0] < fChildCosts[1] ? 0 : 1];
+    }
+
+    const ezUInt32 uiSibling = uiIndex;
+    const ezUInt32 uiOldParent = m_Nodes[uiSibling].m_uiParent;
+    const ezUInt32 uiNewParent = AllocateNode();
+
+    Node& newParent = m_Nodes[uiNewParent];
+    newParent.m_Bounds = GetUnion(leafBounds, m_Nodes[uiSibling].m_Bounds);
+    newParent.m_uiParent = uiOldParent;
+    newParent.m_uiChildren[0] = uiSibling;
+    newParent.m_uiChildren[1] = uiLeaf;
+    newParent.m_iHeight = m_Nodes[uiSibling].m_iHeight + 1;
+
+    m_Nodes[uiSibling].m_uiParent = uiNewParent;
+    m_Nodes[uiLeaf].m_uiParent = uiNewParent;
+
+    if (uiOldParent != ezInvalidIndex)
+    {
+      ReplaceChild(uiOldParent, uiSibling, uiNewParent);
+    }
+    else
+    {
+      m_uiRootIndex = uiNewParent;
+    }
+
+    RefitAncestors(uiNewParent);
+  }
+
+  void RemoveLeaf(ezUInt32 uiLeaf)
+  {
+    if (uiLeaf == m_uiRootIndex)
+    {
+      m_uiRootIndex = ezInvalidIndex;
+      return;
+    }
+
+    const ezUInt32 uiParent = m_Nodes[uiLeaf].m_uiParent;
+    const Node& parent = m_Nodes[uiParent];
+    const ezUInt32 uiGrandParent = parent.m_uiParent;
+    const ezUInt32 uiSibling = parent.m_uiChildren[parent.m_uiChildren[0] == uiLeaf ? 1 : 0];
+
+    m_Nodes[uiSibling].m_uiParent = uiGrandParent;
+    FreeNode(uiParent);
+
+    if (uiGrandParent != ezInvalidIndex)
+    {
+      ReplaceChild(uiGrandParent, uiParent, uiSibling);
+      RefitAncestors(uiGrandParent);
+    }
+    else
+    {
+      m_uiRootIndex = uiSibling;
+    }
+  }
+
+  EZ_ALWAYS_INLINE void ReplaceChild(ezUInt32 uiParent, ezUInt32 uiOldChild, ezUInt32 uiNewChild)
+  {
+    Node& parent = m_Nodes[uiParent];
+    parent.m_uiChildren[parent.m_uiChildren[0] == uiOldChild ? 0 : 1] = uiNewChild;
+  }
+
+  EZ_ALWAYS_INLINE void UpdateFromChildren(Node& ref_node) const
+  {
+    const Node& child0 = m_Nodes[ref_node.m_uiChildren[0]];
+    const Node& child1 = m_Nodes[ref_node.m_uiChildren[1]];
+
+    ref_node.m_Bounds = GetUnion(child0.m_Bounds, child1.m_Bounds);
+    ref_node.m_iHeight = 1 + ezMath::Max(child0.m_iHeight, child1.m_iHeight);
+  }
+
+  void RefitAncestors(ezUInt32 uiIndex)
+  {
+    while (uiIndex != ezInvalidIndex)
+    {
+      uiIndex = Balance(uiIndex);
+
+      Node& node = m_Nodes[uiIndex];
+      UpdateFromChildren(node);
+
+      uiIndex = node.m_uiParent;
+    }
+  }
+
+  /// Performs a left or right rotation if the subtree at the given node is imbalanced and returns the new root of the subtree.
+  ezUInt32 Balance(ezUInt32 uiA)
+  {
+    Node& a = m_Nodes[uiA];
+    if (a.IsLeaf() || a.m_iHeight < 2)
+      return uiA;
+
+    const ezUInt32 uiB = a.m_uiChildren[0];
+    const ezUInt32 uiC = a.m_uiChildren[1];
+    const ezInt32 iBalance = m_Nodes[uiC].m_iHeight - m_Nodes[uiB].m_iHeight;
+
+    if (iBalance > 1)
+    {
+      return Rotate(uiA, uiC, 1);
+    }
+
+    if (iBalance < -1)
+    {
+      return Rotate(uiA, uiB, 0);
+    }
+
+    return uiA;
+  }
+
+  /// Moves the child at the given slot of A up to A's position. A takes the place of its former child and adopts the smaller grandchild.
+  ezUInt32 Rotate(ezUInt32 uiA, ezUInt32 uiUp, ezUInt32 uiSlot)
+  {
+    Node& a = m_Nodes[uiA];
+    Node& up = m_Nodes[uiUp];
+
+    const ezUInt32 uiF = up.m_uiChildren[0];
+    const ezUInt32 uiG = up.m_uiChildren[1];
+    Node& f = m_Nodes[uiF];
+    Node& g = m_Nodes[uiG];
+
+    up.m_uiChildren[0] = uiA;
+    up.m_uiParent = a.m_uiParent;
+    a.m_uiParent = uiUp;
+
+    if (up.m_uiParent != ezInvalidIndex)
+    {
+      ReplaceChild(up.m_uiParent, uiA, uiUp);
+    }
+    else
+    {
+      m_uiRootIndex = uiUp;
+    }
+
+    // the taller grandchild stays with the new subtree root, the other one moves to A
+    const bool bKeepF = f.m_iHeight > g.m_iHeight;
+    const ezUInt32 uiKeep = bKeepF ? uiF : uiG;
+    const ezUInt32 uiMove = bKeepF ? uiG : uiF;
+
+    up.m_uiChildren[1] = uiKeep;
+    a.m_uiChildren[uiSlot] = uiMove;
+    m_Nodes[uiMove].m_uiParent = uiA;
+
+    UpdateFromChildren(a);
+    UpdateFromChildren(up);
+
+    return uiUp;
+  }
+
+  struct BuildLeaf
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdBBox m_Bounds;
+    float m_fCenter[3];
+    ezUInt32 m_uiNodeIndex;
+  };
+
+  /// Builds a subtree over the given leaves top-down with a binned surface area heuristic and returns its root.
+  ezUInt32 BuildSubtree(BuildLeaf* pLeaves, ezUInt32 uiNumLeaves, ezUInt32 uiDepth)
+  {
+    if (uiNumLeaves == 1)
+      return pLeaves[0].m_uiNodeIndex;
+
+    ezUInt32 uiSplit = uiNumLeaves / 2;
+
+    if (uiDepth < MAX_SAH_DEPTH)
+    {
+      ezVec3 vCenterMin = ezVec3(ezMath::MaxValue<float>());
+      ezVec3 vCenterMax = ezVec3(-ezMath::MaxValue<float>());
+      for (ezUInt32 i = 0; i < uiNumLeaves; ++i)
+      {
+        const ezVec3 vCenter(pLeaves[i].m_fCenter[0], pLeaves[i].m_fCenter[1], pLeaves[i].m_fCenter[2]);
+        vCenterMin = vCenterMin.CompMin(vCenter);
+        vCenterMax = vCenterMax.CompMax(vCenter);
+      }
+
+      const ezVec3 vExtents = vCenterMax - vCenterMin;
+      ezUInt32 uiAxis = 0;
+      if (vExtents.y > vExtents.GetData()[uiAxis])
+        uiAxis = 1;
+      if (vExtents.z > vExtents.GetData()[uiAxis])
+        uiAxis = 2;
+
+      const float fAxisExtents = vExtents.GetData()[uiAxis];
+      if (fAxisExtents > ezMath::SmallEpsilon<float>())
+      {
+        const float fBinScale = (NUM_SAH_BINS * 0.9999f) / fAxisExtents;
+        const float fBinMin = vCenterMin.GetData()[uiAxis];
+
+        auto GetBinIndex = [&](const BuildLeaf& leaf) {
+          return ezMath::Min<ezUInt32>(static_cast<ezUInt32>((leaf.m_fCenter[uiAxis] - fBinMin) * fBinScale), NUM_SAH_BINS - 1);
+        };
+
+        ezSimdBBox binBounds[NUM_SAH_BINS];
+        ezUInt32 binCounts[NUM_SAH_BINS] = {};
+        for (ezUInt32 i = 0; i < NUM_SAH_BINS; ++i)
+        {
+          binBounds[i] = ezSimdBBox::MakeInvalid();
+        }
+
+        for (ezUInt32 i = 0; i < uiNumLeaves; ++i)
+        {
+          const ezUInt32 uiBin = GetBinIndex(pLeaves[i]);
+          binBounds[uiBin].ExpandToInclude(pLeaves[i].m_Bounds);
+          ++binCounts[uiBin];
+        }
+
+        // sweep from the right to get the cost of everything right of each split
+        float fRightCosts[NUM_SAH_BINS];
+        {
+          ezSimdBBox rightBounds = ezSimdBBox::MakeInvalid();
+          ezUInt32 uiRightCount = 0;
+          for (ezUInt32 i = NUM_SAH_BINS - 1; i > 0; --i)
+          {
+            rightBounds.ExpandToInclude(binBounds[i]);
+            uiRightCount += binCounts[i];
+            fRightCosts[i] = uiRightCount > 0 ? GetHalfSurfaceArea(rightBounds) * uiRightCount : 0.0f;
+          }
+        }
+
+        ezUInt32 uiBestSplitBin = ezInvalidIndex;
+        float fBestCost = ezMath::MaxValue<float>();
+        {
+          ezSimdBBox leftBounds = ezSimdBBox::MakeInvalid();
+          ezUInt32 uiLeftCount = 0;
+          for (ezUInt32 i = 0; i < NUM_SAH_BINS - 1; ++i)
+          {
+            leftBounds.ExpandToInclude(binBounds[i]);
+            uiLeftCount += binCounts[i];
+
+            if (uiLeftCount == 0 || uiLeftCount == uiNumLeaves)
+              continue;
+
+            const float fCost = GetHalfSurfaceArea(leftBounds) * uiLeftCount + fRightCosts[i + 1];
+            if (fCost < fBestCost)
+            {
+              fBestCost = fCost;
+              uiBestSplitBin = i;
+            }
+          }
+        }
+
+        if (uiBestSplitBin != ezInvalidIndex)
+        {
+          ezUInt32 uiLeft = 0;
+          ezUInt32 uiRight = uiNumLeaves;
+          while (uiLeft < uiRight)
+          {
+            if (GetBinIndex(pLeaves[uiLeft]) <= uiBestSplitBin)
+            {
+              ++uiLeft;
+            }
+            else
+            {
+              ezMath::Swap(pLeaves[uiLeft], pLeaves[--uiRight]);
+            }
+          }
+
+          uiSplit = uiLeft;
+        }
+      }
+    }
+
+    const ezUInt32 uiChild0 = BuildSubtree(pLeaves, uiSplit, uiDepth + 1);
+    const ezUInt32 uiChild1 = BuildSubtree(pLeaves + uiSplit, uiNumLeaves - uiSplit, uiDepth + 1);
+
+    const ezUInt32 uiIndex = AllocateNode();
+    Node& node = m_Nodes[uiIndex];
+    node.m_uiChildren[0] = uiChild0;
+    node.m_uiChildren[1] = uiChild1;
+    UpdateFromChildren(node);
+
+    m_Nodes[uiChild0].m_uiParent = uiIndex;
+    m_Nodes[uiChild1].m_uiParent = uiIndex;
+
+    return uiIndex;
+  }
+
+  ezDynamicArray<Node> m_Nodes;
+  ezUInt32 m_uiRootIndex = ezInvalidIndex;
+  ezUInt32 m_uiFreeListIndex = ezInvalidIndex;
+  ezUInt32 m_uiNumLeaves = 0;
+  ezUInt32 m_uiNumChangesSinceRebuild = 0;
+
+  ezDynamicArray<ezUInt32> m_DataToLeaf;
+  ezDynamicArray<ezUInt32> m_AlwaysVisibleData;
+  ezDynamicArray<Node> m_TempNodes;
+  ezDynamicArray<BuildLeaf> m_TempLeaves;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace ezInternal
+{
+  struct AabbTreeQueryHelper
+  {
+    using Node = ezSpatialSystem_AabbTree::Node;
+    using Tree = ezSpatialSystem_AabbTree::Tree;
+    using Data = ezSpatialSystem_AabbTree::Data;
+
+    struct Stats
+    {
+      ezUInt32 m_uiNumObjectsTested = 0;
+      ezUInt32 m_uiNumObjectsPassed = 0;
+    };
+
+    using NodeStack = ezHybridArray<ezUInt32, 128>;
+
+    template <typename T>
+    static ezVisitorExecution::Enum ShapeQuery(const ezSpatialSystem_AabbTree& system, const Tree& tree, const T& shape, const ezSpatialSystem::QueryParams& queryParams, bool bUseTagsFilter, ezSpatialSystem::QueryCallback& ref_callback, Stats& ref_stats)
+    {
+      auto ReportData = [&](ezUInt32 uiDataIndex, ezGameObject* pObject) {
+        if (bUseTagsFilter)
+        {
+          const Data& data = system.m_DataTable.GetValueUnchecked(uiDataIndex);
+          if (FilterByTags(data.m_Tags, queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+            return ezVisitorExecution::Continue;
+        }
+
+        ref_stats.m_uiNumObjectsPassed++;
+        return ref_callback(pObject);
+      };
+
+      if (tree.m_uiRootIndex != ezInvalidIndex)
+      {
+        const Node* pNodes = tree.m_Nodes.GetData();
+
+        NodeStack stack;
+        stack.PushBack(tree.m_uiRootIndex);
+
+        while (!stack.IsEmpty())
+        {
+          const ezUInt32 uiEntry = stack.PeekBack();
+          stack.PopBack();
+
+          const Node& node = pNodes[uiEntry & ~INSIDE_QUERY_FLAG];
+          ezUInt32 uiInsideFlag = uiEntry & INSIDE_QUERY_FLAG;
+
+          if (!node.IsLeaf())
+          {
+            // once a node is completely inside the query shape, all leaves below it overlap the shape as well
+            if (uiInsideFlag == 0)
+            {
+              if (!node.m_Bounds.Overlaps(shape))
+                continue;
+
+              uiInsideFlag = ShapeContainsBox(shape, node.m_Bounds) ? INSIDE_QUERY_FLAG : 0;
+            }
+
+            stack.PushBack(node.m_uiChildren[1] | uiInsideFlag);
+            stack.PushBack(node.m_uiChildren[0] | uiInsideFlag);
+            continue;
+          }
+
+          ref_stats.m_uiNumObjectsTested++;
+
+          if (uiInsideFlag == 0 && !shape.Overlaps(node.m_Sphere))
+            continue;
+
+          if (ReportData(node.GetDataIndex(), node.m_pObject) == ezVisitorExecution::Stop)
+            return ezVisitorExecution::Stop;
+        }
+      }
+
+      // always visible data overlaps with everything
+      for (ezUInt32 uiDataIndex : tree.m_AlwaysVisibleData)
+      {
+        ref_stats.m_uiNumObjectsTested++;
+
+        if (ReportData(uiDataIndex, system.m_DataTable.GetValueUnchecked(uiDataIndex).m_pObject) == ezVisitorExecution::Stop)
+          return ezVisitorExecution::Stop;
+      }
+
+      return ezVisitorExecution::Continue;
+    }
+
+    struct FrustumQueryData
+    {
+      PlaneData m_PlaneData;
+      ezDynamicArray<const ezGameObject*>* m_pOutObjects;
+      ezInt64 m_iFrameIdxAndType;
+      ezSpatialSystem::IsOccludedFunc m_IsOccludedCB;
+    };
+
+    template <bool UseTagsFilter, bool UseOcclusionCallback>
+    static void FrustumQuery(const ezSpatialSystem_AabbTree& system, const Tree& tree, const FrustumQueryData& queryData, const ezSpatialSystem::QueryParams& queryParams, Stats& ref_stats)
+    {
+      auto ReportLeaf = [&](const Node& leaf) {
+        if constexpr (UseTagsFilter || UseOcclusionCallback)
+        {
+          const Data& data = system.m_DataTable.GetValueUnchecked(leaf.GetDataIndex());
+
+          if constexpr (UseTagsFilter)
+          {
+            if (FilterByTags(data.m_Tags, queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+              return;
+          }
+
+          if constexpr (UseOcclusionCallback)
+          {
+            const ezSimdBBox bbox = ezSimdBBox::MakeFromCenterAndHalfExtents(leaf.m_Sphere.GetCenter(), ezSimdConversion::ToVec3(data.m_vBoxHalfExtents));
+            if (queryData.m_IsOccludedCB(bbox))
+              return;
+          }
+        }
+
+        ezAtomicUtils::Max(leaf.m_iLastVisibleFrameIdxAndVisType, queryData.m_iFrameIdxAndType);
+        queryData.m_pOutObjects->PushBack(leaf.m_pObject);
+
+        ref_stats.m_uiNumObjectsPassed++;
+      };
+
+      if (tree.m_uiRootIndex != ezInvalidIndex)
+      {
+        const Node* pNodes = tree.m_Nodes.GetData();
+
+        NodeStack stack;
+        stack.PushBack(tree.m_uiRootIndex);
+
+        while (!stack.IsEmpty())
+        {
+          const ezUInt32 uiEntry = stack.PeekBack();
+          stack.PopBack();
+
+          const Node& node = pNodes[uiEntry & ~INSIDE_QUERY_FLAG];
+          ezUInt32 uiInsideFlag = uiEntry & INSIDE_QUERY_FLAG;
+
+          if (!node.IsLeaf())
+          {
+            // once a node is completely inside the frustum, its whole subtree is visible and doesn't need to be tested anymore
+            if (uiInsideFlag == 0)
+            {
+              const FrustumTestResult result = BoxFrustumIntersect(node.m_Bounds, queryData.m_PlaneData);
+              if (result == FrustumTestResult::Outside)
+                continue;
+
+              uiInsideFlag = (result == FrustumTestResult::Inside) ? INSIDE_QUERY_FLAG : 0;
+            }
+
+            if constexpr (UseOcclusionCallback)
+            {
+              if (node.m_iHeight >= OCCLUSION_MIN_NODE_HEIGHT && queryData.m_IsOccludedCB(node.m_Bounds))
+                continue;
+            }
+
+            stack.PushBack(node.m_uiChildren[1] | uiInsideFlag);
+            stack.PushBack(node.m_uiChildren[0] | uiInsideFlag);
+            continue;
+          }
+
+          ref_stats.m_uiNumObjectsTested++;
+
+          if (uiInsideFlag == 0 && !SphereFrustumIntersect(node.m_Sphere, queryData.m_PlaneData))
+            continue;
+
+          ReportLeaf(node);
+        }
+      }
+
+      for (ezUInt32 uiDataIndex : tree.m_AlwaysVisibleData)
+      {
+        ref_stats.m_uiNumObjectsTested++;
+
+        const Data& data = system.m_DataTable.GetValueUnchecked(uiDataIndex);
+
+        if constexpr (UseTagsFilter)
+        {
+          if (FilterByTags(data.m_Tags, queryParams.m_IncludeTags, queryParams.m_ExcludeTags))
+            continue;
+        }
+
+        queryData.m_pOutObjects->PushBack(data.m_pObject);
+
+        ref_stats.m_uiNumObjectsPassed++;
+      }
+    }
+  };
+} // namespace ezInternal
+
+//////////////////////////////////////////////////////////////////////////
+
+// clang-format off
+EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezSpatialSystem_AabbTree, 1, ezRTTINoAllocator)
+EZ_END_DYNAMIC_REFLECTED_TYPE;
+// clang-format on
+
+ezSpatialSystem_AabbTree::ezSpatialSystem_AabbTree(float fFatBoundsMargin /*= 1.0f*/)
+  : m_AlignedAllocator("Spatial System Aligned", ezFoundation::GetAlignedAllocator())
+  , m_fFatBoundsMargin(fFatBoundsMargin)
+  , m_Trees(&m_Allocator)
+  , m_DataTable(&m_Allocator)
+{
+  m_Trees.SetCount(MAX_NUM_TREES);
+}
+
+ezSpatialSystem_AabbTree::~ezSpatialSystem_AabbTree() = default;
+
+void ezSpatialSystem_AabbTree::CreateTrees(ezUInt32 uiCategoryBitmask)
+{
+  uiCategoryBitmask &= EZ_BIT(MAX_NUM_TREES) - 1;
+
+  while (uiCategoryBitmask > 0)
+  {
+    const ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiCategoryBitmask);
+    uiCategoryBitmask &= uiCategoryBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+    {
+      pTree = EZ_NEW(&m_Allocator, Tree, &m_AlignedAllocator, &m_Allocator);
+    }
+  }
+}
+
+template <typename Functor>
+EZ_FORCE_INLINE void ezSpatialSystem_AabbTree::ForEachTree(ezUInt32 uiCategoryBitmask, Functor func) const
+{
+  uiCategoryBitmask &= EZ_BIT(MAX_NUM_TREES) - 1;
+
+  while (uiCategoryBitmask > 0)
+  {
+    const ezUInt32 uiTreeIndex = ezMath::FirstBitLow(uiCategoryBitmask);
+    uiCategoryBitmask &= uiCategoryBitmask - 1;
+
+    auto& pTree = m_Trees[uiTreeIndex];
+    if (pTree == nullptr)
+      continue;
+
+    func(*pTree);
+  }
+}
+
+ezResult ezSpatialSystem_AabbTree::GetLeafBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_boundingBox) const
+{
+  Data* pData = nullptr;
+  if (!m_DataTable.TryGetValue(hData.GetInternalID(), pData) || pData->m_bAlwaysVisible)
+    return EZ_FAILURE;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  const Tree& tree = *m_Trees[ezMath::FirstBitLow(pData->m_uiCategoryBitmask)];
+
+  out_boundingBox = ezSimdConversion::ToBBox(tree.m_Nodes[tree.m_DataToLeaf[uiDataIndex]].m_Bounds);
+  return EZ_SUCCESS;
+}
+
+void ezSpatialSystem_AabbTree::GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory /*= ezInvalidSpatialDataCategory*/, ezUInt32 uiMaxDepth /*= 8*/) const
+{
+  const ezUInt32 uiCategoryBitmask = filterCategory != ezInvalidSpatialDataCategory ? filterCategory.GetBitmask() : 0xFFFFFFFF;
+
+  ForEachTree(uiCategoryBitmask,
+    [&](const Tree& tree) {
+      if (tree.m_uiRootIndex == ezInvalidIndex)
+        return;
+
+      ezHybridArray<ezUInt32, 128> stack;
+      ezHybridArray<ezUInt32, 128> depthStack;
+      stack.PushBack(tree.m_uiRootIndex);
+      depthStack.PushBack(0);
+
+      while (!stack.IsEmpty())
+      {
+        const Node& node = tree.m_Nodes[stack.PeekBack()];
+        const ezUInt32 uiDepth = depthStack.PeekBack();
+        stack.PopBack();
+        depthStack.PopBack();
+
+        if (node.IsLeaf())
+          continue;
+
+        out_boundingBoxes.PushBack(ezSimdConversion::ToBBox(node.m_Bounds));
+
+        if (uiDepth < uiMaxDepth)
+        {
+          stack.PushBack(node.m_uiChildren[0]);
+          stack.PushBack(node.m_uiChildren[1]);
+          depthStack.PushBack(uiDepth + 1);
+          depthStack.PushBack(uiDepth + 1);
+        }
+      }
+    });
+}
+
+void ezSpatialSystem_AabbTree::StartNewFrame()
+{
+  SUPER::StartNewFrame();
+
+  EZ_PROFILE_SCOPE("RebuildAabbTrees");
+
+  for (auto& pTree : m_Trees)
+  {
+    if (pTree != nullptr && pTree->NeedsRebuild())
+    {
+      pTree->Rebuild();
+    }
+  }
+}
+
+ezSpatialDataHandle ezSpatialSystem_AabbTree::CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  Data data;
+  data.m_pObject = pObject;
+  data.m_Tags = tags;
+  data.m_vBoxHalfExtents = ezSimdConversion::ToVec3(bounds.m_BoxHalfExtents);
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+
+  CreateTrees(uiCategoryBitmask);
+  MarkModified(uiCategoryBitmask);
+
+  auto hData = ezSpatialDataHandle(m_DataTable.Insert(std::move(data)));
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  const ezSimdBSphere sphere = bounds.GetSphere();
+
+  ForEachTree(uiCategoryBitmask,
+    [&](Tree& ref_tree) {
+      ref_tree.AddSpatialData(uiDataIndex, sphere, pObject);
+    });
+
+  return hData;
+}
+
+ezSpatialDataHandle ezSpatialSystem_AabbTree::CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags)
+{
+  if (uiCategoryBitmask == 0)
+    return ezSpatialDataHandle();
+
+  Data data;
+  data.m_pObject = pObject;
+  data.m_Tags = tags;
+  data.m_uiCategoryBitmask = uiCategoryBitmask;
+  data.m_bAlwaysVisible = true;
+
+  CreateTrees(uiCategoryBitmask);
+  MarkModified(uiCategoryBitmask);
+
+  auto hData = ezSpatialDataHandle(m_DataTable.Insert(std::move(data)));
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(uiCategoryBitmask,
+    [&](Tree& ref_tree) {
+      ref_tree.AddAlwaysVisibleData(uiDataIndex);
+    });
+
+  return hData;
+}
+
+void ezSpatialSystem_AabbTree::DeleteSpatialData(const ezSpatialDataHandle& hData)
+{
+  Data oldData;
+  EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
+
+  MarkModified(oldData.m_uiCategoryBitmask);
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(oldData.m_uiCategoryBitmask,
+    [&](Tree& ref_tree) {
+      if (oldData.m_bAlwaysVisible)
+      {
+        ref_tree.RemoveAlwaysVisibleData(uiDataIndex);
+      }
+      else
+      {
+        ref_tree.RemoveSpatialData(uiDataIndex);
+      }
+    });
+}
+
+void ezSpatialSystem_AabbTree::UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  // No need to update bounds for always visible data
+  if (pData->m_bAlwaysVisible)
+    return;
+
+  MarkModified(pData->m_uiCategoryBitmask);
+
+  pData->m_vBoxHalfExtents = ezSimdConversion::ToVec3(bounds.m_BoxHalfExtents);
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+  const ezSimdBSphere sphere = bounds.GetSphere();
+
+  ForEachTree(pData->m_uiCategoryBitmask,
+    [&](Tree& ref_tree) {
+      ref_tree.UpdateSpatialData(uiDataIndex, sphere, m_fFatBoundsMargin);
+    });
+}
+
+void ezSpatialSystem_AabbTree::UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject)
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  pData->m_pObject = pObject;
+  MarkModified(pData->m_uiCategoryBitmask);
+
+  if (pData->m_bAlwaysVisible)
+    return;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ForEachTree(pData->m_uiCategoryBitmask,
+    [&](Tree& ref_tree) {
+      ref_tree.m_Nodes[ref_tree.m_DataToLeaf[uiDataIndex]].m_pObject = pObject;
+    });
+}
+
+void ezSpatialSystem_AabbTree::FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInSphere");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const ezSimdBSphere simdSphere(ezSimdConversion::ToVec3(sphere.m_vCenter), sphere.m_fRadius);
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+
+  ezInternal::AabbTreeQueryHelper::Stats stats;
+  ezVisitorExecution::Enum res = ezVisitorExecution::Continue;
+
+  ForEachTree(queryParams.m_uiCategoryBitmask,
+    [&](const Tree& tree) {
+      if (res == ezVisitorExecution::Continue)
+      {
+        res = ezInternal::AabbTreeQueryHelper::ShapeQuery(*this, tree, simdSphere, queryParams, bUseTagsFilter, callback, stats);
+      }
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+void ezSpatialSystem_AabbTree::FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const
+{
+  EZ_PROFILE_SCOPE("FindObjectsInBox");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  const ezSimdBBox simdBox(ezSimdConversion::ToVec3(box.m_vMin), ezSimdConversion::ToVec3(box.m_vMax));
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+
+  ezInternal::AabbTreeQueryHelper::Stats stats;
+  ezVisitorExecution::Enum res = ezVisitorExecution::Continue;
+
+  ForEachTree(queryParams.m_uiCategoryBitmask,
+    [&](const Tree& tree) {
+      if (res == ezVisitorExecution::Continue)
+      {
+        res = ezInternal::AabbTreeQueryHelper::ShapeQuery(*this, tree, simdBox, queryParams, bUseTagsFilter, callback, stats);
+      }
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+void ezSpatialSystem_AabbTree::FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const
+{
+  EZ_PROFILE_SCOPE("FindVisibleObjects");
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ezStopwatch timer;
+#endif
+
+  ezInternal::AabbTreeQueryHelper::FrustumQueryData queryData;
+  {
+    // Compiler is too stupid to properly unroll a constant loop so we do it by hand
+    ezSimdVec4f plane0 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(0).m_vNormal.x)));
+    ezSimdVec4f plane1 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(1).m_vNormal.x)));
+    ezSimdVec4f plane2 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(2).m_vNormal.x)));
+    ezSimdVec4f plane3 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(3).m_vNormal.x)));
+    ezSimdVec4f plane4 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(4).m_vNormal.x)));
+    ezSimdVec4f plane5 = ezSimdConversion::ToVec4(*reinterpret_cast<const ezVec4*>(&(frustum.GetPlane(5).m_vNormal.x)));
+
+    ezSimdMat4f helperMat;
+    helperMat.SetRows(plane0, plane1, plane2, plane3);
+
+    queryData.m_PlaneData.m_x0x1x2x3 = helperMat.m_col0;
+    queryData.m_PlaneData.m_y0y1y2y3 = helperMat.m_col1;
+    queryData.m_PlaneData.m_z0z1z2z3 = helperMat.m_col2;
+    queryData.m_PlaneData.m_w0w1w2w3 = helperMat.m_col3;
+
+    helperMat.SetRows(plane4, plane5, plane4, plane5);
+
+    queryData.m_PlaneData.m_x4x5x4x5 = helperMat.m_col0;
+    queryData.m_PlaneData.m_y4y5y4y5 = helperMat.m_col1;
+    queryData.m_PlaneData.m_z4z5z4z5 = helperMat.m_col2;
+    queryData.m_PlaneData.m_w4w5w4w5 = helperMat.m_col3;
+
+    queryData.m_pOutObjects = &out_Objects;
+    queryData.m_iFrameIdxAndType = static_cast<ezInt64>((m_uiFrameCounter << 4) | static_cast<ezUInt64>(visType));
+    queryData.m_IsOccludedCB = IsOccluded;
+  }
+
+  const bool bUseTagsFilter = !queryParams.m_IncludeTags.IsEmpty() || !queryParams.m_ExcludeTags.IsEmpty();
+
+  using QueryFunc = void (*)(const ezSpatialSystem_AabbTree&, const Tree&, const ezInternal::AabbTreeQueryHelper::FrustumQueryData&, const QueryParams&, ezInternal::AabbTreeQueryHelper::Stats&);
+  QueryFunc queryFunc = nullptr;
+  if (IsOccluded.IsValid())
+  {
+    queryFunc = bUseTagsFilter ? &ezInternal::AabbTreeQueryHelper::FrustumQuery<true, true> : &ezInternal::AabbTreeQueryHelper::FrustumQuery<false, true>;
+  }
+  else
+  {
+    queryFunc = bUseTagsFilter ? &ezInternal::AabbTreeQueryHelper::FrustumQuery<true, false> : &ezInternal::AabbTreeQueryHelper::FrustumQuery<false, false>;
+  }
+
+  ezInternal::AabbTreeQueryHelper::Stats stats;
+
+  ForEachTree(queryParams.m_uiCategoryBitmask,
+    [&](const Tree& tree) {
+      queryFunc(*this, tree, queryData, queryParams, stats);
+    });
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (queryParams.m_pStats != nullptr)
+  {
+    queryParams.m_pStats->m_uiTotalNumObjects = m_DataTable.GetCount();
+    queryParams.m_pStats->m_uiNumObjectsTested += stats.m_uiNumObjectsTested;
+    queryParams.m_pStats->m_uiNumObjectsPassed += stats.m_uiNumObjectsPassed;
+    queryParams.m_pStats->m_TimeTaken = timer.GetRunningTotal();
+  }
+#endif
+}
+
+ezVisibilityState ezSpatialSystem_AabbTree::GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const
+{
+  Data* pData = nullptr;
+  EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
+
+  if (pData->m_bAlwaysVisible)
+    return ezVisibilityState::Direct;
+
+  const ezUInt32 uiDataIndex = hData.GetInternalID().m_InstanceIndex;
+
+  ezUInt64 uiLastVisibleFrameIdxAndVisType = 0;
+  ForEachTree(pData->m_uiCategoryBitmask,
+    [&](const Tree& tree) {
+      const Node& leaf = tree.m_Nodes[tree.m_DataToLeaf[uiDataIndex]];
+      uiLastVisibleFrameIdxAndVisType = ezMath::Max<ezUInt64>(uiLastVisibleFrameIdxAndVisType, leaf.m_iLastVisibleFrameIdxAndVisType);
+    });
+
+  const ezUInt64 uiLastVisibleFrameIdx = (uiLastVisibleFrameIdxAndVisType >> 4);
+  const ezUInt64 uiLastVisibilityType = (uiLastVisibleFrameIdxAndVisType & static_cast<ezUInt64>(15)); // mask out lower 4 bits
+
+  if (m_uiFrameCounter > uiLastVisibleFrameIdx + uiNumFramesBeforeInvisible)
+    return ezVisibilityState::Invisible;
+
+  return static_cast<ezVisibilityState>(uiLastVisibilityType);
+}
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+void ezSpatialSystem_AabbTree::GetInternalStats(ezStringBuilder& sb) const
+{
+  sb = "AABB Trees:\n";
+
+  for (ezUInt32 i = 0; i < m_Trees.GetCount(); ++i)
+  {
+    auto& pTree = m_Trees[i];
+    if (pTree == nullptr)
+      continue;
+
+    const ezInt32 iHeight = pTree->m_uiRootIndex != ezInvalidIndex ? pTree->m_Nodes[pTree->m_uiRootIndex].m_iHeight : 0;
+
+    sb.AppendFormat(" \nCategory: {}\nLeaves: {}\nAlways Visible: {}\nHeight: {}\nChanges since rebuild: {}\n", i, pTree->m_uiNumLeaves, pTree->m_AlwaysVisibleData.GetCount(), iHeight, pTree->m_uiNumChangesSinceRebuild);
+  }
+}
+#endif
+
+EZ_STATICLINK_FILE(Core, Core_World_Implementation_SpatialSystem_AabbTree);
@@ -744,6 +744,8 @@ void ezSpatialSystem_RegularGrid::DeleteSpatialData(const ezSpatialDataHandle& h
   Data oldData;
   EZ_VERIFY(m_DataTable.Remove(hData.GetInternalID(), &oldData), "Invalid spatial data handle");
 
+  MarkModified(GetCategoryBitmask(oldData));
+
   ForEachGrid(oldData, hData,
     [&](Grid& ref_grid, const CellDataMapping& mapping) {
       ref_grid.RemoveSpatialData(hData);
@@ -760,6 +762,8 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataBounds(const ezSpatialDataHan
   if (IsAlwaysVisibleData(*pData))
     return;
 
+  MarkModified(GetCategoryBitmask(*pData));
+
   ForEachGrid(*pData, hData,
     [&](Grid& ref_grid, const CellDataMapping& mapping) {
       auto& pOldCell = ref_grid.m_Cells[mapping.m_uiCellIndex];
@@ -790,6 +794,8 @@ void ezSpatialSystem_RegularGrid::UpdateSpatialDataObject(const ezSpatialDataHan
   Data* pData = nullptr;
   EZ_VERIFY(m_DataTable.TryGetValue(hData.GetInternalID(), pData), "Invalid spatial data handle");
 
+  MarkModified(GetCategoryBitmask(*pData));
+
   ForEachGrid(*pData, hData,
     [&](Grid& ref_grid, const CellDataMapping& mapping) {
       auto& pCell = ref_grid.m_Cells[mapping.m_uiCellIndex];
@@ -966,12 +972,20 @@ EZ_ALWAYS_INLINE bool ezSpatialSystem_RegularGrid::IsAlwaysVisibleData(const Dat
   return data.m_uiAlwaysVisible != 0;
 }
 
+EZ_ALWAYS_INLINE ezUInt32 ezSpatialSystem_RegularGrid::GetCategoryBitmask(const Data& data) const
+{
+  // the first grids are the category grids, cached grids come after them
+  return static_cast<ezUInt32>(data.m_uiGridBitmask & (EZ_BIT(MAX_NUM_REGULAR_GRIDS) - 1));
+}
+
 ezSpatialDataHandle ezSpatialSystem_RegularGrid::AddSpatialDataToGrids(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible)
 {
   Data data;
   data.m_uiGridBitmask = uiCategoryBitmask;
   data.m_uiAlwaysVisible = bAlwaysVisible ? 1 : 0;
 
+  MarkModified(uiCategoryBitmask);
+
   // find matching cached grids and add them to data.m_uiGridBitmask
   for (ezUInt32 uiCachedGridIndex = m_uiFirstCachedGridIndex; uiCachedGridIndex < m_Grids.GetCount(); ++uiCachedGridIndex)
   {
@@ -587,9 +587,9 @@ void ezWorld::DeleteModule(const ezRTTI* pRtti)
 
 ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti)
 {
-  CheckForWriteAccess();
-
   const ezWorldModuleTypeId uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+  CheckForModuleWriteAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return m_Data.m_Modules[uiTypeId];
@@ -600,9 +600,9 @@ ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti)
 
 const ezWorldModule* ezWorld::GetModule(const ezRTTI* pRtti) const
 {
-  CheckForReadAccess();
-
   const ezWorldModuleTypeId uiTypeId = ezWorldModuleFactory::GetInstance()->GetTypeId(pRtti);
+  CheckForModuleReadAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return m_Data.m_Modules[uiTypeId];
@@ -1000,6 +1000,7 @@ void ezWorld::DeregisterUpdateFunction(const ezComponentManagerBase::UpdateFunct
     if (updateFunctions[i].m_Function.IsEqualIfComparable(desc.m_Function))
     {
       updateFunctions.RemoveAtAndCopy(i);
+      m_Data.m_bParallelSchedulesDirty = true;
     }
   }
 }
@@ -1017,6 +1018,7 @@ void ezWorld::DeregisterUpdateFunctions(ezWorldModule* pModule)
       if (updateFunctions[i].m_Function.GetClassInstance() == pModule)
       {
         updateFunctions.RemoveAtAndCopy(i);
+        m_Data.m_bParallelSchedulesDirty = true;
       }
     }
   }
@@ -1036,12 +1038,34 @@ void ezWorld::UpdateFromThread()
 
 void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
 {
+  if (m_Data.m_bParallelSchedulesDirty)
+  {
+    UpdateParallelSchedules();
+  }
+
   ezWorldModule::UpdateContext context;
   context.m_uiFirstComponentIndex = 0;
   context.m_uiComponentCount = ezInvalidIndex;
 
-  for (auto& updateFunction : updateFunctions)
+  for (ezUInt32 i = 0; i < updateFunctions.GetCount();)
   {
+    if (m_Data.m_bParallelSynchronousUpdates && updateFunctions[i].m_bDeclaresDataAccess)
+    {
+      // run all consecutive functions with declared data access as one parallel batch
+      ezUInt32 uiBatchEnd = i + 1;
+      while (uiBatchEnd < updateFunctions.GetCount() && updateFunctions[uiBatchEnd].m_bDeclaresDataAccess)
+      {
+        ++uiBatchEnd;
+      }
+
+      UpdateSynchronousInParallel(updateFunctions.GetSubArray(i, uiBatchEnd - i));
+      i = uiBatchEnd;
+      continue;
+    }
+
+    auto& updateFunction = updateFunctions[i];
+    ++i;
+
     if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_Data.m_bSimulateWorld)
       continue;
 
@@ -1052,6 +1076,93 @@ void ezWorld::UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::Register
   }
 }
 
+void ezWorld::UpdateSynchronousInParallel(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions)
+{
+  // The world stays marked for writing by this thread. While a function of the batch runs, the access checks are done against its
+  // declared data instead, see ezWorld::CheckForModuleWriteAccess, and modifying the world structure is not allowed at all.
+  if (updateFunctions.GetCount() == 1)
+  {
+    m_Data.RunParallelUpdateFunction(updateFunctions[0]);
+    return;
+  }
+
+  auto& taskGroups = m_Data.m_ParallelUpdateTaskGroups;
+  taskGroups.Clear();
+
+  for (ezUInt32 i = 0; i < updateFunctions.GetCount(); ++i)
+  {
+    auto& updateFunction = updateFunctions[i];
+
+    ezSharedPtr<ezInternal::WorldData::ParallelUpdateTask> pTask;
+    if (i < m_Data.m_ParallelUpdateTasks.GetCount())
+    {
+      pTask = m_Data.m_ParallelUpdateTasks[i];
+    }
+    else
+    {
+      pTask = EZ_NEW(&m_Data.m_Allocator, ezInternal::WorldData::ParallelUpdateTask);
+      m_Data.m_ParallelUpdateTasks.PushBack(pTask);
+    }
+
+    pTask->ConfigureTask(updateFunction.m_sFunctionName, ezTaskNesting::Maybe);
+    pTask->m_pWorldData = &m_Data;
+    pTask->m_pFunction = &updateFunction;
+
+    ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
+    ezTaskSystem::AddTaskToGroup(taskGroupId, pTask);
+
+    for (ezUInt32 uiDependency : updateFunction.m_ParallelDependencies)
+    {
+      ezTaskSystem::AddTaskGroupDependency(taskGroupId, taskGroups[uiDependency]);
+    }
+
+    taskGroups.PushBack(taskGroupId);
+  }
+
+  ezTaskSystem::StartTaskGroupBatch(taskGroups);
+
+  for (ezTaskGroupID taskGroupId : taskGroups)
+  {
+    ezTaskSystem::WaitForGroup(taskGroupId);
+  }
+}
+
+void ezWorld::UpdateParallelSchedules()
+{
+  m_Data.m_bParallelSchedulesDirty = false;
+
+  for (ezUInt32 phase = ezWorldModule::UpdateFunctionDesc::Phase::PreAsync; phase < ezWorldModule::UpdateFunctionDesc::Phase::COUNT; ++phase)
+  {
+    if (phase == ezWorldModule::UpdateFunctionDesc::Phase::Async)
+      continue;
+
+    auto& updateFunctions = m_Data.m_UpdateFunctions[phase];
+
+    // The functions are already sorted by dependencies and priority. Within a batch of functions with declared data access
+    // each function has to wait for all previous functions that it conflicts with, which keeps the serial order for those.
+    ezUInt32 uiBatchStart = 0;
+    for (ezUInt32 i = 0; i < updateFunctions.GetCount(); ++i)
+    {
+      auto& updateFunction = updateFunctions[i];
+      updateFunction.m_ParallelDependencies.Clear();
+
+      if (!updateFunction.m_bDeclaresDataAccess)
+      {
+        uiBatchStart = i + 1;
+        continue;
+      }
+
+      for (ezUInt32 j = uiBatchStart; j < i; ++j)
+      {
+        if (updateFunctions[j].MustRunBefore(updateFunction))
+        {
+          updateFunction.m_ParallelDependencies.PushBack(j - uiBatchStart);
+        }
+      }
+    }
+  }
+}
+
 void ezWorld::UpdateAsynchronous()
 {
   ezTaskGroupID taskGroupId = ezTaskSystem::CreateTaskGroup(ezTaskPriority::EarlyThisFrame);
@@ -1291,6 +1402,18 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   ezInternal::WorldData::RegisteredUpdateFunction newFunction;
   newFunction.FillFromDesc(desc);
 
+  if (newFunction.m_bDeclaresDataAccess)
+  {
+    // the module that registered the function is always written
+    const ezUInt32 uiModuleIndex = m_Data.m_Modules.IndexOf(static_cast<ezWorldModule*>(desc.m_Function.GetClassInstance()));
+    if (const ezRTTI* pType = ezWorldModuleFactory::GetInstance()->GetRegisteredType(static_cast<ezWorldModuleTypeId>(uiModuleIndex)))
+    {
+      newFunction.m_WritesTo.PushBack(pType);
+    }
+  }
+
+  m_Data.m_bParallelSchedulesDirty = true;
+
   while (uiInsertionIndex < updateFunctions.GetCount())
   {
     const auto& existingFunction = updateFunctions[uiInsertionIndex];
@@ -1307,6 +1430,35 @@ ezResult ezWorld::RegisterUpdateFunctionInternal(const ezWorldModule::UpdateFunc
   return EZ_SUCCESS;
 }
 
+void ezWorld::ValidateParallelModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const
+{
+  if (ezInternal::WorldData::GetParallelUpdateContext().m_pWorldData != &m_Data || uiTypeId >= m_Data.m_Modules.GetCount() || m_Data.m_Modules[uiTypeId] == nullptr)
+    return;
+
+  if (const ezRTTI* pType = ezWorldModuleFactory::GetInstance()->GetRegisteredType(uiTypeId))
+  {
+    ValidateParallelAccess(pType, bWrite);
+  }
+}
+
+void ezWorld::ValidateParallelAccess(const ezRTTI* pType, bool bWrite) const
+{
+  const auto& context = ezInternal::WorldData::GetParallelUpdateContext();
+  if (context.m_pWorldData != &m_Data)
+    return;
+
+  if (bWrite)
+  {
+    EZ_ASSERT_DEV(context.m_pFunction->HasDeclaredAccess(pType, true), "Update function '{}' writes to '{}' in World '{}', but doesn't declare it in m_WritesTo.",
+      context.m_pFunction->m_sFunctionName, pType->GetTypeName(), GetName());
+  }
+  else
+  {
+    EZ_ASSERT_DEV(context.m_pFunction->HasDeclaredAccess(pType, false), "Update function '{}' reads from '{}' in World '{}', but doesn't declare it in m_ReadsFrom or m_WritesTo.",
+      context.m_pFunction->m_sFunctionName, pType->GetTypeName(), GetName());
+  }
+}
+
 void ezWorld::DeleteDeadObjects()
 {
   while (!m_Data.m_DeadObjects.IsEmpty())
@@ -5,6 +5,7 @@
 #include <Core/World/SpatialSystem_RegularGrid.h>
 #include <Core/World/World.h>
 
+#include <Foundation/Profiling/Profiling.h>
 #include <Foundation/Time/DefaultTimeStepSmoothing.h>
 
 namespace ezInternal
@@ -36,6 +37,89 @@ namespace ezInternal
     m_Function(context);
   }
 
+  void WorldData::ParallelUpdateTask::Execute()
+  {
+    m_pWorldData->RunParallelUpdateFunction(*m_pFunction);
+  }
+
+  WorldData::ParallelUpdateContext& WorldData::GetParallelUpdateContext()
+  {
+    thread_local ParallelUpdateContext s_Context;
+    return s_Context;
+  }
+
+  void WorldData::RunParallelUpdateFunction(const RegisteredUpdateFunction& updateFunction) const
+  {
+    if (updateFunction.m_bOnlyUpdateWhenSimulating && !m_bSimulateWorld)
+      return;
+
+    // a task might execute another update function while waiting, so restore the previous context afterwards
+    ParallelUpdateContext& context = GetParallelUpdateContext();
+    const ParallelUpdateContext previousContext = context;
+    context.m_pWorldData = this;
+    context.m_pFunction = &updateFunction;
+
+    {
+      EZ_PROFILE_SCOPE(updateFunction.m_sFunctionName);
+
+      ezWorldModule::UpdateContext updateContext;
+      updateContext.m_uiFirstComponentIndex = 0;
+      updateContext.m_uiComponentCount = ezInvalidIndex;
+
+      updateFunction.m_Function(updateContext);
+    }
+
+    context = previousContext;
+  }
+
+  bool WorldData::RegisteredUpdateFunction::HasDeclaredAccess(const ezRTTI* pType, bool bWrite) const
+  {
+    for (const ezRTTI* pDeclaredType : m_WritesTo)
+    {
+      if (pType->IsDerivedFrom(pDeclaredType))
+        return true;
+    }
+
+    if (bWrite)
+      return false;
+
+    for (const ezRTTI* pDeclaredType : m_ReadsFrom)
+    {
+      if (pType->IsDerivedFrom(pDeclaredType))
+        return true;
+    }
+
+    return false;
+  }
+
+  namespace
+  {
+    bool Overlaps(ezArrayPtr<const ezRTTI* const> a, ezArrayPtr<const ezRTTI* const> b)
+    {
+      for (const ezRTTI* pTypeA : a)
+      {
+        for (const ezRTTI* pTypeB : b)
+        {
+          if (pTypeA->IsDerivedFrom(pTypeB) || pTypeB->IsDerivedFrom(pTypeA))
+            return true;
+        }
+      }
+
+      return false;
+    }
+  } // namespace
+
+  bool WorldData::RegisteredUpdateFunction::MustRunBefore(const RegisteredUpdateFunction& other) const
+  {
+    if (!m_bDeclaresDataAccess || !other.m_bDeclaresDataAccess)
+      return true;
+
+    if (other.m_DependsOn.Contains(m_sFunctionName))
+      return true;
+
+    return Overlaps(m_WritesTo, other.m_WritesTo) || Overlaps(m_WritesTo, other.m_ReadsFrom) || Overlaps(m_ReadsFrom, other.m_WritesTo);
+  }
+
   ////////////////////////////////////////////////////////////////////////////////////////////////////
 
   WorldData::WorldData(ezWorldDesc& desc)
@@ -49,6 +133,7 @@ namespace ezInternal
     , m_Clock(desc.m_sName)
     , m_WriteThreadID((ezThreadID)0)
     , m_bReportErrorWhenStaticObjectMoves(desc.m_bReportErrorWhenStaticObjectMoves)
+    , m_bParallelSynchronousUpdates(desc.m_bParallelSynchronousUpdates)
     , m_ReadMarker(*this)
     , m_WriteMarker(*this)
 
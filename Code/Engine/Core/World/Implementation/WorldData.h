@@ -181,9 +181,21 @@ namespace ezInternal
       float m_fPriority;
       ezUInt16 m_uiGranularity;
       bool m_bOnlyUpdateWhenSimulating;
+      bool m_bDeclaresDataAccess;
+
+      ezHybridArray<ezHashedString, 4> m_DependsOn;
+      ezHybridArray<const ezRTTI*, 2> m_ReadsFrom;
+      ezHybridArray<const ezRTTI*, 3> m_WritesTo;
+
+      /// Indices (relative to the start of the parallel batch) of the functions that have to finish before this one can start.
+      ezHybridArray<ezUInt32, 4> m_ParallelDependencies;
 
       void FillFromDesc(const ezWorldModule::UpdateFunctionDesc& desc);
       bool operator<(const RegisteredUpdateFunction& other) const;
+
+      /// Whether the given type is declared in m_WritesTo or, if bWrite is false, also in m_ReadsFrom.
+      bool HasDeclaredAccess(const ezRTTI* pType, bool bWrite) const;
+      bool MustRunBefore(const RegisteredUpdateFunction& other) const;
     };
 
     struct UpdateTask final : public ezTask
@@ -195,10 +207,31 @@ namespace ezInternal
       ezUInt32 m_uiCount;
     };
 
+    struct ParallelUpdateTask final : public ezTask
+    {
+      virtual void Execute() override;
+
+      const WorldData* m_pWorldData = nullptr;
+      const RegisteredUpdateFunction* m_pFunction = nullptr;
+    };
+
+    /// The parallel synchronous update function that is currently executed on this thread, used to validate its data access.
+    struct ParallelUpdateContext
+    {
+      const WorldData* m_pWorldData = nullptr;
+      const RegisteredUpdateFunction* m_pFunction = nullptr;
+    };
+
+    static ParallelUpdateContext& GetParallelUpdateContext();
+    void RunParallelUpdateFunction(const RegisteredUpdateFunction& updateFunction) const;
+
     ezDynamicArray<RegisteredUpdateFunction, ezLocalAllocatorWrapper> m_UpdateFunctions[ezWorldModule::UpdateFunctionDesc::Phase::COUNT];
     ezDynamicArray<ezWorldModule::UpdateFunctionDesc, ezLocalAllocatorWrapper> m_UpdateFunctionsToRegister;
+    bool m_bParallelSchedulesDirty = true;
 
     ezDynamicArray<ezSharedPtr<UpdateTask>, ezLocalAllocatorWrapper> m_UpdateTasks;
+    ezDynamicArray<ezSharedPtr<ParallelUpdateTask>, ezLocalAllocatorWrapper> m_ParallelUpdateTasks;
+    ezDynamicArray<ezTaskGroupID, ezLocalAllocatorWrapper> m_ParallelUpdateTaskGroups;
 
     ezUniquePtr<ezSpatialSystem> m_pSpatialSystem;
     ezSharedPtr<ezCoordinateSystemProvider> m_pCoordinateSystemProvider;
@@ -243,6 +276,7 @@ namespace ezInternal
     ezUInt32 m_uiUpdateCounter = 0;
     bool m_bSimulateWorld = true;
     bool m_bReportErrorWhenStaticObjectMoves = true;
+    bool m_bParallelSynchronousUpdates = true;
 
     /// \brief Maps some data (given as void*) to an ezGameObjectHandle. Only available in special situations (e.g. editor use cases).
     ezDelegate<ezGameObjectHandle(const void*, ezComponentHandle, ezStringView)> m_GameObjectReferenceResolver;
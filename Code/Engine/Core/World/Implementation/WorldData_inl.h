@@ -198,6 +198,10 @@ namespace ezInternal
     m_fPriority = desc.m_fPriority;
     m_uiGranularity = desc.m_uiGranularity;
     m_bOnlyUpdateWhenSimulating = desc.m_bOnlyUpdateWhenSimulating;
+    m_bDeclaresDataAccess = desc.m_bDeclaresDataAccess && desc.m_Phase != ezWorldModule::UpdateFunctionDesc::Phase::Async;
+    m_DependsOn = desc.m_DependsOn;
+    m_ReadsFrom = desc.m_ReadsFrom;
+    m_WritesTo = desc.m_WritesTo;
   }
 
   EZ_FORCE_INLINE bool WorldData::RegisteredUpdateFunction::operator<(const RegisteredUpdateFunction& other) const
@@ -89,6 +89,16 @@ ezWorldModuleTypeId ezWorldModuleFactory::GetTypeId(const ezRTTI* pRtti)
   return uiTypeId;
 }
 
+const ezRTTI* ezWorldModuleFactory::GetRegisteredType(ezWorldModuleTypeId uiTypeId) const
+{
+  if (uiTypeId < m_CreatorFuncs.GetCount())
+  {
+    return m_CreatorFuncs[uiTypeId].m_pRtti;
+  }
+
+  return nullptr;
+}
+
 ezWorldModule* ezWorldModuleFactory::CreateWorldModule(ezWorldModuleTypeId typeId, ezWorld* pWorld)
 {
   if (typeId < m_CreatorFuncs.GetCount())
@@ -32,6 +32,7 @@ EZ_FORCE_INLINE bool ezWorld::IsValidObject(const ezGameObjectHandle& hObject) c
 EZ_FORCE_INLINE bool ezWorld::TryGetObject(const ezGameObjectHandle& hObject, ezGameObject*& out_pObject)
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(true);
   EZ_ASSERT_DEV(hObject.IsInvalidated() || hObject.m_InternalId.m_WorldIndex == m_uiIndex,
     "Object does not belong to this world. Expected world id {0} got id {1}", m_uiIndex, hObject.m_InternalId.m_WorldIndex);
 
@@ -41,6 +42,7 @@ EZ_FORCE_INLINE bool ezWorld::TryGetObject(const ezGameObjectHandle& hObject, ez
 EZ_FORCE_INLINE bool ezWorld::TryGetObject(const ezGameObjectHandle& hObject, const ezGameObject*& out_pObject) const
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(false);
   EZ_ASSERT_DEV(hObject.IsInvalidated() || hObject.m_InternalId.m_WorldIndex == m_uiIndex,
     "Object does not belong to this world. Expected world id {0} got id {1}", m_uiIndex, hObject.m_InternalId.m_WorldIndex);
 
@@ -53,6 +55,7 @@ EZ_FORCE_INLINE bool ezWorld::TryGetObject(const ezGameObjectHandle& hObject, co
 EZ_FORCE_INLINE bool ezWorld::TryGetObjectWithGlobalKey(const ezTempHashedString& sGlobalKey, ezGameObject*& out_pObject)
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(true);
   ezGameObjectId id;
   if (m_Data.m_GlobalKeyToIdTable.TryGetValue(sGlobalKey.GetHash(), id))
   {
@@ -66,6 +69,7 @@ EZ_FORCE_INLINE bool ezWorld::TryGetObjectWithGlobalKey(const ezTempHashedString
 EZ_FORCE_INLINE bool ezWorld::TryGetObjectWithGlobalKey(const ezTempHashedString& sGlobalKey, const ezGameObject*& out_pObject) const
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(false);
   ezGameObjectId id;
   if (m_Data.m_GlobalKeyToIdTable.TryGetValue(sGlobalKey.GetHash(), id))
   {
@@ -85,19 +89,20 @@ EZ_FORCE_INLINE ezUInt32 ezWorld::GetObjectCount() const
 
 EZ_FORCE_INLINE ezInternal::WorldData::ObjectIterator ezWorld::GetObjects()
 {
-  CheckForWriteAccess();
+  CheckForObjectWriteAccess();
   return ezInternal::WorldData::ObjectIterator(m_Data.m_ObjectStorage.GetIterator(0));
 }
 
 EZ_FORCE_INLINE ezInternal::WorldData::ConstObjectIterator ezWorld::GetObjects() const
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(false);
   return ezInternal::WorldData::ConstObjectIterator(m_Data.m_ObjectStorage.GetIterator(0));
 }
 
 EZ_FORCE_INLINE void ezWorld::Traverse(VisitorFunc visitorFunc, TraversalMethod method /*= DepthFirst*/)
 {
-  CheckForWriteAccess();
+  CheckForObjectWriteAccess();
 
   if (method == DepthFirst)
   {
@@ -203,9 +208,9 @@ EZ_FORCE_INLINE ManagerType* ezWorld::GetComponentManager()
 {
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponentManagerBase, ManagerType), "Not a valid component manager type");
 
-  CheckForWriteAccess();
-
   const ezWorldModuleTypeId uiTypeId = ManagerType::TypeId();
+  CheckForModuleWriteAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -219,9 +224,9 @@ EZ_FORCE_INLINE const ManagerType* ezWorld::GetComponentManager() const
 {
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponentManagerBase, ManagerType), "Not a valid component manager type");
 
-  CheckForReadAccess();
-
   const ezWorldModuleTypeId uiTypeId = ManagerType::TypeId();
+  CheckForModuleReadAccess(uiTypeId);
+
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
     return ezStaticCast<const ManagerType*>(m_Data.m_Modules[uiTypeId]);
@@ -263,10 +268,10 @@ inline bool ezWorld::IsValidComponent(const ezComponentHandle& hComponent) const
 template <typename ComponentType>
 inline bool ezWorld::TryGetComponent(const ezComponentHandle& hComponent, ComponentType*& out_pComponent)
 {
-  CheckForWriteAccess();
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezWorldModuleTypeId uiTypeId = hComponent.m_InternalId.m_TypeId;
+  CheckForModuleWriteAccess(uiTypeId);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -285,10 +290,10 @@ inline bool ezWorld::TryGetComponent(const ezComponentHandle& hComponent, Compon
 template <typename ComponentType>
 inline bool ezWorld::TryGetComponent(const ezComponentHandle& hComponent, const ComponentType*& out_pComponent) const
 {
-  CheckForReadAccess();
   EZ_CHECK_AT_COMPILETIME_MSG(EZ_IS_DERIVED_FROM_STATIC(ezComponent, ComponentType), "Not a valid component type");
 
   const ezWorldModuleTypeId uiTypeId = hComponent.m_InternalId.m_TypeId;
+  CheckForModuleReadAccess(uiTypeId);
 
   if (uiTypeId < m_Data.m_Modules.GetCount())
   {
@@ -400,7 +405,7 @@ EZ_ALWAYS_INLINE ezUInt32 ezWorld::GetUpdateCounter() const
 
 EZ_FORCE_INLINE ezSpatialSystem* ezWorld::GetSpatialSystem()
 {
-  CheckForWriteAccess();
+  CheckForObjectWriteAccess();
 
   return m_Data.m_pSpatialSystem.Borrow();
 }
@@ -408,6 +413,7 @@ EZ_FORCE_INLINE ezSpatialSystem* ezWorld::GetSpatialSystem()
 EZ_FORCE_INLINE const ezSpatialSystem* ezWorld::GetSpatialSystem() const
 {
   CheckForReadAccess();
+  ValidateParallelObjectAccess(false);
 
   return m_Data.m_pSpatialSystem.Borrow();
 }
@@ -542,10 +548,55 @@ EZ_ALWAYS_INLINE void ezWorld::CheckForReadAccess() const
 
 EZ_ALWAYS_INLINE void ezWorld::CheckForWriteAccess() const
 {
+  EZ_ASSERT_DEV(ezInternal::WorldData::GetParallelUpdateContext().m_pWorldData != &m_Data,
+    "Update function '{0}' modifies World '{1}', but functions with declared data access must not change the world structure.",
+    ezInternal::WorldData::GetParallelUpdateContext().m_pFunction->m_sFunctionName, GetName());
   EZ_ASSERT_DEV(
     m_Data.m_WriteThreadID == ezThreadUtils::GetCurrentThreadID(), "Trying to write to World '{0}', but it is not marked for writing.", GetName());
 }
 
+EZ_ALWAYS_INLINE void ezWorld::CheckForModuleWriteAccess(ezWorldModuleTypeId uiTypeId) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (ezInternal::WorldData::GetParallelUpdateContext().m_pWorldData == &m_Data)
+  {
+    ValidateParallelModuleAccess(uiTypeId, true);
+    return;
+  }
+#endif
+
+  CheckForWriteAccess();
+}
+
+EZ_ALWAYS_INLINE void ezWorld::CheckForModuleReadAccess(ezWorldModuleTypeId uiTypeId) const
+{
+  CheckForReadAccess();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ValidateParallelModuleAccess(uiTypeId, false);
+#endif
+}
+
+EZ_ALWAYS_INLINE void ezWorld::CheckForObjectWriteAccess() const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  if (ezInternal::WorldData::GetParallelUpdateContext().m_pWorldData == &m_Data)
+  {
+    ValidateParallelAccess(ezGetStaticRTTI<ezGameObject>(), true);
+    return;
+  }
+#endif
+
+  CheckForWriteAccess();
+}
+
+EZ_ALWAYS_INLINE void ezWorld::ValidateParallelObjectAccess(bool bWrite) const
+{
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  ValidateParallelAccess(ezGetStaticRTTI<ezGameObject>(), bWrite);
+#endif
+}
+
 EZ_ALWAYS_INLINE ezGameObject* ezWorld::GetObjectUnchecked(ezUInt32 uiIndex) const
 {
   return m_Data.m_Objects.GetValueUnchecked(uiIndex);
@@ -75,13 +75,25 @@ public:
   virtual ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const = 0;
 
   ///@}
+  /// \name Change Tracking
+  ///@{
+
+  /// \brief Returns a value that changes whenever spatial data of one of the given categories is created, deleted, moved or changes its object.
+  ///
+  /// This allows to cache query results and only query again when the result might be different. Always visible data doesn't count as moved.
+  ezUInt64 GetModificationCounter(ezUInt32 uiCategoryBitmask) const;
+
+  ///@}
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   virtual void GetInternalStats(ezStringBuilder& ref_sSb) const;
 #endif
 
 protected:
+  void MarkModified(ezUInt32 uiCategoryBitmask);
+
   ezProxyAllocator m_Allocator;
 
   ezUInt64 m_uiFrameCounter = 0;
+  ezUInt64 m_ModificationCounters[32] = {};
 };
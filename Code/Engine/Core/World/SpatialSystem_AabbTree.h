@@ -0,0 +1,90 @@
+#pragma once
+
+#include <Core/World/SpatialSystem.h>
+#include <Foundation/Containers/IdTable.h>
+#include <Foundation/Types/UniquePtr.h>
+
+namespace ezInternal
+{
+  struct AabbTreeQueryHelper;
+}
+
+/// \brief A spatial system that stores the spatial data of each category in a dynamic bounding volume hierarchy.
+///
+/// Every spatial data is a leaf in a binary AABB tree. Objects are inserted with their exact bounds. Once an object moves out of the
+/// bounds stored in its leaf, the leaf is re-inserted with enlarged ('fat') bounds, so that further small movements only update the
+/// exact bounds and don't touch the tree at all. Insertion and removal refit the bounds of all ancestors and keep the tree balanced
+/// with rotations. Since incremental insertion slowly degrades the tree quality, a tree is rebuilt from scratch with the surface area
+/// heuristic in StartNewFrame() once enough leaves have been inserted, removed or re-inserted since the last rebuild.
+///
+/// In contrast to ezSpatialSystem_RegularGrid the tree adapts to the distribution of the objects, which makes it a good fit for worlds
+/// with very unevenly distributed content. Set an instance as ezWorldDesc::m_pSpatialSystem to use it for a world.
+class EZ_CORE_DLL ezSpatialSystem_AabbTree : public ezSpatialSystem
+{
+  EZ_ADD_DYNAMIC_REFLECTION(ezSpatialSystem_AabbTree, ezSpatialSystem);
+
+public:
+  /// \param fFatBoundsMargin By how much the bounds of moving objects are enlarged in every direction.
+  ezSpatialSystem_AabbTree(float fFatBoundsMargin = 1.0f);
+  ~ezSpatialSystem_AabbTree();
+
+  /// \brief Returns the bounding box stored in the tree leaf of the given spatial data. Useful for debug visualizations.
+  ezResult GetLeafBoxForSpatialData(const ezSpatialDataHandle& hData, ezBoundingBox& out_boundingBox) const;
+
+  /// \brief Returns the bounding boxes of all tree nodes down to the given depth.
+  void GetAllNodeBoxes(ezDynamicArray<ezBoundingBox>& out_boundingBoxes, ezSpatialData::Category filterCategory = ezInvalidSpatialDataCategory, ezUInt32 uiMaxDepth = 8) const;
+
+private:
+  friend ezInternal::AabbTreeQueryHelper;
+
+  // ezSpatialSystem implementation
+  virtual void StartNewFrame() override;
+
+  ezSpatialDataHandle CreateSpatialData(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+  ezSpatialDataHandle CreateSpatialDataAlwaysVisible(ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags) override;
+
+  void DeleteSpatialData(const ezSpatialDataHandle& hData) override;
+
+  void UpdateSpatialDataBounds(const ezSpatialDataHandle& hData, const ezSimdBBoxSphere& bounds) override;
+  void UpdateSpatialDataObject(const ezSpatialDataHandle& hData, ezGameObject* pObject) override;
+
+  void FindObjectsInSphere(const ezBoundingSphere& sphere, const QueryParams& queryParams, QueryCallback callback) const override;
+  void FindObjectsInBox(const ezBoundingBox& box, const QueryParams& queryParams, QueryCallback callback) const override;
+
+  void FindVisibleObjects(const ezFrustum& frustum, const QueryParams& queryParams, ezDynamicArray<const ezGameObject*>& out_Objects, ezSpatialSystem::IsOccludedFunc IsOccluded, ezVisibilityState visType) const override;
+
+  ezVisibilityState GetVisibilityState(const ezSpatialDataHandle& hData, ezUInt32 uiNumFramesBeforeInvisible) const override;
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+  virtual void GetInternalStats(ezStringBuilder& sb) const override;
+#endif
+
+  ezProxyAllocator m_AlignedAllocator;
+
+  float m_fFatBoundsMargin;
+
+  enum
+  {
+    MAX_NUM_TREES = (sizeof(ezSpatialData::Category::m_uiValue) * 8)
+  };
+
+  struct Node;
+  struct Tree;
+  ezDynamicArray<ezUniquePtr<Tree>> m_Trees;
+
+  struct Data
+  {
+    ezGameObject* m_pObject = nullptr;
+    ezTagSet m_Tags;
+    ezVec3 m_vBoxHalfExtents = ezVec3::MakeZero();
+    ezUInt32 m_uiCategoryBitmask = 0;
+    bool m_bAlwaysVisible = false;
+  };
+
+  ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
+
+  void CreateTrees(ezUInt32 uiCategoryBitmask);
+
+  template <typename Functor>
+  void ForEachTree(ezUInt32 uiCategoryBitmask, Functor func) const;
+};
@@ -78,6 +78,7 @@ private:
   ezIdTable<ezSpatialDataId, Data, ezLocalAllocatorWrapper> m_DataTable;
 
   bool IsAlwaysVisibleData(const Data& data) const;
+  ezUInt32 GetCategoryBitmask(const Data& data) const;
 
   ezSpatialDataHandle AddSpatialDataToGrids(const ezSimdBBoxSphere& bounds, ezGameObject* pObject, ezUInt32 uiCategoryBitmask, const ezTagSet& tags, bool bAlwaysVisible);
 
@@ -18,6 +18,11 @@ class ezEventMessageHandlerComponent;
 /// * Actual deletion of dead objects and components are done now.
 /// * Transform update: The global transformation of dynamic objects is updated.
 /// * Post-transform phase: Another synchronous phase like the pre-async phase after the transformation has been updated.
+///
+/// Synchronous update functions that declare which data they access (see ezWorldModule::UpdateFunctionDesc::m_bDeclaresDataAccess) are
+/// run in parallel on the task system, as long as they don't conflict with each other. Conflicting functions and explicit dependencies are
+/// still executed in the order described above and functions without declared access act as a barrier, thus the result is the same as with
+/// a purely serial update.
 class EZ_CORE_DLL ezWorld final
 {
 public:
@@ -364,6 +369,17 @@ private:
   void CheckForReadAccess() const;
   void CheckForWriteAccess() const;
 
+  /// \brief Like CheckForWriteAccess, but also allows access from parallel synchronous update functions that declared the given module type in m_WritesTo.
+  void CheckForModuleWriteAccess(ezWorldModuleTypeId uiTypeId) const;
+  /// \brief Like CheckForReadAccess, but also validates the declared data access of a parallel synchronous update function.
+  void CheckForModuleReadAccess(ezWorldModuleTypeId uiTypeId) const;
+  /// \brief Like CheckForWriteAccess, but also allows access from parallel synchronous update functions that declared ezGameObject in m_WritesTo.
+  void CheckForObjectWriteAccess() const;
+  /// \brief Validates that a parallel synchronous update function running on this thread declared access to ezGameObject.
+  void ValidateParallelObjectAccess(bool bWrite) const;
+  void ValidateParallelModuleAccess(ezWorldModuleTypeId uiTypeId, bool bWrite) const;
+  void ValidateParallelAccess(const ezRTTI* pType, bool bWrite) const;
+
   ezGameObject* GetObjectUnchecked(ezUInt32 uiIndex) const;
 
   void SetParent(ezGameObject* pObject, ezGameObject* pNewParent,
@@ -390,7 +406,9 @@ private:
 
   void UpdateFromThread();
   void UpdateSynchronous(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
+  void UpdateSynchronousInParallel(const ezArrayPtr<ezInternal::WorldData::RegisteredUpdateFunction>& updateFunctions);
   void UpdateAsynchronous();
+  void UpdateParallelSchedules();
 
   // returns if the batch was completely initialized
   bool ProcessInitializationBatch(ezInternal::WorldData::InitBatch& batch, ezTime endTime);
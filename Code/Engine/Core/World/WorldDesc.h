@@ -27,5 +27,7 @@ struct ezWorldDesc
 
   bool m_bReportErrorWhenStaticObjectMoves = true;
 
+  bool m_bParallelSynchronousUpdates = true; ///< run synchronous update functions that declare their data access in parallel, see ezWorldModule::UpdateFunctionDesc
+
   ezTime m_MaxComponentInitializationTimePerFrame = ezTime::MakeFromHours(10000); // max time to spend on component initialization per frame
 };
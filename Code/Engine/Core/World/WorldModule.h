@@ -74,6 +74,17 @@ protected:
     ezUInt16 m_uiGranularity = 0;                 ///< The granularity in which batch updates should happen during the asynchronous phase. Has to be 0 for
                                                   ///< synchronous functions.
     float m_fPriority = 0.0f;                     ///< Higher priority (higher number) means that this function is called earlier than a function with lower priority.
+
+    /// \brief Whether m_ReadsFrom and m_WritesTo describe all data that this function accesses.
+    ///
+    /// Synchronous functions that declare their data access are run in parallel to other such functions they don't conflict with.
+    /// The type of the module that registers the function is always considered written. A function with declared access must not modify
+    /// the world itself, i.e. it must not create or delete objects or components, change the hierarchy or send messages, and it must not
+    /// touch game object data unless it declares ezGameObject. In development builds ezWorld asserts when such a function modifies the world
+    /// structure, looks up a module, component or game object it hasn't declared, or requests a mutable one that isn't declared in m_WritesTo.
+    bool m_bDeclaresDataAccess = false;
+    ezHybridArray<const ezRTTI*, 2> m_ReadsFrom; ///< Component or world module types (or ezGameObject) that this function reads. Derived types are included.
+    ezHybridArray<const ezRTTI*, 2> m_WritesTo;  ///< Component or world module types (or ezGameObject) that this function writes. Derived types are included.
   };
 
   /// \brief Registers the given update function at the world.
@@ -124,6 +135,9 @@ public:
   /// \brief Returns the module type id to the given rtti module/component type.
   ezWorldModuleTypeId GetTypeId(const ezRTTI* pRtti);
 
+  /// \brief Returns the rtti type that was registered for the given module type id. For component managers this is the component type.
+  const ezRTTI* GetRegisteredType(ezWorldModuleTypeId uiTypeId) const;
+
   /// \brief Creates a new instance of the world module with the given type id and world.
   ezWorldModule* CreateWorldModule(ezUInt16 uiTypeId, ezWorld* pWorld);
 
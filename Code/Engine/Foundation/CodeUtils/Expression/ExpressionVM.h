@@ -12,8 +12,25 @@ public:
   void RegisterFunction(const ezExpressionFunction& func);
   void UnregisterFunction(const ezExpressionFunction& func);
 
+  /// \brief Executes the byte code for the given number of instances.
+  ///
+  /// The instances are processed in chunks so the temp registers of one chunk fit into the cache. Large executions are distributed across
+  /// the task system, see SetParallelExecutionThreshold().
   ezResult Execute(const ezExpressionByteCode& byteCode, ezArrayPtr<const ezProcessingStream> inputs, ezArrayPtr<ezProcessingStream> outputs, ezUInt32 uiNumInstances, const ezExpression::GlobalData& globalData = ezExpression::GlobalData());
 
+  /// \brief Executions with at least this many instances are split up and processed in parallel using the task system.
+  ///
+  /// Set to ezInvalidIndex to always execute on the calling thread. The default is 16384.
+  void SetParallelExecutionThreshold(ezUInt32 uiNumInstances) { m_uiParallelExecutionThreshold = uiNumInstances; }
+  ezUInt32 GetParallelExecutionThreshold() const { return m_uiParallelExecutionThreshold; }
+
+  /// \brief Enables 8-wide instructions if they are natively supported by the target platform (see EZ_SIMD_VEC8_NATIVE).
+  ///
+  /// The results are exactly the same as with 4-wide instructions. EZ_SIMD_VEC8_NATIVE is off in the default configuration,
+  /// in that case the 8-wide instructions are not compiled in and this setting has no effect.
+  void SetEnableWideSimd(bool bEnable) { m_bEnableWideSimd = bEnable; }
+  bool GetEnableWideSimd() const { return m_bEnableWideSimd; }
+
 private:
   void RegisterDefaultFunctions();
 
@@ -32,4 +49,7 @@ private:
 
   ezDynamicArray<ezExpressionFunction> m_Functions;
   ezHashTable<ezHashedString, ezUInt32> m_FunctionNamesToIndex;
+
+  ezUInt32 m_uiParallelExecutionThreshold = 16384;
+  bool m_bEnableWideSimd = true;
 };
@@ -35,8 +35,8 @@ namespace
     "CeilF_R",
     "TruncF_R",
 
-    "NotB_R",
     "NotI_R",
+    "NotB_R",
 
     "IToF_R",
     "FToI_R",
@@ -5,6 +5,71 @@
 #include <Foundation/CodeUtils/Expression/ExpressionVM.h>
 #include <Foundation/CodeUtils/Expression/Implementation/ExpressionVMOperations.h>
 #include <Foundation/Logging/Log.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+namespace
+{
+  // The temp registers of one chunk should fit into the L1 cache.
+  static constexpr ezUInt32 s_uiRegisterMemoryBudget = 32 * 1024;
+  static constexpr ezUInt32 s_uiMinChunkSize = 64;
+
+  // Number of instances a single task should at least process when executing in parallel.
+  static constexpr ezUInt32 s_uiMinInstancesPerTask = 4096;
+
+  ezUInt32 ComputeChunkSize(ezUInt32 uiNumTempRegisters)
+  {
+    // Each register holds 4 bytes per instance. The chunk size is a multiple of 8 so only the last chunk needs remainder handling
+    // and all other chunks can be processed with 8-wide instructions.
+    const ezUInt32 uiChunkSize = s_uiRegisterMemoryBudget / (ezMath::Max(uiNumTempRegisters, 1u) * 4);
+    return ezMath::Max(uiChunkSize & ~7u, s_uiMinChunkSize);
+  }
+
+  ezExpression::Register* AllocateRegisters(ezDynamicArray<ezExpression::Register, ezAlignedAllocatorWrapper>& ref_registers, ezUInt32 uiNumRegisters)
+  {
+    // One additional register so the start can be aligned to 32 bytes which is needed for 8-wide instructions.
+    ref_registers.SetCountUninitialized(uiNumRegisters + 1);
+    return ezMemoryUtils::AlignForwards(ref_registers.GetData(), 32);
+  }
+
+  ezResult ExecuteChunk(const ezExpressionByteCode& byteCode, const OpFunc* pFuncs, ExecutionContext& context)
+  {
+    const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
+    const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+
+    while (pByteCode < pByteCodeEnd)
+    {
+      ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+
+      OpFunc func = pFuncs[opCode];
+      if (func != nullptr)
+      {
+        func(pByteCode, context);
+      }
+      else
+      {
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        ezLog::Error("Unknown OpCode '{}'. Execution aborted.", opCode);
+        return EZ_FAILURE;
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  ezResult ExecuteChunks(const ezExpressionByteCode& byteCode, const OpFunc* pFuncs, ExecutionContext& context, ezUInt32 uiNumInstances, ezUInt32 uiChunkSize, ezUInt32 uiFirstChunk, ezUInt32 uiEndChunk)
+  {
+    for (ezUInt32 uiChunk = uiFirstChunk; uiChunk < uiEndChunk; ++uiChunk)
+    {
+      context.m_uiFirstInstance = uiChunk * uiChunkSize;
+      context.m_uiNumInstances = ezMath::Min(uiChunkSize, uiNumInstances - context.m_uiFirstInstance);
+      context.m_uiNumSimd4Instances = (context.m_uiNumInstances + 3) / 4;
+
+      EZ_SUCCEED_OR_RETURN(ExecuteChunk(byteCode, pFuncs, context));
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace
 
 ezExpressionVM::ezExpressionVM()
 {
@@ -45,40 +110,59 @@ ezResult ezExpressionVM::Execute(const ezExpressionByteCode& byteCode, ezArrayPt
   EZ_SUCCEED_OR_RETURN(MapStreams(byteCode.GetOutputs(), m_ScalarizedOutputs, "Output", uiNumInstances, m_MappedOutputs));
   EZ_SUCCEED_OR_RETURN(MapFunctions(byteCode.GetFunctions(), globalData));
 
-  const ezUInt32 uiTotalNumRegisters = byteCode.GetNumTempRegisters() * ((uiNumInstances + 3) / 4);
-  m_Registers.SetCountUninitialized(uiTotalNumRegisters);
+  const OpFunc* pFuncs = s_Simd4Funcs;
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+  if (m_bEnableWideSimd)
+  {
+    pFuncs = s_Simd8Funcs;
+  }
+#endif
+
+  const ezUInt32 uiNumTempRegisters = byteCode.GetNumTempRegisters();
+  const ezUInt32 uiChunkSize = ComputeChunkSize(uiNumTempRegisters);
+  const ezUInt32 uiNumChunks = (uiNumInstances + uiChunkSize - 1) / uiChunkSize;
 
-  // Execute bytecode
-  const ezExpressionByteCode::StorageType* pByteCode = byteCode.GetByteCode();
-  const ezExpressionByteCode::StorageType* pByteCodeEnd = byteCode.GetByteCodeEnd();
+  // Registers of the same index are laid out consecutively for all instances of a chunk. The stride is kept even so pairs of registers
+  // can be processed with 8-wide instructions.
+  const ezUInt32 uiRegisterStride = ezMemoryUtils::AlignSize(ezMath::Min(uiChunkSize, uiNumInstances), 8u) / 4;
+  const ezUInt32 uiNumRegisters = uiNumTempRegisters * uiRegisterStride;
 
   ExecutionContext context;
-  context.m_pRegisters = m_Registers.GetData();
-  context.m_uiNumInstances = uiNumInstances;
-  context.m_uiNumSimd4Instances = (uiNumInstances + 3) / 4;
+  context.m_uiRegisterStride = uiRegisterStride;
   context.m_Inputs = m_MappedInputs;
   context.m_Outputs = m_MappedOutputs;
   context.m_Functions = m_MappedFunctions;
   context.m_pGlobalData = &globalData;
 
-  while (pByteCode < pByteCodeEnd)
+  if (uiNumInstances < m_uiParallelExecutionThreshold || uiNumChunks == 1)
   {
-    ezExpressionByteCode::OpCode::Enum opCode = ezExpressionByteCode::GetOpCode(pByteCode);
+    context.m_pRegisters = AllocateRegisters(m_Registers, uiNumRegisters);
 
-    OpFunc func = s_Simd4Funcs[opCode];
-    if (func != nullptr)
-    {
-      func(pByteCode, context);
-    }
-    else
-    {
-      EZ_ASSERT_NOT_IMPLEMENTED;
-      ezLog::Error("Unknown OpCode '{}'. Execution aborted.", opCode);
-      return EZ_FAILURE;
-    }
+    return ExecuteChunks(byteCode, pFuncs, context, uiNumInstances, uiChunkSize, 0, uiNumChunks);
   }
 
-  return EZ_SUCCESS;
+  ezAtomicBool bFailed;
+
+  ezParallelForParams params;
+  params.m_uiBinSize = ezMath::Max(s_uiMinInstancesPerTask / uiChunkSize, 1u);
+  params.m_uiMaxTasksPerThread = 2;
+
+  ezTaskSystem::ParallelForIndexed(
+    0, uiNumChunks,
+    [&byteCode, &context, &bFailed, pFuncs, uiNumInstances, uiChunkSize](ezUInt32 uiStartChunk, ezUInt32 uiEndChunk) {
+      ezDynamicArray<ezExpression::Register, ezAlignedAllocatorWrapper> registers;
+
+      ExecutionContext taskContext = context;
+      taskContext.m_pRegisters = AllocateRegisters(registers, byteCode.GetNumTempRegisters() * context.m_uiRegisterStride);
+
+      if (ExecuteChunks(byteCode, pFuncs, taskContext, uiNumInstances, uiChunkSize, uiStartChunk, uiEndChunk).Failed())
+      {
+        bFailed = true;
+      }
+    },
+    "ExpressionVM", params);
+
+  return bFailed ? EZ_FAILURE : EZ_SUCCESS;
 }
 
 void ezExpressionVM::RegisterDefaultFunctions()
@@ -3,12 +3,15 @@
 #include <Foundation/CodeUtils/Expression/ExpressionByteCode.h>
 #include <Foundation/Math/Float16.h>
 #include <Foundation/SimdMath/SimdMath.h>
+#include <Foundation/SimdMath/SimdVec8i.h>
 
 namespace
 {
   struct ExecutionContext
   {
     ezExpression::Register* m_pRegisters = nullptr;
+    ezUInt32 m_uiRegisterStride = 0;
+    ezUInt32 m_uiFirstInstance = 0;
     ezUInt32 m_uiNumInstances = 0;
     ezUInt32 m_uiNumSimd4Instances = 0;
     ezArrayPtr<ezProcessingStream*> m_Inputs;
@@ -20,45 +23,103 @@ namespace
   using ByteCodeType = ezExpressionByteCode::StorageType;
   using OpFunc = void (*)(const ByteCodeType*& pByteCode, ExecutionContext& context);
 
-#define DEFINE_TARGET_REGISTER()                                                                                                        \
-  ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+  /// \brief Two consecutive 4-wide registers viewed as one 8-wide register.
+  ///
+  /// The register stride is always even and the register memory is 32 byte aligned so pairs of registers can be processed with 8-wide instructions.
+  struct Register8
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    Register8() {}; // NOLINT: using = default doesn't work here.
+
+    union
+    {
+      ezSimdVec8b b;
+      ezSimdVec8i i;
+      ezSimdVec8f f;
+    };
+  };
+
+  static_assert(sizeof(Register8) == 2 * sizeof(ezExpression::Register));
+
+  EZ_ALWAYS_INLINE Register8* AsRegister8(ezExpression::Register* r)
+  {
+    return reinterpret_cast<Register8*>(r);
+  }
+
+  EZ_ALWAYS_INLINE const Register8* AsRegister8(const ezExpression::Register* r)
+  {
+    return reinterpret_cast<const Register8*>(r);
+  }
+
+  template <bool IsConstant>
+  EZ_ALWAYS_INLINE const Register8* GetOperand8(const ezExpression::Register* pOperand, const Register8& constant8)
+  {
+    if constexpr (IsConstant)
+      return &constant8;
+    else
+      return AsRegister8(pOperand);
+  }
+
+  template <bool IsConstant>
+  EZ_ALWAYS_INLINE const ezExpression::Register* GetTailOperand(const ezExpression::Register* pOperand, ptrdiff_t iOffset)
+  {
+    if constexpr (IsConstant)
+      return pOperand;
+    else
+      return pOperand + iOffset;
+  }
+#endif
+
+#define DEFINE_TARGET_REGISTER()                                                                                                      \
+  ezExpression::Register* r = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride; \
   ezExpression::Register* re = r + context.m_uiNumSimd4Instances;
 
 #define DEFINE_OP_REGISTER(name) \
-  const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances;
+  const ezExpression::Register* name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride;
 
 #define DEFINE_CONSTANT(name)                                                      \
   const ezUInt32 EZ_CONCAT(name, Raw) = *pByteCode;                                \
   const ezExpression::Register tmp = ezExpressionByteCode::GetConstant(pByteCode); \
   const ezExpression::Register* name = &tmp;
 
-#define UNARY_OP_INNER_LOOP(code) \
-  code;                           \
-  ++r;                            \
-  ++a;
-
-#define DEFINE_UNARY_OP(name, code)                                                    \
-  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context)  \
-  {                                                                                    \
-    DEFINE_TARGET_REGISTER();                                                          \
-    DEFINE_OP_REGISTER(a);                                                             \
-    while (r != re)                                                                    \
-    {                                                                                  \
-      UNARY_OP_INNER_LOOP(code)                                                        \
-    }                                                                                  \
-  }                                                                                    \
-                                                                                       \
-  void EZ_CONCAT(name, _16)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
-  {                                                                                    \
-    DEFINE_TARGET_REGISTER();                                                          \
-    DEFINE_OP_REGISTER(a);                                                             \
-    while (r != re)                                                                    \
-    {                                                                                  \
-      UNARY_OP_INNER_LOOP(code)                                                        \
-      UNARY_OP_INNER_LOOP(code)                                                        \
-      UNARY_OP_INNER_LOOP(code)                                                        \
-      UNARY_OP_INNER_LOOP(code)                                                        \
-    }                                                                                  \
+#define DEFINE_OPERAND(name, isConstant)                                                                                  \
+  ezUInt32 EZ_CONCAT(name, Raw) = 0;                                                                                      \
+  ezExpression::Register EZ_CONCAT(name, Constant);                                                                       \
+  const ezExpression::Register* name;                                                                                     \
+  if constexpr (isConstant)                                                                                               \
+  {                                                                                                                       \
+    EZ_CONCAT(name, Raw) = *pByteCode;                                                                                    \
+    EZ_CONCAT(name, Constant) = ezExpressionByteCode::GetConstant(pByteCode);                                             \
+    name = &EZ_CONCAT(name, Constant);                                                                                    \
+  }                                                                                                                       \
+  else                                                                                                                    \
+  {                                                                                                                       \
+    name = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiRegisterStride;       \
+  }
+
+  // The op code is implemented once as a loop template over the register type. The _4 variant processes all instances with 4-wide registers,
+  // the _8 variant processes pairs of registers with 8-wide registers and the remaining register, if any, with a 4-wide register.
+  // Only operations that produce exactly the same results in both widths get an _8 variant.
+
+#define DEFINE_UNARY_OP_SIMD4(name, code)                                                                    \
+  template <typename RegisterType>                                                                           \
+  EZ_ALWAYS_INLINE void EZ_CONCAT(name, _Loop)(RegisterType * r, RegisterType * re, const RegisterType* a)   \
+  {                                                                                                          \
+    while (r != re)                                                                                          \
+    {                                                                                                        \
+      code;                                                                                                  \
+      ++r;                                                                                                   \
+      ++a;                                                                                                   \
+    }                                                                                                        \
+  }                                                                                                          \
+                                                                                                             \
+  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context)                        \
+  {                                                                                                          \
+    DEFINE_TARGET_REGISTER();                                                                                \
+    DEFINE_OP_REGISTER(a);                                                                                   \
+    EZ_CONCAT(name, _Loop)(r, re, a);                                                                        \
   }
 
 #define BINARY_OP_INNER_LOOP(code)        \
@@ -70,29 +131,23 @@ namespace
     ++b;                                  \
   }
 
-#define DEFINE_BINARY_OP(name, code)                                                                                \
-  template <bool RightIsConstant>                                                                                   \
-  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context)                               \
-  {                                                                                                                 \
-    DEFINE_TARGET_REGISTER();                                                                                       \
-    DEFINE_OP_REGISTER(a);                                                                                          \
-    ezUInt32 bRaw;                                                                                                  \
-    ezExpression::Register bConstant;                                                                               \
-    const ezExpression::Register* b;                                                                                \
-    if constexpr (RightIsConstant)                                                                                  \
-    {                                                                                                               \
-      bRaw = *pByteCode;                                                                                            \
-      bConstant = ezExpressionByteCode::GetConstant(pByteCode);                                                     \
-      b = &bConstant;                                                                                               \
-    }                                                                                                               \
-    else                                                                                                            \
-    {                                                                                                               \
-      b = context.m_pRegisters + ezExpressionByteCode::GetRegisterIndex(pByteCode) * context.m_uiNumSimd4Instances; \
-    }                                                                                                               \
-    while (r != re)                                                                                                 \
-    {                                                                                                               \
-      BINARY_OP_INNER_LOOP(code)                                                                                    \
-    }                                                                                                               \
+#define DEFINE_BINARY_OP_SIMD4(name, code)                                                                                                        \
+  template <bool RightIsConstant, typename RegisterType>                                                                                          \
+  EZ_ALWAYS_INLINE void EZ_CONCAT(name, _Loop)(RegisterType * r, RegisterType * re, const RegisterType* a, const RegisterType* b, ezUInt32 bRaw) \
+  {                                                                                                                                               \
+    while (r != re)                                                                                                                               \
+    {                                                                                                                                             \
+      BINARY_OP_INNER_LOOP(code)                                                                                                                  \
+    }                                                                                                                                             \
+  }                                                                                                                                               \
+                                                                                                                                                  \
+  template <bool RightIsConstant>                                                                                                                 \
+  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context)                                                             \
+  {                                                                                                                                               \
+    DEFINE_TARGET_REGISTER();                                                                                                                     \
+    DEFINE_OP_REGISTER(a);                                                                                                                        \
+    DEFINE_OPERAND(b, RightIsConstant);                                                                                                           \
+    EZ_CONCAT(name, _Loop)<RightIsConstant>(r, re, a, b, bRaw);                                                                                   \
   }
 
 #define TERNARY_OP_INNER_LOOP(code) \
@@ -102,37 +157,100 @@ namespace
   ++b;                              \
   ++c;
 
-#define DEFINE_TERNARY_OP(name, code)                                                 \
-  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
-  {                                                                                   \
-    DEFINE_TARGET_REGISTER();                                                         \
-    DEFINE_OP_REGISTER(a);                                                            \
-    DEFINE_OP_REGISTER(b);                                                            \
-    DEFINE_OP_REGISTER(c);                                                            \
-    while (r != re)                                                                   \
-    {                                                                                 \
-      TERNARY_OP_INNER_LOOP(code)                                                     \
-    }                                                                                 \
+#define DEFINE_TERNARY_OP_SIMD4(name, code)                                                                                                      \
+  template <typename RegisterType>                                                                                                               \
+  EZ_ALWAYS_INLINE void EZ_CONCAT(name, _Loop)(RegisterType * r, RegisterType * re, const RegisterType* a, const RegisterType* b, const RegisterType* c) \
+  {                                                                                                                                              \
+    while (r != re)                                                                                                                              \
+    {                                                                                                                                            \
+      TERNARY_OP_INNER_LOOP(code)                                                                                                                \
+    }                                                                                                                                            \
+  }                                                                                                                                              \
+                                                                                                                                                 \
+  void EZ_CONCAT(name, _4)(const ByteCodeType*& pByteCode, ExecutionContext& context)                                                            \
+  {                                                                                                                                              \
+    DEFINE_TARGET_REGISTER();                                                                                                                    \
+    DEFINE_OP_REGISTER(a);                                                                                                                       \
+    DEFINE_OP_REGISTER(b);                                                                                                                       \
+    DEFINE_OP_REGISTER(c);                                                                                                                       \
+    EZ_CONCAT(name, _Loop)(r, re, a, b, c);                                                                                                      \
   }
 
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+
+#  define DEFINE_SIMD8_RANGE()                                                      \
+    ezExpression::Register* r8e = r + (context.m_uiNumSimd4Instances & ~1u); \
+    const ptrdiff_t iTail = r8e - r;
+
+#  define DEFINE_UNARY_OP(name, code)                                                 \
+    DEFINE_UNARY_OP_SIMD4(name, code)                                                 \
+                                                                                      \
+    void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context) \
+    {                                                                                 \
+      DEFINE_TARGET_REGISTER();                                                       \
+      DEFINE_OP_REGISTER(a);                                                          \
+      DEFINE_SIMD8_RANGE();                                                           \
+      EZ_CONCAT(name, _Loop)(AsRegister8(r), AsRegister8(r8e), AsRegister8(a));       \
+      EZ_CONCAT(name, _Loop)(r8e, re, a + iTail);                                     \
+    }
+
+#  define DEFINE_BINARY_OP(name, code)                                                                                              \
+    DEFINE_BINARY_OP_SIMD4(name, code)                                                                                              \
+                                                                                                                                    \
+    template <bool RightIsConstant>                                                                                                 \
+    void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context)                                             \
+    {                                                                                                                               \
+      DEFINE_TARGET_REGISTER();                                                                                                     \
+      DEFINE_OP_REGISTER(a);                                                                                                        \
+      DEFINE_OPERAND(b, RightIsConstant);                                                                                           \
+      Register8 bConstant8;                                                                                                         \
+      bConstant8.i = ezSimdVec8i(static_cast<ezInt32>(bRaw));                                                                       \
+      DEFINE_SIMD8_RANGE();                                                                                                         \
+      EZ_CONCAT(name, _Loop)<RightIsConstant>(AsRegister8(r), AsRegister8(r8e), AsRegister8(a), GetOperand8<RightIsConstant>(b, bConstant8), bRaw); \
+      EZ_CONCAT(name, _Loop)<RightIsConstant>(r8e, re, a + iTail, GetTailOperand<RightIsConstant>(b, iTail), bRaw);                 \
+    }
+
+#  define DEFINE_TERNARY_OP(name, code)                                                                                \
+    DEFINE_TERNARY_OP_SIMD4(name, code)                                                                                \
+                                                                                                                       \
+    void EZ_CONCAT(name, _8)(const ByteCodeType*& pByteCode, ExecutionContext& context)                                \
+    {                                                                                                                  \
+      DEFINE_TARGET_REGISTER();                                                                                        \
+      DEFINE_OP_REGISTER(a);                                                                                           \
+      DEFINE_OP_REGISTER(b);                                                                                           \
+      DEFINE_OP_REGISTER(c);                                                                                           \
+      DEFINE_SIMD8_RANGE();                                                                                            \
+      EZ_CONCAT(name, _Loop)(AsRegister8(r), AsRegister8(r8e), AsRegister8(a), AsRegister8(b), AsRegister8(c));        \
+      EZ_CONCAT(name, _Loop)(r8e, re, a + iTail, b + iTail, c + iTail);                                                \
+    }
+
+#else
+
+#  define DEFINE_UNARY_OP(name, code) DEFINE_UNARY_OP_SIMD4(name, code)
+#  define DEFINE_BINARY_OP(name, code) DEFINE_BINARY_OP_SIMD4(name, code)
+#  define DEFINE_TERNARY_OP(name, code) DEFINE_TERNARY_OP_SIMD4(name, code)
+
+#endif
+
   DEFINE_UNARY_OP(AbsF, r->f = a->f.Abs());
   DEFINE_UNARY_OP(AbsI, r->i = a->i.Abs());
   DEFINE_UNARY_OP(SqrtF, r->f = a->f.GetSqrt());
 
-  DEFINE_UNARY_OP(ExpF, r->f = ezSimdMath::Exp(a->f));
-  DEFINE_UNARY_OP(LnF, r->f = ezSimdMath::Ln(a->f));
-  DEFINE_UNARY_OP(Log2F, r->f = ezSimdMath::Log2(a->f));
-  DEFINE_UNARY_OP(Log2I, r->i = ezSimdMath::Log2i(a->i));
-  DEFINE_UNARY_OP(Log10F, r->f = ezSimdMath::Log10(a->f));
-  DEFINE_UNARY_OP(Pow2F, r->f = ezSimdMath::Pow2(a->f));
+  // The ezSimdMath functions are only implemented for 4-wide vectors.
+  DEFINE_UNARY_OP_SIMD4(ExpF, r->f = ezSimdMath::Exp(a->f));
+  DEFINE_UNARY_OP_SIMD4(LnF, r->f = ezSimdMath::Ln(a->f));
+  DEFINE_UNARY_OP_SIMD4(Log2F, r->f = ezSimdMath::Log2(a->f));
+  DEFINE_UNARY_OP_SIMD4(Log2I, r->i = ezSimdMath::Log2i(a->i));
+  DEFINE_UNARY_OP_SIMD4(Log10F, r->f = ezSimdMath::Log10(a->f));
+  DEFINE_UNARY_OP_SIMD4(Pow2F, r->f = ezSimdMath::Pow2(a->f));
 
-  DEFINE_UNARY_OP(SinF, r->f = ezSimdMath::Sin(a->f));
-  DEFINE_UNARY_OP(CosF, r->f = ezSimdMath::Cos(a->f));
-  DEFINE_UNARY_OP(TanF, r->f = ezSimdMath::Tan(a->f));
+  DEFINE_UNARY_OP_SIMD4(SinF, r->f = ezSimdMath::Sin(a->f));
+  DEFINE_UNARY_OP_SIMD4(CosF, r->f = ezSimdMath::Cos(a->f));
+  DEFINE_UNARY_OP_SIMD4(TanF, r->f = ezSimdMath::Tan(a->f));
 
-  DEFINE_UNARY_OP(ASinF, r->f = ezSimdMath::ASin(a->f));
-  DEFINE_UNARY_OP(ACosF, r->f = ezSimdMath::ACos(a->f));
-  DEFINE_UNARY_OP(ATanF, r->f = ezSimdMath::ATan(a->f));
+  DEFINE_UNARY_OP_SIMD4(ASinF, r->f = ezSimdMath::ASin(a->f));
+  DEFINE_UNARY_OP_SIMD4(ACosF, r->f = ezSimdMath::ACos(a->f));
+  DEFINE_UNARY_OP_SIMD4(ATanF, r->f = ezSimdMath::ATan(a->f));
 
   DEFINE_UNARY_OP(RoundF, r->f = a->f.Round());
   DEFINE_UNARY_OP(FloorF, r->f = a->f.Floor());
@@ -143,7 +261,7 @@ namespace
   DEFINE_UNARY_OP(NotB, r->b = !a->b);
 
   DEFINE_UNARY_OP(IToF, r->f = a->i.ToFloat());
-  DEFINE_UNARY_OP(FToI, r->i = ezSimdVec4i::Truncate(a->f));
+  DEFINE_UNARY_OP(FToI, r->i = decltype(r->i)::Truncate(a->f));
 
   DEFINE_BINARY_OP(AddF, r->f = a->f + b->f);
   DEFINE_BINARY_OP(AddI, r->i = a->i + b->i);
@@ -155,7 +273,8 @@ namespace
   DEFINE_BINARY_OP(MulI, r->i = a->i.CompMul(b->i));
 
   DEFINE_BINARY_OP(DivF, r->f = a->f.CompDiv(b->f));
-  DEFINE_BINARY_OP(DivI, r->i = a->i.CompDiv(b->i));
+  // There is no 8-wide integer division.
+  DEFINE_BINARY_OP_SIMD4(DivI, r->i = a->i.CompDiv(b->i));
 
   DEFINE_BINARY_OP(MinF, r->f = a->f.CompMin(b->f));
   DEFINE_BINARY_OP(MinI, r->i = a->i.CompMin(b->i));
@@ -163,8 +282,9 @@ namespace
   DEFINE_BINARY_OP(MaxF, r->f = a->f.CompMax(b->f));
   DEFINE_BINARY_OP(MaxI, r->i = a->i.CompMax(b->i));
 
-  DEFINE_BINARY_OP(ShlI, r->i = a->i << b->i);
-  DEFINE_BINARY_OP(ShrI, r->i = a->i >> b->i);
+  // Shifts by a vector are scalar loops, there is nothing to gain from an 8-wide variant.
+  DEFINE_BINARY_OP_SIMD4(ShlI, r->i = a->i << b->i);
+  DEFINE_BINARY_OP_SIMD4(ShrI, r->i = a->i >> b->i);
   DEFINE_BINARY_OP(ShlI_C, r->i = a->i << bRaw);
   DEFINE_BINARY_OP(ShrI_C, r->i = a->i >> bRaw);
   DEFINE_BINARY_OP(AndI, r->i = a->i & b->i);
@@ -194,19 +314,20 @@ namespace
   DEFINE_BINARY_OP(AndB, r->b = a->b && b->b);
   DEFINE_BINARY_OP(OrB, r->b = a->b || b->b);
 
-  DEFINE_TERNARY_OP(SelF, r->f = ezSimdVec4f::Select(a->b, b->f, c->f));
-  DEFINE_TERNARY_OP(SelI, r->i = ezSimdVec4i::Select(a->b, b->i, c->i));
-  DEFINE_TERNARY_OP(SelB, r->b = ezSimdVec4b::Select(a->b, b->b, c->b));
+  DEFINE_TERNARY_OP(SelF, r->f = decltype(r->f)::Select(a->b, b->f, c->f));
+  DEFINE_TERNARY_OP(SelI, r->i = decltype(r->i)::Select(a->b, b->i, c->i));
+  DEFINE_TERNARY_OP(SelB, r->b = decltype(r->b)::Select(a->b, b->b, c->b));
 
-  void VM_MovX_R_4(const ByteCodeType*& pByteCode, ExecutionContext& context)
+
+  DEFINE_UNARY_OP(VM_MovX_R, r->i = a->i);
+
+  template <typename RegisterType>
+  EZ_ALWAYS_INLINE void VM_MovX_C_Loop(RegisterType* r, RegisterType* re, const RegisterType& a)
   {
-    DEFINE_TARGET_REGISTER();
-    DEFINE_OP_REGISTER(a);
     while (r != re)
     {
-      r->i = a->i;
+      r->i = a.i;
       ++r;
-      ++a;
     }
   }
 
@@ -214,12 +335,22 @@ namespace
   {
     DEFINE_TARGET_REGISTER();
     DEFINE_CONSTANT(a);
-    while (r != re)
-    {
-      r->i = a->i;
-      ++r;
-    }
+    VM_MovX_C_Loop(r, re, *a);
+  }
+
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+  void VM_MovX_C_8(const ByteCodeType*& pByteCode, ExecutionContext& context)
+  {
+    DEFINE_TARGET_REGISTER();
+    DEFINE_CONSTANT(a);
+    Register8 aConstant8;
+    aConstant8.i = ezSimdVec8i(static_cast<ezInt32>(aRaw));
+    DEFINE_SIMD8_RANGE();
+    EZ_IGNORE_UNUSED(iTail);
+    VM_MovX_C_Loop(AsRegister8(r), AsRegister8(r8e), aConstant8);
+    VM_MovX_C_Loop(r8e, re, *a);
   }
+#endif
 
   template <typename ValueType, typename StreamType>
   EZ_ALWAYS_INLINE ValueType ReadInputData(const ezUInt8*& ref_pData, ezUInt32 uiStride)
@@ -230,10 +361,10 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void LoadInput(RegisterType* r, RegisterType* pRe, const ezProcessingStream& input, ezUInt32 uiNumRemainderInstances)
+  void LoadInput(RegisterType* r, RegisterType* pRe, const ezProcessingStream& input, ezUInt32 uiFirstInstance, ezUInt32 uiNumRemainderInstances)
   {
-    const ezUInt8* pInputData = input.GetData<ezUInt8>();
     const ezUInt32 uiByteStride = input.GetElementStride();
+    const ezUInt8* pInputData = input.GetData<ezUInt8>() + uiFirstInstance * uiByteStride;
 
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
@@ -280,10 +411,10 @@ namespace
   }
 
   template <typename RegisterType, typename ValueType, typename StreamType>
-  void StoreOutput(RegisterType* r, RegisterType* pRe, ezProcessingStream& ref_output, ezUInt32 uiNumRemainderInstances)
+  void StoreOutput(RegisterType* r, RegisterType* pRe, ezProcessingStream& ref_output, ezUInt32 uiFirstInstance, ezUInt32 uiNumRemainderInstances)
   {
-    ezUInt8* pOutputData = ref_output.GetWritableData<ezUInt8>();
     const ezUInt32 uiByteStride = ref_output.GetElementStride();
+    ezUInt8* pOutputData = ref_output.GetWritableData<ezUInt8>() + uiFirstInstance * uiByteStride;
 
     if (uiByteStride == sizeof(ValueType) && std::is_same<ValueType, StreamType>::value)
     {
@@ -336,12 +467,12 @@ namespace
 
     if (input.GetDataType() == ezProcessingStream::DataType::Float)
     {
-      LoadInput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Half, "Unsupported input type '{}' for LoadF instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
@@ -358,16 +489,16 @@ namespace
 
     if (input.GetDataType() == ezProcessingStream::DataType::Int)
     {
-      LoadInput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else if (input.GetDataType() == ezProcessingStream::DataType::Short)
     {
-      LoadInput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(input.GetDataType() == ezProcessingStream::DataType::Byte, "Unsupported input type '{}' for LoadI instruction", ezProcessingStream::GetDataTypeName(input.GetDataType()));
-      LoadInput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, uiNumRemainderInstances);
+      LoadInput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), input, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
@@ -385,12 +516,12 @@ namespace
 
     if (output.GetDataType() == ezProcessingStream::DataType::Float)
     {
-      StoreOutput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4f, float, float>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(output.GetDataType() == ezProcessingStream::DataType::Half, "Unsupported input type '{}' for StoreF instruction", ezProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4f, float, ezFloat16>(reinterpret_cast<ezSimdVec4f*>(r), reinterpret_cast<ezSimdVec4f*>(re), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
@@ -408,16 +539,16 @@ namespace
 
     if (output.GetDataType() == ezProcessingStream::DataType::Int)
     {
-      StoreOutput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, int>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else if (output.GetDataType() == ezProcessingStream::DataType::Short)
     {
-      StoreOutput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, ezInt16>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
     else
     {
       EZ_ASSERT_DEBUG(output.GetDataType() == ezProcessingStream::DataType::Byte, "Unsupported input type '{}' for StoreI instruction", ezProcessingStream::GetDataTypeName(output.GetDataType()));
-      StoreOutput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, uiNumRemainderInstances);
+      StoreOutput<ezSimdVec4i, int, ezInt8>(reinterpret_cast<ezSimdVec4i*>(r), reinterpret_cast<ezSimdVec4i*>(re), output, context.m_uiFirstInstance, uiNumRemainderInstances);
     }
   }
 
@@ -601,14 +732,180 @@ namespace
 
   static_assert(EZ_ARRAY_SIZE(s_Simd4Funcs) == ezExpressionByteCode::OpCode::Count);
 
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+  // Same as s_Simd4Funcs but using 8-wide variants wherever they are available.
+  static constexpr OpFunc s_Simd8Funcs[] = {
+    nullptr, // Nop,
+
+    nullptr, // FirstUnary,
+
+    &AbsF_8,  // AbsF_R,
+    &AbsI_8,  // AbsI_R,
+    &SqrtF_8, // SqrtF_R,
+
+    &ExpF_4,   // ExpF_R,
+    &LnF_4,    // LnF_R,
+    &Log2F_4,  // Log2F_R,
+    &Log2I_4,  // Log2I_R,
+    &Log10F_4, // Log10F_R,
+    &Pow2F_4,  // Pow2F_R,
+
+    &SinF_4, // SinF_R,
+    &CosF_4, // CosF_R,
+    &TanF_4, // TanF_R,
+
+    &ASinF_4, // ASinF_R,
+    &ACosF_4, // ACosF_R,
+    &ATanF_4, // ATanF_R,
+
+    &RoundF_8, // RoundF_R,
+    &FloorF_8, // FloorF_R,
+    &CeilF_8,  // CeilF_R,
+    &TruncF_8, // TruncF_R,
+
+    &NotI_8, // NotI_R,
+    &NotB_8, // NotB_R,
+
+    &IToF_8, // IToF_R,
+    &FToI_8, // FToI_R,
+
+    nullptr, // LastUnary,
+    nullptr, // FirstBinary,
+
+    &AddF_8<false>, // AddF_RR,
+    &AddI_8<false>, // AddI_RR,
+
+    &SubF_8<false>, // SubF_RR,
+    &SubI_8<false>, // SubI_RR,
+
+    &MulF_8<false>, // MulF_RR,
+    &MulI_8<false>, // MulI_RR,
+
+    &DivF_8<false>, // DivF_RR,
+    &DivI_4<false>, // DivI_RR,
+
+    &MinF_8<false>, // MinF_RR,
+    &MinI_8<false>, // MinI_RR,
+
+    &MaxF_8<false>, // MaxF_RR,
+    &MaxI_8<false>, // MaxI_RR,
+
+    &ShlI_4<false>, // ShlI_RR,
+    &ShrI_4<false>, // ShrI_RR,
+    &AndI_8<false>, // AndI_RR,
+    &XorI_8<false>, // XorI_RR,
+    &OrI_8<false>,  // OrI_RR,
+
+    &EqF_8<false>, // EqF_RR,
+    &EqI_8<false>, // EqI_RR,
+    &EqB_8<false>, // EqB_RR,
+
+    &NEqF_8<false>, // NEqF_RR,
+    &NEqI_8<false>, // NEqI_RR,
+    &NEqB_8<false>, // NEqB_RR,
+
+    &LtF_8<false>, // LtF_RR,
+    &LtI_8<false>, // LtI_RR,
+
+    &LEqF_8<false>, // LEqF_RR,
+    &LEqI_8<false>, // LEqI_RR,
+
+    &GtF_8<false>, // GtF_RR,
+    &GtI_8<false>, // GtI_RR,
+
+    &GEqF_8<false>, // GEqF_RR,
+    &GEqI_8<false>, // GEqI_RR,
+
+    &AndB_8<false>, // AndB_RR,
+    &OrB_8<false>,  // OrB_RR,
+
+    nullptr, // LastBinary,
+    nullptr, // FirstBinaryWithConstant,
+
+    &AddF_8<true>, // AddF_RC,
+    &AddI_8<true>, // AddI_RC,
+
+    &SubF_8<true>, // SubF_RC,
+    &SubI_8<true>, // SubI_RC,
+
+    &MulF_8<true>, // MulF_RC,
+    &MulI_8<true>, // MulI_RC,
+
+    &DivF_8<true>, // DivF_RC,
+    &DivI_4<true>, // DivI_RC,
+
+    &MinF_8<true>, // MinF_RC,
+    &MinI_8<true>, // MinI_RC,
+
+    &MaxF_8<true>, // MaxF_RC,
+    &MaxI_8<true>, // MaxI_RC,
+
+    &ShlI_C_8<true>, // ShlI_RC,
+    &ShrI_C_8<true>, // ShrI_RC,
+    &AndI_8<true>,   // AndI_RC,
+    &XorI_8<true>,   // XorI_RC,
+    &OrI_8<true>,    // OrI_RC,
+
+    &EqF_8<true>, // EqF_RC,
+    &EqI_8<true>, // EqI_RC,
+    &EqB_8<true>, // EqB_RC
+
+    &NEqF_8<true>, // NEqF_RC,
+    &NEqI_8<true>, // NEqI_RC,
+    &NEqB_8<true>, // NEqB_RC
+
+    &LtF_8<true>, // LtF_RC,
+    &LtI_8<true>, // LtI_RC
+
+    &LEqF_8<true>, // LEqF_RC,
+    &LEqI_8<true>, // LEqI_RC
+
+    &GtF_8<true>, // GtF_RC,
+    &GtI_8<true>, // GtI_RC
+
+    &GEqF_8<true>, // GEqF_RC,
+    &GEqI_8<true>, // GEqI_RC
+
+    &AndB_8<true>, // AndB_RC,
+    &OrB_8<true>,  // OrB_RC,
+
+    nullptr, // LastBinaryWithConstant,
+    nullptr, // FirstTernary,
+
+    &SelF_8, // SelF_RRR,
+    &SelI_8, // SelI_RRR,
+    &SelB_8, // SelB_RRR,
+
+    nullptr, // LastTernary,
+    nullptr, // FirstSpecial,
+
+    &VM_MovX_R_8, // MovX_R,
+    &VM_MovX_C_8, // MovX_C,
+    &VM_LoadF_4,  // LoadF,
+    &VM_LoadI_4,  // LoadI,
+    &VM_StoreF_4, // StoreF,
+    &VM_StoreI_4, // StoreI,
+
+    &VM_Call, // Call,
+
+    nullptr, // LastSpecial,
+  };
+
+  static_assert(EZ_ARRAY_SIZE(s_Simd8Funcs) == ezExpressionByteCode::OpCode::Count);
+#endif
+
 } // namespace
 
 #undef DEFINE_TARGET_REGISTER
 #undef DEFINE_OP_REGISTER
 #undef DEFINE_CONSTANT
-#undef UNARY_OP_INNER_LOOP
+#undef DEFINE_OPERAND
+#undef DEFINE_SIMD8_RANGE
+#undef DEFINE_UNARY_OP_SIMD4
 #undef DEFINE_UNARY_OP
 #undef BINARY_OP_INNER_LOOP
+#undef DEFINE_BINARY_OP_SIMD4
 #undef DEFINE_BINARY_OP
 #undef TERNARY_OP_INNER_LOOP
+#undef DEFINE_TERNARY_OP_SIMD4
 #undef DEFINE_TERNARY_OP
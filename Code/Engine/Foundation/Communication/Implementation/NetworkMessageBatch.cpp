@@ -0,0 +1,138 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Communication/Implementation/NetworkMessageBatch.h>
+#include <Foundation/Utilities/Compression.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiRecordHeaderSize = 12;
+
+  EZ_ALWAYS_INLINE void WriteUInt32(ezUInt8* pDst, ezUInt32 uiValue)
+  {
+    ezMemoryUtils::Copy(pDst, reinterpret_cast<const ezUInt8*>(&uiValue), sizeof(ezUInt32));
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 ReadUInt32(const ezUInt8* pSrc)
+  {
+    ezUInt32 uiValue;
+    ezMemoryUtils::Copy(reinterpret_cast<ezUInt8*>(&uiValue), pSrc, sizeof(ezUInt32));
+    return uiValue;
+  }
+} // namespace
+
+ezUInt32 ezNetworkMessageBatch::GetSupportedFeatures(const ezNetworkBatchingSettings& settings)
+{
+  if (!settings.m_bCombineMessages)
+    return 0;
+
+  ezUInt32 uiFeatures = CombinedMessages;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (settings.m_uiCompressionThreshold > 0)
+  {
+    uiFeatures |= Compression;
+  }
+#endif
+
+  return uiFeatures;
+}
+
+ezResult ezNetworkMessageBatch::Unpack(ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> packetData, ezDynamicArray<ezUInt8>& ref_decompressed, ezDynamicArray<Message>& out_messages)
+{
+  out_messages.Clear();
+
+  if (uiMsgID == CompressedBatchMsgID)
+  {
+    EZ_SUCCEED_OR_RETURN(ezCompressionUtils::Decompress(packetData, ezCompressionMethod::ZStd, ref_decompressed));
+    packetData = ref_decompressed;
+  }
+  else if (uiMsgID != BatchMsgID)
+  {
+    return EZ_FAILURE;
+  }
+
+  ezUInt32 uiOffset = 0;
+  while (uiOffset < packetData.GetCount())
+  {
+    if (packetData.GetCount() - uiOffset < s_uiRecordHeaderSize)
+      return EZ_FAILURE;
+
+    const ezUInt8* pRecord = packetData.GetPtr() + uiOffset;
+    const ezUInt32 uiDataSize = ReadUInt32(pRecord + 8);
+    uiOffset += s_uiRecordHeaderSize;
+
+    if (packetData.GetCount() - uiOffset < uiDataSize)
+      return EZ_FAILURE;
+
+    Message& msg = out_messages.ExpandAndGetRef();
+    msg.m_uiSystemID = ReadUInt32(pRecord);
+    msg.m_uiMsgID = ReadUInt32(pRecord + 4);
+    msg.m_Data = packetData.GetSubArray(uiOffset, uiDataSize);
+
+    uiOffset += uiDataSize;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezNetworkMessageBatch::ezNetworkMessageBatch(ezUInt32 uiHeaderSize /*= 0*/)
+  : m_uiHeaderSize(uiHeaderSize)
+{
+  Clear();
+}
+
+void ezNetworkMessageBatch::AddMessage(ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data)
+{
+  if (m_uiNumMessages == 0)
+  {
+    m_StartTime = ezTime::Now();
+  }
+
+  ++m_uiNumMessages;
+
+  const ezUInt32 uiOffset = m_Data.GetCount();
+  m_Data.SetCountUninitialized(uiOffset + s_uiRecordHeaderSize + data.GetCount());
+
+  ezUInt8* pRecord = m_Data.GetData() + uiOffset;
+  WriteUInt32(pRecord, uiSystemID);
+  WriteUInt32(pRecord + 4, uiMsgID);
+  WriteUInt32(pRecord + 8, data.GetCount());
+
+  if (!data.IsEmpty())
+  {
+    ezMemoryUtils::Copy(pRecord + s_uiRecordHeaderSize, data.GetPtr(), data.GetCount());
+  }
+}
+
+ezArrayPtr<ezUInt8> ezNetworkMessageBatch::GetPacket(ezUInt32 uiCompressionThreshold, ezUInt32& out_uiMsgID)
+{
+  out_uiMsgID = BatchMsgID;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (uiCompressionThreshold > 0 && m_Data.GetCount() >= uiCompressionThreshold)
+  {
+    const ezArrayPtr<const ezUInt8> records = m_Data.GetArrayPtr().GetSubArray(m_uiHeaderSize);
+
+    if (ezCompressionUtils::Compress(records, ezCompressionMethod::ZStd, m_Compressed).Succeeded() && m_Compressed.GetCount() < records.GetCount())
+    {
+      m_CompressedPacket.SetCountUninitialized(m_uiHeaderSize + m_Compressed.GetCount());
+      ezMemoryUtils::Copy(m_CompressedPacket.GetData() + m_uiHeaderSize, m_Compressed.GetData(), m_Compressed.GetCount());
+
+      out_uiMsgID = CompressedBatchMsgID;
+      return m_CompressedPacket;
+    }
+  }
+#else
+  EZ_IGNORE_UNUSED(uiCompressionThreshold);
+#endif
+
+  return m_Data;
+}
+
+void ezNetworkMessageBatch::Clear()
+{
+  m_uiNumMessages = 0;
+  m_Data.SetCountUninitialized(m_uiHeaderSize);
+}
+
+EZ_STATICLINK_FILE(Foundation, Foundation_Communication_Implementation_NetworkMessageBatch);
@@ -0,0 +1,74 @@
+#pragma once
+
+#include <Foundation/Communication/NetworkBatchingSettings.h>
+#include <Foundation/Containers/DynamicArray.h>
+
+/// \brief Collects messages, to send them as one network packet. Used by ezRemoteInterface and ezTelemetry.
+///
+/// Each message is stored as system ID, message ID, data size and the data itself. Large batches may be compressed as a whole.
+/// The packet starts with a header of a fixed size, which is filled out by the user, e.g. with the system and message ID of the batch itself.
+class EZ_FOUNDATION_DLL ezNetworkMessageBatch
+{
+public:
+  /// \brief Optional protocol features, that both sides exchange during the connection handshake.
+  enum Features : ezUInt32
+  {
+    CombinedMessages = EZ_BIT(0), ///< The other side can decode BatchMsgID packets.
+    Compression = EZ_BIT(1),      ///< The other side can decode CompressedBatchMsgID packets.
+  };
+
+  static constexpr ezUInt32 BatchMsgID = 'BTCH';
+  static constexpr ezUInt32 CompressedBatchMsgID = 'ZBTC';
+
+  /// \brief A message inside of a received batch. The data points into the received packet or into the decompression buffer.
+  struct Message
+  {
+    ezUInt32 m_uiSystemID = 0;
+    ezUInt32 m_uiMsgID = 0;
+    ezArrayPtr<const ezUInt8> m_Data;
+  };
+
+  /// \brief Returns the features that should be announced to the other side with the given settings.
+  static ezUInt32 GetSupportedFeatures(const ezNetworkBatchingSettings& settings);
+
+  /// \brief Returns whether the packet with the given message ID contains a batch, that needs to be decoded with Unpack().
+  static bool IsBatch(ezUInt32 uiMsgID) { return uiMsgID == BatchMsgID || uiMsgID == CompressedBatchMsgID; }
+
+  /// \brief Decodes the messages of a received batch. \a packetData is the data after the packet header.
+  ///
+  /// Fails, if the data is not a valid batch, in which case none of the messages should be used.
+  static ezResult Unpack(ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> packetData, ezDynamicArray<ezUInt8>& ref_decompressed, ezDynamicArray<Message>& out_messages);
+
+  ezNetworkMessageBatch(ezUInt32 uiHeaderSize = 0);
+
+  /// \brief Appends a message to the batch.
+  void AddMessage(ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data);
+
+  bool IsEmpty() const { return m_uiNumMessages == 0; }
+
+  ezUInt32 GetNumMessages() const { return m_uiNumMessages; }
+
+  /// \brief Returns the size of the packet, if it is sent without compression.
+  ezUInt32 GetPacketSize() const { return m_Data.GetCount(); }
+
+  /// \brief Returns when the first message was added to the batch.
+  ezTime GetStartTime() const { return m_StartTime; }
+
+  /// \brief Returns the packet for all messages in the batch and the message ID that has to be written into the header.
+  ///
+  /// The first bytes of the packet are reserved for the header, which the caller has to fill out.
+  /// If the packet is at least \a uiCompressionThreshold bytes large (and the threshold isn't zero), it is compressed, if that makes it smaller.
+  /// The packet stays valid until Clear() is called.
+  ezArrayPtr<ezUInt8> GetPacket(ezUInt32 uiCompressionThreshold, ezUInt32& out_uiMsgID);
+
+  /// \brief Removes all messages.
+  void Clear();
+
+private:
+  ezUInt32 m_uiHeaderSize = 0;
+  ezUInt32 m_uiNumMessages = 0;
+  ezTime m_StartTime;
+  ezDynamicArray<ezUInt8> m_Data;
+  ezDynamicArray<ezUInt8> m_Compressed;
+  ezDynamicArray<ezUInt8> m_CompressedPacket;
+};
@@ -1,8 +1,17 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Communication/Implementation/NetworkMessageBatch.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Utilities/ConversionUtils.h>
 
+ezRemoteInterface::ezRemoteInterface()
+{
+  for (auto& pBatch : m_pBatches)
+  {
+    pBatch = EZ_DEFAULT_NEW(ezNetworkMessageBatch, 12);
+  }
+}
+
 ezRemoteInterface::~ezRemoteInterface()
 {
   // unfortunately we cannot do that ourselves here, because ShutdownConnection() calls virtual functions
@@ -20,6 +29,7 @@ ezResult ezRemoteInterface::CreateConnection(ezUInt32 uiConnectionToken, ezRemot
 
   m_uiConnectionToken = uiConnectionToken;
   m_sServerAddress = sServerAddress;
+  m_TrafficStats = ezNetworkTrafficStats();
 
   if (m_uiApplicationID == 0)
   {
@@ -87,8 +97,15 @@ void ezRemoteInterface::ShutdownConnection()
 
   if (m_RemoteMode != ezRemoteMode::None)
   {
+    FlushBatch(ezRemoteTransmitMode::Reliable);
+    FlushBatch(ezRemoteTransmitMode::Unreliable);
+
     InternalShutdownConnection();
 
+    m_uiPeerFeatures = 0;
+    m_pBatches[0]->Clear();
+    m_pBatches[1]->Clear();
+
     m_RemoteMode = ezRemoteMode::None;
     m_uiApplicationID = 0;
     m_uiConnectionToken = 0;
@@ -108,6 +125,9 @@ void ezRemoteInterface::UpdateRemoteInterface()
 {
   EZ_LOCK(GetMutex());
 
+  FlushBatch(ezRemoteTransmitMode::Reliable);
+  FlushBatch(ezRemoteTransmitMode::Unreliable);
+
   InternalUpdateRemoteInterface();
 }
 
@@ -121,6 +141,9 @@ ezResult ezRemoteInterface::Transmit(ezRemoteTransmitMode tm, const ezArrayPtr<c
   if (InternalTransmit(tm, data).Failed())
     return EZ_FAILURE;
 
+  ++m_TrafficStats.m_uiPacketsSent;
+  m_TrafficStats.m_uiBytesSent += data.GetCount();
+
   // make sure the message is processed immediately
   UpdateRemoteInterface();
 
@@ -134,6 +157,26 @@ void ezRemoteInterface::Send(ezUInt32 uiSystemID, ezUInt32 uiMsgID)
 }
 
 void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data)
+{
+  SendMessage(tm, uiSystemID, uiMsgID, data);
+}
+
+void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const void* pData /*= nullptr*/, ezUInt32 uiDataBytes /*= 0*/)
+{
+  SendMessage(tm, uiSystemID, uiMsgID, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(pData), uiDataBytes));
+}
+
+void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezRemoteMessage& ref_msg)
+{
+  Send(tm, ref_msg.GetSystemID(), ref_msg.GetMessageID(), ref_msg.m_Storage);
+}
+
+void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezContiguousMemoryStreamStorage& data)
+{
+  SendMessage(tm, uiSystemID, uiMsgID, {data.GetData(), data.GetStorageSize32()});
+}
+
+void ezRemoteInterface::SendMessage(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data)
 {
   if (m_RemoteMode == ezRemoteMode::None)
     return;
@@ -141,6 +184,41 @@ void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUIn
   // if (!IsConnectedToOther())
   //  return;
 
+  EZ_LOCK(GetMutex());
+
+  ++m_TrafficStats.m_uiMessagesSent;
+
+  const bool bCombine = (m_uiPeerFeatures & ezNetworkMessageBatch::CombinedMessages) != 0 && data.GetCount() <= m_BatchingSettings.m_uiMaxCombinedMessageSize;
+  const bool bCompress = (m_uiPeerFeatures & ezNetworkMessageBatch::Compression) != 0 && m_BatchingSettings.m_uiCompressionThreshold > 0 && data.GetCount() >= m_BatchingSettings.m_uiCompressionThreshold;
+
+  ezNetworkMessageBatch& batch = *m_pBatches[(int)tm];
+
+  if (bCombine || bCompress)
+  {
+    const ezUInt32 uiMaxBatchSize = (tm == ezRemoteTransmitMode::Reliable) ? m_BatchingSettings.m_uiMaxBatchSize : ezMath::Min(m_BatchingSettings.m_uiMaxBatchSize, m_BatchingSettings.m_uiMaxUnreliableBatchSize);
+
+    if (!batch.IsEmpty() && batch.GetPacketSize() + 12 + data.GetCount() > uiMaxBatchSize)
+    {
+      FlushBatch(tm);
+    }
+
+    batch.AddMessage(uiSystemID, uiMsgID, data);
+
+    // large messages are only put into a batch of their own to compress them
+    if (!bCombine || batch.GetPacketSize() >= uiMaxBatchSize || ezTime::Now() - batch.GetStartTime() >= m_BatchingSettings.m_MaxDelay)
+    {
+      FlushBatch(tm);
+
+      // make sure the message is processed immediately
+      UpdateRemoteInterface();
+    }
+
+    return;
+  }
+
+  // keep the order of the messages
+  FlushBatch(tm);
+
   m_TempSendBuffer.SetCountUninitialized(12 + data.GetCount());
   *((ezUInt32*)&m_TempSendBuffer[0]) = m_uiApplicationID;
   *((ezUInt32*)&m_TempSendBuffer[4]) = uiSystemID;
@@ -155,38 +233,50 @@ void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUIn
   Transmit(tm, m_TempSendBuffer).IgnoreResult();
 }
 
-void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const void* pData /*= nullptr*/, ezUInt32 uiDataBytes /*= 0*/)
+void ezRemoteInterface::FlushBatch(ezRemoteTransmitMode tm)
 {
-  Send(tm, uiSystemID, uiMsgID, ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(pData), uiDataBytes));
+  ezNetworkMessageBatch& batch = *m_pBatches[(int)tm];
+
+  if (batch.IsEmpty())
+    return;
+
+  const ezUInt32 uiCompressionThreshold = (m_uiPeerFeatures & ezNetworkMessageBatch::Compression) ? m_BatchingSettings.m_uiCompressionThreshold : 0;
+
+  ezUInt32 uiMsgID = 0;
+  ezArrayPtr<ezUInt8> packet = batch.GetPacket(uiCompressionThreshold, uiMsgID);
+  *((ezUInt32*)&packet[0]) = m_uiApplicationID;
+  *((ezUInt32*)&packet[4]) = m_uiConnectionToken;
+  *((ezUInt32*)&packet[8]) = uiMsgID;
+
+  if (m_RemoteMode != ezRemoteMode::None && InternalTransmit(tm, packet).Succeeded())
+  {
+    ++m_TrafficStats.m_uiPacketsSent;
+    m_TrafficStats.m_uiBytesSent += packet.GetCount();
+  }
+
+  batch.Clear();
 }
 
-void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezRemoteMessage& ref_msg)
+ezUInt32 ezRemoteInterface::GetOwnFeatures() const
 {
-  Send(tm, ref_msg.GetSystemID(), ref_msg.GetMessageID(), ref_msg.m_Storage);
+  return ezNetworkMessageBatch::GetSupportedFeatures(m_BatchingSettings);
 }
 
-void ezRemoteInterface::Send(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezContiguousMemoryStreamStorage& data)
+void ezRemoteInterface::SetPeerFeatures(ezUInt32 uiFeatures)
 {
-  if (m_RemoteMode == ezRemoteMode::None)
-    return;
-
-  // if (!IsConnectedToOther())
-  //  return;
+  EZ_LOCK(m_Mutex);
 
-  ezArrayPtr<const ezUInt8> range = {data.GetData(), data.GetStorageSize32()};
+  // features that are disabled locally are not used either
+  uiFeatures &= GetOwnFeatures();
 
-  m_TempSendBuffer.SetCountUninitialized(12 + range.GetCount());
-  *((ezUInt32*)&m_TempSendBuffer[0]) = m_uiApplicationID;
-  *((ezUInt32*)&m_TempSendBuffer[4]) = uiSystemID;
-  *((ezUInt32*)&m_TempSendBuffer[8]) = uiMsgID;
+  if (m_uiPeerFeatures == uiFeatures)
+    return;
 
-  if (!range.IsEmpty())
-  {
-    ezUInt8* pCopyDst = &m_TempSendBuffer[12];
-    ezMemoryUtils::Copy(pCopyDst, range.GetPtr(), range.GetCount());
-  }
+  // everything that was combined so far, was combined for the previous peers
+  FlushBatch(ezRemoteTransmitMode::Reliable);
+  FlushBatch(ezRemoteTransmitMode::Unreliable);
 
-  Transmit(tm, m_TempSendBuffer).IgnoreResult();
+  m_uiPeerFeatures = uiFeatures;
 }
 
 void ezRemoteInterface::SetMessageHandler(ezUInt32 uiSystemID, ezRemoteMessageHandler messageHandler)
@@ -1,5 +1,6 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Communication/Implementation/NetworkMessageBatch.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
 
 #ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
@@ -20,11 +21,17 @@ protected:
   virtual ezResult InternalTransmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data) override;
 
 private:
+  void HandleMessage(ENetPeer* pPeer, ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data);
+  void UpdateClientFeatures();
+
   ENetAddress m_EnetServerAddress;
   ENetHost* m_pEnetHost = nullptr;
   ENetPeer* m_pEnetConnectionToServer = nullptr;
   bool m_bAllowNetworkUpdates = true;
   ezMap<void*, ezUInt32> m_EnetPeerToClientID;
+  ezMap<void*, ezUInt32> m_EnetPeerFeatures;
+  ezDynamicArray<ezUInt8> m_DecompressedBatch;
+  ezDynamicArray<ezNetworkMessageBatch::Message> m_BatchMessages;
 
   static bool s_bEnetInitialized;
 };
@@ -135,6 +142,8 @@ void ezRemoteInterfaceEnetImpl::InternalShutdownConnection()
 
   // enet_deinitialize();
   m_pEnetConnectionToServer = nullptr;
+  m_EnetPeerToClientID.Clear();
+  m_EnetPeerFeatures.Clear();
 }
 
 ezTime ezRemoteInterfaceEnetImpl::InternalGetPingToServer()
@@ -208,9 +217,13 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
         }
         else
         {
-          const ezUInt32 uiAppID = GetApplicationID();
-          Send(ezRemoteTransmitMode::Reliable, GetConnectionToken(), 'EZID',
-            ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(&uiAppID), sizeof(ezUInt32)));
+          // the new client doesn't support anything, until it tells us otherwise
+          m_EnetPeerFeatures[NetworkEvent.peer] = 0;
+          UpdateClientFeatures();
+
+          // old clients only read the application ID and ignore the features
+          const ezUInt32 data[2] = {GetApplicationID(), GetOwnFeatures()};
+          Send(ezRemoteTransmitMode::Reliable, GetConnectionToken(), 'EZID', ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(data), sizeof(data)));
 
           // then wait for its acknowledgment message
         }
@@ -221,10 +234,14 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
       {
         if (GetRemoteMode() == ezRemoteMode::Client)
         {
+          SetPeerFeatures(0);
           ReportDisconnectedFromServer();
         }
         else
         {
+          m_EnetPeerFeatures.Remove(NetworkEvent.peer);
+          UpdateClientFeatures();
+
           auto it = m_EnetPeerToClientID.Find(NetworkEvent.peer);
           if (it.IsValid())
           {
@@ -240,39 +257,25 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
         const ezUInt32 uiApplicationID = *((ezUInt32*)&NetworkEvent.packet->data[0]);
         const ezUInt32 uiSystemID = *((ezUInt32*)&NetworkEvent.packet->data[4]);
         const ezUInt32 uiMsgID = *((ezUInt32*)&NetworkEvent.packet->data[8]);
-        const ezUInt8* pData = &NetworkEvent.packet->data[12];
+        const ezArrayPtr<const ezUInt8> data(&NetworkEvent.packet->data[12], (ezUInt32)NetworkEvent.packet->dataLength - 12);
 
-        if (uiSystemID == GetConnectionToken())
+        if (uiSystemID == GetConnectionToken() && ezNetworkMessageBatch::IsBatch(uiMsgID))
         {
-          switch (uiMsgID)
+          if (ezNetworkMessageBatch::Unpack(uiMsgID, data, m_DecompressedBatch, m_BatchMessages).Succeeded())
           {
-            case 'EZID':
-            {
-              // acknowledge that the ID has been received
-              Send(GetConnectionToken(), 'AKID');
-
-              // go tell the others about it
-              ezUInt32 uiServerID = *((ezUInt32*)pData);
-              ReportConnectionToServer(uiServerID);
-            }
-            break;
-
-            case 'AKID':
+            for (const auto& msg : m_BatchMessages)
             {
-              if (m_EnetPeerToClientID[NetworkEvent.peer] != uiApplicationID)
-              {
-                m_EnetPeerToClientID[NetworkEvent.peer] = uiApplicationID;
-
-                // the client received the server ID -> the connection has been established properly
-                ReportConnectionToClient(uiApplicationID);
-              }
+              HandleMessage(NetworkEvent.peer, uiApplicationID, msg.m_uiSystemID, msg.m_uiMsgID, msg.m_Data);
             }
-            break;
+          }
+          else
+          {
+            ezLog::Error("Received an invalid message batch.");
           }
         }
         else
         {
-          ReportMessage(uiApplicationID, uiSystemID, uiMsgID, ezArrayPtr<const ezUInt8>(pData, (ezUInt32)NetworkEvent.packet->dataLength - 12));
+          HandleMessage(NetworkEvent.peer, uiApplicationID, uiSystemID, uiMsgID, data);
         }
 
         enet_packet_destroy(NetworkEvent.packet);
@@ -285,6 +288,63 @@ void ezRemoteInterfaceEnetImpl::InternalUpdateRemoteInterface()
   }
 }
 
+void ezRemoteInterfaceEnetImpl::HandleMessage(ENetPeer* pPeer, ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data)
+{
+  if (uiSystemID != GetConnectionToken())
+  {
+    ReportMessage(uiApplicationID, uiSystemID, uiMsgID, data);
+    return;
+  }
+
+  switch (uiMsgID)
+  {
+    case 'EZID':
+    {
+      // old servers only send their ID
+      const ezUInt32 uiServerFeatures = (data.GetCount() >= 8) ? *((ezUInt32*)&data[4]) : 0;
+      SetPeerFeatures(uiServerFeatures);
+
+      // acknowledge that the ID has been received and tell the server what we support
+      const ezUInt32 uiOwnFeatures = GetOwnFeatures();
+      Send(ezRemoteTransmitMode::Reliable, GetConnectionToken(), 'AKID', &uiOwnFeatures, sizeof(ezUInt32));
+
+      // go tell the others about it
+      ezUInt32 uiServerID = *((ezUInt32*)data.GetPtr());
+      ReportConnectionToServer(uiServerID);
+    }
+    break;
+
+    case 'AKID':
+    {
+      // old clients send no data
+      m_EnetPeerFeatures[pPeer] = (data.GetCount() >= 4) ? *((ezUInt32*)data.GetPtr()) : 0;
+      UpdateClientFeatures();
+
+      if (m_EnetPeerToClientID[pPeer] != uiApplicationID)
+      {
+        m_EnetPeerToClientID[pPeer] = uiApplicationID;
+
+        // the client received the server ID -> the connection has been established properly
+        ReportConnectionToClient(uiApplicationID);
+      }
+    }
+    break;
+  }
+}
+
+void ezRemoteInterfaceEnetImpl::UpdateClientFeatures()
+{
+  // messages are broadcast to all clients, so only use what all of them support
+  ezUInt32 uiFeatures = m_EnetPeerFeatures.IsEmpty() ? 0 : 0xFFFFFFFF;
+
+  for (auto it = m_EnetPeerFeatures.GetIterator(); it.IsValid(); ++it)
+  {
+    uiFeatures &= it.Value();
+  }
+
+  SetPeerFeatures(uiFeatures);
+}
+
 #endif
 
 
@@ -1,5 +1,6 @@
 #include <Foundation/FoundationPCH.h>
 
+#include <Foundation/Communication/Implementation/NetworkMessageBatch.h>
 #include <Foundation/Communication/Telemetry.h>
 #include <Foundation/Threading/ThreadUtils.h>
 
@@ -22,11 +23,18 @@ ezString ezTelemetry::s_sServerIP;
 static bool g_bInitialized = false;
 ezTelemetry::ConnectionMode ezTelemetry::s_ConnectionMode = ezTelemetry::None;
 ezMap<ezUInt64, ezTelemetry::MessageQueue> ezTelemetry::s_SystemMessages;
+ezNetworkBatchingSettings ezTelemetry::s_BatchingSettings;
+ezUInt32 ezTelemetry::s_uiPeerFeatures = 0;
+ezNetworkTrafficStats ezTelemetry::s_TrafficStats;
 
 #ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
 static ENetAddress g_pServerAddress;
 static ENetHost* g_pHost = nullptr;
 static ENetPeer* g_pConnectionToServer = nullptr;
+static ezMap<void*, ezUInt32> g_PeerFeatures;
+static ezNetworkMessageBatch g_Batches[2] = {ezNetworkMessageBatch(8), ezNetworkMessageBatch(8)}; // indexed by ezTelemetry::TransmitMode
+static ezDynamicArray<ezUInt8> g_DecompressedBatch;
+static ezDynamicArray<ezNetworkMessageBatch::Message> g_BatchMessages;
 #endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
 
 void ezTelemetry::UpdateServerPing()
@@ -48,6 +56,13 @@ void ezTelemetry::UpdateNetwork()
 
   s_bAllowNetworkUpdate = false;
 
+  {
+    EZ_LOCK(GetTelemetryMutex());
+
+    FlushBatch(Reliable);
+    FlushBatch(Unreliable);
+  }
+
   ENetEvent NetworkEvent;
 
   while (true)
@@ -89,9 +104,15 @@ void ezTelemetry::UpdateNetwork()
         }
         else
         {
+          // the new client doesn't support anything, until it tells us otherwise
+          g_PeerFeatures[NetworkEvent.peer] = 0;
+          UpdateClientFeatures();
+
           // got a new client, send the server ID to it
+          // old clients only read the ID and ignore the features
+          const ezUInt32 data[2] = {s_uiApplicationID, ezNetworkMessageBatch::GetSupportedFeatures(s_BatchingSettings)};
           s_bConnectedToClient = true; // we need this fake state, otherwise Broadcast will queue the message instead of sending it
-          Broadcast(ezTelemetry::Reliable, 'EZBC', 'EZID', &s_uiApplicationID, sizeof(ezUInt32));
+          Broadcast(ezTelemetry::Reliable, 'EZBC', 'EZID', data, sizeof(data));
           s_bConnectedToClient = false;
 
           // then wait for its acknowledgment message
@@ -104,6 +125,7 @@ void ezTelemetry::UpdateNetwork()
         if (s_ConnectionMode == Client)
         {
           s_bConnectedToServer = false;
+          SetPeerFeatures(0);
 
           // First wait a bit to ensure that the Server could shut down, if this was a legitimate disconnect
           ezThreadUtils::Sleep(ezTime::MakeFromSeconds(1));
@@ -122,6 +144,9 @@ void ezTelemetry::UpdateNetwork()
           /// \todo This assumes we only connect to a single client ...
           s_bConnectedToClient = false;
 
+          g_PeerFeatures.Remove(NetworkEvent.peer);
+          UpdateClientFeatures();
+
           TelemetryEventData e;
           e.m_EventType = TelemetryEventData::DisconnectedFromClient;
 
@@ -132,88 +157,151 @@ void ezTelemetry::UpdateNetwork()
 
       case ENET_EVENT_TYPE_RECEIVE:
       {
+        EZ_ASSERT_DEV((ezUInt32)NetworkEvent.packet->dataLength >= 8, "Message Length Invalid: {0}", (ezUInt32)NetworkEvent.packet->dataLength);
+
         const ezUInt32 uiSystemID = *((ezUInt32*)&NetworkEvent.packet->data[0]);
         const ezUInt32 uiMsgID = *((ezUInt32*)&NetworkEvent.packet->data[4]);
-        const ezUInt8* pData = &NetworkEvent.packet->data[8];
+        const ezArrayPtr<const ezUInt8> data(&NetworkEvent.packet->data[8], (ezUInt32)NetworkEvent.packet->dataLength - 8);
 
-        if (uiSystemID == 'EZBC')
+        if (uiSystemID == 'EZBC' && ezNetworkMessageBatch::IsBatch(uiMsgID))
         {
-          switch (uiMsgID)
+          if (ezNetworkMessageBatch::Unpack(uiMsgID, data, g_DecompressedBatch, g_BatchMessages).Succeeded())
           {
-            case 'EZID':
+            for (const auto& msg : g_BatchMessages)
             {
-              s_uiServerID = *((ezUInt32*)pData);
+              HandleMessage(NetworkEvent.peer, msg.m_uiSystemID, msg.m_uiMsgID, msg.m_Data);
+            }
+          }
+          else
+          {
+            ezLog::Error("ezTelemetry: Received an invalid message batch.");
+          }
+        }
+        else
+        {
+          HandleMessage(NetworkEvent.peer, uiSystemID, uiMsgID, data);
+        }
 
-              // connection to server is finalized
-              s_bConnectedToServer = true;
+        enet_packet_destroy(NetworkEvent.packet);
+      }
+      break;
 
-              // acknowledge that the ID has been received
-              SendToServer('EZBC', 'AKID', nullptr, 0);
+      default:
+        break;
+    }
+  }
 
-              // go tell the others about it
-              TelemetryEventData e;
-              e.m_EventType = TelemetryEventData::ConnectedToServer;
+  s_bAllowNetworkUpdate = true;
+#endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
+}
 
-              s_TelemetryEvents.Broadcast(e);
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
 
-              FlushOutgoingQueues();
-            }
-            break;
-            case 'AKID':
-            {
-              // the client received the server ID -> the connection has been established properly
+void ezTelemetry::HandleMessage(void* pPeer, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data)
+{
+  if (uiSystemID == 'EZBC')
+  {
+    switch (uiMsgID)
+    {
+      case 'EZID':
+      {
+        s_uiServerID = *((ezUInt32*)data.GetPtr());
 
-              /// \todo This assumes we only connect to a single client ...
-              s_bConnectedToClient = true;
+        // old servers only send their ID
+        SetPeerFeatures((data.GetCount() >= 8) ? *((ezUInt32*)&data[4]) : 0);
 
-              // go tell the others about it
-              TelemetryEventData e;
-              e.m_EventType = TelemetryEventData::ConnectedToClient;
+        // connection to server is finalized
+        s_bConnectedToServer = true;
 
-              s_TelemetryEvents.Broadcast(e);
+        // acknowledge that the ID has been received and tell the server what we support
+        const ezUInt32 uiOwnFeatures = ezNetworkMessageBatch::GetSupportedFeatures(s_BatchingSettings);
+        SendToServer('EZBC', 'AKID', &uiOwnFeatures, sizeof(ezUInt32));
 
-              SendServerName();
-              FlushOutgoingQueues();
-            }
-            break;
+        // go tell the others about it
+        TelemetryEventData e;
+        e.m_EventType = TelemetryEventData::ConnectedToServer;
 
-            case 'NAME':
-            {
-              s_sServerName = reinterpret_cast<const char*>(pData);
-            }
-            break;
-          }
-        }
-        else
-        {
-          MessageQueue& Queue = s_SystemMessages[uiSystemID];
+        s_TelemetryEvents.Broadcast(e);
 
-          if (Queue.m_bAcceptMessages)
-          {
-            Queue.m_IncomingQueue.PushBack();
-            ezTelemetryMessage& Msg = Queue.m_IncomingQueue.PeekBack();
+        FlushOutgoingQueues();
+      }
+      break;
+      case 'AKID':
+      {
+        // old clients send no data
+        g_PeerFeatures[pPeer] = (data.GetCount() >= 4) ? *((ezUInt32*)data.GetPtr()) : 0;
+        UpdateClientFeatures();
 
-            Msg.SetMessageID(uiSystemID, uiMsgID);
+        // the client received the server ID -> the connection has been established properly
 
-            EZ_ASSERT_DEV((ezUInt32)NetworkEvent.packet->dataLength >= 8, "Message Length Invalid: {0}", (ezUInt32)NetworkEvent.packet->dataLength);
+        /// \todo This assumes we only connect to a single client ...
+        s_bConnectedToClient = true;
 
-            Msg.GetWriter().WriteBytes(pData, NetworkEvent.packet->dataLength - 8).IgnoreResult();
-          }
-        }
+        // go tell the others about it
+        TelemetryEventData e;
+        e.m_EventType = TelemetryEventData::ConnectedToClient;
 
-        enet_packet_destroy(NetworkEvent.packet);
+        s_TelemetryEvents.Broadcast(e);
+
+        SendServerName();
+        FlushOutgoingQueues();
       }
       break;
 
-      default:
-        break;
+      case 'NAME':
+      {
+        s_sServerName = reinterpret_cast<const char*>(data.GetPtr());
+      }
+      break;
     }
   }
+  else
+  {
+    MessageQueue& Queue = s_SystemMessages[uiSystemID];
 
-  s_bAllowNetworkUpdate = true;
-#endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
+    if (Queue.m_bAcceptMessages)
+    {
+      Queue.m_IncomingQueue.PushBack();
+      ezTelemetryMessage& Msg = Queue.m_IncomingQueue.PeekBack();
+
+      Msg.SetMessageID(uiSystemID, uiMsgID);
+      Msg.GetWriter().WriteBytes(data.GetPtr(), data.GetCount()).IgnoreResult();
+    }
+  }
 }
 
+void ezTelemetry::SetPeerFeatures(ezUInt32 uiFeatures)
+{
+  EZ_LOCK(GetTelemetryMutex());
+
+  // features that are disabled locally are not used either
+  uiFeatures &= ezNetworkMessageBatch::GetSupportedFeatures(s_BatchingSettings);
+
+  if (s_uiPeerFeatures == uiFeatures)
+    return;
+
+  // everything that was combined so far, was combined for the previous peers
+  FlushBatch(Reliable);
+  FlushBatch(Unreliable);
+
+  s_uiPeerFeatures = uiFeatures;
+}
+
+void ezTelemetry::UpdateClientFeatures()
+{
+  // messages are broadcast to all clients, so only use what all of them support
+  ezUInt32 uiFeatures = g_PeerFeatures.IsEmpty() ? 0 : 0xFFFFFFFF;
+
+  for (auto it = g_PeerFeatures.GetIterator(); it.IsValid(); ++it)
+  {
+    uiFeatures &= it.Value();
+  }
+
+  SetPeerFeatures(uiFeatures);
+}
+
+#endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
 void ezTelemetry::SetServerName(ezStringView sName)
 {
   if (s_ConnectionMode == ConnectionMode::Client)
@@ -336,6 +424,7 @@ ezResult ezTelemetry::OpenConnection(ConnectionMode Mode, ezStringView sConnectT
   }
 
   s_uiApplicationID = (ezUInt32)ezTime::Now().GetSeconds();
+  s_TrafficStats = ezNetworkTrafficStats();
 
   switch (Mode)
   {
@@ -377,6 +466,9 @@ void ezTelemetry::Transmit(TransmitMode tm, const void* pData, ezUInt32 uiDataBy
   ENetPacket* pPacket = enet_packet_create(pData, uiDataBytes, (tm == Reliable) ? ENET_PACKET_FLAG_RELIABLE : 0);
   enet_host_broadcast(g_pHost, 0, pPacket);
 
+  ++s_TrafficStats.m_uiPacketsSent;
+  s_TrafficStats.m_uiBytesSent += uiDataBytes;
+
   // make sure the message is processed immediately
   ezTelemetry::UpdateNetwork();
 #endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
@@ -394,16 +486,7 @@ void ezTelemetry::Send(TransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, c
   else
   {
     // when we do have a connection, just send the message out
-
-    ezHybridArray<ezUInt8, 64> TempData;
-    TempData.SetCountUninitialized(8 + uiDataBytes);
-    *((ezUInt32*)&TempData[0]) = uiSystemID;
-    *((ezUInt32*)&TempData[4]) = uiMsgID;
-
-    if (pData && uiDataBytes > 0)
-      ezMemoryUtils::Copy((ezUInt8*)&TempData[8], (ezUInt8*)pData, uiDataBytes);
-
-    Transmit(tm, &TempData[0], TempData.GetCount());
+    SendMessage(tm, uiSystemID, uiMsgID, ezArrayPtr<const ezUInt8>(static_cast<const ezUInt8*>(pData), pData != nullptr ? uiDataBytes : 0));
   }
 #endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
 }
@@ -458,11 +541,89 @@ void ezTelemetry::Send(TransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, e
   else
   {
     // when we do have a connection, just send the message out
-    Transmit(tm, &TempData[0], TempData.GetCount());
+    SendMessage(tm, uiSystemID, uiMsgID, TempData.GetArrayPtr().GetSubArray(8));
   }
 #endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
 }
 
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+void ezTelemetry::SendMessage(TransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data)
+{
+  EZ_LOCK(GetTelemetryMutex());
+
+  ++s_TrafficStats.m_uiMessagesSent;
+
+  const bool bCombine = (s_uiPeerFeatures & ezNetworkMessageBatch::CombinedMessages) != 0 && data.GetCount() <= s_BatchingSettings.m_uiMaxCombinedMessageSize;
+  const bool bCompress = (s_uiPeerFeatures & ezNetworkMessageBatch::Compression) != 0 && s_BatchingSettings.m_uiCompressionThreshold > 0 && data.GetCount() >= s_BatchingSettings.m_uiCompressionThreshold;
+
+  ezNetworkMessageBatch& batch = g_Batches[tm];
+
+  if (bCombine || bCompress)
+  {
+    const ezUInt32 uiMaxBatchSize = (tm == Reliable) ? s_BatchingSettings.m_uiMaxBatchSize : ezMath::Min(s_BatchingSettings.m_uiMaxBatchSize, s_BatchingSettings.m_uiMaxUnreliableBatchSize);
+
+    if (!batch.IsEmpty() && batch.GetPacketSize() + 12 + data.GetCount() > uiMaxBatchSize)
+    {
+      FlushBatch(tm);
+    }
+
+    batch.AddMessage(uiSystemID, uiMsgID, data);
+
+    // large messages are only put into a batch of their own to compress them
+    if (!bCombine || batch.GetPacketSize() >= uiMaxBatchSize || ezTime::Now() - batch.GetStartTime() >= s_BatchingSettings.m_MaxDelay)
+    {
+      FlushBatch(tm);
+
+      // make sure the message is processed immediately
+      UpdateNetwork();
+    }
+
+    return;
+  }
+
+  // keep the order of the messages
+  FlushBatch(tm);
+
+  ezHybridArray<ezUInt8, 64> TempData;
+  TempData.SetCountUninitialized(8 + data.GetCount());
+  *((ezUInt32*)&TempData[0]) = uiSystemID;
+  *((ezUInt32*)&TempData[4]) = uiMsgID;
+
+  if (!data.IsEmpty())
+    ezMemoryUtils::Copy(&TempData[8], data.GetPtr(), data.GetCount());
+
+  Transmit(tm, &TempData[0], TempData.GetCount());
+}
+
+void ezTelemetry::FlushBatch(TransmitMode tm)
+{
+  ezNetworkMessageBatch& batch = g_Batches[tm];
+
+  if (batch.IsEmpty())
+    return;
+
+  const ezUInt32 uiCompressionThreshold = (s_uiPeerFeatures & ezNetworkMessageBatch::Compression) ? s_BatchingSettings.m_uiCompressionThreshold : 0;
+
+  ezUInt32 uiMsgID = 0;
+  ezArrayPtr<ezUInt8> packet = batch.GetPacket(uiCompressionThreshold, uiMsgID);
+  *((ezUInt32*)&packet[0]) = 'EZBC';
+  *((ezUInt32*)&packet[4]) = uiMsgID;
+
+  if (g_pHost)
+  {
+    ENetPacket* pPacket = enet_packet_create(packet.GetPtr(), packet.GetCount(), (tm == Reliable) ? ENET_PACKET_FLAG_RELIABLE : 0);
+    enet_host_broadcast(g_pHost, 0, pPacket);
+
+    ++s_TrafficStats.m_uiPacketsSent;
+    s_TrafficStats.m_uiBytesSent += packet.GetCount();
+  }
+
+  batch.Clear();
+}
+
+#endif // BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
 void ezTelemetry::CloseConnection()
 {
 #ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
@@ -504,6 +665,11 @@ void ezTelemetry::CloseConnection()
     g_bInitialized = false;
   }
 
+  s_uiPeerFeatures = 0;
+  g_PeerFeatures.Clear();
+  g_Batches[Reliable].Clear();
+  g_Batches[Unreliable].Clear();
+
   // if there are any queued messages, throw them away
   for (auto it = s_SystemMessages.GetIterator(); it.IsValid(); ++it)
   {
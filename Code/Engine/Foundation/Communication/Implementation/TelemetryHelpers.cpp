@@ -117,6 +117,9 @@ void ezTelemetry::PerFrameUpdate()
   s_bAllowNetworkUpdate = false;
   s_TelemetryEvents.Broadcast(e);
   s_bAllowNetworkUpdate = bAllowUpdate;
+
+  // send the messages that were combined during this frame
+  UpdateNetwork();
 }
 
 void ezTelemetry::SetOutgoingQueueSize(ezUInt32 uiSystemID, ezUInt16 uiMaxQueued)
@@ -0,0 +1,45 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Time/Time.h>
+
+/// \brief Configures how ezRemoteInterface and ezTelemetry combine small messages into fewer network packets.
+///
+/// Combined messages and compression are only used when the other side announced support for them during the connection handshake,
+/// so that applications that don't know about them can still connect.
+struct EZ_FOUNDATION_DLL ezNetworkBatchingSettings
+{
+  /// \brief If disabled, every message is sent as its own packet. This is also announced to the other side, which then does the same.
+  bool m_bCombineMessages = true;
+
+  /// \brief Messages with more data than this are not combined with other messages, but sent right away.
+  ezUInt32 m_uiMaxCombinedMessageSize = 1024;
+
+  /// \brief A batch of reliable messages is sent once it has reached this size.
+  ezUInt32 m_uiMaxBatchSize = 16 * 1024;
+
+  /// \brief A batch of unreliable messages is sent once it has reached this size.
+  ///
+  /// Should stay below the size of a single network packet (enet uses an MTU of 1400 bytes by default), so that losing a fragment
+  /// doesn't lose all of the messages. Batches never get larger than m_uiMaxBatchSize either.
+  ezUInt32 m_uiMaxUnreliableBatchSize = 1200;
+
+  /// \brief How long messages may wait in a batch.
+  ///
+  /// This is only checked when the next message is sent. Without further messages, a batch is sent with the next network update,
+  /// so when nothing updates the network, the messages wait until then.
+  ezTime m_MaxDelay = ezTime::MakeFromMilliseconds(5);
+
+  /// \brief Packets with at least this many bytes are compressed with zstd. Zero disables compression.
+  ///
+  /// Only available when zstd support is compiled in, otherwise compression is never announced to the other side.
+  ezUInt32 m_uiCompressionThreshold = 2 * 1024;
+};
+
+/// \brief Counts what has been sent through ezRemoteInterface or ezTelemetry.
+struct ezNetworkTrafficStats
+{
+  ezUInt64 m_uiMessagesSent = 0; ///< Number of messages that were passed to Send().
+  ezUInt64 m_uiPacketsSent = 0;  ///< Number of packets that were handed to the network layer.
+  ezUInt64 m_uiBytesSent = 0;    ///< Size of all packets, after compression.
+};
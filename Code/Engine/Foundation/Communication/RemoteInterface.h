@@ -2,6 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Communication/Event.h>
+#include <Foundation/Communication/NetworkBatchingSettings.h>
 #include <Foundation/Communication/RemoteMessage.h>
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/Containers/HashTable.h>
@@ -9,6 +10,7 @@
 #include <Foundation/Threading/Thread.h>
 #include <Foundation/Time/Time.h>
 #include <Foundation/Types/Delegate.h>
+#include <Foundation/Types/UniquePtr.h>
 
 /// \brief Whether the remote interface is configured as a server or a client
 enum class ezRemoteMode
@@ -59,6 +61,7 @@ struct EZ_FOUNDATION_DLL ezRemoteMessageQueue
 class EZ_FOUNDATION_DLL ezRemoteInterface
 {
 public:
+  ezRemoteInterface();
   virtual ~ezRemoteInterface();
 
   /// \brief Exposes the mutex that is internally used to secure multi-threaded access
@@ -140,6 +143,8 @@ public:
   ///@{
 
   /// \brief If no update thread was spawned, this should be called to process messages
+  ///
+  /// This also sends all messages that have been combined into batches so far.
   void UpdateRemoteInterface();
 
   /// \brief If no update thread was spawned, this should be called by clients to determine the ping
@@ -172,6 +177,17 @@ public:
   /// If it is a client, the message is only sent to the server.
   void Send(ezRemoteTransmitMode tm, ezRemoteMessage& ref_msg);
 
+  /// \brief Configures how small messages are combined into fewer packets and which packets get compressed.
+  ///
+  /// Should be called before the connection is created, because the enabled features are announced to the other side during the handshake.
+  void SetBatchingSettings(const ezNetworkBatchingSettings& settings) { m_BatchingSettings = settings; }
+
+  /// \brief Returns the settings for combining messages.
+  const ezNetworkBatchingSettings& GetBatchingSettings() const { return m_BatchingSettings; }
+
+  /// \brief Returns how many messages, packets and bytes were sent since the connection was created.
+  const ezNetworkTrafficStats& GetTrafficStats() const { return m_TrafficStats; }
+
   ///@}
 
   /// \name Message Handling
@@ -234,6 +250,14 @@ protected:
   /// \brief Should be called by the implementation, when a message has arrived
   void ReportMessage(ezUInt32 uiApplicationID, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data);
 
+  /// \brief Returns the ezNetworkMessageBatch::Features that the implementation should announce to the other side during the handshake.
+  ezUInt32 GetOwnFeatures() const;
+
+  /// \brief Should be called by the implementation, when the features that all connected peers support have changed.
+  ///
+  /// Messages are only combined and compressed, when the peers support it.
+  void SetPeerFeatures(ezUInt32 uiFeatures);
+
   ///@}
 
 
@@ -241,6 +265,8 @@ private:
   void StartUpdateThread();
   void StopUpdateThread();
   ezResult Transmit(ezRemoteTransmitMode tm, const ezArrayPtr<const ezUInt8>& data);
+  void SendMessage(ezRemoteTransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, const ezArrayPtr<const ezUInt8>& data);
+  void FlushBatch(ezRemoteTransmitMode tm);
   ezResult CreateConnection(ezUInt32 uiConnectionToken, ezRemoteMode mode, ezStringView sServerAddress, bool bStartUpdateThread);
   ezUInt32 ExecuteMessageHandlersForQueue(ezRemoteMessageQueue& queue);
 
@@ -255,6 +281,11 @@ private:
   ezInt32 m_iConnectionsToClients = 0;
   ezDynamicArray<ezUInt8> m_TempSendBuffer;
   ezHashTable<ezUInt32, ezRemoteMessageQueue> m_MessageQueues;
+
+  ezNetworkBatchingSettings m_BatchingSettings;
+  ezUInt32 m_uiPeerFeatures = 0;
+  ezUniquePtr<class ezNetworkMessageBatch> m_pBatches[2]; // indexed by ezRemoteTransmitMode
+  ezNetworkTrafficStats m_TrafficStats;
 };
 
 /// \brief The remote interface thread updates in regular intervals to keep the connection alive.
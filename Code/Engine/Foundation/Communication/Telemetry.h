@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Communication/Implementation/TelemetryMessage.h>
+#include <Foundation/Communication/NetworkBatchingSettings.h>
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
@@ -71,6 +72,18 @@ public:
   static void SendToServer(ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezStreamReader& inout_stream, ezInt32 iDataBytes = -1);
   static void SendToServer(ezTelemetryMessage& ref_msg);
 
+  /// \brief Configures how small messages are combined into fewer packets and which packets get compressed.
+  ///
+  /// Should be called before the connection is opened, because the enabled features are announced to the other side during the handshake.
+  /// Combined messages are sent at the latest at the end of PerFrameUpdate() or whenever the network is updated.
+  static void SetBatchingSettings(const ezNetworkBatchingSettings& settings) { s_BatchingSettings = settings; }
+
+  /// \brief Returns the settings for combining messages.
+  static const ezNetworkBatchingSettings& GetBatchingSettings() { return s_BatchingSettings; }
+
+  /// \brief Returns how many messages, packets and bytes were sent since the connection was opened.
+  static const ezNetworkTrafficStats& GetTrafficStats() { return s_TrafficStats; }
+
   /// @}
 
   /// \name Querying State
@@ -200,6 +213,12 @@ private:
   static void Send(TransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezStreamReader& Stream, ezInt32 iDataBytes = -1);
   static void Send(TransmitMode tm, ezTelemetryMessage& msg);
 
+  static void SendMessage(TransmitMode tm, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data);
+  static void FlushBatch(TransmitMode tm);
+  static void SetPeerFeatures(ezUInt32 uiFeatures);
+  static void UpdateClientFeatures();
+  static void HandleMessage(void* pPeer, ezUInt32 uiSystemID, ezUInt32 uiMsgID, ezArrayPtr<const ezUInt8> data);
+
   friend class ezTelemetryThread;
 
   static void FlushOutgoingQueues();
@@ -224,6 +243,10 @@ private:
 
   static ezTime s_PingToServer;
 
+  static ezNetworkBatchingSettings s_BatchingSettings;
+  static ezUInt32 s_uiPeerFeatures;
+  static ezNetworkTrafficStats s_TrafficStats;
+
   using MessageDeque = ezDeque<ezTelemetryMessage>;
 
   struct MessageQueue
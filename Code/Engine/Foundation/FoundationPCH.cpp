@@ -72,14 +72,17 @@ EZ_STATICLINK_LIBRARY(Foundation)
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_Archive);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveBuilder);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveReader);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveSeekableZstd);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_ArchiveUtils);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Archive_Implementation_DataDirTypeArchive);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_DataDirFileIndex);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_DataDirType);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_DataDirTypeFolder);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_DeferredFileWriter);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileSystem);
   EZ_STATICLINK_REFERENCE(Foundation_IO_FileSystem_Implementation_FileWriter);
+  EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_AsyncFileReader);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_ChunkStream);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_CompressedStreamZstd);
   EZ_STATICLINK_REFERENCE(Foundation_IO_Implementation_DeduplicationContext);
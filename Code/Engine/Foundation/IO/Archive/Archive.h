@@ -12,6 +12,7 @@ enum class ezArchiveCompressionMode : ezUInt8
   Uncompressed,
   Compressed_zstd,
   Compressed_zip,
+  Compressed_zstd_seekable, ///< zstd compressed in independent frames with a seek table, see ezArchiveSeekableZstdWriter. Allows random access and parallel decompression.
 };
 
 /// \brief Data for a single file entry in an ezArchive file
@@ -103,6 +104,9 @@ public:
   ezHashTable<ezArchiveStoredString, ezUInt32> m_PathToEntryIndex;
   /// one large array holding all path strings for the file entries, to reduce allocations
   ezDynamicArray<ezUInt8> m_AllPathStrings;
+  /// byte offset and size of the zstd dictionary that Compressed_zstd_seekable entries may use, zero if the archive has no dictionary
+  ezUInt64 m_uiDictionaryDataOffset = 0;
+  ezUInt64 m_uiDictionaryDataSize = 0;
 
   /// \brief Returns the entry index for the given file or ezInvalidIndex, if not found.
   ezUInt32 FindEntry(ezStringView sFile) const;
@@ -22,6 +22,21 @@ public:
   // all the source files from disk that should be put into the ezArchive
   ezDeque<SourceEntry> m_Entries;
 
+  /// \brief If non-zero, a zstd dictionary of up to this many bytes is trained from the small Compressed_zstd_seekable entries and stored in the archive.
+  ///
+  /// Small files compress much better with a shared dictionary, since each of them can reference data that is common to all of them.
+  ezUInt32 m_uiZstdDictionarySize = 0;
+
+  /// \brief Only Compressed_zstd_seekable entries up to this size are used to train the dictionary and are compressed with it.
+  ezUInt64 m_uiZstdDictionaryMaxFileSize = 128 * 1024;
+
+  /// \brief If larger than one, the data of every entry is stored at a multiple of this many bytes (relative to the start of the archive). Must be a power of two.
+  ///
+  /// Uncompressed entries can be accessed in place from the memory-mapped archive (see ezFileReaderBase::GetMappedFileData()).
+  /// With a sufficient alignment, such data (e.g. vertex data or SIMD types) can be used directly, without copying it to an aligned buffer first.
+  /// The padding increases the archive size by up to this many bytes per entry.
+  ezUInt32 m_uiDataAlignment = 0;
+
   enum class InclusionMode
   {
     Exclude,               ///< Do not add this file to the archive
@@ -39,6 +54,7 @@ public:
   /// \brief Iterates over all files in a folder and adds them to m_Entries for later.
   ///
   /// The callback can be used to exclude certain files or to deactivate compression on them.
+  /// If \a defaultMode is ezArchiveCompressionMode::Compressed_zstd_seekable, the Compress_zstd_* inclusion modes use the seekable format as well.
   /// \note If no callback is given, the default is to store all files uncompressed!
   void AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressionMode defaultMode = ezArchiveCompressionMode::Uncompressed, InclusionCallback callback = InclusionCallback());
 
@@ -49,6 +65,9 @@ public:
   ezResult WriteArchive(ezStreamWriter& inout_stream) const;
 
 protected:
+  bool IsZstdDictionaryCandidate(const SourceEntry& entry) const;
+  ezResult TrainZstdDictionary(ezDynamicArray<ezUInt8>& out_dictionary) const;
+
   /// Override this to get a callback when the next file is being written to the output. Return 'true' to continue, 'false' to cancel the entire archive generation.
   virtual bool WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
   /// Override this to get a progress report for writing a single file to the output
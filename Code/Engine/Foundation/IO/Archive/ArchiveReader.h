@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/IO/Archive/Archive.h>
+#include <Foundation/IO/Archive/ArchiveSeekableZstd.h>
 #include <Foundation/IO/MemoryMappedFile.h>
 #include <Foundation/Types/UniquePtr.h>
 
@@ -30,9 +31,23 @@ public:
   /// \brief Sets up \a memReader for reading the raw (potentially compressed) data that is stored for the given entry in the archive.
   void ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawMemoryStreamReader& ref_memReader) const;
 
+  /// \brief Returns the raw (potentially compressed) data that is stored for the given entry. It stays valid as long as the archive is open.
+  ///
+  /// Returns an empty array for entries that store 4 GB or more, use ConfigureRawMemoryStreamReader() for those.
+  ezArrayPtr<const ezUInt8> GetEntryStoredData(ezUInt32 uiEntryIdx) const;
+
   /// \brief Creates a reader that will decompress the given file entry.
   ezUniquePtr<ezStreamReader> CreateEntryReader(ezUInt32 uiEntryIdx) const;
 
+  /// \brief Reads a range of the uncompressed data of the given entry into \a out_data. Returns how many bytes were read.
+  ///
+  /// For uncompressed and seekable zstd entries, only the requested range is accessed (and decompressed).
+  /// For all other compression modes, the entry has to be decompressed from the start.
+  ezUInt64 ReadEntryRange(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezArrayPtr<ezUInt8> out_data) const;
+
+  /// \brief Returns the zstd dictionary that is stored in the archive, or nullptr if the archive has none.
+  const ezArchiveZstdDictionary* GetZstdDictionary() const;
+
 protected:
   /// \brief Called by ExtractAllFiles() for progress reporting. Return false to abort.
   virtual bool ExtractNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const;
@@ -45,4 +60,8 @@ protected:
   ezUInt8 m_uiArchiveVersion = 0;
   const void* m_pDataStart = nullptr;
   ezUInt64 m_uiMemFileSize = 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  ezArchiveZstdDictionary m_ZstdDictionary;
+#endif
 };
@@ -0,0 +1,166 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/Stream.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+/// \brief A zstd dictionary that is shared by the (small) entries of an ezArchive, to improve their compression ratio.
+///
+/// The dictionary data itself is not copied, it must stay valid for as long as the dictionary is in use.
+/// A dictionary that is initialized for reading can be used by multiple threads at the same time.
+class EZ_FOUNDATION_DLL ezArchiveZstdDictionary
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveZstdDictionary);
+
+public:
+  ezArchiveZstdDictionary();
+  ~ezArchiveZstdDictionary();
+
+  /// \brief Builds a dictionary of at most \a uiMaxSize bytes from the given samples (e.g. the content of many small files).
+  ///
+  /// The dictionary is made up of the byte sequences that occur in the most samples. It is stored as a 'raw content' zstd dictionary.
+  static void Train(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxSize, ezDynamicArray<ezUInt8>& out_dictionary); // [tested]
+
+  /// \brief Prepares the dictionary for decompression.
+  ezResult InitializeForReading(ezArrayPtr<const ezUInt8> dictionary); // [tested]
+
+  /// \brief Prepares the dictionary for decompression and for compression with the given compression level.
+  ezResult InitializeForWriting(ezArrayPtr<const ezUInt8> dictionary, ezInt32 iCompressionLevel); // [tested]
+
+  /// \brief Releases the zstd dictionary objects.
+  void Clear();
+
+  /// \brief Returns whether the dictionary can be used for decompression.
+  bool IsValid() const { return m_pDDict != nullptr; }
+
+  /// \brief Returns the compression level that was passed to InitializeForWriting().
+  ezInt32 GetCompressionLevel() const { return m_iCompressionLevel; }
+
+  /// \brief Returns the dictionary data.
+  ezArrayPtr<const ezUInt8> GetData() const { return m_Data; }
+
+private:
+  friend class ezArchiveSeekableZstdWriter;
+  friend class ezArchiveSeekableZstdReader;
+
+  ezArrayPtr<const ezUInt8> m_Data;
+  ezInt32 m_iCompressionLevel = 0;
+  /*ZSTD_CDict*/ void* m_pCDict = nullptr;
+  /*ZSTD_DDict*/ void* m_pDDict = nullptr;
+};
+
+/// \brief A stream writer that compresses the incoming data into independently compressed zstd frames, followed by a seek table.
+///
+/// This is the format of ezArchiveCompressionMode::Compressed_zstd_seekable. Since every frame can be decompressed on its own,
+/// ezArchiveSeekableZstdReader can read any range of the data without decompressing everything before it, and it can decompress
+/// multiple frames in parallel. The frames are compressed in parallel as well.
+///
+/// Smaller frames allow more fine-grained random access, but reduce the compression ratio.
+class EZ_FOUNDATION_DLL ezArchiveSeekableZstdWriter final : public ezStreamWriter
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveSeekableZstdWriter);
+
+public:
+  static constexpr ezUInt32 DefaultFrameSize = 256 * 1024;
+
+  ezArchiveSeekableZstdWriter();
+  ~ezArchiveSeekableZstdWriter();
+
+  /// \brief Configures the writer to output the compressed data to the given stream.
+  ///
+  /// If a dictionary is given, it must have been initialized with InitializeForWriting(). Its compression level overrides \a iCompressionLevel.
+  /// The same dictionary has to be passed to ezArchiveSeekableZstdReader for decompression.
+  void SetOutputStream(ezStreamWriter* pOutputStream, ezInt32 iCompressionLevel, const ezArchiveZstdDictionary* pDictionary = nullptr, ezUInt32 uiFrameSize = DefaultFrameSize); // [tested]
+
+  /// \brief Compresses the data and passes it on to the output stream, whenever enough data for a batch of frames was collected.
+  virtual ezResult WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite) override; // [tested]
+
+  /// \brief Compresses all remaining data and writes the seek table. Afterwards the writer has to be configured again for further use.
+  ezResult FinishCompressedStream(); // [tested]
+
+  /// \brief Returns the number of uncompressed bytes that were passed in.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Returns how many bytes were written to the output stream, including the seek table.
+  ezUInt64 GetWrittenBytes() const { return m_uiWrittenBytes; } // [tested]
+
+private:
+  ezResult CompressPendingFrames();
+
+  ezStreamWriter* m_pOutputStream = nullptr;
+  const ezArchiveZstdDictionary* m_pDictionary = nullptr;
+  ezInt32 m_iCompressionLevel = 0;
+  ezUInt32 m_uiFrameSize = DefaultFrameSize;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiWrittenBytes = 0;
+
+  ezDynamicArray<ezUInt8> m_PendingData;
+  ezDynamicArray<ezDynamicArray<ezUInt8>> m_CompressedFrames;
+  ezDynamicArray<ezUInt32> m_FrameSizes;
+  ezDynamicArray<void*> m_CompressionContexts;
+};
+
+/// \brief Reads data that was written with ezArchiveSeekableZstdWriter.
+///
+/// The stored data has to be fully accessible in memory (e.g. through a memory mapped ezArchive).
+/// Besides sequential reading, ReadAt() allows to read any range of the data. Frames that are fully covered by a read are decompressed in parallel
+/// directly into the target buffer, partially covered frames go through an internal cache.
+class EZ_FOUNDATION_DLL ezArchiveSeekableZstdReader : public ezStreamReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezArchiveSeekableZstdReader);
+
+public:
+  ezArchiveSeekableZstdReader();
+  ~ezArchiveSeekableZstdReader();
+
+  /// \brief Configures the reader to decompress the given data. Fails if the seek table is invalid or a required dictionary is missing.
+  ///
+  /// Calling this a second time on the same instance is valid and allows to reuse the decoder and its cache.
+  ezResult SetInputData(ezArrayPtr<const ezUInt8> storedData, const ezArchiveZstdDictionary* pDictionary = nullptr); // [tested]
+
+  /// \brief Reads from the current read position and advances it.
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override; // [tested]
+
+  /// \brief Advances the read position without decompressing anything.
+  virtual ezUInt64 SkipBytes(ezUInt64 uiBytesToSkip) override; // [tested]
+
+  /// \brief Reads up to \a uiBytesToRead bytes, starting at the given uncompressed offset. Does not change the read position.
+  ezUInt64 ReadAt(ezUInt64 uiOffset, void* pReadBuffer, ezUInt64 uiBytesToRead); // [tested]
+
+  /// \brief Sets the read position for ReadBytes().
+  void SetReadPosition(ezUInt64 uiReadPosition) { m_uiReadPosition = ezMath::Min(uiReadPosition, m_uiUncompressedSize); }
+
+  ezUInt64 GetReadPosition() const { return m_uiReadPosition; }
+
+  /// \brief Returns the size of the decompressed data.
+  ezUInt64 GetUncompressedSize() const { return m_uiUncompressedSize; }
+
+  /// \brief Returns how many independently compressed frames the data consists of.
+  ezUInt32 GetNumFrames() const { return m_FrameOffsets.IsEmpty() ? 0 : m_FrameOffsets.GetCount() - 1; }
+
+  /// \brief Returns whether the data was compressed with a dictionary.
+  bool UsesDictionary() const { return m_pDictionary != nullptr; }
+
+  /// \brief Checks the seek table of the given data, whether it was compressed with a dictionary.
+  static bool RequiresDictionary(ezArrayPtr<const ezUInt8> storedData);
+
+private:
+  ezUInt64 GetFrameSize(ezUInt32 uiFrame) const;
+  ezResult DecompressFrame(void* pDStream, ezUInt32 uiFrame, void* pTarget) const;
+  ezResult DecompressFrameToCache(ezUInt32 uiFrame);
+
+  ezArrayPtr<const ezUInt8> m_StoredData;
+  const ezArchiveZstdDictionary* m_pDictionary = nullptr;
+  ezUInt64 m_uiUncompressedSize = 0;
+  ezUInt64 m_uiReadPosition = 0;
+  ezUInt32 m_uiFrameSize = 0;
+  ezDynamicArray<ezUInt64> m_FrameOffsets; ///< Where each frame starts in m_StoredData, with one additional entry for the end.
+
+  ezUInt32 m_uiCachedFrame = ezInvalidIndex;
+  ezDynamicArray<ezUInt8> m_FrameCache;
+  /*ZSTD_DCtx*/ void* m_pDContext = nullptr;
+};
+
+#endif
@@ -10,6 +10,7 @@ class ezMemoryMappedFile;
 class ezArchiveTOC;
 class ezArchiveEntry;
 class ezRawMemoryStreamReader;
+class ezArchiveZstdDictionary;
 
 /// \brief Utilities for working with ezArchive files
 namespace ezArchiveUtils
@@ -25,6 +26,9 @@ namespace ezArchiveUtils
   /// \brief Checks case insensitive, whether the given extension is in the list of GetAcceptedArchiveFileExtensions().
   EZ_FOUNDATION_DLL bool IsAcceptedArchiveFileExtensions(ezStringView sExtension);
 
+  /// \brief The number of bytes that WriteHeader() writes. The archive data starts directly after the header.
+  constexpr ezUInt32 HeaderSize = 16;
+
   /// \brief Writes the header that identifies the ezArchive file and version to the stream
   EZ_FOUNDATION_DLL ezResult WriteHeader(ezStreamWriter& inout_stream);
 
@@ -41,15 +45,16 @@ namespace ezArchiveUtils
   ///
   /// Appends information to the TOC for finding the data in the stream. Reads and updates inout_uiCurrentStreamPosition with the data byte
   /// offset. The progress callback is executed for every couple of KB of data that were written.
+  /// The dictionary is only used by ezArchiveCompressionMode::Compressed_zstd_seekable and must have been initialized for writing.
   EZ_FOUNDATION_DLL ezResult WriteEntry(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezArchiveZstdDictionary* pDictionary = nullptr);
 
   /// \brief Similar to WriteEntry, but if compression is enabled, checks that compression makes enough of a difference.
   /// If compression does not reduce file size enough, the file is stored uncompressed instead.
   EZ_FOUNDATION_DLL ezResult WriteEntryOptimal(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset,
     ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition,
-    FileWriteProgressCallback progress = FileWriteProgressCallback());
+    FileWriteProgressCallback progress = FileWriteProgressCallback(), const ezArchiveZstdDictionary* pDictionary = nullptr);
 
   /// \brief Configures \a memReader as a view into the data stored for \a entry in the archive file.
   ///
@@ -60,7 +65,9 @@ namespace ezArchiveUtils
   /// \brief Creates a new stream reader which allows to read the uncompressed data for the given archive entry.
   ///
   /// Under the hood it may create different types of stream readers to uncompress or decode the data.
-  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData);
+  /// Entries that were compressed with a dictionary can only be read, if the same dictionary is passed in.
+  /// Returns nullptr, if the entry can't be read.
+  EZ_FOUNDATION_DLL ezUniquePtr<ezStreamReader> CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezArchiveZstdDictionary* pDictionary = nullptr);
 
   EZ_FOUNDATION_DLL ezResult ReadZipHeader(ezStreamReader& inout_stream, ezUInt8& out_uiVersion);
   EZ_FOUNDATION_DLL ezResult ExtractZipTOC(ezMemoryMappedFile& ref_memFile, ezArchiveTOC& ref_toc);
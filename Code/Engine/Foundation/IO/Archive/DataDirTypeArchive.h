@@ -13,6 +13,7 @@ namespace ezDataDirectory
 {
   class ArchiveReaderUncompressed;
   class ArchiveReaderZstd;
+  class ArchiveReaderZstdSeekable;
   class ArchiveReaderZip;
 
   class EZ_FOUNDATION_DLL ArchiveType : public ezDataDirectoryType
@@ -44,12 +45,16 @@ namespace ezDataDirectory
     ezArchiveReader m_ArchiveReader;
 
     ezMutex m_ReaderMutex;
+    ezUInt32 m_uiNumOpenReaders = 0;
+    bool m_bRemoveWhenUnused = false; ///< Set when the data directory is removed while files are still open, it is deleted once they are closed.
     ezHybridArray<ezUniquePtr<ArchiveReaderUncompressed>, 4> m_ReadersUncompressed;
     ezHybridArray<ArchiveReaderUncompressed*, 4> m_FreeReadersUncompressed;
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
     ezHybridArray<ezUniquePtr<ArchiveReaderZstd>, 4> m_ReadersZstd;
     ezHybridArray<ArchiveReaderZstd*, 4> m_FreeReadersZstd;
+    ezHybridArray<ezUniquePtr<ArchiveReaderZstdSeekable>, 4> m_ReadersZstdSeekable;
+    ezHybridArray<ArchiveReaderZstdSeekable*, 4> m_FreeReadersZstdSeekable;
 #endif
   };
 
@@ -63,6 +68,7 @@ namespace ezDataDirectory
 
     virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
     virtual ezUInt64 GetFileSize() const override;
+    virtual ezArrayPtr<const ezUInt8> GetMappedFileData() const override { return m_MappedData; }
 
   protected:
     virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
@@ -73,6 +79,7 @@ namespace ezDataDirectory
     ezUInt64 m_uiUncompressedSize = 0;
     ezUInt64 m_uiCompressedSize = 0;
     ezRawMemoryStreamReader m_MemStreamReader;
+    ezArrayPtr<const ezUInt8> m_MappedData; ///< Only set for uncompressed entries, points directly into the memory-mapped archive.
   };
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
@@ -93,6 +100,26 @@ namespace ezDataDirectory
 
     ezCompressedStreamReaderZstd m_CompressedStreamReader;
   };
+
+  class EZ_FOUNDATION_DLL ArchiveReaderZstdSeekable : public ArchiveReaderUncompressed
+  {
+    EZ_DISALLOW_COPY_AND_ASSIGN(ArchiveReaderZstdSeekable);
+
+  public:
+    ArchiveReaderZstdSeekable(ezInt32 iDataDirUserData);
+    ~ArchiveReaderZstdSeekable();
+
+    virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) override;
+
+  protected:
+    virtual ezResult InternalOpen(ezFileShareMode::Enum FileShareMode) override;
+
+    friend class ArchiveType;
+
+    ezArrayPtr<const ezUInt8> m_StoredData;
+    const ezArchiveZstdDictionary* m_pDictionary = nullptr;
+    ezArchiveSeekableZstdReader m_SeekableReader;
+  };
 #endif
 
 
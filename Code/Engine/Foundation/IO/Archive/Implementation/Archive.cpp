@@ -38,7 +38,7 @@ ezStringView ezArchiveTOC::GetEntryPathString(ezUInt32 uiEntryIdx) const
 
 ezResult ezArchiveTOC::Serialize(ezStreamWriter& inout_stream) const
 {
-  inout_stream.WriteVersion(2);
+  inout_stream.WriteVersion(3);
 
   EZ_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_Entries));
 
@@ -50,6 +50,9 @@ ezResult ezArchiveTOC::Serialize(ezStreamWriter& inout_stream) const
 
   EZ_SUCCEED_OR_RETURN(inout_stream.WriteArray(m_AllPathStrings));
 
+  inout_stream << m_uiDictionaryDataOffset;
+  inout_stream << m_uiDictionaryDataSize;
+
   return EZ_SUCCESS;
 }
 
@@ -82,10 +85,10 @@ struct ezHashHelper<ezOldTempHashedString>
 
 ezResult ezArchiveTOC::Deserialize(ezStreamReader& inout_stream, ezUInt8 uiArchiveVersion)
 {
-  EZ_ASSERT_ALWAYS(uiArchiveVersion <= 4, "Unsupported archive version {}", uiArchiveVersion);
+  EZ_ASSERT_ALWAYS(uiArchiveVersion <= 5, "Unsupported archive version {}", uiArchiveVersion);
 
   // we don't use the TOC version anymore, but the archive version instead
-  const ezTypeVersion version = inout_stream.ReadVersion(2);
+  const ezTypeVersion version = inout_stream.ReadVersion(3);
 
   EZ_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_Entries));
 
@@ -116,6 +119,15 @@ ezResult ezArchiveTOC::Deserialize(ezStreamReader& inout_stream, ezUInt8 uiArchi
 
   EZ_SUCCEED_OR_RETURN(inout_stream.ReadArray(m_AllPathStrings));
 
+  m_uiDictionaryDataOffset = 0;
+  m_uiDictionaryDataSize = 0;
+
+  if (version >= 3)
+  {
+    inout_stream >> m_uiDictionaryDataOffset;
+    inout_stream >> m_uiDictionaryDataSize;
+  }
+
   if (bRecreateStringHashes)
   {
     ezLog::Info("Archive uses older string hashing, recomputing hashes.");
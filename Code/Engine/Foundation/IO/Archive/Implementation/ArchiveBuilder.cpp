@@ -1,6 +1,7 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveSeekableZstd.h>
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
@@ -19,6 +20,8 @@ void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressi
   ezStringBuilder fullPath;
   ezStringBuilder relPath;
 
+  const ezArchiveCompressionMode zstdMode = (defaultMode == ezArchiveCompressionMode::Compressed_zstd_seekable) ? ezArchiveCompressionMode::Compressed_zstd_seekable : ezArchiveCompressionMode::Compressed_zstd;
+
   for (fileIt.StartSearch(sBasePath, ezFileSystemIteratorFlags::ReportFilesRecursive); fileIt.IsValid(); fileIt.Next())
   {
     const auto& stat = fileIt.GetStats();
@@ -43,23 +46,23 @@ void ezArchiveBuilder::AddFolder(ezStringView sAbsFolderPath, ezArchiveCompressi
             break;
 
           case InclusionMode::Compress_zstd_fastest:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fastest);
             break;
           case InclusionMode::Compress_zstd_fast:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Fast);
             break;
           case InclusionMode::Compress_zstd_average:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Average);
             break;
           case InclusionMode::Compress_zstd_high:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::High);
             break;
           case InclusionMode::Compress_zstd_highest:
-            compression = ezArchiveCompressionMode::Compressed_zstd;
+            compression = zstdMode;
             iCompressionLevel = static_cast<ezInt32>(ezCompressedStreamWriterZstd::Compression::Highest);
             break;
         }
@@ -94,6 +97,8 @@ ezResult ezArchiveBuilder::WriteArchive(ezStringView sFile) const
 
 ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 {
+  EZ_ASSERT_DEV(m_uiDataAlignment == 0 || ezMath::IsPowerOf2(m_uiDataAlignment), "The data alignment must be a power of two.");
+
   EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteHeader(inout_stream));
 
   ezArchiveTOC toc;
@@ -103,6 +108,26 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   ezUInt64 uiStreamSize = 0;
   const ezUInt32 uiNumEntries = m_Entries.GetCount();
 
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  // the dictionary is stored in front of all entries, it must stay alive until all entries are written
+  ezDynamicArray<ezUInt8> dictionaryData;
+  ezArchiveZstdDictionary dictionary;
+
+  if (m_uiZstdDictionarySize > 0)
+  {
+    EZ_SUCCEED_OR_RETURN(TrainZstdDictionary(dictionaryData));
+
+    if (!dictionaryData.IsEmpty())
+    {
+      EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(dictionaryData.GetData(), dictionaryData.GetCount()));
+
+      toc.m_uiDictionaryDataOffset = uiStreamSize;
+      toc.m_uiDictionaryDataSize = dictionaryData.GetCount();
+      uiStreamSize += dictionaryData.GetCount();
+    }
+  }
+#endif
+
   ezStopwatch sw;
 
   for (ezUInt32 i = 0; i < uiNumEntries; ++i)
@@ -122,7 +147,38 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
 
     ezArchiveEntry& tocEntry = toc.m_Entries.ExpandAndGetRef();
 
-    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this)));
+    if (m_uiDataAlignment > 1)
+    {
+      // entry offsets are relative to the end of the header, but the alignment should be relative to the start of the (memory-mapped) file
+      const ezUInt64 uiFileOffset = ezArchiveUtils::HeaderSize + uiStreamSize;
+      const ezUInt64 uiPadding = ezMemoryUtils::AlignSize<ezUInt64>(uiFileOffset, m_uiDataAlignment) - uiFileOffset;
+
+      const ezUInt8 zeros[256] = {};
+      for (ezUInt64 uiWritten = 0; uiWritten < uiPadding;)
+      {
+        const ezUInt64 uiChunk = ezMath::Min<ezUInt64>(uiPadding - uiWritten, EZ_ARRAY_SIZE(zeros));
+        EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(zeros, uiChunk));
+        uiWritten += uiChunk;
+      }
+
+      uiStreamSize += uiPadding;
+    }
+
+    const ezArchiveZstdDictionary* pDictionary = nullptr;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    if (!dictionaryData.IsEmpty() && IsZstdDictionaryCandidate(e))
+    {
+      if (!dictionary.IsValid() || dictionary.GetCompressionLevel() != e.m_iCompressionLevel)
+      {
+        EZ_SUCCEED_OR_RETURN(dictionary.InitializeForWriting(dictionaryData, e.m_iCompressionLevel));
+      }
+
+      pDictionary = &dictionary;
+    }
+#endif
+
+    EZ_SUCCEED_OR_RETURN(ezArchiveUtils::WriteEntryOptimal(inout_stream, e.m_sAbsSourcePath, uiPathStringOffset, e.m_CompressionMode, e.m_iCompressionLevel, tocEntry, uiStreamSize, ezMakeDelegate(&ezArchiveBuilder::WriteFileProgressCallback, this), pDictionary));
 
     WriteFileResultCallback(i + 1, uiNumEntries, e.m_sAbsSourcePath, tocEntry.m_uiUncompressedDataSize, tocEntry.m_uiStoredDataSize, sw.Checkpoint());
   }
@@ -132,6 +188,71 @@ ezResult ezArchiveBuilder::WriteArchive(ezStreamWriter& inout_stream) const
   return EZ_SUCCESS;
 }
 
+bool ezArchiveBuilder::IsZstdDictionaryCandidate(const SourceEntry& entry) const
+{
+  if (entry.m_CompressionMode != ezArchiveCompressionMode::Compressed_zstd_seekable)
+    return false;
+
+  ezFileStats stats;
+  if (ezOSFile::GetFileStats(entry.m_sAbsSourcePath, stats).Failed())
+    return false;
+
+  return stats.m_uiFileSize > 0 && stats.m_uiFileSize <= m_uiZstdDictionaryMaxFileSize;
+}
+
+ezResult ezArchiveBuilder::TrainZstdDictionary(ezDynamicArray<ezUInt8>& out_dictionary) const
+{
+  out_dictionary.Clear();
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  EZ_LOG_BLOCK("TrainZstdDictionary");
+
+  // around 100 times the dictionary size is a good amount of training data, more only makes the training slower
+  const ezUInt64 uiMaxSampleBytes = static_cast<ezUInt64>(m_uiZstdDictionarySize) * 100;
+
+  ezDynamicArray<ezDynamicArray<ezUInt8>> sampleData;
+  ezUInt64 uiSampleBytes = 0;
+
+  for (const SourceEntry& e : m_Entries)
+  {
+    if (uiSampleBytes >= uiMaxSampleBytes)
+      break;
+
+    if (!IsZstdDictionaryCandidate(e))
+      continue;
+
+    ezOSFile file;
+    if (file.Open(e.m_sAbsSourcePath, ezFileOpenMode::Read).Failed())
+    {
+      ezLog::Error("Could not open '{}' for reading.", e.m_sAbsSourcePath);
+      return EZ_FAILURE;
+    }
+
+    uiSampleBytes += file.ReadAll(sampleData.ExpandAndGetRef());
+  }
+
+  // with very few samples there is nothing to share
+  if (sampleData.GetCount() < 8)
+  {
+    ezLog::Info("Not enough small files to train a zstd dictionary.");
+    return EZ_SUCCESS;
+  }
+
+  ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+  samples.Reserve(sampleData.GetCount());
+  for (const auto& data : sampleData)
+  {
+    samples.PushBack(data.GetArrayPtr());
+  }
+
+  ezArchiveZstdDictionary::Train(samples, m_uiZstdDictionarySize, out_dictionary);
+
+  ezLog::Info("Trained a zstd dictionary of {} from {} files ({}).", ezArgFileSize(out_dictionary.GetCount()), samples.GetCount(), ezArgFileSize(uiSampleBytes));
+#endif
+
+  return EZ_SUCCESS;
+}
+
 bool ezArchiveBuilder::WriteNextFileCallback(ezUInt32 uiCurEntry, ezUInt32 uiMaxEntries, ezStringView sSourceFile) const
 {
   return true;
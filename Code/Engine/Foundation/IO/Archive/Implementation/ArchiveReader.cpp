@@ -16,6 +16,10 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
 #if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
   EZ_LOG_BLOCK("OpenArchive", sPath);
 
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  m_ZstdDictionary.Clear();
+#  endif
+
   EZ_SUCCEED_OR_RETURN(m_MemFile.Open(sPath, ezMemoryMappedFile::Mode::ReadOnly));
   m_uiMemFileSize = m_MemFile.GetFileSize();
 
@@ -29,7 +33,7 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
     {
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ReadHeader(reader, m_uiArchiveVersion));
 
-      m_pDataStart = m_MemFile.GetReadPointer(16, ezMemoryMappedFile::OffsetBase::Start);
+      m_pDataStart = m_MemFile.GetReadPointer(ezArchiveUtils::HeaderSize, ezMemoryMappedFile::OffsetBase::Start);
 
       EZ_SUCCEED_OR_RETURN(ezArchiveUtils::ExtractTOC(m_MemFile, m_ArchiveTOC, m_uiArchiveVersion));
     }
@@ -60,12 +64,37 @@ ezResult ezArchiveReader::OpenArchive(ezStringView sPath)
         return EZ_FAILURE;
       }
 
+      // the frames of seekable entries are addressed through 32 bit array pointers, the writer never creates larger ones
+      if (e.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable && e.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Error("Archive is corrupt. Seekable zstd entry exceeds 4 GB.");
+        return EZ_FAILURE;
+      }
+
       if (e.m_uiPathStringOffset >= uiMaxPathString)
       {
         ezLog::Error("Archive is corrupt. Invalid entry path-string offset.");
         return EZ_FAILURE;
       }
     }
+
+    if (m_ArchiveTOC.m_uiDictionaryDataSize > 0)
+    {
+      if (m_ArchiveTOC.m_uiDictionaryDataOffset + m_ArchiveTOC.m_uiDictionaryDataSize > uiValidSize || m_ArchiveTOC.m_uiDictionaryDataSize > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Error("Archive is corrupt. Invalid dictionary data range.");
+        return EZ_FAILURE;
+      }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      const ezUInt8* pDictionary = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(m_ArchiveTOC.m_uiDictionaryDataOffset)));
+      if (m_ZstdDictionary.InitializeForReading(ezArrayPtr<const ezUInt8>(pDictionary, static_cast<ezUInt32>(m_ArchiveTOC.m_uiDictionaryDataSize))).Failed())
+      {
+        ezLog::Error("Archive is corrupt. Invalid zstd dictionary.");
+        return EZ_FAILURE;
+      }
+#  endif
+    }
   }
 
   return EZ_SUCCESS;
@@ -104,9 +133,62 @@ void ezArchiveReader::ConfigureRawMemoryStreamReader(ezUInt32 uiEntryIdx, ezRawM
   ezArchiveUtils::ConfigureRawMemoryStreamReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, ref_memReader);
 }
 
+ezArrayPtr<const ezUInt8> ezArchiveReader::GetEntryStoredData(ezUInt32 uiEntryIdx) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+    return {};
+
+  const ezUInt8* pData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)));
+  return ezArrayPtr<const ezUInt8>(pData, static_cast<ezUInt32>(entry.m_uiStoredDataSize));
+}
+
 ezUniquePtr<ezStreamReader> ezArchiveReader::CreateEntryReader(ezUInt32 uiEntryIdx) const
 {
-  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart);
+  return ezArchiveUtils::CreateEntryReader(m_ArchiveTOC.m_Entries[uiEntryIdx], m_pDataStart, GetZstdDictionary());
+}
+
+ezUInt64 ezArchiveReader::ReadEntryRange(ezUInt32 uiEntryIdx, ezUInt64 uiOffset, ezArrayPtr<ezUInt8> out_data) const
+{
+  const ezArchiveEntry& entry = m_ArchiveTOC.m_Entries[uiEntryIdx];
+
+  if (uiOffset >= entry.m_uiUncompressedDataSize)
+    return 0;
+
+  const ezUInt64 uiBytesToRead = ezMath::Min<ezUInt64>(out_data.GetCount(), entry.m_uiUncompressedDataSize - uiOffset);
+
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+  {
+    ezMemoryUtils::Copy(out_data.GetPtr(), static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(m_pDataStart, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset + uiOffset))), static_cast<size_t>(uiBytesToRead));
+    return uiBytesToRead;
+  }
+
+  ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
+  if (pReader == nullptr)
+    return 0;
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (entry.m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable)
+  {
+    return static_cast<ezArchiveSeekableZstdReader*>(pReader.Borrow())->ReadAt(uiOffset, out_data.GetPtr(), uiBytesToRead);
+  }
+#endif
+
+  if (pReader->SkipBytes(uiOffset) != uiOffset)
+    return 0;
+
+  return pReader->ReadBytes(out_data.GetPtr(), uiBytesToRead);
+}
+
+const ezArchiveZstdDictionary* ezArchiveReader::GetZstdDictionary() const
+{
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+  if (m_ZstdDictionary.IsValid())
+    return &m_ZstdDictionary;
+#endif
+
+  return nullptr;
 }
 
 ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetFolder) const
@@ -115,6 +197,8 @@ ezResult ezArchiveReader::ExtractFile(ezUInt32 uiEntryIdx, ezStringView sTargetF
   const ezUInt64 uiMaxSize = m_ArchiveTOC.m_Entries[uiEntryIdx].m_uiUncompressedDataSize;
 
   ezUniquePtr<ezStreamReader> pReader = CreateEntryReader(uiEntryIdx);
+  if (pReader == nullptr)
+    return EZ_FAILURE;
 
   ezStringBuilder sOutputFile = sTargetFolder;
   sOutputFile.AppendPath(sFilePath);
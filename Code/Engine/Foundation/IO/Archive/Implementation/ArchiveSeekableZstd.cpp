@@ -0,0 +1,638 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveSeekableZstd.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+#  include <Foundation/Containers/HashTable.h>
+#  include <Foundation/IO/MemoryStream.h>
+#  include <Foundation/Logging/Log.h>
+#  include <Foundation/Threading/TaskSystem.h>
+#  include <zstd/zstd.h>
+
+namespace
+{
+  // seek table format, stored after the last frame:
+  //   ezUInt32 compressed size of each frame
+  //   ezUInt64 uncompressed size
+  //   ezUInt32 uncompressed frame size (all frames but the last have exactly this size)
+  //   ezUInt32 number of frames
+  //   ezUInt8  flags
+  //   ezUInt8  version
+  //   ezUInt16 reserved
+  constexpr ezUInt32 s_uiSeekTableFooterSize = 20;
+  constexpr ezUInt8 s_uiSeekTableVersion = 1;
+  constexpr ezUInt8 s_uiFlagUsesDictionary = EZ_BIT(0);
+
+  // how many frames are collected before they are compressed in parallel
+  constexpr ezUInt32 s_uiFramesPerBatch = 16;
+
+  struct SeekTableFooter
+  {
+    ezUInt64 m_uiUncompressedSize = 0;
+    ezUInt32 m_uiFrameSize = 0;
+    ezUInt32 m_uiNumFrames = 0;
+    ezUInt8 m_uiFlags = 0;
+    ezUInt8 m_uiVersion = 0;
+  };
+
+  ezResult ReadSeekTableFooter(ezArrayPtr<const ezUInt8> storedData, SeekTableFooter& out_footer)
+  {
+    if (storedData.GetCount() < s_uiSeekTableFooterSize)
+      return EZ_FAILURE;
+
+    ezRawMemoryStreamReader reader(storedData.GetEndPtr() - s_uiSeekTableFooterSize, s_uiSeekTableFooterSize);
+
+    ezUInt16 uiReserved = 0;
+    reader >> out_footer.m_uiUncompressedSize;
+    reader >> out_footer.m_uiFrameSize;
+    reader >> out_footer.m_uiNumFrames;
+    reader >> out_footer.m_uiFlags;
+    reader >> out_footer.m_uiVersion;
+    reader >> uiReserved;
+
+    if (out_footer.m_uiVersion != s_uiSeekTableVersion)
+      return EZ_FAILURE;
+
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezArchiveZstdDictionary::ezArchiveZstdDictionary() = default;
+
+ezArchiveZstdDictionary::~ezArchiveZstdDictionary()
+{
+  Clear();
+}
+
+void ezArchiveZstdDictionary::Train(ezArrayPtr<const ezArrayPtr<const ezUInt8>> samples, ezUInt32 uiMaxSize, ezDynamicArray<ezUInt8>& out_dictionary)
+{
+  // A simplified version of the 'cover' algorithm that zstd's dictionary builder uses:
+  // Every short byte sequence (d-mer) is rated by how many samples contain it. The sample data is split into epochs
+  // and from each epoch the segment with the highest rated d-mers is added to the dictionary. Afterwards the rating of those
+  // d-mers is reset, so that the next segments add different content.
+  constexpr ezUInt32 uiDmerSize = 8;
+  constexpr ezUInt32 uiSegmentSize = 256;
+
+  out_dictionary.Clear();
+
+  ezDynamicArray<ezUInt8> allData;
+  ezDynamicArray<ezUInt32> dmerHashes; // the hash of the d-mer that starts at each position, 0 for d-mers that cross sample borders
+  ezHashTable<ezUInt32, ezUInt32> dmerRating;
+
+  {
+    ezHashTable<ezUInt32, ezUInt32> lastSample;
+
+    for (ezUInt32 uiSample = 0; uiSample < samples.GetCount(); ++uiSample)
+    {
+      const ezArrayPtr<const ezUInt8> sample = samples[uiSample];
+      allData.PushBackRange(sample);
+
+      for (ezUInt32 uiPos = 0; uiPos < sample.GetCount(); ++uiPos)
+      {
+        if (uiPos + uiDmerSize > sample.GetCount())
+        {
+          dmerHashes.PushBack(0);
+          continue;
+        }
+
+        const ezUInt32 uiHash = ezMath::Max(1u, ezHashingUtils::xxHash32(sample.GetPtr() + uiPos, uiDmerSize));
+        dmerHashes.PushBack(uiHash);
+
+        bool bExisted = false;
+        ezUInt32& uiLastSample = lastSample.FindOrAdd(uiHash, &bExisted);
+
+        if (!bExisted || uiLastSample != uiSample)
+        {
+          uiLastSample = uiSample;
+          ++dmerRating[uiHash];
+        }
+      }
+    }
+  }
+
+  const ezUInt32 uiDataSize = allData.GetCount();
+  if (uiDataSize < uiSegmentSize || uiMaxSize < uiSegmentSize)
+    return;
+
+  auto GetRating = [&](ezUInt32 uiPos) -> ezUInt32 {
+    const ezUInt32 uiHash = dmerHashes[uiPos];
+    if (uiHash == 0)
+      return 0;
+
+    const ezUInt32 uiRating = *dmerRating.GetValue(uiHash);
+
+    // d-mers that occur in only one sample don't help other samples
+    return uiRating >= 2 ? uiRating : 0;
+  };
+
+  const ezUInt32 uiNumSegments = uiMaxSize / uiSegmentSize;
+  const ezUInt32 uiNumEpochs = ezMath::Clamp(uiDataSize / (uiSegmentSize * 4), 1u, uiNumSegments);
+  const ezUInt32 uiEpochSize = uiDataSize / uiNumEpochs;
+
+  ezDynamicArray<ezUInt32> selected;
+
+  for (ezUInt32 uiPass = 0; uiPass < 4 && selected.GetCount() < uiNumSegments; ++uiPass)
+  {
+    bool bFoundAny = false;
+
+    for (ezUInt32 uiEpoch = 0; uiEpoch < uiNumEpochs && selected.GetCount() < uiNumSegments; ++uiEpoch)
+    {
+      const ezUInt32 uiEpochStart = uiEpoch * uiEpochSize;
+      const ezUInt32 uiEpochEnd = ezMath::Min(uiDataSize, uiEpochStart + uiEpochSize);
+
+      if (uiEpochEnd - uiEpochStart < uiSegmentSize)
+        continue;
+
+      // sliding window over all segments in the epoch
+      ezUInt64 uiScore = 0;
+      for (ezUInt32 i = 0; i < uiSegmentSize; ++i)
+      {
+        uiScore += GetRating(uiEpochStart + i);
+      }
+
+      ezUInt64 uiBestScore = uiScore;
+      ezUInt32 uiBestPos = uiEpochStart;
+
+      for (ezUInt32 uiPos = uiEpochStart + 1; uiPos + uiSegmentSize <= uiEpochEnd; ++uiPos)
+      {
+        uiScore = uiScore - GetRating(uiPos - 1) + GetRating(uiPos + uiSegmentSize - 1);
+
+        if (uiScore > uiBestScore)
+        {
+          uiBestScore = uiScore;
+          uiBestPos = uiPos;
+        }
+      }
+
+      if (uiBestScore == 0)
+        continue;
+
+      selected.PushBack(uiBestPos);
+      bFoundAny = true;
+
+      // the content is in the dictionary now, other segments should add something else
+      for (ezUInt32 i = 0; i < uiSegmentSize; ++i)
+      {
+        if (const ezUInt32 uiHash = dmerHashes[uiBestPos + i])
+        {
+          *dmerRating.GetValue(uiHash) = 0;
+        }
+      }
+    }
+
+    if (!bFoundAny)
+      break;
+  }
+
+  // zstd prefers matches close to the data, ie. at the end of the dictionary, so the segments that were picked first go last
+  out_dictionary.Reserve(selected.GetCount() * uiSegmentSize);
+  for (ezUInt32 i = selected.GetCount(); i > 0; --i)
+  {
+    out_dictionary.PushBackRange(allData.GetArrayPtr().GetSubArray(selected[i - 1], uiSegmentSize));
+  }
+}
+
+ezResult ezArchiveZstdDictionary::InitializeForReading(ezArrayPtr<const ezUInt8> dictionary)
+{
+  Clear();
+
+  if (dictionary.IsEmpty())
+    return EZ_FAILURE;
+
+  m_pDDict = ZSTD_createDDict(dictionary.GetPtr(), dictionary.GetCount());
+  if (m_pDDict == nullptr)
+    return EZ_FAILURE;
+
+  m_Data = dictionary;
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveZstdDictionary::InitializeForWriting(ezArrayPtr<const ezUInt8> dictionary, ezInt32 iCompressionLevel)
+{
+  EZ_SUCCEED_OR_RETURN(InitializeForReading(dictionary));
+
+  m_pCDict = ZSTD_createCDict(dictionary.GetPtr(), dictionary.GetCount(), iCompressionLevel);
+  if (m_pCDict == nullptr)
+  {
+    Clear();
+    return EZ_FAILURE;
+  }
+
+  m_iCompressionLevel = iCompressionLevel;
+  return EZ_SUCCESS;
+}
+
+void ezArchiveZstdDictionary::Clear()
+{
+  if (m_pCDict != nullptr)
+  {
+    ZSTD_freeCDict(reinterpret_cast<ZSTD_CDict*>(m_pCDict));
+    m_pCDict = nullptr;
+  }
+
+  if (m_pDDict != nullptr)
+  {
+    ZSTD_freeDDict(reinterpret_cast<ZSTD_DDict*>(m_pDDict));
+    m_pDDict = nullptr;
+  }
+
+  m_Data.Clear();
+  m_iCompressionLevel = 0;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezArchiveSeekableZstdWriter::ezArchiveSeekableZstdWriter() = default;
+
+ezArchiveSeekableZstdWriter::~ezArchiveSeekableZstdWriter()
+{
+  for (void* pContext : m_CompressionContexts)
+  {
+    ZSTD_freeCCtx(reinterpret_cast<ZSTD_CCtx*>(pContext));
+  }
+}
+
+void ezArchiveSeekableZstdWriter::SetOutputStream(ezStreamWriter* pOutputStream, ezInt32 iCompressionLevel, const ezArchiveZstdDictionary* pDictionary /*= nullptr*/, ezUInt32 uiFrameSize /*= DefaultFrameSize*/)
+{
+  EZ_ASSERT_DEV(pDictionary == nullptr || pDictionary->m_pCDict != nullptr, "The dictionary has not been initialized for writing.");
+  EZ_ASSERT_DEV(uiFrameSize > 0, "Invalid frame size");
+
+  m_pOutputStream = pOutputStream;
+  m_pDictionary = pDictionary;
+  m_iCompressionLevel = (pDictionary != nullptr) ? pDictionary->GetCompressionLevel() : iCompressionLevel;
+  m_uiFrameSize = uiFrameSize;
+  m_uiUncompressedSize = 0;
+  m_uiWrittenBytes = 0;
+
+  m_PendingData.Clear();
+  m_FrameSizes.Clear();
+}
+
+ezResult ezArchiveSeekableZstdWriter::WriteBytes(const void* pWriteBuffer, ezUInt64 uiBytesToWrite)
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "No output stream has been set.");
+
+  const ezUInt64 uiBatchSize = static_cast<ezUInt64>(m_uiFrameSize) * s_uiFramesPerBatch;
+  const ezUInt8* pData = static_cast<const ezUInt8*>(pWriteBuffer);
+
+  while (uiBytesToWrite > 0)
+  {
+    const ezUInt32 uiTake = static_cast<ezUInt32>(ezMath::Min<ezUInt64>(uiBytesToWrite, uiBatchSize - m_PendingData.GetCount()));
+
+    m_PendingData.PushBackRange(ezArrayPtr<const ezUInt8>(pData, uiTake));
+    m_uiUncompressedSize += uiTake;
+    pData += uiTake;
+    uiBytesToWrite -= uiTake;
+
+    if (m_PendingData.GetCount() == uiBatchSize)
+    {
+      EZ_SUCCEED_OR_RETURN(CompressPendingFrames());
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveSeekableZstdWriter::FinishCompressedStream()
+{
+  EZ_ASSERT_DEV(m_pOutputStream != nullptr, "No output stream has been set.");
+
+  EZ_SUCCEED_OR_RETURN(CompressPendingFrames());
+
+  ezStreamWriter& stream = *m_pOutputStream;
+
+  for (ezUInt32 uiSize : m_FrameSizes)
+  {
+    stream << uiSize;
+  }
+
+  const ezUInt8 uiFlags = (m_pDictionary != nullptr) ? s_uiFlagUsesDictionary : 0;
+  const ezUInt16 uiReserved = 0;
+
+  stream << m_uiUncompressedSize;
+  stream << m_uiFrameSize;
+  stream << m_FrameSizes.GetCount();
+  stream << uiFlags;
+  stream << s_uiSeekTableVersion;
+  stream << uiReserved;
+
+  m_uiWrittenBytes += m_FrameSizes.GetCount() * sizeof(ezUInt32) + s_uiSeekTableFooterSize;
+  m_pOutputStream = nullptr;
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveSeekableZstdWriter::CompressPendingFrames()
+{
+  if (m_PendingData.IsEmpty())
+    return EZ_SUCCESS;
+
+  const ezUInt32 uiNumFrames = (m_PendingData.GetCount() + m_uiFrameSize - 1) / m_uiFrameSize;
+
+  m_CompressedFrames.SetCount(ezMath::Max(m_CompressedFrames.GetCount(), uiNumFrames));
+
+  while (m_CompressionContexts.GetCount() < uiNumFrames)
+  {
+    m_CompressionContexts.PushBack(ZSTD_createCCtx());
+  }
+
+  ezAtomicInteger32 iNumFailures;
+
+  ezTaskSystem::ParallelForIndexed(
+    0u, uiNumFrames, [this, &iNumFailures](ezUInt32 uiStartFrame, ezUInt32 uiEndFrame)
+    {
+      for (ezUInt32 uiFrame = uiStartFrame; uiFrame < uiEndFrame; ++uiFrame)
+      {
+        const ezUInt32 uiOffset = uiFrame * m_uiFrameSize;
+        const ezUInt32 uiSize = ezMath::Min(m_uiFrameSize, m_PendingData.GetCount() - uiOffset);
+
+        ezDynamicArray<ezUInt8>& compressed = m_CompressedFrames[uiFrame];
+        compressed.SetCountUninitialized(static_cast<ezUInt32>(ZSTD_compressBound(uiSize)));
+
+        ZSTD_CCtx* pContext = reinterpret_cast<ZSTD_CCtx*>(m_CompressionContexts[uiFrame]);
+
+        size_t uiResult = 0;
+        if (m_pDictionary != nullptr)
+          uiResult = ZSTD_compress_usingCDict(pContext, compressed.GetData(), compressed.GetCount(), m_PendingData.GetData() + uiOffset, uiSize, reinterpret_cast<const ZSTD_CDict*>(m_pDictionary->m_pCDict));
+        else
+          uiResult = ZSTD_compressCCtx(pContext, compressed.GetData(), compressed.GetCount(), m_PendingData.GetData() + uiOffset, uiSize, m_iCompressionLevel);
+
+        if (ZSTD_isError(uiResult))
+        {
+          iNumFailures.Increment();
+          compressed.Clear();
+        }
+        else
+        {
+          compressed.SetCountUninitialized(static_cast<ezUInt32>(uiResult));
+        }
+      }
+    },
+    "SeekableZstdCompress");
+
+  if (iNumFailures > 0)
+  {
+    ezLog::Error("zstd compression failed for {} frames.", iNumFailures);
+    return EZ_FAILURE;
+  }
+
+  for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+  {
+    const ezDynamicArray<ezUInt8>& compressed = m_CompressedFrames[uiFrame];
+
+    EZ_SUCCEED_OR_RETURN(m_pOutputStream->WriteBytes(compressed.GetData(), compressed.GetCount()));
+
+    m_FrameSizes.PushBack(compressed.GetCount());
+    m_uiWrittenBytes += compressed.GetCount();
+  }
+
+  m_PendingData.Clear();
+  return EZ_SUCCESS;
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezArchiveSeekableZstdReader::ezArchiveSeekableZstdReader() = default;
+
+ezArchiveSeekableZstdReader::~ezArchiveSeekableZstdReader()
+{
+  if (m_pDContext != nullptr)
+  {
+    ZSTD_freeDCtx(reinterpret_cast<ZSTD_DCtx*>(m_pDContext));
+    m_pDContext = nullptr;
+  }
+}
+
+bool ezArchiveSeekableZstdReader::RequiresDictionary(ezArrayPtr<const ezUInt8> storedData)
+{
+  SeekTableFooter footer;
+  if (ReadSeekTableFooter(storedData, footer).Failed())
+    return false;
+
+  return (footer.m_uiFlags & s_uiFlagUsesDictionary) != 0;
+}
+
+ezResult ezArchiveSeekableZstdReader::SetInputData(ezArrayPtr<const ezUInt8> storedData, const ezArchiveZstdDictionary* pDictionary /*= nullptr*/)
+{
+  m_StoredData.Clear();
+  m_pDictionary = nullptr;
+  m_uiUncompressedSize = 0;
+  m_uiReadPosition = 0;
+  m_uiFrameSize = 0;
+  m_uiCachedFrame = ezInvalidIndex;
+  m_FrameOffsets.Clear();
+
+  SeekTableFooter footer;
+  if (ReadSeekTableFooter(storedData, footer).Failed())
+  {
+    ezLog::Error("Invalid seekable zstd data. Seek table not found.");
+    return EZ_FAILURE;
+  }
+
+  const ezUInt64 uiSeekTableSize = static_cast<ezUInt64>(footer.m_uiNumFrames) * sizeof(ezUInt32) + s_uiSeekTableFooterSize;
+  const ezUInt64 uiExpectedFrames = (footer.m_uiFrameSize == 0) ? 0 : (footer.m_uiUncompressedSize + footer.m_uiFrameSize - 1) / footer.m_uiFrameSize;
+
+  if (uiSeekTableSize > storedData.GetCount() || uiExpectedFrames != footer.m_uiNumFrames || (footer.m_uiFrameSize == 0 && footer.m_uiUncompressedSize > 0))
+  {
+    ezLog::Error("Invalid seekable zstd data. Corrupted seek table.");
+    return EZ_FAILURE;
+  }
+
+  if ((footer.m_uiFlags & s_uiFlagUsesDictionary) != 0)
+  {
+    if (pDictionary == nullptr || !pDictionary->IsValid())
+    {
+      ezLog::Error("Seekable zstd data was compressed with a dictionary, but no dictionary is available.");
+      return EZ_FAILURE;
+    }
+
+    m_pDictionary = pDictionary;
+  }
+
+  const ezUInt64 uiFramesDataSize = storedData.GetCount() - uiSeekTableSize;
+
+  ezRawMemoryStreamReader tableReader(storedData.GetPtr() + uiFramesDataSize, uiSeekTableSize);
+
+  m_FrameOffsets.SetCountUninitialized(footer.m_uiNumFrames + 1);
+  m_FrameOffsets[0] = 0;
+
+  for (ezUInt32 uiFrame = 0; uiFrame < footer.m_uiNumFrames; ++uiFrame)
+  {
+    ezUInt32 uiCompressedSize = 0;
+    tableReader >> uiCompressedSize;
+
+    m_FrameOffsets[uiFrame + 1] = m_FrameOffsets[uiFrame] + uiCompressedSize;
+  }
+
+  if (m_FrameOffsets.PeekBack() != uiFramesDataSize)
+  {
+    ezLog::Error("Invalid seekable zstd data. Frame sizes do not match the data size.");
+    m_FrameOffsets.Clear();
+    m_pDictionary = nullptr;
+    return EZ_FAILURE;
+  }
+
+  m_StoredData = storedData;
+  m_uiUncompressedSize = footer.m_uiUncompressedSize;
+  m_uiFrameSize = footer.m_uiFrameSize;
+
+  if (m_pDContext == nullptr)
+  {
+    m_pDContext = ZSTD_createDCtx();
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezUInt64 ezArchiveSeekableZstdReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  const ezUInt64 uiRead = ReadAt(m_uiReadPosition, pReadBuffer, uiBytesToRead);
+  m_uiReadPosition += uiRead;
+  return uiRead;
+}
+
+ezUInt64 ezArchiveSeekableZstdReader::SkipBytes(ezUInt64 uiBytesToSkip)
+{
+  const ezUInt64 uiSkip = ezMath::Min(uiBytesToSkip, m_uiUncompressedSize - m_uiReadPosition);
+  m_uiReadPosition += uiSkip;
+  return uiSkip;
+}
+
+ezUInt64 ezArchiveSeekableZstdReader::ReadAt(ezUInt64 uiOffset, void* pReadBuffer, ezUInt64 uiBytesToRead)
+{
+  if (uiOffset >= m_uiUncompressedSize)
+    return 0;
+
+  uiBytesToRead = ezMath::Min(uiBytesToRead, m_uiUncompressedSize - uiOffset);
+
+  if (pReadBuffer == nullptr || uiBytesToRead == 0)
+    return uiBytesToRead;
+
+  ezUInt8* pTarget = static_cast<ezUInt8*>(pReadBuffer);
+  const ezUInt64 uiEnd = uiOffset + uiBytesToRead;
+  ezUInt64 uiPos = uiOffset;
+
+  // the first frame is only partially needed -> go through the cache
+  ezUInt32 uiFrame = static_cast<ezUInt32>(uiPos / m_uiFrameSize);
+  {
+    const ezUInt64 uiFrameStart = static_cast<ezUInt64>(uiFrame) * m_uiFrameSize;
+    const ezUInt64 uiFrameEnd = uiFrameStart + GetFrameSize(uiFrame);
+
+    if (uiPos != uiFrameStart || uiEnd < uiFrameEnd)
+    {
+      if (DecompressFrameToCache(uiFrame).Failed())
+        return 0;
+
+      const ezUInt64 uiCopy = ezMath::Min(uiEnd, uiFrameEnd) - uiPos;
+      ezMemoryUtils::Copy(pTarget, m_FrameCache.GetData() + (uiPos - uiFrameStart), static_cast<size_t>(uiCopy));
+
+      uiPos += uiCopy;
+      ++uiFrame;
+    }
+  }
+
+  // all fully covered frames are decompressed directly into the target buffer
+  if (uiPos < uiEnd)
+  {
+    const ezUInt32 uiFullFramesEnd = (uiEnd == m_uiUncompressedSize) ? GetNumFrames() : static_cast<ezUInt32>(uiEnd / m_uiFrameSize);
+
+    if (uiFullFramesEnd > uiFrame)
+    {
+      ezUInt8* pFramesTarget = pTarget + (uiPos - uiOffset);
+      const ezUInt32 uiFirstFrame = uiFrame;
+
+      if (uiFullFramesEnd - uiFrame == 1)
+      {
+        if (DecompressFrame(m_pDContext, uiFrame, pFramesTarget).Failed())
+          return uiPos - uiOffset;
+      }
+      else
+      {
+        ezAtomicInteger32 iNumFailures;
+
+        ezTaskSystem::ParallelForIndexed(
+          0u, uiFullFramesEnd - uiFirstFrame, [this, pFramesTarget, uiFirstFrame, &iNumFailures](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+          {
+            ZSTD_DCtx* pContext = ZSTD_createDCtx();
+
+            for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+            {
+              if (DecompressFrame(pContext, uiFirstFrame + i, pFramesTarget + static_cast<ezUInt64>(i) * m_uiFrameSize).Failed())
+              {
+                iNumFailures.Increment();
+              }
+            }
+
+            ZSTD_freeDCtx(pContext);
+          },
+          "SeekableZstdDecompress");
+
+        if (iNumFailures > 0)
+          return uiPos - uiOffset;
+      }
+
+      uiPos = ezMath::Min(uiEnd, static_cast<ezUInt64>(uiFullFramesEnd) * m_uiFrameSize);
+      uiFrame = uiFullFramesEnd;
+    }
+  }
+
+  // the last frame is only partially needed
+  if (uiPos < uiEnd)
+  {
+    if (DecompressFrameToCache(uiFrame).Failed())
+      return uiPos - uiOffset;
+
+    ezMemoryUtils::Copy(pTarget + (uiPos - uiOffset), m_FrameCache.GetData(), static_cast<size_t>(uiEnd - uiPos));
+    uiPos = uiEnd;
+  }
+
+  return uiPos - uiOffset;
+}
+
+ezUInt64 ezArchiveSeekableZstdReader::GetFrameSize(ezUInt32 uiFrame) const
+{
+  return ezMath::Min<ezUInt64>(m_uiFrameSize, m_uiUncompressedSize - static_cast<ezUInt64>(uiFrame) * m_uiFrameSize);
+}
+
+ezResult ezArchiveSeekableZstdReader::DecompressFrame(void* pDContext, ezUInt32 uiFrame, void* pTarget) const
+{
+  const ezUInt8* pSource = m_StoredData.GetPtr() + m_FrameOffsets[uiFrame];
+  const size_t uiSourceSize = static_cast<size_t>(m_FrameOffsets[uiFrame + 1] - m_FrameOffsets[uiFrame]);
+  const size_t uiFrameSize = static_cast<size_t>(GetFrameSize(uiFrame));
+
+  size_t uiResult = 0;
+  if (m_pDictionary != nullptr)
+    uiResult = ZSTD_decompress_usingDDict(reinterpret_cast<ZSTD_DCtx*>(pDContext), pTarget, uiFrameSize, pSource, uiSourceSize, reinterpret_cast<const ZSTD_DDict*>(m_pDictionary->m_pDDict));
+  else
+    uiResult = ZSTD_decompressDCtx(reinterpret_cast<ZSTD_DCtx*>(pDContext), pTarget, uiFrameSize, pSource, uiSourceSize);
+
+  if (ZSTD_isError(uiResult) || uiResult != uiFrameSize)
+  {
+    ezLog::Error("Failed to decompress seekable zstd frame {}.", uiFrame);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezArchiveSeekableZstdReader::DecompressFrameToCache(ezUInt32 uiFrame)
+{
+  if (m_uiCachedFrame == uiFrame)
+    return EZ_SUCCESS;
+
+  m_uiCachedFrame = ezInvalidIndex;
+  m_FrameCache.SetCountUninitialized(m_uiFrameSize);
+
+  EZ_SUCCEED_OR_RETURN(DecompressFrame(m_pDContext, uiFrame, m_FrameCache.GetData()));
+
+  m_uiCachedFrame = uiFrame;
+  return EZ_SUCCESS;
+}
+
+#endif
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Archive_Implementation_ArchiveSeekableZstd);
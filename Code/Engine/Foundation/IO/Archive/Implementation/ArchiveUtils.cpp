@@ -3,6 +3,7 @@
 #include <Foundation/IO/Archive/ArchiveUtils.h>
 
 #include <Foundation/Algorithm/HashStream.h>
+#include <Foundation/IO/Archive/ArchiveSeekableZstd.h>
 #include <Foundation/IO/CompressedStreamZstd.h>
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/MemoryMappedFile.h>
@@ -37,11 +38,12 @@ ezResult ezArchiveUtils::WriteHeader(ezStreamWriter& inout_stream)
   const char* szTag = "EZARCHIVE";
   EZ_SUCCEED_OR_RETURN(inout_stream.WriteBytes(szTag, 10));
 
-  const ezUInt8 uiArchiveVersion = 4;
+  const ezUInt8 uiArchiveVersion = 5;
 
   // Version 2: Added end-of-file marker for file corruption (cutoff) detection
   // Version 3: HashedStrings changed from MurmurHash to xxHash
   // Version 4: use 64 Bit string hashes
+  // Version 5: seekable zstd entries and an optional zstd dictionary
   inout_stream << uiArchiveVersion;
 
   const ezUInt8 uiPadding[5] = {0, 0, 0, 0, 0};
@@ -62,7 +64,7 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& inout_stream, ezUInt8& out_u
   out_uiVersion = 0;
   inout_stream >> out_uiVersion;
 
-  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4)
+  if (out_uiVersion != 1 && out_uiVersion != 2 && out_uiVersion != 3 && out_uiVersion != 4 && out_uiVersion != 5)
   {
     ezLog::Error("Unsupported archive version '{}'.", out_uiVersion);
     return EZ_FAILURE;
@@ -88,7 +90,8 @@ ezResult ezArchiveUtils::ReadHeader(ezStreamReader& inout_stream, ezUInt8& out_u
 
 ezResult ezArchiveUtils::WriteEntry(
   ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression,
-  ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+  ezInt32 iCompressionLevel, ezArchiveEntry& inout_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/,
+  const ezArchiveZstdDictionary* pDictionary /*= nullptr*/)
 {
   ezFileReader file;
   EZ_SUCCEED_OR_RETURN(file.Open(sAbsSourcePath, 1024 * 1024));
@@ -105,6 +108,7 @@ ezResult ezArchiveUtils::WriteEntry(
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
   ezCompressedStreamWriterZstd zstdWriter;
+  ezArchiveSeekableZstdWriter seekableWriter;
 #endif
 
   switch (compression)
@@ -120,6 +124,13 @@ ezResult ezArchiveUtils::WriteEntry(
       pWriter = &zstdWriter;
     }
     break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_seekable:
+    {
+      seekableWriter.SetOutputStream(&inout_stream, iCompressionLevel, pDictionary);
+      pWriter = &seekableWriter;
+    }
+    break;
 #endif
 
     default:
@@ -156,6 +167,17 @@ ezResult ezArchiveUtils::WriteEntry(
       EZ_SUCCEED_OR_RETURN(zstdWriter.FinishCompressedStream());
       inout_tocEntry.m_uiStoredDataSize = zstdWriter.GetWrittenBytes();
       break;
+
+    case ezArchiveCompressionMode::Compressed_zstd_seekable:
+      EZ_SUCCEED_OR_RETURN(seekableWriter.FinishCompressedStream());
+      inout_tocEntry.m_uiStoredDataSize = seekableWriter.GetWrittenBytes();
+
+      if (inout_tocEntry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Error("'{}' is too large for seekable zstd compression ({} compressed). Use regular zstd compression instead.", sAbsSourcePath, ezArgFileSize(inout_tocEntry.m_uiStoredDataSize));
+        return EZ_FAILURE;
+      }
+      break;
 #endif
 
     case ezArchiveCompressionMode::Uncompressed:
@@ -169,7 +191,7 @@ ezResult ezArchiveUtils::WriteEntry(
   return EZ_SUCCESS;
 }
 
-ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/)
+ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& inout_stream, ezStringView sAbsSourcePath, ezUInt32 uiPathStringOffset, ezArchiveCompressionMode compression, ezInt32 iCompressionLevel, ezArchiveEntry& ref_tocEntry, ezUInt64& inout_uiCurrentStreamPosition, FileWriteProgressCallback progress /*= FileWriteProgressCallback()*/, const ezArchiveZstdDictionary* pDictionary /*= nullptr*/)
 {
   if (compression == ezArchiveCompressionMode::Uncompressed)
   {
@@ -181,7 +203,7 @@ ezResult ezArchiveUtils::WriteEntryOptimal(ezStreamWriter& inout_stream, ezStrin
     ezMemoryStreamWriter writer(&storage);
 
     ezUInt64 streamPos = inout_uiCurrentStreamPosition;
-    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, sAbsSourcePath, uiPathStringOffset, compression, iCompressionLevel, ref_tocEntry, streamPos, progress));
+    EZ_SUCCEED_OR_RETURN(WriteEntry(writer, sAbsSourcePath, uiPathStringOffset, compression, iCompressionLevel, ref_tocEntry, streamPos, progress, pDictionary));
 
     if (ref_tocEntry.m_uiStoredDataSize * 12 >= ref_tocEntry.m_uiUncompressedDataSize * 10)
     {
@@ -209,7 +231,7 @@ public:
 #endif
 
 
-ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData)
+ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEntry& entry, const void* pStartOfArchiveData, const ezArchiveZstdDictionary* pDictionary /*= nullptr*/)
 {
   ezUniquePtr<ezStreamReader> reader;
 
@@ -232,6 +254,27 @@ ezUniquePtr<ezStreamReader> ezArchiveUtils::CreateEntryReader(const ezArchiveEnt
       pRawReader->SetInputStream(&pRawReader->m_Source);
       break;
     }
+
+    case ezArchiveCompressionMode::Compressed_zstd_seekable:
+    {
+      if (entry.m_uiStoredDataSize > ezMath::MaxValue<ezUInt32>())
+      {
+        ezLog::Error("Seekable zstd archive entry is too large ({} compressed).", ezArgFileSize(entry.m_uiStoredDataSize));
+        break;
+      }
+
+      const ezUInt8* pStoredData = static_cast<const ezUInt8*>(ezMemoryUtils::AddByteOffset(pStartOfArchiveData, static_cast<ptrdiff_t>(entry.m_uiDataStartOffset)));
+
+      ezUniquePtr<ezArchiveSeekableZstdReader> pSeekableReader = EZ_DEFAULT_NEW(ezArchiveSeekableZstdReader);
+      if (pSeekableReader->SetInputData(ezArrayPtr<const ezUInt8>(pStoredData, static_cast<ezUInt32>(entry.m_uiStoredDataSize)), pDictionary).Failed())
+      {
+        ezLog::Error("Seekable zstd archive entry is corrupted or requires a dictionary.");
+        break;
+      }
+
+      reader = std::move(pSeekableReader);
+      break;
+    }
 #endif
 
     default:
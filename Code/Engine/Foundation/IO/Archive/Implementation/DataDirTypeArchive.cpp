@@ -86,22 +86,51 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
         }
         break;
       }
+
+      case ezArchiveCompressionMode::Compressed_zstd_seekable:
+      {
+        ArchiveReaderZstdSeekable* pSeekableReader = nullptr;
+
+        if (!m_FreeReadersZstdSeekable.IsEmpty())
+        {
+          pSeekableReader = m_FreeReadersZstdSeekable.PeekBack();
+          m_FreeReadersZstdSeekable.PopBack();
+        }
+        else
+        {
+          m_ReadersZstdSeekable.PushBack(EZ_DEFAULT_NEW(ArchiveReaderZstdSeekable, 2));
+          pSeekableReader = m_ReadersZstdSeekable.PeekBack().Borrow();
+        }
+
+        pSeekableReader->m_StoredData = m_ArchiveReader.GetEntryStoredData(uiEntryIndex);
+        pSeekableReader->m_pDictionary = m_ArchiveReader.GetZstdDictionary();
+        pReader = pSeekableReader;
+        break;
+      }
 #endif
 
       default:
         EZ_REPORT_FAILURE("Compression mode {} is unknown (or not compiled in)", (ezUInt8)pEntry->m_CompressionMode);
         return nullptr;
     }
+
+    ++m_uiNumOpenReaders;
   }
 
   pReader->m_uiUncompressedSize = pEntry->m_uiUncompressedDataSize;
   pReader->m_uiCompressedSize = pEntry->m_uiStoredDataSize;
 
+  if (pEntry->m_CompressionMode == ezArchiveCompressionMode::Uncompressed)
+    pReader->m_MappedData = m_ArchiveReader.GetEntryStoredData(uiEntryIndex);
+  else
+    pReader->m_MappedData.Clear();
+
   m_ArchiveReader.ConfigureRawMemoryStreamReader(uiEntryIndex, pReader->m_MemStreamReader);
 
   if (pReader->Open(sArchivePath, this, FileShareMode).Failed())
   {
-    EZ_DEFAULT_DELETE(pReader);
+    // the reader is owned by the pool, just make it available again
+    OnReaderWriterClose(pReader);
     return nullptr;
   }
 
@@ -110,6 +139,17 @@ ezDataDirectoryReader* ezDataDirectory::ArchiveType::OpenFileToRead(ezStringView
 
 void ezDataDirectory::ArchiveType::RemoveDataDirectory()
 {
+  {
+    EZ_LOCK(m_ReaderMutex);
+
+    // open files may hand out views into the memory-mapped archive, so the archive has to stay mapped until they are closed
+    if (m_uiNumOpenReaders > 0)
+    {
+      m_bRemoveWhenUnused = true;
+      return;
+    }
+  }
+
   ArchiveType* pThis = this;
   EZ_DEFAULT_DELETE(pThis);
 }
@@ -206,24 +246,41 @@ endloop:
 
 void ezDataDirectory::ArchiveType::OnReaderWriterClose(ezDataDirectoryReaderWriterBase* pClosed)
 {
-  EZ_LOCK(m_ReaderMutex);
+  bool bDeleteThis = false;
 
-  if (pClosed->GetDataDirUserData() == 0)
   {
-    m_FreeReadersUncompressed.PushBack(static_cast<ArchiveReaderUncompressed*>(pClosed));
-    return;
-  }
+    EZ_LOCK(m_ReaderMutex);
+
+    switch (pClosed->GetDataDirUserData())
+    {
+      case 0:
+        m_FreeReadersUncompressed.PushBack(static_cast<ArchiveReaderUncompressed*>(pClosed));
+        break;
 
 #ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
-  if (pClosed->GetDataDirUserData() == 1)
-  {
-    m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
-    return;
-  }
+      case 1:
+        m_FreeReadersZstd.PushBack(static_cast<ArchiveReaderZstd*>(pClosed));
+        break;
+
+      case 2:
+        m_FreeReadersZstdSeekable.PushBack(static_cast<ArchiveReaderZstdSeekable*>(pClosed));
+        break;
 #endif
 
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        return;
+    }
 
-  EZ_ASSERT_NOT_IMPLEMENTED;
+    --m_uiNumOpenReaders;
+    bDeleteThis = m_bRemoveWhenUnused && m_uiNumOpenReaders == 0;
+  }
+
+  if (bDeleteThis)
+  {
+    ArchiveType* pThis = this;
+    EZ_DEFAULT_DELETE(pThis);
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -282,6 +339,28 @@ ezResult ezDataDirectory::ArchiveReaderZstd::InternalOpen(ezFileShareMode::Enum
   return EZ_SUCCESS;
 }
 
+//////////////////////////////////////////////////////////////////////////
+
+ezDataDirectory::ArchiveReaderZstdSeekable::ArchiveReaderZstdSeekable(ezInt32 iDataDirUserData)
+  : ArchiveReaderUncompressed(iDataDirUserData)
+{
+}
+
+ezDataDirectory::ArchiveReaderZstdSeekable::~ArchiveReaderZstdSeekable() = default;
+
+ezUInt64 ezDataDirectory::ArchiveReaderZstdSeekable::Read(void* pBuffer, ezUInt64 uiBytes)
+{
+  return m_SeekableReader.ReadBytes(pBuffer, uiBytes);
+}
+
+ezResult ezDataDirectory::ArchiveReaderZstdSeekable::InternalOpen(ezFileShareMode::Enum FileShareMode)
+{
+  EZ_ASSERT_DEBUG(FileShareMode != ezFileShareMode::Exclusive, "Archives only support shared reading of files. Exclusive access cannot be guaranteed.");
+
+  // reuses the decompression context and frame cache of the previous file
+  return m_SeekableReader.SetInputData(m_StoredData, m_pDictionary);
+}
+
 #endif
 
 //////////////////////////////////////////////////////////////////////////
@@ -0,0 +1,115 @@
+#pragma once
+
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Threading/ConditionVariable.h>
+#include <Foundation/Types/UniquePtr.h>
+
+struct ezAsyncFileReaderUring;
+
+/// \brief Describes one read operation that is submitted to ezAsyncFileReader.
+struct ezAsyncFileReadRequest
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezUInt64 m_uiOffset = 0;         ///< The byte offset in the file from where to read.
+  ezArrayPtr<ezUInt8> m_Buffer;    ///< The data is written into this buffer. It must stay valid until the request has completed.
+  ezUInt64 m_uiUserData = 0;       ///< Passed through to ezAsyncFileReadResult, to identify the request.
+};
+
+/// \brief Reports the outcome of one ezAsyncFileReadRequest.
+struct ezAsyncFileReadResult
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezUInt64 m_uiUserData = 0;   ///< The value of ezAsyncFileReadRequest::m_uiUserData.
+  ezUInt64 m_uiBytesRead = 0;  ///< How many bytes were read. This is less than requested when the end of the file was reached.
+  ezResult m_Result = EZ_FAILURE;
+};
+
+/// \brief Reads from a file asynchronously, with many reads in flight at the same time.
+///
+/// Reads are submitted with Submit() and return immediately. Each request reads a range of the file into a caller provided buffer,
+/// so a large read can be scattered into many buffers, and many files can be read at once, without blocking the calling thread.
+/// Completed requests are retrieved with Poll().
+///
+/// On Linux the reads are executed through io_uring, if the kernel supports it. Everywhere else (or when io_uring is not available,
+/// e.g. because it is disabled in a container) the reads are executed by tasks on the ezTaskSystem, using ezOSFile::ReadAt().
+///
+/// All functions must be called from the same thread.
+class EZ_FOUNDATION_DLL ezAsyncFileReader
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezAsyncFileReader);
+
+public:
+  /// \brief Which mechanism is used to execute the reads.
+  enum class Backend
+  {
+    Default,    ///< Use the fastest backend that is available.
+    ThreadPool, ///< Execute blocking reads on the ezTaskSystem.
+    IoUring,    ///< Use io_uring. Only available on Linux.
+  };
+
+  ezAsyncFileReader();
+  ~ezAsyncFileReader();
+
+  /// \brief Opens the given file for asynchronous reading.
+  ///
+  /// The path can be absolute or any path that ezFileSystem::ResolvePath() can resolve to a file in a folder data directory.
+  /// \param uiQueueDepth How many reads may be in flight at the same time. Additional requests are queued until others finish.
+  /// \param backend Which backend to use. If the requested backend is not available, the thread pool is used.
+  ezResult Open(ezStringView sFile, ezUInt32 uiQueueDepth = 32, Backend backend = Backend::Default); // [tested]
+
+  /// \brief Waits for all outstanding reads and closes the file. Results that were not polled are discarded.
+  void Close(); // [tested]
+
+  /// \brief Returns whether a file is currently open.
+  bool IsOpen() const { return m_File.IsOpen(); }
+
+  /// \brief Returns which backend is used for the currently open file.
+  Backend GetBackend() const { return m_Backend; }
+
+  /// \brief Returns the size of the open file.
+  ezUInt64 GetFileSize() const { return m_uiFileSize; }
+
+  /// \brief Queues all the given reads. Returns immediately.
+  void Submit(ezArrayPtr<const ezAsyncFileReadRequest> requests); // [tested]
+
+  /// \brief Appends the results of all reads that have completed so far to \a out_results.
+  ///
+  /// If \a uiMinResults is larger than zero, the function blocks until at least that many results are available
+  /// (or all outstanding reads are done). Returns the number of results that were appended.
+  ezUInt32 Poll(ezDynamicArray<ezAsyncFileReadResult>& out_results, ezUInt32 uiMinResults = 0); // [tested]
+
+  /// \brief Blocks until all submitted reads have completed and appends their results to \a out_results.
+  void WaitForAll(ezDynamicArray<ezAsyncFileReadResult>& out_results); // [tested]
+
+  /// \brief Returns the number of submitted reads whose results have not been polled yet.
+  ezUInt32 GetNumOutstanding() const { return m_uiNumOutstanding; }
+
+  /// \brief Returns whether io_uring can be used on this system.
+  static bool IsIoUringSupported();
+
+private:
+  friend struct ezAsyncFileReaderUring;
+
+  void SubmitToThreadPool(ezArrayPtr<const ezAsyncFileReadRequest> requests);
+  ezUInt32 PollThreadPool(ezDynamicArray<ezAsyncFileReadResult>& out_results, ezUInt32 uiMinResults);
+  void ThreadPoolWorker();
+
+  ezOSFile m_File;
+  ezUInt64 m_uiFileSize = 0;
+  ezUInt32 m_uiQueueDepth = 0;
+  ezUInt32 m_uiNumOutstanding = 0;
+  Backend m_Backend = Backend::Default;
+
+  // thread pool backend
+  ezConditionVariable m_ThreadPoolSignal; ///< Protects the data below, signaled when a request completes or a worker finishes.
+  ezDeque<ezAsyncFileReadRequest> m_PendingRequests;
+  ezDeque<ezAsyncFileReadResult> m_CompletedRequests;
+  ezUInt32 m_uiActiveWorkers = 0;
+
+  // io_uring backend
+  ezUniquePtr<ezAsyncFileReaderUring> m_pUring;
+};
@@ -0,0 +1,102 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Threading/AtomicInteger.h>
+#include <Foundation/Threading/Mutex.h>
+
+class ezStreamReader;
+class ezStreamWriter;
+
+/// \brief An in-memory index of all files and folders inside of a data directory.
+///
+/// Data directory types can use this to answer 'does this file exist' queries without asking the OS.
+/// The index only stores 64 bit hashes of the (lower-case, clean) data directory relative paths. Therefore it can only
+/// give a definite 'no' answer, a positive answer may be a hash collision and still needs to be confirmed through the OS.
+/// This is the case that matters, though: with many mounted data directories, most lookups are misses.
+///
+/// Lookups (MayContainEntry()) are lock-free and can happen on any thread, while entries are added or removed.
+/// Modifications are synchronized through an internal mutex. Build(), ReadFromStream() and Clear() must not be called
+/// while other threads may do lookups.
+class EZ_FOUNDATION_DLL ezDataDirFileIndex
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezDataDirFileIndex);
+
+public:
+  ezDataDirFileIndex();
+  ~ezDataDirFileIndex();
+
+  /// \brief Removes all entries and marks the index as invalid.
+  void Clear();
+
+  /// \brief Returns true once the index has been filled through Build() or ReadFromStream().
+  ///
+  /// An invalid index is never used to reject lookups.
+  bool IsValid() const { return m_bValid; }
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS) || defined(EZ_DOCS)
+  /// \brief Recursively iterates over all files and folders in the given absolute folder and adds them to the index.
+  ///
+  /// Folders that are reached through symlinks are indexed as well, see ezFileSystemIteratorFlags::FollowSymlinks.
+  ezResult Build(ezStringView sAbsoluteFolder);
+#endif
+
+  /// \brief Writes the index (only the hashes) to a stream, such that it can be restored without scanning the folder again.
+  ezResult WriteToStream(ezStreamWriter& inout_stream) const;
+
+  /// \brief Replaces the index content with data previously written through WriteToStream().
+  ezResult ReadFromStream(ezStreamReader& inout_stream);
+
+  /// \brief Adds the given data directory relative path to the index. All parent folders are added as well.
+  void AddEntry(ezStringView sRelativePath);
+
+  /// \brief Removes the given data directory relative path from the index.
+  ///
+  /// Entries inside a removed folder are not removed, which is fine, since they only lead to an unnecessary OS lookup.
+  void RemoveEntry(ezStringView sRelativePath);
+
+  /// \brief Returns false, if the given data directory relative path definitely does not exist. Lock-free.
+  ///
+  /// Returns true, if the path may exist, ie. if it is in the index, if the index is not valid, or if the path cannot
+  /// be handled by the index (absolute paths or paths that leave the data directory).
+  bool MayContainEntry(ezStringView sRelativePath) const;
+
+  /// \brief Returns the number of entries in the index.
+  ezUInt32 GetCount() const { return m_uiCount; }
+
+  struct Stats
+  {
+    ezUInt64 m_uiNumLookups = 0;  ///< How often MayContainEntry() was called.
+    ezUInt64 m_uiNumRejected = 0; ///< How many of those lookups were answered with 'does not exist'.
+  };
+
+  /// \brief Returns how many lookups were done and how many of those did not need to go to the OS.
+  Stats GetStats() const;
+
+  /// \brief Resets the values returned by GetStats().
+  void ResetStats();
+
+  /// \brief Computes the hash under which a relative path is stored. Returns 0 if the path can't be indexed.
+  static ezUInt64 ComputePathHash(ezStringView sRelativePath);
+
+private:
+  struct Table
+  {
+    Table(ezUInt32 uiCapacity);
+
+    ezUInt32 m_uiMask = 0;
+    ezUInt32 m_uiUsedSlots = 0; // including removed ones
+    ezDynamicArray<ezInt64> m_Slots;
+  };
+
+  void InsertHash(ezUInt64 uiHash);
+  void GrowIfNecessary();
+
+  mutable ezMutex m_Mutex;
+  Table* volatile m_pTable = nullptr;
+  ezDynamicArray<Table*> m_RetiredTables;
+  ezUInt32 m_uiCount = 0;
+  bool m_bValid = false;
+
+  mutable ezAtomicInteger64 m_iNumLookups;
+  mutable ezAtomicInteger64 m_iNumRejected;
+};
@@ -2,9 +2,13 @@
 
 #include <Foundation/Containers/HybridArray.h>
 #include <Foundation/Containers/Map.h>
+#include <Foundation/IO/FileSystem/DataDirFileIndex.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/Implementation/DataDirType.h>
 #include <Foundation/IO/OSFile.h>
+#include <Foundation/Types/UniquePtr.h>
+
+class ezDirectoryWatcher;
 
 namespace ezDataDirectory
 {
@@ -34,9 +38,30 @@ namespace ezDataDirectory
     /// access.
     static ezString s_sRedirectionPrefix;
 
+    /// If enabled, folder data directories that are mounted afterwards keep an ezDataDirFileIndex of all their files.
+    /// Lookups of files that do not exist in the folder are then answered from memory, instead of asking the OS.
+    /// Files that are written through ezFileSystem are added to the index right away, other changes are picked up
+    /// through an ezDirectoryWatcher whenever ezFileSystem::UpdateAllDataDirectoryFileIndices() is called.
+    static bool s_bUseFileIndex;
+
+    /// If s_bUseFileIndex is enabled and a file with this name exists in the data directory, the file index is read from it,
+    /// instead of scanning the entire folder. See WriteFileIndexManifest().
+    static ezString s_sFileIndexManifest;
+
     /// \brief When s_sRedirectionFile and s_sRedirectionPrefix are used to enable file redirection, this will reload those config files.
     virtual void ReloadExternalConfigs() override;
 
+    /// \brief Applies all changes that the directory watcher reported since the last call to the file index.
+    virtual void UpdateFileIndex() override;
+
+    /// \brief Returns the file index of this data directory. It is only valid, if s_bUseFileIndex was enabled when this directory was mounted.
+    const ezDataDirFileIndex& GetFileIndex() const { return m_FileIndex; }
+
+    /// \brief Scans the given folder and writes a file index manifest (with the name s_sFileIndexManifest) into it.
+    ///
+    /// This is meant for packaging steps, where the content of a data directory doesn't change anymore.
+    static ezResult WriteFileIndexManifest(ezStringView sAbsoluteFolder);
+
     virtual const ezString128& GetRedirectedDataDirectoryPath() const override { return m_sRedirectedDataDirPath; }
 
   protected:
@@ -60,6 +85,10 @@ namespace ezDataDirectory
     virtual void OnReaderWriterClose(ezDataDirectoryReaderWriterBase* pClosed) override;
 
     void LoadRedirectionFile();
+    void InitializeFileIndex();
+
+    /// \brief Informs all folder data directories with a file index, that the given file has been created.
+    static void AddToFileIndices(ezStringView sAbsolutePath);
 
     mutable ezMutex m_ReaderWriterMutex; ///< Locks m_Readers / m_Writers as well as the m_bIsInUse flag of each reader / writer.
     ezHybridArray<ezDataDirectory::FolderReader*, 4> m_Readers;
@@ -68,6 +97,11 @@ namespace ezDataDirectory
     mutable ezMutex m_RedirectionMutex;
     ezMap<ezString, ezString> m_FileRedirection;
     ezString128 m_sRedirectedDataDirPath;
+
+    ezDataDirFileIndex m_FileIndex;
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    ezUniquePtr<ezDirectoryWatcher> m_pFileIndexWatcher;
+#endif
   };
 
 
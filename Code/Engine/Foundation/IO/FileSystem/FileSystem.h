@@ -123,6 +123,13 @@ public:
   /// \brief Calls ezDataDirectoryType::ReloadExternalConfigs() on all active data directories.
   static void ReloadAllExternalDataDirectoryConfigs();
 
+  /// \brief Calls ezDataDirectoryType::UpdateFileIndex() on all active data directories.
+  ///
+  /// Data directories that use a file index (see ezDataDirectory::FolderType::s_bUseFileIndex) only pick up files that were
+  /// created outside of ezFileSystem, once this has been called. Applications that use file indices should call this regularly,
+  /// e.g. once per frame.
+  static void UpdateAllDataDirectoryFileIndices();
+
   ///@}
   /// \name Special Directories
   ///@{
@@ -0,0 +1,334 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/Algorithm/HashingUtils.h>
+#include <Foundation/IO/FileSystem/DataDirFileIndex.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/Threading/AtomicUtils.h>
+
+namespace
+{
+  // slot values 0 and 1 are reserved, all hashes are remapped to not collide with those
+  constexpr ezInt64 s_iEmptySlot = 0;
+  constexpr ezInt64 s_iRemovedSlot = 1;
+
+  constexpr ezUInt32 s_uiMinCapacity = 64;
+  constexpr ezUInt8 s_uiFileIndexVersion = 1;
+} // namespace
+
+ezDataDirFileIndex::Table::Table(ezUInt32 uiCapacity)
+{
+  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiCapacity), "Invalid table capacity");
+
+  m_uiMask = uiCapacity - 1;
+  m_Slots.SetCount(uiCapacity); // zero-initialized, ie. s_iEmptySlot
+}
+
+ezDataDirFileIndex::ezDataDirFileIndex() = default;
+
+ezDataDirFileIndex::~ezDataDirFileIndex()
+{
+  Clear();
+}
+
+void ezDataDirFileIndex::Clear()
+{
+  EZ_LOCK(m_Mutex);
+
+  for (Table* pTable : m_RetiredTables)
+  {
+    EZ_DEFAULT_DELETE(pTable);
+  }
+  m_RetiredTables.Clear();
+
+  Table* pTable = m_pTable;
+  m_pTable = nullptr;
+  EZ_DEFAULT_DELETE(pTable);
+
+  m_uiCount = 0;
+  m_bValid = false;
+}
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+ezResult ezDataDirFileIndex::Build(ezStringView sAbsoluteFolder)
+{
+  Clear();
+
+  ezStringBuilder sRoot = sAbsoluteFolder;
+  sRoot.MakeCleanPath();
+  sRoot.Trim("", "/");
+
+  if (!ezOSFile::ExistsDirectory(sRoot))
+    return EZ_FAILURE;
+
+  EZ_LOCK(m_Mutex);
+
+  ezStringBuilder sFullPath;
+
+  ezFileSystemIterator it;
+  for (it.StartSearch(sRoot, ezFileSystemIteratorFlags::ReportFilesAndFoldersRecursive | ezFileSystemIteratorFlags::FollowSymlinks); it.IsValid(); it.Next())
+  {
+    it.GetStats().GetFullPath(sFullPath);
+
+    ezStringView sRelative = sFullPath;
+    if (!sRelative.StartsWith_NoCase(sRoot))
+      continue;
+
+    sRelative.Shrink(sRoot.GetCharacterCount(), 0);
+    sRelative.Trim("/");
+
+    InsertHash(ComputePathHash(sRelative));
+  }
+
+  m_bValid = true;
+  return EZ_SUCCESS;
+}
+#endif
+
+ezResult ezDataDirFileIndex::WriteToStream(ezStreamWriter& inout_stream) const
+{
+  EZ_LOCK(m_Mutex);
+
+  inout_stream << s_uiFileIndexVersion;
+  inout_stream << m_uiCount;
+
+  if (m_pTable != nullptr)
+  {
+    for (ezInt64 iSlot : m_pTable->m_Slots)
+    {
+      if (iSlot != s_iEmptySlot && iSlot != s_iRemovedSlot)
+      {
+        inout_stream << iSlot;
+      }
+    }
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezDataDirFileIndex::ReadFromStream(ezStreamReader& inout_stream)
+{
+  Clear();
+
+  ezUInt8 uiVersion = 0;
+  inout_stream >> uiVersion;
+
+  if (uiVersion != s_uiFileIndexVersion)
+    return EZ_FAILURE;
+
+  ezUInt32 uiCount = 0;
+  inout_stream >> uiCount;
+
+  EZ_LOCK(m_Mutex);
+
+  for (ezUInt32 i = 0; i < uiCount; ++i)
+  {
+    ezInt64 iHash = 0;
+    if (inout_stream.ReadBytes(&iHash, sizeof(iHash)) != sizeof(iHash))
+    {
+      Clear();
+      return EZ_FAILURE;
+    }
+
+    InsertHash(static_cast<ezUInt64>(iHash));
+  }
+
+  m_bValid = true;
+  return EZ_SUCCESS;
+}
+
+void ezDataDirFileIndex::AddEntry(ezStringView sRelativePath)
+{
+  ezStringBuilder sPath = sRelativePath;
+  sPath.MakeCleanPath();
+
+  EZ_LOCK(m_Mutex);
+
+  // add the file and all its parent folders, so that folder queries (GetFileStats) are answered correctly as well
+  while (!sPath.IsEmpty())
+  {
+    const ezUInt64 uiHash = ComputePathHash(sPath);
+    if (uiHash == 0)
+      break;
+
+    InsertHash(uiHash);
+
+    sPath.PathParentDirectory();
+    sPath.Trim("", "/");
+  }
+}
+
+void ezDataDirFileIndex::RemoveEntry(ezStringView sRelativePath)
+{
+  const ezUInt64 uiHash = ComputePathHash(sRelativePath);
+  if (uiHash == 0)
+    return;
+
+  EZ_LOCK(m_Mutex);
+
+  Table* pTable = m_pTable;
+  if (pTable == nullptr)
+    return;
+
+  for (ezUInt32 i = 0, uiSlot = static_cast<ezUInt32>(uiHash) & pTable->m_uiMask; i <= pTable->m_uiMask; ++i, uiSlot = (uiSlot + 1) & pTable->m_uiMask)
+  {
+    const ezInt64 iSlot = pTable->m_Slots[uiSlot];
+
+    if (iSlot == s_iEmptySlot)
+      return;
+
+    if (iSlot == static_cast<ezInt64>(uiHash))
+    {
+      // the slot stays 'used', so that probing for other entries does not stop here
+      ezAtomicUtils::Set(pTable->m_Slots[uiSlot], s_iRemovedSlot);
+      --m_uiCount;
+      return;
+    }
+  }
+}
+
+bool ezDataDirFileIndex::MayContainEntry(ezStringView sRelativePath) const
+{
+  if (!m_bValid)
+    return true;
+
+  m_iNumLookups.Increment();
+
+  const ezUInt64 uiHash = ComputePathHash(sRelativePath);
+  if (uiHash == 0)
+    return true;
+
+  // the table pointer is only swapped out, never deleted while lookups may happen (see m_RetiredTables)
+  const Table* pTable = m_pTable;
+  if (pTable != nullptr)
+  {
+    for (ezUInt32 i = 0, uiSlot = static_cast<ezUInt32>(uiHash) & pTable->m_uiMask; i <= pTable->m_uiMask; ++i, uiSlot = (uiSlot + 1) & pTable->m_uiMask)
+    {
+      const ezInt64 iSlot = ezAtomicUtils::Read(pTable->m_Slots[uiSlot]);
+
+      if (iSlot == static_cast<ezInt64>(uiHash))
+        return true;
+
+      if (iSlot == s_iEmptySlot)
+        break;
+    }
+  }
+
+  m_iNumRejected.Increment();
+  return false;
+}
+
+ezDataDirFileIndex::Stats ezDataDirFileIndex::GetStats() const
+{
+  Stats stats;
+  stats.m_uiNumLookups = static_cast<ezUInt64>(m_iNumLookups);
+  stats.m_uiNumRejected = static_cast<ezUInt64>(m_iNumRejected);
+  return stats;
+}
+
+void ezDataDirFileIndex::ResetStats()
+{
+  m_iNumLookups = 0;
+  m_iNumRejected = 0;
+}
+
+ezUInt64 ezDataDirFileIndex::ComputePathHash(ezStringView sRelativePath)
+{
+  if (sRelativePath.IsEmpty() || ezPathUtils::IsAbsolutePath(sRelativePath) || sRelativePath.StartsWith(":"))
+    return 0;
+
+  ezStringBuilder sPath = sRelativePath;
+  sPath.MakeCleanPath();
+  sPath.Trim("/");
+  sPath.ToLower();
+
+  // paths that leave the data directory cannot be answered by the index
+  if (sPath.IsEmpty() || sPath.IsEqual("..") || sPath.StartsWith("../"))
+    return 0;
+
+  ezUInt64 uiHash = ezHashingUtils::xxHash64String(sPath);
+
+  if (uiHash <= static_cast<ezUInt64>(s_iRemovedSlot))
+    uiHash += 2;
+
+  return uiHash;
+}
+
+void ezDataDirFileIndex::InsertHash(ezUInt64 uiHash)
+{
+  if (uiHash == 0)
+    return;
+
+  GrowIfNecessary();
+
+  Table* pTable = m_pTable;
+
+  ezUInt32 uiFreeSlot = ezInvalidIndex;
+
+  for (ezUInt32 i = 0, uiSlot = static_cast<ezUInt32>(uiHash) & pTable->m_uiMask; i <= pTable->m_uiMask; ++i, uiSlot = (uiSlot + 1) & pTable->m_uiMask)
+  {
+    const ezInt64 iSlot = pTable->m_Slots[uiSlot];
+
+    if (iSlot == static_cast<ezInt64>(uiHash))
+      return;
+
+    if (iSlot == s_iRemovedSlot && uiFreeSlot == ezInvalidIndex)
+    {
+      uiFreeSlot = uiSlot;
+    }
+    else if (iSlot == s_iEmptySlot)
+    {
+      if (uiFreeSlot == ezInvalidIndex)
+      {
+        uiFreeSlot = uiSlot;
+        ++pTable->m_uiUsedSlots;
+      }
+      break;
+    }
+  }
+
+  EZ_ASSERT_DEBUG(uiFreeSlot != ezInvalidIndex, "File index table is full");
+
+  ezAtomicUtils::Set(pTable->m_Slots[uiFreeSlot], static_cast<ezInt64>(uiHash));
+  ++m_uiCount;
+}
+
+void ezDataDirFileIndex::GrowIfNecessary()
+{
+  Table* pOldTable = m_pTable;
+
+  // keep the load factor (including removed slots) below 50%, so that probe sequences stay short
+  if (pOldTable != nullptr && (pOldTable->m_uiUsedSlots + 1) * 2 <= pOldTable->m_Slots.GetCount())
+    return;
+
+  const ezUInt32 uiCapacity = ezMath::Max(s_uiMinCapacity, ezMath::PowerOfTwo_Ceil((m_uiCount + 1) * 4));
+
+  Table* pNewTable = EZ_DEFAULT_NEW(Table, uiCapacity);
+
+  if (pOldTable != nullptr)
+  {
+    for (ezInt64 iSlot : pOldTable->m_Slots)
+    {
+      if (iSlot == s_iEmptySlot || iSlot == s_iRemovedSlot)
+        continue;
+
+      ezUInt32 uiSlot = static_cast<ezUInt32>(iSlot) & pNewTable->m_uiMask;
+      while (pNewTable->m_Slots[uiSlot] != s_iEmptySlot)
+      {
+        uiSlot = (uiSlot + 1) & pNewTable->m_uiMask;
+      }
+
+      pNewTable->m_Slots[uiSlot] = iSlot;
+      ++pNewTable->m_uiUsedSlots;
+    }
+
+    // concurrent lookups may still read from the old table, so it can only be deleted in Clear()
+    m_RetiredTables.PushBack(pOldTable);
+  }
+
+  // publish the fully initialized table, TestAndSet acts as a full memory barrier
+  ezAtomicUtils::TestAndSet(reinterpret_cast<void**>(const_cast<Table**>(&m_pTable)), pOldTable, pNewTable);
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_FileSystem_Implementation_DataDirFileIndex);
@@ -36,6 +36,10 @@ public:
   ///        reloading and reapplying of configurations, without dismounting and remounting the data directory.
   virtual void ReloadExternalConfigs(){};
 
+  /// \brief Data directory types that keep an in-memory index of their files (see ezDataDirFileIndex) should
+  ///        update that index with all external changes that happened since the last call.
+  virtual void UpdateFileIndex() {}
+
 protected:
   friend class ezFileSystem;
 
@@ -163,6 +167,11 @@ public:
   }
 
   virtual ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes) = 0;
+
+  /// \brief If the entire file content is directly accessible in memory (e.g. an uncompressed file in a memory-mapped archive), this returns a view of it.
+  ///
+  /// The view stays valid until the reader is closed. The default implementation returns an empty view.
+  virtual ezArrayPtr<const ezUInt8> GetMappedFileData() const { return {}; }
 };
 
 /// \brief A base class for writers that handle writing to a (virtual) file inside a data directory.
@@ -1,7 +1,9 @@
 #include <Foundation/FoundationPCH.h>
 
 #include <Foundation/Configuration/Startup.h>
+#include <Foundation/IO/DirectoryWatcher.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#include <Foundation/IO/MemoryStream.h>
 #include <Foundation/Logging/Log.h>
 
 // clang-format off
@@ -23,6 +25,11 @@ namespace ezDataDirectory
 {
   ezString FolderType::s_sRedirectionFile;
   ezString FolderType::s_sRedirectionPrefix;
+  bool FolderType::s_bUseFileIndex = false;
+  ezString FolderType::s_sFileIndexManifest = "ezFileIndex.ezIndex";
+
+  // all folder data directories that have a file index, protected by the file system mutex
+  static ezHybridArray<FolderType*, 16> s_FoldersWithFileIndex;
 
   ezResult FolderReader::InternalOpen(ezFileShareMode::Enum FileShareMode)
   {
@@ -105,10 +112,17 @@ namespace ezDataDirectory
     sPath.AppendPath(sFile);
 
     ezOSFile::DeleteFile(sPath.GetData()).IgnoreResult();
+    m_FileIndex.RemoveEntry(sFile);
   }
 
   FolderType::~FolderType()
   {
+    if (m_FileIndex.IsValid())
+    {
+      EZ_LOCK(ezFileSystem::GetMutex());
+      s_FoldersWithFileIndex.RemoveAndSwap(this);
+    }
+
     EZ_LOCK(m_ReaderWriterMutex);
     for (ezUInt32 i = 0; i < m_Readers.GetCount(); ++i)
       EZ_DEFAULT_DELETE(m_Readers[i]);
@@ -122,6 +136,144 @@ namespace ezDataDirectory
     LoadRedirectionFile();
   }
 
+  void FolderType::InitializeFileIndex()
+  {
+    EZ_LOG_BLOCK("InitializeFileIndex", m_sRedirectedDataDirPath.GetData());
+
+    bool bLoaded = false;
+
+    if (!s_sFileIndexManifest.IsEmpty())
+    {
+      ezStringBuilder sManifest(m_sRedirectedDataDirPath, "/", s_sFileIndexManifest);
+      sManifest.MakeCleanPath();
+
+      ezOSFile file;
+      if (file.Open(sManifest, ezFileOpenMode::Read).Succeeded())
+      {
+        ezDynamicArray<ezUInt8> content;
+        file.ReadAll(content);
+
+        ezRawMemoryStreamReader reader(content);
+        bLoaded = m_FileIndex.ReadFromStream(reader).Succeeded();
+
+        if (!bLoaded)
+        {
+          ezLog::Warning("File index manifest '{}' is invalid and will be ignored.", sManifest);
+        }
+      }
+    }
+
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    if (!bLoaded)
+    {
+      bLoaded = m_FileIndex.Build(m_sRedirectedDataDirPath).Succeeded();
+    }
+#endif
+
+    if (!bLoaded)
+      return;
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    m_pFileIndexWatcher = EZ_DEFAULT_NEW(ezDirectoryWatcher);
+    if (m_pFileIndexWatcher->OpenDirectory(m_sRedirectedDataDirPath, ezDirectoryWatcher::Watch::Creates | ezDirectoryWatcher::Watch::Deletes | ezDirectoryWatcher::Watch::Renames | ezDirectoryWatcher::Watch::Subdirectories).Failed())
+    {
+      ezLog::Warning("Could not watch data directory for changes. Files that are created outside of ezFileSystem will not be found.");
+      m_pFileIndexWatcher.Clear();
+    }
+#endif
+
+    EZ_LOCK(ezFileSystem::GetMutex());
+    s_FoldersWithFileIndex.PushBack(this);
+  }
+
+  void FolderType::UpdateFileIndex()
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+    if (m_pFileIndexWatcher == nullptr)
+      return;
+
+    // not all watcher implementations report their directory through GetDirectory()
+    ezStringBuilder sRoot = m_sRedirectedDataDirPath;
+    sRoot.MakeCleanPath();
+    sRoot.Trim("", "/");
+
+    m_pFileIndexWatcher->EnumerateChanges([&](ezStringView sFilename, ezDirectoryWatcherAction action, ezDirectoryWatcherType type) {
+      ezStringView sRelative = sFilename;
+
+      if (ezPathUtils::IsAbsolutePath(sRelative))
+      {
+        if (!sRelative.StartsWith_NoCase(sRoot))
+          return;
+
+        sRelative.Shrink(sRoot.GetCharacterCount(), 0);
+        sRelative.Trim("/\\");
+      }
+
+      switch (action)
+      {
+        case ezDirectoryWatcherAction::Added:
+        case ezDirectoryWatcherAction::RenamedNewName:
+          m_FileIndex.AddEntry(sRelative);
+          break;
+
+        case ezDirectoryWatcherAction::Removed:
+        case ezDirectoryWatcherAction::RenamedOldName:
+          m_FileIndex.RemoveEntry(sRelative);
+          break;
+
+        default:
+          break;
+      }
+    });
+#endif
+  }
+
+  ezResult FolderType::WriteFileIndexManifest(ezStringView sAbsoluteFolder)
+  {
+#if EZ_ENABLED(EZ_SUPPORTS_FILE_ITERATORS)
+    EZ_ASSERT_DEV(!s_sFileIndexManifest.IsEmpty(), "No file index manifest name is set.");
+
+    ezDataDirFileIndex index;
+    EZ_SUCCEED_OR_RETURN(index.Build(sAbsoluteFolder));
+
+    // the manifest itself should be found as well
+    index.AddEntry(s_sFileIndexManifest);
+
+    ezDynamicArray<ezUInt8> content;
+    ezMemoryStreamContainerWrapperStorage<ezDynamicArray<ezUInt8>> storage(&content);
+    ezMemoryStreamWriter writer(&storage);
+    EZ_SUCCEED_OR_RETURN(index.WriteToStream(writer));
+
+    ezStringBuilder sManifest(sAbsoluteFolder, "/", s_sFileIndexManifest);
+    sManifest.MakeCleanPath();
+
+    ezOSFile file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sManifest, ezFileOpenMode::Write));
+    return file.Write(content.GetData(), content.GetCount());
+#else
+    return EZ_FAILURE;
+#endif
+  }
+
+  void FolderType::AddToFileIndices(ezStringView sAbsolutePath)
+  {
+    EZ_LOCK(ezFileSystem::GetMutex());
+
+    for (FolderType* pFolder : s_FoldersWithFileIndex)
+    {
+      const ezString128& sRoot = pFolder->GetRedirectedDataDirectoryPath();
+
+      if (!sAbsolutePath.StartsWith_NoCase(sRoot))
+        continue;
+
+      ezStringView sRelative = sAbsolutePath;
+      sRelative.Shrink(sRoot.GetCharacterCount(), 0);
+      sRelative.Trim("/");
+
+      pFolder->m_FileIndex.AddEntry(sRelative);
+    }
+  }
+
   void FolderType::LoadRedirectionFile()
   {
     EZ_LOCK(m_RedirectionMutex);
@@ -185,6 +337,9 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(sFile, sRedirectedAsset);
 
+    if (!m_FileIndex.MayContainEntry(sRedirectedAsset))
+      return false;
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
     sPath.AppendPath(sRedirectedAsset);
     return ezOSFile::ExistsFile(sPath);
@@ -195,6 +350,9 @@ namespace ezDataDirectory
     ezStringBuilder sRedirectedAsset;
     ResolveAssetRedirection(sFileOrFolder, sRedirectedAsset);
 
+    if (!m_FileIndex.MayContainEntry(sRedirectedAsset))
+      return EZ_FAILURE;
+
     ezStringBuilder sPath = GetRedirectedDataDirectoryPath();
 
     if (ezPathUtils::IsAbsolutePath(sRedirectedAsset))
@@ -234,6 +392,11 @@ namespace ezDataDirectory
 
     ReloadExternalConfigs();
 
+    if (s_bUseFileIndex)
+    {
+      InitializeFileIndex();
+    }
+
     return EZ_SUCCESS;
   }
 
@@ -271,6 +434,10 @@ namespace ezDataDirectory
     if (ezConversionUtils::IsStringUuid(sFileToOpen))
       return nullptr;
 
+    // the file index knows that this file does not exist, no need to ask the OS
+    if (!m_FileIndex.MayContainEntry(sFileToOpen))
+      return nullptr;
+
     FolderReader* pReader = nullptr;
     {
       EZ_LOCK(m_ReaderWriterMutex);
@@ -356,6 +523,14 @@ namespace ezDataDirectory
       return nullptr;
     }
 
+    if (!s_FoldersWithFileIndex.IsEmpty())
+    {
+      ezStringBuilder sAbsolutePath = GetRedirectedDataDirectoryPath();
+      sAbsolutePath.AppendPath(sFile);
+      sAbsolutePath.MakeCleanPath();
+      AddToFileIndices(sAbsolutePath);
+    }
+
     // if it succeeds, we return the reader
     return pWriter;
   }
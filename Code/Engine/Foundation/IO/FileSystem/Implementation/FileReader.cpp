@@ -14,6 +14,16 @@ ezResult ezFileReader::Open(ezStringView sFile, ezUInt32 uiCacheSize /*= 1024 *
   if (!m_pDataDirReader)
     return EZ_FAILURE;
 
+  if (!m_pDataDirReader->GetMappedFileData().IsEmpty())
+  {
+    // the data is already in memory, reading it through the cache would only add another copy
+    m_Cache.Clear();
+    m_uiBytesCached = 0;
+    m_uiCacheReadPosition = 0;
+    m_bEOF = false;
+    return EZ_SUCCESS;
+  }
+
   m_Cache.SetCountUninitialized(uiCacheSize);
 
   m_uiCacheReadPosition = 0;
@@ -38,6 +48,14 @@ ezUInt64 ezFileReader::ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead)
   if (m_bEOF)
     return 0;
 
+  if (m_Cache.IsEmpty())
+  {
+    // no cache is used for files that are mapped into memory
+    const ezUInt64 uiBytesRead = m_pDataDirReader->Read(pReadBuffer, uiBytesToRead);
+    m_bEOF = uiBytesRead < uiBytesToRead;
+    return uiBytesRead;
+  }
+
   ezUInt64 uiBufferPosition = 0; // how much was read, yet
   ezUInt8* pBuffer = (ezUInt8*)pReadBuffer;
 
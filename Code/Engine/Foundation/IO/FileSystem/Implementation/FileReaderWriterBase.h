@@ -36,6 +36,12 @@ public:
   /// \brief Returns the current total size of the file.
   ezUInt64 GetFileSize() const { return m_pDataDirReader->GetFileSize(); }
 
+  /// \brief Returns a read-only view of the entire file content, if the data directory provides it directly in memory, e.g. for uncompressed files in an ezArchive.
+  ///
+  /// This allows to use the data in place, without copying it. The view stays valid until the file is closed.
+  /// Returns an empty view, if the file content is not available in memory. In this case the file has to be read as usual.
+  ezArrayPtr<const ezUInt8> GetMappedFileData() const { return m_pDataDirReader->GetMappedFileData(); } // [tested]
+
 protected:
   ezDataDirectoryReader* GetFileReader(ezStringView sFile, ezFileShareMode::Enum FileShareMode, bool bAllowFileEvents)
   {
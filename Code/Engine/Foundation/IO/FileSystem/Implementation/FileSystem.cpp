@@ -828,6 +828,16 @@ void ezFileSystem::ReloadAllExternalDataDirectoryConfigs()
   }
 }
 
+void ezFileSystem::UpdateAllDataDirectoryFileIndices()
+{
+  EZ_LOCK(s_pData->m_FsMutex);
+
+  for (auto& dd : s_pData->m_DataDirectories)
+  {
+    dd.m_pDataDirectory->UpdateFileIndex();
+  }
+}
+
 void ezFileSystem::Startup()
 {
   s_pData = EZ_DEFAULT_NEW(FileSystemData);
@@ -0,0 +1,236 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/Threading/DelegateTask.h>
+#include <Foundation/Threading/TaskSystem.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <Foundation/IO/Implementation/Linux/AsyncFileReader_linux.h>
+#else
+struct ezAsyncFileReaderUring
+{
+};
+#endif
+
+ezAsyncFileReader::ezAsyncFileReader() = default;
+
+ezAsyncFileReader::~ezAsyncFileReader()
+{
+  Close();
+}
+
+bool ezAsyncFileReader::IsIoUringSupported()
+{
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  static const bool s_bSupported = []()
+  {
+    // io_uring may be missing (kernels before 5.1) or blocked (seccomp in containers), the only reliable test is to create one
+    io_uring_params params = {};
+    const int iRingFd = ezAsyncFileReaderUring::Setup(1, &params);
+    if (iRingFd < 0)
+      return false;
+
+    close(iRingFd);
+    return true;
+  }();
+
+  return s_bSupported;
+#else
+  return false;
+#endif
+}
+
+ezResult ezAsyncFileReader::Open(ezStringView sFile, ezUInt32 uiQueueDepth, Backend backend)
+{
+  Close();
+
+  EZ_ASSERT_DEV(uiQueueDepth > 0, "The queue depth must not be zero.");
+
+  ezStringBuilder sAbsolutePath;
+  if (ezPathUtils::IsAbsolutePath(sFile))
+  {
+    sAbsolutePath = sFile;
+  }
+  else
+  {
+    EZ_SUCCEED_OR_RETURN(ezFileSystem::ResolvePath(sFile, &sAbsolutePath, nullptr));
+  }
+
+  EZ_SUCCEED_OR_RETURN(m_File.Open(sAbsolutePath, ezFileOpenMode::Read));
+
+  m_uiFileSize = m_File.GetFileSize();
+  m_uiQueueDepth = uiQueueDepth;
+  m_uiNumOutstanding = 0;
+  m_Backend = Backend::ThreadPool;
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  if (backend != Backend::ThreadPool && IsIoUringSupported())
+  {
+    m_pUring = EZ_DEFAULT_NEW(ezAsyncFileReaderUring);
+
+    if (m_pUring->Initialize(fileno(m_File.GetFileData().m_pFileHandle), m_uiFileSize, uiQueueDepth).Succeeded())
+    {
+      m_Backend = Backend::IoUring;
+    }
+    else
+    {
+      m_pUring.Clear();
+    }
+  }
+#endif
+
+  return EZ_SUCCESS;
+}
+
+void ezAsyncFileReader::Close()
+{
+  if (!m_File.IsOpen())
+    return;
+
+  // the uring destructor waits for all reads that are in flight
+  m_pUring.Clear();
+
+  {
+    EZ_LOCK(m_ThreadPoolSignal);
+    m_PendingRequests.Clear();
+
+    while (m_uiActiveWorkers > 0)
+    {
+      m_ThreadPoolSignal.UnlockWaitForSignalAndLock();
+    }
+
+    m_CompletedRequests.Clear();
+  }
+
+  m_File.Close();
+  m_uiFileSize = 0;
+  m_uiNumOutstanding = 0;
+  m_Backend = Backend::Default;
+}
+
+void ezAsyncFileReader::Submit(ezArrayPtr<const ezAsyncFileReadRequest> requests)
+{
+  EZ_ASSERT_DEV(m_File.IsOpen(), "No file is open.");
+
+  m_uiNumOutstanding += requests.GetCount();
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  if (m_pUring != nullptr)
+  {
+    m_pUring->Submit(requests);
+    return;
+  }
+#endif
+
+  SubmitToThreadPool(requests);
+}
+
+ezUInt32 ezAsyncFileReader::Poll(ezDynamicArray<ezAsyncFileReadResult>& out_results, ezUInt32 uiMinResults)
+{
+  uiMinResults = ezMath::Min(uiMinResults, m_uiNumOutstanding);
+
+  ezUInt32 uiNumResults = 0;
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+  if (m_pUring != nullptr)
+  {
+    uiNumResults = m_pUring->Poll(out_results, uiMinResults);
+  }
+  else
+#endif
+  {
+    uiNumResults = PollThreadPool(out_results, uiMinResults);
+  }
+
+  m_uiNumOutstanding -= uiNumResults;
+  return uiNumResults;
+}
+
+void ezAsyncFileReader::WaitForAll(ezDynamicArray<ezAsyncFileReadResult>& out_results)
+{
+  Poll(out_results, m_uiNumOutstanding);
+}
+
+void ezAsyncFileReader::SubmitToThreadPool(ezArrayPtr<const ezAsyncFileReadRequest> requests)
+{
+  // more workers than long running threads would only wait for each other
+  const ezUInt32 uiMaxWorkers = ezMath::Min(m_uiQueueDepth, ezMath::Max(1u, ezTaskSystem::GetWorkerThreadCount(ezWorkerThreadType::LongTasks)));
+
+  ezUInt32 uiWorkersToStart = 0;
+
+  {
+    EZ_LOCK(m_ThreadPoolSignal);
+
+    for (const ezAsyncFileReadRequest& req : requests)
+    {
+      m_PendingRequests.PushBack(req);
+    }
+
+    while (m_uiActiveWorkers + uiWorkersToStart < uiMaxWorkers && m_uiActiveWorkers + uiWorkersToStart < m_PendingRequests.GetCount())
+    {
+      ++uiWorkersToStart;
+    }
+
+    m_uiActiveWorkers += uiWorkersToStart;
+  }
+
+  for (ezUInt32 i = 0; i < uiWorkersToStart; ++i)
+  {
+    ezSharedPtr<ezTask> pTask = EZ_DEFAULT_NEW(ezDelegateTask<void>, "AsyncFileRead", ezTaskNesting::Never, ezMakeDelegate(&ezAsyncFileReader::ThreadPoolWorker, this));
+    ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+  }
+}
+
+ezUInt32 ezAsyncFileReader::PollThreadPool(ezDynamicArray<ezAsyncFileReadResult>& out_results, ezUInt32 uiMinResults)
+{
+  EZ_LOCK(m_ThreadPoolSignal);
+
+  while (m_CompletedRequests.GetCount() < uiMinResults)
+  {
+    m_ThreadPoolSignal.UnlockWaitForSignalAndLock();
+  }
+
+  const ezUInt32 uiNumResults = m_CompletedRequests.GetCount();
+
+  for (const ezAsyncFileReadResult& res : m_CompletedRequests)
+  {
+    out_results.PushBack(res);
+  }
+
+  m_CompletedRequests.Clear();
+  return uiNumResults;
+}
+
+void ezAsyncFileReader::ThreadPoolWorker()
+{
+  EZ_LOCK(m_ThreadPoolSignal);
+
+  while (!m_PendingRequests.IsEmpty())
+  {
+    const ezAsyncFileReadRequest req = m_PendingRequests.PeekFront();
+    m_PendingRequests.PopFront();
+
+    ezAsyncFileReadResult res;
+    res.m_uiUserData = req.m_uiUserData;
+
+    {
+      // do the actual read without holding the lock
+      m_ThreadPoolSignal.Unlock();
+      res.m_uiBytesRead = m_File.ReadAt(req.m_Buffer.GetPtr(), req.m_Buffer.GetCount(), req.m_uiOffset);
+      m_ThreadPoolSignal.Lock();
+    }
+
+    // reading less than requested is only fine at the end of the file
+    res.m_Result = (res.m_uiBytesRead == req.m_Buffer.GetCount() || req.m_uiOffset + res.m_uiBytesRead >= m_uiFileSize) ? EZ_SUCCESS : EZ_FAILURE;
+
+    m_CompletedRequests.PushBack(res);
+    m_ThreadPoolSignal.SignalAll();
+  }
+
+  --m_uiActiveWorkers;
+  m_ThreadPoolSignal.SignalAll();
+}
+
+
+EZ_STATICLINK_FILE(Foundation, Foundation_IO_Implementation_AsyncFileReader);
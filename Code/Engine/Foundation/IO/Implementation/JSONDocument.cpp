@@ -0,0 +1,1052 @@
+#include <Foundation/FoundationPCH.h>
+
+#include <Foundation/IO/JSONDocument.h>
+#include <Foundation/IO/Stream.h>
+#include <Foundation/IO/StreamUtils.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/SimdMath/SimdTypes.h>
+#include <Foundation/Strings/UnicodeUtils.h>
+#include <Foundation/Utilities/ConversionUtils.h>
+
+namespace
+{
+  /// Deeper documents are rejected, mostly to keep ToVariant() from running out of stack space.
+  constexpr ezUInt32 s_uiMaxNestingDepth = 1024;
+
+  /// Bit masks for 64 consecutive bytes of the source, bit N belongs to byte N.
+  struct CharacterMasks
+  {
+    ezUInt64 m_uiQuote;
+    ezUInt64 m_uiBackslash;
+    ezUInt64 m_uiOperator;   // { } [ ] , :
+    ezUInt64 m_uiWhitespace; // space, tab, line feed, carriage return
+    ezUInt64 m_uiControl;    // all bytes below 0x20
+    ezUInt64 m_uiNonAscii;
+  };
+
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_AVX2
+
+  EZ_ALWAYS_INLINE ezUInt64 ToMask(__m256i low, __m256i high)
+  {
+    return static_cast<ezUInt32>(_mm256_movemask_epi8(low)) | (static_cast<ezUInt64>(static_cast<ezUInt32>(_mm256_movemask_epi8(high))) << 32);
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 EqualMask(__m256i low, __m256i high, char c)
+  {
+    const __m256i v = _mm256_set1_epi8(c);
+    return ToMask(_mm256_cmpeq_epi8(low, v), _mm256_cmpeq_epi8(high, v));
+  }
+
+  void ClassifyBlock(const char* pBlock, CharacterMasks& out_masks)
+  {
+    const __m256i low = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock));
+    const __m256i high = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pBlock + 32));
+
+    // setting bit 5 maps '[' onto '{' and ']' onto '}', no other byte ends up on these two
+    const __m256i bit5 = _mm256_set1_epi8(0x20);
+    const __m256i lowBit5 = _mm256_or_si256(low, bit5);
+    const __m256i highBit5 = _mm256_or_si256(high, bit5);
+
+    out_masks.m_uiQuote = EqualMask(low, high, '"');
+    out_masks.m_uiBackslash = EqualMask(low, high, '\\');
+    out_masks.m_uiOperator = EqualMask(lowBit5, highBit5, '{') | EqualMask(lowBit5, highBit5, '}') | EqualMask(low, high, ',') | EqualMask(low, high, ':');
+    out_masks.m_uiWhitespace = EqualMask(low, high, ' ') | EqualMask(low, high, '\t') | EqualMask(low, high, '\n') | EqualMask(low, high, '\r');
+
+    const __m256i maxControl = _mm256_set1_epi8(0x1F);
+    out_masks.m_uiControl = ToMask(_mm256_cmpeq_epi8(_mm256_min_epu8(low, maxControl), low), _mm256_cmpeq_epi8(_mm256_min_epu8(high, maxControl), high));
+    out_masks.m_uiNonAscii = ToMask(low, high);
+  }
+
+#elif EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE
+
+  struct Chunks
+  {
+    __m128i m_Data[4];
+  };
+
+  EZ_ALWAYS_INLINE ezUInt64 ToMask(__m128i a, __m128i b, __m128i c, __m128i d)
+  {
+    const ezUInt64 uiLow = static_cast<ezUInt32>(_mm_movemask_epi8(a)) | (static_cast<ezUInt32>(_mm_movemask_epi8(b)) << 16);
+    const ezUInt64 uiHigh = static_cast<ezUInt32>(_mm_movemask_epi8(c)) | (static_cast<ezUInt32>(_mm_movemask_epi8(d)) << 16);
+    return uiLow | (uiHigh << 32);
+  }
+
+  EZ_ALWAYS_INLINE ezUInt64 EqualMask(const Chunks& chunks, char c)
+  {
+    const __m128i v = _mm_set1_epi8(c);
+    return ToMask(_mm_cmpeq_epi8(chunks.m_Data[0], v), _mm_cmpeq_epi8(chunks.m_Data[1], v), _mm_cmpeq_epi8(chunks.m_Data[2], v), _mm_cmpeq_epi8(chunks.m_Data[3], v));
+  }
+
+  void ClassifyBlock(const char* pBlock, CharacterMasks& out_masks)
+  {
+    Chunks chunks;
+    Chunks chunksBit5;
+    Chunks control;
+
+    // setting bit 5 maps '[' onto '{' and ']' onto '}', no other byte ends up on these two
+    const __m128i bit5 = _mm_set1_epi8(0x20);
+    const __m128i maxControl = _mm_set1_epi8(0x1F);
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      chunks.m_Data[i] = _mm_loadu_si128(reinterpret_cast<const __m128i*>(pBlock + i * 16));
+      chunksBit5.m_Data[i] = _mm_or_si128(chunks.m_Data[i], bit5);
+      control.m_Data[i] = _mm_cmpeq_epi8(_mm_min_epu8(chunks.m_Data[i], maxControl), chunks.m_Data[i]);
+    }
+
+    out_masks.m_uiQuote = EqualMask(chunks, '"');
+    out_masks.m_uiBackslash = EqualMask(chunks, '\\');
+    out_masks.m_uiOperator = EqualMask(chunksBit5, '{') | EqualMask(chunksBit5, '}') | EqualMask(chunks, ',') | EqualMask(chunks, ':');
+    out_masks.m_uiWhitespace = EqualMask(chunks, ' ') | EqualMask(chunks, '\t') | EqualMask(chunks, '\n') | EqualMask(chunks, '\r');
+    out_masks.m_uiControl = ToMask(control.m_Data[0], control.m_Data[1], control.m_Data[2], control.m_Data[3]);
+    out_masks.m_uiNonAscii = ToMask(chunks.m_Data[0], chunks.m_Data[1], chunks.m_Data[2], chunks.m_Data[3]);
+  }
+
+#else
+
+  void ClassifyBlock(const char* pBlock, CharacterMasks& out_masks)
+  {
+    out_masks = {};
+
+    for (ezUInt32 i = 0; i < 64; ++i)
+    {
+      const ezUInt8 c = static_cast<ezUInt8>(pBlock[i]);
+      const ezUInt64 uiBit = static_cast<ezUInt64>(1) << i;
+
+      switch (c)
+      {
+        case '"':
+          out_masks.m_uiQuote |= uiBit;
+          break;
+        case '\\':
+          out_masks.m_uiBackslash |= uiBit;
+          break;
+        case '{':
+        case '}':
+        case '[':
+        case ']':
+        case ',':
+        case ':':
+          out_masks.m_uiOperator |= uiBit;
+          break;
+        case ' ':
+        case '\t':
+        case '\n':
+        case '\r':
+          out_masks.m_uiWhitespace |= uiBit;
+          break;
+      }
+
+      if (c < 0x20)
+        out_masks.m_uiControl |= uiBit;
+      if (c >= 0x80)
+        out_masks.m_uiNonAscii |= uiBit;
+    }
+  }
+
+#endif
+
+  /// \brief Returns the mask of all characters that are preceded by an escaping backslash.
+  ///
+  /// Runs of backslashes escape each other pairwise, \a inout_uiCarry transports a backslash at the end of the previous block.
+  /// This loops once per escape sequence, which is rare enough in typical documents.
+  EZ_ALWAYS_INLINE ezUInt64 FindEscapedCharacters(ezUInt64 uiBackslash, ezUInt64& inout_uiCarry)
+  {
+    ezUInt64 uiEscaped = inout_uiCarry;
+    uiBackslash &= ~inout_uiCarry;
+    inout_uiCarry = 0;
+
+    while (uiBackslash != 0)
+    {
+      const ezUInt64 uiBit = uiBackslash & (~uiBackslash + 1);
+      const ezUInt64 uiNext = uiBit << 1;
+
+      if (uiNext == 0)
+        inout_uiCarry = 1;
+
+      uiEscaped |= uiNext;
+      uiBackslash &= ~(uiBit | uiNext);
+    }
+
+    return uiEscaped;
+  }
+
+  /// \brief Bit N of the result is the XOR of the bits 0 to N of the input.
+  ///
+  /// Applied to the quote mask, this marks everything from an opening quote up to (excluding) the closing quote.
+  EZ_ALWAYS_INLINE ezUInt64 PrefixXor(ezUInt64 x)
+  {
+    x ^= x << 1;
+    x ^= x << 2;
+    x ^= x << 4;
+    x ^= x << 8;
+    x ^= x << 16;
+    x ^= x << 32;
+    return x;
+  }
+
+  EZ_ALWAYS_INLINE bool IsAtomCharacter(char c)
+  {
+    switch (c)
+    {
+      case ' ':
+      case '\t':
+      case '\n':
+      case '\r':
+      case '{':
+      case '}':
+      case '[':
+      case ']':
+      case ',':
+      case ':':
+      case '"':
+        return false;
+      default:
+        return true;
+    }
+  }
+
+  EZ_ALWAYS_INLINE bool IsDigit(char c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  /// \brief Checks the number grammar of RFC 8259: -?(0|[1-9][0-9]*)(\.[0-9]+)?([eE][+-]?[0-9]+)?
+  bool IsValidNumber(const char* pStart, const char* pEnd, bool& out_bInteger)
+  {
+    const char* c = pStart;
+    out_bInteger = true;
+
+    if (c < pEnd && *c == '-')
+      ++c;
+
+    if (c == pEnd)
+      return false;
+
+    if (*c == '0')
+    {
+      ++c;
+    }
+    else if (*c >= '1' && *c <= '9')
+    {
+      while (c < pEnd && IsDigit(*c))
+        ++c;
+    }
+    else
+    {
+      return false;
+    }
+
+    if (c < pEnd && *c == '.')
+    {
+      ++c;
+      out_bInteger = false;
+
+      if (c == pEnd || !IsDigit(*c))
+        return false;
+
+      while (c < pEnd && IsDigit(*c))
+        ++c;
+    }
+
+    if (c < pEnd && (*c == 'e' || *c == 'E'))
+    {
+      ++c;
+      out_bInteger = false;
+
+      if (c < pEnd && (*c == '+' || *c == '-'))
+        ++c;
+
+      if (c == pEnd || !IsDigit(*c))
+        return false;
+
+      while (c < pEnd && IsDigit(*c))
+        ++c;
+    }
+
+    return c == pEnd;
+  }
+
+  bool ParseHex4(const char* pStart, const char* pEnd, ezUInt32& out_uiValue)
+  {
+    if (pEnd - pStart < 4)
+      return false;
+
+    out_uiValue = 0;
+
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      const char c = pStart[i];
+      ezUInt32 uiDigit;
+
+      if (c >= '0' && c <= '9')
+        uiDigit = c - '0';
+      else if (c >= 'a' && c <= 'f')
+        uiDigit = c - 'a' + 10;
+      else if (c >= 'A' && c <= 'F')
+        uiDigit = c - 'A' + 10;
+      else
+        return false;
+
+      out_uiValue = (out_uiValue << 4) | uiDigit;
+    }
+
+    return true;
+  }
+} // namespace
+
+//////////////////////////////////////////////////////////////////////////
+
+ezJSONDocument::ezJSONDocument() = default;
+ezJSONDocument::~ezJSONDocument() = default;
+
+ezResult ezJSONDocument::Parse(ezStringView sJson, ezLogInterface* pLog)
+{
+  m_OwnedSource.Clear();
+  m_sSource = sJson;
+
+  return ParseSource(pLog);
+}
+
+ezResult ezJSONDocument::Parse(ezStreamReader& ref_input, ezLogInterface* pLog)
+{
+  m_OwnedSource.Clear();
+  ezStreamUtils::ReadAllAndAppend(ref_input, m_OwnedSource);
+
+  m_sSource = ezStringView(reinterpret_cast<const char*>(m_OwnedSource.GetData()), m_OwnedSource.GetCount());
+
+  return ParseSource(pLog);
+}
+
+void ezJSONDocument::Clear()
+{
+  m_sSource = {};
+  m_OwnedSource.Clear();
+  m_StructuralIndices.Clear();
+  m_Nodes.Clear();
+  m_StringBuffer.Clear();
+}
+
+ezJSONDocument::Value ezJSONDocument::GetRoot() const
+{
+  if (m_Nodes.IsEmpty())
+    return Value();
+
+  return Value(this, 0);
+}
+
+ezResult ezJSONDocument::ParseSource(ezLogInterface* pLog)
+{
+  m_pLogInterface = pLog;
+  m_StructuralIndices.Clear();
+  m_Nodes.Clear();
+  m_StringBuffer.Clear();
+
+  const char* pStart = m_sSource.GetStartPointer();
+  const ezUInt32 uiSize = m_sSource.GetElementCount();
+
+  if (uiSize >= 3 && static_cast<ezUInt8>(pStart[0]) == 0xEF && static_cast<ezUInt8>(pStart[1]) == 0xBB && static_cast<ezUInt8>(pStart[2]) == 0xBF)
+  {
+    m_sSource = ezStringView(pStart + 3, uiSize - 3);
+  }
+
+  if (FindStructuralCharacters().Failed() || BuildNodes().Failed())
+  {
+    m_Nodes.Clear();
+    m_StringBuffer.Clear();
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONDocument::FindStructuralCharacters()
+{
+  const char* pSource = m_sSource.GetStartPointer();
+  const ezUInt32 uiSize = m_sSource.GetElementCount();
+
+  // the expected number of structural characters, the array grows when a document is denser than that
+  m_StructuralIndices.SetCountUninitialized(ezMath::Max(uiSize / 6, 64u) + 64);
+  ezUInt32 uiNumIndices = 0;
+
+  ezUInt64 uiEscapeCarry = 0;
+  ezUInt64 uiInStringCarry = 0;
+  ezUInt64 uiAtomCarry = 0;
+  ezUInt64 uiNonAscii = 0;
+
+  char tail[64];
+
+  for (ezUInt32 uiBlockStart = 0; uiBlockStart < uiSize; uiBlockStart += 64)
+  {
+    const char* pBlock = pSource + uiBlockStart;
+
+    if (uiSize - uiBlockStart < 64)
+    {
+      // pad the last block with whitespace, which doesn't affect anything
+      ezMemoryUtils::PatternFillArray(tail, static_cast<ezUInt8>(' '));
+      ezMemoryUtils::Copy(tail, pBlock, uiSize - uiBlockStart);
+      pBlock = tail;
+    }
+
+    CharacterMasks masks;
+    ClassifyBlock(pBlock, masks);
+
+    const ezUInt64 uiEscaped = FindEscapedCharacters(masks.m_uiBackslash, uiEscapeCarry);
+    const ezUInt64 uiQuote = masks.m_uiQuote & ~uiEscaped;
+
+    // includes the opening quote, but not the closing one
+    const ezUInt64 uiInString = PrefixXor(uiQuote) ^ uiInStringCarry;
+    uiInStringCarry = static_cast<ezUInt64>(static_cast<ezInt64>(uiInString) >> 63);
+
+    if ((masks.m_uiControl & uiInString) != 0)
+    {
+      ReportError(uiBlockStart + ezMath::FirstBitLow(masks.m_uiControl & uiInString), "Control characters must be escaped in strings");
+      return EZ_FAILURE;
+    }
+
+    // true, false, null and numbers are everything that is not whitespace, an operator or inside a string,
+    // for those only the first character is structural
+    const ezUInt64 uiOperator = masks.m_uiOperator & ~uiInString;
+    const ezUInt64 uiAtom = ~(uiOperator | masks.m_uiWhitespace | uiQuote | uiInString);
+    const ezUInt64 uiAtomStart = uiAtom & ~((uiAtom << 1) | uiAtomCarry);
+    uiAtomCarry = uiAtom >> 63;
+
+    uiNonAscii |= masks.m_uiNonAscii;
+
+    // both the opening and the closing quotes are structural, so that the end of a string is known without searching for it
+    ezUInt64 uiStructural = uiOperator | uiQuote | uiAtomStart;
+
+    if (uiNumIndices + 64 > m_StructuralIndices.GetCount())
+    {
+      m_StructuralIndices.SetCountUninitialized(m_StructuralIndices.GetCount() * 2);
+    }
+
+    ezUInt32* pIndices = m_StructuralIndices.GetData() + uiNumIndices;
+
+    while (uiStructural != 0)
+    {
+      *pIndices = uiBlockStart + ezMath::FirstBitLow(uiStructural);
+      ++pIndices;
+      uiStructural &= uiStructural - 1;
+    }
+
+    uiNumIndices = static_cast<ezUInt32>(pIndices - m_StructuralIndices.GetData());
+  }
+
+  m_StructuralIndices.SetCountUninitialized(uiNumIndices);
+
+  if (uiInStringCarry != 0)
+  {
+    ReportError(uiSize, "Unterminated string");
+    return EZ_FAILURE;
+  }
+
+  if (uiNonAscii != 0 && !ezUnicodeUtils::IsValidUtf8(pSource, pSource + uiSize))
+  {
+    ReportError(0, "The document is not valid UTF-8");
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONDocument::BuildNodes()
+{
+  const char* pSource = m_sSource.GetStartPointer();
+  const ezUInt32 uiSize = m_sSource.GetElementCount();
+  const ezUInt32* pIndices = m_StructuralIndices.GetData();
+  const ezUInt32 uiNumIndices = m_StructuralIndices.GetCount();
+
+  if (uiNumIndices == 0)
+  {
+    ReportError(0, "The document is empty");
+    return EZ_FAILURE;
+  }
+
+  // most values take at least two structural characters (the value and the separator after it)
+  m_Nodes.Reserve(uiNumIndices / 2 + 1);
+
+  struct Scope
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiNode;
+    ezUInt32 m_uiCount;
+    bool m_bObject;
+  };
+
+  ezHybridArray<Scope, 64> scopes;
+
+  enum class State
+  {
+    Value,
+    MemberName,
+    AfterValue,
+  };
+
+  State state = State::Value;
+  ezUInt32 uiNext = 0;
+  ezStringBuilder sError;
+
+  while (true)
+  {
+    switch (state)
+    {
+      case State::Value:
+      {
+        if (uiNext == uiNumIndices)
+        {
+          ReportError(uiSize, "Unexpected end of document, expected a value");
+          return EZ_FAILURE;
+        }
+
+        const ezUInt32 uiPos = pIndices[uiNext++];
+        const char c = pSource[uiPos];
+
+        switch (c)
+        {
+          case '{':
+          case '[':
+          {
+            const bool bObject = (c == '{');
+
+            Node& node = m_Nodes.ExpandAndGetRef();
+            node.m_Type = bObject ? ValueType::Object : ValueType::Array;
+            node.m_uiFlags = 0;
+            node.m_uiPadding = 0;
+            node.m_uiOffset = m_Nodes.GetCount();
+            node.m_uiLength = 0;
+
+            if (uiNext < uiNumIndices && pSource[pIndices[uiNext]] == (bObject ? '}' : ']'))
+            {
+              ++uiNext;
+              state = State::AfterValue;
+              break;
+            }
+
+            if (scopes.GetCount() == s_uiMaxNestingDepth)
+            {
+              ReportError(uiPos, "The document is nested too deeply");
+              return EZ_FAILURE;
+            }
+
+            scopes.PushBack({m_Nodes.GetCount() - 1, 0, bObject});
+            state = bObject ? State::MemberName : State::Value;
+            break;
+          }
+
+          case '"':
+            // the closing quote is always the next structural character, unterminated strings were already rejected
+            EZ_SUCCEED_OR_RETURN(ParseString(uiPos + 1, pIndices[uiNext++]));
+            state = State::AfterValue;
+            break;
+
+          case '}':
+          case ']':
+          case ',':
+          case ':':
+            sError.Format("Unexpected '{0}', expected a value", ezArgC(c));
+            ReportError(uiPos, sError);
+            return EZ_FAILURE;
+
+          default:
+            EZ_SUCCEED_OR_RETURN(ParseAtom(uiPos));
+            state = State::AfterValue;
+            break;
+        }
+        break;
+      }
+
+      case State::MemberName:
+      {
+        if (uiNext == uiNumIndices)
+        {
+          ReportError(uiSize, "Unexpected end of document, expected a member name");
+          return EZ_FAILURE;
+        }
+
+        const ezUInt32 uiPos = pIndices[uiNext++];
+
+        if (pSource[uiPos] != '"')
+        {
+          ReportError(uiPos, "Expected a member name in double quotes");
+          return EZ_FAILURE;
+        }
+
+        EZ_SUCCEED_OR_RETURN(ParseString(uiPos + 1, pIndices[uiNext++]));
+
+        if (uiNext == uiNumIndices || pSource[pIndices[uiNext]] != ':')
+        {
+          ReportError(uiNext < uiNumIndices ? pIndices[uiNext] : uiSize, "Expected ':' after the member name");
+          return EZ_FAILURE;
+        }
+
+        ++uiNext;
+        state = State::Value;
+        break;
+      }
+
+      case State::AfterValue:
+      {
+        if (scopes.IsEmpty())
+        {
+          if (uiNext != uiNumIndices)
+          {
+            ReportError(pIndices[uiNext], "Unexpected content after the end of the document");
+            return EZ_FAILURE;
+          }
+
+          return EZ_SUCCESS;
+        }
+
+        Scope& scope = scopes.PeekBack();
+        ++scope.m_uiCount;
+
+        const char cClose = scope.m_bObject ? '}' : ']';
+
+        if (uiNext == uiNumIndices)
+        {
+          sError.Format("Unexpected end of document, expected ',' or '{0}'", ezArgC(cClose));
+          ReportError(uiSize, sError);
+          return EZ_FAILURE;
+        }
+
+        const ezUInt32 uiPos = pIndices[uiNext++];
+        const char c = pSource[uiPos];
+
+        if (c == ',')
+        {
+          state = scope.m_bObject ? State::MemberName : State::Value;
+        }
+        else if (c == cClose)
+        {
+          Node& node = m_Nodes[scope.m_uiNode];
+          node.m_uiOffset = m_Nodes.GetCount();
+          node.m_uiLength = scope.m_uiCount;
+          scopes.PopBack();
+        }
+        else
+        {
+          sError.Format("Expected ',' or '{0}'", ezArgC(cClose));
+          ReportError(uiPos, sError);
+          return EZ_FAILURE;
+        }
+        break;
+      }
+    }
+  }
+}
+
+ezResult ezJSONDocument::ParseString(ezUInt32 uiStart, ezUInt32 uiEnd)
+{
+  const char* pSource = m_sSource.GetStartPointer();
+  const char* pIn = pSource + uiStart;
+  const char* pEnd = pSource + uiEnd;
+
+  Node& node = m_Nodes.ExpandAndGetRef();
+  node.m_Type = ValueType::String;
+  node.m_uiFlags = 0;
+  node.m_uiPadding = 0;
+  node.m_uiOffset = uiStart;
+  node.m_uiLength = uiEnd - uiStart;
+
+  const char* pBackslash = static_cast<const char*>(memchr(pIn, '\\', pEnd - pIn));
+
+  if (pBackslash == nullptr)
+    return EZ_SUCCESS;
+
+  // decoding never makes a string longer
+  const ezUInt32 uiBufferStart = m_StringBuffer.GetCount();
+  m_StringBuffer.SetCountUninitialized(uiBufferStart + node.m_uiLength);
+  char* pOut = m_StringBuffer.GetData() + uiBufferStart;
+
+  while (pIn < pEnd)
+  {
+    if (pBackslash == nullptr)
+      pBackslash = pEnd;
+
+    ezMemoryUtils::Copy(pOut, pIn, pBackslash - pIn);
+    pOut += pBackslash - pIn;
+    pIn = pBackslash;
+
+    if (pIn == pEnd)
+      break;
+
+    // the closing quote can't be escaped, so there is always a character after the backslash
+    const char* pEscape = pIn;
+    pIn += 2;
+
+    switch (pEscape[1])
+    {
+      case '"':
+      case '\\':
+      case '/':
+        *pOut++ = pEscape[1];
+        break;
+      case 'b':
+        *pOut++ = '\b';
+        break;
+      case 'f':
+        *pOut++ = '\f';
+        break;
+      case 'n':
+        *pOut++ = '\n';
+        break;
+      case 'r':
+        *pOut++ = '\r';
+        break;
+      case 't':
+        *pOut++ = '\t';
+        break;
+
+      case 'u':
+      {
+        ezUInt32 uiCodePoint = 0;
+        if (!ParseHex4(pIn, pEnd, uiCodePoint))
+        {
+          ReportError(static_cast<ezUInt32>(pEscape - pSource), "Invalid \\u escape sequence, expected four hex digits");
+          return EZ_FAILURE;
+        }
+
+        pIn += 4;
+
+        if (uiCodePoint >= 0xD800 && uiCodePoint <= 0xDBFF)
+        {
+          ezUInt32 uiLowSurrogate = 0;
+          if (pEnd - pIn < 6 || pIn[0] != '\\' || pIn[1] != 'u' || !ParseHex4(pIn + 2, pEnd, uiLowSurrogate) || uiLowSurrogate < 0xDC00 || uiLowSurrogate > 0xDFFF)
+          {
+            ReportError(static_cast<ezUInt32>(pEscape - pSource), "Unpaired UTF-16 high surrogate in \\u escape sequence");
+            return EZ_FAILURE;
+          }
+
+          pIn += 6;
+          uiCodePoint = 0x10000 + ((uiCodePoint - 0xD800) << 10) + (uiLowSurrogate - 0xDC00);
+        }
+        else if (uiCodePoint >= 0xDC00 && uiCodePoint <= 0xDFFF)
+        {
+          ReportError(static_cast<ezUInt32>(pEscape - pSource), "Unpaired UTF-16 low surrogate in \\u escape sequence");
+          return EZ_FAILURE;
+        }
+
+        ezUnicodeUtils::EncodeUtf32ToUtf8(uiCodePoint, pOut);
+        break;
+      }
+
+      default:
+      {
+        ezStringBuilder sError;
+        sError.Format("Invalid escape sequence '\\{0}'", ezArgC(pEscape[1]));
+        ReportError(static_cast<ezUInt32>(pEscape - pSource), sError);
+        return EZ_FAILURE;
+      }
+    }
+
+    pBackslash = static_cast<const char*>(memchr(pIn, '\\', pEnd - pIn));
+  }
+
+  node.m_uiFlags = NodeFlags::StringInBuffer;
+  node.m_uiOffset = uiBufferStart;
+  node.m_uiLength = static_cast<ezUInt32>(pOut - (m_StringBuffer.GetData() + uiBufferStart));
+  m_StringBuffer.SetCountUninitialized(uiBufferStart + node.m_uiLength);
+
+  return EZ_SUCCESS;
+}
+
+ezResult ezJSONDocument::ParseAtom(ezUInt32 uiStart)
+{
+  const char* pStart = m_sSource.GetStartPointer() + uiStart;
+  const char* pSourceEnd = m_sSource.GetEndPointer();
+
+  const char* pEnd = pStart;
+  while (pEnd < pSourceEnd && IsAtomCharacter(*pEnd))
+    ++pEnd;
+
+  const ezStringView sAtom(pStart, pEnd);
+
+  Node& node = m_Nodes.ExpandAndGetRef();
+  node.m_uiFlags = 0;
+  node.m_uiPadding = 0;
+  node.m_uiOffset = 0;
+  node.m_uiLength = 0;
+
+  bool bInteger = false;
+
+  if (sAtom == "true" || sAtom == "false")
+  {
+    node.m_Type = ValueType::Bool;
+    node.m_uiOffset = (sAtom == "true") ? 1 : 0;
+  }
+  else if (sAtom == "null")
+  {
+    node.m_Type = ValueType::Null;
+  }
+  else if (IsValidNumber(pStart, pEnd, bInteger))
+  {
+    node.m_Type = ValueType::Number;
+    node.m_uiFlags = bInteger ? NodeFlags::IntegerNumber : 0;
+    node.m_uiOffset = uiStart;
+    node.m_uiLength = sAtom.GetElementCount();
+  }
+  else
+  {
+    ezStringBuilder sError;
+    sError.Format("Invalid value '{0}'", sAtom);
+    ReportError(uiStart, sError);
+    return EZ_FAILURE;
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezJSONDocument::ReportError(ezUInt32 uiOffset, ezStringView sMessage)
+{
+  // line and column are only needed for errors, so they are computed here instead of being tracked while parsing
+  const char* pSource = m_sSource.GetStartPointer();
+  ezUInt32 uiLine = 1;
+  ezUInt32 uiLineStart = 0;
+
+  for (ezUInt32 i = 0; i < uiOffset; ++i)
+  {
+    if (pSource[i] == '\n')
+    {
+      ++uiLine;
+      uiLineStart = i + 1;
+    }
+  }
+
+  ezLog::Error(m_pLogInterface, "Line {0} ({1}): {2}", uiLine, uiOffset - uiLineStart + 1, sMessage);
+}
+
+ezUInt32 ezJSONDocument::GetNextNode(ezUInt32 uiNode) const
+{
+  const Node& node = m_Nodes[uiNode];
+
+  if (node.m_Type == ValueType::Array || node.m_Type == ValueType::Object)
+    return node.m_uiOffset;
+
+  return uiNode + 1;
+}
+
+ezStringView ezJSONDocument::GetNodeText(const Node& node) const
+{
+  if ((node.m_uiFlags & NodeFlags::StringInBuffer) != 0)
+    return ezStringView(m_StringBuffer.GetData() + node.m_uiOffset, node.m_uiLength);
+
+  return ezStringView(m_sSource.GetStartPointer() + node.m_uiOffset, node.m_uiLength);
+}
+
+ezVariant ezJSONDocument::ConvertToVariant(ezUInt32 uiNode) const
+{
+  const Node& node = m_Nodes[uiNode];
+
+  switch (node.m_Type)
+  {
+    case ValueType::Bool:
+      return ezVariant(node.m_uiOffset != 0);
+
+    case ValueType::Number:
+      return ezVariant(Value(this, uiNode).GetNumber());
+
+    case ValueType::String:
+      return ezVariant(ezString(GetNodeText(node)));
+
+    case ValueType::Array:
+    {
+      ezVariant result = ezVariantArray();
+      ezVariantArray& elements = result.GetWritable<ezVariantArray>();
+      elements.Reserve(node.m_uiLength);
+
+      for (ezUInt32 uiElement = uiNode + 1; uiElement < node.m_uiOffset; uiElement = GetNextNode(uiElement))
+      {
+        elements.PushBack(ConvertToVariant(uiElement));
+      }
+
+      return result;
+    }
+
+    case ValueType::Object:
+    {
+      ezVariant result = ezVariantDictionary();
+      ezVariantDictionary& members = result.GetWritable<ezVariantDictionary>();
+      members.Reserve(node.m_uiLength);
+
+      for (ezUInt32 uiName = uiNode + 1; uiName < node.m_uiOffset; uiName = GetNextNode(uiName + 1))
+      {
+        members[GetNodeText(m_Nodes[uiName])] = ConvertToVariant(uiName + 1);
+      }
+
+      return result;
+    }
+
+    default:
+      return ezVariant();
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezJSONDocument::ValueType::Enum ezJSONDocument::Value::GetType() const
+{
+  if (m_pDocument == nullptr)
+    return ValueType::Invalid;
+
+  return m_pDocument->m_Nodes[m_uiNode].m_Type;
+}
+
+bool ezJSONDocument::Value::GetBool(bool bDefault) const
+{
+  if (!IsBool())
+    return bDefault;
+
+  return m_pDocument->m_Nodes[m_uiNode].m_uiOffset != 0;
+}
+
+double ezJSONDocument::Value::GetNumber(double fDefault) const
+{
+  if (!IsNumber())
+    return fDefault;
+
+  double fResult = 0.0;
+  if (ezConversionUtils::StringToFloat(GetNumberText(), fResult).Failed())
+    return fDefault;
+
+  return fResult;
+}
+
+ezInt64 ezJSONDocument::Value::GetInt64(ezInt64 iDefault) const
+{
+  if (!IsNumber())
+    return iDefault;
+
+  if ((m_pDocument->m_Nodes[m_uiNode].m_uiFlags & NodeFlags::IntegerNumber) != 0)
+  {
+    ezInt64 iResult = 0;
+    if (ezConversionUtils::StringToInt64(GetNumberText(), iResult).Succeeded())
+      return iResult;
+  }
+
+  // fractions, exponents and integers that don't fit into 64 bits
+  const double fValue = ezMath::Clamp(GetNumber(static_cast<double>(iDefault)), -9.2e18, 9.2e18);
+  return static_cast<ezInt64>(fValue);
+}
+
+ezStringView ezJSONDocument::Value::GetString() const
+{
+  if (!IsString())
+    return {};
+
+  return m_pDocument->GetNodeText(m_pDocument->m_Nodes[m_uiNode]);
+}
+
+ezStringView ezJSONDocument::Value::GetNumberText() const
+{
+  if (!IsNumber())
+    return {};
+
+  return m_pDocument->GetNodeText(m_pDocument->m_Nodes[m_uiNode]);
+}
+
+ezUInt32 ezJSONDocument::Value::GetCount() const
+{
+  if (!IsArray() && !IsObject())
+    return 0;
+
+  return m_pDocument->m_Nodes[m_uiNode].m_uiLength;
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::GetElement(ezUInt32 uiIndex) const
+{
+  if (!IsArray() || uiIndex >= GetCount())
+    return Value();
+
+  ezUInt32 uiElement = m_uiNode + 1;
+
+  for (ezUInt32 i = 0; i < uiIndex; ++i)
+  {
+    uiElement = m_pDocument->GetNextNode(uiElement);
+  }
+
+  return Value(m_pDocument, uiElement);
+}
+
+ezJSONDocument::Value ezJSONDocument::Value::FindMember(ezStringView sName) const
+{
+  if (!IsObject())
+    return Value();
+
+  Value result;
+  const ezUInt32 uiEnd = m_pDocument->m_Nodes[m_uiNode].m_uiOffset;
+
+  for (ezUInt32 uiName = m_uiNode + 1; uiName < uiEnd; uiName = m_pDocument->GetNextNode(uiName + 1))
+  {
+    if (m_pDocument->GetNodeText(m_pDocument->m_Nodes[uiName]) == sName)
+    {
+      result = Value(m_pDocument, uiName + 1);
+    }
+  }
+
+  return result;
+}
+
+ezJSONDocument::Range<ezJSONDocument::ElementIterator> ezJSONDocument::Value::GetElements() const
+{
+  Range<ElementIterator> range;
+  range.m_Begin.m_pDocument = m_pDocument;
+  range.m_End.m_pDocument = m_pDocument;
+
+  if (IsArray())
+  {
+    range.m_Begin.m_uiNode = m_uiNode + 1;
+    range.m_End.m_uiNode = m_pDocument->m_Nodes[m_uiNode].m_uiOffset;
+  }
+
+  return range;
+}
+
+ezJSONDocument::Range<ezJSONDocument::MemberIterator> ezJSONDocument::Value::GetMembers() const
+{
+  Range<MemberIterator> range;
+  range.m_Begin.m_pDocument = m_pDocument;
+  range.m_End.m_pDocument = m_pDocument;
+
+  if (IsObject())
+  {
+    range.m_Begin.m_uiNode = m_uiNode + 1;
+    range.m_End.m_uiNode = m_pDocument->m_Nodes[m_uiNode].m_uiOffset;
+  }
+
+  return range;
+}
+
+ezVariant ezJSONDocument::Value::ToVariant() const
+{
+  if (m_pDocument == nullptr)
+    return ezVariant();
+
+  return m_pDocument->ConvertToVariant(m_uiNode);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezJSONDocument::Value ezJSONDocument::ElementIterator::operator*() const
+{
+  return Value(m_pDocument, m_uiNode);
+}
+
+void ezJSONDocument::ElementIterator::operator++()
+{
+  m_uiNode = m_pDocument->GetNextNode(m_uiNode);
+}
+
+ezJSONDocument::Member ezJSONDocument::MemberIterator::operator*() const
+{
+  Member member;
+  member.m_sName = m_pDocument->GetNodeText(m_pDocument->m_Nodes[m_uiNode]);
+  member.m_Value = Value(m_pDocument, m_uiNode + 1);
+  return member;
+}
+
+void ezJSONDocument::MemberIterator::operator++()
+{
+  m_uiNode = m_pDocument->GetNextNode(m_uiNode + 1);
+}
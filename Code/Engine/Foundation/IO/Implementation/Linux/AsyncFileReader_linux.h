@@ -0,0 +1,410 @@
+#pragma once
+
+#include <Foundation/FoundationInternal.h>
+EZ_FOUNDATION_INTERNAL_HEADER
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+
+#  include <Foundation/IO/AsyncFileReader.h>
+#  include <Foundation/Logging/Log.h>
+
+#  include <errno.h>
+#  include <linux/io_uring.h>
+#  include <sys/mman.h>
+#  include <sys/syscall.h>
+#  include <sys/uio.h>
+#  include <unistd.h>
+
+/// Talks to the kernel directly through the io_uring syscalls, so that no additional library (liburing) is needed.
+struct ezAsyncFileReaderUring
+{
+  struct Slot
+  {
+    ezAsyncFileReadRequest m_Request;
+    ezUInt64 m_uiBytesRead = 0;
+    iovec m_IoVec;
+  };
+
+  ~ezAsyncFileReaderUring() { Shutdown(); }
+
+  static int Setup(unsigned int uiEntries, io_uring_params* pParams)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_setup, uiEntries, pParams));
+  }
+
+  static int Enter(int iRingFd, unsigned int uiToSubmit, unsigned int uiMinComplete, unsigned int uiFlags)
+  {
+    return static_cast<int>(syscall(__NR_io_uring_enter, iRingFd, uiToSubmit, uiMinComplete, uiFlags, nullptr, 0));
+  }
+
+  ezResult Initialize(int iFileFd, ezUInt64 uiFileSize, ezUInt32 uiQueueDepth)
+  {
+    m_iFileFd = iFileFd;
+    m_uiFileSize = uiFileSize;
+
+    io_uring_params params = {};
+    m_iRingFd = Setup(uiQueueDepth, &params);
+    if (m_iRingFd < 0)
+      return EZ_FAILURE;
+
+    m_uiSqRingSize = params.sq_off.array + params.sq_entries * sizeof(unsigned int);
+    m_uiCqRingSize = params.cq_off.cqes + params.cq_entries * sizeof(io_uring_cqe);
+
+    const bool bSingleMmap = (params.features & IORING_FEAT_SINGLE_MMAP) != 0;
+    if (bSingleMmap)
+    {
+      m_uiSqRingSize = ezMath::Max(m_uiSqRingSize, m_uiCqRingSize);
+      m_uiCqRingSize = m_uiSqRingSize;
+    }
+
+    m_pSqRing = mmap(nullptr, m_uiSqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQ_RING);
+    if (m_pSqRing == MAP_FAILED)
+    {
+      m_pSqRing = nullptr;
+      Shutdown();
+      return EZ_FAILURE;
+    }
+
+    if (bSingleMmap)
+    {
+      m_pCqRing = m_pSqRing;
+    }
+    else
+    {
+      m_pCqRing = mmap(nullptr, m_uiCqRingSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_CQ_RING);
+      if (m_pCqRing == MAP_FAILED)
+      {
+        m_pCqRing = nullptr;
+        Shutdown();
+        return EZ_FAILURE;
+      }
+    }
+
+    m_uiSqesSize = params.sq_entries * sizeof(io_uring_sqe);
+    m_pSqes = static_cast<io_uring_sqe*>(mmap(nullptr, m_uiSqesSize, PROT_READ | PROT_WRITE, MAP_SHARED | MAP_POPULATE, m_iRingFd, IORING_OFF_SQES));
+    if (m_pSqes == MAP_FAILED)
+    {
+      m_pSqes = nullptr;
+      Shutdown();
+      return EZ_FAILURE;
+    }
+
+    m_pSqTail = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pSqRing, params.sq_off.tail));
+    m_pSqMask = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pSqRing, params.sq_off.ring_mask));
+    m_pSqArray = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pSqRing, params.sq_off.array));
+    m_pCqHead = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pCqRing, params.cq_off.head));
+    m_pCqTail = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pCqRing, params.cq_off.tail));
+    m_pCqMask = static_cast<unsigned int*>(ezMemoryUtils::AddByteOffset(m_pCqRing, params.cq_off.ring_mask));
+    m_pCqes = static_cast<io_uring_cqe*>(ezMemoryUtils::AddByteOffset(m_pCqRing, params.cq_off.cqes));
+
+    // never have more reads in flight than there are submission entries, then the completion queue (which is at least as large) can't overflow
+    m_Slots.SetCount(params.sq_entries);
+    m_FreeSlots.Reserve(params.sq_entries);
+    for (ezUInt32 i = params.sq_entries; i > 0; --i)
+    {
+      m_FreeSlots.PushBack(i - 1);
+    }
+
+    return EZ_SUCCESS;
+  }
+
+  void Shutdown()
+  {
+    if (m_iRingFd < 0)
+      return;
+
+    // the kernel may still write into the user buffers, so wait until all reads that it accepted are done
+    while (m_uiNumInFlight > 0)
+    {
+      if (Enter(m_iRingFd, 0, 1, IORING_ENTER_GETEVENTS) < 0 && errno != EINTR)
+        break;
+
+      ReapCompletions();
+    }
+
+    if (m_pSqes != nullptr)
+      munmap(m_pSqes, m_uiSqesSize);
+    if (m_pCqRing != nullptr && m_pCqRing != m_pSqRing)
+      munmap(m_pCqRing, m_uiCqRingSize);
+    if (m_pSqRing != nullptr)
+      munmap(m_pSqRing, m_uiSqRingSize);
+
+    close(m_iRingFd);
+
+    m_iRingFd = -1;
+    m_pSqes = nullptr;
+    m_pCqRing = nullptr;
+    m_pSqRing = nullptr;
+    m_uiNumInFlight = 0;
+    m_uiNumUnsubmitted = 0;
+    m_Slots.Clear();
+    m_FreeSlots.Clear();
+    m_Resubmit.Clear();
+    m_Pending.Clear();
+    m_Completed.Clear();
+  }
+
+  void Submit(ezArrayPtr<const ezAsyncFileReadRequest> requests)
+  {
+    for (const ezAsyncFileReadRequest& req : requests)
+    {
+      m_Pending.PushBack(req);
+    }
+
+    SubmitPending(0);
+  }
+
+  ezUInt32 Poll(ezDynamicArray<ezAsyncFileReadResult>& out_results, ezUInt32 uiMinResults)
+  {
+    ReapCompletions();
+
+    while (true)
+    {
+      // fill up the free slots with queued requests and wait for completions in the same syscall
+      const ezUInt32 uiWaitFor = (m_Completed.GetCount() < uiMinResults) ? 1 : 0;
+      SubmitPending(uiWaitFor);
+
+      ReapCompletions();
+
+      // nothing left that could complete
+      if (m_Completed.GetCount() >= uiMinResults || (m_uiNumInFlight == 0 && m_uiNumUnsubmitted == 0 && m_Pending.IsEmpty() && m_Resubmit.IsEmpty()))
+        break;
+    }
+
+    const ezUInt32 uiNumResults = m_Completed.GetCount();
+    out_results.PushBackRange(m_Completed);
+    m_Completed.Clear();
+
+    return uiNumResults;
+  }
+
+private:
+  void SubmitPending(ezUInt32 uiWaitFor)
+  {
+    const unsigned int uiMask = *m_pSqMask;
+    unsigned int uiTail = *m_pSqTail;
+    unsigned int uiToSubmit = 0;
+
+    while (!m_Pending.IsEmpty() && !m_FreeSlots.IsEmpty())
+    {
+      const ezUInt32 uiSlot = m_FreeSlots.PeekBack();
+      m_FreeSlots.PopBack();
+
+      Slot& slot = m_Slots[uiSlot];
+      slot.m_Request = m_Pending.PeekFront();
+      slot.m_uiBytesRead = 0;
+      m_Pending.PopFront();
+
+      FillEntry(uiTail & uiMask, uiSlot);
+      ++uiTail;
+      ++uiToSubmit;
+    }
+
+    while (!m_Resubmit.IsEmpty())
+    {
+      FillEntry(uiTail & uiMask, m_Resubmit.PeekBack());
+      m_Resubmit.PopBack();
+      ++uiTail;
+      ++uiToSubmit;
+    }
+
+    // make the new entries visible to the kernel, before it reads the tail
+    __atomic_store_n(m_pSqTail, uiTail, __ATOMIC_RELEASE);
+
+    // entries that the kernel didn't take during the previous call are still in the ring
+    m_uiNumUnsubmitted += uiToSubmit;
+
+    if (m_uiNumUnsubmitted == 0 && (uiWaitFor == 0 || m_uiNumInFlight == 0))
+      return;
+
+    while (true)
+    {
+      const int res = Enter(m_iRingFd, m_uiNumUnsubmitted, uiWaitFor, uiWaitFor > 0 ? IORING_ENTER_GETEVENTS : 0);
+
+      if (res >= 0)
+      {
+        // only entries that the kernel accepted will ever complete
+        const unsigned int uiAccepted = ezMath::Min<unsigned int>(m_uiNumUnsubmitted, static_cast<unsigned int>(res));
+        m_uiNumUnsubmitted -= uiAccepted;
+        m_uiNumInFlight += uiAccepted;
+
+        // the kernel consumed all entries, or it can't take more right now
+        if (m_uiNumUnsubmitted == 0 || res == 0)
+          break;
+
+        uiWaitFor = 0;
+      }
+      else if (errno == EINTR)
+      {
+        continue;
+      }
+      else if ((errno == EAGAIN || errno == EBUSY) && m_uiNumInFlight > 0)
+      {
+        // the completion queue is full or the kernel is out of resources, both only get better once reads complete
+        const ezUInt32 uiNumInFlight = m_uiNumInFlight;
+        ReapCompletions();
+
+        if (m_uiNumInFlight == uiNumInFlight)
+        {
+          Enter(m_iRingFd, 0, 1, IORING_ENTER_GETEVENTS);
+          ReapCompletions();
+        }
+
+        uiWaitFor = 0;
+      }
+      else
+      {
+        ezLog::Error("io_uring_enter failed with error {}, failing all outstanding reads.", errno);
+        FailOutstanding();
+        break;
+      }
+    }
+
+    // nothing could be submitted and nothing will complete, so waiting for more would never end
+    if (m_uiNumUnsubmitted > 0 && m_uiNumInFlight == 0)
+    {
+      ezLog::Error("io_uring doesn't accept more reads, failing all outstanding reads.");
+      FailOutstanding();
+    }
+  }
+
+  void FillEntry(unsigned int uiEntry, ezUInt32 uiSlot)
+  {
+    Slot& slot = m_Slots[uiSlot];
+    slot.m_IoVec.iov_base = slot.m_Request.m_Buffer.GetPtr() + slot.m_uiBytesRead;
+    slot.m_IoVec.iov_len = slot.m_Request.m_Buffer.GetCount() - static_cast<ezUInt32>(slot.m_uiBytesRead);
+
+    io_uring_sqe& sqe = m_pSqes[uiEntry];
+    ezMemoryUtils::ZeroFill(&sqe, 1);
+    sqe.opcode = IORING_OP_READV;
+    sqe.fd = m_iFileFd;
+    sqe.off = slot.m_Request.m_uiOffset + slot.m_uiBytesRead;
+    sqe.addr = reinterpret_cast<ezUInt64>(&slot.m_IoVec);
+    sqe.len = 1;
+    sqe.user_data = uiSlot;
+
+    m_pSqArray[uiEntry] = uiEntry;
+  }
+
+  void CompleteSlot(ezUInt32 uiSlot, ezResult result)
+  {
+    const Slot& slot = m_Slots[uiSlot];
+
+    ezAsyncFileReadResult& res = m_Completed.ExpandAndGetRef();
+    res.m_uiUserData = slot.m_Request.m_uiUserData;
+    res.m_uiBytesRead = slot.m_uiBytesRead;
+    res.m_Result = result;
+
+    m_FreeSlots.PushBack(uiSlot);
+  }
+
+  /// \brief Fails all requests that the kernel hasn't accepted yet. Reads that are in flight complete normally.
+  void FailOutstanding()
+  {
+    // the kernel only looks at the tail when it is entered, so entries it didn't take can be removed again
+    unsigned int uiTail = *m_pSqTail;
+    for (; m_uiNumUnsubmitted > 0; --m_uiNumUnsubmitted)
+    {
+      --uiTail;
+      CompleteSlot(static_cast<ezUInt32>(m_pSqes[uiTail & *m_pSqMask].user_data), EZ_FAILURE);
+    }
+    __atomic_store_n(m_pSqTail, uiTail, __ATOMIC_RELEASE);
+
+    for (ezUInt32 uiSlot : m_Resubmit)
+    {
+      CompleteSlot(uiSlot, EZ_FAILURE);
+    }
+    m_Resubmit.Clear();
+
+    for (const ezAsyncFileReadRequest& req : m_Pending)
+    {
+      ezAsyncFileReadResult& res = m_Completed.ExpandAndGetRef();
+      res.m_uiUserData = req.m_uiUserData;
+      res.m_uiBytesRead = 0;
+      res.m_Result = EZ_FAILURE;
+    }
+    m_Pending.Clear();
+  }
+
+  ezUInt32 ReapCompletions()
+  {
+    ezUInt32 uiNumResults = 0;
+
+    const unsigned int uiMask = *m_pCqMask;
+    unsigned int uiHead = *m_pCqHead;
+
+    // the kernel writes the entries before it publishes the new tail
+    const unsigned int uiTail = __atomic_load_n(m_pCqTail, __ATOMIC_ACQUIRE);
+
+    for (; uiHead != uiTail; ++uiHead)
+    {
+      const io_uring_cqe& cqe = m_pCqes[uiHead & uiMask];
+      const ezUInt32 uiSlot = static_cast<ezUInt32>(cqe.user_data);
+      Slot& slot = m_Slots[uiSlot];
+
+      --m_uiNumInFlight;
+
+      bool bDone = true;
+      ezResult result = EZ_SUCCESS;
+
+      if (cqe.res == -EINTR || cqe.res == -EAGAIN)
+      {
+        bDone = false;
+      }
+      else if (cqe.res < 0)
+      {
+        result = EZ_FAILURE;
+      }
+      else if (cqe.res > 0)
+      {
+        slot.m_uiBytesRead += static_cast<ezUInt64>(cqe.res);
+
+        // short reads before the end of the file are allowed, the remainder needs to be requested again
+        if (slot.m_uiBytesRead < slot.m_Request.m_Buffer.GetCount() && slot.m_Request.m_uiOffset + slot.m_uiBytesRead < m_uiFileSize)
+          bDone = false;
+      }
+
+      if (!bDone)
+      {
+        m_Resubmit.PushBack(uiSlot);
+        continue;
+      }
+
+      CompleteSlot(uiSlot, result);
+      ++uiNumResults;
+    }
+
+    __atomic_store_n(m_pCqHead, uiHead, __ATOMIC_RELEASE);
+
+    return uiNumResults;
+  }
+
+  int m_iFileFd = -1;
+  int m_iRingFd = -1;
+  ezUInt64 m_uiFileSize = 0;
+  ezUInt32 m_uiNumInFlight = 0;
+  ezUInt32 m_uiNumUnsubmitted = 0;
+
+  void* m_pSqRing = nullptr;
+  void* m_pCqRing = nullptr;
+  io_uring_sqe* m_pSqes = nullptr;
+  size_t m_uiSqRingSize = 0;
+  size_t m_uiCqRingSize = 0;
+  size_t m_uiSqesSize = 0;
+
+  unsigned int* m_pSqTail = nullptr;
+  unsigned int* m_pSqMask = nullptr;
+  unsigned int* m_pSqArray = nullptr;
+  unsigned int* m_pCqHead = nullptr;
+  unsigned int* m_pCqTail = nullptr;
+  unsigned int* m_pCqMask = nullptr;
+  io_uring_cqe* m_pCqes = nullptr;
+
+  ezDynamicArray<Slot> m_Slots;
+  ezDynamicArray<ezUInt32> m_FreeSlots;
+  ezDynamicArray<ezUInt32> m_Resubmit;
+  ezDeque<ezAsyncFileReadRequest> m_Pending;
+  ezDynamicArray<ezAsyncFileReadResult> m_Completed; ///< Results that have not been returned through Poll() yet.
+};
+
+#endif
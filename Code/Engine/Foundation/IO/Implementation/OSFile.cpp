@@ -163,6 +163,31 @@ ezUInt64 ezOSFile::Read(void* pBuffer, ezUInt64 uiBytes)
   return Res;
 }
 
+ezUInt64 ezOSFile::ReadAt(void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiFileOffset)
+{
+  EZ_ASSERT_DEV(m_FileMode == ezFileOpenMode::Read, "The file is not opened for reading.");
+  EZ_ASSERT_DEV(pBuffer != nullptr, "pBuffer must not be nullptr.");
+
+  const ezTime t0 = ezTime::Now();
+
+  const ezUInt64 Res = InternalReadAt(pBuffer, uiBytes, uiFileOffset);
+
+  const ezTime t1 = ezTime::Now();
+  const ezTime tdiff = t1 - t0;
+
+  EventData e;
+  e.m_bSuccess = (Res == uiBytes);
+  e.m_Duration = tdiff;
+  e.m_iFileID = m_iFileID;
+  e.m_sFile = m_sFileName;
+  e.m_EventType = EventType::FileRead;
+  e.m_uiBytesAccessed = Res;
+
+  s_FileEvents.Broadcast(e);
+
+  return Res;
+}
+
 ezUInt64 ezOSFile::ReadAll(ezDynamicArray<ezUInt8>& out_fileContent)
 {
   EZ_ASSERT_DEV(m_FileMode == ezFileOpenMode::Read, "The file is not opened for reading.");
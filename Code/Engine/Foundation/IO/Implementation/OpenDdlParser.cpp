@@ -40,6 +40,9 @@ void ezOpenDdlParser::SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLin
   EZ_ASSERT_DEV(m_StateStack.IsEmpty(), "OpenDDL Parser cannot be restarted");
 
   m_pInput = &stream;
+  m_InputBuffer.SetCountUninitialized(s_uiInputBufferSize);
+  m_uiInputBufferPos = 0;
+  m_uiInputBufferEnd = 0;
 
   m_bSkippingMode = false;
   m_uiCurLine = 1 + uiFirstLineOffset;
@@ -184,7 +187,12 @@ void ezOpenDdlParser::ParsingError(ezStringView sMessage, bool bFatal)
 
 void ezOpenDdlParser::ReadNextByte()
 {
-  m_pInput->ReadBytes(&m_uiNextByte, sizeof(ezUInt8));
+  // at the end of the stream m_uiNextByte keeps the value that the caller set
+  if (m_uiInputBufferPos < m_uiInputBufferEnd || FillInputBuffer())
+  {
+    m_uiNextByte = m_InputBuffer[m_uiInputBufferPos];
+    ++m_uiInputBufferPos;
+  }
 
   if (m_uiNextByte == '\n')
   {
@@ -195,6 +203,33 @@ void ezOpenDdlParser::ReadNextByte()
     ++m_uiCurColumn;
 }
 
+bool ezOpenDdlParser::FillInputBuffer()
+{
+  m_uiInputBufferPos = 0;
+  m_uiInputBufferEnd = static_cast<ezUInt32>(m_pInput->ReadBytes(m_InputBuffer.GetData(), m_InputBuffer.GetCount()));
+
+  return m_uiInputBufferEnd > 0;
+}
+
+void ezOpenDdlParser::SkipInputBufferTo(ezUInt32 uiPos)
+{
+  EZ_ASSERT_DEBUG(uiPos >= m_uiInputBufferPos && uiPos <= m_uiInputBufferEnd, "Invalid input buffer position");
+
+  // keep the line and column counters the same as if every byte was read through ReadNextByte()
+  for (ezUInt32 i = m_uiInputBufferPos; i < uiPos; ++i)
+  {
+    if (m_InputBuffer[i] == '\n')
+    {
+      ++m_uiCurLine;
+      m_uiCurColumn = 0;
+    }
+    else
+      ++m_uiCurColumn;
+  }
+
+  m_uiInputBufferPos = uiPos;
+}
+
 bool ezOpenDdlParser::ReadCharacter()
 {
   m_uiCurByte = m_uiNextByte;
@@ -890,6 +925,9 @@ void ezOpenDdlParser::ContinueInt()
   if (!ContinuePrimitiveList())
     return;
 
+  if (ContinueNumbersInBuffer())
+    return;
+
   ezInt8 sign = 1;
 
   // allow exactly one sign
@@ -1049,6 +1087,9 @@ void ezOpenDdlParser::ContinueFloat()
   if (!ContinuePrimitiveList())
     return;
 
+  if (ContinueNumbersInBuffer())
+    return;
+
   const auto curState = m_StateStack.PeekBack().m_State;
 
   float sign = 1;
@@ -1148,6 +1189,228 @@ void ezOpenDdlParser::ContinueFloat()
   }
 }
 
+namespace
+{
+  EZ_ALWAYS_INLINE bool IsDdlDigit(ezUInt8 c)
+  {
+    return c >= '0' && c <= '9';
+  }
+
+  EZ_ALWAYS_INLINE const ezUInt8* SkipDdlWhitespace(const ezUInt8* p, const ezUInt8* pEnd)
+  {
+    // same as ezStringUtils::IsWhiteSpace(), but inlined
+    while (p < pEnd && *p >= 1 && *p <= 32)
+      ++p;
+
+    return p;
+  }
+
+  /// \brief Accumulates a run of decimal digits into inout_uiValue and multiplies inout_uiScale by ten for every digit.
+  ///
+  /// Overflows wrap around, exactly like they do in ezOpenDdlParser::ReadDecimalLiteral() and ezConversionUtils::StringToFloat().
+  EZ_ALWAYS_INLINE const ezUInt8* ReadDdlDigits(const ezUInt8* p, const ezUInt8* pEnd, ezUInt64& inout_uiValue, ezUInt64& inout_uiScale)
+  {
+#if EZ_ENABLED(EZ_PLATFORM_LITTLE_ENDIAN)
+    // converts eight digits at once, with a few multiplications on a 64 bit register
+    while (pEnd - p >= 8)
+    {
+      ezUInt64 uiChunk;
+      memcpy(&uiChunk, p, 8);
+
+      // each byte has to be in the range '0' - '9'
+      if ((((uiChunk & 0xF0F0F0F0F0F0F0F0ull) | (((uiChunk + 0x0606060606060606ull) & 0xF0F0F0F0F0F0F0F0ull) >> 4)) != 0x3333333333333333ull))
+        break;
+
+      uiChunk -= 0x3030303030303030ull;
+      uiChunk = (uiChunk * 10) + (uiChunk >> 8);
+      uiChunk = (((uiChunk & 0x000000FF000000FFull) * 0x000F424000000064ull) + (((uiChunk >> 16) & 0x000000FF000000FFull) * 0x0000271000000001ull)) >> 32;
+
+      inout_uiValue = inout_uiValue * 100000000ull + (uiChunk & 0xFFFFFFFFull);
+      inout_uiScale *= 100000000ull;
+      p += 8;
+    }
+#endif
+
+    while (p < pEnd && IsDdlDigit(*p))
+    {
+      inout_uiValue = inout_uiValue * 10 + (*p - '0');
+      inout_uiScale *= 10;
+      ++p;
+    }
+
+    return p;
+  }
+} // namespace
+
+bool ezOpenDdlParser::ContinueNumbersInBuffer()
+{
+  // Large lists of numbers are converted directly from the input buffer, without going through ReadCharacterSkipComments() for every byte.
+  // Only the plain decimal notation is handled here. Whenever anything else shows up (comments, underscores, hex literals, errors, ...) or the
+  // buffer runs out, this stops at the last complete value and the regular code path continues from there, so that the results are identical.
+
+  // the current and the next byte have to be the last two bytes that were taken from the buffer
+  const ezUInt32 uiPos = m_uiInputBufferPos;
+  if (uiPos < 2 || m_InputBuffer[uiPos - 2] != m_uiCurByte || m_InputBuffer[uiPos - 1] != m_uiNextByte)
+    return false;
+
+  const State state = m_StateStack.PeekBack().m_State;
+  const bool bFloat = (state == State::ReadingFloat || state == State::ReadingDouble);
+  const bool bUnsigned = (state >= State::ReadingUInt8 && state <= State::ReadingUInt64);
+  const ezUInt32 uiCacheSize = m_Cache.GetCount();
+
+  const ezUInt8* const pBuffer = m_InputBuffer.GetData();
+  const ezUInt8* const pEnd = pBuffer + m_uiInputBufferEnd;
+  const ezUInt8* p = pBuffer + uiPos - 2;
+  const ezUInt8* pResume = nullptr;
+
+  while (true)
+  {
+    bool bNegative = false;
+    if (*p == '-' || *p == '+')
+    {
+      bNegative = (*p == '-');
+      ++p;
+    }
+
+    if (p >= pEnd || !IsDdlDigit(*p) || (bNegative && bUnsigned))
+      break;
+
+    ezUInt64 uiValue = 0;
+    ezUInt64 uiUnused = 1;
+    p = ReadDdlDigits(p, pEnd, uiValue, uiUnused);
+
+    double fValue = 0;
+
+    if (bFloat)
+    {
+      // same computation as ezConversionUtils::StringToFloat()
+      ezUInt64 uiFraction = 0;
+      ezUInt64 uiFractionDivisor = 1;
+
+      if (p < pEnd && *p == '.')
+      {
+        p = ReadDdlDigits(p + 1, pEnd, uiFraction, uiFractionDivisor);
+      }
+
+      fValue = (double)uiValue + (double)uiFraction / (double)uiFractionDivisor;
+
+      if (p < pEnd && (*p == 'e' || *p == 'E'))
+      {
+        ++p;
+
+        bool bExponentIsPositive = true;
+        if (p < pEnd && (*p == '-' || *p == '+'))
+        {
+          bExponentIsPositive = (*p == '+');
+          ++p;
+        }
+
+        ezUInt64 uiExponent = 0;
+        p = ReadDdlDigits(p, pEnd, uiExponent, uiUnused);
+
+        if (bExponentIsPositive)
+          fValue *= ezMath::Pow(10.0, (double)uiExponent);
+        else
+          fValue /= ezMath::Pow(10.0, (double)uiExponent);
+      }
+    }
+
+    // the value must be complete, so it has to be followed by a separator that is still inside the buffer
+    const ezUInt8* pNext = SkipDdlWhitespace(p, pEnd);
+    if (pNext >= pEnd || (pNext == p && *p != ',' && *p != '}'))
+      break;
+
+    if (*pNext == ',')
+      pNext = SkipDdlWhitespace(pNext + 1, pEnd);
+
+    // the regular code path must be able to continue at pNext, so it needs a look-ahead byte and must not be in the middle of a comment
+    if (pEnd - pNext < 2 || *pNext == '/')
+      break;
+
+    switch (state)
+    {
+      case ReadingInt8:
+        m_pInt8Cache[m_uiNumCachedPrimitives++] = (bNegative ? -1 : 1) * (ezInt8)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezInt8))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingInt16:
+        m_pInt16Cache[m_uiNumCachedPrimitives++] = (bNegative ? -1 : 1) * (ezInt16)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezInt16))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingInt32:
+        m_pInt32Cache[m_uiNumCachedPrimitives++] = (bNegative ? -1 : 1) * (ezInt32)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezInt32))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingInt64:
+        m_pInt64Cache[m_uiNumCachedPrimitives++] = (bNegative ? -1 : 1) * (ezInt64)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezInt64))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingUInt8:
+        m_pUInt8Cache[m_uiNumCachedPrimitives++] = (ezUInt8)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezUInt8))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingUInt16:
+        m_pUInt16Cache[m_uiNumCachedPrimitives++] = (ezUInt16)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezUInt16))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingUInt32:
+        m_pUInt32Cache[m_uiNumCachedPrimitives++] = (ezUInt32)uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezUInt32))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingUInt64:
+        m_pUInt64Cache[m_uiNumCachedPrimitives++] = uiValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(ezUInt64))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingFloat:
+        m_pFloatCache[m_uiNumCachedPrimitives++] = (bNegative ? -1.0f : 1.0f) * (float)fValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(float))
+          PurgeCachedPrimitives(false);
+        break;
+
+      case ReadingDouble:
+        m_pDoubleCache[m_uiNumCachedPrimitives++] = (bNegative ? -1.0f : 1.0f) * fValue;
+        if (m_uiNumCachedPrimitives >= uiCacheSize / sizeof(double))
+          PurgeCachedPrimitives(false);
+        break;
+
+      default:
+        EZ_ASSERT_NOT_IMPLEMENTED;
+        break;
+    }
+
+    pResume = pNext;
+    p = pNext;
+
+    if (*p != '-' && *p != '+' && !IsDdlDigit(*p))
+      break;
+  }
+
+  if (pResume == nullptr)
+    return false;
+
+  SkipInputBufferTo(static_cast<ezUInt32>(pResume - pBuffer) + 2);
+  m_uiCurByte = pResume[0];
+  m_uiNextByte = pResume[1];
+
+  return true;
+}
+
 void ezOpenDdlParser::ReadDecimalFloat()
 {
   m_uiTempStringLength = 0;
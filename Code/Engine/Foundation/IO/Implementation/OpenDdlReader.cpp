@@ -6,6 +6,7 @@ ezOpenDdlReader::ezOpenDdlReader()
 {
   m_pCurrentChunk = nullptr;
   m_uiBytesInChunkLeft = 0;
+  m_uiNextChunkSize = s_uiChunkSize;
 }
 
 ezOpenDdlReader::~ezOpenDdlReader()
@@ -23,14 +24,8 @@ ezResult ezOpenDdlReader::ParseDocument(ezStreamReader& inout_stream, ezUInt32 u
 
   m_TempCache.Reserve(s_uiChunkSize);
 
-  ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
-  pElement->m_pFirstChild = nullptr;
-  pElement->m_pLastChild = nullptr;
-  pElement->m_PrimitiveType = ezOpenDdlPrimitiveType::Custom;
-  pElement->m_pSiblingElement = nullptr;
+  ezOpenDdlReaderElement* pElement = new (AllocateBytes(sizeof(ezOpenDdlReaderElement))) ezOpenDdlReaderElement();
   pElement->m_sCustomType = CopyString("root");
-  pElement->m_sName = nullptr;
-  pElement->m_uiNumChildElements = 0;
 
   m_ObjectStack.PushBack(pElement);
 
@@ -47,7 +42,8 @@ const ezOpenDdlReaderElement* ezOpenDdlReader::GetRootElement() const
 
 const ezOpenDdlReaderElement* ezOpenDdlReader::FindElement(ezStringView sGlobalName) const
 {
-  return m_GlobalNames.GetValueOrDefault(sGlobalName, nullptr);
+  ezOpenDdlReaderElement* const* pElement = m_GlobalNames.GetValue(sGlobalName);
+  return pElement != nullptr ? *pElement : nullptr;
 }
 
 ezStringView ezOpenDdlReader::CopyString(const ezStringView& string)
@@ -55,21 +51,21 @@ ezStringView ezOpenDdlReader::CopyString(const ezStringView& string)
   if (string.IsEmpty())
     return {};
 
-  // no idea how to make this more efficient without running into lots of other problems
-  m_Strings.PushBack(string);
-  return m_Strings.PeekBack();
+  // strings are zero-terminated, even though the string views don't require it, it makes debugging easier
+  const ezUInt32 uiLength = string.GetElementCount();
+  char* szTarget = reinterpret_cast<char*>(AllocateBytes(uiLength + 1));
+  ezMemoryUtils::Copy(szTarget, string.GetStartPointer(), uiLength);
+  szTarget[uiLength] = '\0';
+
+  return ezStringView(szTarget, uiLength);
 }
 
 ezOpenDdlReaderElement* ezOpenDdlReader::CreateElement(ezOpenDdlPrimitiveType type, ezStringView sType, ezStringView sName, bool bGlobalName)
 {
-  ezOpenDdlReaderElement* pElement = &m_Elements.ExpandAndGetRef();
-  pElement->m_pFirstChild = nullptr;
-  pElement->m_pLastChild = nullptr;
+  ezOpenDdlReaderElement* pElement = new (AllocateBytes(sizeof(ezOpenDdlReaderElement))) ezOpenDdlReaderElement();
   pElement->m_PrimitiveType = type;
-  pElement->m_pSiblingElement = nullptr;
   pElement->m_sCustomType = sType;
   pElement->m_sName = CopyString(sName);
-  pElement->m_uiNumChildElements = 0;
 
   if (bGlobalName)
   {
@@ -78,7 +74,7 @@ ezOpenDdlReaderElement* ezOpenDdlReader::CreateElement(ezOpenDdlPrimitiveType ty
 
   if (bGlobalName && !sName.IsEmpty())
   {
-    m_GlobalNames[sName] = pElement;
+    m_GlobalNames[pElement->m_sName] = pElement;
   }
 
   ezOpenDdlReaderElement* pParent = m_ObjectStack.PeekBack();
@@ -243,7 +239,6 @@ void ezOpenDdlReader::OnParsingError(ezStringView sMessage, bool bFatal, ezUInt3
   {
     m_ObjectStack.Clear();
     m_GlobalNames.Clear();
-    m_Elements.Clear();
 
     ClearDataChunks();
   }
@@ -259,6 +254,9 @@ void ezOpenDdlReader::ClearDataChunks()
   }
 
   m_DataChunks.Clear();
+  m_pCurrentChunk = nullptr;
+  m_uiBytesInChunkLeft = 0;
+  m_uiNextChunkSize = s_uiChunkSize;
 }
 
 ezUInt8* ezOpenDdlReader::AllocateBytes(ezUInt32 uiNumBytes)
@@ -266,7 +264,7 @@ ezUInt8* ezOpenDdlReader::AllocateBytes(ezUInt32 uiNumBytes)
   uiNumBytes = ezMemoryUtils::AlignSize(uiNumBytes, static_cast<ezUInt32>(EZ_ALIGNMENT_MINIMUM));
 
   // if the requested data is very large, just allocate it as an individual chunk
-  if (uiNumBytes > s_uiChunkSize / 2)
+  if (uiNumBytes > m_uiNextChunkSize / 2)
   {
     ezUInt8* pResult = EZ_DEFAULT_NEW_ARRAY(ezUInt8, uiNumBytes).GetPtr();
     m_DataChunks.PushBack(pResult);
@@ -274,11 +272,14 @@ ezUInt8* ezOpenDdlReader::AllocateBytes(ezUInt32 uiNumBytes)
   }
 
   // if our current chunk is too small, discard the remaining free bytes and just allocate a new chunk
+  // every new chunk is twice as large as the previous one, so that large documents only need a few allocations
   if (m_uiBytesInChunkLeft < uiNumBytes)
   {
-    m_pCurrentChunk = EZ_DEFAULT_NEW_ARRAY(ezUInt8, s_uiChunkSize).GetPtr();
-    m_uiBytesInChunkLeft = s_uiChunkSize;
+    m_pCurrentChunk = EZ_DEFAULT_NEW_ARRAY(ezUInt8, m_uiNextChunkSize).GetPtr();
+    m_uiBytesInChunkLeft = m_uiNextChunkSize;
     m_DataChunks.PushBack(m_pCurrentChunk);
+
+    m_uiNextChunkSize = ezMath::Min(m_uiNextChunkSize * 2, s_uiMaxChunkSize);
   }
 
   // no fulfill the request from the current chunk
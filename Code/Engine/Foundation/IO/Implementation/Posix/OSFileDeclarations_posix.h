@@ -1,6 +1,7 @@
 #pragma once
 
 #include <Foundation/Basics.h>
+#include <Foundation/Containers/Set.h>
 
 // Deactivate Doxygen document generation for the following block.
 /// \cond
@@ -19,6 +20,17 @@ struct ezFileIterationData
   // This is storing DIR*, which we can't forward declare
   ezHybridArray<void*, 16> m_Handles;
   ezString m_wildcardSearch;
+
+  struct FolderId
+  {
+    ezUInt64 m_uiDevice = 0;
+    ezUInt64 m_uiInode = 0;
+
+    bool operator<(const FolderId& other) const { return m_uiDevice < other.m_uiDevice || (m_uiDevice == other.m_uiDevice && m_uiInode < other.m_uiInode); }
+  };
+
+  // Only filled when following symlinks, to detect cycles
+  ezSet<FolderId> m_VisitedFolders;
 };
 
 #endif
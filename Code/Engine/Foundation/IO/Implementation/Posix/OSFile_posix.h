@@ -220,6 +220,41 @@ ezUInt64 ezOSFile::InternalRead(void* pBuffer, ezUInt64 uiBytes)
   return uiBytesRead;
 }
 
+ezUInt64 ezOSFile::InternalReadAt(void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiFileOffset) const
+{
+  ezUInt64 uiBytesRead = 0;
+
+#if EZ_ENABLED(EZ_USE_OLD_POSIX_FUNCTIONS)
+  // there is no positional read, so serialize all calls and restore the file position afterwards
+  static ezMutex s_ReadAtMutex;
+  EZ_LOCK(s_ReadAtMutex);
+
+  const ezUInt64 uiPrevPosition = InternalGetFilePosition();
+  InternalSetFilePosition(static_cast<ezInt64>(uiFileOffset), ezFileSeekMode::FromStart);
+  uiBytesRead = fread(pBuffer, 1, static_cast<size_t>(uiBytes), m_FileData.m_pFileHandle);
+  InternalSetFilePosition(static_cast<ezInt64>(uiPrevPosition), ezFileSeekMode::FromStart);
+#else
+  const int fd = fileno(m_FileData.m_pFileHandle);
+  const ezUInt64 uiBatchBytes = 1024 * 1024 * 1024; // 1 GB
+
+  while (uiBytesRead < uiBytes)
+  {
+    const ezUInt64 uiReadThisTime = ezMath::Min(uiBytes - uiBytesRead, uiBatchBytes);
+    const ssize_t res = pread(fd, ezMemoryUtils::AddByteOffset(pBuffer, uiBytesRead), static_cast<size_t>(uiReadThisTime), static_cast<off_t>(uiFileOffset + uiBytesRead));
+
+    if (res < 0 && errno == EINTR)
+      continue;
+
+    if (res <= 0)
+      break;
+
+    uiBytesRead += static_cast<ezUInt64>(res);
+  }
+#endif
+
+  return uiBytesRead;
+}
+
 ezUInt64 ezOSFile::InternalGetFilePosition() const
 {
 #if EZ_ENABLED(EZ_USE_OLD_POSIX_FUNCTIONS)
@@ -489,7 +524,7 @@ bool ezFileSystemIterator::IsValid() const
 
 namespace
 {
-  ezResult UpdateCurrentFile(ezFileStats& curFile, const ezStringBuilder& curPath, DIR* hSearch, const ezString& wildcardSearch)
+  ezResult UpdateCurrentFile(ezFileStats& curFile, const ezStringBuilder& curPath, DIR* hSearch, const ezString& wildcardSearch, bool bFollowSymlinks)
   {
     struct dirent* hCurrentFile = readdir(hSearch);
     if (hCurrentFile == nullptr)
@@ -508,17 +543,53 @@ namespace
     ezStringBuilder absFileName = curPath;
     absFileName.AppendPath(hCurrentFile->d_name);
 
+    bool bIsLink = hCurrentFile->d_type == DT_LNK;
+
+    // d_type is DT_UNKNOWN on some file systems
+    if (hCurrentFile->d_type == DT_UNKNOWN)
+    {
+      struct stat linkStat = {};
+      bIsLink = lstat(absFileName.GetData(), &linkStat) == 0 && S_ISLNK(linkStat.st_mode);
+    }
+
+    // fails for broken links, those are reported as empty files
     struct stat fileStat = {};
-    stat(absFileName.GetData(), &fileStat);
+    const bool bHasStat = stat(absFileName.GetData(), &fileStat) == 0;
+
+    if (!bHasStat)
+      curFile.m_bIsDirectory = false;
+    else if (bIsLink)
+      curFile.m_bIsDirectory = bFollowSymlinks && S_ISDIR(fileStat.st_mode);
+    else if (hCurrentFile->d_type == DT_UNKNOWN)
+      curFile.m_bIsDirectory = S_ISDIR(fileStat.st_mode);
+    else
+      curFile.m_bIsDirectory = hCurrentFile->d_type == DT_DIR;
 
-    curFile.m_uiFileSize = fileStat.st_size;
-    curFile.m_bIsDirectory = hCurrentFile->d_type == DT_DIR;
+    curFile.m_uiFileSize = bHasStat ? fileStat.st_size : 0;
     curFile.m_sParentPath = curPath;
     curFile.m_sName = hCurrentFile->d_name;
-    curFile.m_LastModificationTime.SetInt64(fileStat.st_mtime, ezSIUnitOfTime::Second);
+    curFile.m_LastModificationTime.SetInt64(bHasStat ? fileStat.st_mtime : 0, ezSIUnitOfTime::Second);
 
     return EZ_SUCCESS;
   }
+
+  /// \brief Returns false if the folder can't be accessed or was entered before, which happens when symlinks form a cycle.
+  bool MarkFolderAsVisited(ezFileIterationData& ref_data, const ezStringBuilder& sPath)
+  {
+    struct stat folderStat = {};
+    if (stat(sPath.GetData(), &folderStat) != 0)
+      return false;
+
+    ezFileIterationData::FolderId id;
+    id.m_uiDevice = static_cast<ezUInt64>(folderStat.st_dev);
+    id.m_uiInode = static_cast<ezUInt64>(folderStat.st_ino);
+
+    if (ref_data.m_VisitedFolders.Contains(id))
+      return false;
+
+    ref_data.m_VisitedFolders.Insert(id);
+    return true;
+  }
 } // namespace
 
 void ezFileSystemIterator::StartSearch(ezStringView sSearchTerm, ezBitflags<ezFileSystemIteratorFlags> flags /*= ezFileSystemIteratorFlags::All*/)
@@ -560,12 +631,18 @@ void ezFileSystemIterator::StartSearch(ezStringView sSearchTerm, ezBitflags<ezFi
 
   m_Flags = flags;
 
+  m_Data.m_VisitedFolders.Clear();
+  if (m_Flags.IsSet(ezFileSystemIteratorFlags::FollowSymlinks))
+  {
+    MarkFolderAsVisited(m_Data, m_sCurPath);
+  }
+
   DIR* hSearch = opendir(m_sCurPath.GetData());
 
   if (hSearch == nullptr)
     return;
 
-  if (UpdateCurrentFile(m_CurFile, m_sCurPath, hSearch, m_Data.m_wildcardSearch).Failed())
+  if (UpdateCurrentFile(m_CurFile, m_sCurPath, hSearch, m_Data.m_wildcardSearch, m_Flags.IsSet(ezFileSystemIteratorFlags::FollowSymlinks)).Failed())
   {
     return;
   }
@@ -605,11 +682,17 @@ ezInt32 ezFileSystemIterator::InternalNext()
 
   if (m_Flags.IsSet(ezFileSystemIteratorFlags::Recursive) && m_CurFile.m_bIsDirectory && (m_CurFile.m_sName != "..") && (m_CurFile.m_sName != "."))
   {
+    const bool bFollowSymlinks = m_Flags.IsSet(ezFileSystemIteratorFlags::FollowSymlinks);
+
     m_sCurPath.AppendPath(m_CurFile.m_sName.GetData());
 
-    DIR* hSearch = opendir(m_sCurPath.GetData());
+    DIR* hSearch = nullptr;
+    if (!bFollowSymlinks || MarkFolderAsVisited(m_Data, m_sCurPath))
+    {
+      hSearch = opendir(m_sCurPath.GetData());
+    }
 
-    if (hSearch != nullptr && UpdateCurrentFile(m_CurFile, m_sCurPath, hSearch, m_Data.m_wildcardSearch).Succeeded())
+    if (hSearch != nullptr && UpdateCurrentFile(m_CurFile, m_sCurPath, hSearch, m_Data.m_wildcardSearch, bFollowSymlinks).Succeeded())
     {
       m_Data.m_Handles.PushBack(hSearch);
 
@@ -630,10 +713,20 @@ ezInt32 ezFileSystemIterator::InternalNext()
       return EZ_SUCCESS;
     }
 
+    if (hSearch != nullptr)
+    {
+      closedir(hSearch);
+    }
+
     // if the recursion did not work, just iterate in this folder further
+    m_sCurPath.PathParentDirectory();
+    if (m_sCurPath.GetElementCount() > 1 && m_sCurPath.EndsWith("/"))
+    {
+      m_sCurPath.Shrink(0, 1);
+    }
   }
 
-  if (UpdateCurrentFile(m_CurFile, m_sCurPath, (DIR*)m_Data.m_Handles.PeekBack(), m_Data.m_wildcardSearch).Failed())
+  if (UpdateCurrentFile(m_CurFile, m_sCurPath, (DIR*)m_Data.m_Handles.PeekBack(), m_Data.m_wildcardSearch, m_Flags.IsSet(ezFileSystemIteratorFlags::FollowSymlinks)).Failed())
   {
     // nothing found in this directory anymore
     closedir((DIR*)m_Data.m_Handles.PeekBack());
@@ -192,6 +192,35 @@ ezUInt64 ezOSFile::InternalRead(void* pBuffer, ezUInt64 uiBytes)
   return uiBytesRead;
 }
 
+ezUInt64 ezOSFile::InternalReadAt(void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiFileOffset) const
+{
+  ezUInt64 uiBytesRead = 0;
+
+  const ezUInt32 uiBatchBytes = 1024 * 1024 * 1024; // 1 GB
+
+  while (uiBytesRead < uiBytes)
+  {
+    const ezUInt64 uiOffset = uiFileOffset + uiBytesRead;
+
+    // a read with an OVERLAPPED structure on a synchronous handle reads from the given offset, but it still moves the file pointer
+    OVERLAPPED overlapped = {};
+    overlapped.Offset = static_cast<DWORD>(uiOffset & 0xFFFFFFFFu);
+    overlapped.OffsetHigh = static_cast<DWORD>(uiOffset >> 32);
+
+    const DWORD uiReadThisTime = static_cast<DWORD>(ezMath::Min<ezUInt64>(uiBytes - uiBytesRead, uiBatchBytes));
+    DWORD uiBytesReadThisTime = 0;
+    if (!ReadFile(m_FileData.m_pFileHandle, ezMemoryUtils::AddByteOffset(pBuffer, uiBytesRead), uiReadThisTime, &uiBytesReadThisTime, &overlapped))
+      return uiBytesRead + uiBytesReadThisTime;
+
+    uiBytesRead += uiBytesReadThisTime;
+
+    if (uiBytesReadThisTime != uiReadThisTime)
+      break;
+  }
+
+  return uiBytesRead;
+}
+
 ezUInt64 ezOSFile::InternalGetFilePosition() const
 {
   long int uiHigh32 = 0;
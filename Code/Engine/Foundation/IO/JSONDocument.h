@@ -0,0 +1,239 @@
+#pragma once
+
+#include <Foundation/Basics.h>
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Logging/Log.h>
+#include <Foundation/Types/Variant.h>
+
+class ezStreamReader;
+
+/// \brief Parses an entire JSON document at once into a flat, read-only representation that can be queried on demand.
+///
+/// ezJSONReader builds a tree of ezVariantDictionary and ezVariantArray objects, which allocates and copies a lot for large documents.
+/// ezJSONDocument instead stores the whole document in one array of small nodes, in document order, where every array and object
+/// knows where it ends, so that whole sub-trees can be skipped in constant time. Strings and numbers reference the source text
+/// directly, only strings that contain escape sequences are decoded into a separate buffer. Numbers are only converted when they are
+/// accessed. Parsing therefore does not allocate anything per value.
+///
+/// The structural characters of the document are located with SIMD instructions, 64 bytes at a time, where available.
+///
+/// The parser is strict and follows RFC 8259: the top-level element may be any value, but comments and superfluous commas,
+/// which ezJSONParser tolerates, are reported as errors.
+///
+/// Code that works with ezJSONReader::GetTopLevelObject() can switch over by calling GetRoot().ToVariant(),
+/// code that only reads parts of a document should access the values directly through ezJSONDocument::Value.
+class EZ_FOUNDATION_DLL ezJSONDocument
+{
+  EZ_DISALLOW_COPY_AND_ASSIGN(ezJSONDocument);
+
+public:
+  struct ValueType
+  {
+    using StorageType = ezUInt8;
+
+    enum Enum : ezUInt8
+    {
+      Invalid,
+      Null,
+      Bool,
+      Number,
+      String,
+      Array,
+      Object,
+
+      Default = Invalid
+    };
+  };
+
+  class Value;
+  struct Member;
+
+  /// \brief Iterates over the elements of an array. Returned by Value::GetElements().
+  class EZ_FOUNDATION_DLL ElementIterator
+  {
+  public:
+    Value operator*() const;
+    void operator++();
+    bool operator!=(const ElementIterator& rhs) const { return m_uiNode != rhs.m_uiNode; }
+
+  private:
+    friend class Value;
+    const ezJSONDocument* m_pDocument = nullptr;
+    ezUInt32 m_uiNode = 0;
+  };
+
+  /// \brief Iterates over the members of an object. Returned by Value::GetMembers().
+  class EZ_FOUNDATION_DLL MemberIterator
+  {
+  public:
+    Member operator*() const;
+    void operator++();
+    bool operator!=(const MemberIterator& rhs) const { return m_uiNode != rhs.m_uiNode; }
+
+  private:
+    friend class Value;
+    const ezJSONDocument* m_pDocument = nullptr;
+    ezUInt32 m_uiNode = 0;
+  };
+
+  /// \brief A begin/end pair, so that elements and members can be iterated with range based for loops.
+  template <typename ITERATOR>
+  struct Range
+  {
+    ITERATOR begin() const { return m_Begin; }
+    ITERATOR end() const { return m_End; }
+
+    ITERATOR m_Begin;
+    ITERATOR m_End;
+  };
+
+  /// \brief A lightweight handle to a value inside an ezJSONDocument.
+  ///
+  /// Values are only valid as long as the document they come from is not parsed again or destroyed.
+  /// Accessing a value with the wrong type or a member that does not exist never fails, it returns an invalid value or
+  /// the provided default instead, so chains like doc.GetRoot()["a"]["b"][3].GetNumber() don't need checks in between.
+  class EZ_FOUNDATION_DLL Value
+  {
+  public:
+    Value() = default;
+
+    /// \brief Returns false for values that don't exist, e.g. the result of FindMember() when there is no such member.
+    bool IsValid() const { return m_pDocument != nullptr; }
+
+    ValueType::Enum GetType() const;
+
+    bool IsNull() const { return GetType() == ValueType::Null; }
+    bool IsBool() const { return GetType() == ValueType::Bool; }
+    bool IsNumber() const { return GetType() == ValueType::Number; }
+    bool IsString() const { return GetType() == ValueType::String; }
+    bool IsArray() const { return GetType() == ValueType::Array; }
+    bool IsObject() const { return GetType() == ValueType::Object; }
+
+    /// \brief Returns the boolean or bDefault, if this is not a bool.
+    bool GetBool(bool bDefault = false) const;
+
+    /// \brief Converts the number text to a double, or returns fDefault, if this is not a number.
+    double GetNumber(double fDefault = 0.0) const;
+
+    /// \brief Converts the number text to an integer, or returns iDefault, if this is not a number.
+    ///
+    /// Numbers with a fraction or an exponent are converted through double and truncated.
+    ezInt64 GetInt64(ezInt64 iDefault = 0) const;
+
+    /// \brief Returns the decoded string, or an empty string, if this is not a string.
+    ///
+    /// The returned view is not zero-terminated and points into the source text or into the document.
+    ezStringView GetString() const;
+
+    /// \brief Returns the text of a number exactly as it appears in the document, or an empty string, if this is not a number.
+    ezStringView GetNumberText() const;
+
+    /// \brief Returns the number of elements of an array or members of an object, zero for all other values.
+    ezUInt32 GetCount() const;
+
+    /// \brief Returns the array element with the given index or an invalid value. This has to skip all previous elements.
+    Value GetElement(ezUInt32 uiIndex) const;
+
+    /// \brief Returns the value of the object member with the given name or an invalid value.
+    ///
+    /// Members are searched linearly. When a name appears multiple times, the last occurrence is returned,
+    /// which matches what ezJSONReader stores.
+    Value FindMember(ezStringView sName) const;
+
+    Value operator[](ezUInt32 uiIndex) const { return GetElement(uiIndex); }
+    Value operator[](ezStringView sName) const { return FindMember(sName); }
+
+    /// \brief Allows to iterate over all elements of an array. The range is empty for all other values.
+    Range<ElementIterator> GetElements() const;
+
+    /// \brief Allows to iterate over all members of an object, in document order. The range is empty for all other values.
+    Range<MemberIterator> GetMembers() const;
+
+    /// \brief Converts this value and everything below it into the same ezVariant structure that ezJSONReader creates.
+    ///
+    /// Objects become ezVariantDictionary, arrays ezVariantArray, numbers double, strings ezString and null an invalid ezVariant.
+    ezVariant ToVariant() const;
+
+  private:
+    friend class ezJSONDocument;
+
+    Value(const ezJSONDocument* pDocument, ezUInt32 uiNode)
+      : m_pDocument(pDocument)
+      , m_uiNode(uiNode)
+    {
+    }
+
+    const ezJSONDocument* m_pDocument = nullptr;
+    ezUInt32 m_uiNode = 0;
+  };
+
+  /// \brief A single member of an object.
+  struct Member
+  {
+    ezStringView m_sName;
+    Value m_Value;
+  };
+
+  ezJSONDocument();
+  ~ezJSONDocument();
+
+  /// \brief Parses the given text. Returns EZ_FAILURE and logs an error with line and column, if the text is not valid JSON.
+  ///
+  /// The document references \a sJson, so the text must stay alive and unmodified as long as the document is used.
+  /// A UTF-8 BOM at the start is skipped.
+  ezResult Parse(ezStringView sJson, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem());
+
+  /// \brief Reads the entire stream and parses it. The document keeps its own copy of the data.
+  ezResult Parse(ezStreamReader& ref_input, ezLogInterface* pLog = ezLog::GetThreadLocalLogSystem());
+
+  /// \brief Resets the document to the empty state.
+  void Clear();
+
+  /// \brief Returns the top-level value. Invalid, if parsing failed or nothing was parsed yet.
+  Value GetRoot() const;
+
+  /// \brief Returns the number of nodes in the document, which is the number of values plus the number of object member names.
+  ezUInt32 GetNodeCount() const { return m_Nodes.GetCount(); }
+
+private:
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ValueType::Enum m_Type;
+    ezUInt8 m_uiFlags;
+    ezUInt16 m_uiPadding;
+
+    /// String and Number: byte offset into the source (or the string buffer). Bool: the value.
+    /// Array and Object: index of the first node after the container.
+    ezUInt32 m_uiOffset;
+
+    /// String and Number: length in bytes. Array and Object: number of elements or members.
+    ezUInt32 m_uiLength;
+  };
+
+  enum NodeFlags : ezUInt8
+  {
+    StringInBuffer = EZ_BIT(0),
+    IntegerNumber = EZ_BIT(1),
+  };
+
+  ezResult ParseSource(ezLogInterface* pLog);
+  ezResult FindStructuralCharacters();
+  ezResult BuildNodes();
+  ezResult ParseString(ezUInt32 uiStart, ezUInt32 uiEnd);
+  ezResult ParseAtom(ezUInt32 uiStart);
+  void ReportError(ezUInt32 uiOffset, ezStringView sMessage);
+
+  ezUInt32 GetNextNode(ezUInt32 uiNode) const;
+  ezStringView GetNodeText(const Node& node) const;
+  ezVariant ConvertToVariant(ezUInt32 uiNode) const;
+
+  ezLogInterface* m_pLogInterface = nullptr;
+
+  ezStringView m_sSource;
+  ezDynamicArray<ezUInt8> m_OwnedSource;
+  ezDynamicArray<ezUInt32> m_StructuralIndices;
+  ezDynamicArray<Node> m_Nodes;
+  ezDynamicArray<char> m_StringBuffer;
+};
@@ -70,6 +70,12 @@ struct ezFileSystemIteratorFlags
     ReportFiles = EZ_BIT(1),
     ReportFolders = EZ_BIT(2),
 
+    /// \brief Also recurses into folders that are reached through symbolic links.
+    ///
+    /// Every folder is only entered once, so links that form a cycle are skipped. Without this flag, links are reported as files on POSIX platforms.
+    /// On Windows, links to folders are always treated as folders.
+    FollowSymlinks = EZ_BIT(3),
+
     ReportFilesRecursive = Recursive | ReportFiles,
     ReportFoldersRecursive = Recursive | ReportFolders,
     ReportFilesAndFoldersRecursive = Recursive | ReportFiles | ReportFolders,
@@ -82,6 +88,7 @@ struct ezFileSystemIteratorFlags
     StorageType Recursive : 1;
     StorageType ReportFiles : 1;
     StorageType ReportFolders : 1;
+    StorageType FollowSymlinks : 1;
   };
 };
 
@@ -189,6 +196,13 @@ public:
   /// \brief Reads up to the given number of bytes from the file. Returns the actual number of bytes that was read.
   ezUInt64 Read(void* pBuffer, ezUInt64 uiBytes); // [tested]
 
+  /// \brief Reads up to the given number of bytes, starting at the given position in the file. Returns the actual number of bytes that was read.
+  ///
+  /// The current file position is not used. On POSIX platforms it is not modified either, but on Windows it is moved to the end of the
+  /// data that was read, so don't rely on the file position after calling this. This function may be called from multiple threads at
+  /// the same time, but must not be mixed with concurrent calls to Read(), Write() or SetFilePosition().
+  ezUInt64 ReadAt(void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiFileOffset); // [tested]
+
   /// \brief Reads the entire file content into the given array
   ezUInt64 ReadAll(ezDynamicArray<ezUInt8>& out_fileContent); // [tested]
 
@@ -358,6 +372,7 @@ private:
   void InternalClose();
   ezResult InternalWrite(const void* pBuffer, ezUInt64 uiBytes);
   ezUInt64 InternalRead(void* pBuffer, ezUInt64 uiBytes);
+  ezUInt64 InternalReadAt(void* pBuffer, ezUInt64 uiBytes, ezUInt64 uiFileOffset) const;
   ezUInt64 InternalGetFilePosition() const;
   void InternalSetFilePosition(ezInt64 iDistance, ezFileSeekMode::Enum Pos) const;
 
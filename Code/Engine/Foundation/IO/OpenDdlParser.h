@@ -52,6 +52,9 @@ protected:
   void SetCacheSize(ezUInt32 uiSizeInKB);
 
   /// \brief Configures the parser to read from the given stream. This can only be called once on a parser instance.
+  ///
+  /// The stream is read in blocks, so the parser may read further ahead than it has parsed.
+  /// Therefore the stream should not be read from anymore, once parsing has started.
   void SetInputStream(ezStreamReader& stream, ezUInt32 uiFirstLineOffset = 0); // [tested]
 
   /// \brief Call this to parse the next piece of the document. This may trigger a callback through which data is returned.
@@ -161,6 +164,8 @@ private:
   };
 
   void ReadNextByte();
+  bool FillInputBuffer();
+  void SkipInputBufferTo(ezUInt32 uiPos);
   bool ReadCharacter();
   bool ReadCharacterSkipComments();
   void SkipWhitespace();
@@ -176,12 +181,19 @@ private:
   void ContinueBool();
   void ContinueInt();
   void ContinueFloat();
+  bool ContinueNumbersInBuffer();
 
   void ReadDecimalFloat();
   void ReadHexString();
 
   ezHybridArray<DdlState, 32> m_StateStack;
   ezStreamReader* m_pInput;
+
+  static const ezUInt32 s_uiInputBufferSize = 1024 * 16;
+
+  ezDynamicArray<ezUInt8> m_InputBuffer;
+  ezUInt32 m_uiInputBufferPos = 0;
+  ezUInt32 m_uiInputBufferEnd = 0;
   ezDynamicArray<ezUInt8> m_Cache;
 
   static const ezUInt32 s_uiMaxIdentifierLength = 64;
@@ -2,6 +2,7 @@
 
 #include <Foundation/Basics.h>
 #include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Containers/Map.h>
 #include <Foundation/IO/OpenDdlParser.h>
 #include <Foundation/Logging/Log.h>
@@ -114,6 +115,9 @@ private:
 };
 
 /// \brief An OpenDDL reader parses an entire DDL document and creates an in-memory representation of the document structure.
+///
+/// All elements, names and primitive data are stored in a few large memory blocks that are owned by the reader,
+/// so the number of allocations does not grow with the number of elements in the document.
 class EZ_FOUNDATION_DLL ezOpenDdlReader : public ezOpenDdlParser
 {
 public:
@@ -170,18 +174,17 @@ protected:
   void ClearDataChunks();
   ezUInt8* AllocateBytes(ezUInt32 uiNumBytes);
 
-  static const ezUInt32 s_uiChunkSize = 1000 * 4; // 4 KiB
+  static const ezUInt32 s_uiChunkSize = 1000 * 4;          // 4 KiB
+  static const ezUInt32 s_uiMaxChunkSize = 1024 * 1024 * 2; // 2 MiB, chunks double in size up to this
 
   ezHybridArray<ezUInt8*, 16> m_DataChunks;
   ezUInt8* m_pCurrentChunk;
   ezUInt32 m_uiBytesInChunkLeft;
+  ezUInt32 m_uiNextChunkSize;
 
   ezDynamicArray<ezUInt8> m_TempCache;
 
-  ezDeque<ezOpenDdlReaderElement> m_Elements;
   ezHybridArray<ezOpenDdlReaderElement*, 16> m_ObjectStack;
 
-  ezDeque<ezString> m_Strings;
-
-  ezMap<ezString, ezOpenDdlReaderElement*> m_GlobalNames;
+  ezHashTable<ezStringView, ezOpenDdlReaderElement*> m_GlobalNames;
 };
@@ -0,0 +1,116 @@
+#pragma once
+
+namespace ezInternal
+{
+  /// \brief Returns a mask with all bits set in the first N components, as used by the AVX masked loads and stores.
+  template <int N>
+  EZ_ALWAYS_INLINE __m256i GetOctLoadMask()
+  {
+    static_assert(N >= 1 && N <= 8, "Invalid number of components");
+    return _mm256_cmpgt_epi32(_mm256_set1_epi32(N), _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7));
+  }
+} // namespace ezInternal
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b()
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_castsi256_ps(_mm256_set1_epi32(b ? -1 : 0));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(ezInternal::OctBool b)
+{
+  m_v = b;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_castsi256_ps(_mm256_setr_epi32(b0 ? -1 : 0, b1 ? -1 : 0, b2 ? -1 : 0, b3 ? -1 : 0, b4 ? -1 : 0, b5 ? -1 : 0, b6 ? -1 : 0, b7 ? -1 : 0));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(const ezSimdVec4b& vLow, const ezSimdVec4b& vHigh)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_insertf128_ps(_mm256_castps128_ps256(vLow.m_v), vHigh.m_v, 1);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::GetComponent() const
+{
+  return (_mm256_movemask_ps(m_v) & EZ_BIT(N)) != 0;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetLow() const
+{
+  return _mm256_castps256_ps128(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetHigh() const
+{
+  return _mm256_extractf128_ps(m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator&&(const ezSimdVec8b& rhs) const
+{
+  return _mm256_and_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator||(const ezSimdVec8b& rhs) const
+{
+  return _mm256_or_ps(m_v, rhs.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!() const
+{
+  return _mm256_xor_ps(m_v, _mm256_castsi256_ps(_mm256_set1_epi32(-1)));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator==(const ezSimdVec8b& rhs) const
+{
+  return !(*this != rhs);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!=(const ezSimdVec8b& rhs) const
+{
+  return _mm256_xor_ps(m_v, rhs.m_v);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AllSet() const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(m_v) & mask) == mask;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AnySet() const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(m_v) & mask) != 0;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::NoneSet() const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(m_v) & mask) == 0;
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec8b::GetMask() const
+{
+  return static_cast<ezUInt32>(_mm256_movemask_ps(m_v));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::Select(const ezSimdVec8b& vCmp, const ezSimdVec8b& vTrue, const ezSimdVec8b& vFalse)
+{
+  return _mm256_blendv_ps(vFalse.m_v, vTrue.m_v, vCmp.m_v);
+}
@@ -0,0 +1,403 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f()
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  // Initialize all data to NaN in debug mode to find problems with uninitialized data easier.
+  m_v = _mm256_set1_ps(ezMath::NaN<float>());
+#endif
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float fAll)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_set1_ps(fAll);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdFloat& fAll)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_broadcastss_ps(fAll.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_setr_ps(f0, f1, f2, f3, f4, f5, f6, f7);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdVec4f& vLow, const ezSimdVec4f& vHigh)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_insertf128_ps(_mm256_castps128_ps256(vLow.m_v), vHigh.m_v, 1);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float fAll)
+{
+  m_v = _mm256_set1_ps(fAll);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7)
+{
+  m_v = _mm256_setr_ps(f0, f1, f2, f3, f4, f5, f6, f7);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::SetZero()
+{
+  m_v = _mm256_setzero_ps();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8f::Load(const float* pFloats)
+{
+  if constexpr (N == 8)
+  {
+    m_v = _mm256_loadu_ps(pFloats);
+  }
+  else
+  {
+    // masked out components are not accessed, so reading close to the end of a buffer is fine
+    m_v = _mm256_maskload_ps(pFloats, ezInternal::GetOctLoadMask<N>());
+  }
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8f::Store(float* pFloats) const
+{
+  if constexpr (N == 8)
+  {
+    _mm256_storeu_ps(pFloats, m_v);
+  }
+  else
+  {
+    _mm256_maskstore_ps(pFloats, ezInternal::GetOctLoadMask<N>(), m_v);
+  }
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::BITS_12>() const
+{
+  return _mm256_rcp_ps(m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::BITS_23>() const
+{
+  __m256 x0 = _mm256_rcp_ps(m_v);
+
+  // One Newton-Raphson iteration
+  __m256 x1 = _mm256_mul_ps(x0, _mm256_fnmadd_ps(m_v, x0, _mm256_set1_ps(2.0f)));
+
+  return x1;
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal<ezMathAcc::FULL>() const
+{
+  return _mm256_div_ps(_mm256_set1_ps(1.0f), m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::BITS_12>() const
+{
+  return _mm256_mul_ps(m_v, _mm256_rsqrt_ps(m_v));
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::BITS_23>() const
+{
+  __m256 x0 = _mm256_rsqrt_ps(m_v);
+
+  // One iteration of Newton-Raphson
+  __m256 x1 = _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x0), _mm256_fnmadd_ps(_mm256_mul_ps(m_v, x0), x0, _mm256_set1_ps(3.0f)));
+
+  return _mm256_mul_ps(m_v, x1);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt<ezMathAcc::FULL>() const
+{
+  return _mm256_sqrt_ps(m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::FULL>() const
+{
+  return _mm256_div_ps(_mm256_set1_ps(1.0f), _mm256_sqrt_ps(m_v));
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::BITS_23>() const
+{
+  const __m256 x0 = _mm256_rsqrt_ps(m_v);
+
+  // One iteration of Newton-Raphson
+  return _mm256_mul_ps(_mm256_mul_ps(_mm256_set1_ps(0.5f), x0), _mm256_fnmadd_ps(_mm256_mul_ps(m_v, x0), x0, _mm256_set1_ps(3.0f)));
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt<ezMathAcc::BITS_12>() const
+{
+  return _mm256_rsqrt_ps(m_v);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsZero() const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(_mm256_cmp_ps(m_v, _mm256_setzero_ps(), _CMP_EQ_OQ)) & mask) == mask;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsZero(const ezSimdFloat& fEpsilon) const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(_mm256_cmp_ps(Abs().m_v, _mm256_broadcastss_ps(fEpsilon.m_v), _CMP_LT_OQ)) & mask) == mask;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsNaN() const
+{
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(_mm256_cmp_ps(m_v, m_v, _CMP_UNORD_Q)) & mask) != 0;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsValid() const
+{
+  // Check the 8 exponent bits.
+  // NAN -> (exponent = all 1, mantissa = non-zero)
+  // INF -> (exponent = all 1, mantissa = zero)
+
+  const __m256 exponentMask = _mm256_castsi256_ps(_mm256_set1_epi32(0x7f800000));
+  const __m256 exponentNot1 = _mm256_castsi256_ps(_mm256_xor_si256(_mm256_cmpeq_epi32(_mm256_castps_si256(_mm256_and_ps(m_v, exponentMask)), _mm256_castps_si256(exponentMask)), _mm256_set1_epi32(-1)));
+
+  const int mask = EZ_BIT(N) - 1;
+  return (_mm256_movemask_ps(exponentNot1) & mask) == mask;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::GetComponent() const
+{
+  return _mm256_castps256_ps128(_mm256_permutevar8x32_ps(m_v, _mm256_set1_epi32(N)));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetLow() const
+{
+  return _mm256_castps256_ps128(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetHigh() const
+{
+  return _mm256_extractf128_ps(m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-() const
+{
+  return _mm256_sub_ps(_mm256_setzero_ps(), m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator+(const ezSimdVec8f& v) const
+{
+  return _mm256_add_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-(const ezSimdVec8f& v) const
+{
+  return _mm256_sub_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator*(const ezSimdFloat& f) const
+{
+  return _mm256_mul_ps(m_v, _mm256_broadcastss_ps(f.m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator/(const ezSimdFloat& f) const
+{
+  return _mm256_div_ps(m_v, _mm256_broadcastss_ps(f.m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMul(const ezSimdVec8f& v) const
+{
+  return _mm256_mul_ps(m_v, v.m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv<ezMathAcc::FULL>(const ezSimdVec8f& v) const
+{
+  return _mm256_div_ps(m_v, v.m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv<ezMathAcc::BITS_23>(const ezSimdVec8f& v) const
+{
+  return _mm256_mul_ps(m_v, v.GetReciprocal<ezMathAcc::BITS_23>().m_v);
+}
+
+template <>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv<ezMathAcc::BITS_12>(const ezSimdVec8f& v) const
+{
+  return _mm256_mul_ps(m_v, _mm256_rcp_ps(v.m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMin(const ezSimdVec8f& v) const
+{
+  return _mm256_min_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMax(const ezSimdVec8f& v) const
+{
+  return _mm256_max_ps(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Abs() const
+{
+  return _mm256_andnot_ps(_mm256_set1_ps(-0.0f), m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Round() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_NINT);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Floor() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_FLOOR);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Ceil() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_CEIL);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Trunc() const
+{
+  return _mm256_round_ps(m_v, _MM_FROUND_TRUNC);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::FlipSign(const ezSimdVec8b& vCmp) const
+{
+  return _mm256_xor_ps(m_v, _mm256_and_ps(vCmp.m_v, _mm256_set1_ps(-0.0f)));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Select(const ezSimdVec8b& vCmp, const ezSimdVec8f& vTrue, const ezSimdVec8f& vFalse)
+{
+  return _mm256_blendv_ps(vFalse.m_v, vTrue.m_v, vCmp.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator+=(const ezSimdVec8f& v)
+{
+  m_v = _mm256_add_ps(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator-=(const ezSimdVec8f& v)
+{
+  m_v = _mm256_sub_ps(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator*=(const ezSimdFloat& f)
+{
+  m_v = _mm256_mul_ps(m_v, _mm256_broadcastss_ps(f.m_v));
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator/=(const ezSimdFloat& f)
+{
+  m_v = _mm256_div_ps(m_v, _mm256_broadcastss_ps(f.m_v));
+  return *this;
+}
+
+// The predicates match the behavior of the SSE comparisons used by ezSimdVec4f, i.e. only != is true for NaN.
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator==(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_EQ_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator!=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_NEQ_UQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_LE_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_LT_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>=(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_GE_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>(const ezSimdVec8f& v) const
+{
+  return _mm256_cmp_ps(m_v, v.m_v, _CMP_GT_OQ);
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalSum() const
+{
+  __m128 a = _mm_add_ps(_mm256_castps256_ps128(m_v), _mm256_extractf128_ps(m_v, 1));
+  a = _mm_hadd_ps(a, a);
+  return _mm_hadd_ps(a, a);
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMin() const
+{
+  __m128 a = _mm_min_ps(_mm256_castps256_ps128(m_v), _mm256_extractf128_ps(m_v, 1));
+  __m128 xyxyzwzw = _mm_min_ps(_mm_shuffle_ps(a, a, EZ_TO_SHUFFLE(ezSwizzle::ZWXY)), a);
+  __m128 zwzwxyxy = _mm_shuffle_ps(xyxyzwzw, xyxyzwzw, EZ_TO_SHUFFLE(ezSwizzle::YXWZ));
+  return _mm_min_ps(xyxyzwzw, zwzwxyxy);
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMax() const
+{
+  __m128 a = _mm_max_ps(_mm256_castps256_ps128(m_v), _mm256_extractf128_ps(m_v, 1));
+  __m128 xyxyzwzw = _mm_max_ps(_mm_shuffle_ps(a, a, EZ_TO_SHUFFLE(ezSwizzle::ZWXY)), a);
+  __m128 zwzwxyxy = _mm_shuffle_ps(xyxyzwzw, xyxyzwzw, EZ_TO_SHUFFLE(ezSwizzle::YXWZ));
+  return _mm_max_ps(xyxyzwzw, zwzwxyxy);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmadd_ps(a.m_v, b.m_v, c.m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmadd_ps(a.m_v, _mm256_broadcastss_ps(b.m_v), c.m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmsub_ps(a.m_v, b.m_v, c.m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c)
+{
+  return _mm256_fmsub_ps(a.m_v, _mm256_broadcastss_ps(b.m_v), c.m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CopySign(const ezSimdVec8f& vMagnitude, const ezSimdVec8f& vSign)
+{
+  __m256 minusZero = _mm256_set1_ps(-0.0f);
+  return _mm256_or_ps(_mm256_andnot_ps(minusZero, vMagnitude.m_v), _mm256_and_ps(minusZero, vSign.m_v));
+}
@@ -0,0 +1,262 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i()
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+  m_v = _mm256_set1_epi32(0xCDCDCDCD);
+#endif
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInt32 iAll)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_set1_epi32(iAll);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(const ezSimdVec4i& vLow, const ezSimdVec4i& vHigh)
+{
+  EZ_CHECK_SIMD8_ALIGNMENT(this);
+
+  m_v = _mm256_inserti128_si256(_mm256_castsi128_si256(vLow.m_v), vHigh.m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInternal::OctInt v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::MakeZero()
+{
+  return _mm256_setzero_si256();
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Set(ezInt32 iAll)
+{
+  m_v = _mm256_set1_epi32(iAll);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Set(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7)
+{
+  m_v = _mm256_setr_epi32(i0, i1, i2, i3, i4, i5, i6, i7);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::SetZero()
+{
+  m_v = _mm256_setzero_si256();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8i::Load(const ezInt32* pInts)
+{
+  if constexpr (N == 8)
+  {
+    m_v = _mm256_loadu_si256(reinterpret_cast<const __m256i*>(pInts));
+  }
+  else
+  {
+    m_v = _mm256_maskload_epi32(reinterpret_cast<const int*>(pInts), ezInternal::GetOctLoadMask<N>());
+  }
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8i::Store(ezInt32* pInts) const
+{
+  if constexpr (N == 8)
+  {
+    _mm256_storeu_si256(reinterpret_cast<__m256i*>(pInts), m_v);
+  }
+  else
+  {
+    _mm256_maskstore_epi32(reinterpret_cast<int*>(pInts), ezInternal::GetOctLoadMask<N>(), m_v);
+  }
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8i::ToFloat() const
+{
+  return _mm256_cvtepi32_ps(m_v);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Truncate(const ezSimdVec8f& f)
+{
+  return _mm256_cvttps_epi32(f.m_v);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE ezInt32 ezSimdVec8i::GetComponent() const
+{
+  return _mm256_extract_epi32(m_v, N);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetLow() const
+{
+  return _mm256_castsi256_si128(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetHigh() const
+{
+  return _mm256_extracti128_si256(m_v, 1);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-() const
+{
+  return _mm256_sub_epi32(_mm256_setzero_si256(), m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator+(const ezSimdVec8i& v) const
+{
+  return _mm256_add_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-(const ezSimdVec8i& v) const
+{
+  return _mm256_sub_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMul(const ezSimdVec8i& v) const
+{
+  return _mm256_mullo_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator|(const ezSimdVec8i& v) const
+{
+  return _mm256_or_si256(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator&(const ezSimdVec8i& v) const
+{
+  return _mm256_and_si256(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator^(const ezSimdVec8i& v) const
+{
+  return _mm256_xor_si256(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator~() const
+{
+  return _mm256_xor_si256(m_v, _mm256_set1_epi32(-1));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator<<(ezUInt32 uiShift) const
+{
+  return _mm256_sll_epi32(m_v, _mm_cvtsi32_si128(uiShift));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator>>(ezUInt32 uiShift) const
+{
+  return _mm256_sra_epi32(m_v, _mm_cvtsi32_si128(uiShift));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator<<(const ezSimdVec8i& v) const
+{
+  return _mm256_sllv_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator>>(const ezSimdVec8i& v) const
+{
+  return _mm256_srav_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator+=(const ezSimdVec8i& v)
+{
+  m_v = _mm256_add_epi32(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator-=(const ezSimdVec8i& v)
+{
+  m_v = _mm256_sub_epi32(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator|=(const ezSimdVec8i& v)
+{
+  m_v = _mm256_or_si256(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator&=(const ezSimdVec8i& v)
+{
+  m_v = _mm256_and_si256(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator^=(const ezSimdVec8i& v)
+{
+  m_v = _mm256_xor_si256(m_v, v.m_v);
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator<<=(ezUInt32 uiShift)
+{
+  m_v = _mm256_sll_epi32(m_v, _mm_cvtsi32_si128(uiShift));
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator>>=(ezUInt32 uiShift)
+{
+  m_v = _mm256_sra_epi32(m_v, _mm_cvtsi32_si128(uiShift));
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMin(const ezSimdVec8i& v) const
+{
+  return _mm256_min_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMax(const ezSimdVec8i& v) const
+{
+  return _mm256_max_epi32(m_v, v.m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Abs() const
+{
+  return _mm256_abs_epi32(m_v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator==(const ezSimdVec8i& v) const
+{
+  return _mm256_castsi256_ps(_mm256_cmpeq_epi32(m_v, v.m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator!=(const ezSimdVec8i& v) const
+{
+  return !(*this == v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<=(const ezSimdVec8i& v) const
+{
+  return !(*this > v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<(const ezSimdVec8i& v) const
+{
+  return _mm256_castsi256_ps(_mm256_cmpgt_epi32(v.m_v, m_v));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>=(const ezSimdVec8i& v) const
+{
+  return !(*this < v);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>(const ezSimdVec8i& v) const
+{
+  return _mm256_castsi256_ps(_mm256_cmpgt_epi32(m_v, v.m_v));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Select(const ezSimdVec8b& vCmp, const ezSimdVec8i& vTrue, const ezSimdVec8i& vFalse)
+{
+  return _mm256_castps_si256(_mm256_blendv_ps(_mm256_castsi256_ps(vFalse.m_v), _mm256_castsi256_ps(vTrue.m_v), vCmp.m_v));
+}
@@ -8,7 +8,13 @@
 #define EZ_SSE_AVX 0x50
 #define EZ_SSE_AVX2 0x51
 
-#define EZ_SSE_LEVEL EZ_SSE_41
+// AVX2 is only used when the compiler is allowed to generate it (EZ_ENABLE_AVX2 in CMake), since the binaries won't run on older CPUs.
+// MSVC has no define for FMA, but /arch:AVX2 enables it as well.
+#if defined(__AVX2__) && (defined(__FMA__) || EZ_ENABLED(EZ_COMPILER_MSVC))
+#  define EZ_SSE_LEVEL EZ_SSE_AVX2
+#else
+#  define EZ_SSE_LEVEL EZ_SSE_41
+#endif
 
 #if EZ_SSE_LEVEL >= EZ_SSE_20
 #  include <emmintrin.h>
@@ -36,8 +42,10 @@
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
 #  define EZ_CHECK_SIMD_ALIGNMENT EZ_CHECK_ALIGNMENT_16
+#  define EZ_CHECK_SIMD8_ALIGNMENT EZ_CHECK_ALIGNMENT_32
 #else
 #  define EZ_CHECK_SIMD_ALIGNMENT(x)
+#  define EZ_CHECK_SIMD8_ALIGNMENT(x)
 #endif
 
 namespace ezInternal
@@ -46,6 +54,12 @@ namespace ezInternal
   using QuadBool = __m128;
   using QuadInt = __m128i;
   using QuadUInt = __m128i;
+
+#if EZ_SSE_LEVEL >= EZ_SSE_AVX2
+  using OctFloat = __m256;
+  using OctBool = __m256;
+  using OctInt = __m256i;
+#endif
 } // namespace ezInternal
 
 #include <Foundation/SimdMath/SimdSwizzle.h>
@@ -0,0 +1,64 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(ezInternal::OctFloat v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MakeZero()
+{
+  return ezSimdVec8f(ezSimdFloat::MakeZero());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MakeNaN()
+{
+  return ezSimdVec8f(ezSimdFloat::MakeNaN());
+}
+
+inline ezSimdFloat ezSimdVec8f::GetComponent(int i) const
+{
+  switch (i)
+  {
+    case 0:
+      return GetComponent<0>();
+
+    case 1:
+      return GetComponent<1>();
+
+    case 2:
+      return GetComponent<2>();
+
+    case 3:
+      return GetComponent<3>();
+
+    case 4:
+      return GetComponent<4>();
+
+    case 5:
+      return GetComponent<5>();
+
+    case 6:
+      return GetComponent<6>();
+
+    default:
+      return GetComponent<7>();
+  }
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Fraction() const
+{
+  return *this - Trunc();
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Lerp(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& t)
+{
+  return MulAdd(t, b - a, a);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::IsEqual(const ezSimdVec8f& rhs, const ezSimdFloat& fEpsilon) const
+{
+  ezSimdVec8f minusEps = rhs - ezSimdVec8f(fEpsilon);
+  ezSimdVec8f plusEps = rhs + ezSimdVec8f(fEpsilon);
+  return (*this >= minusEps) && (*this <= plusEps);
+}
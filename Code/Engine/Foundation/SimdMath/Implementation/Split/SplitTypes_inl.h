@@ -0,0 +1,24 @@
+#pragma once
+
+namespace ezInternal
+{
+  /// Without native 8-wide registers, every 8-wide vector is made of two 4-wide vectors of the active SIMD implementation.
+
+  struct OctFloat
+  {
+    ezSimdVec4f m_Low;
+    ezSimdVec4f m_High;
+  };
+
+  struct OctBool
+  {
+    ezSimdVec4b m_Low;
+    ezSimdVec4b m_High;
+  };
+
+  struct OctInt
+  {
+    ezSimdVec4i m_Low;
+    ezSimdVec4i m_High;
+  };
+} // namespace ezInternal
@@ -0,0 +1,117 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b() = default;
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b)
+{
+  m_v.m_Low = ezSimdVec4b(b);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(ezInternal::OctBool b)
+{
+  m_v = b;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7)
+{
+  m_v.m_Low = ezSimdVec4b(b0, b1, b2, b3);
+  m_v.m_High = ezSimdVec4b(b4, b5, b6, b7);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b::ezSimdVec8b(const ezSimdVec4b& vLow, const ezSimdVec4b& vHigh)
+{
+  m_v.m_Low = vLow;
+  m_v.m_High = vHigh;
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::GetComponent() const
+{
+  if constexpr (N < 4)
+    return m_v.m_Low.GetComponent<N>();
+  else
+    return m_v.m_High.GetComponent<N - 4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetLow() const
+{
+  return m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4b ezSimdVec8b::GetHigh() const
+{
+  return m_v.m_High;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator&&(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(m_v.m_Low && rhs.m_v.m_Low, m_v.m_High && rhs.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator||(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(m_v.m_Low || rhs.m_v.m_Low, m_v.m_High || rhs.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!() const
+{
+  return ezSimdVec8b(!m_v.m_Low, !m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator==(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(m_v.m_Low == rhs.m_v.m_Low, m_v.m_High == rhs.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::operator!=(const ezSimdVec8b& rhs) const
+{
+  return ezSimdVec8b(m_v.m_Low != rhs.m_v.m_Low, m_v.m_High != rhs.m_v.m_High);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AllSet() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.AllSet<N>();
+  else
+    return m_v.m_Low.AllSet<4>() && m_v.m_High.AllSet<N - 4>();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::AnySet() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.AnySet<N>();
+  else
+    return m_v.m_Low.AnySet<4>() || m_v.m_High.AnySet<N - 4>();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8b::NoneSet() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.NoneSet<N>();
+  else
+    return m_v.m_Low.NoneSet<4>() && m_v.m_High.NoneSet<N - 4>();
+}
+
+EZ_ALWAYS_INLINE ezUInt32 ezSimdVec8b::GetMask() const
+{
+  ezUInt32 uiMask = 0;
+  uiMask |= m_v.m_Low.x() ? EZ_BIT(0) : 0;
+  uiMask |= m_v.m_Low.y() ? EZ_BIT(1) : 0;
+  uiMask |= m_v.m_Low.z() ? EZ_BIT(2) : 0;
+  uiMask |= m_v.m_Low.w() ? EZ_BIT(3) : 0;
+  uiMask |= m_v.m_High.x() ? EZ_BIT(4) : 0;
+  uiMask |= m_v.m_High.y() ? EZ_BIT(5) : 0;
+  uiMask |= m_v.m_High.z() ? EZ_BIT(6) : 0;
+  uiMask |= m_v.m_High.w() ? EZ_BIT(7) : 0;
+  return uiMask;
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8b::Select(const ezSimdVec8b& vCmp, const ezSimdVec8b& vTrue, const ezSimdVec8b& vFalse)
+{
+  return ezSimdVec8b(ezSimdVec4b::Select(vCmp.m_v.m_Low, vTrue.m_v.m_Low, vFalse.m_v.m_Low), ezSimdVec4b::Select(vCmp.m_v.m_High, vTrue.m_v.m_High, vFalse.m_v.m_High));
+}
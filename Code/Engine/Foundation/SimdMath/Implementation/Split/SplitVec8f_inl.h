@@ -0,0 +1,336 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f() = default;
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float fAll)
+{
+  m_v.m_Low.Set(fAll);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdFloat& fAll)
+{
+  m_v.m_Low = ezSimdVec4f(fAll);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7)
+{
+  m_v.m_Low.Set(f0, f1, f2, f3);
+  m_v.m_High.Set(f4, f5, f6, f7);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f::ezSimdVec8f(const ezSimdVec4f& vLow, const ezSimdVec4f& vHigh)
+{
+  m_v.m_Low = vLow;
+  m_v.m_High = vHigh;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float fAll)
+{
+  m_v.m_Low.Set(fAll);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::Set(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7)
+{
+  m_v.m_Low.Set(f0, f1, f2, f3);
+  m_v.m_High.Set(f4, f5, f6, f7);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8f::SetZero()
+{
+  m_v.m_Low.SetZero();
+  m_v.m_High.SetZero();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8f::Load(const float* pFloats)
+{
+  static_assert(N >= 1 && N <= 8, "Invalid number of components");
+
+  if constexpr (N <= 4)
+  {
+    m_v.m_Low.Load<N>(pFloats);
+    m_v.m_High.SetZero();
+  }
+  else
+  {
+    m_v.m_Low.Load<4>(pFloats);
+    m_v.m_High.Load<N - 4>(pFloats + 4);
+  }
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8f::Store(float* pFloats) const
+{
+  static_assert(N >= 1 && N <= 8, "Invalid number of components");
+
+  if constexpr (N <= 4)
+  {
+    m_v.m_Low.Store<N>(pFloats);
+  }
+  else
+  {
+    m_v.m_Low.Store<4>(pFloats);
+    m_v.m_High.Store<N - 4>(pFloats + 4);
+  }
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetReciprocal() const
+{
+  return ezSimdVec8f(m_v.m_Low.GetReciprocal<acc>(), m_v.m_High.GetReciprocal<acc>());
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetSqrt() const
+{
+  return ezSimdVec8f(m_v.m_Low.GetSqrt<acc>(), m_v.m_High.GetSqrt<acc>());
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::GetInvSqrt() const
+{
+  return ezSimdVec8f(m_v.m_Low.GetInvSqrt<acc>(), m_v.m_High.GetInvSqrt<acc>());
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsZero() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.IsZero<N>();
+  else
+    return m_v.m_Low.IsZero<4>() && m_v.m_High.IsZero<N - 4>();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsZero(const ezSimdFloat& fEpsilon) const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.IsZero<N>(fEpsilon);
+  else
+    return m_v.m_Low.IsZero<4>(fEpsilon) && m_v.m_High.IsZero<N - 4>(fEpsilon);
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsNaN() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.IsNaN<N>();
+  else
+    return m_v.m_Low.IsNaN<4>() || m_v.m_High.IsNaN<N - 4>();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE bool ezSimdVec8f::IsValid() const
+{
+  if constexpr (N <= 4)
+    return m_v.m_Low.IsValid<N>();
+  else
+    return m_v.m_Low.IsValid<4>() && m_v.m_High.IsValid<N - 4>();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::GetComponent() const
+{
+  if constexpr (N < 4)
+    return m_v.m_Low.GetComponent<N>();
+  else
+    return m_v.m_High.GetComponent<N - 4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetLow() const
+{
+  return m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4f ezSimdVec8f::GetHigh() const
+{
+  return m_v.m_High;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-() const
+{
+  return ezSimdVec8f(-m_v.m_Low, -m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator+(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low + v.m_v.m_Low, m_v.m_High + v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator-(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low - v.m_v.m_Low, m_v.m_High - v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator*(const ezSimdFloat& f) const
+{
+  return ezSimdVec8f(m_v.m_Low * f, m_v.m_High * f);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::operator/(const ezSimdFloat& f) const
+{
+  return ezSimdVec8f(m_v.m_Low / f, m_v.m_High / f);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMul(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low.CompMul(v.m_v.m_Low), m_v.m_High.CompMul(v.m_v.m_High));
+}
+
+template <ezMathAcc::Enum acc>
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompDiv(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low.CompDiv<acc>(v.m_v.m_Low), m_v.m_High.CompDiv<acc>(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMin(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low.CompMin(v.m_v.m_Low), m_v.m_High.CompMin(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CompMax(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8f(m_v.m_Low.CompMax(v.m_v.m_Low), m_v.m_High.CompMax(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Abs() const
+{
+  return ezSimdVec8f(m_v.m_Low.Abs(), m_v.m_High.Abs());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Round() const
+{
+  return ezSimdVec8f(m_v.m_Low.Round(), m_v.m_High.Round());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Floor() const
+{
+  return ezSimdVec8f(m_v.m_Low.Floor(), m_v.m_High.Floor());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Ceil() const
+{
+  return ezSimdVec8f(m_v.m_Low.Ceil(), m_v.m_High.Ceil());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Trunc() const
+{
+  return ezSimdVec8f(m_v.m_Low.Trunc(), m_v.m_High.Trunc());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::FlipSign(const ezSimdVec8b& vCmp) const
+{
+  return ezSimdVec8f(m_v.m_Low.FlipSign(vCmp.m_v.m_Low), m_v.m_High.FlipSign(vCmp.m_v.m_High));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::Select(const ezSimdVec8b& vCmp, const ezSimdVec8f& vTrue, const ezSimdVec8f& vFalse)
+{
+  return ezSimdVec8f(ezSimdVec4f::Select(vCmp.m_v.m_Low, vTrue.m_v.m_Low, vFalse.m_v.m_Low), ezSimdVec4f::Select(vCmp.m_v.m_High, vTrue.m_v.m_High, vFalse.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator+=(const ezSimdVec8f& v)
+{
+  m_v.m_Low += v.m_v.m_Low;
+  m_v.m_High += v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator-=(const ezSimdVec8f& v)
+{
+  m_v.m_Low -= v.m_v.m_Low;
+  m_v.m_High -= v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator*=(const ezSimdFloat& f)
+{
+  m_v.m_Low *= f;
+  m_v.m_High *= f;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f& ezSimdVec8f::operator/=(const ezSimdFloat& f)
+{
+  m_v.m_Low /= f;
+  m_v.m_High /= f;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator==(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low == v.m_v.m_Low, m_v.m_High == v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator!=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low != v.m_v.m_Low, m_v.m_High != v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low <= v.m_v.m_Low, m_v.m_High <= v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator<(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low < v.m_v.m_Low, m_v.m_High < v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>=(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low >= v.m_v.m_Low, m_v.m_High >= v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8f::operator>(const ezSimdVec8f& v) const
+{
+  return ezSimdVec8b(m_v.m_Low > v.m_v.m_Low, m_v.m_High > v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalSum() const
+{
+  return (m_v.m_Low + m_v.m_High).HorizontalSum<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMin() const
+{
+  return m_v.m_Low.CompMin(m_v.m_High).HorizontalMin<4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdFloat ezSimdVec8f::HorizontalMax() const
+{
+  return m_v.m_Low.CompMax(m_v.m_High).HorizontalMax<4>();
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulAdd(a.m_v.m_Low, b.m_v.m_Low, c.m_v.m_Low), ezSimdVec4f::MulAdd(a.m_v.m_High, b.m_v.m_High, c.m_v.m_High));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulAdd(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulAdd(a.m_v.m_Low, b, c.m_v.m_Low), ezSimdVec4f::MulAdd(a.m_v.m_High, b, c.m_v.m_High));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulSub(a.m_v.m_Low, b.m_v.m_Low, c.m_v.m_Low), ezSimdVec4f::MulSub(a.m_v.m_High, b.m_v.m_High, c.m_v.m_High));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::MulSub(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c)
+{
+  return ezSimdVec8f(ezSimdVec4f::MulSub(a.m_v.m_Low, b, c.m_v.m_Low), ezSimdVec4f::MulSub(a.m_v.m_High, b, c.m_v.m_High));
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8f::CopySign(const ezSimdVec8f& vMagnitude, const ezSimdVec8f& vSign)
+{
+  return ezSimdVec8f(ezSimdVec4f::CopySign(vMagnitude.m_v.m_Low, vSign.m_v.m_Low), ezSimdVec4f::CopySign(vMagnitude.m_v.m_High, vSign.m_v.m_High));
+}
@@ -0,0 +1,272 @@
+#pragma once
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i() = default;
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInt32 iAll)
+{
+  m_v.m_Low.Set(iAll);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7)
+{
+  m_v.m_Low.Set(i0, i1, i2, i3);
+  m_v.m_High.Set(i4, i5, i6, i7);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(const ezSimdVec4i& vLow, const ezSimdVec4i& vHigh)
+{
+  m_v.m_Low = vLow;
+  m_v.m_High = vHigh;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i::ezSimdVec8i(ezInternal::OctInt v)
+{
+  m_v = v;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::MakeZero()
+{
+  return ezSimdVec8i(ezSimdVec4i::MakeZero(), ezSimdVec4i::MakeZero());
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Set(ezInt32 iAll)
+{
+  m_v.m_Low.Set(iAll);
+  m_v.m_High = m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::Set(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7)
+{
+  m_v.m_Low.Set(i0, i1, i2, i3);
+  m_v.m_High.Set(i4, i5, i6, i7);
+}
+
+EZ_ALWAYS_INLINE void ezSimdVec8i::SetZero()
+{
+  m_v.m_Low.SetZero();
+  m_v.m_High.SetZero();
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8i::Load(const ezInt32* pInts)
+{
+  static_assert(N >= 1 && N <= 8, "Invalid number of components");
+
+  if constexpr (N <= 4)
+  {
+    m_v.m_Low.Load<N>(pInts);
+    m_v.m_High.SetZero();
+  }
+  else
+  {
+    m_v.m_Low.Load<4>(pInts);
+    m_v.m_High.Load<N - 4>(pInts + 4);
+  }
+}
+
+template <int N>
+EZ_ALWAYS_INLINE void ezSimdVec8i::Store(ezInt32* pInts) const
+{
+  static_assert(N >= 1 && N <= 8, "Invalid number of components");
+
+  if constexpr (N <= 4)
+  {
+    m_v.m_Low.Store<N>(pInts);
+  }
+  else
+  {
+    m_v.m_Low.Store<4>(pInts);
+    m_v.m_High.Store<N - 4>(pInts + 4);
+  }
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8f ezSimdVec8i::ToFloat() const
+{
+  return ezSimdVec8f(m_v.m_Low.ToFloat(), m_v.m_High.ToFloat());
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Truncate(const ezSimdVec8f& f)
+{
+  return ezSimdVec8i(ezSimdVec4i::Truncate(f.m_v.m_Low), ezSimdVec4i::Truncate(f.m_v.m_High));
+}
+
+template <int N>
+EZ_ALWAYS_INLINE ezInt32 ezSimdVec8i::GetComponent() const
+{
+  if constexpr (N < 4)
+    return m_v.m_Low.GetComponent<N>();
+  else
+    return m_v.m_High.GetComponent<N - 4>();
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetLow() const
+{
+  return m_v.m_Low;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec4i ezSimdVec8i::GetHigh() const
+{
+  return m_v.m_High;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-() const
+{
+  return ezSimdVec8i(-m_v.m_Low, -m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator+(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low + v.m_v.m_Low, m_v.m_High + v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator-(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low - v.m_v.m_Low, m_v.m_High - v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMul(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low.CompMul(v.m_v.m_Low), m_v.m_High.CompMul(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator|(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low | v.m_v.m_Low, m_v.m_High | v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator&(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low & v.m_v.m_Low, m_v.m_High & v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator^(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low ^ v.m_v.m_Low, m_v.m_High ^ v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator~() const
+{
+  return ezSimdVec8i(~m_v.m_Low, ~m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator<<(ezUInt32 uiShift) const
+{
+  return ezSimdVec8i(m_v.m_Low << uiShift, m_v.m_High << uiShift);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator>>(ezUInt32 uiShift) const
+{
+  return ezSimdVec8i(m_v.m_Low >> uiShift, m_v.m_High >> uiShift);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator<<(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low << v.m_v.m_Low, m_v.m_High << v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::operator>>(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low >> v.m_v.m_Low, m_v.m_High >> v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator+=(const ezSimdVec8i& v)
+{
+  m_v.m_Low += v.m_v.m_Low;
+  m_v.m_High += v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator-=(const ezSimdVec8i& v)
+{
+  m_v.m_Low -= v.m_v.m_Low;
+  m_v.m_High -= v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator|=(const ezSimdVec8i& v)
+{
+  m_v.m_Low |= v.m_v.m_Low;
+  m_v.m_High |= v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator&=(const ezSimdVec8i& v)
+{
+  m_v.m_Low &= v.m_v.m_Low;
+  m_v.m_High &= v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator^=(const ezSimdVec8i& v)
+{
+  m_v.m_Low ^= v.m_v.m_Low;
+  m_v.m_High ^= v.m_v.m_High;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator<<=(ezUInt32 uiShift)
+{
+  m_v.m_Low <<= uiShift;
+  m_v.m_High <<= uiShift;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i& ezSimdVec8i::operator>>=(ezUInt32 uiShift)
+{
+  m_v.m_Low >>= uiShift;
+  m_v.m_High >>= uiShift;
+  return *this;
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMin(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low.CompMin(v.m_v.m_Low), m_v.m_High.CompMin(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::CompMax(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8i(m_v.m_Low.CompMax(v.m_v.m_Low), m_v.m_High.CompMax(v.m_v.m_High));
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Abs() const
+{
+  return ezSimdVec8i(m_v.m_Low.Abs(), m_v.m_High.Abs());
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator==(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low == v.m_v.m_Low, m_v.m_High == v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator!=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low != v.m_v.m_Low, m_v.m_High != v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low <= v.m_v.m_Low, m_v.m_High <= v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator<(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low < v.m_v.m_Low, m_v.m_High < v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>=(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low >= v.m_v.m_Low, m_v.m_High >= v.m_v.m_High);
+}
+
+EZ_ALWAYS_INLINE ezSimdVec8b ezSimdVec8i::operator>(const ezSimdVec8i& v) const
+{
+  return ezSimdVec8b(m_v.m_Low > v.m_v.m_Low, m_v.m_High > v.m_v.m_High);
+}
+
+// static
+EZ_ALWAYS_INLINE ezSimdVec8i ezSimdVec8i::Select(const ezSimdVec8b& vCmp, const ezSimdVec8i& vTrue, const ezSimdVec8i& vFalse)
+{
+  return ezSimdVec8i(ezSimdVec4i::Select(vCmp.m_v.m_Low, vTrue.m_v.m_Low, vFalse.m_v.m_Low), ezSimdVec4i::Select(vCmp.m_v.m_High, vTrue.m_v.m_High, vFalse.m_v.m_High));
+}
@@ -21,3 +21,12 @@ struct ezMathAcc
 #else
 #  error "Unknown SIMD implementation."
 #endif
+
+/// \brief Whether ezSimdVec8f, ezSimdVec8i and ezSimdVec8b map to native 8-wide registers.
+///
+/// Otherwise every 8-wide vector is made of two 4-wide vectors of the active implementation.
+#if EZ_SIMD_IMPLEMENTATION == EZ_SIMD_IMPLEMENTATION_SSE && EZ_SSE_LEVEL >= EZ_SSE_AVX2
+#  define EZ_SIMD_VEC8_NATIVE EZ_ON
+#else
+#  define EZ_SIMD_VEC8_NATIVE EZ_OFF
+#endif
@@ -0,0 +1,65 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec4i.h>
+
+#if EZ_DISABLED(EZ_SIMD_VEC8_NATIVE)
+#  include <Foundation/SimdMath/Implementation/Split/SplitTypes_inl.h>
+#endif
+
+/// \brief An 8-component SIMD boolean vector, e.g. the result of comparing two ezSimdVec8f.
+///
+/// See ezSimdVec8f for how the 8 components map to the hardware.
+class EZ_FOUNDATION_DLL ezSimdVec8b
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8b();                      // [tested]
+  ezSimdVec8b(bool b);                // [tested]
+  ezSimdVec8b(ezInternal::OctBool b); // [tested]
+
+  ezSimdVec8b(bool b0, bool b1, bool b2, bool b3, bool b4, bool b5, bool b6, bool b7); // [tested]
+
+  ezSimdVec8b(const ezSimdVec4b& vLow, const ezSimdVec4b& vHigh); // [tested]
+
+public:
+  template <int N>
+  bool GetComponent() const; // [tested]
+
+  /// \brief Returns components 0 to 3.
+  ezSimdVec4b GetLow() const; // [tested]
+
+  /// \brief Returns components 4 to 7.
+  ezSimdVec4b GetHigh() const; // [tested]
+
+public:
+  ezSimdVec8b operator&&(const ezSimdVec8b& rhs) const; // [tested]
+  ezSimdVec8b operator||(const ezSimdVec8b& rhs) const; // [tested]
+  ezSimdVec8b operator!() const;                        // [tested]
+
+  ezSimdVec8b operator==(const ezSimdVec8b& rhs) const; // [tested]
+  ezSimdVec8b operator!=(const ezSimdVec8b& rhs) const; // [tested]
+
+  template <int N = 8>
+  bool AllSet() const; // [tested]
+
+  template <int N = 8>
+  bool AnySet() const; // [tested]
+
+  template <int N = 8>
+  bool NoneSet() const; // [tested]
+
+  /// \brief Returns one bit per component, component 0 in the lowest bit.
+  ezUInt32 GetMask() const; // [tested]
+
+  static ezSimdVec8b Select(const ezSimdVec8b& vCmp, const ezSimdVec8b& vTrue, const ezSimdVec8b& vFalse); // [tested]
+
+public:
+  ezInternal::OctBool m_v;
+};
+
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8b_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Split/SplitVec8b_inl.h>
+#endif
@@ -0,0 +1,149 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec8b.h>
+
+/// \brief An 8-component SIMD vector class, meant for processing 8 independent values at once (structure of arrays).
+///
+/// With AVX2 (see EZ_SIMD_VEC8_NATIVE) every operation maps to a single 256 bit instruction.
+/// Otherwise the vector is made of two ezSimdVec4f, so code written for 8 components still works everywhere,
+/// just without the benefit of the wider registers.
+///
+/// Unlike ezSimdVec4f there are no geometric functions (dot, cross, length, ...), since the components are not meant to form a vector.
+class EZ_FOUNDATION_DLL ezSimdVec8f
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8f(); // [tested]
+
+  explicit ezSimdVec8f(float fAll); // [tested]
+
+  explicit ezSimdVec8f(const ezSimdFloat& fAll); // [tested]
+
+  ezSimdVec8f(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7); // [tested]
+
+  ezSimdVec8f(const ezSimdVec4f& vLow, const ezSimdVec4f& vHigh); // [tested]
+
+  ezSimdVec8f(ezInternal::OctFloat v); // [tested]
+
+  /// \brief Creates an ezSimdVec8f that is initialized to zero.
+  [[nodiscard]] static ezSimdVec8f MakeZero(); // [tested]
+
+  /// \brief Creates an ezSimdVec8f that is initialized to Not-A-Number (NaN).
+  [[nodiscard]] static ezSimdVec8f MakeNaN(); // [tested]
+
+  void Set(float fAll); // [tested]
+
+  void Set(float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7); // [tested]
+
+  void SetZero(); // [tested]
+
+  /// \brief Loads the first N components, the other components are set to zero.
+  template <int N = 8>
+  void Load(const float* pFloats); // [tested]
+
+  /// \brief Stores the first N components.
+  template <int N = 8>
+  void Store(float* pFloats) const; // [tested]
+
+public:
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetReciprocal() const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetSqrt() const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  ezSimdVec8f GetInvSqrt() const; // [tested]
+
+  template <int N = 8>
+  bool IsZero() const; // [tested]
+
+  template <int N = 8>
+  bool IsZero(const ezSimdFloat& fEpsilon) const; // [tested]
+
+  template <int N = 8>
+  bool IsNaN() const; // [tested]
+
+  template <int N = 8>
+  bool IsValid() const; // [tested]
+
+public:
+  template <int N>
+  ezSimdFloat GetComponent() const; // [tested]
+
+  ezSimdFloat GetComponent(int i) const; // [tested]
+
+  /// \brief Returns components 0 to 3.
+  ezSimdVec4f GetLow() const; // [tested]
+
+  /// \brief Returns components 4 to 7.
+  ezSimdVec4f GetHigh() const; // [tested]
+
+public:
+  [[nodiscard]] ezSimdVec8f operator-() const;                     // [tested]
+  [[nodiscard]] ezSimdVec8f operator+(const ezSimdVec8f& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8f operator-(const ezSimdVec8f& v) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8f operator*(const ezSimdFloat& f) const; // [tested]
+  [[nodiscard]] ezSimdVec8f operator/(const ezSimdFloat& f) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8f CompMul(const ezSimdVec8f& v) const; // [tested]
+
+  template <ezMathAcc::Enum acc = ezMathAcc::FULL>
+  [[nodiscard]] ezSimdVec8f CompDiv(const ezSimdVec8f& v) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8f CompMin(const ezSimdVec8f& rhs) const; // [tested]
+  [[nodiscard]] ezSimdVec8f CompMax(const ezSimdVec8f& rhs) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8f Abs() const;      // [tested]
+  [[nodiscard]] ezSimdVec8f Round() const;    // [tested]
+  [[nodiscard]] ezSimdVec8f Floor() const;    // [tested]
+  [[nodiscard]] ezSimdVec8f Ceil() const;     // [tested]
+  [[nodiscard]] ezSimdVec8f Trunc() const;    // [tested]
+  [[nodiscard]] ezSimdVec8f Fraction() const; // [tested]
+
+  [[nodiscard]] ezSimdVec8f FlipSign(const ezSimdVec8b& vCmp) const; // [tested]
+
+  [[nodiscard]] static ezSimdVec8f Select(const ezSimdVec8b& vCmp, const ezSimdVec8f& vTrue, const ezSimdVec8f& vFalse); // [tested]
+
+  [[nodiscard]] static ezSimdVec8f Lerp(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& t); // [tested]
+
+  ezSimdVec8f& operator+=(const ezSimdVec8f& v); // [tested]
+  ezSimdVec8f& operator-=(const ezSimdVec8f& v); // [tested]
+
+  ezSimdVec8f& operator*=(const ezSimdFloat& f); // [tested]
+  ezSimdVec8f& operator/=(const ezSimdFloat& f); // [tested]
+
+  ezSimdVec8b IsEqual(const ezSimdVec8f& rhs, const ezSimdFloat& fEpsilon) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8b operator==(const ezSimdVec8f& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator!=(const ezSimdVec8f& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator<=(const ezSimdVec8f& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator<(const ezSimdVec8f& v) const;  // [tested]
+  [[nodiscard]] ezSimdVec8b operator>=(const ezSimdVec8f& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator>(const ezSimdVec8f& v) const;  // [tested]
+
+  [[nodiscard]] ezSimdFloat HorizontalSum() const; // [tested]
+  [[nodiscard]] ezSimdFloat HorizontalMin() const; // [tested]
+  [[nodiscard]] ezSimdFloat HorizontalMax() const; // [tested]
+
+  [[nodiscard]] static ezSimdVec8f MulAdd(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c); // [tested]
+  [[nodiscard]] static ezSimdVec8f MulAdd(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c); // [tested]
+
+  [[nodiscard]] static ezSimdVec8f MulSub(const ezSimdVec8f& a, const ezSimdVec8f& b, const ezSimdVec8f& c); // [tested]
+  [[nodiscard]] static ezSimdVec8f MulSub(const ezSimdVec8f& a, const ezSimdFloat& b, const ezSimdVec8f& c); // [tested]
+
+  [[nodiscard]] static ezSimdVec8f CopySign(const ezSimdVec8f& vMagnitude, const ezSimdVec8f& vSign); // [tested]
+
+public:
+  ezInternal::OctFloat m_v;
+};
+
+#include <Foundation/SimdMath/Implementation/SimdVec8f_inl.h>
+
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8f_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Split/SplitVec8f_inl.h>
+#endif
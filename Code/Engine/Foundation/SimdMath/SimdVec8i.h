@@ -0,0 +1,103 @@
+#pragma once
+
+#include <Foundation/SimdMath/SimdVec8f.h>
+
+/// \brief A SIMD 8-component vector class of signed 32b integers
+///
+/// See ezSimdVec8f for how the 8 components map to the hardware.
+class EZ_FOUNDATION_DLL ezSimdVec8i
+{
+public:
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec8i(); // [tested]
+
+  explicit ezSimdVec8i(ezInt32 iAll); // [tested]
+
+  ezSimdVec8i(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7); // [tested]
+
+  ezSimdVec8i(const ezSimdVec4i& vLow, const ezSimdVec4i& vHigh); // [tested]
+
+  ezSimdVec8i(ezInternal::OctInt v); // [tested]
+
+  /// \brief Creates an ezSimdVec8i that is initialized to zero.
+  [[nodiscard]] static ezSimdVec8i MakeZero(); // [tested]
+
+  void Set(ezInt32 iAll); // [tested]
+
+  void Set(ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7); // [tested]
+
+  void SetZero(); // [tested]
+
+  /// \brief Loads the first N components, the other components are set to zero.
+  template <int N = 8>
+  void Load(const ezInt32* pInts); // [tested]
+
+  /// \brief Stores the first N components.
+  template <int N = 8>
+  void Store(ezInt32* pInts) const; // [tested]
+
+public:
+  ezSimdVec8f ToFloat() const; // [tested]
+
+  [[nodiscard]] static ezSimdVec8i Truncate(const ezSimdVec8f& f); // [tested]
+
+public:
+  template <int N>
+  ezInt32 GetComponent() const; // [tested]
+
+  /// \brief Returns components 0 to 3.
+  ezSimdVec4i GetLow() const; // [tested]
+
+  /// \brief Returns components 4 to 7.
+  ezSimdVec4i GetHigh() const; // [tested]
+
+public:
+  [[nodiscard]] ezSimdVec8i operator-() const;                     // [tested]
+  [[nodiscard]] ezSimdVec8i operator+(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i operator-(const ezSimdVec8i& v) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8i CompMul(const ezSimdVec8i& v) const; // [tested]
+
+  [[nodiscard]] ezSimdVec8i operator|(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i operator&(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i operator^(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i operator~() const;                     // [tested]
+
+  [[nodiscard]] ezSimdVec8i operator<<(ezUInt32 uiShift) const;     // [tested]
+  [[nodiscard]] ezSimdVec8i operator>>(ezUInt32 uiShift) const;     // [tested]
+  [[nodiscard]] ezSimdVec8i operator<<(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i operator>>(const ezSimdVec8i& v) const; // [tested]
+
+  ezSimdVec8i& operator+=(const ezSimdVec8i& v); // [tested]
+  ezSimdVec8i& operator-=(const ezSimdVec8i& v); // [tested]
+
+  ezSimdVec8i& operator|=(const ezSimdVec8i& v); // [tested]
+  ezSimdVec8i& operator&=(const ezSimdVec8i& v); // [tested]
+  ezSimdVec8i& operator^=(const ezSimdVec8i& v); // [tested]
+
+  ezSimdVec8i& operator<<=(ezUInt32 uiShift); // [tested]
+  ezSimdVec8i& operator>>=(ezUInt32 uiShift); // [tested]
+
+  [[nodiscard]] ezSimdVec8i CompMin(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i CompMax(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8i Abs() const;                         // [tested]
+
+  [[nodiscard]] ezSimdVec8b operator==(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator!=(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator<=(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator<(const ezSimdVec8i& v) const;  // [tested]
+  [[nodiscard]] ezSimdVec8b operator>=(const ezSimdVec8i& v) const; // [tested]
+  [[nodiscard]] ezSimdVec8b operator>(const ezSimdVec8i& v) const;  // [tested]
+
+  [[nodiscard]] static ezSimdVec8i Select(const ezSimdVec8b& vCmp, const ezSimdVec8i& vTrue, const ezSimdVec8i& vFalse); // [tested]
+
+public:
+  ezInternal::OctInt m_v;
+};
+
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+#  include <Foundation/SimdMath/Implementation/SSE/AVXVec8i_inl.h>
+#else
+#  include <Foundation/SimdMath/Implementation/Split/SplitVec8i_inl.h>
+#endif
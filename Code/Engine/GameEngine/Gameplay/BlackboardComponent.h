@@ -42,7 +42,7 @@ private:
 struct ezMsgUpdateLocalBounds;
 struct ezMsgExtractRenderData;
 
-using ezBlackboardComponentManager = ezComponentManager<class ezBlackboardComponent, ezBlockStorageType::Compact>;
+using ezBlackboardComponentManager = ezComponentManagerSimple<class ezBlackboardComponent, ezComponentUpdateType::Always, ezBlockStorageType::Compact>;
 
 /// \brief This component holds an ezBlackboard which can be used to share state between multiple components.
 class EZ_GAMEENGINE_DLL ezBlackboardComponent : public ezComponent
@@ -112,6 +112,8 @@ private:
   void OnEntryChanged(const ezBlackboard::EntryEvent& e);
   void InitializeFromTemplate();
 
+  void Update();
+
   ezSharedPtr<ezBlackboard> m_pBoard;
 
   // this array is not held during runtime, it is only needed during editor time until the component is serialized out
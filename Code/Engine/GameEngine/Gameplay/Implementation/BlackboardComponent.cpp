@@ -420,6 +420,12 @@ void ezBlackboardComponent::OnEntryChanged(const ezBlackboard::EntryEvent& e)
   m_EntryChangedSender.SendEventMessage(msg, this, GetOwner());
 }
 
+void ezBlackboardComponent::Update()
+{
+  // changes made through typed slots are broadcast once per frame
+  m_pBoard->BroadcastPendingEntryEvents();
+}
+
 void ezBlackboardComponent::InitializeFromTemplate()
 {
   if (!m_hTemplate.IsValid())
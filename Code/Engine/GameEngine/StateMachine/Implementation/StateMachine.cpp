@@ -60,6 +60,11 @@ bool ezStateMachineState::GetInstanceDataDesc(ezInstanceDataDesc& out_desc)
   return false;
 }
 
+bool ezStateMachineState::NeedsUpdate() const
+{
+  return true;
+}
+
 void ezStateMachineState::Reflection_OnEnter(ezStateMachineInstance* pStateMachineInstance, const ezStateMachineState* pFromState)
 {
 }
@@ -74,6 +79,34 @@ void ezStateMachineState::Reflection_Update(ezStateMachineInstance* pStateMachin
 
 //////////////////////////////////////////////////////////////////////////
 
+void ezStateMachineTransitionDependencies::AddTimeout(ezTime timeout)
+{
+  ezUInt32 uiIndex = 0;
+  while (uiIndex < m_Timeouts.GetCount() && m_Timeouts[uiIndex] < timeout)
+  {
+    ++uiIndex;
+  }
+
+  if (uiIndex < m_Timeouts.GetCount() && m_Timeouts[uiIndex] == timeout)
+    return;
+
+  m_Timeouts.Insert(timeout, uiIndex);
+}
+
+void ezStateMachineTransitionDependencies::Merge(const ezStateMachineTransitionDependencies& other)
+{
+  m_bEvaluateEveryFrame |= other.m_bEvaluateEveryFrame;
+  m_bBlackboard |= other.m_bBlackboard;
+  m_bThreadSafe &= other.m_bThreadSafe;
+
+  for (ezTime timeout : other.m_Timeouts)
+  {
+    AddTimeout(timeout);
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
 // clang-format off
 EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ezStateMachineTransition, 1, ezRTTINoAllocator)
 EZ_END_DYNAMIC_REFLECTED_TYPE;
@@ -94,6 +127,13 @@ bool ezStateMachineTransition::GetInstanceDataDesc(ezInstanceDataDesc& out_desc)
   return false;
 }
 
+void ezStateMachineTransition::GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const
+{
+  // unknown transition, we have to assume that it can change at any time and might not be thread safe
+  inout_dependencies.m_bEvaluateEveryFrame = true;
+  inout_dependencies.m_bThreadSafe = false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 ezStateMachineDescription::ezStateMachineDescription() = default;
@@ -118,6 +158,8 @@ ezUInt32 ezStateMachineDescription::AddState(ezUniquePtr<ezStateMachineState>&&
     stateContext.m_uiInstanceDataOffset = m_InstanceDataAllocator.AddDesc(instanceDataDesc);
   }
 
+  stateContext.m_bNeedsUpdate = pState->NeedsUpdate();
+  stateContext.m_TransitionDependencies = m_FromAnyTransitionDependencies;
   stateContext.m_pState = std::move(pState);
 
   return uiIndex;
@@ -127,15 +169,27 @@ void ezStateMachineDescription::AddTransition(ezUInt32 uiFromStateIndex, ezUInt3
 {
   EZ_ASSERT_DEV(uiFromStateIndex != uiToStateIndex, "Can't add a transition to itself");
 
+  ezStateMachineTransitionDependencies dependencies;
+  pTransistion->GetDependencies(dependencies);
+
   TransitionArray* pTransitions = nullptr;
   if (uiFromStateIndex == ezInvalidIndex)
   {
     pTransitions = &m_FromAnyTransitions;
+
+    // from any transitions are evaluated in every state
+    m_FromAnyTransitionDependencies.Merge(dependencies);
+    for (auto& stateContext : m_States)
+    {
+      stateContext.m_TransitionDependencies.Merge(dependencies);
+    }
   }
   else
   {
     EZ_ASSERT_DEV(uiFromStateIndex < m_States.GetCount(), "Invalid from state index {}", uiFromStateIndex);
     pTransitions = &m_States[uiFromStateIndex].m_Transitions;
+
+    m_States[uiFromStateIndex].m_TransitionDependencies.Merge(dependencies);
   }
 
   EZ_ASSERT_DEV(uiToStateIndex < m_States.GetCount(), "Invalid to state index {}", uiToStateIndex);
@@ -385,21 +439,70 @@ ezResult ezStateMachineInstance::SetStateOrFallback(const ezHashedString& sState
 
 void ezStateMachineInstance::Update(ezTime deltaTime)
 {
-  ezUInt32 uiNewStateIndex = FindNewStateToTransitionTo();
-  if (uiNewStateIndex != ezInvalidIndex)
+  // a result from EvaluateTransitions() can only be used if nothing has changed in between,
+  // e.g. because another instance has modified a shared blackboard in its update
+  if (!m_bTransitionsEvaluated || NeedsTransitionEvaluation())
+  {
+    EvaluateTransitions();
+  }
+
+  m_bTransitionsEvaluated = false;
+
+  if (m_uiEvaluatedStateIndex != ezInvalidIndex)
   {
-    SetState(uiNewStateIndex).IgnoreResult();
+    SetState(m_uiEvaluatedStateIndex).IgnoreResult();
   }
 
   if (m_pCurrentState != nullptr)
   {
-    void* pInstanceData = GetCurrentStateInstanceData();
-    m_pCurrentState->Update(*this, pInstanceData, deltaTime);
+    if (m_uiCurrentStateIndex == ezInvalidIndex || m_pDescription->m_States[m_uiCurrentStateIndex].m_bNeedsUpdate)
+    {
+      void* pInstanceData = GetCurrentStateInstanceData();
+      m_pCurrentState->Update(*this, pInstanceData, deltaTime);
+    }
   }
 
   m_TimeInCurrentState += deltaTime;
 }
 
+void ezStateMachineInstance::EvaluateTransitions()
+{
+  m_bTransitionsEvaluated = true;
+  m_uiEvaluatedStateIndex = ezInvalidIndex;
+
+  if (!NeedsTransitionEvaluation())
+    return;
+
+  m_bTransitionEvaluationRequested = false;
+
+  if (m_pBlackboard != nullptr)
+  {
+    m_uiEvaluatedBlackboardChangeCounter = m_pBlackboard->GetBlackboardChangeCounter();
+    m_uiEvaluatedBlackboardEntryChangeCounter = m_pBlackboard->GetBlackboardEntryChangeCounter();
+  }
+
+  m_NextTransitionTimeout = ezTime::MakeFromHours(24 * 365);
+  if (auto pDependencies = GetCurrentTransitionDependencies())
+  {
+    for (ezTime timeout : pDependencies->m_Timeouts)
+    {
+      if (timeout > m_TimeInCurrentState)
+      {
+        m_NextTransitionTimeout = timeout;
+        break;
+      }
+    }
+  }
+
+  m_uiEvaluatedStateIndex = FindNewStateToTransitionTo();
+}
+
+bool ezStateMachineInstance::CanEvaluateTransitionsInParallel() const
+{
+  auto pDependencies = GetCurrentTransitionDependencies();
+  return pDependencies == nullptr || pDependencies->m_bThreadSafe;
+}
+
 ezWorld* ezStateMachineInstance::GetOwnerWorld()
 {
   if (auto pComponent = ezDynamicCast<ezComponent*>(&m_Owner))
@@ -413,6 +516,7 @@ ezWorld* ezStateMachineInstance::GetOwnerWorld()
 void ezStateMachineInstance::SetBlackboard(const ezSharedPtr<ezBlackboard>& pBlackboard)
 {
   m_pBlackboard = pBlackboard;
+  m_bTransitionEvaluationRequested = true;
 }
 
 bool ezStateMachineInstance::Reflection_SetState(ezStringView sStateName)
@@ -455,6 +559,8 @@ void ezStateMachineInstance::EnterCurrentState(const ezStateMachineState* pFromS
 
     m_TimeInCurrentState = ezTime::MakeZero();
   }
+
+  m_bTransitionEvaluationRequested = true;
 }
 
 void ezStateMachineInstance::ExitCurrentState(const ezStateMachineState* pToState)
@@ -495,5 +601,39 @@ ezUInt32 ezStateMachineInstance::FindNewStateToTransitionTo()
   return ezInvalidIndex;
 }
 
+bool ezStateMachineInstance::NeedsTransitionEvaluation() const
+{
+  if (m_bTransitionEvaluationRequested)
+    return true;
+
+  auto pDependencies = GetCurrentTransitionDependencies();
+  if (pDependencies == nullptr)
+    return false;
+
+  if (pDependencies->m_bEvaluateEveryFrame)
+    return true;
+
+  if (pDependencies->m_bBlackboard && m_pBlackboard != nullptr)
+  {
+    if (m_pBlackboard->GetBlackboardChangeCounter() != m_uiEvaluatedBlackboardChangeCounter ||
+        m_pBlackboard->GetBlackboardEntryChangeCounter() != m_uiEvaluatedBlackboardEntryChangeCounter)
+      return true;
+  }
+
+  return m_TimeInCurrentState >= m_NextTransitionTimeout;
+}
+
+const ezStateMachineTransitionDependencies* ezStateMachineInstance::GetCurrentTransitionDependencies() const
+{
+  if (m_pDescription == nullptr)
+    return nullptr;
+
+  if (m_uiCurrentStateIndex != ezInvalidIndex)
+    return &m_pDescription->m_States[m_uiCurrentStateIndex].m_TransitionDependencies;
+
+  // no state or a state that was set directly, only the from any transitions apply
+  return &m_pDescription->m_FromAnyTransitionDependencies;
+}
+
 
 EZ_STATICLINK_FILE(GameEngine, GameEngine_StateMachine_Implementation_StateMachine);
@@ -245,6 +245,17 @@ bool ezStateMachineState_Compound::GetInstanceDataDesc(ezInstanceDataDesc& out_d
   return m_Compound.GetInstanceDataDesc(m_SubStates.GetArrayPtr(), out_desc);
 }
 
+bool ezStateMachineState_Compound::NeedsUpdate() const
+{
+  for (auto pSubState : m_SubStates)
+  {
+    if (pSubState->NeedsUpdate())
+      return true;
+  }
+
+  return false;
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -276,7 +287,7 @@ bool ezStateMachineTransition_BlackboardConditions::IsConditionMet(ezStateMachin
   if (m_Conditions.IsEmpty())
     return true;
 
-  auto pBlackboard = ref_instance.GetBlackboard();
+  const auto& pBlackboard = ref_instance.GetBlackboard();
   if (pBlackboard == nullptr)
     return false;
 
@@ -306,6 +317,14 @@ ezResult ezStateMachineTransition_BlackboardConditions::Deserialize(ezStreamRead
   return inout_stream.ReadArray(m_Conditions);
 }
 
+void ezStateMachineTransition_BlackboardConditions::GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const
+{
+  if (m_Conditions.IsEmpty() == false)
+  {
+    inout_dependencies.m_bBlackboard = true;
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -344,6 +363,11 @@ ezResult ezStateMachineTransition_Timeout::Deserialize(ezStreamReader& inout_str
   return EZ_SUCCESS;
 }
 
+void ezStateMachineTransition_Timeout::GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const
+{
+  inout_dependencies.AddTimeout(m_Timeout);
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -444,5 +468,13 @@ bool ezStateMachineTransition_Compound::GetInstanceDataDesc(ezInstanceDataDesc&
   return m_Compound.GetInstanceDataDesc(m_SubTransitions.GetArrayPtr(), out_desc);
 }
 
+void ezStateMachineTransition_Compound::GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const
+{
+  for (auto pSubTransition : m_SubTransitions)
+  {
+    pSubTransition->GetDependencies(inout_dependencies);
+  }
+}
+
 
 EZ_STATICLINK_FILE(GameEngine, GameEngine_StateMachine_Implementation_StateMachineBuiltins);
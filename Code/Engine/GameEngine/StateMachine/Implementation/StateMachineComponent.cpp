@@ -2,6 +2,8 @@
 
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <GameEngine/Gameplay/BlackboardComponent.h>
 #include <GameEngine/StateMachine/StateMachineComponent.h>
 
@@ -216,8 +218,39 @@ void ezStateMachineComponentManager::Update(const ezWorldModule::UpdateContext&
     m_ComponentsToReload.Clear();
   }
 
-  // update
-  if (GetWorld()->GetWorldSimulationEnabled())
+  if (GetWorld()->GetWorldSimulationEnabled() == false)
+    return;
+
+  // evaluate transitions
+  {
+    EZ_PROFILE_SCOPE("EvaluateTransitions");
+
+    m_InstancesToEvaluate.Clear();
+
+    for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
+    {
+      ComponentType* pComponent = it;
+      if (pComponent->IsActiveAndSimulating() && pComponent->m_pStateMachineInstance != nullptr &&
+          pComponent->m_pStateMachineInstance->CanEvaluateTransitionsInParallel())
+      {
+        m_InstancesToEvaluate.PushBack(pComponent->m_pStateMachineInstance.Borrow());
+      }
+    }
+
+    // instances of the same state machine resource share their description, so evaluate them next to each other
+    m_InstancesToEvaluate.Sort([](const ezStateMachineInstance* a, const ezStateMachineInstance* b)
+      { return a->GetDescription().Borrow() < b->GetDescription().Borrow(); });
+
+    ezTaskSystem::ParallelForIndexed(0, m_InstancesToEvaluate.GetCount(), [this](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+      {
+        for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+        {
+          m_InstancesToEvaluate[i]->EvaluateTransitions();
+        } },
+      "StateMachine.EvaluateTransitions");
+  }
+
+  // update, states can modify the world so this has to happen serially
   {
     for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
     {
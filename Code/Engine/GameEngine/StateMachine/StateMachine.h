@@ -39,6 +39,12 @@ public:
   /// \see ezStateMachineInstanceDataDesc
   virtual bool GetInstanceDataDesc(ezInstanceDataDesc& out_desc);
 
+  /// \brief Returns whether Update() needs to be called while this state is active.
+  ///
+  /// States that only act in OnEnter() and OnExit() should return false, so that instances in that state don't need to call into
+  /// the state every frame.
+  virtual bool NeedsUpdate() const;
+
 private:
   // These are dummy functions for the scripting reflection
   void Reflection_OnEnter(ezStateMachineInstance* pStateMachineInstance, const ezStateMachineState* pFromState);
@@ -60,6 +66,28 @@ struct ezStateMachineState_ScriptBaseClassFunctions
   };
 };
 
+/// \brief Describes what the result of ezStateMachineTransition::IsConditionMet() depends on.
+///
+/// Instances use this to only evaluate the transitions of the current state when one of the dependencies has changed,
+/// instead of polling them every frame.
+struct EZ_GAMEENGINE_DLL ezStateMachineTransitionDependencies
+{
+  /// \brief The result may change at any time, e.g. because it depends on data outside of the state machine instance.
+  bool m_bEvaluateEveryFrame = false;
+
+  /// \brief The result depends on the entries of the instance's blackboard.
+  bool m_bBlackboard = false;
+
+  /// \brief IsConditionMet() only reads shared data, so it may be called for different instances at the same time.
+  bool m_bThreadSafe = true;
+
+  /// \brief The result may change once the time in the current state reaches one of these values. Sorted in ascending order.
+  ezSmallArray<ezTime, 2> m_Timeouts;
+
+  void AddTimeout(ezTime timeout);
+  void Merge(const ezStateMachineTransitionDependencies& other);
+};
+
 /// \brief Base class for a transition in a state machine. The target state of a transition is automatically set
 /// once its condition has been met.
 ///
@@ -79,6 +107,13 @@ class EZ_GAMEENGINE_DLL ezStateMachineTransition : public ezReflectedClass
   ///
   /// \see ezStateMachineInstanceDataDesc
   virtual bool GetInstanceDataDesc(ezInstanceDataDesc& out_desc);
+
+  /// \brief Adds everything that the result of IsConditionMet() depends on to inout_dependencies.
+  ///
+  /// The default implementation requests evaluation every frame and no parallel evaluation, which is always correct.
+  /// Transitions that react to events the state machine doesn't know about (e.g. messages) can also declare no dependencies
+  /// and rely on ezStateMachineInstance::RequestTransitionEvaluation() being called when the event happens.
+  virtual void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const;
 };
 
 /// \brief The state machine description defines the structure of a state machine like e.g.
@@ -96,6 +131,8 @@ public:
   ezUInt32 AddState(ezUniquePtr<ezStateMachineState>&& pState);
 
   /// \brief Adds the given transition between the two given states. A uiFromStateIndex of ezInvalidIndex generates a transition that can be done from any other possible state.
+  ///
+  /// The transition's dependencies are queried here, so it has to be fully set up before it is added.
   void AddTransition(ezUInt32 uiFromStateIndex, ezUInt32 uiToStateIndex, ezUniquePtr<ezStateMachineTransition>&& pTransistion);
 
   ezResult Serialize(ezStreamWriter& inout_stream) const;
@@ -113,12 +150,15 @@ private:
 
   using TransitionArray = ezSmallArray<TransitionContext, 2>;
   TransitionArray m_FromAnyTransitions;
+  ezStateMachineTransitionDependencies m_FromAnyTransitionDependencies;
 
   struct StateContext
   {
     ezUniquePtr<ezStateMachineState> m_pState;
     TransitionArray m_Transitions;
+    ezStateMachineTransitionDependencies m_TransitionDependencies; ///< combined dependencies of m_Transitions and m_FromAnyTransitions
     ezUInt32 m_uiInstanceDataOffset = ezInvalidIndex;
+    bool m_bNeedsUpdate = true;
   };
 
   ezDynamicArray<StateContext> m_States;
@@ -142,9 +182,27 @@ public:
   ezResult SetState(const ezHashedString& sStateName);
   ezResult SetStateOrFallback(const ezHashedString& sStateName, ezUInt32 uiFallbackStateIndex = 0);
   ezStateMachineState* GetCurrentState() { return m_pCurrentState; }
+  ezUInt32 GetCurrentStateIndex() const { return m_uiCurrentStateIndex; }
 
+  /// \brief Transitions to a new state, if a transition condition is met, and then updates the current state.
+  ///
+  /// Transitions are only evaluated when something they depend on has changed, see ezStateMachineTransitionDependencies.
   void Update(ezTime deltaTime);
 
+  /// \brief Evaluates the transitions now and lets the next Update() use the result.
+  ///
+  /// This allows to evaluate the transitions of many instances in parallel before they are updated one by one.
+  /// Only call this from multiple threads when CanEvaluateTransitionsInParallel() returns true.
+  void EvaluateTransitions();
+
+  /// \brief Whether all transitions of the current state allow EvaluateTransitions() to be called from multiple threads.
+  bool CanEvaluateTransitionsInParallel() const;
+
+  /// \brief Makes sure that the transitions are evaluated during the next update, e.g. after an event that a transition depends on.
+  void RequestTransitionEvaluation() { m_bTransitionEvaluationRequested = true; }
+
+  const ezSharedPtr<const ezStateMachineDescription>& GetDescription() const { return m_pDescription; }
+
   ezReflectedClass& GetOwner() { return m_Owner; }
   ezWorld* GetOwnerWorld();
 
@@ -165,6 +223,8 @@ private:
   void EnterCurrentState(const ezStateMachineState* pFromState);
   void ExitCurrentState(const ezStateMachineState* pToState);
   ezUInt32 FindNewStateToTransitionTo();
+  bool NeedsTransitionEvaluation() const;
+  const ezStateMachineTransitionDependencies* GetCurrentTransitionDependencies() const;
 
   EZ_ALWAYS_INLINE void* GetInstanceData(ezUInt32 uiOffset)
   {
@@ -190,6 +250,14 @@ private:
 
   const ezStateMachineDescription::TransitionArray* m_pCurrentTransitions = nullptr;
 
+  // transition evaluation state
+  bool m_bTransitionEvaluationRequested = true;
+  bool m_bTransitionsEvaluated = false;
+  ezUInt32 m_uiEvaluatedStateIndex = ezInvalidIndex;
+  ezUInt32 m_uiEvaluatedBlackboardChangeCounter = 0;
+  ezUInt32 m_uiEvaluatedBlackboardEntryChangeCounter = 0;
+  ezTime m_NextTransitionTimeout = ezTime::MakeFromHours(24 * 365);
+
   ezBlob m_InstanceData;
 };
 
@@ -67,6 +67,7 @@ public:
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
   virtual bool GetInstanceDataDesc(ezInstanceDataDesc& out_desc) override;
+  virtual bool NeedsUpdate() const override;
 
   ezSmallArray<ezStateMachineState*, 2> m_SubStates;
 
@@ -108,6 +109,8 @@ public:
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
+  virtual void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const override;
+
   ezEnum<ezStateMachineLogicOperator> m_Operator;
   ezHybridArray<ezBlackboardCondition, 2> m_Conditions;
 };
@@ -128,6 +131,8 @@ public:
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
+  virtual void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const override;
+
   ezTime m_Timeout;
 };
 
@@ -152,6 +157,8 @@ public:
 
   virtual bool GetInstanceDataDesc(ezInstanceDataDesc& out_desc) override;
 
+  virtual void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const override;
+
   ezEnum<ezStateMachineLogicOperator> m_Operator;
   ezSmallArray<ezStateMachineTransition*, 2> m_SubTransitions;
 
@@ -39,6 +39,8 @@ public:
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
+  virtual bool NeedsUpdate() const override { return false; }
+
   ezTime m_MessageDelay;
 
   bool m_bSendMessageOnEnter = true;
@@ -78,6 +80,8 @@ public:
   virtual ezResult Serialize(ezStreamWriter& inout_stream) const override;
   virtual ezResult Deserialize(ezStreamReader& inout_stream) override;
 
+  virtual bool NeedsUpdate() const override { return false; }
+
   ezString m_sGroupPath;
   ezString m_sObjectToEnable;
   bool m_bDeactivateOthers = true;
@@ -99,6 +103,9 @@ private:
   void ResourceEventHandler(const ezResourceEvent& e);
 
   ezHashSet<ezComponentHandle> m_ComponentsToReload;
+
+  // instances whose transitions are evaluated in parallel, sorted by description
+  ezDynamicArray<ezStateMachineInstance*> m_InstancesToEvaluate;
 };
 
 //////////////////////////////////////////////////////////////////////////
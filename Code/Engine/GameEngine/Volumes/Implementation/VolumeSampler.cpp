@@ -38,6 +38,70 @@ void ezVolumeSampler::DeregisterAllValues()
   m_Values.Clear();
 }
 
+namespace
+{
+  struct VolumeShape
+  {
+    ezSimdMat4f m_GlobalToLocalTransform;
+    ezSimdVec4f m_vFalloff;
+    float m_fMaxScale = 0.0f;
+    bool m_bIsBox = false;
+  };
+
+  void ComputeVolumeShape(const ezVolumeComponent* pComponent, VolumeShape& out_shape)
+  {
+    ezSimdTransform scaledTransform = pComponent->GetOwner()->GetGlobalTransformSimd();
+
+    if (auto pBoxComponent = ezDynamicCast<const ezVolumeBoxComponent*>(pComponent))
+    {
+      scaledTransform.m_Scale = scaledTransform.m_Scale.CompMul(ezSimdConversion::ToVec3(pBoxComponent->GetExtents())) * 0.5f;
+
+      out_shape.m_vFalloff = ezSimdConversion::ToVec3(pBoxComponent->GetFalloff().CompMax(ezVec3(0.0001f)));
+      out_shape.m_bIsBox = true;
+    }
+    else if (auto pSphereComponent = ezDynamicCast<const ezVolumeSphereComponent*>(pComponent))
+    {
+      scaledTransform.m_Scale *= pSphereComponent->GetRadius();
+
+      out_shape.m_vFalloff = ezSimdVec4f(pSphereComponent->GetFalloff());
+      out_shape.m_bIsBox = false;
+    }
+    else
+    {
+      EZ_ASSERT_NOT_IMPLEMENTED;
+    }
+
+    out_shape.m_GlobalToLocalTransform = scaledTransform.GetAsMat4().GetInverse();
+    out_shape.m_fMaxScale = scaledTransform.GetMaxScale();
+  }
+
+  float ComputeAlpha(const VolumeShape& shape, const ezSimdVec4f& vGlobalPos)
+  {
+    const ezSimdVec4f localPos = shape.m_GlobalToLocalTransform.TransformPosition(vGlobalPos);
+
+    if (shape.m_bIsBox)
+    {
+      const ezSimdVec4f absLocalPos = localPos.Abs();
+      if ((absLocalPos <= ezSimdVec4f(1.0f)).AllSet<3>())
+      {
+        ezSimdVec4f vAlpha = (ezSimdVec4f(1.0f) - absLocalPos).CompDiv(shape.m_vFalloff);
+        vAlpha = vAlpha.CompMin(ezSimdVec4f(1.0f)).CompMax(ezSimdVec4f::MakeZero());
+        return vAlpha.x() * vAlpha.y() * vAlpha.z();
+      }
+    }
+    else
+    {
+      const float distSquared = localPos.GetLengthSquared<3>();
+      if (distSquared <= 1.0f)
+      {
+        return ezMath::Saturate((1.0f - ezMath::Sqrt(distSquared)) / shape.m_vFalloff.x());
+      }
+    }
+
+    return 0.0f;
+  }
+} // namespace
+
 void ezVolumeSampler::SampleAtPosition(const ezWorld& world, ezSpatialData::Category spatialCategory, const ezVec3& vGlobalPosition, ezTime deltaTime)
 {
   struct ComponentInfo
@@ -63,44 +127,16 @@ void ezVolumeSampler::SampleAtPosition(const ezWorld& world, ezSpatialData::Cate
       ezVolumeComponent* pComponent = nullptr;
       if (pObject->TryGetComponentOfBaseType(pComponent))
       {
+        VolumeShape shape;
+        ComputeVolumeShape(pComponent, shape);
+
         ComponentInfo info;
         info.m_pComponent = pComponent;
-
-        ezSimdTransform scaledTransform = pComponent->GetOwner()->GetGlobalTransformSimd();
-
-        if (auto pBoxComponent = ezDynamicCast<const ezVolumeBoxComponent*>(pComponent))
-        {
-          scaledTransform.m_Scale = scaledTransform.m_Scale.CompMul(ezSimdConversion::ToVec3(pBoxComponent->GetExtents())) * 0.5f;
-
-          ezSimdMat4f globalToLocalTransform = scaledTransform.GetAsMat4().GetInverse();
-          const ezSimdVec4f absLocalPos = globalToLocalTransform.TransformPosition(vPos).Abs();
-          if ((absLocalPos <= ezSimdVec4f(1.0f)).AllSet<3>())
-          {
-            ezSimdVec4f vAlpha = (ezSimdVec4f(1.0f) - absLocalPos).CompDiv(ezSimdConversion::ToVec3(pBoxComponent->GetFalloff().CompMax(ezVec3(0.0001f))));
-            vAlpha = vAlpha.CompMin(ezSimdVec4f(1.0f)).CompMax(ezSimdVec4f::MakeZero());
-            info.m_fAlpha = vAlpha.x() * vAlpha.y() * vAlpha.z();
-          }
-        }
-        else if (auto pSphereComponent = ezDynamicCast<const ezVolumeSphereComponent*>(pComponent))
-        {
-          scaledTransform.m_Scale *= pSphereComponent->GetRadius();
-
-          ezSimdMat4f globalToLocalTransform = scaledTransform.GetAsMat4().GetInverse();
-          const ezSimdVec4f localPos = globalToLocalTransform.TransformPosition(vPos);
-          const float distSquared = localPos.GetLengthSquared<3>();
-          if (distSquared <= 1.0f)
-          {
-            info.m_fAlpha = ezMath::Saturate((1.0f - ezMath::Sqrt(distSquared)) / pSphereComponent->GetFalloff());
-          }
-        }
-        else
-        {
-          EZ_ASSERT_NOT_IMPLEMENTED;
-        }
+        info.m_fAlpha = ComputeAlpha(shape, vPos);
 
         if (info.m_fAlpha > 0.0f)
         {
-          info.m_uiSortingKey = ComputeSortingKey(pComponent->GetSortOrder(), scaledTransform.GetMaxScale());
+          info.m_uiSortingKey = ComputeSortingKey(pComponent->GetSortOrder(), shape.m_fMaxScale);
 
           componentInfos.PushBack(info);
         }
@@ -150,6 +186,200 @@ void ezVolumeSampler::SampleAtPosition(const ezWorld& world, ezSpatialData::Cate
   }
 }
 
+void ezVolumeSampler::SampleAtPositions(const ezWorld& world, ezSpatialData::Category spatialCategory, ezArrayPtr<const ezVec3> positions, ezArrayPtr<const BatchValue> values) const
+{
+  enum class ResultType : ezUInt8
+  {
+    Float,
+    Vec3,
+    Color,
+  };
+
+  struct VolumeInfo
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    VolumeShape m_Shape;
+    const ezVolumeComponent* m_pComponent;
+    ezUInt32 m_uiSortingKey;
+
+    bool operator<(const VolumeInfo& other) const
+    {
+      return m_uiSortingKey < other.m_uiSortingKey;
+    }
+  };
+
+  struct ValueInfo
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_vDefaultValue;
+    ResultType m_ResultType;
+  };
+
+  struct VolumeValue
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezSimdVec4f m_vValue;
+    bool m_bValid;
+  };
+
+  const ezUInt32 uiNumPositions = positions.GetCount();
+  const ezUInt32 uiNumValues = values.GetCount();
+  if (uiNumPositions == 0 || uiNumValues == 0)
+    return;
+
+  auto ConvertValue = [](const ezVariant& value, ResultType resultType, ezSimdVec4f& out_vValue) -> ezResult
+  {
+    ezResult conversionStatus = EZ_SUCCESS;
+    switch (resultType)
+    {
+      case ResultType::Float:
+        out_vValue = ezSimdVec4f(value.ConvertTo<float>(&conversionStatus));
+        break;
+      case ResultType::Vec3:
+        out_vValue = ezSimdConversion::ToVec3(value.ConvertTo<ezVec3>(&conversionStatus));
+        break;
+      case ResultType::Color:
+      {
+        const ezColor color = value.ConvertTo<ezColor>(&conversionStatus);
+        out_vValue = ezSimdVec4f(color.r, color.g, color.b, color.a);
+        break;
+      }
+    }
+    return conversionStatus;
+  };
+
+  ezHybridArray<ValueInfo, 8, ezAlignedAllocatorWrapper> valueInfos;
+  valueInfos.SetCountUninitialized(uiNumValues);
+
+  for (ezUInt32 v = 0; v < uiNumValues; ++v)
+  {
+    const BatchValue& batchValue = values[v];
+    if (!batchValue.m_FloatResults.IsEmpty())
+    {
+      EZ_ASSERT_DEV(batchValue.m_FloatResults.GetCount() == uiNumPositions, "Result array must hold one element per position");
+      valueInfos[v].m_ResultType = ResultType::Float;
+    }
+    else if (!batchValue.m_Vec3Results.IsEmpty())
+    {
+      EZ_ASSERT_DEV(batchValue.m_Vec3Results.GetCount() == uiNumPositions, "Result array must hold one element per position");
+      valueInfos[v].m_ResultType = ResultType::Vec3;
+    }
+    else
+    {
+      EZ_ASSERT_DEV(batchValue.m_ColorResults.GetCount() == uiNumPositions, "Result array must hold one element per position");
+      valueInfos[v].m_ResultType = ResultType::Color;
+    }
+
+    valueInfos[v].m_vDefaultValue = ezSimdVec4f::MakeZero();
+    if (const Value* pValue = m_Values.GetValue(batchValue.m_sName))
+    {
+      if (ConvertValue(pValue->m_DefaultValue, valueInfos[v].m_ResultType, valueInfos[v].m_vDefaultValue).Failed())
+      {
+        valueInfos[v].m_vDefaultValue = ezSimdVec4f::MakeZero();
+      }
+    }
+  }
+
+  // one query for all positions, the small margin matches the query sphere of SampleAtPosition
+  ezBoundingBox queryBox = ezBoundingBox::MakeFromPoints(positions.GetPtr(), uiNumPositions);
+  queryBox.Grow(ezVec3(0.01f));
+
+  ezSpatialSystem::QueryParams queryParams;
+  queryParams.m_uiCategoryBitmask = spatialCategory.GetBitmask();
+
+  ezHybridArray<VolumeInfo, 16, ezAlignedAllocatorWrapper> volumeInfos;
+  world.GetSpatialSystem()->FindObjectsInBox(queryBox, queryParams, [&](ezGameObject* pObject) {
+      ezVolumeComponent* pComponent = nullptr;
+      if (pObject->TryGetComponentOfBaseType(pComponent))
+      {
+        auto& info = volumeInfos.ExpandAndGetRef();
+        ComputeVolumeShape(pComponent, info.m_Shape);
+        info.m_pComponent = pComponent;
+        info.m_uiSortingKey = ComputeSortingKey(pComponent->GetSortOrder(), info.m_Shape.m_fMaxScale);
+      }
+
+      return ezVisitorExecution::Continue; });
+
+  volumeInfos.Sort();
+
+  // convert the volume values only once instead of once per position
+  const ezUInt32 uiNumVolumes = volumeInfos.GetCount();
+  ezHybridArray<VolumeValue, 64, ezAlignedAllocatorWrapper> volumeValues;
+  volumeValues.SetCountUninitialized(uiNumVolumes * uiNumValues);
+
+  for (ezUInt32 i = 0; i < uiNumVolumes; ++i)
+  {
+    for (ezUInt32 v = 0; v < uiNumValues; ++v)
+    {
+      VolumeValue& volumeValue = volumeValues[i * uiNumValues + v];
+      volumeValue.m_bValid = false;
+
+      ezVariant value = volumeInfos[i].m_pComponent->GetValue(values[v].m_sName);
+      if (value.IsValid() == false)
+        continue;
+
+      if (ConvertValue(value, valueInfos[v].m_ResultType, volumeValue.m_vValue).Failed())
+      {
+        ezLog::Error("VolumeSampler: Can't convert volume value of type '{}'.", value.GetType());
+        continue;
+      }
+
+      volumeValue.m_bValid = true;
+    }
+  }
+
+  ezHybridArray<ezSimdVec4f, 8, ezAlignedAllocatorWrapper> results;
+  results.SetCountUninitialized(uiNumValues);
+
+  for (ezUInt32 p = 0; p < uiNumPositions; ++p)
+  {
+    const ezSimdVec4f vPos = ezSimdConversion::ToVec3(positions[p]);
+
+    for (ezUInt32 v = 0; v < uiNumValues; ++v)
+    {
+      results[v] = valueInfos[v].m_vDefaultValue;
+    }
+
+    for (ezUInt32 i = 0; i < uiNumVolumes; ++i)
+    {
+      const float fAlpha = ComputeAlpha(volumeInfos[i].m_Shape, vPos);
+      if (fAlpha <= 0.0f)
+        continue;
+
+      const ezSimdVec4f vAlpha(fAlpha);
+      const VolumeValue* pVolumeValues = volumeValues.GetData() + i * uiNumValues;
+
+      for (ezUInt32 v = 0; v < uiNumValues; ++v)
+      {
+        if (pVolumeValues[v].m_bValid)
+        {
+          results[v] = results[v] + (pVolumeValues[v].m_vValue - results[v]).CompMul(vAlpha);
+        }
+      }
+    }
+
+    for (ezUInt32 v = 0; v < uiNumValues; ++v)
+    {
+      const BatchValue& batchValue = values[v];
+      switch (valueInfos[v].m_ResultType)
+      {
+        case ResultType::Float:
+          batchValue.m_FloatResults.GetPtr()[p] = results[v].x();
+          break;
+        case ResultType::Vec3:
+          batchValue.m_Vec3Results.GetPtr()[p] = ezSimdConversion::ToVec3(results[v]);
+          break;
+        case ResultType::Color:
+          results[v].Store<4>(batchValue.m_ColorResults.GetPtr()[p].GetData());
+          break;
+      }
+    }
+  }
+}
+
 // static
 ezUInt32 ezVolumeSampler::ComputeSortingKey(float fSortOrder, float fMaxScale)
 {
@@ -17,6 +17,26 @@ public:
 
   void SampleAtPosition(const ezWorld& world, ezSpatialData::Category spatialCategory, const ezVec3& vGlobalPosition, ezTime deltaTime);
 
+  /// \brief Describes where SampleAtPositions() writes the results for one value.
+  ///
+  /// Exactly one of the result arrays has to be set and it must hold one element per sample position.
+  /// Volume values are converted to the type of the result array. Where no volume applies, the registered default value is used,
+  /// or zero if the value is not registered.
+  struct BatchValue
+  {
+    ezTempHashedString m_sName;
+    ezArrayPtr<float> m_FloatResults;
+    ezArrayPtr<ezVec3> m_Vec3Results;
+    ezArrayPtr<ezColor> m_ColorResults;
+  };
+
+  /// \brief Samples the given values at many positions at once, e.g. for all agents of an AI system.
+  ///
+  /// All volumes are gathered with one spatial query over the bounds of all positions and are blended with SIMD instructions
+  /// instead of through ezVariant. The results are the target values that SampleAtPosition() would compute for each position.
+  /// The state of the sampler is not modified and there is no interpolation over time.
+  void SampleAtPositions(const ezWorld& world, ezSpatialData::Category spatialCategory, ezArrayPtr<const ezVec3> positions, ezArrayPtr<const BatchValue> values) const;
+
   ezVariant GetValue(ezTempHashedString sName) const
   {
     if (const Value* pValue = m_Values.GetValue(sName))
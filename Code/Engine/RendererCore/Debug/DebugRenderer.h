@@ -21,6 +21,9 @@ struct ezRenderViewContext;
 /// The 'context' specifies whether shapes are generally visible in a scene, from all views,
 /// or specific to a single view. See the ezDebugRendererContext constructors for what can be implicitly
 /// used as a context.
+///
+/// All draw functions are thread-safe. Worker threads record into thread local buffers, which are merged when the frame is rendered,
+/// so drawing from many threads at once doesn't serialize on a lock (see the 'Debug.DebugRenderer.ThreadLocalRecording' cvar).
 class EZ_RENDERERCORE_DLL ezDebugRenderer
 {
 public:
@@ -186,6 +189,19 @@ public:
   /// If the start and end radius are different, a cone or arrow can be created.
   static void DrawCylinder(const ezDebugRendererContext& context, float fRadiusStart, float fRadiusEnd, float fLength, const ezColor& solidColor, const ezColor& lineColor, const ezTransform& transform, bool bCapStart = false, bool bCapEnd = false);
 
+  struct RenderDataStats
+  {
+    ezUInt32 m_uiNumLines = 0;
+    ezUInt32 m_uiNumTriangles = 0;
+    ezUInt32 m_uiNumLineBoxes = 0;
+    ezUInt32 m_uiNumSolidBoxes = 0;
+  };
+
+  /// \brief Returns how much 3D geometry is rendered for the given context in the frame that is currently rendered.
+  ///
+  /// Geometry that other threads recorded is only included once it was merged at the beginning of rendering.
+  static RenderDataStats GetRenderDataStats(const ezDebugRendererContext& context);
+
 private:
   friend class ezSimpleRenderPass;
 
@@ -2,6 +2,7 @@
 
 #include <Core/Graphics/Geometry.h>
 #include <Core/World/World.h>
+#include <Foundation/Configuration/CVar.h>
 #include <Foundation/Containers/HybridArray.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Debug/SimpleASCIIFont.h>
@@ -26,10 +27,14 @@ ezDebugRendererContext::ezDebugRendererContext(const ezViewHandle& hView)
 
 //////////////////////////////////////////////////////////////////////////
 
+ezCVarBool cvar_DebugRendererThreadLocalRecording("Debug.DebugRenderer.ThreadLocalRecording", true, ezCVarFlags::Default, "Records debug geometry from worker threads into thread local buffers instead of locking a global mutex");
+
 namespace
 {
   struct alignas(16) Vertex
   {
+    EZ_DECLARE_POD_TYPE();
+
     ezVec3 m_position;
     ezColorLinearUB m_color;
   };
@@ -38,6 +43,8 @@ namespace
 
   struct alignas(16) TexVertex
   {
+    EZ_DECLARE_POD_TYPE();
+
     ezVec3 m_position;
     ezColorLinearUB m_color;
     ezVec2 m_texCoord;
@@ -84,6 +91,22 @@ namespace
     ezColor m_color;
   };
 
+  /// \brief A range of textured vertices that use the same texture.
+  struct TexturedTriangleBatch
+  {
+    ezGALResourceViewHandle m_hResourceView;
+    ezUInt32 m_uiFirstVertex;
+    ezUInt32 m_uiNumVertices;
+
+    EZ_ALWAYS_INLINE bool operator<(const TexturedTriangleBatch& other) const
+    {
+      if (m_hResourceView != other.m_hResourceView)
+        return m_hResourceView < other.m_hResourceView;
+
+      return m_uiFirstVertex < other.m_uiFirstVertex;
+    }
+  };
+
   struct PerContextData
   {
     ezDynamicArray<Vertex, ezAlignedAllocatorWrapper> m_lineVertices;
@@ -92,8 +115,10 @@ namespace
     ezDynamicArray<Vertex, ezAlignedAllocatorWrapper> m_line2DVertices;
     ezDynamicArray<BoxData, ezAlignedAllocatorWrapper> m_lineBoxes;
     ezDynamicArray<BoxData, ezAlignedAllocatorWrapper> m_solidBoxes;
-    ezMap<ezGALResourceViewHandle, ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>> m_texTriangle2DVertices;
-    ezMap<ezGALResourceViewHandle, ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>> m_texTriangle3DVertices;
+    ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper> m_texTriangle2DVertices;
+    ezDynamicArray<TexturedTriangleBatch> m_texTriangle2DBatches;
+    ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper> m_texTriangle3DVertices;
+    ezDynamicArray<TexturedTriangleBatch> m_texTriangle3DBatches;
 
     ezDynamicArray<InfoTextData> m_infoTextData[(int)ezDebugRenderer::ScreenPlacement::ENUM_COUNT];
     ezDynamicArray<TextLineData2D> m_textLines2D;
@@ -132,6 +157,27 @@ namespace
     return *pData;
   }
 
+  static void ClearData(PerContextData& ref_data)
+  {
+    ref_data.m_lineVertices.Clear();
+    ref_data.m_line2DVertices.Clear();
+    ref_data.m_lineBoxes.Clear();
+    ref_data.m_solidBoxes.Clear();
+    ref_data.m_triangleVertices.Clear();
+    ref_data.m_triangle2DVertices.Clear();
+    ref_data.m_texTriangle2DVertices.Clear();
+    ref_data.m_texTriangle2DBatches.Clear();
+    ref_data.m_texTriangle3DVertices.Clear();
+    ref_data.m_texTriangle3DBatches.Clear();
+    ref_data.m_textLines2D.Clear();
+    ref_data.m_textLines3D.Clear();
+
+    for (ezUInt32 i = 0; i < (ezUInt32)ezDebugRenderer::ScreenPlacement::ENUM_COUNT; ++i)
+    {
+      ref_data.m_infoTextData[i].Clear();
+    }
+  }
+
   static void ClearRenderData()
   {
     EZ_LOCK(s_Mutex);
@@ -141,28 +187,210 @@ namespace
       PerContextData* pData = it.Value().m_pData[ezRenderWorld::GetDataIndexForRendering()].Borrow();
       if (pData)
       {
-        pData->m_lineVertices.Clear();
-        pData->m_line2DVertices.Clear();
-        pData->m_lineBoxes.Clear();
-        pData->m_solidBoxes.Clear();
-        pData->m_triangleVertices.Clear();
-        pData->m_triangle2DVertices.Clear();
-        pData->m_texTriangle2DVertices.Clear();
-        pData->m_texTriangle3DVertices.Clear();
-        pData->m_textLines2D.Clear();
-        pData->m_textLines3D.Clear();
-
-        for (ezUInt32 i = 0; i < (ezUInt32)ezDebugRenderer::ScreenPlacement::ENUM_COUNT; ++i)
+        ClearData(*pData);
+      }
+    }
+  }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Thread Local Recording
+
+  /// \brief Debug geometry that was drawn by one thread.
+  ///
+  /// Every thread except the render thread records into its own buffers, so draw calls from many worker threads don't contend on s_Mutex.
+  /// The mutex of each thread is only contended while the render thread merges the buffers into s_PerContextData.
+  struct ThreadLocalData
+  {
+    struct ContextData
+    {
+      ezDebugRendererContext m_Context;
+      ezUniquePtr<PerContextData> m_pData;
+    };
+
+    PerContextData& GetData(const ezDebugRendererContext& context, ezUInt32 uiDataIndex)
+    {
+      auto& contexts = m_Contexts[uiDataIndex];
+
+      // there are only ever a few contexts (worlds and views), so a linear search is fastest
+      for (ContextData& contextData : contexts)
+      {
+        if (contextData.m_Context == context)
+          return *contextData.m_pData;
+      }
+
+      ContextData& contextData = contexts.ExpandAndGetRef();
+      contextData.m_Context = context;
+      contextData.m_pData = EZ_DEFAULT_NEW(PerContextData);
+      return *contextData.m_pData;
+    }
+
+    ezMutex m_Mutex;
+    ezHybridArray<ContextData, 4> m_Contexts[2];
+  };
+
+  static ezDynamicArray<ezUniquePtr<ThreadLocalData>> s_ThreadLocalData;
+
+  /// Incremented on shutdown to invalidate the thread local pointers into s_ThreadLocalData.
+  static ezAtomicInteger32 s_iThreadLocalDataGeneration;
+
+  static ThreadLocalData& GetThreadLocalData()
+  {
+    static thread_local ThreadLocalData* tl_pData = nullptr;
+    static thread_local ezInt32 tl_iGeneration = -1;
+
+    if (tl_pData == nullptr || tl_iGeneration != s_iThreadLocalDataGeneration)
+    {
+      EZ_LOCK(s_Mutex);
+
+      s_ThreadLocalData.PushBack(EZ_DEFAULT_NEW(ThreadLocalData));
+      tl_pData = s_ThreadLocalData.PeekBack().Borrow();
+      tl_iGeneration = s_iThreadLocalDataGeneration;
+    }
+
+    return *tl_pData;
+  }
+
+  /// \brief Gives exclusive access to the data that the current thread should draw into.
+  ///
+  /// The render thread and, if thread local recording is disabled, all other threads draw directly into s_PerContextData.
+  class ScopedDataForExtraction
+  {
+  public:
+    ScopedDataForExtraction(const ezDebugRendererContext& context)
+    {
+      if (cvar_DebugRendererThreadLocalRecording && !ezRenderWorld::IsRenderingThread())
+      {
+        ThreadLocalData& threadData = GetThreadLocalData();
+
+        m_pMutex = &threadData.m_Mutex;
+        m_pMutex->Lock();
+        m_pData = &threadData.GetData(context, ezRenderWorld::GetDataIndexForExtraction());
+      }
+      else
+      {
+        m_pMutex = &s_Mutex;
+        m_pMutex->Lock();
+        m_pData = &GetDataForExtraction(context);
+      }
+    }
+
+    ~ScopedDataForExtraction() { m_pMutex->Unlock(); }
+
+    EZ_ALWAYS_INLINE PerContextData& GetData() { return *m_pData; }
+
+  private:
+    ezMutex* m_pMutex = nullptr;
+    PerContextData* m_pData = nullptr;
+  };
+
+  template <typename T>
+  EZ_ALWAYS_INLINE T* AddElements(ezDynamicArray<T, ezAlignedAllocatorWrapper>& ref_elements, ezUInt32 uiNumElements)
+  {
+    const ezUInt32 uiFirstElement = ref_elements.GetCount();
+    ref_elements.SetCountUninitialized(uiFirstElement + uiNumElements);
+    return ref_elements.GetData() + uiFirstElement;
+  }
+
+  static TexVertex* AddTexturedVertices(ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>& ref_vertices, ezDynamicArray<TexturedTriangleBatch>& ref_batches, ezGALResourceViewHandle hResourceView, ezUInt32 uiNumVertices)
+  {
+    const ezUInt32 uiFirstVertex = ref_vertices.GetCount();
+
+    // consecutive draws with the same texture extend the previous batch
+    if (!ref_batches.IsEmpty() && ref_batches.PeekBack().m_hResourceView == hResourceView)
+    {
+      ref_batches.PeekBack().m_uiNumVertices += uiNumVertices;
+    }
+    else
+    {
+      TexturedTriangleBatch& batch = ref_batches.ExpandAndGetRef();
+      batch.m_hResourceView = hResourceView;
+      batch.m_uiFirstVertex = uiFirstVertex;
+      batch.m_uiNumVertices = uiNumVertices;
+    }
+
+    return AddElements(ref_vertices, uiNumVertices);
+  }
+
+  static void AppendTexturedVertices(ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>& ref_vertices, ezDynamicArray<TexturedTriangleBatch>& ref_batches, const ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>& vertices, const ezDynamicArray<TexturedTriangleBatch>& batches)
+  {
+    for (const TexturedTriangleBatch& batch : batches)
+    {
+      TexVertex* pVertices = AddTexturedVertices(ref_vertices, ref_batches, batch.m_hResourceView, batch.m_uiNumVertices);
+      ezMemoryUtils::Copy(pVertices, vertices.GetData() + batch.m_uiFirstVertex, batch.m_uiNumVertices);
+    }
+  }
+
+  /// \brief Sorts the batches by texture and reorders the vertices accordingly, so that there is only one batch per texture.
+  static void SortTexturedBatches(ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper>& ref_vertices, ezDynamicArray<TexturedTriangleBatch>& ref_batches)
+  {
+    if (ref_batches.GetCount() <= 1)
+      return;
+
+    ref_batches.Sort();
+
+    ezDynamicArray<TexVertex, ezAlignedAllocatorWrapper> sortedVertices;
+    ezDynamicArray<TexturedTriangleBatch> sortedBatches;
+    sortedVertices.Reserve(ref_vertices.GetCount());
+
+    AppendTexturedVertices(sortedVertices, sortedBatches, ref_vertices, ref_batches);
+
+    ref_vertices.Swap(sortedVertices);
+    ref_batches.Swap(sortedBatches);
+  }
+
+  static void MergeData(PerContextData& ref_target, const PerContextData& source)
+  {
+    ref_target.m_lineVertices.PushBackRange(source.m_lineVertices);
+    ref_target.m_line2DVertices.PushBackRange(source.m_line2DVertices);
+    ref_target.m_lineBoxes.PushBackRange(source.m_lineBoxes);
+    ref_target.m_solidBoxes.PushBackRange(source.m_solidBoxes);
+    ref_target.m_triangleVertices.PushBackRange(source.m_triangleVertices);
+    ref_target.m_triangle2DVertices.PushBackRange(source.m_triangle2DVertices);
+    AppendTexturedVertices(ref_target.m_texTriangle2DVertices, ref_target.m_texTriangle2DBatches, source.m_texTriangle2DVertices, source.m_texTriangle2DBatches);
+    AppendTexturedVertices(ref_target.m_texTriangle3DVertices, ref_target.m_texTriangle3DBatches, source.m_texTriangle3DVertices, source.m_texTriangle3DBatches);
+    ref_target.m_textLines2D.PushBackRange(source.m_textLines2D);
+    ref_target.m_textLines3D.PushBackRange(source.m_textLines3D);
+
+    for (ezUInt32 i = 0; i < (ezUInt32)ezDebugRenderer::ScreenPlacement::ENUM_COUNT; ++i)
+    {
+      ref_target.m_infoTextData[i].PushBackRange(source.m_infoTextData[i]);
+    }
+  }
+
+  /// \brief Moves everything that was recorded by other threads for the frame that is about to be rendered into s_PerContextData.
+  static void MergeThreadLocalData()
+  {
+    EZ_LOCK(s_Mutex);
+
+    const ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForRendering();
+
+    for (auto& pThreadData : s_ThreadLocalData)
+    {
+      EZ_LOCK(pThreadData->m_Mutex);
+
+      for (auto& contextData : pThreadData->m_Contexts[uiDataIndex])
+      {
+        ezUniquePtr<PerContextData>& pTarget = s_PerContextData[contextData.m_Context].m_pData[uiDataIndex];
+        if (pTarget == nullptr)
         {
-          pData->m_infoTextData[i].Clear();
+          pTarget = EZ_DEFAULT_NEW(PerContextData);
         }
+
+        MergeData(*pTarget, *contextData.m_pData);
+
+        // keep the allocated memory for the next frame
+        ClearData(*contextData.m_pData);
       }
     }
   }
 
   static void OnRenderEvent(const ezRenderWorldRenderEvent& e)
   {
-    if (e.m_Type == ezRenderWorldRenderEvent::Type::EndRender)
+    if (e.m_Type == ezRenderWorldRenderEvent::Type::BeginRender)
+    {
+      MergeThreadLocalData();
+    }
+    else if (e.m_Type == ezRenderWorldRenderEvent::Type::EndRender)
     {
       ClearRenderData();
     }
@@ -322,9 +550,8 @@ namespace
       screenPosY -= lines.GetCount() * fLineHeight;
 
     {
-      EZ_LOCK(s_Mutex);
-
-      auto& data = GetDataForExtraction(context);
+      ScopedDataForExtraction scopedData(context);
+      auto& data = scopedData.GetData();
 
       ezVec2 currentPos(screenPosX, screenPosY);
 
@@ -435,6 +662,17 @@ EZ_BEGIN_SUBSYSTEM_DECLARATION(RendererCore, DebugRenderer)
     "Core"
   END_SUBSYSTEM_DEPENDENCIES
 
+  ON_CORESYSTEMS_STARTUP
+  {
+    // merging and clearing the recorded data doesn't need a device, so it also happens without the high level systems
+    ezRenderWorld::GetRenderEvent().AddEventHandler(&OnRenderEvent);
+  }
+
+  ON_CORESYSTEMS_SHUTDOWN
+  {
+    ezRenderWorld::GetRenderEvent().RemoveEventHandler(&OnRenderEvent);
+  }
+
   ON_HIGHLEVELSYSTEMS_STARTUP
   {
     ezDebugRenderer::OnEngineStartup();
@@ -454,21 +692,17 @@ void ezDebugRenderer::DrawLines(const ezDebugRendererContext& context, ezArrayPt
   if (lines.IsEmpty())
     return;
 
-  EZ_LOCK(s_Mutex);
+  ScopedDataForExtraction scopedData(context);
 
-  auto& data = GetDataForExtraction(context);
+  Vertex* pVertex = AddElements(scopedData.GetData().m_lineVertices, lines.GetCount() * 2);
 
   for (auto& line : lines)
   {
-    const ezVec3* pPositions = &line.m_start;
-    const ezColor* pColors = &line.m_startColor;
-
-    for (ezUInt32 i = 0; i < 2; ++i)
-    {
-      auto& vertex = data.m_lineVertices.ExpandAndGetRef();
-      vertex.m_position = transform.TransformPosition(pPositions[i]);
-      vertex.m_color = pColors[i] * color;
-    }
+    pVertex[0].m_position = transform.TransformPosition(line.m_start);
+    pVertex[0].m_color = line.m_startColor * color;
+    pVertex[1].m_position = transform.TransformPosition(line.m_end);
+    pVertex[1].m_color = line.m_endColor * color;
+    pVertex += 2;
   }
 }
 
@@ -477,20 +711,19 @@ void ezDebugRenderer::Draw2DLines(const ezDebugRendererContext& context, ezArray
   if (lines.IsEmpty())
     return;
 
-  EZ_LOCK(s_Mutex);
+  const ezColorLinearUB lineColor = color;
+
+  ScopedDataForExtraction scopedData(context);
 
-  auto& data = GetDataForExtraction(context);
+  Vertex* pVertex = AddElements(scopedData.GetData().m_line2DVertices, lines.GetCount() * 2);
 
   for (auto& line : lines)
   {
-    const ezVec3* pPositions = &line.m_start;
-
-    for (ezUInt32 i = 0; i < 2; ++i)
-    {
-      auto& vertex = data.m_line2DVertices.ExpandAndGetRef();
-      vertex.m_position = pPositions[i];
-      vertex.m_color = color;
-    }
+    pVertex[0].m_position = line.m_start;
+    pVertex[0].m_color = lineColor;
+    pVertex[1].m_position = line.m_end;
+    pVertex[1].m_color = lineColor;
+    pVertex += 2;
   }
 }
 
@@ -505,33 +738,33 @@ void ezDebugRenderer::DrawCross(const ezDebugRendererContext& context, const ezV
   const ezVec3 yAxis = ezVec3::MakeAxisY() * fHalfLineLength;
   const ezVec3 zAxis = ezVec3::MakeAxisZ() * fHalfLineLength;
 
-  EZ_LOCK(s_Mutex);
+  const ezColorLinearUB lineColor = color;
 
-  auto& data = GetDataForExtraction(context);
+  ScopedDataForExtraction scopedData(context);
 
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition - xAxis), color});
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition + xAxis), color});
+  Vertex* pVertex = AddElements(scopedData.GetData().m_lineVertices, 6);
 
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition - yAxis), color});
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition + yAxis), color});
+  pVertex[0] = {transform.TransformPosition(vGlobalPosition - xAxis), lineColor};
+  pVertex[1] = {transform.TransformPosition(vGlobalPosition + xAxis), lineColor};
 
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition - zAxis), color});
-  data.m_lineVertices.PushBack({transform.TransformPosition(vGlobalPosition + zAxis), color});
+  pVertex[2] = {transform.TransformPosition(vGlobalPosition - yAxis), lineColor};
+  pVertex[3] = {transform.TransformPosition(vGlobalPosition + yAxis), lineColor};
+
+  pVertex[4] = {transform.TransformPosition(vGlobalPosition - zAxis), lineColor};
+  pVertex[5] = {transform.TransformPosition(vGlobalPosition + zAxis), lineColor};
 }
 
 // static
 void ezDebugRenderer::DrawLineBox(const ezDebugRendererContext& context, const ezBoundingBox& box, const ezColor& color, const ezTransform& transform)
 {
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  auto& boxData = data.m_lineBoxes.ExpandAndGetRef();
-
-  ezTransform boxTransform(box.GetCenter(), ezQuat::MakeIdentity(), box.GetHalfExtents());
+  const ezTransform boxTransform(box.GetCenter(), ezQuat::MakeIdentity(), box.GetHalfExtents());
 
+  BoxData boxData;
   boxData.m_transform = transform * boxTransform;
   boxData.m_color = color;
+
+  ScopedDataForExtraction scopedData(context);
+  scopedData.GetData().m_lineBoxes.PushBack(boxData);
 }
 
 // static
@@ -586,33 +819,53 @@ void ezDebugRenderer::DrawLineSphere(const ezDebugRendererContext& context, cons
     NUM_SEGMENTS = 32
   };
 
-  const ezVec3 vCenter = sphere.m_vCenter;
-  const float fRadius = sphere.m_fRadius;
-  const ezAngle stepAngle = ezAngle::MakeFromDegree(360.0f / NUM_SEGMENTS);
+  struct UnitCircle
+  {
+    UnitCircle()
+    {
+      const ezAngle stepAngle = ezAngle::MakeFromDegree(360.0f / NUM_SEGMENTS);
 
-  EZ_LOCK(s_Mutex);
+      for (ezUInt32 s = 0; s <= NUM_SEGMENTS; ++s)
+      {
+        m_Cos[s] = ezMath::Cos((float)s * stepAngle);
+        m_Sin[s] = ezMath::Sin((float)s * stepAngle);
+      }
+    }
 
-  auto& data = GetDataForExtraction(context);
+    float m_Cos[NUM_SEGMENTS + 1];
+    float m_Sin[NUM_SEGMENTS + 1];
+  };
 
-  for (ezUInt32 s = 0; s < NUM_SEGMENTS; ++s)
-  {
-    const float fS1 = (float)s;
-    const float fS2 = (float)(s + 1);
+  static const UnitCircle s_UnitCircle;
 
-    const float fCos1 = ezMath::Cos(fS1 * stepAngle);
-    const float fCos2 = ezMath::Cos(fS2 * stepAngle);
+  const ezVec3 vCenter = sphere.m_vCenter;
+  const float fRadius = sphere.m_fRadius;
+  const ezColorLinearUB lineColor = color;
 
-    const float fSin1 = ezMath::Sin(fS1 * stepAngle);
-    const float fSin2 = ezMath::Sin(fS2 * stepAngle);
+  // transform the points of the three circles once, each point is shared by two lines
+  ezVec3 points[3][NUM_SEGMENTS + 1];
+  for (ezUInt32 s = 0; s <= NUM_SEGMENTS; ++s)
+  {
+    const float fCos = s_UnitCircle.m_Cos[s];
+    const float fSin = s_UnitCircle.m_Sin[s];
 
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(0.0f, fCos1, fSin1) * fRadius), color});
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(0.0f, fCos2, fSin2) * fRadius), color});
+    points[0][s] = transform * (vCenter + ezVec3(0.0f, fCos, fSin) * fRadius);
+    points[1][s] = transform * (vCenter + ezVec3(fCos, 0.0f, fSin) * fRadius);
+    points[2][s] = transform * (vCenter + ezVec3(fCos, fSin, 0.0f) * fRadius);
+  }
+
+  ScopedDataForExtraction scopedData(context);
 
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(fCos1, 0.0f, fSin1) * fRadius), color});
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(fCos2, 0.0f, fSin2) * fRadius), color});
+  Vertex* pVertex = AddElements(scopedData.GetData().m_lineVertices, NUM_SEGMENTS * 6);
 
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(fCos1, fSin1, 0.0f) * fRadius), color});
-    data.m_lineVertices.PushBack({transform * (vCenter + ezVec3(fCos2, fSin2, 0.0f) * fRadius), color});
+  for (ezUInt32 s = 0; s < NUM_SEGMENTS; ++s)
+  {
+    for (ezUInt32 c = 0; c < 3; ++c)
+    {
+      pVertex[0] = {points[c][s], lineColor};
+      pVertex[1] = {points[c][s + 1], lineColor};
+      pVertex += 2;
+    }
   }
 }
 
@@ -783,16 +1036,14 @@ void ezDebugRenderer::DrawLineFrustum(const ezDebugRendererContext& context, con
 // static
 void ezDebugRenderer::DrawSolidBox(const ezDebugRendererContext& context, const ezBoundingBox& box, const ezColor& color, const ezTransform& transform)
 {
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  auto& boxData = data.m_solidBoxes.ExpandAndGetRef();
-
-  ezTransform boxTransform(box.GetCenter(), ezQuat::MakeIdentity(), box.GetHalfExtents());
+  const ezTransform boxTransform(box.GetCenter(), ezQuat::MakeIdentity(), box.GetHalfExtents());
 
+  BoxData boxData;
   boxData.m_transform = transform * boxTransform;
   boxData.m_color = color;
+
+  ScopedDataForExtraction scopedData(context);
+  scopedData.GetData().m_solidBoxes.PushBack(boxData);
 }
 
 // static
@@ -801,9 +1052,9 @@ void ezDebugRenderer::DrawSolidTriangles(const ezDebugRendererContext& context,
   if (triangles.IsEmpty())
     return;
 
-  EZ_LOCK(s_Mutex);
+  ScopedDataForExtraction scopedData(context);
 
-  auto& data = GetDataForExtraction(context);
+  Vertex* pVertex = AddElements(scopedData.GetData().m_triangleVertices, triangles.GetCount() * 3);
 
   for (auto& triangle : triangles)
   {
@@ -811,10 +1062,11 @@ void ezDebugRenderer::DrawSolidTriangles(const ezDebugRendererContext& context,
 
     for (ezUInt32 i = 0; i < 3; ++i)
     {
-      auto& vertex = data.m_triangleVertices.ExpandAndGetRef();
-      vertex.m_position = triangle.m_position[i];
-      vertex.m_color = col;
+      pVertex[i].m_position = triangle.m_position[i];
+      pVertex[i].m_color = col;
     }
+
+    pVertex += 3;
   }
 }
 
@@ -826,9 +1078,10 @@ void ezDebugRenderer::DrawTexturedTriangles(const ezDebugRendererContext& contex
   ezResourceLock<ezTexture2DResource> pTexture(hTexture, ezResourceAcquireMode::AllowLoadingFallback);
   auto hResourceView = ezGALDevice::GetDefaultDevice()->GetDefaultResourceView(pTexture->GetGALTexture());
 
-  EZ_LOCK(s_Mutex);
+  ScopedDataForExtraction scopedData(context);
+  auto& data = scopedData.GetData();
 
-  auto& data = GetDataForExtraction(context).m_texTriangle3DVertices[hResourceView];
+  TexVertex* pVertex = AddTexturedVertices(data.m_texTriangle3DVertices, data.m_texTriangle3DBatches, hResourceView, triangles.GetCount() * 3);
 
   for (auto& triangle : triangles)
   {
@@ -836,11 +1089,12 @@ void ezDebugRenderer::DrawTexturedTriangles(const ezDebugRendererContext& contex
 
     for (ezUInt32 i = 0; i < 3; ++i)
     {
-      auto& vertex = data.ExpandAndGetRef();
-      vertex.m_position = triangle.m_position[i];
-      vertex.m_texCoord = triangle.m_texcoord[i];
-      vertex.m_color = col;
+      pVertex[i].m_position = triangle.m_position[i];
+      pVertex[i].m_texCoord = triangle.m_texcoord[i];
+      pVertex[i].m_color = col;
     }
+
+    pVertex += 3;
   }
 }
 
@@ -861,11 +1115,8 @@ void ezDebugRenderer::Draw2DRectangle(const ezDebugRendererContext& context, con
   }
 
 
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
-  data.m_triangle2DVertices.PushBackRange(ezMakeArrayPtr(vertices));
+  ScopedDataForExtraction scopedData(context);
+  scopedData.GetData().m_triangle2DVertices.PushBackRange(ezMakeArrayPtr(vertices));
 }
 
 void ezDebugRenderer::Draw2DRectangle(const ezDebugRendererContext& context, const ezRectFloat& rectInPixel, float fDepth, const ezColor& color, const ezTexture2DResourceHandle& hTexture, ezVec2 vScale)
@@ -897,11 +1148,11 @@ void ezDebugRenderer::Draw2DRectangle(const ezDebugRendererContext& context, con
   }
 
 
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
+  ScopedDataForExtraction scopedData(context);
+  auto& data = scopedData.GetData();
 
-  data.m_texTriangle2DVertices[hResourceView].PushBackRange(ezMakeArrayPtr(vertices));
+  TexVertex* pVertices = AddTexturedVertices(data.m_texTriangle2DVertices, data.m_texTriangle2DBatches, hResourceView, EZ_ARRAY_SIZE(vertices));
+  ezMemoryUtils::Copy(pVertices, vertices, EZ_ARRAY_SIZE(vertices));
 }
 
 ezUInt32 ezDebugRenderer::Draw2DText(const ezDebugRendererContext& context, const ezFormatString& text, const ezVec2I32& vPositionInPixel, const ezColor& color, ezUInt32 uiSizeInPixel /*= 16*/, HorizontalAlignment horizontalAlignment /*= HorizontalAlignment::Left*/, VerticalAlignment verticalAlignment /*= VerticalAlignment::Top*/)
@@ -917,13 +1168,11 @@ ezUInt32 ezDebugRenderer::Draw2DText(const ezDebugRendererContext& context, cons
 
 void ezDebugRenderer::DrawInfoText(const ezDebugRendererContext& context, ScreenPlacement placement, const char* szGroupName, const ezFormatString& text, const ezColor& color)
 {
-  EZ_LOCK(s_Mutex);
-
-  auto& data = GetDataForExtraction(context);
-
   ezStringBuilder tmp;
 
-  auto& e = data.m_infoTextData[(int)placement].ExpandAndGetRef();
+  ScopedDataForExtraction scopedData(context);
+
+  auto& e = scopedData.GetData().m_infoTextData[(int)placement].ExpandAndGetRef();
   e.m_group = szGroupName;
   e.m_text = text.GetText(tmp);
   e.m_color = color;
@@ -1202,6 +1451,28 @@ void ezDebugRenderer::DrawCylinder(const ezDebugRendererContext& context, float
   DrawLines(context, lines, lineColor, transform);
 }
 
+// static
+ezDebugRenderer::RenderDataStats ezDebugRenderer::GetRenderDataStats(const ezDebugRendererContext& context)
+{
+  EZ_LOCK(s_Mutex);
+
+  RenderDataStats stats;
+
+  DoubleBufferedPerContextData* pDoubleBufferedContextData = nullptr;
+  if (s_PerContextData.TryGetValue(context, pDoubleBufferedContextData))
+  {
+    if (const PerContextData* pData = pDoubleBufferedContextData->m_pData[ezRenderWorld::GetDataIndexForRendering()].Borrow())
+    {
+      stats.m_uiNumLines = pData->m_lineVertices.GetCount() / 2;
+      stats.m_uiNumTriangles = pData->m_triangleVertices.GetCount() / 3;
+      stats.m_uiNumLineBoxes = pData->m_lineBoxes.GetCount();
+      stats.m_uiNumSolidBoxes = pData->m_solidBoxes.GetCount();
+    }
+  }
+
+  return stats;
+}
+
 // static
 void ezDebugRenderer::Render(const ezRenderViewContext& renderViewContext)
 {
@@ -1418,13 +1689,13 @@ void ezDebugRenderer::RenderInternal(const ezDebugRendererContext& context, cons
 
   // Textured 3D triangles
   {
-    for (auto itTex = pData->m_texTriangle3DVertices.GetIterator(); itTex.IsValid(); ++itTex)
-    {
-      renderViewContext.m_pRenderContext->BindTexture2D("BaseTexture", itTex.Key());
+    SortTexturedBatches(pData->m_texTriangle3DVertices, pData->m_texTriangle3DBatches);
 
-      const auto& verts = itTex.Value();
+    for (const TexturedTriangleBatch& batch : pData->m_texTriangle3DBatches)
+    {
+      renderViewContext.m_pRenderContext->BindTexture2D("BaseTexture", batch.m_hResourceView);
 
-      ezUInt32 uiNumVertices = verts.GetCount();
+      ezUInt32 uiNumVertices = batch.m_uiNumVertices;
       if (uiNumVertices != 0)
       {
         CreateVertexBuffer(BufferType::TexTriangles3D, sizeof(TexVertex));
@@ -1432,7 +1703,7 @@ void ezDebugRenderer::RenderInternal(const ezDebugRendererContext& context, cons
         renderViewContext.m_pRenderContext->SetShaderPermutationVariable("PRE_TRANSFORMED_VERTICES", "FALSE");
         renderViewContext.m_pRenderContext->BindShader(s_hDebugTexturedPrimitiveShader);
 
-        const TexVertex* pTriangleData = verts.GetData();
+        const TexVertex* pTriangleData = pData->m_texTriangle3DVertices.GetData() + batch.m_uiFirstVertex;
         while (uiNumVertices > 0)
         {
           const ezUInt32 uiNumVerticesInBatch = ezMath::Min<ezUInt32>(uiNumVertices, TEX_TRIANGLE_VERTICES_PER_BATCH);
@@ -1558,13 +1829,13 @@ void ezDebugRenderer::RenderInternal(const ezDebugRendererContext& context, cons
 
   // Textured 2D triangles
   {
-    for (auto itTex = pData->m_texTriangle2DVertices.GetIterator(); itTex.IsValid(); ++itTex)
-    {
-      renderViewContext.m_pRenderContext->BindTexture2D("BaseTexture", itTex.Key());
+    SortTexturedBatches(pData->m_texTriangle2DVertices, pData->m_texTriangle2DBatches);
 
-      const auto& verts = itTex.Value();
+    for (const TexturedTriangleBatch& batch : pData->m_texTriangle2DBatches)
+    {
+      renderViewContext.m_pRenderContext->BindTexture2D("BaseTexture", batch.m_hResourceView);
 
-      ezUInt32 uiNum2DVertices = verts.GetCount();
+      ezUInt32 uiNum2DVertices = batch.m_uiNumVertices;
       if (uiNum2DVertices != 0)
       {
         CreateVertexBuffer(BufferType::TexTriangles2D, sizeof(TexVertex));
@@ -1572,7 +1843,7 @@ void ezDebugRenderer::RenderInternal(const ezDebugRendererContext& context, cons
         renderViewContext.m_pRenderContext->SetShaderPermutationVariable("PRE_TRANSFORMED_VERTICES", "TRUE");
         renderViewContext.m_pRenderContext->BindShader(s_hDebugTexturedPrimitiveShader);
 
-        const TexVertex* pTriangleData = verts.GetData();
+        const TexVertex* pTriangleData = pData->m_texTriangle2DVertices.GetData() + batch.m_uiFirstVertex;
         while (uiNum2DVertices > 0)
         {
           const ezUInt32 uiNum2DVerticesInBatch = ezMath::Min<ezUInt32>(uiNum2DVertices, TEX_TRIANGLE_VERTICES_PER_BATCH);
@@ -1742,14 +2013,10 @@ void ezDebugRenderer::OnEngineStartup()
   s_hDebugPrimitiveShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Debug/DebugPrimitive.ezShader");
   s_hDebugTexturedPrimitiveShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Debug/DebugTexturedPrimitive.ezShader");
   s_hDebugTextShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Debug/DebugText.ezShader");
-
-  ezRenderWorld::GetRenderEvent().AddEventHandler(&OnRenderEvent);
 }
 
 void ezDebugRenderer::OnEngineShutdown()
 {
-  ezRenderWorld::GetRenderEvent().RemoveEventHandler(&OnRenderEvent);
-
   for (ezUInt32 i = 0; i < BufferType::Count; ++i)
   {
     DestroyBuffer(static_cast<BufferType::Enum>(i));
@@ -1766,6 +2033,12 @@ void ezDebugRenderer::OnEngineShutdown()
 
   s_PerContextData.Clear();
 
+  {
+    EZ_LOCK(s_Mutex);
+    s_iThreadLocalDataGeneration.Increment();
+    s_ThreadLocalData.Clear();
+  }
+
   s_PersistentPerContextData.Clear();
 }
 
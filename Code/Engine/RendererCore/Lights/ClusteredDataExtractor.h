@@ -7,6 +7,8 @@ struct ezPerLightData;
 struct ezPerDecalData;
 struct ezPerReflectionProbeData;
 struct ezPerClusterData;
+struct ezClusteredDataShape;
+struct ezClusterBoundingSphereGroup;
 
 class ezClusteredDataCPU : public ezRenderData
 {
@@ -53,6 +55,7 @@ public:
     const ezView& view, const ezDynamicArray<const ezGameObject*>& visibleObjects, ezExtractedRenderData& ref_extractedRenderData) override;
 
 private:
+  void RasterizeClusters();
   void FillItemListAndClusterData(ezClusteredDataCPU* pData);
 
   template <ezUInt32 MaxData>
@@ -69,7 +72,11 @@ private:
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_LIGHT_DATA>> m_TempLightsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_DECAL_DATA>> m_TempDecalsClusters;
   ezDynamicArray<TempCluster<ezClusteredDataCPU::MAX_REFLECTION_PROBE_DATA>> m_TempReflectionProbeClusters;
-  ezDynamicArray<ezUInt32> m_TempClusterItemList;
+  ezDynamicArray<ezClusteredDataShape, ezAlignedAllocatorWrapper> m_TempLightShapes;
+  ezDynamicArray<ezClusteredDataShape, ezAlignedAllocatorWrapper> m_TempDecalShapes;
+  ezDynamicArray<ezClusteredDataShape, ezAlignedAllocatorWrapper> m_TempReflectionProbeShapes;
+  ezDynamicArray<ezUInt32> m_TempClusterItemCounts;
 
   ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
+  ezDynamicArray<ezClusterBoundingSphereGroup, ezAlignedAllocatorWrapper> m_ClusterBoundingSphereGroups;
 };
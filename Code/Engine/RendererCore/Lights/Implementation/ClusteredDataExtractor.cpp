@@ -3,6 +3,7 @@
 #include <Core/Graphics/Camera.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <RendererCore/Components/FogComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/AmbientLightComponent.h>
@@ -168,6 +169,8 @@ ezClusteredDataExtractor::ezClusteredDataExtractor(const char* szName)
   m_TempDecalsClusters.SetCountUninitialized(NUM_CLUSTERS);
   m_TempReflectionProbeClusters.SetCountUninitialized(NUM_CLUSTERS);
   m_ClusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
+  m_ClusterBoundingSphereGroups.SetCountUninitialized(NUM_CLUSTERS / 4);
+  m_TempClusterItemCounts.SetCountUninitialized(NUM_CLUSTERS);
 }
 
 ezClusteredDataExtractor::~ezClusteredDataExtractor() = default;
@@ -181,6 +184,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   const float fAspectRatio = view.GetViewport().width / view.GetViewport().height;
 
   FillClusterBoundingSpheres(*pCamera, fAspectRatio, m_ClusterBoundingSpheres);
+  FillClusterBoundingSphereGroups(m_ClusterBoundingSpheres, m_ClusterBoundingSphereGroups);
   ezClusteredDataCPU* pData = EZ_NEW(ezFrameAllocator::GetCurrentAllocator(), ezClusteredDataCPU);
   pData->m_ClusterData = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezPerClusterData, NUM_CLUSTERS);
 
@@ -196,7 +200,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   {
     EZ_PROFILE_SCOPE("Lights");
     m_TempLightData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData(), NUM_CLUSTERS);
+    m_TempLightShapes.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Light);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -220,8 +224,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
 
           ezSimdBSphere pointLightSphere =
             ezSimdBSphere(ezSimdConversion::ToVec3(pPointLightRenderData->m_GlobalTransform.m_vPosition), pPointLightRenderData->m_fRange);
-          RasterizeSphere(
-            pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          m_TempLightShapes.PushBack(MakeSphereShape(pointLightSphere, uiLightIndex, viewMatrix, projectionMatrix));
 
           if (false)
           {
@@ -246,13 +249,13 @@ void ezClusteredDataExtractor::PostSortAndBatch(
           cone.m_PositionAndRange.SetW(pSpotLightRenderData->m_fRange);
           cone.m_ForwardDir = ezSimdConversion::ToVec3(pSpotLightRenderData->m_GlobalTransform.m_qRotation * ezVec3(1.0f, 0.0f, 0.0f));
           cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
-          RasterizeSpotLight(cone, uiLightIndex, viewMatrix, projectionMatrix, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          m_TempLightShapes.PushBack(MakeSpotLightShape(cone, uiLightIndex, viewMatrix, projectionMatrix));
         }
         else if (auto pDirLightRenderData = ezDynamicCast<const ezDirectionalLightRenderData*>(it))
         {
           FillDirLightData(m_TempLightData.ExpandAndGetRef(), pDirLightRenderData);
 
-          RasterizeDirLight(pDirLightRenderData, uiLightIndex, m_TempLightsClusters.GetArrayPtr());
+          m_TempLightShapes.PushBack(MakeAllShape(uiLightIndex));
         }
         else if (auto pFogRenderData = ezDynamicCast<const ezFogRenderData*>(it))
         {
@@ -291,7 +294,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   {
     EZ_PROFILE_SCOPE("Decals");
     m_TempDecalData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData(), NUM_CLUSTERS);
+    m_TempDecalShapes.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::Decal);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -313,7 +316,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
         {
           FillDecalData(m_TempDecalData.ExpandAndGetRef(), pDecalRenderData);
 
-          RasterizeBox(pDecalRenderData->m_GlobalTransform, uiDecalIndex, viewProjectionMatrix, m_TempDecalsClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+          m_TempDecalShapes.PushBack(MakeBoxShape(pDecalRenderData->m_GlobalTransform, uiDecalIndex, viewProjectionMatrix));
         }
         else
         {
@@ -330,7 +333,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
   {
     EZ_PROFILE_SCOPE("Probes");
     m_TempReflectionProbeData.Clear();
-    ezMemoryUtils::ZeroFill(m_TempReflectionProbeClusters.GetData(), NUM_CLUSTERS);
+    m_TempReflectionProbeShapes.Clear();
 
     auto batchList = ref_extractedRenderData.GetRenderDataBatchesWithCategory(ezDefaultRenderDataCategories::ReflectionProbe);
     const ezUInt32 uiBatchCount = batchList.GetBatchCount();
@@ -373,8 +376,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
           {
             ezSimdBSphere pointLightSphere =
               ezSimdBSphere(ezSimdConversion::ToVec3(pReflectionProbeRenderData->m_GlobalTransform.m_vPosition), fMaxRadius);
-            RasterizeSphere(
-              pointLightSphere, uiProbeIndex, viewMatrix, projectionMatrix, m_TempReflectionProbeClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            m_TempReflectionProbeShapes.PushBack(MakeSphereShape(pointLightSphere, uiProbeIndex, viewMatrix, projectionMatrix));
           }
           else
           {
@@ -385,7 +387,7 @@ void ezClusteredDataExtractor::PostSortAndBatch(
             //const ezBoundingBox aabb(ezVec3(-1.0f), ezVec3(1.0f));
             //ezDebugRenderer::DrawLineBox(view.GetHandle(), aabb, ezColor::DarkBlue, transform);
 
-            RasterizeBox(transform, uiProbeIndex, viewProjectionMatrix, m_TempReflectionProbeClusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            m_TempReflectionProbeShapes.PushBack(MakeBoxShape(transform, uiProbeIndex, viewProjectionMatrix));
           }
         }
         else
@@ -399,6 +401,8 @@ void ezClusteredDataExtractor::PostSortAndBatch(
     pData->m_ReflectionProbeData.CopyFrom(m_TempReflectionProbeData);
   }
 
+  RasterizeClusters();
+
   FillItemListAndClusterData(pData);
 
   ref_extractedRenderData.AddFrameData(pData);
@@ -408,17 +412,49 @@ void ezClusteredDataExtractor::PostSortAndBatch(
 #endif
 }
 
+void ezClusteredDataExtractor::RasterizeClusters()
+{
+  EZ_PROFILE_SCOPE("RasterizeClusters");
+
+  // Every task covers a range of depth slices, so the tasks write to disjoint clusters and don't need to be synchronized.
+  ezTaskSystem::ParallelForIndexed(
+    0u, static_cast<ezUInt32>(NUM_CLUSTERS_Z), [this](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice)
+    {
+      const ezUInt32 uiFirstCluster = uiStartSlice * NUM_CLUSTERS_XY;
+      const ezUInt32 uiNumClusters = (uiEndSlice - uiStartSlice) * NUM_CLUSTERS_XY;
+
+      ezMemoryUtils::ZeroFill(m_TempLightsClusters.GetData() + uiFirstCluster, uiNumClusters);
+      ezMemoryUtils::ZeroFill(m_TempDecalsClusters.GetData() + uiFirstCluster, uiNumClusters);
+      ezMemoryUtils::ZeroFill(m_TempReflectionProbeClusters.GetData() + uiFirstCluster, uiNumClusters);
+
+      RasterizeShapes(m_TempLightShapes.GetArrayPtr(), uiStartSlice, uiEndSlice, m_TempLightsClusters.GetData(), m_ClusterBoundingSpheres.GetData(), m_ClusterBoundingSphereGroups.GetData());
+      RasterizeShapes(m_TempDecalShapes.GetArrayPtr(), uiStartSlice, uiEndSlice, m_TempDecalsClusters.GetData(), m_ClusterBoundingSpheres.GetData(), m_ClusterBoundingSphereGroups.GetData());
+      RasterizeShapes(m_TempReflectionProbeShapes.GetArrayPtr(), uiStartSlice, uiEndSlice, m_TempReflectionProbeClusters.GetData(), m_ClusterBoundingSpheres.GetData(), m_ClusterBoundingSphereGroups.GetData());
+    },
+    "ClusteredData.Rasterize");
+}
+
 namespace
 {
   ezUInt32 PackIndex(ezUInt32 uiLightIndex, ezUInt32 uiDecalIndex) { return uiDecalIndex << 10 | uiLightIndex; }
 
   ezUInt32 PackReflectionProbeIndex(ezUInt32 uiData, ezUInt32 uiReflectionProbeIndex) { return uiReflectionProbeIndex << 20 | uiData; }
+
+  template <typename Cluster>
+  EZ_ALWAYS_INLINE ezUInt32 CountClusterItems(const Cluster& cluster, ezUInt32 uiMaxBlockIndex)
+  {
+    ezUInt32 uiCount = 0;
+    for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxBlockIndex; ++uiBlockIndex)
+    {
+      uiCount += ezMath::CountBits(cluster.m_BitMask[uiBlockIndex]);
+    }
+    return uiCount;
+  }
 } // namespace
 
 void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pData)
 {
   EZ_PROFILE_SCOPE("FillItemListAndClusterData");
-  m_TempClusterItemList.Clear();
 
   const ezUInt32 uiNumLights = m_TempLightData.GetCount();
   const ezUInt32 uiMaxLightBlockIndex = (uiNumLights + 31) / 32;
@@ -429,108 +465,122 @@ void ezClusteredDataExtractor::FillItemListAndClusterData(ezClusteredDataCPU* pD
   const ezUInt32 uiNumReflectionProbes = m_TempReflectionProbeData.GetCount();
   const ezUInt32 uiMaxReflectionProbeBlockIndex = (uiNumReflectionProbes + 31) / 32;
 
-  const ezUInt32 uiWorstCase = ezMath::Max(uiNumLights, uiNumDecals, uiNumReflectionProbes);
-  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
-  {
-    const ezUInt32 uiOffset = m_TempClusterItemList.GetCount();
-    ezUInt32 uiLightCount = 0;
-
-    // We expand m_TempClusterItemList by the worst case this loop can produce and then cut it down again to the actual size once we have filled the data. This makes sure we do not waste time on boundary checks or potential out of line calls like PushBack or PushBackUnchecked.
-    m_TempClusterItemList.SetCountUninitialized(uiOffset + uiWorstCase);
-    ezUInt32* pTempClusterItemListRange = m_TempClusterItemList.GetData() + uiOffset;
-
-    // Lights
+  // Count the items of every cluster first, so that the offsets into the item list are known up front and the clusters can be filled in parallel.
+  ezTaskSystem::ParallelForIndexed(
+    0u, static_cast<ezUInt32>(NUM_CLUSTERS), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
     {
-      auto& tempCluster = m_TempLightsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
       {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
-
-        while (mask > 0)
-        {
-          ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiLightIndex);
+        const ezUInt32 uiLightCount = CountClusterItems(m_TempLightsClusters[i], uiMaxLightBlockIndex);
+        const ezUInt32 uiDecalCount = CountClusterItems(m_TempDecalsClusters[i], uiMaxDecalBlockIndex);
+        const ezUInt32 uiReflectionProbeCount = CountClusterItems(m_TempReflectionProbeClusters[i], uiMaxReflectionProbeBlockIndex);
 
-          uiLightIndex += uiBlockIndex * 32;
-          pTempClusterItemListRange[uiLightCount] = uiLightIndex;
-          ++uiLightCount;
-        }
+        m_TempClusterItemCounts[i] = ezMath::Max(uiLightCount, uiDecalCount, uiReflectionProbeCount);
+        pData->m_ClusterData[i].counts = PackReflectionProbeIndex(PackIndex(uiLightCount, uiDecalCount), uiReflectionProbeCount);
       }
-    }
+    },
+    "ClusteredData.CountItems");
 
-    ezUInt32 uiDecalCount = 0;
+  ezUInt32 uiNumItems = 0;
+  for (ezUInt32 i = 0; i < NUM_CLUSTERS; ++i)
+  {
+    pData->m_ClusterData[i].offset = uiNumItems;
+    uiNumItems += m_TempClusterItemCounts[i];
+  }
+
+  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, uiNumItems);
 
-    // Decals
+  ezTaskSystem::ParallelForIndexed(
+    0u, static_cast<ezUInt32>(NUM_CLUSTERS), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
     {
-      auto& tempCluster = m_TempDecalsClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
       {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+        ezUInt32* pClusterItemListRange = pData->m_ClusterItemList.GetPtr() + pData->m_ClusterData[i].offset;
+        ezUInt32 uiLightCount = 0;
 
-        while (mask > 0)
+        // Lights
         {
-          ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiDecalIndex);
+          auto& tempCluster = m_TempLightsClusters[i];
+          for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxLightBlockIndex; ++uiBlockIndex)
+          {
+            ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
-          uiDecalIndex += uiBlockIndex * 32;
+            while (mask > 0)
+            {
+              ezUInt32 uiLightIndex = ezMath::FirstBitLow(mask);
+              mask &= ~(1 << uiLightIndex);
 
-          if (uiDecalCount < uiLightCount)
-          {
-            auto& item = pTempClusterItemListRange[uiDecalCount];
-            item = PackIndex(item, uiDecalIndex);
-          }
-          else
-          {
-            pTempClusterItemListRange[uiDecalCount] = PackIndex(0, uiDecalIndex);
+              uiLightIndex += uiBlockIndex * 32;
+              pClusterItemListRange[uiLightCount] = uiLightIndex;
+              ++uiLightCount;
+            }
           }
-
-          ++uiDecalCount;
         }
-      }
-    }
 
-    ezUInt32 uiReflectionProbeCount = 0;
-    const ezUInt32 uiMaxUsed = ezMath::Max(uiLightCount, uiDecalCount);
-    // Reflection Probes
-    {
-      auto& tempCluster = m_TempReflectionProbeClusters[i];
-      for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxReflectionProbeBlockIndex; ++uiBlockIndex)
-      {
-        ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+        ezUInt32 uiDecalCount = 0;
 
-        while (mask > 0)
+        // Decals
         {
-          ezUInt32 uiReflectionProbeIndex = ezMath::FirstBitLow(mask);
-          mask &= ~(1 << uiReflectionProbeIndex);
-
-          uiReflectionProbeIndex += uiBlockIndex * 32;
-
-          if (uiReflectionProbeCount < uiMaxUsed)
+          auto& tempCluster = m_TempDecalsClusters[i];
+          for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxDecalBlockIndex; ++uiBlockIndex)
           {
-            auto& item = pTempClusterItemListRange[uiReflectionProbeCount];
-            item = PackReflectionProbeIndex(item, uiReflectionProbeIndex);
+            ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
+
+            while (mask > 0)
+            {
+              ezUInt32 uiDecalIndex = ezMath::FirstBitLow(mask);
+              mask &= ~(1 << uiDecalIndex);
+
+              uiDecalIndex += uiBlockIndex * 32;
+
+              if (uiDecalCount < uiLightCount)
+              {
+                auto& item = pClusterItemListRange[uiDecalCount];
+                item = PackIndex(item, uiDecalIndex);
+              }
+              else
+              {
+                pClusterItemListRange[uiDecalCount] = PackIndex(0, uiDecalIndex);
+              }
+
+              ++uiDecalCount;
+            }
           }
-          else
+        }
+
+        ezUInt32 uiReflectionProbeCount = 0;
+        const ezUInt32 uiMaxUsed = ezMath::Max(uiLightCount, uiDecalCount);
+        // Reflection Probes
+        {
+          auto& tempCluster = m_TempReflectionProbeClusters[i];
+          for (ezUInt32 uiBlockIndex = 0; uiBlockIndex < uiMaxReflectionProbeBlockIndex; ++uiBlockIndex)
           {
-            pTempClusterItemListRange[uiReflectionProbeCount] = PackReflectionProbeIndex(0, uiReflectionProbeIndex);
-          }
+            ezUInt32 mask = tempCluster.m_BitMask[uiBlockIndex];
 
-          ++uiReflectionProbeCount;
+            while (mask > 0)
+            {
+              ezUInt32 uiReflectionProbeIndex = ezMath::FirstBitLow(mask);
+              mask &= ~(1 << uiReflectionProbeIndex);
+
+              uiReflectionProbeIndex += uiBlockIndex * 32;
+
+              if (uiReflectionProbeCount < uiMaxUsed)
+              {
+                auto& item = pClusterItemListRange[uiReflectionProbeCount];
+                item = PackReflectionProbeIndex(item, uiReflectionProbeIndex);
+              }
+              else
+              {
+                pClusterItemListRange[uiReflectionProbeCount] = PackReflectionProbeIndex(0, uiReflectionProbeIndex);
+              }
+
+              ++uiReflectionProbeCount;
+            }
+          }
         }
       }
-    }
-
-    // Cut down the array to the actual number of elements we have written.
-    const ezUInt32 uiActualCase = ezMath::Max(uiLightCount, uiDecalCount, uiReflectionProbeCount);
-    m_TempClusterItemList.SetCountUninitialized(uiOffset + uiActualCase);
-
-    auto& clusterData = pData->m_ClusterData[i];
-    clusterData.offset = uiOffset;
-    clusterData.counts = PackReflectionProbeIndex(PackIndex(uiLightCount, uiDecalCount), uiReflectionProbeCount);
-  }
-
-  pData->m_ClusterItemList = EZ_NEW_ARRAY(ezFrameAllocator::GetCurrentAllocator(), ezUInt32, m_TempClusterItemList.GetCount());
-  pData->m_ClusterItemList.CopyFrom(m_TempClusterItemList);
+    },
+    "ClusteredData.FillItemList");
 }
 
 
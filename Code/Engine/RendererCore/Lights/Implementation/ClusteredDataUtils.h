@@ -19,6 +19,38 @@ EZ_DEFINE_AS_POD_TYPE(ezPerClusterData);
 #include <Foundation/SimdMath/SimdVec4i.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
+/// \brief The bounding spheres of four neighboring clusters along x in SoA layout, so a shape can be tested against all four at once.
+struct ezClusterBoundingSphereGroup
+{
+  EZ_DECLARE_POD_TYPE();
+
+  ezSimdVec4f m_CenterX;
+  ezSimdVec4f m_CenterY;
+  ezSimdVec4f m_CenterZ;
+  ezSimdVec4f m_Radius;
+};
+
+static_assert(NUM_CLUSTERS_X % 4 == 0, "Cluster bounding sphere groups must not cross rows");
+
+/// \brief A light, decal or reflection probe prepared for rasterization into the clusters.
+///
+/// All shapes of a view are collected first, so that the clusters can then be filled in parallel with every task covering a range of depth slices.
+struct ezClusteredDataShape
+{
+  enum Type : ezUInt8
+  {
+    Sphere,    ///< m_Params[0] is the center and radius.
+    SpotLight, ///< m_Params[0] is the position and range, m_Params[1] the forward direction and m_Params[2] the sine and cosine of the half angle.
+    Box,       ///< m_Params are the columns of the world to box matrix.
+    All,       ///< Affects all clusters, e.g. a directional light.
+  };
+
+  ezSimdBBox m_ScreenSpaceBounds;
+  ezSimdVec4f m_Params[4];
+  ezUInt32 m_uiIndex = 0;
+  Type m_Type = All;
+};
+
 namespace
 {
   ///\todo Make this configurable.
@@ -299,8 +331,17 @@ namespace
     return ezSimdBBox(mi, ma);
   }
 
-  template <typename Cluster, typename IntersectionFunc>
-  EZ_FORCE_INLINE void FillCluster(const ezSimdBBox& screenSpaceBounds, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters, IntersectionFunc func)
+  struct ClusterRange
+  {
+    ezUInt32 m_uiMinX;
+    ezUInt32 m_uiMaxX;
+    ezUInt32 m_uiMinY;
+    ezUInt32 m_uiMaxY;
+    ezUInt32 m_uiMinZ;
+    ezUInt32 m_uiMaxZ;
+  };
+
+  EZ_FORCE_INLINE ClusterRange GetClusterRange(const ezSimdBBox& screenSpaceBounds)
   {
     ezSimdVec4f scale = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, -0.5f * NUM_CLUSTERS_Y, 1.0f, 1.0f);
     ezSimdVec4f bias = ezSimdVec4f(0.5f * NUM_CLUSTERS_X, 0.5f * NUM_CLUSTERS_Y, 0.0f, 0.0f);
@@ -323,11 +364,17 @@ namespace
     ezUInt32 zMin = GetSliceIndexFromDepth(screenSpaceBounds.m_Min.z());
     ezUInt32 zMax = GetSliceIndexFromDepth(screenSpaceBounds.m_Max.z());
 
-    for (ezUInt32 z = zMin; z <= zMax; ++z)
+    return {xMin, xMax, yMin, yMax, zMin, zMax};
+  }
+
+  template <typename Cluster, typename IntersectionFunc>
+  EZ_FORCE_INLINE void FillCluster(const ClusterRange& range, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters, IntersectionFunc func)
+  {
+    for (ezUInt32 z = range.m_uiMinZ; z <= range.m_uiMaxZ; ++z)
     {
-      for (ezUInt32 y = yMin; y <= yMax; ++y)
+      for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
       {
-        for (ezUInt32 x = xMin; x <= xMax; ++x)
+        for (ezUInt32 x = range.m_uiMinX; x <= range.m_uiMaxX; ++x)
         {
           ezUInt32 uiClusterIndex = GetClusterIndexFromCoord(x, y, z);
           if (func(uiClusterIndex))
@@ -348,7 +395,7 @@ namespace
     const ezUInt32 uiBlockIndex = uiLightIndex / 32;
     const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters,
+    FillCluster(GetClusterRange(screenSpaceBounds), uiBlockIndex, uiMask, pClusters,
       [&](ezUInt32 uiClusterIndex) { return pointLightSphere.Overlaps(pClusterBoundingSpheres[uiClusterIndex]); });
   }
 
@@ -360,17 +407,14 @@ namespace
     ezSimdVec4f m_SinCosAngle;
   };
 
-  template <typename Cluster>
-  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix,
-    const ezSimdMat4f& mProjectionMatrix, Cluster* pClusters, ezSimdBSphere* pClusterBoundingSpheres)
+  EZ_FORCE_INLINE ezSimdBSphere GetConeBoundingSphere(const BoundingCone& cone)
   {
-    ezSimdVec4f position = spotLightCone.m_PositionAndRange;
-    ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
-    ezSimdVec4f forwardDir = spotLightCone.m_ForwardDir;
-    ezSimdFloat sinAngle = spotLightCone.m_SinCosAngle.x();
-    ezSimdFloat cosAngle = spotLightCone.m_SinCosAngle.y();
+    ezSimdVec4f position = cone.m_PositionAndRange;
+    ezSimdFloat range = cone.m_PositionAndRange.w();
+    ezSimdVec4f forwardDir = cone.m_ForwardDir;
+    ezSimdFloat sinAngle = cone.m_SinCosAngle.x();
+    ezSimdFloat cosAngle = cone.m_SinCosAngle.y();
 
-    // First calculate a bounding sphere around the cone to get min and max bounds
     ezSimdVec4f bSphereCenter;
     ezSimdFloat bSphereRadius;
     if (sinAngle > 0.707107f) // sin(45)
@@ -384,13 +428,27 @@ namespace
       bSphereCenter = position + forwardDir * bSphereRadius;
     }
 
-    ezSimdBSphere spotLightSphere(bSphereCenter, bSphereRadius);
+    return ezSimdBSphere(bSphereCenter, bSphereRadius);
+  }
+
+  template <typename Cluster>
+  void RasterizeSpotLight(const BoundingCone& spotLightCone, ezUInt32 uiLightIndex, const ezSimdMat4f& mViewMatrix,
+    const ezSimdMat4f& mProjectionMatrix, Cluster* pClusters, ezSimdBSphere* pClusterBoundingSpheres)
+  {
+    ezSimdVec4f position = spotLightCone.m_PositionAndRange;
+    ezSimdFloat range = spotLightCone.m_PositionAndRange.w();
+    ezSimdVec4f forwardDir = spotLightCone.m_ForwardDir;
+    ezSimdFloat sinAngle = spotLightCone.m_SinCosAngle.x();
+    ezSimdFloat cosAngle = spotLightCone.m_SinCosAngle.y();
+
+    // First calculate a bounding sphere around the cone to get min and max bounds
+    ezSimdBSphere spotLightSphere = GetConeBoundingSphere(spotLightCone);
     ezSimdBBox screenSpaceBounds = GetScreenSpaceBounds(spotLightSphere, mViewMatrix, mProjectionMatrix);
 
     const ezUInt32 uiBlockIndex = uiLightIndex / 32;
     const ezUInt32 uiMask = 1 << (uiLightIndex - uiBlockIndex * 32);
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex) {
+    FillCluster(GetClusterRange(screenSpaceBounds), uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex) {
       ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
       ezSimdFloat clusterRadius = clusterSphere.GetRadius();
 
@@ -418,17 +476,12 @@ namespace
     }
   }
 
-  template <typename Cluster>
-  void RasterizeBox(const ezTransform& transform, ezUInt32 uiDecalIndex, const ezSimdMat4f& mViewProjectionMatrix, Cluster* pClusters,
-    ezSimdBSphere* pClusterBoundingSpheres)
+  EZ_FORCE_INLINE ezSimdBBox GetBoxScreenSpaceBounds(const ezSimdMat4f& mDecalToWorld, const ezSimdMat4f& mViewProjectionMatrix)
   {
-    ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(transform).GetAsMat4();
-    ezSimdMat4f worldToDecal = decalToWorld.GetInverse();
-
     ezVec3 corners[8];
     ezBoundingBox::MakeFromMinMax(ezVec3(-1), ezVec3(1)).GetCorners(corners);
 
-    ezSimdMat4f decalToScreen = mViewProjectionMatrix * decalToWorld;
+    ezSimdMat4f decalToScreen = mViewProjectionMatrix * mDecalToWorld;
     ezSimdBBox screenSpaceBounds = ezSimdBBox::MakeInvalid();
     bool bInsideBox = false;
     for (ezUInt32 i = 0; i < 8; ++i)
@@ -451,16 +504,218 @@ namespace
       screenSpaceBounds.m_Max = ezSimdVec4f(1.0f).GetCombined<ezSwizzle::XYZW>(screenSpaceBounds.m_Max);
     }
 
+    return screenSpaceBounds;
+  }
+
+  template <typename Cluster>
+  void RasterizeBox(const ezTransform& transform, ezUInt32 uiDecalIndex, const ezSimdMat4f& mViewProjectionMatrix, Cluster* pClusters,
+    ezSimdBSphere* pClusterBoundingSpheres)
+  {
+    ezSimdMat4f decalToWorld = ezSimdConversion::ToTransform(transform).GetAsMat4();
+    ezSimdMat4f worldToDecal = decalToWorld.GetInverse();
+
+    ezSimdBBox screenSpaceBounds = GetBoxScreenSpaceBounds(decalToWorld, mViewProjectionMatrix);
+
     ezSimdVec4f decalHalfExtents = ezSimdVec4f(1.0f);
     ezSimdBBox localDecalBounds = ezSimdBBox(-decalHalfExtents, decalHalfExtents);
 
     const ezUInt32 uiBlockIndex = uiDecalIndex / 32;
     const ezUInt32 uiMask = 1 << (uiDecalIndex - uiBlockIndex * 32);
 
-    FillCluster(screenSpaceBounds, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex) {
+    FillCluster(GetClusterRange(screenSpaceBounds), uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex) {
       ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
       clusterSphere.Transform(worldToDecal);
 
       return localDecalBounds.Overlaps(clusterSphere); });
   }
+
+  //////////////////////////////////////////////////////////////////////////
+  // Batched rasterization
+  //
+  // The functions above rasterize one item at a time into all clusters it touches. The functions below do the same for a whole list of
+  // shapes, but only for a range of depth slices, so that multiple tasks can fill disjoint parts of the cluster array without any
+  // synchronization. Spheres and spot lights are tested against four clusters at once. The results are bit-identical to the functions above.
+
+  void FillClusterBoundingSphereGroups(ezArrayPtr<const ezSimdBSphere> clusterBoundingSpheres, ezArrayPtr<ezClusterBoundingSphereGroup> groups)
+  {
+    EZ_ASSERT_DEBUG(clusterBoundingSpheres.GetCount() == groups.GetCount() * 4, "Invalid number of cluster bounding sphere groups");
+
+    for (ezUInt32 i = 0; i < groups.GetCount(); ++i)
+    {
+      const ezSimdBSphere* pSpheres = clusterBoundingSpheres.GetPtr() + i * 4;
+      const ezSimdMat4f transposed = ezSimdMat4f::MakeFromColumns(pSpheres[0].m_CenterAndRadius, pSpheres[1].m_CenterAndRadius,
+        pSpheres[2].m_CenterAndRadius, pSpheres[3].m_CenterAndRadius)
+                                       .GetTranspose();
+
+      auto& group = groups[i];
+      group.m_CenterX = transposed.m_col0;
+      group.m_CenterY = transposed.m_col1;
+      group.m_CenterZ = transposed.m_col2;
+      group.m_Radius = transposed.m_col3;
+    }
+  }
+
+  ezClusteredDataShape MakeSphereShape(const ezSimdBSphere& sphere, ezUInt32 uiIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix)
+  {
+    ezClusteredDataShape shape;
+    shape.m_ScreenSpaceBounds = GetScreenSpaceBounds(sphere, mViewMatrix, mProjectionMatrix);
+    shape.m_Params[0] = sphere.m_CenterAndRadius;
+    shape.m_uiIndex = uiIndex;
+    shape.m_Type = ezClusteredDataShape::Sphere;
+    return shape;
+  }
+
+  ezClusteredDataShape MakeSpotLightShape(const BoundingCone& cone, ezUInt32 uiIndex, const ezSimdMat4f& mViewMatrix, const ezSimdMat4f& mProjectionMatrix)
+  {
+    ezClusteredDataShape shape;
+    shape.m_ScreenSpaceBounds = GetScreenSpaceBounds(GetConeBoundingSphere(cone), mViewMatrix, mProjectionMatrix);
+    shape.m_Params[0] = cone.m_PositionAndRange;
+    shape.m_Params[1] = cone.m_ForwardDir;
+    shape.m_Params[2] = cone.m_SinCosAngle;
+    shape.m_uiIndex = uiIndex;
+    shape.m_Type = ezClusteredDataShape::SpotLight;
+    return shape;
+  }
+
+  ezClusteredDataShape MakeBoxShape(const ezTransform& transform, ezUInt32 uiIndex, const ezSimdMat4f& mViewProjectionMatrix)
+  {
+    const ezSimdMat4f boxToWorld = ezSimdConversion::ToTransform(transform).GetAsMat4();
+    const ezSimdMat4f worldToBox = boxToWorld.GetInverse();
+
+    ezClusteredDataShape shape;
+    shape.m_ScreenSpaceBounds = GetBoxScreenSpaceBounds(boxToWorld, mViewProjectionMatrix);
+    shape.m_Params[0] = worldToBox.m_col0;
+    shape.m_Params[1] = worldToBox.m_col1;
+    shape.m_Params[2] = worldToBox.m_col2;
+    shape.m_Params[3] = worldToBox.m_col3;
+    shape.m_uiIndex = uiIndex;
+    shape.m_Type = ezClusteredDataShape::Box;
+    return shape;
+  }
+
+  ezClusteredDataShape MakeAllShape(ezUInt32 uiIndex)
+  {
+    ezClusteredDataShape shape;
+    shape.m_uiIndex = uiIndex;
+    shape.m_Type = ezClusteredDataShape::All;
+    return shape;
+  }
+
+  template <typename Cluster, typename IntersectionFunc>
+  EZ_FORCE_INLINE void FillClusterGroups(const ClusterRange& range, ezUInt32 uiBlockIndex, ezUInt32 uiMask, Cluster* pClusters,
+    const ezClusterBoundingSphereGroup* pClusterBoundingSphereGroups, IntersectionFunc func)
+  {
+    const ezUInt32 uiMinGroupX = range.m_uiMinX / 4;
+    const ezUInt32 uiMaxGroupX = range.m_uiMaxX / 4;
+
+    for (ezUInt32 z = range.m_uiMinZ; z <= range.m_uiMaxZ; ++z)
+    {
+      for (ezUInt32 y = range.m_uiMinY; y <= range.m_uiMaxY; ++y)
+      {
+        for (ezUInt32 uiGroupX = uiMinGroupX; uiGroupX <= uiMaxGroupX; ++uiGroupX)
+        {
+          const ezUInt32 uiFirstClusterIndex = GetClusterIndexFromCoord(uiGroupX * 4, y, z);
+          const ezSimdVec4b overlaps = func(pClusterBoundingSphereGroups[uiFirstClusterIndex / 4]);
+          if (!overlaps.AnySet())
+            continue;
+
+          const bool laneOverlaps[4] = {overlaps.x(), overlaps.y(), overlaps.z(), overlaps.w()};
+          for (ezUInt32 uiLane = 0; uiLane < 4; ++uiLane)
+          {
+            const ezUInt32 x = uiGroupX * 4 + uiLane;
+            if (laneOverlaps[uiLane] && x >= range.m_uiMinX && x <= range.m_uiMaxX)
+            {
+              pClusters[uiFirstClusterIndex + uiLane].m_BitMask[uiBlockIndex] |= uiMask;
+            }
+          }
+        }
+      }
+    }
+  }
+
+  /// Rasterizes the given shapes into the depth slices [uiFirstSlice, uiEndSlice). Clusters outside of these slices are not touched.
+  template <typename Cluster>
+  void RasterizeShapes(ezArrayPtr<const ezClusteredDataShape> shapes, ezUInt32 uiFirstSlice, ezUInt32 uiEndSlice, Cluster* pClusters,
+    const ezSimdBSphere* pClusterBoundingSpheres, const ezClusterBoundingSphereGroup* pClusterBoundingSphereGroups)
+  {
+    for (const ezClusteredDataShape& shape : shapes)
+    {
+      const ezUInt32 uiBlockIndex = shape.m_uiIndex / 32;
+      const ezUInt32 uiMask = 1 << (shape.m_uiIndex - uiBlockIndex * 32);
+
+      if (shape.m_Type == ezClusteredDataShape::All)
+      {
+        for (ezUInt32 i = uiFirstSlice * NUM_CLUSTERS_XY; i < uiEndSlice * NUM_CLUSTERS_XY; ++i)
+        {
+          pClusters[i].m_BitMask[uiBlockIndex] |= uiMask;
+        }
+
+        continue;
+      }
+
+      ClusterRange range = GetClusterRange(shape.m_ScreenSpaceBounds);
+      range.m_uiMinZ = ezMath::Max(range.m_uiMinZ, uiFirstSlice);
+      range.m_uiMaxZ = ezMath::Min(range.m_uiMaxZ, uiEndSlice - 1);
+
+      if (range.m_uiMinZ > range.m_uiMaxZ)
+        continue;
+
+      if (shape.m_Type == ezClusteredDataShape::Sphere)
+      {
+        const ezSimdVec4f centerX = shape.m_Params[0].Get<ezSwizzle::XXXX>();
+        const ezSimdVec4f centerY = shape.m_Params[0].Get<ezSwizzle::YYYY>();
+        const ezSimdVec4f centerZ = shape.m_Params[0].Get<ezSwizzle::ZZZZ>();
+        const ezSimdVec4f radius = shape.m_Params[0].Get<ezSwizzle::WWWW>();
+
+        // same operations as ezSimdBSphere::Overlaps
+        FillClusterGroups(range, uiBlockIndex, uiMask, pClusters, pClusterBoundingSphereGroups, [&](const ezClusterBoundingSphereGroup& group) {
+          const ezSimdVec4f dx = group.m_CenterX - centerX;
+          const ezSimdVec4f dy = group.m_CenterY - centerY;
+          const ezSimdVec4f dz = group.m_CenterZ - centerZ;
+          const ezSimdVec4f distSquared = (dx.CompMul(dx) + dy.CompMul(dy)) + dz.CompMul(dz);
+          const ezSimdVec4f combinedRadius = group.m_Radius + radius;
+
+          return distSquared < combinedRadius.CompMul(combinedRadius); });
+      }
+      else if (shape.m_Type == ezClusteredDataShape::SpotLight)
+      {
+        const ezSimdVec4f positionX = shape.m_Params[0].Get<ezSwizzle::XXXX>();
+        const ezSimdVec4f positionY = shape.m_Params[0].Get<ezSwizzle::YYYY>();
+        const ezSimdVec4f positionZ = shape.m_Params[0].Get<ezSwizzle::ZZZZ>();
+        const ezSimdVec4f range4 = shape.m_Params[0].Get<ezSwizzle::WWWW>();
+        const ezSimdVec4f forwardX = shape.m_Params[1].Get<ezSwizzle::XXXX>();
+        const ezSimdVec4f forwardY = shape.m_Params[1].Get<ezSwizzle::YYYY>();
+        const ezSimdVec4f forwardZ = shape.m_Params[1].Get<ezSwizzle::ZZZZ>();
+        const ezSimdVec4f sinAngle = shape.m_Params[2].Get<ezSwizzle::XXXX>();
+        const ezSimdVec4f cosAngle = shape.m_Params[2].Get<ezSwizzle::YYYY>();
+
+        // same operations as the cluster test in RasterizeSpotLight
+        FillClusterGroups(range, uiBlockIndex, uiMask, pClusters, pClusterBoundingSphereGroups, [&](const ezClusterBoundingSphereGroup& group) {
+          const ezSimdVec4f toConePosX = group.m_CenterX - positionX;
+          const ezSimdVec4f toConePosY = group.m_CenterY - positionY;
+          const ezSimdVec4f toConePosZ = group.m_CenterZ - positionZ;
+
+          const ezSimdVec4f projected = (forwardX.CompMul(toConePosX) + forwardY.CompMul(toConePosY)) + forwardZ.CompMul(toConePosZ);
+          const ezSimdVec4f distToConeSq = (toConePosX.CompMul(toConePosX) + toConePosY.CompMul(toConePosY)) + toConePosZ.CompMul(toConePosZ);
+          const ezSimdVec4f distClosestP = cosAngle.CompMul((distToConeSq - projected.CompMul(projected)).GetSqrt()) - projected.CompMul(sinAngle);
+
+          const ezSimdVec4b angleCull = distClosestP > group.m_Radius;
+          const ezSimdVec4b frontCull = projected > group.m_Radius + range4;
+          const ezSimdVec4b backCull = projected < -group.m_Radius;
+
+          return !(angleCull || frontCull || backCull); });
+      }
+      else
+      {
+        const ezSimdMat4f worldToBox = ezSimdMat4f::MakeFromColumns(shape.m_Params[0], shape.m_Params[1], shape.m_Params[2], shape.m_Params[3]);
+        const ezSimdBBox localBoxBounds = ezSimdBBox(ezSimdVec4f(-1.0f), ezSimdVec4f(1.0f));
+
+        FillCluster(range, uiBlockIndex, uiMask, pClusters, [&](ezUInt32 uiClusterIndex) {
+          ezSimdBSphere clusterSphere = pClusterBoundingSpheres[uiClusterIndex];
+          clusterSphere.Transform(worldToBox);
+
+          return localBoxBounds.Overlaps(clusterSphere); });
+      }
+    }
+  }
 } // namespace
@@ -0,0 +1,398 @@
+#include <RendererCore/RendererCorePCH.h>
+
+#include <RendererCore/Lights/Implementation/ShadowMapCache.h>
+
+void ezShadowAtlasAllocator::Initialize(ezUInt32 uiAtlasSize, ezUInt32 uiMinCellSize)
+{
+  EZ_ASSERT_DEV(ezMath::IsPowerOf2(uiAtlasSize) && ezMath::IsPowerOf2(uiMinCellSize) && uiMinCellSize <= uiAtlasSize, "Invalid atlas size {} / min cell size {}", uiAtlasSize, uiMinCellSize);
+
+  m_uiAtlasSize = uiAtlasSize;
+  m_uiMinCellSize = uiMinCellSize;
+  m_uiNumAllocations = 0;
+  m_uiAllocatedArea = 0;
+
+  m_Cells.Clear();
+  m_UnusedChildBlocks.Clear();
+
+  m_FreeCellsPerLevel.Clear();
+  m_FreeCellsPerLevel.SetCount(ezMath::Log2i(uiAtlasSize) - ezMath::Log2i(uiMinCellSize) + 1);
+
+  Cell& root = m_Cells.ExpandAndGetRef();
+  root.m_Rect = ezRectU32(0, 0, uiAtlasSize, uiAtlasSize);
+
+  m_FreeCellsPerLevel[0].PushBack(0);
+}
+
+ezUInt32 ezShadowAtlasAllocator::Allocate(ezUInt32 uiSize)
+{
+  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiSize), "Size must be power of 2");
+
+  uiSize = ezMath::Clamp(uiSize, m_uiMinCellSize, m_uiAtlasSize);
+  const ezUInt32 uiLevel = ezMath::Log2i(m_uiAtlasSize) - ezMath::Log2i(uiSize);
+
+  // Prefer a free cell of the exact size, otherwise split the smallest larger one. This keeps large cells intact as long as possible.
+  ezUInt32 uiFreeLevel = uiLevel + 1;
+  while (uiFreeLevel > 0 && m_FreeCellsPerLevel[uiFreeLevel - 1].IsEmpty())
+  {
+    --uiFreeLevel;
+  }
+
+  if (uiFreeLevel == 0)
+    return ezInvalidIndex;
+
+  --uiFreeLevel;
+
+  ezUInt32 uiCellIndex = m_FreeCellsPerLevel[uiFreeLevel].PeekBack();
+  m_FreeCellsPerLevel[uiFreeLevel].PopBack();
+
+  while (uiFreeLevel < uiLevel)
+  {
+    Split(uiCellIndex);
+
+    const ezUInt32 uiFirstChild = m_Cells[uiCellIndex].m_uiFirstChild;
+    ++uiFreeLevel;
+
+    for (ezUInt32 i = 3; i > 0; --i)
+    {
+      m_FreeCellsPerLevel[uiFreeLevel].PushBack(uiFirstChild + i);
+    }
+
+    uiCellIndex = uiFirstChild;
+  }
+
+  Cell& cell = m_Cells[uiCellIndex];
+  cell.m_State = CellState::Allocated;
+
+  ++m_uiNumAllocations;
+  m_uiAllocatedArea += ezUInt64(cell.m_Rect.width) * cell.m_Rect.height;
+
+  return uiCellIndex;
+}
+
+void ezShadowAtlasAllocator::Free(ezUInt32 uiCellIndex)
+{
+  EZ_ASSERT_DEV(m_Cells[uiCellIndex].m_State == CellState::Allocated, "Cell {} is not allocated", uiCellIndex);
+
+  {
+    Cell& cell = m_Cells[uiCellIndex];
+    cell.m_State = CellState::Free;
+
+    --m_uiNumAllocations;
+    m_uiAllocatedArea -= ezUInt64(cell.m_Rect.width) * cell.m_Rect.height;
+  }
+
+  // Merge with the siblings as long as all of them are free
+  while (true)
+  {
+    const Cell& cell = m_Cells[uiCellIndex];
+    if (cell.m_uiParent == ezInvalidIndex)
+      break;
+
+    Cell& parent = m_Cells[cell.m_uiParent];
+    const ezUInt32 uiFirstChild = parent.m_uiFirstChild;
+
+    bool bAllChildrenFree = true;
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      bAllChildrenFree &= m_Cells[uiFirstChild + i].m_State == CellState::Free;
+    }
+
+    if (!bAllChildrenFree)
+      break;
+
+    auto& freeCells = m_FreeCellsPerLevel[cell.m_uiLevel];
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      if (uiFirstChild + i != uiCellIndex)
+      {
+        EZ_VERIFY(freeCells.RemoveAndSwap(uiFirstChild + i), "Implementation error");
+      }
+
+      m_Cells[uiFirstChild + i].m_State = CellState::Unused;
+    }
+
+    m_UnusedChildBlocks.PushBack(uiFirstChild);
+
+    parent.m_State = CellState::Free;
+    parent.m_uiFirstChild = ezInvalidIndex;
+
+    uiCellIndex = cell.m_uiParent;
+  }
+
+  m_FreeCellsPerLevel[m_Cells[uiCellIndex].m_uiLevel].PushBack(uiCellIndex);
+}
+
+void ezShadowAtlasAllocator::Split(ezUInt32 uiCellIndex)
+{
+  ezUInt32 uiFirstChild = 0;
+  if (!m_UnusedChildBlocks.IsEmpty())
+  {
+    uiFirstChild = m_UnusedChildBlocks.PeekBack();
+    m_UnusedChildBlocks.PopBack();
+  }
+  else
+  {
+    uiFirstChild = m_Cells.GetCount();
+    m_Cells.SetCount(uiFirstChild + 4);
+  }
+
+  Cell& cell = m_Cells[uiCellIndex];
+  cell.m_State = CellState::Split;
+  cell.m_uiFirstChild = uiFirstChild;
+
+  const ezUInt32 x = cell.m_Rect.x;
+  const ezUInt32 y = cell.m_Rect.y;
+  const ezUInt32 w = cell.m_Rect.width / 2;
+  const ezUInt32 h = cell.m_Rect.height / 2;
+
+  const ezRectU32 childRects[4] = {
+    ezRectU32(x, y, w, h),
+    ezRectU32(x + w, y, w, h),
+    ezRectU32(x, y + h, w, h),
+    ezRectU32(x + w, y + h, w, h),
+  };
+
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    Cell& child = m_Cells[uiFirstChild + i];
+    child.m_Rect = childRects[i];
+    child.m_uiParent = uiCellIndex;
+    child.m_uiFirstChild = ezInvalidIndex;
+    child.m_uiLevel = cell.m_uiLevel + 1;
+    child.m_State = CellState::Free;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezShadowMapCache::ezShadowMapCache()
+{
+  Initialize(Settings());
+}
+
+void ezShadowMapCache::Initialize(const Settings& settings)
+{
+  m_Settings = settings;
+  m_Allocator.Initialize(settings.m_uiAtlasSize, settings.m_uiMinShadowMapSize);
+
+  m_Entries.Clear();
+  m_FreeEntries.Clear();
+  m_KeyToEntry.Clear();
+
+  m_Stats = Stats();
+}
+
+void ezShadowMapCache::SetSettings(const Settings& settings)
+{
+  EZ_ASSERT_DEV(settings.m_uiAtlasSize == m_Settings.m_uiAtlasSize && settings.m_uiMinShadowMapSize == m_Settings.m_uiMinShadowMapSize, "Changing the atlas layout requires Initialize");
+
+  m_Settings = settings;
+}
+
+void ezShadowMapCache::BeginFrame(ezUInt64 uiFrameCounter)
+{
+  m_uiFrameCounter = uiFrameCounter;
+  m_Stats = Stats();
+}
+
+ezShadowMapCache::Result ezShadowMapCache::Update(const Request& request)
+{
+  EZ_ASSERT_DEBUG(request.m_uiNumViews > 0, "Invalid number of views");
+
+  m_Stats.m_uiNumLights++;
+  m_Stats.m_uiNumViews += request.m_uiNumViews;
+
+  Result result;
+
+  if (!m_KeyToEntry.TryGetValue(request.m_uiKey, result.m_uiEntryIndex))
+  {
+    if (!m_FreeEntries.IsEmpty())
+    {
+      result.m_uiEntryIndex = m_FreeEntries.PeekBack();
+      m_FreeEntries.PopBack();
+    }
+    else
+    {
+      result.m_uiEntryIndex = m_Entries.GetCount();
+      m_Entries.ExpandAndGetRef();
+    }
+
+    m_Entries[result.m_uiEntryIndex] = Entry();
+    m_Entries[result.m_uiEntryIndex].m_uiKey = request.m_uiKey;
+
+    m_KeyToEntry.Insert(request.m_uiKey, result.m_uiEntryIndex);
+  }
+
+  Entry& entry = m_Entries[result.m_uiEntryIndex];
+  EZ_ASSERT_DEBUG(entry.m_uiLastUsedFrame != m_uiFrameCounter || !entry.m_bRendered, "Update must only be called once per key and frame");
+  entry.m_uiLastUsedFrame = m_uiFrameCounter;
+
+  ezUInt32 uiShadowMapSize = ezMath::Max(request.m_uiShadowMapSize, entry.m_uiNextFrameShadowMapSize);
+  uiShadowMapSize = ezMath::Clamp(ezMath::PowerOfTwo_Ceil(uiShadowMapSize), m_Settings.m_uiMinShadowMapSize, m_Settings.m_uiAtlasSize);
+  entry.m_uiNextFrameShadowMapSize = 0;
+
+  if (entry.m_AtlasCells.GetCount() != request.m_uiNumViews || entry.m_uiRequestedShadowMapSize != uiShadowMapSize)
+  {
+    FreeEntryCells(entry);
+
+    entry.m_uiRequestedShadowMapSize = uiShadowMapSize;
+    entry.m_bRendered = false;
+
+    if (!AllocateEntryCells(entry, request.m_uiNumViews, uiShadowMapSize))
+    {
+      m_Stats.m_uiNumViewsWithoutSpace += request.m_uiNumViews;
+      return result;
+    }
+  }
+
+  if (!entry.m_bRendered)
+    result.m_Reason = UpdateReason::NewAllocation;
+  else if (!m_Settings.m_bEnableCaching)
+    result.m_Reason = UpdateReason::CachingDisabled;
+  else if (entry.m_uiStaticCasterHash != request.m_uiStaticCasterHash)
+    result.m_Reason = UpdateReason::StaticCastersChanged;
+  else if (entry.m_uiCameraHash != request.m_uiCameraHash)
+    result.m_Reason = UpdateReason::LightChanged;
+  else if (request.m_bHasDynamicCasters)
+    result.m_Reason = UpdateReason::DynamicCasters;
+  else
+  {
+    m_Stats.m_uiNumCachedViews += request.m_uiNumViews;
+    return result;
+  }
+
+  // Small lights keep their old shadow map for a few frames if the budget is used up. The cameras they were rendered with stay valid.
+  const bool bCanDefer = result.m_Reason >= UpdateReason::StaticCastersChanged && request.m_fScreenSpaceSize < m_Settings.m_fTimeSliceScreenSpaceSize &&
+                         m_uiFrameCounter - entry.m_uiLastRenderedFrame < m_Settings.m_uiMaxFramesStale;
+  if (bCanDefer)
+  {
+    if (m_Stats.m_uiNumTimeSlicedViews + request.m_uiNumViews > m_Settings.m_uiTimeSlicedViewsPerFrame)
+    {
+      m_Stats.m_uiNumDeferredViews += request.m_uiNumViews;
+      return result;
+    }
+
+    m_Stats.m_uiNumTimeSlicedViews += request.m_uiNumViews;
+  }
+
+  entry.m_uiCameraHash = request.m_uiCameraHash;
+  entry.m_uiStaticCasterHash = request.m_uiStaticCasterHash;
+  entry.m_uiLastRenderedFrame = m_uiFrameCounter;
+  entry.m_bRendered = true;
+
+  m_Stats.m_uiNumRenderedViews += request.m_uiNumViews;
+
+  result.m_bRender = true;
+  return result;
+}
+
+void ezShadowMapCache::RequestShadowMapSizeForNextFrame(ezUInt32 uiEntryIndex, ezUInt32 uiShadowMapSize)
+{
+  Entry& entry = m_Entries[uiEntryIndex];
+  entry.m_uiNextFrameShadowMapSize = ezMath::Max(entry.m_uiNextFrameShadowMapSize, uiShadowMapSize);
+}
+
+void ezShadowMapCache::EndFrame()
+{
+  for (auto it = m_KeyToEntry.GetIterator(); it.IsValid();)
+  {
+    Entry& entry = m_Entries[it.Value()];
+    if (m_uiFrameCounter - entry.m_uiLastUsedFrame >= m_Settings.m_uiFramesToKeepUnused)
+    {
+      FreeEntryCells(entry);
+      m_FreeEntries.PushBack(it.Value());
+
+      it = m_KeyToEntry.Remove(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
+}
+
+void ezShadowMapCache::InvalidateAll()
+{
+  for (Entry& entry : m_Entries)
+  {
+    entry.m_bRendered = false;
+  }
+}
+
+ezRectU32 ezShadowMapCache::GetAtlasRect(ezUInt32 uiEntryIndex, ezUInt32 uiViewIndex) const
+{
+  const Entry& entry = m_Entries[uiEntryIndex];
+  if (uiViewIndex >= entry.m_AtlasCells.GetCount())
+    return ezRectU32(0, 0, 0, 0);
+
+  return m_Allocator.GetRect(entry.m_AtlasCells[uiViewIndex]);
+}
+
+void ezShadowMapCache::FreeEntryCells(Entry& entry)
+{
+  for (ezUInt32 uiCellIndex : entry.m_AtlasCells)
+  {
+    m_Allocator.Free(uiCellIndex);
+  }
+
+  entry.m_AtlasCells.Clear();
+  entry.m_uiShadowMapSize = 0;
+  entry.m_bRendered = false;
+}
+
+bool ezShadowMapCache::AllocateEntryCells(Entry& entry, ezUInt32 uiNumViews, ezUInt32 uiShadowMapSize)
+{
+  while (true)
+  {
+    while (entry.m_AtlasCells.GetCount() < uiNumViews)
+    {
+      const ezUInt32 uiCellIndex = m_Allocator.Allocate(uiShadowMapSize);
+      if (uiCellIndex == ezInvalidIndex)
+        break;
+
+      entry.m_AtlasCells.PushBack(uiCellIndex);
+    }
+
+    if (entry.m_AtlasCells.GetCount() == uiNumViews)
+    {
+      entry.m_uiShadowMapSize = uiShadowMapSize;
+      return true;
+    }
+
+    // Lights that have not been requested this frame are the first to go, only then fall back to smaller shadow maps
+    if (EvictLeastRecentlyUsed())
+      continue;
+
+    FreeEntryCells(entry);
+
+    if (uiShadowMapSize <= m_Settings.m_uiMinShadowMapSize)
+    {
+      ezLog::Warning("Shadow Pool is full. Not enough space for a {0}x{0} shadow map. The light will have no shadow.", uiShadowMapSize);
+      return false;
+    }
+
+    uiShadowMapSize /= 2;
+  }
+}
+
+bool ezShadowMapCache::EvictLeastRecentlyUsed()
+{
+  ezUInt32 uiOldestEntry = ezInvalidIndex;
+  for (auto it = m_KeyToEntry.GetIterator(); it.IsValid(); ++it)
+  {
+    const Entry& entry = m_Entries[it.Value()];
+    if (entry.m_uiLastUsedFrame == m_uiFrameCounter || entry.m_AtlasCells.IsEmpty())
+      continue;
+
+    if (uiOldestEntry == ezInvalidIndex || entry.m_uiLastUsedFrame < m_Entries[uiOldestEntry].m_uiLastUsedFrame)
+    {
+      uiOldestEntry = it.Value();
+    }
+  }
+
+  if (uiOldestEntry == ezInvalidIndex)
+    return false;
+
+  FreeEntryCells(m_Entries[uiOldestEntry]);
+  return true;
+}
@@ -0,0 +1,184 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/Containers/HybridArray.h>
+#include <Foundation/Math/Rect.h>
+#include <RendererCore/RendererCoreDLL.h>
+
+/// \brief Quadtree allocator for square, power of two sized shadow maps in the shadow atlas.
+///
+/// Unlike a per frame repack, allocations stay where they are until they are freed, so the atlas content can be reused across frames.
+/// Freed cells are merged with their siblings again to keep fragmentation low.
+class EZ_RENDERERCORE_DLL ezShadowAtlasAllocator
+{
+public:
+  /// \brief Resets the allocator to an empty atlas. Both sizes need to be powers of two.
+  void Initialize(ezUInt32 uiAtlasSize, ezUInt32 uiMinCellSize);
+
+  /// \brief Returns the cell index of the allocation or ezInvalidIndex if there is not enough space left.
+  ezUInt32 Allocate(ezUInt32 uiSize);
+  void Free(ezUInt32 uiCellIndex);
+
+  ezRectU32 GetRect(ezUInt32 uiCellIndex) const { return m_Cells[uiCellIndex].m_Rect; }
+
+  ezUInt32 GetAtlasSize() const { return m_uiAtlasSize; }
+  ezUInt32 GetMinCellSize() const { return m_uiMinCellSize; }
+  ezUInt32 GetNumAllocations() const { return m_uiNumAllocations; }
+  ezUInt64 GetAllocatedArea() const { return m_uiAllocatedArea; }
+
+private:
+  enum class CellState : ezUInt8
+  {
+    Free,
+    Split,
+    Allocated,
+    Unused, ///< Part of a child block that has been merged back into its parent.
+  };
+
+  struct Cell
+  {
+    ezRectU32 m_Rect;
+    ezUInt32 m_uiParent = ezInvalidIndex;
+    ezUInt32 m_uiFirstChild = ezInvalidIndex;
+    ezUInt32 m_uiLevel = 0;
+    CellState m_State = CellState::Free;
+  };
+
+  void Split(ezUInt32 uiCellIndex);
+
+  ezUInt32 m_uiAtlasSize = 0;
+  ezUInt32 m_uiMinCellSize = 0;
+  ezUInt32 m_uiNumAllocations = 0;
+  ezUInt64 m_uiAllocatedArea = 0;
+
+  ezDynamicArray<Cell> m_Cells;
+  ezHybridArray<ezDynamicArray<ezUInt32>, 8> m_FreeCellsPerLevel;
+  ezDynamicArray<ezUInt32> m_UnusedChildBlocks;
+};
+
+/// \brief Decides which shadow maps need to be rendered in a frame and which ones can be reused from the atlas.
+///
+/// Every shadow casting light (per reference view for directional lights) has an entry that owns persistent atlas cells.
+/// An entry is re-rendered if it is new or was resized, if the light's cameras changed, if the static shadow casters in its bounds changed
+/// or if there are dynamic casters in its bounds. Only the latter three can be deferred: lights with a small screen space size share
+/// a per frame view budget and are refreshed at the latest after a fixed number of frames, in the meantime the shadow map that was
+/// rendered last is used together with the cameras it was rendered with.
+///
+/// The cache does not touch the GPU and is not thread-safe, so it can be used and tested without a device.
+class EZ_RENDERERCORE_DLL ezShadowMapCache
+{
+public:
+  struct Settings
+  {
+    ezUInt32 m_uiAtlasSize = 4096;
+    ezUInt32 m_uiMinShadowMapSize = 64;
+    bool m_bEnableCaching = true;
+    ezUInt32 m_uiTimeSlicedViewsPerFrame = 12; ///< How many views of deferrable lights may be rendered per frame.
+    float m_fTimeSliceScreenSpaceSize = 0.25f; ///< Lights with a smaller screen space size may be refreshed time sliced.
+    ezUInt32 m_uiMaxFramesStale = 8;           ///< A deferred light is refreshed at the latest after this many frames.
+    ezUInt32 m_uiFramesToKeepUnused = 30;      ///< Entries that are not requested for this many frames release their atlas cells.
+  };
+
+  struct Request
+  {
+    ezUInt64 m_uiKey = 0;
+    ezUInt32 m_uiNumViews = 1;
+    ezUInt32 m_uiShadowMapSize = 0;
+    float m_fScreenSpaceSize = 0.0f;
+    ezUInt64 m_uiCameraHash = 0;
+    ezUInt64 m_uiStaticCasterHash = 0;
+    bool m_bHasDynamicCasters = false;
+  };
+
+  enum class UpdateReason : ezUInt8
+  {
+    None,
+    NewAllocation,
+    CachingDisabled,
+    StaticCastersChanged,
+    LightChanged,
+    DynamicCasters,
+  };
+
+  struct Result
+  {
+    ezUInt32 m_uiEntryIndex = ezInvalidIndex;
+    bool m_bRender = false;
+    UpdateReason m_Reason = UpdateReason::None;
+  };
+
+  struct Entry
+  {
+    ezUInt64 m_uiKey = 0;
+    ezHybridArray<ezUInt32, 6> m_AtlasCells;
+    ezUInt32 m_uiShadowMapSize = 0;          ///< The size of the allocated cells, might be smaller than requested if the atlas is full.
+    ezUInt32 m_uiRequestedShadowMapSize = 0;
+    ezUInt32 m_uiNextFrameShadowMapSize = 0;
+    ezUInt64 m_uiCameraHash = 0;
+    ezUInt64 m_uiStaticCasterHash = 0;
+    ezUInt64 m_uiLastUsedFrame = 0;
+    ezUInt64 m_uiLastRenderedFrame = 0;
+    bool m_bRendered = false;
+  };
+
+  struct Stats
+  {
+    ezUInt32 m_uiNumLights = 0;
+    ezUInt32 m_uiNumViews = 0;
+    ezUInt32 m_uiNumRenderedViews = 0;
+    ezUInt32 m_uiNumCachedViews = 0;
+    ezUInt32 m_uiNumDeferredViews = 0;
+    ezUInt32 m_uiNumTimeSlicedViews = 0;
+    ezUInt32 m_uiNumViewsWithoutSpace = 0;
+  };
+
+  ezShadowMapCache();
+
+  /// \brief Frees all entries and resets the atlas.
+  void Initialize(const Settings& settings);
+
+  /// \brief Changes the scheduling settings. The atlas layout is not affected.
+  void SetSettings(const Settings& settings);
+  const Settings& GetSettings() const { return m_Settings; }
+
+  void BeginFrame(ezUInt64 uiFrameCounter);
+
+  /// \brief Allocates or looks up the entry for the given light and decides whether it has to be rendered this frame.
+  ///
+  /// Must only be called once per key and frame. If the atlas is full the entry has no atlas cells and must not be rendered.
+  Result Update(const Request& request);
+
+  /// \brief The shadow map size for the next frame will be at least this size.
+  ///
+  /// This allows to request the final size once all reference views have been extracted without reallocating every frame
+  /// when a light is seen by several views with different screen space sizes.
+  void RequestShadowMapSizeForNextFrame(ezUInt32 uiEntryIndex, ezUInt32 uiShadowMapSize);
+
+  /// \brief Releases the atlas cells of entries that have not been requested for a while.
+  void EndFrame();
+
+  /// \brief Forces all entries to be rendered again, e.g. after the atlas content was lost.
+  void InvalidateAll();
+
+  const Entry& GetEntry(ezUInt32 uiEntryIndex) const { return m_Entries[uiEntryIndex]; }
+  ezRectU32 GetAtlasRect(ezUInt32 uiEntryIndex, ezUInt32 uiViewIndex) const;
+
+  const ezShadowAtlasAllocator& GetAllocator() const { return m_Allocator; }
+  const Stats& GetStats() const { return m_Stats; }
+
+private:
+  void FreeEntryCells(Entry& entry);
+  bool AllocateEntryCells(Entry& entry, ezUInt32 uiNumViews, ezUInt32 uiShadowMapSize);
+  bool EvictLeastRecentlyUsed();
+
+  Settings m_Settings;
+  ezShadowAtlasAllocator m_Allocator;
+
+  ezDynamicArray<Entry> m_Entries;
+  ezDynamicArray<ezUInt32> m_FreeEntries;
+  ezHashTable<ezUInt64, ezUInt32> m_KeyToEntry;
+
+  ezUInt64 m_uiFrameCounter = 0;
+  Stats m_Stats;
+};
@@ -1,17 +1,22 @@
 #include <RendererCore/RendererCorePCH.h>
 
 #include <Core/Graphics/Camera.h>
+#include <Core/World/SpatialSystem.h>
+#include <Core/World/World.h>
 #include <Foundation/Configuration/CVar.h>
 #include <Foundation/Configuration/Startup.h>
 #include <Foundation/Math/Rect.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Lights/DirectionalLightComponent.h>
+#include <RendererCore/Lights/Implementation/ShadowMapCache.h>
 #include <RendererCore/Lights/Implementation/ShadowPool.h>
 #include <RendererCore/Lights/PointLightComponent.h>
 #include <RendererCore/Lights/SpotLightComponent.h>
 #include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
+#include <RendererCore/Shader/ShaderResource.h>
 #include <RendererFoundation/CommandEncoder/RenderCommandEncoder.h>
 #include <RendererFoundation/Device/Device.h>
 #include <RendererFoundation/Device/Pass.h>
@@ -44,6 +49,10 @@ EZ_END_SUBSYSTEM_DECLARATION;
 ezCVarBool cvar_RenderingShadowsShowPoolStats("Rendering.Shadows.ShowPoolStats", false, ezCVarFlags::Default, "Display same stats of the shadow pool");
 #endif
 
+ezCVarBool cvar_RenderingShadowsCaching("Rendering.Shadows.Caching", true, ezCVarFlags::Default, "Reuses shadow maps of lights whose cameras and shadow casters did not change");
+ezCVarInt cvar_RenderingShadowsTimeSlicedViewsPerFrame("Rendering.Shadows.TimeSlicedViewsPerFrame", 12, ezCVarFlags::Default, "How many shadow views of small lights may be refreshed per frame");
+ezCVarFloat cvar_RenderingShadowsTimeSliceScreenSize("Rendering.Shadows.TimeSliceScreenSize", 0.25f, ezCVarFlags::Default, "Lights with a smaller screen space size refresh their shadows time sliced");
+
 static ezUInt32 s_uiShadowAtlasTextureWidth = 4096; ///\todo make this configurable
 static ezUInt32 s_uiShadowAtlasTextureHeight = 4096;
 static ezUInt32 s_uiShadowMapSize = 1024;
@@ -68,6 +77,7 @@ struct ShadowData
   float m_fFadeOutStart;
   float m_fMinRange;
   ezUInt32 m_uiPackedDataOffset; // in 16 bytes steps
+  ezUInt32 m_uiCacheEntryIndex;
 };
 
 struct LightAndRefView
@@ -78,111 +88,76 @@ struct LightAndRefView
   const ezView* m_pReferenceView;
 };
 
-struct SortedShadowData
+static ezUInt32 GetShadowMapSize(ezUInt32 uiType, float fShadowMapScale)
 {
-  EZ_DECLARE_POD_TYPE();
+  ezUInt32 uiShadowMapSize = s_uiShadowMapSize;
+  float fadeOutStart = s_fFadeOutScaleStart;
 
-  ezUInt32 m_uiIndex;
-  float m_fShadowMapScale;
-
-  EZ_ALWAYS_INLINE bool operator<(const SortedShadowData& other) const
+  // point lights use a lot of atlas space thus we cut the shadow map size in half
+  if (uiType == LIGHT_TYPE_POINT)
   {
-    if (m_fShadowMapScale > other.m_fShadowMapScale) // we want to sort descending (higher scale first)
-      return true;
-
-    return m_uiIndex < other.m_uiIndex;
+    uiShadowMapSize /= 2;
+    fadeOutStart *= 2.0f;
   }
-};
 
-static ezDynamicArray<SortedShadowData> s_SortedShadowData;
+  return ezMath::PowerOfTwo_Ceil((ezUInt32)(uiShadowMapSize * ezMath::Clamp(fShadowMapScale, fadeOutStart, 1.0f)));
+}
 
-struct AtlasCell
+static ezUInt64 HashShadowCameras(ezArrayPtr<ShadowView*> shadowViews)
 {
-  EZ_DECLARE_POD_TYPE();
-
-  EZ_ALWAYS_INLINE AtlasCell()
-    : m_Rect(0, 0, 0, 0)
+  ezUInt64 uiHash = 0;
+  for (const ShadowView* pShadowView : shadowViews)
   {
-    m_uiChildIndices[0] = m_uiChildIndices[1] = m_uiChildIndices[2] = m_uiChildIndices[3] = 0xFFFF;
-    m_uiDataIndex = ezInvalidIndex;
-  }
+    const ezCamera& camera = pShadowView->m_Camera;
+    const ezVec3 orientation[3] = {camera.GetPosition(), camera.GetDirForwards(), camera.GetDirUp()};
+    const float settings[3] = {camera.GetFovOrDim(), camera.GetNearPlane(), camera.GetFarPlane()};
 
-  EZ_ALWAYS_INLINE bool IsLeaf() const
-  {
-    return m_uiChildIndices[0] == 0xFFFF && m_uiChildIndices[1] == 0xFFFF && m_uiChildIndices[2] == 0xFFFF && m_uiChildIndices[3] == 0xFFFF;
+    uiHash = ezHashingUtils::xxHash64(orientation, sizeof(orientation), uiHash);
+    uiHash = ezHashingUtils::xxHash64(settings, sizeof(settings), uiHash);
   }
 
-  ezRectU32 m_Rect;
-  ezUInt16 m_uiChildIndices[4];
-  ezUInt32 m_uiDataIndex;
-};
-
-static ezDeque<AtlasCell> s_AtlasCells;
+  return uiHash;
+}
 
-static AtlasCell* Insert(AtlasCell* pCell, ezUInt32 uiShadowMapSize, ezUInt32 uiDataIndex)
+static void GatherShadowCasters(const ezWorld* pWorld, const ezBoundingSphere& bounds, ezUInt32 uiCategoryBitmask, ezUInt64& out_uiStaticCasterHash, bool& out_bHasDynamicCasters)
 {
-  if (!pCell->IsLeaf())
-  {
-    for (ezUInt32 i = 0; i < 4; ++i)
-    {
-      AtlasCell* pChildCell = &s_AtlasCells[pCell->m_uiChildIndices[i]];
-      if (AtlasCell* pNewCell = Insert(pChildCell, uiShadowMapSize, uiDataIndex))
-      {
-        return pNewCell;
-      }
-    }
+  EZ_PROFILE_SCOPE("Gather Shadow Casters");
 
-    return nullptr;
-  }
-  else
-  {
-    if (pCell->m_uiDataIndex != ezInvalidIndex)
-      return nullptr;
+  ezSpatialSystem::QueryParams queryParams;
+  queryParams.m_uiCategoryBitmask = uiCategoryBitmask;
+  queryParams.m_IncludeTags.Set(ezTagRegistry::GetGlobalRegistry().RegisterTag("CastShadow"));
 
-    if (pCell->m_Rect.width < uiShadowMapSize || pCell->m_Rect.height < uiShadowMapSize)
-      return nullptr;
+  out_uiStaticCasterHash = 0;
+  out_bHasDynamicCasters = false;
 
-    if (pCell->m_Rect.width == uiShadowMapSize && pCell->m_Rect.height == uiShadowMapSize)
+  pWorld->GetSpatialSystem()->FindObjectsInSphere(bounds, queryParams, [&](ezGameObject* pObject)
     {
-      pCell->m_uiDataIndex = uiDataIndex;
-      return pCell;
-    }
+      if (pObject->IsDynamic())
+      {
+        // the light has to be rendered anyway, so the static casters don't matter anymore
+        out_bHasDynamicCasters = true;
+        return ezVisitorExecution::Stop;
+      }
 
-    // Split
-    ezUInt32 x = pCell->m_Rect.x;
-    ezUInt32 y = pCell->m_Rect.y;
-    ezUInt32 w = pCell->m_Rect.width / 2;
-    ezUInt32 h = pCell->m_Rect.height / 2;
+      // static objects can still be moved or changed in the editor, so their bounds and transforms are part of the hash
+      const ezBoundingBoxSphere globalBounds = pObject->GetGlobalBounds();
+      const ezTransform globalTransform = pObject->GetGlobalTransform();
 
-    ezUInt32 uiCellIndex = s_AtlasCells.GetCount();
-    s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x, y, w, h);
-    s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x + w, y, w, h);
-    s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x, y + h, w, h);
-    s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(x + w, y + h, w, h);
+      ezUInt64 uiHash = ezHashingUtils::xxHash64(&pObject, sizeof(pObject));
+      uiHash = ezHashingUtils::xxHash64(&globalBounds, sizeof(globalBounds), uiHash);
+      uiHash = ezHashingUtils::xxHash64(&globalTransform, sizeof(globalTransform), uiHash);
 
-    for (ezUInt32 i = 0; i < 4; ++i)
-    {
-      pCell->m_uiChildIndices[i] = static_cast<ezUInt16>(uiCellIndex + i);
-    }
+      // summing up makes the hash independent of the query order
+      out_uiStaticCasterHash += uiHash;
 
-    AtlasCell* pChildCell = &s_AtlasCells[pCell->m_uiChildIndices[0]];
-    return Insert(pChildCell, uiShadowMapSize, uiDataIndex);
-  }
+      return ezVisitorExecution::Continue; });
 }
 
-static ezRectU32 FindAtlasRect(ezUInt32 uiShadowMapSize, ezUInt32 uiDataIndex)
+static void RestoreCamera(const ezCamera& renderedCamera, ezCamera& out_camera)
 {
-  EZ_ASSERT_DEBUG(ezMath::IsPowerOf2(uiShadowMapSize), "Size must be power of 2");
-
-  AtlasCell* pCell = Insert(&s_AtlasCells[0], uiShadowMapSize, uiDataIndex);
-  if (pCell != nullptr)
-  {
-    EZ_ASSERT_DEBUG(pCell->IsLeaf() && pCell->m_uiDataIndex == uiDataIndex, "Implementation error");
-    return pCell->m_Rect;
-  }
-
-  ezLog::Warning("Shadow Pool is full. Not enough space for a {0}x{0} shadow map. The light will have no shadow.", uiShadowMapSize);
-  return ezRectU32(0, 0, 0, 0);
+  const ezVec3 vPosition = renderedCamera.GetPosition();
+  out_camera.LookAt(vPosition, vPosition + renderedCamera.GetDirForwards(), renderedCamera.GetDirUp());
+  out_camera.SetCameraMode(renderedCamera.GetCameraMode(), renderedCamera.GetFovOrDim(), renderedCamera.GetNearPlane(), renderedCamera.GetFarPlane());
 }
 
 static float AddSafeBorder(ezAngle fov, float fPenumbraSize)
@@ -224,7 +199,15 @@ struct ezHashHelper<LightAndRefView>
 
 struct ezShadowPool::Data
 {
-  Data() { Clear(); }
+  Data()
+  {
+    ezShadowMapCache::Settings settings;
+    settings.m_uiAtlasSize = s_uiShadowAtlasTextureWidth;
+    settings.m_uiMinShadowMapSize = s_uiMinShadowMapSize;
+    m_Cache.Initialize(settings);
+
+    Clear();
+  }
 
   ~Data()
   {
@@ -260,6 +243,11 @@ struct ezShadowPool::Data
       desc.SetAsRenderTarget(s_uiShadowAtlasTextureWidth, s_uiShadowAtlasTextureHeight, ezGALResourceFormat::D16);
 
       m_hShadowAtlasTexture = ezGALDevice::GetDefaultDevice()->CreateTexture(desc);
+
+      // the content of a new atlas is undefined
+      m_bClearWholeAtlas[ezRenderWorld::GetDataIndexForExtraction()] = true;
+
+      m_hClearShader = ezResourceManager::LoadResource<ezShaderResource>("Shaders/Pipeline/ShadowAtlasClear.ezShader");
     }
   }
 
@@ -357,6 +345,7 @@ struct ezShadowPool::Data
     out_pData->m_fFadeOutStart = 1.0f;
     out_pData->m_fMinRange = 1.0f;
     out_pData->m_uiPackedDataOffset = m_uiUsedPackedShadowData;
+    out_pData->m_uiCacheEntryIndex = ezInvalidIndex;
 
     m_LightToShadowDataTable.Insert(key, m_uiUsedShadowData);
 
@@ -366,6 +355,127 @@ struct ezShadowPool::Data
     return false;
   }
 
+  /// \brief Adds the shadow casters in the given bounds to the request.
+  ///
+  /// The spatial system is only queried again if the bounds changed or if spatial data of the queried category was modified since the last query.
+  /// Static and dynamic render data are queried separately, so moving dynamic objects don't cause a query for static objects.
+  void GatherShadowCastersCached(const ezWorld* pWorld, const ezBoundingSphere& bounds, ezShadowMapCache::Request& ref_request)
+  {
+    const ezUInt64 uiFrameCounter = ezRenderWorld::GetFrameCounter();
+    const ezSpatialSystem* pSpatialSystem = pWorld->GetSpatialSystem();
+    const ezUInt32 categories[] = {ezDefaultSpatialDataCategories::RenderStatic.GetBitmask(), ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask()};
+
+    CasterCacheEntry entry;
+    bool bFound = false;
+    {
+      EZ_LOCK(m_CasterCacheMutex);
+      bFound = m_CasterCache.TryGetValue(ref_request.m_uiKey, entry);
+    }
+
+    // an entry that was not used in the previous frame might belong to a world that does not exist anymore
+    const bool bQueryAll = !bFound || entry.m_uiLastUsedFrame + 1 < uiFrameCounter || entry.m_Bounds != bounds;
+
+    entry.m_Bounds = bounds;
+    entry.m_uiLastUsedFrame = uiFrameCounter;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(categories); ++i)
+    {
+      CasterQuery& query = entry.m_Queries[i];
+
+      const ezUInt64 uiModificationCounter = pSpatialSystem->GetModificationCounter(categories[i]);
+      if (bQueryAll || query.m_uiModificationCounter != uiModificationCounter)
+      {
+        query.m_uiModificationCounter = uiModificationCounter;
+        GatherShadowCasters(pWorld, bounds, categories[i], query.m_uiStaticCasterHash, query.m_bHasDynamicCasters);
+      }
+
+      ref_request.m_uiStaticCasterHash += query.m_uiStaticCasterHash;
+      ref_request.m_bHasDynamicCasters |= query.m_bHasDynamicCasters;
+    }
+
+    {
+      EZ_LOCK(m_CasterCacheMutex);
+      m_CasterCache.Insert(ref_request.m_uiKey, entry);
+    }
+  }
+
+  void RemoveUnusedCasterCacheEntries()
+  {
+    const ezUInt64 uiFrameCounter = ezRenderWorld::GetFrameCounter();
+
+    for (auto it = m_CasterCache.GetIterator(); it.IsValid();)
+    {
+      if (it.Value().m_uiLastUsedFrame != uiFrameCounter)
+      {
+        it = m_CasterCache.Remove(it);
+      }
+      else
+      {
+        ++it;
+      }
+    }
+  }
+
+  /// \brief Decides whether the shadow views of a light need to be rendered this frame or whether the cached shadow maps can be used.
+  ///
+  /// Cached shadow maps are used together with the cameras they were rendered with.
+  void UpdateShadowCache(const ezLightComponent* pLight, const ezView* pReferenceView, ShadowData* pData, ezArrayPtr<ShadowView*> shadowViews, float fScreenSpaceSize, const ezBoundingSphere& casterBounds)
+  {
+    ezShadowMapCache::Request request;
+    {
+      const ezComponentHandle hLight = pLight->GetHandle();
+      const ezViewHandle hReferenceView = pReferenceView != nullptr ? pReferenceView->GetHandle() : ezViewHandle();
+      request.m_uiKey = ezHashingUtils::xxHash64(&hLight, sizeof(hLight), ezHashingUtils::xxHash64(&hReferenceView, sizeof(hReferenceView)));
+    }
+    request.m_uiNumViews = shadowViews.GetCount();
+    request.m_fScreenSpaceSize = fScreenSpaceSize;
+    request.m_uiCameraHash = HashShadowCameras(shadowViews);
+
+    GatherShadowCastersCached(pLight->GetWorld(), casterBounds, request);
+
+    ezShadowMapCache::Result result;
+    {
+      EZ_LOCK(m_ShadowDataMutex);
+
+      request.m_uiShadowMapSize = GetShadowMapSize(pData->m_uiType, pData->m_fShadowMapScale);
+
+      result = m_Cache.Update(request);
+      pData->m_uiCacheEntryIndex = result.m_uiEntryIndex;
+
+      m_RenderedCameras.EnsureCount(result.m_uiEntryIndex + 1);
+      auto& renderedCameras = m_RenderedCameras[result.m_uiEntryIndex];
+
+      if (result.m_bRender)
+      {
+        auto& atlasRectsToClear = m_AtlasRectsToClear[ezRenderWorld::GetDataIndexForExtraction()];
+
+        renderedCameras.SetCount(shadowViews.GetCount());
+        for (ezUInt32 i = 0; i < shadowViews.GetCount(); ++i)
+        {
+          renderedCameras[i] = shadowViews[i]->m_Camera;
+          atlasRectsToClear.PushBack(m_Cache.GetAtlasRect(result.m_uiEntryIndex, i));
+        }
+      }
+      else if (!m_Cache.GetEntry(result.m_uiEntryIndex).m_AtlasCells.IsEmpty())
+      {
+        EZ_ASSERT_DEBUG(renderedCameras.GetCount() == shadowViews.GetCount(), "Implementation error");
+
+        for (ezUInt32 i = 0; i < shadowViews.GetCount(); ++i)
+        {
+          RestoreCamera(renderedCameras[i], shadowViews[i]->m_Camera);
+        }
+      }
+    }
+
+    if (result.m_bRender)
+    {
+      for (ShadowView* pShadowView : shadowViews)
+      {
+        ezRenderWorld::AddViewToRender(pShadowView->m_hView);
+      }
+    }
+  }
+
   void Clear()
   {
     m_uiUsedViews = 0;
@@ -388,6 +498,31 @@ struct ezShadowPool::Data
   ezDynamicArray<ezVec4, ezAlignedAllocatorWrapper> m_PackedShadowData[2];
   ezUInt32 m_uiUsedPackedShadowData = 0; // in 16 bytes steps (sizeof(ezVec4))
 
+  ezShadowMapCache m_Cache;
+  ezDynamicArray<ezDynamicArray<ezCamera>> m_RenderedCameras; // indexed by cache entry
+
+  /// \brief The result of the last shadow caster query of a light in one spatial data category.
+  struct CasterQuery
+  {
+    ezUInt64 m_uiModificationCounter = 0;
+    ezUInt64 m_uiStaticCasterHash = 0;
+    bool m_bHasDynamicCasters = false;
+  };
+
+  struct CasterCacheEntry
+  {
+    ezBoundingSphere m_Bounds = ezBoundingSphere::MakeInvalid();
+    ezUInt64 m_uiLastUsedFrame = 0;
+    CasterQuery m_Queries[2]; // static and dynamic render data
+  };
+
+  ezMutex m_CasterCacheMutex;
+  ezHashTable<ezUInt64, CasterCacheEntry> m_CasterCache; // by cache request key
+
+  ezDynamicArray<ezRectU32> m_AtlasRectsToClear[2];
+  bool m_bClearWholeAtlas[2] = {false, false};
+  ezShaderResourceHandle m_hClearShader;
+
   ezGALTextureHandle m_hShadowAtlasTexture;
   ezGALBufferHandle m_hShadowDataBuffer;
 };
@@ -454,11 +589,15 @@ ezUInt32 ezShadowPool::AddDirectionalLight(const ezDirectionalLightComponent* pD
 
   float fNearPlaneOffset = pDirLight->GetNearPlaneOffset();
 
+  ezHybridArray<ShadowView*, 4> shadowViews;
+  ezBoundingSphere casterBounds = ezBoundingSphere::MakeInvalid();
+
   for (ezUInt32 i = 0; i < uiNumCascades; ++i)
   {
     ezView* pView = nullptr;
     ShadowView& shadowView = s_pData->GetShadowView(pView);
     pData->m_Views[i] = shadowView.m_hView;
+    shadowViews.PushBack(&shadowView);
 
     // Setup view
     {
@@ -518,11 +657,16 @@ ezUInt32 ezShadowPool::AddDirectionalLight(const ezDirectionalLightComponent* pD
       offset.y -= ezMath::Floor(offset.y / texelInWorld) * texelInWorld;
 
       camera.MoveLocally(0.0f, offset.x, offset.y);
-    }
 
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
+      // the last cascade contains all others, its box extends from the shadow camera to the far side of the cascade sphere
+      const float fHalfDepth = radius + fNearPlaneOffset * 0.5f;
+      casterBounds = ezBoundingSphere::MakeFromCenterAndRadius(center - vLightDirForwards * (fNearPlaneOffset * 0.5f), ezMath::Sqrt(fHalfDepth * fHalfDepth + 2.0f * radius * radius));
+    }
   }
 
+  // directional lights are never time sliced since their cascades follow the reference view
+  s_pData->UpdateShadowCache(pDirLight, pReferenceView, pData, shadowViews, 100.0f, casterBounds);
+
   return pData->m_uiPackedDataOffset;
 }
 
@@ -573,11 +717,14 @@ ezUInt32 ezShadowPool::AddPointLight(const ezPointLightComponent* pPointLight, f
   float fNearPlane = 0.1f; ///\todo expose somewhere
   float fFarPlane = pPointLight->GetEffectiveRange();
 
+  ezHybridArray<ShadowView*, 6> shadowViews;
+
   for (ezUInt32 i = 0; i < 6; ++i)
   {
     ezView* pView = nullptr;
     ShadowView& shadowView = s_pData->GetShadowView(pView);
     pData->m_Views[i] = shadowView.m_hView;
+    shadowViews.PushBack(&shadowView);
 
     // Setup view
     {
@@ -594,10 +741,10 @@ ezUInt32 ezShadowPool::AddPointLight(const ezPointLightComponent* pPointLight, f
       camera.LookAt(vPosition, vPosition + vForward, vUp);
       camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, fFov, fNearPlane, fFarPlane);
     }
-
-    ezRenderWorld::AddViewToRender(shadowView.m_hView);
   }
 
+  s_pData->UpdateShadowCache(pPointLight, nullptr, pData, shadowViews, fScreenSpaceSize, ezBoundingSphere::MakeFromCenterAndRadius(vPosition, fFarPlane));
+
   return pData->m_uiPackedDataOffset;
 }
 
@@ -624,6 +771,9 @@ ezUInt32 ezShadowPool::AddSpotLight(const ezSpotLightComponent* pSpotLight, floa
   ShadowView& shadowView = s_pData->GetShadowView(pView);
   pData->m_Views[0] = shadowView.m_hView;
 
+  ShadowView* pShadowView = &shadowView;
+  ezBoundingSphere casterBounds;
+
   // Setup view
   {
     pView->SetName("SpotLightView");
@@ -645,9 +795,11 @@ ezUInt32 ezShadowPool::AddSpotLight(const ezSpotLightComponent* pSpotLight, floa
     ezCamera& camera = shadowView.m_Camera;
     camera.LookAt(vPosition, vPosition + vForward, vUp);
     camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovX, fFov, fNearPlane, fFarPlane);
+
+    casterBounds = ezBoundingSphere::MakeFromCenterAndRadius(vPosition, fFarPlane);
   }
 
-  ezRenderWorld::AddViewToRender(shadowView.m_hView);
+  s_pData->UpdateShadowCache(pSpotLight, nullptr, pData, ezMakeArrayPtr(&pShadowView, 1), fScreenSpaceSize, casterBounds);
 
   return pData->m_uiPackedDataOffset;
 }
@@ -691,42 +843,42 @@ void ezShadowPool::OnEngineShutdown()
 // static
 void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
 {
+  if (e.m_Type == ezRenderWorldExtractionEvent::Type::BeginExtraction)
+  {
+    ezShadowMapCache::Settings settings = s_pData->m_Cache.GetSettings();
+    settings.m_bEnableCaching = cvar_RenderingShadowsCaching;
+    settings.m_uiTimeSlicedViewsPerFrame = ezMath::Max(cvar_RenderingShadowsTimeSlicedViewsPerFrame.GetValue(), 0);
+    settings.m_fTimeSliceScreenSpaceSize = cvar_RenderingShadowsTimeSliceScreenSize;
+
+    s_pData->m_Cache.SetSettings(settings);
+    s_pData->m_Cache.BeginFrame(e.m_uiFrameCounter);
+    return;
+  }
+
   if (e.m_Type != ezRenderWorldExtractionEvent::Type::EndExtraction)
     return;
 
   EZ_PROFILE_SCOPE("Shadow Pool Update");
 
+  s_pData->RemoveUnusedCasterCacheEntries();
+
   ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForExtraction();
   auto& packedShadowData = s_pData->m_PackedShadowData[uiDataIndex];
   packedShadowData.SetCountUninitialized(s_pData->m_uiUsedPackedShadowData);
 
   if (s_pData->m_uiUsedShadowData == 0)
-    return;
-
-  // Sort by shadow map scale
-  s_SortedShadowData.Clear();
-
-  for (ezUInt32 uiShadowDataIndex = 0; uiShadowDataIndex < s_pData->m_uiUsedShadowData; ++uiShadowDataIndex)
   {
-    auto& shadowData = s_pData->m_ShadowData[uiShadowDataIndex];
-
-    auto& sorted = s_SortedShadowData.ExpandAndGetRef();
-    sorted.m_uiIndex = uiShadowDataIndex;
-    sorted.m_fShadowMapScale = shadowData.m_uiType == LIGHT_TYPE_DIR ? 100.0f : ezMath::Min(shadowData.m_fShadowMapScale, 10.0f);
+    s_pData->m_Cache.EndFrame();
+    return;
   }
 
-  s_SortedShadowData.Sort();
-
-  // Prepare atlas
-  s_AtlasCells.Clear();
-  s_AtlasCells.ExpandAndGetRef().m_Rect = ezRectU32(0, 0, s_uiShadowAtlasTextureWidth, s_uiShadowAtlasTextureHeight);
+  const ezShadowMapCache& cache = s_pData->m_Cache;
 
   float fAtlasInvWidth = 1.0f / s_uiShadowAtlasTextureWidth;
   float fAtlasInvHeight = 1.0f / s_uiShadowAtlasTextureWidth;
 
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   ezUInt32 uiTotalAtlasSize = s_uiShadowAtlasTextureWidth * s_uiShadowAtlasTextureHeight;
-  ezUInt32 uiUsedAtlasSize = 0;
 
   ezDebugRendererContext debugContext(ezWorld::GetWorld(0));
   if (const ezView* pView = ezRenderWorld::GetViewByUsageHint(ezCameraUsageHint::MainView, ezCameraUsageHint::EditorView))
@@ -736,30 +888,45 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
 
   if (cvar_RenderingShadowsShowPoolStats)
   {
+    const ezShadowMapCache::Stats& stats = cache.GetStats();
+
     ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", "Shadow Pool Stats:", ezColor::LightSteelBlue);
+    ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Lights: {0}, Views: {1}", stats.m_uiNumLights, stats.m_uiNumViews), ezColor::LightSteelBlue);
+    ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Rendered Views: {0} ({1} time sliced)", stats.m_uiNumRenderedViews, stats.m_uiNumTimeSlicedViews), ezColor::LightSteelBlue);
+    ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Cached Views: {0}, Deferred Views: {1}", stats.m_uiNumCachedViews, stats.m_uiNumDeferredViews), ezColor::LightSteelBlue);
+    if (stats.m_uiNumViewsWithoutSpace > 0)
+    {
+      ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Views without atlas space: {0}", stats.m_uiNumViewsWithoutSpace), ezColor::OrangeRed);
+    }
     ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", "Details (Name: Size - Atlas Offset)", ezColor::LightSteelBlue);
   }
 
 #endif
 
-  for (auto& sorted : s_SortedShadowData)
+  for (ezUInt32 uiShadowDataIndex = 0; uiShadowDataIndex < s_pData->m_uiUsedShadowData; ++uiShadowDataIndex)
   {
-    ezUInt32 uiShadowDataIndex = sorted.m_uiIndex;
     auto& shadowData = s_pData->m_ShadowData[uiShadowDataIndex];
 
-    ezUInt32 uiShadowMapSize = s_uiShadowMapSize;
     float fadeOutStart = s_fFadeOutScaleStart;
     float fadeOutEnd = s_fFadeOutScaleEnd;
 
-    // point lights use a lot of atlas space thus we cut the shadow map size in half
+    // point lights use a lot of atlas space thus their shadow maps are half the size
     if (shadowData.m_uiType == LIGHT_TYPE_POINT)
     {
-      uiShadowMapSize /= 2;
       fadeOutStart *= 2.0f;
       fadeOutEnd *= 2.0f;
     }
 
-    uiShadowMapSize = ezMath::PowerOfTwo_Ceil((ezUInt32)(uiShadowMapSize * ezMath::Clamp(shadowData.m_fShadowMapScale, fadeOutStart, 1.0f)));
+    // The scale is only final after all reference views have been extracted, so a larger size is applied in the next frame.
+    // The entry might also have gotten a smaller shadow map than requested if the atlas is full.
+    ezUInt32 uiShadowMapSize = GetShadowMapSize(shadowData.m_uiType, shadowData.m_fShadowMapScale);
+    s_pData->m_Cache.RequestShadowMapSizeForNextFrame(shadowData.m_uiCacheEntryIndex, uiShadowMapSize);
+
+    const ezShadowMapCache::Entry& cacheEntry = cache.GetEntry(shadowData.m_uiCacheEntryIndex);
+    if (cacheEntry.m_uiShadowMapSize != 0)
+    {
+      uiShadowMapSize = cacheEntry.m_uiShadowMapSize;
+    }
 
     ezHybridArray<ezView*, 8> shadowViews;
     ezHybridArray<ezRectU32, 8> atlasRects;
@@ -773,7 +940,7 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
 
       EZ_ASSERT_DEV(pShadowView != nullptr, "Implementation error");
 
-      ezRectU32 atlasRect = FindAtlasRect(uiShadowMapSize, uiShadowDataIndex);
+      ezRectU32 atlasRect = cache.GetAtlasRect(shadowData.m_uiCacheEntryIndex, uiViewIndex);
       atlasRects.PushBack(atlasRect);
 
       pShadowView->SetViewport(ezRectFloat((float)atlasRect.x, (float)atlasRect.y, (float)atlasRect.width, (float)atlasRect.height));
@@ -782,8 +949,6 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
       if (cvar_RenderingShadowsShowPoolStats)
       {
         ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("{0}: {1} - {2}x{3}", pShadowView->GetName(), atlasRect.width, atlasRect.x, atlasRect.y), ezColor::LightSteelBlue);
-
-        uiUsedAtlasSize += atlasRect.width * atlasRect.height;
       }
 #endif
     }
@@ -958,10 +1123,11 @@ void ezShadowPool::OnExtractionEvent(const ezRenderWorldExtractionEvent& e)
 #if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
   if (cvar_RenderingShadowsShowPoolStats)
   {
-    ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Atlas Utilization: {0}%%", ezArgF(100.0 * (double)uiUsedAtlasSize / uiTotalAtlasSize, 2)), ezColor::LightSteelBlue);
+    ezDebugRenderer::DrawInfoText(debugContext, ezDebugRenderer::ScreenPlacement::TopLeft, "ShadowPoolStats", ezFmt("Atlas Utilization: {0}%%", ezArgF(100.0 * (double)cache.GetAllocator().GetAllocatedArea() / uiTotalAtlasSize, 2)), ezColor::LightSteelBlue);
   }
 #endif
 
+  s_pData->m_Cache.EndFrame();
   s_pData->Clear();
 }
 
@@ -974,16 +1140,38 @@ void ezShadowPool::OnRenderEvent(const ezRenderWorldRenderEvent& e)
   if (s_pData->m_hShadowAtlasTexture.IsInvalidated() || s_pData->m_hShadowDataBuffer.IsInvalidated())
     return;
 
+  ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForRendering();
+  auto& atlasRectsToClear = s_pData->m_AtlasRectsToClear[uiDataIndex];
+  bool& bClearWholeAtlas = s_pData->m_bClearWholeAtlas[uiDataIndex];
+
   ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
   ezGALPass* pGALPass = pDevice->BeginPass("Shadow Atlas");
 
   ezGALRenderingSetup renderingSetup;
   renderingSetup.m_RenderTargetSetup.SetDepthStencilTarget(pDevice->GetDefaultRenderTargetView(s_pData->m_hShadowAtlasTexture));
-  renderingSetup.m_bClearDepth = true;
+  renderingSetup.m_bClearDepth = bClearWholeAtlas;
 
-  auto pCommandEncoder = pGALPass->BeginRendering(renderingSetup);
+  ezRenderContext* pRenderContext = ezRenderContext::GetDefaultInstance();
+  auto pCommandEncoder = pRenderContext->BeginRendering(pGALPass, renderingSetup, ezRectFloat(0.0f, 0.0f, (float)s_uiShadowAtlasTextureWidth, (float)s_uiShadowAtlasTextureHeight), "Shadow Atlas");
+
+  // Only the shadow maps that are rendered this frame are cleared, all others keep their content from previous frames
+  if (!bClearWholeAtlas && !atlasRectsToClear.IsEmpty())
+  {
+    EZ_PROFILE_SCOPE("Clear Shadow Maps");
+
+    pRenderContext->BindShader(s_pData->m_hClearShader);
+    pRenderContext->BindMeshBuffer(ezGALBufferHandle(), ezGALBufferHandle(), nullptr, ezGALPrimitiveTopology::Triangles, 1);
+
+    for (const ezRectU32& rect : atlasRectsToClear)
+    {
+      pCommandEncoder->SetViewport(ezRectFloat((float)rect.x, (float)rect.y, (float)rect.width, (float)rect.height));
+      pRenderContext->DrawMeshBuffer().IgnoreResult();
+    }
+  }
+
+  atlasRectsToClear.Clear();
+  bClearWholeAtlas = false;
 
-  ezUInt32 uiDataIndex = ezRenderWorld::GetDataIndexForRendering();
   auto& packedShadowData = s_pData->m_PackedShadowData[uiDataIndex];
   if (!packedShadowData.IsEmpty())
   {
@@ -992,7 +1180,7 @@ void ezShadowPool::OnRenderEvent(const ezRenderWorldRenderEvent& e)
     pCommandEncoder->UpdateBuffer(s_pData->m_hShadowDataBuffer, 0, packedShadowData.GetByteArrayPtr());
   }
 
-  pGALPass->EndRendering(pCommandEncoder);
+  pRenderContext->EndRendering();
   pDevice->EndPass(pGALPass);
 }
 
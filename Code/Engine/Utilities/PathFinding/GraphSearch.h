@@ -1,5 +1,7 @@
 #pragma once
 
+#include <Foundation/Containers/Deque.h>
+#include <Foundation/Containers/DynamicArray.h>
 #include <Foundation/Math/Math.h>
 #include <Utilities/PathFinding/PathState.h>
 #include <Utilities/UtilitiesDLL.h>
@@ -11,6 +13,10 @@
 ///
 /// PathStateType must be derived from ezPathState and can be used for keeping track of certain state along a path and to modify
 /// the path search dynamically.
+///
+/// The nodes that still need to be expanded are kept in a binary heap sorted by their estimated costs. If the range of node indices
+/// is known up front (e.g. the number of cells in a grid), SetDenseNodeIndexRange() can be used to replace the hash table lookup of
+/// visited nodes with a plain array lookup.
 template <typename PathStateType>
 class ezPathSearch
 {
@@ -33,6 +39,13 @@ public:
   /// \brief Sets the ezPathStateGenerator that should be used by this ezPathSearch object.
   void SetPathStateGenerator(ezPathStateGenerator<PathStateType>* pStateGenerator) { m_pStateGenerator = pStateGenerator; }
 
+  /// \brief Tells the path search that all node indices passed to it will be in the range [0; uiNumNodes).
+  ///
+  /// Visited nodes are then looked up through an array of that size instead of a hash table, which is a lot faster for large
+  /// searches, e.g. on big grids. The array is allocated once and reused by all following searches.
+  /// Pass zero to switch back to the hash table lookup, which works with arbitrary node indices.
+  void SetDenseNodeIndexRange(ezUInt32 uiNumNodes);
+
   /// \brief Searches for a path that starts at the graph node \a iStartNodeIndex with the start state \a StartState and shall terminate
   /// when the graph node \a iTargetNodeIndex was reached.
   ///
@@ -57,20 +70,41 @@ public:
   void AddPathNode(ezInt64 iNodeIndex, const PathStateType& NewState);
 
 private:
+  struct NodeData
+  {
+    PathStateType m_State;
+    ezInt64 m_iNodeIndex;
+
+    /// Position of the node in m_OpenHeap, ezInvalidIndex once the node has been expanded.
+    ezUInt32 m_uiHeapIndex;
+  };
+
   void ClearPathStates();
-  ezInt64 FindBestNodeToExpand(PathStateType*& out_pPathState);
-  void FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path);
+  ezUInt32 FindNode(ezInt64 iNodeIndex) const;
+  ezUInt32 AddNode(ezInt64 iNodeIndex, const PathStateType& state);
+  ezUInt32 FindBestNodeToExpand();
+  void HeapSiftUp(ezUInt32 uiHeapIndex);
+  void HeapSiftDown(ezUInt32 uiHeapIndex);
+  void FillOutPathResult(ezUInt32 uiEndNode, ezDeque<PathResultData>& out_Path);
+
+  ezPathStateGenerator<PathStateType>* m_pStateGenerator = nullptr;
 
-  ezPathStateGenerator<PathStateType>* m_pStateGenerator;
+  /// All nodes that were reached during the current search. Nodes are referenced by their index into this array.
+  ezDynamicArray<NodeData> m_Nodes;
 
-  ezHashTable<ezInt64, PathStateType> m_PathStates;
+  /// Maps the node index to the index into m_Nodes, if no dense node index range is set.
+  ezHashTable<ezInt64, ezUInt32> m_NodeLookup;
 
-  ezDeque<ezInt64> m_StateQueue;
+  /// Maps the node index to the index into m_Nodes, if a dense node index range is set.
+  /// Entries are never cleared, instead they are validated against m_Nodes[i].m_iNodeIndex.
+  ezDynamicArray<ezUInt32> m_DenseNodeLookup;
 
-  ezInt64 m_iCurNodeIndex;
+  /// Binary min-heap of the nodes that still need to be expanded, sorted by m_fEstimatedCostToTarget.
+  ezDynamicArray<ezUInt32> m_OpenHeap;
+
+  ezInt64 m_iCurNodeIndex = 0;
   PathStateType m_CurState;
 };
 
 
-
 #include <Utilities/PathFinding/Implementation/GraphSearch_inl.h>
@@ -1,5 +1,6 @@
 #pragma once
 
+#include <Foundation/Containers/Bitfield.h>
 #include <Foundation/Containers/Deque.h>
 #include <Foundation/Math/Rect.h>
 #include <Utilities/DataStructures/GameGrid.h>
@@ -62,6 +63,22 @@ public:
   /// \brief Returns the given area edge by index.
   const AreaEdge& GetAreaEdge(ezInt32 iAreaEdge) const { return m_GraphEdges[iAreaEdge]; }
 
+  /// \brief Searches for a path through the graph of convex areas, from the area at \a vStartCoord to the area at \a vTargetCoord.
+  ///
+  /// This is the coarse level of a hierarchical path search. The graph only has one node per convex area, so even long range queries
+  /// are cheap. The costs between two areas are the distances from the area centers to the center of the edge that connects them,
+  /// so the result is a good corridor, but not necessarily the one that contains the optimal path on the cell level.
+  /// Use MarkAreaCorridor() to restrict a cell level path search to the areas along the returned path.
+  ///
+  /// Returns EZ_FAILURE if one of the cells is blocked or no path could be found.
+  ezResult FindAreaPath(const ezVec2I32& vStartCoord, const ezVec2I32& vTargetCoord, ezDynamicArray<ezInt32>& out_AreaPath) const;
+
+  /// \brief Resizes \a out_Corridor to GetNumConvexAreas() and sets the bits of all areas in \a areaPath.
+  ///
+  /// If \a bIncludeNeighborAreas is set, all areas that are directly adjacent to the path are marked as well. This gives the cell level
+  /// path search more room to find a path that is close to the optimal one.
+  void MarkAreaCorridor(ezArrayPtr<const ezInt32> areaPath, ezDynamicBitfield& out_Corridor, bool bIncludeNeighborAreas = true) const;
+
 private:
   void UpdateRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2);
 
@@ -1,49 +1,155 @@
 #pragma once
 
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::SetDenseNodeIndexRange(ezUInt32 uiNumNodes)
+{
+  // the lookup entries are validated against m_Nodes, so they only need to be in range, not cleared
+  m_DenseNodeLookup.Clear();
+  m_DenseNodeLookup.SetCount(uiNumNodes, ezInvalidIndex);
+  m_DenseNodeLookup.Compact();
+}
+
 template <typename PathStateType>
 void ezPathSearch<PathStateType>::ClearPathStates()
 {
-  m_PathStates.Clear();
-  m_StateQueue.Clear();
+  m_Nodes.Clear();
+  m_NodeLookup.Clear();
+  m_OpenHeap.Clear();
+}
+
+template <typename PathStateType>
+ezUInt32 ezPathSearch<PathStateType>::FindNode(ezInt64 iNodeIndex) const
+{
+  if (!m_DenseNodeLookup.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < (ezInt64)m_DenseNodeLookup.GetCount(), "Node index {0} is outside the dense node index range.", iNodeIndex);
+
+    const ezUInt32 uiNode = m_DenseNodeLookup[static_cast<ezUInt32>(iNodeIndex)];
+    if (uiNode < m_Nodes.GetCount() && m_Nodes[uiNode].m_iNodeIndex == iNodeIndex)
+      return uiNode;
+
+    return ezInvalidIndex;
+  }
+
+  ezUInt32 uiNode = ezInvalidIndex;
+  m_NodeLookup.TryGetValue(iNodeIndex, uiNode);
+  return uiNode;
 }
 
 template <typename PathStateType>
-ezInt64 ezPathSearch<PathStateType>::FindBestNodeToExpand(PathStateType*& out_pPathState)
+ezUInt32 ezPathSearch<PathStateType>::AddNode(ezInt64 iNodeIndex, const PathStateType& state)
 {
-  float fLowestEstimation = ezMath::Infinity<float>();
-  out_pPathState = nullptr;
-  ezUInt32 iBestInQueue = 0;
+  const ezUInt32 uiNode = m_Nodes.GetCount();
+
+  NodeData& node = m_Nodes.ExpandAndGetRef();
+  node.m_State = state;
+  node.m_iNodeIndex = iNodeIndex;
+  node.m_uiHeapIndex = m_OpenHeap.GetCount();
 
-  for (ezUInt32 i = 0; i < m_StateQueue.GetCount(); ++i)
+  if (!m_DenseNodeLookup.IsEmpty())
+  {
+    EZ_ASSERT_DEBUG(iNodeIndex >= 0 && iNodeIndex < (ezInt64)m_DenseNodeLookup.GetCount(), "Node index {0} is outside the dense node index range.", iNodeIndex);
+    m_DenseNodeLookup[static_cast<ezUInt32>(iNodeIndex)] = uiNode;
+  }
+  else
   {
-    const ezInt64 iNodeIndex = m_StateQueue[i];
+    m_NodeLookup.Insert(iNodeIndex, uiNode);
+  }
+
+  // put it into the queue of states that still need to be expanded
+  m_OpenHeap.PushBack(uiNode);
+  HeapSiftUp(node.m_uiHeapIndex);
+
+  return uiNode;
+}
 
-    PathStateType* pState = &m_PathStates[iNodeIndex];
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::HeapSiftUp(ezUInt32 uiHeapIndex)
+{
+  const ezUInt32 uiNode = m_OpenHeap[uiHeapIndex];
+  const float fEstimation = m_Nodes[uiNode].m_State.m_fEstimatedCostToTarget;
 
-    if (pState->m_fEstimatedCostToTarget < fLowestEstimation)
+  while (uiHeapIndex > 0)
+  {
+    const ezUInt32 uiParentHeapIndex = (uiHeapIndex - 1) / 2;
+    const ezUInt32 uiParentNode = m_OpenHeap[uiParentHeapIndex];
+
+    if (m_Nodes[uiParentNode].m_State.m_fEstimatedCostToTarget <= fEstimation)
+      break;
+
+    m_OpenHeap[uiHeapIndex] = uiParentNode;
+    m_Nodes[uiParentNode].m_uiHeapIndex = uiHeapIndex;
+    uiHeapIndex = uiParentHeapIndex;
+  }
+
+  m_OpenHeap[uiHeapIndex] = uiNode;
+  m_Nodes[uiNode].m_uiHeapIndex = uiHeapIndex;
+}
+
+template <typename PathStateType>
+void ezPathSearch<PathStateType>::HeapSiftDown(ezUInt32 uiHeapIndex)
+{
+  const ezUInt32 uiHeapSize = m_OpenHeap.GetCount();
+  const ezUInt32 uiNode = m_OpenHeap[uiHeapIndex];
+  const float fEstimation = m_Nodes[uiNode].m_State.m_fEstimatedCostToTarget;
+
+  while (true)
+  {
+    ezUInt32 uiChildHeapIndex = uiHeapIndex * 2 + 1;
+    if (uiChildHeapIndex >= uiHeapSize)
+      break;
+
+    // pick the cheaper of the two children
+    if (uiChildHeapIndex + 1 < uiHeapSize &&
+        m_Nodes[m_OpenHeap[uiChildHeapIndex + 1]].m_State.m_fEstimatedCostToTarget < m_Nodes[m_OpenHeap[uiChildHeapIndex]].m_State.m_fEstimatedCostToTarget)
     {
-      fLowestEstimation = pState->m_fEstimatedCostToTarget;
-      out_pPathState = pState;
-      iBestInQueue = i;
+      ++uiChildHeapIndex;
     }
+
+    const ezUInt32 uiChildNode = m_OpenHeap[uiChildHeapIndex];
+
+    if (fEstimation <= m_Nodes[uiChildNode].m_State.m_fEstimatedCostToTarget)
+      break;
+
+    m_OpenHeap[uiHeapIndex] = uiChildNode;
+    m_Nodes[uiChildNode].m_uiHeapIndex = uiHeapIndex;
+    uiHeapIndex = uiChildHeapIndex;
   }
 
-  EZ_ASSERT_DEV(out_pPathState != nullptr, "Implementation Error");
+  m_OpenHeap[uiHeapIndex] = uiNode;
+  m_Nodes[uiNode].m_uiHeapIndex = uiHeapIndex;
+}
+
+template <typename PathStateType>
+ezUInt32 ezPathSearch<PathStateType>::FindBestNodeToExpand()
+{
+  EZ_ASSERT_DEV(!m_OpenHeap.IsEmpty(), "Implementation Error");
 
-  const ezInt64 iBestNodeIndex = m_StateQueue[iBestInQueue];
-  m_StateQueue.RemoveAtAndSwap(iBestInQueue);
+  const ezUInt32 uiBestNode = m_OpenHeap[0];
+  m_Nodes[uiBestNode].m_uiHeapIndex = ezInvalidIndex;
+
+  const ezUInt32 uiLastNode = m_OpenHeap.PeekBack();
+  m_OpenHeap.PopBack();
+
+  if (!m_OpenHeap.IsEmpty())
+  {
+    m_OpenHeap[0] = uiLastNode;
+    HeapSiftDown(0);
+  }
 
-  return iBestNodeIndex;
+  return uiBestNode;
 }
 
 template <typename PathStateType>
-void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeque<PathResultData>& out_Path)
+void ezPathSearch<PathStateType>::FillOutPathResult(ezUInt32 uiEndNode, ezDeque<PathResultData>& out_Path)
 {
   out_Path.Clear();
 
+  ezInt64 iEndNodeIndex = m_Nodes[uiEndNode].m_iNodeIndex;
+
   while (true)
   {
-    const PathStateType* pCurState = &m_PathStates[iEndNodeIndex];
+    const PathStateType* pCurState = &m_Nodes[uiEndNode].m_State;
 
     PathResultData r;
     r.m_iNodeIndex = iEndNodeIndex;
@@ -55,6 +161,7 @@ void ezPathSearch<PathStateType>::FillOutPathResult(ezInt64 iEndNodeIndex, ezDeq
       return;
 
     iEndNodeIndex = pCurState->m_iReachedThroughNode;
+    uiEndNode = FindNode(iEndNodeIndex);
   }
 }
 
@@ -69,28 +176,32 @@ void ezPathSearch<PathStateType>::AddPathNode(ezInt64 iNodeIndex, const PathStat
   // ezArgF(m_pCurPathState->m_fEstimatedCostToTarget, 2), ezArgF(NewState.m_fEstimatedCostToTarget, 2));
   EZ_ASSERT_DEV(NewState.m_fEstimatedCostToTarget >= NewState.m_fCostToNode, "Unrealistic expectations will get you nowhere.");
 
-  PathStateType* pExistingState;
+  const ezUInt32 uiExistingNode = FindNode(iNodeIndex);
 
-  if (m_PathStates.TryGetValue(iNodeIndex, pExistingState))
+  if (uiExistingNode != ezInvalidIndex)
   {
-    // state already exists in the hash table, and has a lower cost -> ignore the new state
-    if (pExistingState->m_fCostToNode <= NewState.m_fCostToNode)
+    NodeData& existing = m_Nodes[uiExistingNode];
+
+    // state was already reached before, and has a lower cost -> ignore the new state
+    if (existing.m_State.m_fCostToNode <= NewState.m_fCostToNode)
       return;
 
     // incoming state is better than the existing state -> update existing state
-    *pExistingState = NewState;
-    pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
+    existing.m_State = NewState;
+    existing.m_State.m_iReachedThroughNode = m_iCurNodeIndex;
+
+    // if it is still waiting to be expanded, move it up in the queue
+    if (existing.m_uiHeapIndex != ezInvalidIndex)
+    {
+      HeapSiftUp(existing.m_uiHeapIndex);
+    }
+
     return;
   }
 
   // the state has not been reached before -> insert it
-  pExistingState = &m_PathStates[iNodeIndex];
-
-  *pExistingState = NewState;
-  pExistingState->m_iReachedThroughNode = m_iCurNodeIndex;
-
-  // put it into the queue of states that still need to be expanded
-  m_StateQueue.PushBack(iNodeIndex);
+  const ezUInt32 uiNode = AddNode(iNodeIndex, NewState);
+  m_Nodes[uiNode].m_State.m_iReachedThroughNode = m_iCurNodeIndex;
 }
 
 template <typename PathStateType>
@@ -103,13 +214,11 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
 
   if (iStartNodeIndex == iTargetNodeIndex)
   {
-    m_PathStates.Reserve(1);
-
-    m_PathStates[iTargetNodeIndex] = StartState;
+    const ezUInt32 uiNode = AddNode(iTargetNodeIndex, StartState);
 
     PathResultData r;
     r.m_iNodeIndex = iTargetNodeIndex;
-    r.m_pPathState = &m_PathStates[iTargetNodeIndex];
+    r.m_pPathState = &m_Nodes[uiNode].m_State;
 
     out_Path.Clear();
     out_Path.PushBack(r);
@@ -117,29 +226,27 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
     return EZ_SUCCESS;
   }
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
-
-  m_pStateGenerator->StartSearch(iStartNodeIndex, &FirstState, iTargetNodeIndex);
+  m_Nodes.Reserve(10000);
+  m_OpenHeap.Reserve(1000);
 
   // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
+  // this also puts the start state into the to-be-expanded queue
+  const ezUInt32 uiFirstNode = AddNode(iStartNodeIndex, StartState);
+  m_Nodes[uiFirstNode].m_State.m_iReachedThroughNode = iStartNodeIndex;
 
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  m_pStateGenerator->StartSearch(iStartNodeIndex, &m_Nodes[uiFirstNode].m_State, iTargetNodeIndex);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenHeap.IsEmpty())
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const ezUInt32 uiCurNode = FindBestNodeToExpand();
+    const PathStateType* pCurState = &m_Nodes[uiCurNode].m_State;
+    m_iCurNodeIndex = m_Nodes[uiCurNode].m_iNodeIndex;
 
     // we have reached the target node, generate the final path result
     if (m_iCurNodeIndex == iTargetNodeIndex)
     {
-      FillOutPathResult(m_iCurNodeIndex, out_Path);
+      FillOutPathResult(uiCurNode, out_Path);
       m_pStateGenerator->SearchFinished(EZ_SUCCESS);
       return EZ_SUCCESS;
     }
@@ -153,6 +260,7 @@ ezResult ezPathSearch<PathStateType>::FindPath(ezInt64 iStartNodeIndex, const Pa
       return EZ_FAILURE;
     }
 
+    // m_Nodes may grow while adjacent states are added, so we need a copy of the current state
     m_CurState = *pCurState;
 
     // let the generate append all the nodes that we can reach from here
@@ -172,29 +280,27 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
 
   ClearPathStates();
 
-  m_PathStates.Reserve(10000);
-
-  PathStateType& FirstState = m_PathStates[iStartNodeIndex];
-
-  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &FirstState);
+  m_Nodes.Reserve(10000);
+  m_OpenHeap.Reserve(1000);
 
   // make sure the first state references itself, as that is a termination criterion
-  FirstState = StartState;
-  FirstState.m_iReachedThroughNode = iStartNodeIndex;
+  // this also puts the start state into the to-be-expanded queue
+  const ezUInt32 uiFirstNode = AddNode(iStartNodeIndex, StartState);
+  m_Nodes[uiFirstNode].m_State.m_iReachedThroughNode = iStartNodeIndex;
 
-  // put the start state into the to-be-expanded queue
-  m_StateQueue.PushBack(iStartNodeIndex);
+  m_pStateGenerator->StartSearchForClosest(iStartNodeIndex, &m_Nodes[uiFirstNode].m_State);
 
   // while the queue is not empty, expand the next node and see where that gets us
-  while (!m_StateQueue.IsEmpty())
+  while (!m_OpenHeap.IsEmpty())
   {
-    PathStateType* pCurState;
-    m_iCurNodeIndex = FindBestNodeToExpand(pCurState);
+    const ezUInt32 uiCurNode = FindBestNodeToExpand();
+    const PathStateType* pCurState = &m_Nodes[uiCurNode].m_State;
+    m_iCurNodeIndex = m_Nodes[uiCurNode].m_iNodeIndex;
 
     // we have reached the target node, generate the final path result
     if (Callback(m_iCurNodeIndex, *pCurState))
     {
-      FillOutPathResult(m_iCurNodeIndex, out_Path);
+      FillOutPathResult(uiCurNode, out_Path);
       m_pStateGenerator->SearchFinished(EZ_SUCCESS);
       return EZ_SUCCESS;
     }
@@ -208,6 +314,7 @@ ezResult ezPathSearch<PathStateType>::FindClosest(
       return EZ_FAILURE;
     }
 
+    // m_Nodes may grow while adjacent states are added, so we need a copy of the current state
     m_CurState = *pCurState;
 
     // let the generate append all the nodes that we can reach from here
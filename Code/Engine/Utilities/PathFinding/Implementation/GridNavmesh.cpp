@@ -1,7 +1,103 @@
 #include <Utilities/UtilitiesPCH.h>
 
+#include <Utilities/PathFinding/GraphSearch.h>
 #include <Utilities/PathFinding/GridNavmesh.h>
 
+namespace
+{
+  ezVec2 GetRectCenter(const ezRectU32& r)
+  {
+    return ezVec2(r.x + r.width * 0.5f, r.y + r.height * 0.5f);
+  }
+
+  class AreaStateGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    AreaStateGenerator(const ezGridNavmesh& navmesh, const ezVec2& vTarget)
+      : m_Navmesh(navmesh)
+      , m_vTarget(vTarget)
+    {
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezGridNavmesh::ConvexArea& area = m_Navmesh.GetConvexArea(static_cast<ezInt32>(iNodeIndex));
+      const ezVec2 vAreaCenter = GetRectCenter(area.m_Rect);
+
+      for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+      {
+        const ezGridNavmesh::AreaEdge& edge = m_Navmesh.GetAreaEdge(area.m_uiFirstEdge + e);
+        const ezVec2 vEdgeCenter(edge.m_EdgeRect.x + edge.m_EdgeRect.width * 0.5f, edge.m_EdgeRect.y + edge.m_EdgeRect.height * 0.5f);
+        const ezVec2 vNeighborCenter = GetRectCenter(m_Navmesh.GetConvexArea(edge.m_iNeighborArea).m_Rect);
+
+        // areas never overlap, so their centers are never identical and the costs always grow
+        ezPathState state;
+        state.m_fCostToNode = StartState.m_fCostToNode + (vEdgeCenter - vAreaCenter).GetLength() + (vNeighborCenter - vEdgeCenter).GetLength();
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode + (m_vTarget - vNeighborCenter).GetLength();
+
+        pPathSearch->AddPathNode(edge.m_iNeighborArea, state);
+      }
+    }
+
+  private:
+    const ezGridNavmesh& m_Navmesh;
+    ezVec2 m_vTarget;
+  };
+} // namespace
+
+ezResult ezGridNavmesh::FindAreaPath(const ezVec2I32& vStartCoord, const ezVec2I32& vTargetCoord, ezDynamicArray<ezInt32>& out_AreaPath) const
+{
+  out_AreaPath.Clear();
+
+  const ezInt32 iStartArea = GetAreaAt(vStartCoord);
+  const ezInt32 iTargetArea = GetAreaAt(vTargetCoord);
+
+  if (iStartArea < 0 || iTargetArea < 0)
+    return EZ_FAILURE;
+
+  const ezVec2 vTarget(vTargetCoord.x + 0.5f, vTargetCoord.y + 0.5f);
+
+  AreaStateGenerator generator(*this, vTarget);
+
+  ezPathSearch<ezPathState> search;
+  search.SetPathStateGenerator(&generator);
+  search.SetDenseNodeIndexRange(m_ConvexAreas.GetCount());
+
+  ezPathState startState;
+  startState.m_fEstimatedCostToTarget = (vTarget - GetRectCenter(m_ConvexAreas[iStartArea].m_Rect)).GetLength();
+
+  ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+  EZ_SUCCEED_OR_RETURN(search.FindPath(iStartArea, startState, iTargetArea, path));
+
+  out_AreaPath.Reserve(path.GetCount());
+  for (const auto& step : path)
+  {
+    out_AreaPath.PushBack(static_cast<ezInt32>(step.m_iNodeIndex));
+  }
+
+  return EZ_SUCCESS;
+}
+
+void ezGridNavmesh::MarkAreaCorridor(ezArrayPtr<const ezInt32> areaPath, ezDynamicBitfield& out_Corridor, bool bIncludeNeighborAreas /*= true*/) const
+{
+  out_Corridor.Clear();
+  out_Corridor.SetCount(m_ConvexAreas.GetCount(), false);
+
+  for (ezInt32 iArea : areaPath)
+  {
+    out_Corridor.SetBit(iArea);
+
+    if (!bIncludeNeighborAreas)
+      continue;
+
+    const ConvexArea& area = m_ConvexAreas[iArea];
+    for (ezUInt32 e = 0; e < area.m_uiNumEdges; ++e)
+    {
+      out_Corridor.SetBit(m_GraphEdges[area.m_uiFirstEdge + e].m_iNeighborArea);
+    }
+  }
+}
+
 void ezGridNavmesh::UpdateRegion(ezRectU32 region, CellComparator IsSameCellType, void* pPassThrough1, CellBlocked IsCellBlocked, void* pPassThrough2)
 {
   ezInt32 iInvalidNode = -(ezInt32)m_ConvexAreas.GetCount();
@@ -3,6 +3,7 @@
 #include <BakingPlugin/BakingScene.h>
 #include <BakingPlugin/Tasks/PlaceProbesTask.h>
 #include <BakingPlugin/Tasks/SkyVisibilityTask.h>
+#include <BakingPlugin/Tracer/TracerBVH.h>
 #include <BakingPlugin/Tracer/TracerEmbree.h>
 #include <Core/Assets/AssetFileHeader.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
@@ -93,7 +94,11 @@ ezResult ezBakingScene::Bake(const ezStringView& sOutputPath, ezProgress& progre
 
   if (m_pTracer == nullptr)
   {
+#ifdef BUILDSYSTEM_ENABLE_EMBREE_SUPPORT
     m_pTracer = EZ_DEFAULT_NEW(ezTracerEmbree);
+#else
+    m_pTracer = EZ_DEFAULT_NEW(ezTracerBVH);
+#endif
   }
 
   ezProgressRange pgRange("Baking Scene", 2, true, &progress);
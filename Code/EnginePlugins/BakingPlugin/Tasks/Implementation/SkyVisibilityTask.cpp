@@ -20,13 +20,13 @@ void SkyVisibilityTask::Execute()
   m_SkyVisibility.SetCountUninitialized(m_ProbePositions.GetCount());
 
   const ezUInt32 uiNumSamples = m_Settings.m_uiNumSamplesPerProbe;
-  ezHybridArray<ezTracerInterface::Ray, 128> rays(ezFrameAllocator::GetCurrentAllocator());
-  rays.SetCountUninitialized(uiNumSamples);
+  ezDynamicArray<ezTracerInterface::Ray> sampleRays;
+  sampleRays.SetCountUninitialized(uiNumSamples);
 
   ezAmbientCube<float> weightNormalization;
   for (ezUInt32 uiSampleIndex = 0; uiSampleIndex < uiNumSamples; ++uiSampleIndex)
   {
-    auto& ray = rays[uiSampleIndex];
+    auto& ray = sampleRays[uiSampleIndex];
     ray.m_vDir = ezBakingUtils::FibonacciSphere(uiSampleIndex, uiNumSamples);
     ray.m_fDistance = m_Settings.m_fMaxRayDistance;
 
@@ -38,34 +38,48 @@ void SkyVisibilityTask::Execute()
     weightNormalization.m_Values[i] = 1.0f / weightNormalization.m_Values[i];
   }
 
-  ezHybridArray<ezTracerInterface::Hit, 128> hits(ezFrameAllocator::GetCurrentAllocator());
-  hits.SetCountUninitialized(uiNumSamples);
+  // Probes are independent of each other, so they are distributed across all worker threads.
+  // The frame allocator can't be used here since it is not thread-safe.
+  ezParallelForParams params;
+  params.m_uiBinSize = 4;
+  params.m_uiMaxTasksPerThread = 4;
 
-  for (ezUInt32 uiProbeIndex = 0; uiProbeIndex < m_ProbePositions.GetCount(); ++uiProbeIndex)
-  {
-    ezVec3 probePos = m_ProbePositions[uiProbeIndex];
-    for (ezUInt32 uiSampleIndex = 0; uiSampleIndex < uiNumSamples; ++uiSampleIndex)
-    {
-      rays[uiSampleIndex].m_vStartPos = probePos;
-    }
-
-    m_Tracer.TraceRays(rays, hits);
-
-    ezAmbientCube<float> skyVisibility;
-    for (ezUInt32 uiSampleIndex = 0; uiSampleIndex < uiNumSamples; ++uiSampleIndex)
-    {
-      const auto& ray = rays[uiSampleIndex];
-      const auto& hit = hits[uiSampleIndex];
-      const float value = hit.m_fDistance < 0.0f ? 1.0f : 0.0f;
-
-      skyVisibility.AddSample(ray.m_vDir, value);
-    }
-
-    for (ezUInt32 i = 0; i < ezAmbientCubeBasis::NumDirs; ++i)
-    {
-      skyVisibility.m_Values[i] *= weightNormalization.m_Values[i];
-    }
-    auto& compressedSkyVisibility = m_SkyVisibility[uiProbeIndex];
-    compressedSkyVisibility = ezBakingUtils::CompressSkyVisibility(skyVisibility);
-  }
+  ezTaskSystem::ParallelForIndexed(
+    0, m_ProbePositions.GetCount(),
+    [&](ezUInt32 uiStartProbe, ezUInt32 uiEndProbe) {
+      ezHybridArray<ezTracerInterface::Ray, 128> rays;
+      rays = sampleRays;
+
+      ezHybridArray<ezTracerInterface::Hit, 128> hits;
+      hits.SetCountUninitialized(uiNumSamples);
+
+      for (ezUInt32 uiProbeIndex = uiStartProbe; uiProbeIndex < uiEndProbe; ++uiProbeIndex)
+      {
+        ezVec3 probePos = m_ProbePositions[uiProbeIndex];
+        for (ezUInt32 uiSampleIndex = 0; uiSampleIndex < uiNumSamples; ++uiSampleIndex)
+        {
+          rays[uiSampleIndex].m_vStartPos = probePos;
+        }
+
+        m_Tracer.TraceRays(rays, hits);
+
+        ezAmbientCube<float> skyVisibility;
+        for (ezUInt32 uiSampleIndex = 0; uiSampleIndex < uiNumSamples; ++uiSampleIndex)
+        {
+          const auto& ray = rays[uiSampleIndex];
+          const auto& hit = hits[uiSampleIndex];
+          const float value = hit.m_fDistance < 0.0f ? 1.0f : 0.0f;
+
+          skyVisibility.AddSample(ray.m_vDir, value);
+        }
+
+        for (ezUInt32 i = 0; i < ezAmbientCubeBasis::NumDirs; ++i)
+        {
+          skyVisibility.m_Values[i] *= weightNormalization.m_Values[i];
+        }
+        auto& compressedSkyVisibility = m_SkyVisibility[uiProbeIndex];
+        compressedSkyVisibility = ezBakingUtils::CompressSkyVisibility(skyVisibility);
+      }
+    },
+    "SkyVisibility", params);
 }
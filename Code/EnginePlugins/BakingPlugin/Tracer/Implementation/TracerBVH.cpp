@@ -0,0 +1,730 @@
+#include <BakingPlugin/BakingPluginPCH.h>
+
+#include <BakingPlugin/BakingScene.h>
+#include <BakingPlugin/Tracer/TracerBVH.h>
+#include <Foundation/Math/BoundingBox.h>
+#include <Foundation/SimdMath/SimdVec4f.h>
+#include <RendererCore/Meshes/CpuMeshResource.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiMaxTrianglesPerLeaf = 4;
+  constexpr ezUInt32 s_uiNumBins = 16;
+
+  // Children of a node either reference another node or, with the leaf flag set, a group of four triangles.
+  constexpr ezUInt32 s_uiLeafFlag = EZ_BIT(31);
+  constexpr ezUInt32 s_uiEmptyChild = 0xFFFFFFFF;
+
+  struct BuildNode
+  {
+    ezBoundingBox m_Bounds;
+    ezUInt32 m_uiFirstChild = ezInvalidIndex; // children are always stored next to each other, invalid for leaves
+    ezUInt32 m_uiFirstTriangle = 0;
+    ezUInt32 m_uiNumTriangles = 0;
+  };
+
+  struct Bin
+  {
+    ezBoundingBox m_Bounds = ezBoundingBox::MakeInvalid();
+    ezUInt32 m_uiCount = 0;
+  };
+
+  struct MeshData
+  {
+    ezDynamicArray<ezVec3> m_Positions;
+    ezDynamicArray<ezVec3> m_Normals;
+    ezDynamicArray<ezUInt32> m_Indices;
+  };
+
+  float GetSurfaceArea(const ezBoundingBox& box)
+  {
+    if (!box.IsValid())
+      return 0.0f;
+
+    const ezVec3 vExtents = box.GetExtents();
+    return vExtents.x * vExtents.y + vExtents.y * vExtents.z + vExtents.z * vExtents.x;
+  }
+
+  ezResult ExtractMeshData(const ezCpuMeshResourceHandle& hMeshResource, MeshData& out_meshData)
+  {
+    ezResourceLock<ezCpuMeshResource> pCpuMesh(hMeshResource, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pCpuMesh.GetAcquireResult() != ezResourceAcquireResult::Final)
+    {
+      ezLog::Warning("Failed to retrieve CPU mesh '{}'", hMeshResource.GetResourceID());
+      return EZ_FAILURE;
+    }
+
+    const auto& mbDesc = pCpuMesh->GetDescriptor().MeshBufferDesc();
+
+    const ezVec3* pPositions = nullptr;
+    const ezUInt8* pNormals = nullptr;
+    ezGALResourceFormat::Enum normalFormat = ezGALResourceFormat::Invalid;
+    ezUInt32 uiElementStride = 0;
+    EZ_SUCCEED_OR_RETURN(ezMeshBufferUtils::GetPositionAndNormalStream(mbDesc, pPositions, pNormals, normalFormat, uiElementStride));
+
+    out_meshData.m_Positions.SetCountUninitialized(mbDesc.GetVertexCount());
+    out_meshData.m_Normals.SetCountUninitialized(mbDesc.GetVertexCount());
+
+    ezVec3 vNormal;
+    for (ezUInt32 i = 0; i < mbDesc.GetVertexCount(); ++i)
+    {
+      ezMeshBufferUtils::DecodeNormal(ezMakeArrayPtr(pNormals, sizeof(ezVec3)), normalFormat, vNormal).IgnoreResult();
+
+      out_meshData.m_Positions[i] = *pPositions;
+      out_meshData.m_Normals[i] = vNormal;
+
+      pPositions = ezMemoryUtils::AddByteOffset(pPositions, uiElementStride);
+      pNormals = ezMemoryUtils::AddByteOffset(pNormals, uiElementStride);
+    }
+
+    const ezUInt32 uiNumIndices = mbDesc.GetPrimitiveCount() * 3;
+    out_meshData.m_Indices.SetCountUninitialized(uiNumIndices);
+
+    if (mbDesc.Uses32BitIndices())
+    {
+      const ezUInt32* pTypedIndices = reinterpret_cast<const ezUInt32*>(mbDesc.GetIndexBufferData().GetPtr());
+      for (ezUInt32 i = 0; i < uiNumIndices; ++i)
+      {
+        out_meshData.m_Indices[i] = pTypedIndices[i];
+      }
+    }
+    else
+    {
+      const ezUInt16* pTypedIndices = reinterpret_cast<const ezUInt16*>(mbDesc.GetIndexBufferData().GetPtr());
+      for (ezUInt32 i = 0; i < uiNumIndices; ++i)
+      {
+        out_meshData.m_Indices[i] = pTypedIndices[i];
+      }
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+struct ezTracerBVH::Data
+{
+  /// Bounds of four children in SoA layout, so that one ray can be tested against all of them at once.
+  struct Node
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fMinX[4];
+    float m_fMinY[4];
+    float m_fMinZ[4];
+    float m_fMaxX[4];
+    float m_fMaxY[4];
+    float m_fMaxZ[4];
+    ezUInt32 m_uiChildren[4];
+  };
+
+  /// Four triangles in SoA layout, stored as one vertex and two edges as needed for the Moeller-Trumbore test.
+  /// Unused slots have zero edges and can therefore never be hit.
+  struct Triangles4
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    float m_fV0X[4];
+    float m_fV0Y[4];
+    float m_fV0Z[4];
+    float m_fE1X[4];
+    float m_fE1Y[4];
+    float m_fE1Z[4];
+    float m_fE2X[4];
+    float m_fE2Y[4];
+    float m_fE2Z[4];
+    ezUInt32 m_uiTriangleIndices[4];
+  };
+
+  struct StackEntry
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_uiChild;
+    float m_fDistance;
+  };
+
+  void Clear()
+  {
+    m_Nodes.Clear();
+    m_Triangles.Clear();
+    m_Normals.Clear();
+    m_uiRoot = s_uiEmptyChild;
+    m_uiMaxDepth = 0;
+  }
+
+  ezResult Build(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezVec3> normals, ezArrayPtr<const ezUInt32> indices);
+  void BuildBinaryTree(ezArrayPtr<const ezVec3> centroids, ezArrayPtr<const ezBoundingBox> triangleBounds);
+  ezUInt32 Collapse(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices, ezUInt32 uiBuildNode, ezUInt32 uiDepth);
+  ezUInt32 CreateLeaf(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices, const BuildNode& buildNode);
+  void Trace(const Ray& ray, Hit& ref_hit, ezArrayPtr<StackEntry> stack) const;
+
+  // only needed during the build
+  ezDynamicArray<BuildNode> m_BuildNodes;
+  ezDynamicArray<ezUInt32> m_BuildTriangles;
+
+  ezDynamicArray<Node, ezAlignedAllocatorWrapper> m_Nodes;
+  ezDynamicArray<Triangles4, ezAlignedAllocatorWrapper> m_Triangles;
+  ezDynamicArray<ezVec3> m_Normals; // three per triangle
+  ezUInt32 m_uiRoot = s_uiEmptyChild;
+  ezUInt32 m_uiMaxDepth = 0;
+};
+
+ezResult ezTracerBVH::Data::Build(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezVec3> normals, ezArrayPtr<const ezUInt32> indices)
+{
+  Clear();
+
+  if (indices.GetCount() % 3 != 0)
+  {
+    ezLog::Error("Index count {} is not a multiple of three", indices.GetCount());
+    return EZ_FAILURE;
+  }
+
+  if (!normals.IsEmpty() && normals.GetCount() != positions.GetCount())
+  {
+    ezLog::Error("Normal count {} does not match position count {}", normals.GetCount(), positions.GetCount());
+    return EZ_FAILURE;
+  }
+
+  const ezUInt32 uiNumTriangles = indices.GetCount() / 3;
+  if (uiNumTriangles == 0)
+  {
+    return EZ_SUCCESS;
+  }
+
+  ezDynamicArray<ezVec3> centroids;
+  centroids.SetCountUninitialized(uiNumTriangles);
+  ezDynamicArray<ezBoundingBox> triangleBounds;
+  triangleBounds.SetCountUninitialized(uiNumTriangles);
+  m_Normals.SetCountUninitialized(uiNumTriangles * 3);
+
+  for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+  {
+    ezVec3 v[3];
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      const ezUInt32 uiIndex = indices[t * 3 + i];
+      if (uiIndex >= positions.GetCount())
+      {
+        ezLog::Error("Vertex index {} is out of bounds", uiIndex);
+        Clear();
+        return EZ_FAILURE;
+      }
+
+      v[i] = positions[uiIndex];
+    }
+
+    triangleBounds[t] = ezBoundingBox::MakeFromPoints(v, 3);
+    centroids[t] = triangleBounds[t].GetCenter();
+
+    ezVec3 vFaceNormal = (v[1] - v[0]).CrossRH(v[2] - v[0]);
+    vFaceNormal.NormalizeIfNotZero(ezVec3(0, 0, 1)).IgnoreResult();
+
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      ezVec3 vNormal = normals.IsEmpty() ? vFaceNormal : normals[indices[t * 3 + i]];
+      vNormal.NormalizeIfNotZero(vFaceNormal).IgnoreResult();
+      m_Normals[t * 3 + i] = vNormal;
+    }
+  }
+
+  BuildBinaryTree(centroids, triangleBounds);
+
+  m_Nodes.Reserve(m_BuildNodes.GetCount() / 3 + 1);
+  m_Triangles.Reserve(m_BuildNodes.GetCount() / 2 + 1);
+  m_uiRoot = Collapse(positions, indices, 0, 1);
+
+  m_BuildNodes.Clear();
+  m_BuildNodes.Compact();
+  m_BuildTriangles.Clear();
+  m_BuildTriangles.Compact();
+
+  return EZ_SUCCESS;
+}
+
+void ezTracerBVH::Data::BuildBinaryTree(ezArrayPtr<const ezVec3> centroids, ezArrayPtr<const ezBoundingBox> triangleBounds)
+{
+  const ezUInt32 uiNumTriangles = centroids.GetCount();
+
+  m_BuildTriangles.SetCountUninitialized(uiNumTriangles);
+  for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+  {
+    m_BuildTriangles[t] = t;
+  }
+
+  m_BuildNodes.Reserve(uiNumTriangles * 2);
+  {
+    auto& root = m_BuildNodes.ExpandAndGetRef();
+    root.m_Bounds = ezBoundingBox::MakeInvalid();
+    for (ezUInt32 t = 0; t < uiNumTriangles; ++t)
+    {
+      root.m_Bounds.ExpandToInclude(triangleBounds[t]);
+    }
+    root.m_uiNumTriangles = uiNumTriangles;
+  }
+
+  ezHybridArray<ezUInt32, 64> nodesToSplit;
+  nodesToSplit.PushBack(0);
+
+  while (!nodesToSplit.IsEmpty())
+  {
+    const ezUInt32 uiNodeIndex = nodesToSplit.PeekBack();
+    nodesToSplit.PopBack();
+
+    const ezUInt32 uiFirst = m_BuildNodes[uiNodeIndex].m_uiFirstTriangle;
+    const ezUInt32 uiCount = m_BuildNodes[uiNodeIndex].m_uiNumTriangles;
+
+    if (uiCount <= s_uiMaxTrianglesPerLeaf)
+      continue;
+
+    ezBoundingBox centroidBounds = ezBoundingBox::MakeInvalid();
+    for (ezUInt32 i = uiFirst; i < uiFirst + uiCount; ++i)
+    {
+      centroidBounds.ExpandToInclude(centroids[m_BuildTriangles[i]]);
+    }
+
+    // find the split plane with the lowest surface area heuristic cost by sorting the centroids into bins along each axis
+    float fBestCost = ezMath::MaxValue<float>();
+    ezUInt32 uiBestAxis = 0;
+    ezUInt32 uiBestBin = 0;
+
+    for (ezUInt32 uiAxis = 0; uiAxis < 3; ++uiAxis)
+    {
+      const float fMin = centroidBounds.m_vMin.GetData()[uiAxis];
+      const float fExtent = centroidBounds.m_vMax.GetData()[uiAxis] - fMin;
+      if (fExtent <= 0.0f)
+        continue;
+
+      const float fScale = s_uiNumBins / fExtent;
+
+      Bin bins[s_uiNumBins];
+      for (ezUInt32 i = uiFirst; i < uiFirst + uiCount; ++i)
+      {
+        const ezUInt32 t = m_BuildTriangles[i];
+        const ezUInt32 uiBin = ezMath::Min(static_cast<ezUInt32>((centroids[t].GetData()[uiAxis] - fMin) * fScale), s_uiNumBins - 1);
+        bins[uiBin].m_Bounds.ExpandToInclude(triangleBounds[t]);
+        bins[uiBin].m_uiCount++;
+      }
+
+      float rightAreas[s_uiNumBins];
+      ezUInt32 rightCounts[s_uiNumBins];
+      {
+        ezBoundingBox rightBounds = ezBoundingBox::MakeInvalid();
+        ezUInt32 uiRightCount = 0;
+        for (ezUInt32 b = s_uiNumBins - 1; b > 0; --b)
+        {
+          rightBounds.ExpandToInclude(bins[b].m_Bounds);
+          uiRightCount += bins[b].m_uiCount;
+          rightAreas[b] = GetSurfaceArea(rightBounds);
+          rightCounts[b] = uiRightCount;
+        }
+      }
+
+      ezBoundingBox leftBounds = ezBoundingBox::MakeInvalid();
+      ezUInt32 uiLeftCount = 0;
+      for (ezUInt32 b = 0; b < s_uiNumBins - 1; ++b)
+      {
+        leftBounds.ExpandToInclude(bins[b].m_Bounds);
+        uiLeftCount += bins[b].m_uiCount;
+
+        if (uiLeftCount == 0 || rightCounts[b + 1] == 0)
+          continue;
+
+        const float fCost = GetSurfaceArea(leftBounds) * uiLeftCount + rightAreas[b + 1] * rightCounts[b + 1];
+        if (fCost < fBestCost)
+        {
+          fBestCost = fCost;
+          uiBestAxis = uiAxis;
+          uiBestBin = b;
+        }
+      }
+    }
+
+    ezUInt32 uiLeftCount = 0;
+    if (fBestCost < ezMath::MaxValue<float>())
+    {
+      const float fMin = centroidBounds.m_vMin.GetData()[uiBestAxis];
+      const float fScale = s_uiNumBins / (centroidBounds.m_vMax.GetData()[uiBestAxis] - fMin);
+
+      ezUInt32 uiLeft = uiFirst;
+      ezUInt32 uiRight = uiFirst + uiCount;
+      while (uiLeft < uiRight)
+      {
+        const ezUInt32 t = m_BuildTriangles[uiLeft];
+        const ezUInt32 uiBin = ezMath::Min(static_cast<ezUInt32>((centroids[t].GetData()[uiBestAxis] - fMin) * fScale), s_uiNumBins - 1);
+        if (uiBin <= uiBestBin)
+        {
+          ++uiLeft;
+        }
+        else
+        {
+          --uiRight;
+          ezMath::Swap(m_BuildTriangles[uiLeft], m_BuildTriangles[uiRight]);
+        }
+      }
+
+      uiLeftCount = uiLeft - uiFirst;
+    }
+
+    if (uiLeftCount == 0 || uiLeftCount == uiCount)
+    {
+      // all centroids are in the same spot, just split in the middle
+      uiLeftCount = uiCount / 2;
+    }
+
+    const ezUInt32 uiFirstChild = m_BuildNodes.GetCount();
+    m_BuildNodes[uiNodeIndex].m_uiFirstChild = uiFirstChild;
+
+    for (ezUInt32 c = 0; c < 2; ++c)
+    {
+      auto& child = m_BuildNodes.ExpandAndGetRef();
+      child.m_uiFirstTriangle = c == 0 ? uiFirst : uiFirst + uiLeftCount;
+      child.m_uiNumTriangles = c == 0 ? uiLeftCount : uiCount - uiLeftCount;
+      child.m_Bounds = ezBoundingBox::MakeInvalid();
+      for (ezUInt32 i = child.m_uiFirstTriangle; i < child.m_uiFirstTriangle + child.m_uiNumTriangles; ++i)
+      {
+        child.m_Bounds.ExpandToInclude(triangleBounds[m_BuildTriangles[i]]);
+      }
+
+      nodesToSplit.PushBack(uiFirstChild + c);
+    }
+  }
+}
+
+ezUInt32 ezTracerBVH::Data::Collapse(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices, ezUInt32 uiBuildNode, ezUInt32 uiDepth)
+{
+  m_uiMaxDepth = ezMath::Max(m_uiMaxDepth, uiDepth);
+
+  const BuildNode& buildNode = m_BuildNodes[uiBuildNode];
+  if (buildNode.m_uiFirstChild == ezInvalidIndex)
+  {
+    return CreateLeaf(positions, indices, buildNode);
+  }
+
+  // pull up grand children until there are four children, always opening the largest inner node first
+  ezUInt32 children[4] = {buildNode.m_uiFirstChild, buildNode.m_uiFirstChild + 1};
+  ezUInt32 uiNumChildren = 2;
+  while (uiNumChildren < 4)
+  {
+    ezUInt32 uiBestChild = ezInvalidIndex;
+    float fBestArea = -1.0f;
+    for (ezUInt32 c = 0; c < uiNumChildren; ++c)
+    {
+      const BuildNode& child = m_BuildNodes[children[c]];
+      const float fArea = GetSurfaceArea(child.m_Bounds);
+      if (child.m_uiFirstChild != ezInvalidIndex && fArea > fBestArea)
+      {
+        fBestArea = fArea;
+        uiBestChild = c;
+      }
+    }
+
+    if (uiBestChild == ezInvalidIndex)
+      break;
+
+    const ezUInt32 uiFirstGrandChild = m_BuildNodes[children[uiBestChild]].m_uiFirstChild;
+    children[uiBestChild] = uiFirstGrandChild;
+    children[uiNumChildren] = uiFirstGrandChild + 1;
+    ++uiNumChildren;
+  }
+
+  const ezUInt32 uiNodeIndex = m_Nodes.GetCount();
+  m_Nodes.ExpandAndGetRef();
+
+  for (ezUInt32 c = 0; c < 4; ++c)
+  {
+    ezBoundingBox bounds = ezBoundingBox::MakeInvalid();
+    ezUInt32 uiChild = s_uiEmptyChild;
+
+    if (c < uiNumChildren)
+    {
+      bounds = m_BuildNodes[children[c]].m_Bounds;
+      uiChild = Collapse(positions, indices, children[c], uiDepth + 1);
+    }
+
+    // the reference can't be kept across the recursion since the array might have been resized
+    Node& node = m_Nodes[uiNodeIndex];
+    node.m_fMinX[c] = bounds.m_vMin.x;
+    node.m_fMinY[c] = bounds.m_vMin.y;
+    node.m_fMinZ[c] = bounds.m_vMin.z;
+    node.m_fMaxX[c] = bounds.m_vMax.x;
+    node.m_fMaxY[c] = bounds.m_vMax.y;
+    node.m_fMaxZ[c] = bounds.m_vMax.z;
+    node.m_uiChildren[c] = uiChild;
+  }
+
+  return uiNodeIndex;
+}
+
+ezUInt32 ezTracerBVH::Data::CreateLeaf(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezUInt32> indices, const BuildNode& buildNode)
+{
+  const ezUInt32 uiLeafIndex = m_Triangles.GetCount();
+  Triangles4& triangles = m_Triangles.ExpandAndGetRef();
+
+  for (ezUInt32 i = 0; i < 4; ++i)
+  {
+    ezVec3 v0 = ezVec3::MakeZero();
+    ezVec3 e1 = ezVec3::MakeZero();
+    ezVec3 e2 = ezVec3::MakeZero();
+    ezUInt32 uiTriangle = ezInvalidIndex;
+
+    if (i < buildNode.m_uiNumTriangles)
+    {
+      uiTriangle = m_BuildTriangles[buildNode.m_uiFirstTriangle + i];
+      v0 = positions[indices[uiTriangle * 3 + 0]];
+      e1 = positions[indices[uiTriangle * 3 + 1]] - v0;
+      e2 = positions[indices[uiTriangle * 3 + 2]] - v0;
+    }
+
+    triangles.m_fV0X[i] = v0.x;
+    triangles.m_fV0Y[i] = v0.y;
+    triangles.m_fV0Z[i] = v0.z;
+    triangles.m_fE1X[i] = e1.x;
+    triangles.m_fE1Y[i] = e1.y;
+    triangles.m_fE1Z[i] = e1.z;
+    triangles.m_fE2X[i] = e2.x;
+    triangles.m_fE2Y[i] = e2.y;
+    triangles.m_fE2Z[i] = e2.z;
+    triangles.m_uiTriangleIndices[i] = uiTriangle;
+  }
+
+  return s_uiLeafFlag | uiLeafIndex;
+}
+
+void ezTracerBVH::Data::Trace(const Ray& ray, Hit& ref_hit, ezArrayPtr<StackEntry> stack) const
+{
+  ref_hit.m_vPosition.SetZero();
+  ref_hit.m_vNormal.SetZero();
+  ref_hit.m_fDistance = -1.0f;
+
+  if (m_uiRoot == s_uiEmptyChild)
+    return;
+
+  // avoid divisions by zero, a tiny direction component just moves the box intersections far away
+  ezVec3 vInvDir;
+  for (ezUInt32 i = 0; i < 3; ++i)
+  {
+    float fDir = ray.m_vDir.GetData()[i];
+    if (ezMath::Abs(fDir) < 1e-20f)
+    {
+      fDir = fDir < 0.0f ? -1e-20f : 1e-20f;
+    }
+    vInvDir.GetData()[i] = 1.0f / fDir;
+  }
+
+  const bool bNegX = vInvDir.x < 0.0f;
+  const bool bNegY = vInvDir.y < 0.0f;
+  const bool bNegZ = vInvDir.z < 0.0f;
+
+  const ezSimdVec4f originX(ray.m_vStartPos.x);
+  const ezSimdVec4f originY(ray.m_vStartPos.y);
+  const ezSimdVec4f originZ(ray.m_vStartPos.z);
+  const ezSimdVec4f dirX(ray.m_vDir.x);
+  const ezSimdVec4f dirY(ray.m_vDir.y);
+  const ezSimdVec4f dirZ(ray.m_vDir.z);
+  const ezSimdVec4f invDirX(vInvDir.x);
+  const ezSimdVec4f invDirY(vInvDir.y);
+  const ezSimdVec4f invDirZ(vInvDir.z);
+  const ezSimdVec4f zero = ezSimdVec4f::MakeZero();
+  const ezSimdVec4f one(1.0f);
+  const ezSimdVec4f infinity(ezMath::Infinity<float>());
+
+  float fClosest = ray.m_fDistance;
+  ezUInt32 uiHitTriangle = ezInvalidIndex;
+  float fHitU = 0.0f;
+  float fHitV = 0.0f;
+
+  ezUInt32 uiStackSize = 1;
+  stack[0] = {m_uiRoot, 0.0f};
+
+  while (uiStackSize > 0)
+  {
+    const StackEntry entry = stack[--uiStackSize];
+    if (entry.m_fDistance > fClosest)
+      continue;
+
+    if ((entry.m_uiChild & s_uiLeafFlag) != 0)
+    {
+      const Triangles4& triangles = m_Triangles[entry.m_uiChild & ~s_uiLeafFlag];
+
+      ezSimdVec4f v0X, v0Y, v0Z, e1X, e1Y, e1Z, e2X, e2Y, e2Z;
+      v0X.Load<4>(triangles.m_fV0X);
+      v0Y.Load<4>(triangles.m_fV0Y);
+      v0Z.Load<4>(triangles.m_fV0Z);
+      e1X.Load<4>(triangles.m_fE1X);
+      e1Y.Load<4>(triangles.m_fE1Y);
+      e1Z.Load<4>(triangles.m_fE1Z);
+      e2X.Load<4>(triangles.m_fE2X);
+      e2Y.Load<4>(triangles.m_fE2Y);
+      e2Z.Load<4>(triangles.m_fE2Z);
+
+      // Moeller-Trumbore for four triangles at once
+      const ezSimdVec4f pX = dirY.CompMul(e2Z) - dirZ.CompMul(e2Y);
+      const ezSimdVec4f pY = dirZ.CompMul(e2X) - dirX.CompMul(e2Z);
+      const ezSimdVec4f pZ = dirX.CompMul(e2Y) - dirY.CompMul(e2X);
+      const ezSimdVec4f det = e1X.CompMul(pX) + e1Y.CompMul(pY) + e1Z.CompMul(pZ);
+      const ezSimdVec4b validDet = det.Abs() > zero;
+      const ezSimdVec4f invDet = ezSimdVec4f::Select(validDet, det, one).GetReciprocal();
+
+      const ezSimdVec4f tX = originX - v0X;
+      const ezSimdVec4f tY = originY - v0Y;
+      const ezSimdVec4f tZ = originZ - v0Z;
+      const ezSimdVec4f u = (tX.CompMul(pX) + tY.CompMul(pY) + tZ.CompMul(pZ)).CompMul(invDet);
+
+      const ezSimdVec4f qX = tY.CompMul(e1Z) - tZ.CompMul(e1Y);
+      const ezSimdVec4f qY = tZ.CompMul(e1X) - tX.CompMul(e1Z);
+      const ezSimdVec4f qZ = tX.CompMul(e1Y) - tY.CompMul(e1X);
+      const ezSimdVec4f v = (dirX.CompMul(qX) + dirY.CompMul(qY) + dirZ.CompMul(qZ)).CompMul(invDet);
+      const ezSimdVec4f t = (e2X.CompMul(qX) + e2Y.CompMul(qY) + e2Z.CompMul(qZ)).CompMul(invDet);
+
+      const ezSimdVec4b valid = validDet && (u >= zero) && (v >= zero) && ((u + v) <= one) && (t >= zero) && (t < ezSimdVec4f(fClosest));
+      if (valid.NoneSet())
+        continue;
+
+      float fT[4], fU[4], fV[4];
+      ezSimdVec4f::Select(valid, t, infinity).Store<4>(fT);
+      u.Store<4>(fU);
+      v.Store<4>(fV);
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        if (fT[i] < fClosest)
+        {
+          fClosest = fT[i];
+          uiHitTriangle = triangles.m_uiTriangleIndices[i];
+          fHitU = fU[i];
+          fHitV = fV[i];
+        }
+      }
+
+      continue;
+    }
+
+    const Node& node = m_Nodes[entry.m_uiChild];
+
+    ezSimdVec4f nearX, nearY, nearZ, farX, farY, farZ;
+    nearX.Load<4>(bNegX ? node.m_fMaxX : node.m_fMinX);
+    nearY.Load<4>(bNegY ? node.m_fMaxY : node.m_fMinY);
+    nearZ.Load<4>(bNegZ ? node.m_fMaxZ : node.m_fMinZ);
+    farX.Load<4>(bNegX ? node.m_fMinX : node.m_fMaxX);
+    farY.Load<4>(bNegY ? node.m_fMinY : node.m_fMaxY);
+    farZ.Load<4>(bNegZ ? node.m_fMinZ : node.m_fMaxZ);
+
+    nearX = (nearX - originX).CompMul(invDirX);
+    nearY = (nearY - originY).CompMul(invDirY);
+    nearZ = (nearZ - originZ).CompMul(invDirZ);
+    farX = (farX - originX).CompMul(invDirX);
+    farY = (farY - originY).CompMul(invDirY);
+    farZ = (farZ - originZ).CompMul(invDirZ);
+
+    const ezSimdVec4f tNear = nearX.CompMax(nearY).CompMax(nearZ.CompMax(zero));
+    const ezSimdVec4f tFar = farX.CompMin(farY).CompMin(farZ.CompMin(ezSimdVec4f(fClosest)));
+    const ezSimdVec4b hitMask = tNear <= tFar;
+    if (hitMask.NoneSet())
+      continue;
+
+    float fNear[4];
+    ezSimdVec4f::Select(hitMask, tNear, infinity).Store<4>(fNear);
+
+    // push the hit children sorted by distance, farthest first, so that the closest one is visited next
+    ezUInt32 order[4];
+    ezUInt32 uiNumHits = 0;
+    for (ezUInt32 c = 0; c < 4; ++c)
+    {
+      if (fNear[c] > fClosest)
+        continue;
+
+      ezUInt32 uiInsert = uiNumHits++;
+      while (uiInsert > 0 && fNear[order[uiInsert - 1]] < fNear[c])
+      {
+        order[uiInsert] = order[uiInsert - 1];
+        --uiInsert;
+      }
+      order[uiInsert] = c;
+    }
+
+    for (ezUInt32 i = 0; i < uiNumHits; ++i)
+    {
+      stack[uiStackSize++] = {node.m_uiChildren[order[i]], fNear[order[i]]};
+    }
+  }
+
+  if (uiHitTriangle != ezInvalidIndex)
+  {
+    const ezVec3* pNormals = m_Normals.GetData() + uiHitTriangle * 3;
+    ezVec3 vNormal = pNormals[0] * (1.0f - fHitU - fHitV) + pNormals[1] * fHitU + pNormals[2] * fHitV;
+    vNormal.NormalizeIfNotZero(pNormals[0]).IgnoreResult();
+
+    ref_hit.m_vNormal = vNormal;
+    ref_hit.m_fDistance = fClosest;
+    ref_hit.m_vPosition = ray.m_vStartPos + ray.m_vDir * fClosest;
+  }
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+ezTracerBVH::ezTracerBVH()
+{
+  m_pData = EZ_DEFAULT_NEW(Data);
+}
+
+ezTracerBVH::~ezTracerBVH() = default;
+
+ezResult ezTracerBVH::BuildScene(const ezBakingScene& scene)
+{
+  ezHashTable<ezHashedString, MeshData> meshCache;
+
+  ezDynamicArray<ezVec3> positions;
+  ezDynamicArray<ezVec3> normals;
+  ezDynamicArray<ezUInt32> indices;
+
+  for (auto& meshObject : scene.GetMeshObjects())
+  {
+    ezHashedString sResourceId;
+    sResourceId.Assign(meshObject.m_hMeshResource.GetResourceID());
+
+    bool bExisted = false;
+    MeshData& meshData = meshCache.FindOrAdd(sResourceId, &bExisted);
+    if (!bExisted && ExtractMeshData(meshObject.m_hMeshResource, meshData).Failed())
+    {
+      meshData.m_Indices.Clear();
+    }
+
+    if (meshData.m_Indices.IsEmpty())
+      continue;
+
+    const ezMat4 transform = meshObject.m_GlobalTransform.GetAsMat4();
+    const ezMat3 normalTransform = transform.GetRotationalPart().GetInverse(0.0f).GetTranspose();
+
+    const ezUInt32 uiVertexOffset = positions.GetCount();
+    for (ezUInt32 i = 0; i < meshData.m_Positions.GetCount(); ++i)
+    {
+      positions.PushBack(transform.TransformPosition(meshData.m_Positions[i]));
+      normals.PushBack(normalTransform.TransformDirection(meshData.m_Normals[i]));
+    }
+
+    for (ezUInt32 uiIndex : meshData.m_Indices)
+    {
+      indices.PushBack(uiVertexOffset + uiIndex);
+    }
+  }
+
+  return BuildScene(positions, normals, indices);
+}
+
+ezResult ezTracerBVH::BuildScene(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezVec3> normals, ezArrayPtr<const ezUInt32> indices)
+{
+  return m_pData->Build(positions, normals, indices);
+}
+
+void ezTracerBVH::TraceRays(ezArrayPtr<const Ray> rays, ezArrayPtr<Hit> hits)
+{
+  // every visited node pushes at most four children and pops itself
+  ezHybridArray<Data::StackEntry, 128> stack;
+  stack.SetCountUninitialized(m_pData->m_uiMaxDepth * 3 + 1);
+
+  for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+  {
+    m_pData->Trace(rays[i], hits[i], stack);
+  }
+}
@@ -1,5 +1,7 @@
 #include <BakingPlugin/BakingPluginPCH.h>
 
+#ifdef BUILDSYSTEM_ENABLE_EMBREE_SUPPORT
+
 #include <BakingPlugin/BakingScene.h>
 #include <BakingPlugin/Tracer/TracerEmbree.h>
 #include <Foundation/Configuration/Startup.h>
@@ -311,3 +313,5 @@ void ezTracerEmbree::TraceRays(ezArrayPtr<const Ray> rays, ezArrayPtr<Hit> hits)
     }
   }
 }
+
+#endif
@@ -0,0 +1,32 @@
+#pragma once
+
+#include <BakingPlugin/Tracer/TracerInterface.h>
+#include <Foundation/Types/UniquePtr.h>
+
+/// \brief A self-contained ray tracer that doesn't need any third party library.
+///
+/// All mesh instances of the scene are flattened into one world space triangle soup, from which a bounding volume hierarchy
+/// is built with the surface area heuristic. The hierarchy is collapsed to four children per node and the triangles are stored
+/// in groups of four, so that traversal can test four boxes and four triangles at once with SIMD instructions.
+///
+/// TraceRays() only reads from the acceleration structure and may be called from multiple threads at the same time.
+class EZ_BAKINGPLUGIN_DLL ezTracerBVH : public ezTracerInterface
+{
+public:
+  ezTracerBVH();
+  ~ezTracerBVH();
+
+  virtual ezResult BuildScene(const ezBakingScene& scene) override;
+
+  /// \brief Builds the acceleration structure directly from world space triangles.
+  ///
+  /// Every three consecutive indices form one triangle. The normals are interpolated at the hit position.
+  ezResult BuildScene(ezArrayPtr<const ezVec3> positions, ezArrayPtr<const ezVec3> normals, ezArrayPtr<const ezUInt32> indices);
+
+  virtual void TraceRays(ezArrayPtr<const Ray> rays, ezArrayPtr<Hit> hits) override;
+
+private:
+  struct Data;
+
+  ezUniquePtr<Data> m_pData;
+};
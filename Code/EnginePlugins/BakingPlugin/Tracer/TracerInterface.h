@@ -27,5 +27,6 @@ public:
     float m_fDistance;
   };
 
+  /// \brief Traces all rays against the scene. Must be safe to call from multiple threads at the same time once BuildScene() has finished.
   virtual void TraceRays(ezArrayPtr<const Ray> rays, ezArrayPtr<Hit> hits) = 0;
 };
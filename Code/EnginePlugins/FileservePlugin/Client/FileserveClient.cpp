@@ -74,6 +74,9 @@ void ezFileserveClient::ClearState()
   m_CurFileRequestGuid = ezUuid();
   m_sCurFileRequest.Clear();
   m_Download.Clear();
+  m_PrefetchBatches.Clear();
+  m_PrefetchSingleRequests.Clear();
+  m_PrefetchSupport = PrefetchSupport::Unknown;
 }
 
 ezResult ezFileserveClient::EnsureConnected(ezTime timeout)
@@ -268,6 +271,7 @@ void ezFileserveClient::FillFileStatusCache(const char* szFile)
   EZ_LOCK(m_Mutex);
   auto it = m_FileDataDir.FindOrAdd(szFile);
   it.Value() = 0xffff; // does not exist
+  ezUInt16 uiFallback = 0;
 
   for (ezUInt16 i = static_cast<ezUInt16>(m_MountedDataDirs.GetCount()); i > 0; --i)
   {
@@ -276,6 +280,8 @@ void ezFileserveClient::FillFileStatusCache(const char* szFile)
     if (!m_MountedDataDirs[dd].m_bMounted)
       continue;
 
+    uiFallback = dd;
+
     auto& cache = m_MountedDataDirs[dd].m_CacheStatus[szFile];
 
     DetermineCacheStatus(dd, szFile, cache);
@@ -290,7 +296,7 @@ void ezFileserveClient::FillFileStatusCache(const char* szFile)
   }
 
   if (it.Value() == 0xffff)
-    it.Value() = 0; // fallback
+    it.Value() = uiFallback; // any mounted data dir, an unmounted one may still hold outdated state
 }
 
 void ezFileserveClient::BuildPathInCache(const char* szFile, const char* szMountPoint, ezStringBuilder* out_pAbsPath, ezStringBuilder* out_pFullPathMeta) const
@@ -347,6 +353,31 @@ void ezFileserveClient::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PDWN')
+  {
+    HandlePrefetchTransferMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFIL')
+  {
+    HandlePrefetchFileMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFIN')
+  {
+    HandlePrefetchFinishedMsg(msg);
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PFOK')
+  {
+    if (m_PrefetchSupport == PrefetchSupport::Pending)
+      m_PrefetchSupport = PrefetchSupport::Supported;
+    return;
+  }
+
   static bool s_bReloadResources = false;
 
   if (msg.GetMessageID() == 'RLDR')
@@ -397,10 +428,13 @@ ezUInt16 ezFileserveClient::MountDataDirectory(ezStringView sDataDirectory, ezSt
 
   auto& dd = m_MountedDataDirs.ExpandAndGetRef();
   // dd.m_sPathOnClient = sDataDirectory;
-  // dd.m_sRootName = sRoot;
+  dd.m_sRootName = sRoot;
   dd.m_sMountPoint = sMountPoint;
   dd.m_bMounted = true;
 
+  // the new data directory may contain a better match for any file
+  m_FileDataDir.Clear();
+
   return uiDataDirID;
 }
 
@@ -418,6 +452,9 @@ void ezFileserveClient::UnmountDataDirectory(ezUInt16 uiDataDir)
 
   auto& dd = m_MountedDataDirs[uiDataDir];
   dd.m_bMounted = false;
+
+  // files must not be looked up in this data directory anymore
+  m_FileDataDir.Clear();
 }
 
 void ezFileserveClient::DeleteFile(ezUInt16 uiDataDir, ezStringView sFile)
@@ -449,6 +486,11 @@ void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
     }
   }
 
+  ReadFileTransferChunk(msg, m_Download);
+}
+
+void ezFileserveClient::ReadFileTransferChunk(ezRemoteMessage& msg, ezDynamicArray<ezUInt8>& ref_download)
+{
   ezUInt16 uiChunkSize = 0;
   msg.GetReader() >> uiChunkSize;
 
@@ -456,13 +498,13 @@ void ezFileserveClient::HandleFileTransferMsg(ezRemoteMessage& msg)
   msg.GetReader() >> uiFileSize;
 
   // make sure we don't need to reallocate
-  m_Download.Reserve(uiFileSize);
+  ref_download.Reserve(uiFileSize);
 
   if (uiChunkSize > 0)
   {
-    const ezUInt32 uiStartPos = m_Download.GetCount();
-    m_Download.SetCountUninitialized(uiStartPos + uiChunkSize);
-    msg.GetReader().ReadBytes(&m_Download[uiStartPos], uiChunkSize);
+    const ezUInt32 uiStartPos = ref_download.GetCount();
+    ref_download.SetCountUninitialized(uiStartPos + uiChunkSize);
+    msg.GetReader().ReadBytes(&ref_download[uiStartPos], uiChunkSize);
   }
 }
 
@@ -499,13 +541,20 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   ezUInt16 uiFoundInDataDir = 0;
   msg.GetReader() >> uiFoundInDataDir;
 
+  UpdateCachedFile(m_sCurFileRequest, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, m_Download);
+}
+
+void ezFileserveClient::UpdateCachedFile(const ezString& sFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir, const ezDynamicArray<ezUInt8>& download)
+{
+  EZ_LOCK(m_Mutex);
+
   if (uiFoundInDataDir == 0xffff) // file does not exist on server in any data dir
   {
-    m_FileDataDir[m_sCurFileRequest] = 0; // placeholder
+    m_FileDataDir[sFile] = 0; // placeholder
 
     for (ezUInt32 i = 0; i < m_MountedDataDirs.GetCount(); ++i)
     {
-      auto& ref = m_MountedDataDirs[i].m_CacheStatus[m_sCurFileRequest];
+      auto& ref = m_MountedDataDirs[i].m_CacheStatus[sFile];
       ref.m_FileHash = 0;
       ref.m_TimeStamp = 0;
       ref.m_LastCheck = m_CurrentTime;
@@ -515,9 +564,9 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
   }
   else
   {
-    m_FileDataDir[m_sCurFileRequest] = uiFoundInDataDir;
+    m_FileDataDir[sFile] = uiFoundInDataDir;
 
-    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[m_sCurFileRequest];
+    auto& ref = m_MountedDataDirs[uiFoundInDataDir].m_CacheStatus[sFile];
     ref.m_FileHash = uiFileHash;
     ref.m_TimeStamp = iFileTimeStamp;
     ref.m_LastCheck = m_CurrentTime;
@@ -529,7 +578,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   const ezString& sMountPoint = m_MountedDataDirs[uiFoundInDataDir].m_sMountPoint;
   ezStringBuilder sCachedFile, sCachedMetaFile;
-  BuildPathInCache(m_sCurFileRequest, sMountPoint, &sCachedFile, &sCachedMetaFile);
+  BuildPathInCache(sFile, sMountPoint, &sCachedFile, &sCachedMetaFile);
 
   if (fileState == ezFileserveFileState::NonExistant)
   {
@@ -547,7 +596,7 @@ void ezFileserveClient::HandleFileTransferFinishedMsg(ezRemoteMessage& msg)
 
   if (fileState == ezFileserveFileState::Different)
   {
-    WriteDownloadToDisk(sCachedFile);
+    WriteDownloadToDisk(sCachedFile, download);
     WriteMetaFile(sCachedMetaFile, iFileTimeStamp, uiFileHash);
   }
 }
@@ -569,14 +618,13 @@ void ezFileserveClient::WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 i
   }
 }
 
-void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile)
+void ezFileserveClient::WriteDownloadToDisk(ezStringBuilder sCachedFile, const ezDynamicArray<ezUInt8>& download)
 {
-  EZ_LOCK(m_Mutex);
   ezOSFile file;
   if (file.Open(sCachedFile, ezFileOpenMode::Write).Succeeded())
   {
-    if (!m_Download.IsEmpty())
-      file.Write(m_Download.GetData(), m_Download.GetCount()).IgnoreResult();
+    if (!download.IsEmpty())
+      file.Write(download.GetData(), download.GetCount()).IgnoreResult();
 
     file.Close();
   }
@@ -674,6 +722,423 @@ ezResult ezFileserveClient::DownloadFile(ezUInt16 uiDataDirID, const char* szFil
   }
 }
 
+ezResult ezFileserveClient::PrefetchFiles(ezArrayPtr<const ezString> files, PrefetchResult* out_pResult, ezUInt32 uiBatchSize, ezUInt32 uiMaxBatchesInFlight, ezTime timeout)
+{
+  EZ_LOCK(m_Mutex);
+  if (m_bDownloading)
+  {
+    ezLog::Warning("Trying to prefetch files over fileserve while another file is already downloading. Recursive download is ignored.");
+    return EZ_FAILURE;
+  }
+
+  EZ_ASSERT_DEV(uiBatchSize > 0 && uiMaxBatchesInFlight > 0, "Invalid prefetch batch configuration");
+
+  if (m_pNetwork == nullptr || !m_pNetwork->IsConnectedToServer() || m_MountedDataDirs.IsEmpty())
+    return EZ_FAILURE;
+
+  m_CurrentTime = ezTime::Now();
+  m_PrefetchResult = PrefetchResult();
+  m_PrefetchResult.m_uiNumFiles = files.GetCount();
+
+  // files that have to be requested one by one, because the server can't prefetch them
+  m_PrefetchSingleRequests.Clear();
+
+  {
+    // prevents recursive downloads from message handlers and defers resource reloads until all batches are answered
+    m_bDownloading = true;
+    EZ_SCOPE_EXIT(m_bDownloading = false);
+
+    ezUInt32 uiNextFile = 0;
+
+    if (!CheckPrefetchSupport(timeout))
+    {
+      GatherPrefetchEntries(files, m_PrefetchSingleRequests);
+      uiNextFile = files.GetCount();
+    }
+
+    m_LastPrefetchAnswer = ezTime::Now();
+
+    while (uiNextFile < files.GetCount() || !m_PrefetchBatches.IsEmpty())
+    {
+      // keep multiple batches in flight, so that the server can work on the next one, while the answer to the previous one is transferred
+      while (uiNextFile < files.GetCount() && m_PrefetchBatches.GetCount() < uiMaxBatchesInFlight)
+      {
+        const ezUInt32 uiNumFiles = ezMath::Min(uiBatchSize, files.GetCount() - uiNextFile);
+        SendPrefetchBatch(files.GetSubArray(uiNextFile, uiNumFiles));
+        uiNextFile += uiNumFiles;
+      }
+
+      m_pNetwork->UpdateRemoteInterface();
+      m_pNetwork->ExecuteAllMessageHandlers();
+
+      if (!m_pNetwork->IsConnectedToServer())
+      {
+        ezLog::Error("Fileserve connection was lost while prefetching files.");
+        m_PrefetchBatches.Clear();
+        return EZ_FAILURE;
+      }
+
+      if (!m_PrefetchBatches.IsEmpty() && ezTime::Now() - m_LastPrefetchAnswer > timeout)
+      {
+        ezLog::Warning("Fileserver did not answer prefetch requests for {0} seconds. Requesting the remaining files one by one.", timeout.GetSeconds());
+
+        // don't wait for this server again, late answers to the dropped batches are ignored
+        m_PrefetchSupport = PrefetchSupport::Unsupported;
+
+        while (!m_PrefetchBatches.IsEmpty())
+        {
+          DiscardPrefetchBatch(m_PrefetchBatches.GetCount() - 1);
+        }
+
+        GatherPrefetchEntries(files.GetSubArray(uiNextFile), m_PrefetchSingleRequests);
+        uiNextFile = files.GetCount();
+      }
+    }
+  }
+
+  ezDynamicArray<PrefetchEntry> singleRequests;
+  singleRequests.Swap(m_PrefetchSingleRequests);
+
+  for (const PrefetchEntry& entry : singleRequests)
+  {
+    RequestPrefetchEntry(entry);
+
+    if (!m_pNetwork->IsConnectedToServer())
+    {
+      ezLog::Error("Fileserve connection was lost while prefetching files.");
+      return EZ_FAILURE;
+    }
+  }
+
+  if (out_pResult)
+    *out_pResult = m_PrefetchResult;
+
+  return EZ_SUCCESS;
+}
+
+bool ezFileserveClient::CheckPrefetchSupport(ezTime timeout)
+{
+  EZ_LOCK(m_Mutex);
+
+  if (m_PrefetchSupport == PrefetchSupport::Unknown)
+  {
+    // older servers don't know this message and never answer
+    m_PrefetchSupport = PrefetchSupport::Pending;
+    m_pNetwork->Send('FSRV', 'PFCP');
+
+    const ezTime tStart = ezTime::Now();
+    while (m_PrefetchSupport == PrefetchSupport::Pending && ezTime::Now() - tStart < timeout && m_pNetwork->IsConnectedToServer())
+    {
+      m_pNetwork->UpdateRemoteInterface();
+      m_pNetwork->ExecuteAllMessageHandlers();
+    }
+
+    if (m_PrefetchSupport != PrefetchSupport::Supported)
+    {
+      ezLog::Warning("Fileserver does not support prefetching files. Files are requested one by one instead.");
+      m_PrefetchSupport = PrefetchSupport::Unsupported;
+    }
+  }
+
+  return m_PrefetchSupport == PrefetchSupport::Supported;
+}
+
+void ezFileserveClient::GatherPrefetchEntries(ezArrayPtr<const ezString> files, ezDynamicArray<PrefetchEntry>& out_entries)
+{
+  EZ_LOCK(m_Mutex);
+
+  for (const ezString& sPath : files)
+  {
+    ezStringView sFile = sPath;
+    ezUInt16 uiDataDirID = 0xffff;
+    bool bForceThisDataDir = false;
+
+    if (ezPathUtils::IsRootedPath(sPath))
+    {
+      // a rooted path only refers to the data directory with that name
+      ezStringView sRoot;
+      ezPathUtils::GetRootedPathParts(sPath, sRoot, sFile);
+
+      for (ezUInt16 dd = 0; dd < m_MountedDataDirs.GetCount(); ++dd)
+      {
+        if (m_MountedDataDirs[dd].m_bMounted && m_MountedDataDirs[dd].m_sRootName.IsEqual_NoCase(sRoot))
+        {
+          uiDataDirID = dd;
+          bForceThisDataDir = true;
+        }
+      }
+
+      if (uiDataDirID == 0xffff)
+      {
+        ++m_PrefetchResult.m_uiNumMissing;
+        continue;
+      }
+    }
+    else if (ezPathUtils::IsAbsolutePath(sPath))
+    {
+      // fileserve cannot handle absolute paths
+      ++m_PrefetchResult.m_uiNumMissing;
+      continue;
+    }
+
+    bool bCachedYet = false;
+    auto itFileDataDir = m_FileDataDir.FindOrAdd(sFile, &bCachedYet);
+    if (!bCachedYet)
+    {
+      FillFileStatusCache(itFileDataDir.Key());
+    }
+
+    if (!bForceThisDataDir)
+      uiDataDirID = itFileDataDir.Value();
+
+    const FileCacheStatus& cacheStatus = m_MountedDataDirs[uiDataDirID].m_CacheStatus[sFile];
+
+    if (m_CurrentTime - cacheStatus.m_LastCheck < ezTime::MakeFromSeconds(5.0f))
+    {
+      // checked very recently, no need to ask again
+      if (cacheStatus.m_FileHash == 0)
+        ++m_PrefetchResult.m_uiNumMissing;
+      else
+        ++m_PrefetchResult.m_uiNumUpToDate;
+
+      continue;
+    }
+
+    PrefetchEntry& entry = out_entries.ExpandAndGetRef();
+    entry.m_sFile = sFile;
+    entry.m_uiDataDirID = uiDataDirID;
+    entry.m_bForceThisDataDir = bForceThisDataDir;
+  }
+}
+
+void ezFileserveClient::SendPrefetchBatch(ezArrayPtr<const ezString> files)
+{
+  EZ_LOCK(m_Mutex);
+
+  PrefetchBatch& batch = m_PrefetchBatches.ExpandAndGetRef();
+  batch.m_BatchGuid = ezUuid::MakeUuid();
+  batch.m_Entries.Reserve(files.GetCount());
+
+  GatherPrefetchEntries(files, batch.m_Entries);
+
+  if (batch.m_Entries.IsEmpty())
+  {
+    m_PrefetchBatches.PopBack();
+    return;
+  }
+
+  ezRemoteMessage msg('FSRV', 'PREF');
+  msg.GetWriter() << batch.m_BatchGuid;
+  msg.GetWriter() << batch.m_Entries.GetCount();
+
+  for (const PrefetchEntry& entry : batch.m_Entries)
+  {
+    const FileCacheStatus& cacheStatus = m_MountedDataDirs[entry.m_uiDataDirID].m_CacheStatus[entry.m_sFile];
+
+    msg.GetWriter() << entry.m_uiDataDirID;
+    msg.GetWriter() << entry.m_bForceThisDataDir;
+    msg.GetWriter() << entry.m_sFile;
+    msg.GetWriter() << cacheStatus.m_TimeStamp;
+    msg.GetWriter() << cacheStatus.m_FileHash;
+  }
+
+  m_pNetwork->Send(ezRemoteTransmitMode::Reliable, msg);
+  ++m_PrefetchResult.m_uiNumRoundTrips;
+}
+
+void ezFileserveClient::RequestPrefetchEntry(const PrefetchEntry& entry)
+{
+  EZ_LOCK(m_Mutex);
+
+  const ezUInt64 uiPrevHash = m_MountedDataDirs[entry.m_uiDataDirID].m_CacheStatus[entry.m_sFile].m_FileHash;
+
+  // the result doesn't matter, the file may just have been found in a better data directory
+  DownloadFile(entry.m_uiDataDirID, entry.m_sFile, entry.m_bForceThisDataDir, nullptr).IgnoreResult();
+
+  ++m_PrefetchResult.m_uiNumRoundTrips;
+  ++m_PrefetchResult.m_uiNumSingleRequests;
+
+  const ezUInt16 uiDataDirID = entry.m_bForceThisDataDir ? entry.m_uiDataDirID : m_FileDataDir[entry.m_sFile];
+  const ezUInt64 uiHash = m_MountedDataDirs[uiDataDirID].m_CacheStatus[entry.m_sFile].m_FileHash;
+
+  if (uiHash == 0)
+  {
+    ++m_PrefetchResult.m_uiNumMissing;
+  }
+  else if (uiHash != uiPrevHash)
+  {
+    ++m_PrefetchResult.m_uiNumDownloaded;
+    m_PrefetchResult.m_uiNumBytesDownloaded += m_Download.GetCount();
+  }
+  else
+  {
+    ++m_PrefetchResult.m_uiNumUpToDate;
+  }
+}
+
+void ezFileserveClient::DiscardPrefetchBatch(ezUInt32 uiBatch)
+{
+  EZ_LOCK(m_Mutex);
+
+  for (const PrefetchEntry& entry : m_PrefetchBatches[uiBatch].m_Entries)
+  {
+    if (!entry.m_bReported)
+      m_PrefetchSingleRequests.PushBack(entry);
+  }
+
+  m_PrefetchBatches.RemoveAtAndCopy(uiBatch);
+}
+
+ezUInt32 ezFileserveClient::FindPrefetchBatch(const ezUuid& batchGuid) const
+{
+  EZ_LOCK(m_Mutex);
+  for (ezUInt32 i = 0; i < m_PrefetchBatches.GetCount(); ++i)
+  {
+    if (m_PrefetchBatches[i].m_BatchGuid == batchGuid)
+      return i;
+  }
+
+  return ezInvalidIndex;
+}
+
+void ezFileserveClient::HandlePrefetchTransferMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  const ezUInt32 uiBatch = FindPrefetchBatch(batchGuid);
+  if (uiBatch == ezInvalidIndex)
+    return;
+
+  m_LastPrefetchAnswer = ezTime::Now();
+
+  ReadFileTransferChunk(msg, m_PrefetchBatches[uiBatch].m_Download);
+}
+
+void ezFileserveClient::HandlePrefetchFileMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  const ezUInt32 uiBatch = FindPrefetchBatch(batchGuid);
+  if (uiBatch == ezInvalidIndex)
+    return;
+
+  m_LastPrefetchAnswer = ezTime::Now();
+
+  PrefetchBatch& batch = m_PrefetchBatches[uiBatch];
+
+  // the message contains the results for multiple files, terminated by an invalid index
+  while (true)
+  {
+    ezUInt32 uiEntry = ezInvalidIndex;
+    msg.GetReader() >> uiEntry;
+
+    if (uiEntry == ezInvalidIndex)
+      break;
+
+    // the rest of the message can't be interpreted anymore, so all unanswered files of the batch are requested one by one
+    if (uiEntry >= batch.m_Entries.GetCount())
+    {
+      ezLog::Error("Invalid fileserve prefetch entry index {0} in a batch of {1} files. Message is ignored.", uiEntry, batch.m_Entries.GetCount());
+      DiscardPrefetchBatch(uiBatch);
+      return;
+    }
+
+    ezFileserveFileState fileState;
+    {
+      ezInt8 iFileStatus = 0;
+      msg.GetReader() >> iFileStatus;
+      fileState = (ezFileserveFileState)iFileStatus;
+    }
+
+    ezInt64 iFileTimeStamp = 0;
+    msg.GetReader() >> iFileTimeStamp;
+
+    ezUInt64 uiFileHash = 0;
+    msg.GetReader() >> uiFileHash;
+
+    ezUInt16 uiFoundInDataDir = 0;
+    msg.GetReader() >> uiFoundInDataDir;
+
+    // small files are embedded, large ones were transferred through 'PDWN' messages before
+    ezUInt32 uiInlineBytes = 0;
+    msg.GetReader() >> uiInlineBytes;
+
+    if (uiInlineBytes > msg.GetMessageData().GetCount() || (uiFoundInDataDir != 0xffff && uiFoundInDataDir >= m_MountedDataDirs.GetCount()))
+    {
+      ezLog::Error("Invalid fileserve prefetch result for '{0}'. Message is ignored.", batch.m_Entries[uiEntry].m_sFile);
+      DiscardPrefetchBatch(uiBatch);
+      return;
+    }
+
+    if (uiInlineBytes > 0)
+    {
+      const ezUInt32 uiStartPos = batch.m_Download.GetCount();
+      batch.m_Download.SetCountUninitialized(uiStartPos + uiInlineBytes);
+      msg.GetReader().ReadBytes(&batch.m_Download[uiStartPos], uiInlineBytes);
+    }
+
+    PrefetchEntry& entry = batch.m_Entries[uiEntry];
+    entry.m_bReported = true;
+
+    switch (fileState)
+    {
+      case ezFileserveFileState::Different:
+        ++m_PrefetchResult.m_uiNumDownloaded;
+        m_PrefetchResult.m_uiNumBytesDownloaded += batch.m_Download.GetCount();
+        break;
+
+      case ezFileserveFileState::SameTimestamp:
+      case ezFileserveFileState::SameHash:
+        ++m_PrefetchResult.m_uiNumUpToDate;
+        break;
+
+      default:
+        ++m_PrefetchResult.m_uiNumMissing;
+        break;
+    }
+
+    UpdateCachedFile(entry.m_sFile, fileState, iFileTimeStamp, uiFileHash, uiFoundInDataDir, batch.m_Download);
+    batch.m_Download.Clear();
+  }
+}
+
+void ezFileserveClient::HandlePrefetchFinishedMsg(ezRemoteMessage& msg)
+{
+  EZ_LOCK(m_Mutex);
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  const ezUInt32 uiBatch = FindPrefetchBatch(batchGuid);
+  if (uiBatch == ezInvalidIndex)
+    return;
+
+  m_LastPrefetchAnswer = ezTime::Now();
+
+  // the server only reports files that changed, everything else is confirmed to be up to date (or to not exist)
+  for (const PrefetchEntry& entry : m_PrefetchBatches[uiBatch].m_Entries)
+  {
+    if (entry.m_bReported)
+      continue;
+
+    FileCacheStatus& cacheStatus = m_MountedDataDirs[entry.m_uiDataDirID].m_CacheStatus[entry.m_sFile];
+    cacheStatus.m_LastCheck = m_CurrentTime;
+
+    if (cacheStatus.m_FileHash == 0)
+      ++m_PrefetchResult.m_uiNumMissing;
+    else
+      ++m_PrefetchResult.m_uiNumUpToDate;
+  }
+
+  m_PrefetchBatches.RemoveAtAndCopy(uiBatch);
+}
+
 void ezFileserveClient::DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const
 {
   EZ_LOCK(m_Mutex);
@@ -2,8 +2,10 @@
 
 #include <FileservePlugin/FileservePluginDLL.h>
 
+#include <FileservePlugin/Fileserver/ClientContext.h>
 #include <Foundation/Communication/RemoteInterface.h>
 #include <Foundation/Configuration/Singleton.h>
+#include <Foundation/Containers/Deque.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <Foundation/Types/Uuid.h>
 
@@ -79,6 +81,35 @@ public:
   /// \brief Adds an address that should be tried for connecting with the server.
   void AddServerAddressToTry(ezStringView sAddress);
 
+  /// \brief Statistics about a PrefetchFiles() call.
+  struct PrefetchResult
+  {
+    ezUInt32 m_uiNumFiles = 0;           ///< How many files were requested.
+    ezUInt32 m_uiNumUpToDate = 0;        ///< How many files were already up to date in the local cache.
+    ezUInt32 m_uiNumDownloaded = 0;      ///< How many files had to be transferred, because they were missing or outdated in the local cache.
+    ezUInt32 m_uiNumMissing = 0;         ///< How many files do not exist on the server, or cannot be served through fileserve at all.
+    ezUInt32 m_uiNumRoundTrips = 0;      ///< How many batches of requests were sent to the server.
+    ezUInt32 m_uiNumSingleRequests = 0;  ///< How many files had to be requested one by one, because the server cannot prefetch or did not answer in time.
+    ezUInt64 m_uiNumBytesDownloaded = 0; ///< The size of all transferred files.
+  };
+
+  /// \brief Makes sure that all the given files are up to date in the local fileserve cache, with as few round trips to the server as possible.
+  ///
+  /// This is meant to be called with a list of files that are known to be needed soon, e.g. from a manifest or the entries of a collection resource.
+  /// The paths are relative to the mounted data directories (searched like any other file access), or they start with the root name of a
+  /// fileserve data directory (e.g. ":project/Textures/Stone.dds"). Other paths are ignored.
+  ///
+  /// Instead of requesting every file separately, the cache state (timestamp and hash) of many files is sent to the server in one batch
+  /// and the server only answers with the files that changed. Up to \a uiMaxBatchesInFlight batches are sent before waiting for the answers.
+  /// Afterwards these files can be accessed without contacting the server again, for the same amount of time as after any other file access.
+  ///
+  /// Before the first prefetch on a connection, the client asks the server whether it supports prefetching at all.
+  /// If the server does not confirm that within \a timeout, or stops answering prefetch requests for longer than \a timeout,
+  /// the remaining files are requested one by one instead, just like a regular file access would do.
+  ///
+  /// The function blocks until all files were answered. It fails, if the connection to the server is lost.
+  ezResult PrefetchFiles(ezArrayPtr<const ezString> files, PrefetchResult* out_pResult = nullptr, ezUInt32 uiBatchSize = 256, ezUInt32 uiMaxBatchesInFlight = 4, ezTime timeout = ezTime::MakeFromSeconds(10));
+
 private:
   friend class ezDataDirectory::FileserveType;
 
@@ -94,7 +125,7 @@ private:
 
   struct DataDir
   {
-    // ezString m_sRootName;
+    ezString m_sRootName;
     // ezString m_sPathOnClient;
     ezString m_sMountPoint;
     bool m_bMounted = false;
@@ -102,6 +133,29 @@ private:
     ezMap<ezString, FileCacheStatus> m_CacheStatus;
   };
 
+  struct PrefetchEntry
+  {
+    ezString m_sFile;
+    ezUInt16 m_uiDataDirID = 0;
+    bool m_bForceThisDataDir = false;
+    bool m_bReported = false;
+  };
+
+  struct PrefetchBatch
+  {
+    ezUuid m_BatchGuid;
+    ezDynamicArray<PrefetchEntry> m_Entries;
+    ezDynamicArray<ezUInt8> m_Download;
+  };
+
+  enum class PrefetchSupport : ezUInt8
+  {
+    Unknown,
+    Pending,
+    Supported,
+    Unsupported,
+  };
+
   void DeleteFile(ezUInt16 uiDataDir, ezStringView sFile);
   ezUInt16 MountDataDirectory(ezStringView sDataDir, ezStringView sRootName);
   void UnmountDataDirectory(ezUInt16 uiDataDir);
@@ -111,8 +165,19 @@ private:
   void NetworkMsgHandler(ezRemoteMessage& msg);
   void HandleFileTransferMsg(ezRemoteMessage& msg);
   void HandleFileTransferFinishedMsg(ezRemoteMessage& msg);
+  void HandlePrefetchTransferMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFileMsg(ezRemoteMessage& msg);
+  void HandlePrefetchFinishedMsg(ezRemoteMessage& msg);
+  ezUInt32 FindPrefetchBatch(const ezUuid& batchGuid) const;
+  void DiscardPrefetchBatch(ezUInt32 uiBatch);
+  bool CheckPrefetchSupport(ezTime timeout);
+  void GatherPrefetchEntries(ezArrayPtr<const ezString> files, ezDynamicArray<PrefetchEntry>& out_entries);
+  void SendPrefetchBatch(ezArrayPtr<const ezString> files);
+  void RequestPrefetchEntry(const PrefetchEntry& entry);
+  static void ReadFileTransferChunk(ezRemoteMessage& msg, ezDynamicArray<ezUInt8>& ref_download);
+  void UpdateCachedFile(const ezString& sFile, ezFileserveFileState fileState, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash, ezUInt16 uiFoundInDataDir, const ezDynamicArray<ezUInt8>& download);
   static void WriteMetaFile(ezStringBuilder sCachedMetaFile, ezInt64 iFileTimeStamp, ezUInt64 uiFileHash);
-  void WriteDownloadToDisk(ezStringBuilder sCachedFile);
+  static void WriteDownloadToDisk(ezStringBuilder sCachedFile, const ezDynamicArray<ezUInt8>& download);
   ezResult DownloadFile(ezUInt16 uiDataDirID, const char* szFile, bool bForceThisDataDir, ezStringBuilder* out_pFullPath);
   void DetermineCacheStatus(ezUInt16 uiDataDirID, const char* szFile, FileCacheStatus& out_Status) const;
   void UploadFile(ezUInt16 uiDataDirID, const char* szFile, const ezDynamicArray<ezUInt8>& fileContent);
@@ -139,4 +204,10 @@ private:
 
   ezMap<ezString, ezUInt16> m_FileDataDir;
   ezHybridArray<DataDir, 8> m_MountedDataDirs;
+
+  ezDeque<PrefetchBatch> m_PrefetchBatches;
+  ezDynamicArray<PrefetchEntry> m_PrefetchSingleRequests;
+  PrefetchResult m_PrefetchResult;
+  PrefetchSupport m_PrefetchSupport = PrefetchSupport::Unknown;
+  ezTime m_LastPrefetchAnswer;
 };
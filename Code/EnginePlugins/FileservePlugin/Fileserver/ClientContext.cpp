@@ -6,6 +6,8 @@
 ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiDataDirID, const char* szRequestedFile, FileStatus& inout_status,
   ezDynamicArray<ezUInt8>& out_fileContent, bool bForceThisDataDir) const
 {
+  const bool bClientHasFile = inout_status.m_iTimestamp != 0 || inout_status.m_uiHash != 0;
+
   for (ezUInt16 i = static_cast<ezUInt16>(m_MountedDataDirs.GetCount()); i > 0; --i)
   {
     const ezUInt16 uiDataDirID = i - 1;
@@ -70,7 +72,7 @@ ezFileserveFileState ezFileserveClientContext::GetFileStatus(ezUInt16& inout_uiD
 
   // the client doesn't have the file either
   // this is an optimization to prevent redundant file deletions on the client
-  if (inout_status.m_iTimestamp == 0 && inout_status.m_uiHash == 0)
+  if (!bClientHasFile)
     return ezFileserveFileState::NonExistantEither;
 
   return ezFileserveFileState::NonExistant;
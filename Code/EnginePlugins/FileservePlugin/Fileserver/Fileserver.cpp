@@ -1,6 +1,5 @@
 #include <FileservePlugin/FileservePluginPCH.h>
 
-#include <FileservePlugin/Client/FileserveClient.h>
 #include <FileservePlugin/Fileserver/Fileserver.h>
 #include <Foundation/Algorithm/HashingUtils.h>
 #include <Foundation/Communication/RemoteInterfaceEnet.h>
@@ -12,9 +11,6 @@ EZ_IMPLEMENT_SINGLETON(ezFileserver);
 ezFileserver::ezFileserver()
   : m_SingletonRegistrar(this)
 {
-  // once a server exists, the client should stay inactive
-  ezFileserveClient::DisabledFileserveClient();
-
   // check whether the fileserve port was reconfigured through the command line
   m_uiPort = static_cast<ezUInt16>(ezCommandLineUtils::GetGlobalInstance()->GetIntOption("-fs_port", m_uiPort));
 }
@@ -102,6 +98,19 @@ void ezFileserver::NetworkMsgHandler(ezRemoteMessage& msg)
     return;
   }
 
+  if (msg.GetMessageID() == 'PFCP')
+  {
+    // clients only send prefetch requests, once the server confirmed that it understands them
+    m_pNetwork->Send('FSRV', 'PFOK');
+    return;
+  }
+
+  if (msg.GetMessageID() == 'PREF')
+  {
+    HandlePrefetchRequest(client, msg);
+    return;
+  }
+
   if (msg.GetMessageID() == 'UPLH')
   {
     HandleUploadFileHeader(client, msg);
@@ -284,35 +293,7 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
 
   if (filestate == ezFileserveFileState::Different)
   {
-    ezUInt32 uiNextByte = 0;
-    const ezUInt32 uiFileSize = m_SendToClient.GetCount();
-
-    // send the file over in multiple packages of 1KB each
-    // send at least one package, even for empty files
-    do
-    {
-      const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(1024, m_SendToClient.GetCount() - uiNextByte);
-
-      ezRemoteMessage ret;
-      ret.GetWriter() << downloadGuid;
-      ret.GetWriter() << uiChunkSize;
-      ret.GetWriter() << uiFileSize;
-
-      if (!m_SendToClient.IsEmpty())
-        ret.GetWriter().WriteBytes(&m_SendToClient[uiNextByte], uiChunkSize).IgnoreResult();
-
-      ret.SetMessageID('FSRV', 'DWNL');
-      m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
-
-      uiNextByte += uiChunkSize;
-
-      // reuse previous values
-      {
-        e.m_Type = ezFileserverEvent::Type::FileDownloading;
-        e.m_uiSentTotal = uiNextByte;
-        m_Events.Broadcast(e);
-      }
-    } while (uiNextByte < m_SendToClient.GetCount());
+    SendFileContent('DWNL', downloadGuid, e, 1024);
   }
 
   // final answer to client
@@ -334,6 +315,158 @@ void ezFileserver::HandleFileRequest(ezFileserveClientContext& client, ezRemoteM
   }
 }
 
+void ezFileserver::HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
+{
+  // the answers for many files are combined into few messages, sending every small file separately would be much slower
+  constexpr ezUInt32 uiMaxMessageSize = 16 * 1024;
+
+  ezUuid batchGuid;
+  msg.GetReader() >> batchGuid;
+
+  ezUInt32 uiNumFiles = 0;
+  msg.GetReader() >> uiNumFiles;
+
+  ezRemoteMessage results('FSRV', 'PFIL');
+  results.GetWriter() << batchGuid;
+  bool bHasResults = false;
+
+  auto FlushResults = [&]()
+  {
+    if (!bHasResults)
+      return;
+
+    // end marker
+    results.GetWriter() << ezInvalidIndex;
+    m_pNetwork->Send(ezRemoteTransmitMode::Reliable, results);
+
+    results = ezRemoteMessage('FSRV', 'PFIL');
+    results.GetWriter() << batchGuid;
+    bHasResults = false;
+  };
+
+  ezStringBuilder sRequestedFile;
+
+  ezFileserverEvent e;
+  e.m_uiClientID = client.m_uiApplicationID;
+
+  for (ezUInt32 uiEntry = 0; uiEntry < uiNumFiles; ++uiEntry)
+  {
+    ezUInt16 uiDataDirID = 0;
+    bool bForceThisDataDir = false;
+
+    msg.GetReader() >> uiDataDirID;
+    msg.GetReader() >> bForceThisDataDir;
+    msg.GetReader() >> sRequestedFile;
+
+    ezFileserveClientContext::FileStatus status;
+    msg.GetReader() >> status.m_iTimestamp;
+    msg.GetReader() >> status.m_uiHash;
+
+    const ezFileserveFileState filestate = client.GetFileStatus(uiDataDirID, sRequestedFile, status, m_SendToClient, bForceThisDataDir);
+
+    e.m_szPath = sRequestedFile;
+    e.m_uiSentTotal = 0;
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadRequest;
+      e.m_uiSizeTotal = m_SendToClient.GetCount();
+      e.m_FileState = filestate;
+      m_Events.Broadcast(e);
+    }
+
+    // the client already has the correct state of this file, which is confirmed by the final message
+    if (filestate == ezFileserveFileState::SameTimestamp || filestate == ezFileserveFileState::NonExistantEither)
+      continue;
+
+    // small files are embedded in the result, large files are sent separately before it
+    ezUInt32 uiInlineBytes = 0;
+
+    if (filestate == ezFileserveFileState::Different)
+    {
+      if (m_SendToClient.GetCount() <= uiMaxMessageSize)
+      {
+        uiInlineBytes = m_SendToClient.GetCount();
+      }
+      else
+      {
+        FlushResults();
+        SendFileContent('PDWN', batchGuid, e, uiMaxMessageSize);
+      }
+    }
+
+    results.GetWriter() << uiEntry;
+    results.GetWriter() << (ezInt8)filestate;
+    results.GetWriter() << status.m_iTimestamp;
+    results.GetWriter() << status.m_uiHash;
+    results.GetWriter() << uiDataDirID;
+    results.GetWriter() << uiInlineBytes;
+
+    if (uiInlineBytes > 0)
+    {
+      results.GetWriter().WriteBytes(m_SendToClient.GetData(), uiInlineBytes).IgnoreResult();
+
+      e.m_Type = ezFileserverEvent::Type::FileDownloading;
+      e.m_uiSentTotal = uiInlineBytes;
+      m_Events.Broadcast(e);
+    }
+
+    bHasResults = true;
+
+    if (results.GetMessageData().GetCount() >= uiMaxMessageSize)
+    {
+      FlushResults();
+    }
+
+    {
+      e.m_Type = ezFileserverEvent::Type::FileDownloadFinished;
+      m_Events.Broadcast(e);
+    }
+  }
+
+  FlushResults();
+
+  // all files that were not reported are up to date
+  {
+    ezRemoteMessage ret('FSRV', 'PFIN');
+    ret.GetWriter() << batchGuid;
+
+    m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
+  }
+}
+
+void ezFileserver::SendFileContent(ezUInt32 uiMsgID, const ezUuid& transferGuid, ezFileserverEvent& ref_event, ezUInt16 uiMaxChunkSize)
+{
+  ezUInt32 uiNextByte = 0;
+  const ezUInt32 uiFileSize = m_SendToClient.GetCount();
+
+  // send the file over in multiple packages
+  // send at least one package, even for empty files
+  do
+  {
+    const ezUInt16 uiChunkSize = (ezUInt16)ezMath::Min<ezUInt32>(uiMaxChunkSize, m_SendToClient.GetCount() - uiNextByte);
+
+    ezRemoteMessage ret;
+    ret.GetWriter() << transferGuid;
+    ret.GetWriter() << uiChunkSize;
+    ret.GetWriter() << uiFileSize;
+
+    if (!m_SendToClient.IsEmpty())
+      ret.GetWriter().WriteBytes(&m_SendToClient[uiNextByte], uiChunkSize).IgnoreResult();
+
+    ret.SetMessageID('FSRV', uiMsgID);
+    m_pNetwork->Send(ezRemoteTransmitMode::Reliable, ret);
+
+    uiNextByte += uiChunkSize;
+
+    // reuse previous values
+    {
+      ref_event.m_Type = ezFileserverEvent::Type::FileDownloading;
+      ref_event.m_uiSentTotal = uiNextByte;
+      m_Events.Broadcast(ref_event);
+    }
+  } while (uiNextByte < m_SendToClient.GetCount());
+}
+
 void ezFileserver::HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg)
 {
   ezUInt16 uiDataDirID = 0xffff;
@@ -54,6 +54,9 @@ struct ezFileserverEvent
 /// That means it cannot serve two clients that require different settings for the same special directory.
 ///
 /// The port on which the server connects to clients can be configured through the command line option "-fs_port X"
+///
+/// The server does not touch the fileserve client of its own process. An application that serves its files to others
+/// should call ezFileserveClient::DisabledFileserveClient(), so that it doesn't redirect its own file accesses.
 class EZ_FILESERVEPLUGIN_DLL ezFileserver
 {
   EZ_DECLARE_SINGLETON(ezFileserver);
@@ -96,6 +99,8 @@ private:
   void HandleMountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUnmountRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void HandlePrefetchRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
+  void SendFileContent(ezUInt32 uiMsgID, const ezUuid& transferGuid, ezFileserverEvent& ref_event, ezUInt16 uiMaxChunkSize);
   void HandleDeleteFileRequest(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileHeader(ezFileserveClientContext& client, ezRemoteMessage& msg);
   void HandleUploadFileTransfer(ezFileserveClientContext& client, ezRemoteMessage& msg);
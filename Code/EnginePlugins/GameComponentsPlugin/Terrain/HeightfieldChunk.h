@@ -0,0 +1,61 @@
+#pragma once
+
+#include <Foundation/Containers/DynamicArray.h>
+#include <Foundation/Math/BoundingBox.h>
+#include <Foundation/Math/Vec2.h>
+#include <Foundation/Types/RefCounted.h>
+#include <GameComponentsPlugin/GameComponentsDLL.h>
+
+class ezImage;
+class ezMeshResourceDescriptor;
+
+/// \brief A copy of the red channel of the heightfield image, which the chunk tasks can access without holding a resource lock.
+struct EZ_GAMECOMPONENTS_DLL ezHeightfieldHeightData : public ezRefCounted
+{
+  /// \brief Copies the red channel of the image, which has to be in a float RGBA format.
+  void CopyFrom(const ezImage& heightmap);
+
+  /// \brief Does the same computation as ezImageUtils::BilinearSample() with ezImageAddressMode::Clamp, so heights don't change compared to sampling the image.
+  float Sample(ezVec2 vUv) const;
+
+  ezDynamicArray<float> m_Heights;
+  ezUInt32 m_uiWidth = 0;
+  ezUInt32 m_uiHeight = 0;
+};
+
+/// \brief Describes which part of the heightfield a chunk covers and how its mesh is built.
+struct ezHeightfieldChunkDesc
+{
+  ezVec2U32 m_vFirstQuad = ezVec2U32(0);  ///< index of the first quad of the chunk in the grid of its level
+  ezVec2U32 m_vGridQuads = ezVec2U32(32); ///< number of quads of all chunks of the same level together
+  ezVec2U32 m_vNumQuads = ezVec2U32(32);  ///< number of quads in this chunk
+  float m_fSkirtDepth = 0.0f;             ///< how far the skirt hangs below the chunk border, no skirt is built when zero
+
+  ezVec2 m_vHalfExtents;
+  float m_fHeight = 0.0f;
+  ezVec2 m_vTexCoordOffset;
+  ezVec2 m_vTexCoordScale;
+};
+
+/// \brief The quadtree layout of the heightfield chunks.
+struct ezHeightfieldLodLayout
+{
+  ezUInt32 m_uiNumLevels = 1;
+  ezVec2U32 m_vChunkQuads = ezVec2U32(32); ///< number of quads of every chunk, on all levels
+};
+
+/// \brief Builds the geometry of heightfield chunks. Doesn't access any resources, so all functions can be called from any thread.
+class EZ_GAMECOMPONENTS_DLL ezHeightfieldChunkUtils
+{
+public:
+  /// \brief Computes how many levels are needed so that the deepest level has at least the requested tesselation.
+  static ezHeightfieldLodLayout ComputeLodLayout(ezVec2U32 vTesselation, ezUInt32 uiChunkTesselation);
+
+  /// \brief Computes only the vertex positions of the chunk, in the same order as the vertices of BuildChunkMesh(). Skirts are not included.
+  static void ComputeChunkPositions(const ezHeightfieldChunkDesc& desc, const ezHeightfieldHeightData& data, ezDynamicArray<ezVec3>& out_positions);
+
+  /// \brief Builds the render mesh of the chunk and returns its bounds.
+  ///
+  /// The first (NumQuads.x + 1) * (NumQuads.y + 1) vertices are the grid vertices in row order, skirt vertices follow after them.
+  static ezBoundingBox BuildChunkMesh(const ezHeightfieldChunkDesc& desc, const ezHeightfieldHeightData& data, ezMeshResourceDescriptor& out_desc, ezUInt32& out_uiNumTriangles);
+};
@@ -3,12 +3,17 @@
 #include <Core/ResourceManager/ResourceHandle.h>
 #include <Core/World/Component.h>
 #include <Core/World/World.h>
+#include <Foundation/Containers/HashTable.h>
 #include <Foundation/Math/Vec2.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Types/SharedPtr.h>
 #include <GameComponentsPlugin/GameComponentsDLL.h>
 #include <RendererCore/Components/RenderComponent.h>
 #include <RendererCore/Pipeline/RenderData.h>
 
-class ezGeometry;
+class ezHeightfieldChunkTask;
+struct ezHeightfieldHeightData;
 struct ezMsgExtractRenderData;
 struct ezMsgBuildStaticMesh;
 struct ezMsgExtractGeometry;
@@ -18,6 +23,7 @@ class ezMeshResourceDescriptor;
 using ezMeshResourceHandle = ezTypedResourceHandle<class ezMeshResource>;
 using ezMaterialResourceHandle = ezTypedResourceHandle<class ezMaterialResource>;
 using ezImageDataResourceHandle = ezTypedResourceHandle<class ezImageDataResource>;
+using ezCpuMeshResourceHandle = ezTypedResourceHandle<class ezCpuMeshResource>;
 
 class EZ_GAMECOMPONENTS_DLL ezHeightfieldComponentManager : public ezComponentManager<ezHeightfieldComponent, ezBlockStorageType::Compact>
 {
@@ -31,17 +37,58 @@ public:
   void AddToUpdateList(ezHeightfieldComponent* pComponent);
 
 private:
+  friend class ezHeightfieldComponent;
+
   void ResourceEventHandler(const ezResourceEvent& e);
 
+  void RequestChunk(const ezComponentHandle& hComponent, ezUInt64 uiChunkKey, float fDistanceToCamera) const;
+  void UpdateChunkTasks();
+  void ShowStats();
+
   ezDeque<ezComponentHandle> m_ComponentsToUpdate;
+
+  struct ChunkRequest
+  {
+    ezComponentHandle m_hComponent;
+    ezUInt64 m_uiChunkKey;
+    float m_fDistanceToCamera;
+  };
+
+  mutable ezMutex m_ChunkRequestsMutex;
+  mutable ezDynamicArray<ChunkRequest> m_ChunkRequests;
+
+  struct RunningTask
+  {
+    ezComponentHandle m_hComponent;
+    ezSharedPtr<ezHeightfieldChunkTask> m_pTask;
+    ezTaskGroupID m_TaskGroupID;
+  };
+
+  ezDynamicArray<RunningTask> m_RunningTasks;
+
+  // stats, only gathered when 'Heightfield.ShowStats' is enabled
+  mutable ezAtomicInteger32 m_iNumExtractedChunks;
+  mutable ezAtomicInteger64 m_iNumExtractedTriangles;
+  mutable ezAtomicInteger64 m_iExtractionTimeNS;
+  ezUInt32 m_uiNumGeneratedChunks = 0;
+  ezTime m_GenerationTime;
 };
 
 /// \brief This component utilizes a greyscale image to generate an elevation mesh, which is typically used for simple terrain
 ///
-/// The component always creates a mesh for rendering, which uses a single material.
-/// For different layers of grass, dirt, etc. the material can combine multiple textures and a mask.
+/// The render mesh is split into a quadtree of chunks, which all use the same number of quads ("ChunkTesselation").
+/// The root chunk covers the entire heightfield, the chunks on the deepest level together have the full "Tesselation".
+/// For every view the component renders the coarsest chunks that are detailed enough for their distance to the camera and skips
+/// chunks outside the view frustum. Every chunk samples the heightfield exactly at its own resolution, so neighbors on the same level
+/// match up exactly. The cracks between neighbors with a different level of detail are hidden with a skirt around each chunk.
+///
+/// Chunks are generated on demand by background tasks, once a camera gets close enough, and are released again when they haven't
+/// been rendered for a while. After an edit the previous chunks are shown until the new root chunk is available.
+///
+/// The mesh uses a single material. For different layers of grass, dirt, etc. the material can combine multiple textures and a mask.
 ///
 /// If the "GenerateCollision" property is set, the component also generates a static collision mesh during scene export.
+/// The collision mesh is built from the same chunk layout, with the chunks computed in parallel.
 class EZ_GAMECOMPONENTS_DLL ezHeightfieldComponent : public ezRenderComponent
 {
   EZ_DECLARE_COMPONENT_TYPE(ezHeightfieldComponent, ezRenderComponent, ezHeightfieldComponentManager);
@@ -53,6 +100,7 @@ class EZ_GAMECOMPONENTS_DLL ezHeightfieldComponent : public ezRenderComponent
   virtual void DeserializeComponent(ezWorldReader& stream) override;
 
   virtual void OnActivated() override;
+  virtual void OnDeactivated() override;
 
   //////////////////////////////////////////////////////////////////////////
   // ezRenderComponent
@@ -94,6 +142,12 @@ public:
   ezVec2U32 GetTesselation() const { return m_vTesselation; } // [ property ]
   void SetTesselation(ezVec2U32 value);                       // [ property ]
 
+  ezUInt32 GetChunkTesselation() const { return m_uiChunkTesselation; } // [ property ]
+  void SetChunkTesselation(ezUInt32 value);                           // [ property ]
+
+  float GetLodDistanceScale() const { return m_fLodDistanceScale; } // [ property ]
+  void SetLodDistanceScale(float fScale);                          // [ property ]
+
   void SetGenerateCollision(bool b);                                 // [ property ]
   bool GetGenerateCollision() const { return m_bGenerateCollision; } // [ property ]
 
@@ -108,11 +162,38 @@ protected:
   void OnMsgExtractGeometry(ezMsgExtractGeometry& msg) const; // [ msg handler ]
 
   void InvalidateMesh();
-  void BuildGeometry(ezGeometry& geom) const;
-  ezResult BuildMeshDescriptor(ezMeshResourceDescriptor& desc) const;
+  void InvalidateHeightData();
+  ezResult EnsureHeightDataIsAvailable();
+  void UpdateLodSettings();
 
-  template <typename ResourceType>
-  ezTypedResourceHandle<ResourceType> GenerateMesh() const;
+  ezCpuMeshResourceHandle GenerateCpuMesh() const;
+
+  static ezUInt64 MakeChunkKey(ezUInt32 uiLevel, ezUInt32 x, ezUInt32 y);
+  ezUInt64 ComputeSettingsHash() const;
+
+  struct Chunk
+  {
+    ezMeshResourceHandle m_hMesh; ///< invalid while the chunk is being generated
+    ezBoundingBox m_LocalBounds;
+    ezUInt32 m_uiNumTriangles = 0;
+    mutable ezAtomicInteger64 m_iLastUsedFrame; ///< updated by all views that extract the chunk in parallel
+  };
+
+  using ChunkTable = ezHashTable<ezUInt64, Chunk>;
+
+  struct ExtractContext;
+  void ExtractChunk(ExtractContext& ref_context, ezUInt32 uiLevel, ezUInt32 x, ezUInt32 y) const;
+
+  ezSharedPtr<ezHeightfieldChunkTask> StartChunkGeneration(ezUInt64 uiChunkKey);
+  void FinishChunkGeneration(ezHeightfieldChunkTask& ref_task);
+  void ReleaseUnusedChunks(ezUInt64 uiFrameCounter);
+
+  ChunkTable m_Chunks;
+  ChunkTable m_PreviousChunks; ///< chunks from before the last edit, shown until the new root chunk is ready
+  ezUInt32 m_uiChunkGeneration = 0;
+  ezUInt32 m_uiNumLodLevels = 1;
+  ezVec2U32 m_vChunkQuads = ezVec2U32(32);
+  ezSharedPtr<ezHeightfieldHeightData> m_pHeightData;
 
   ezUInt32 m_uiHeightfieldChangeCounter = 0;
   ezImageDataResourceHandle m_hHeightfield;
@@ -126,9 +207,9 @@ protected:
 
   ezVec2U32 m_vTesselation = ezVec2U32(128);
   ezVec2U32 m_vColMeshTesselation = ezVec2U32(64);
+  ezUInt32 m_uiChunkTesselation = 32;
+  float m_fLodDistanceScale = 1.0f;
 
   bool m_bGenerateCollision = true;
   bool m_bIncludeInNavmesh = true;
-
-  ezMeshResourceHandle m_hMesh;
 };
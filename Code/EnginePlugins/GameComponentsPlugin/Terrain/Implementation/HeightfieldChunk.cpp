@@ -0,0 +1,317 @@
+#include <GameComponentsPlugin/GameComponentsPCH.h>
+
+#include <GameComponentsPlugin/Terrain/HeightfieldChunk.h>
+#include <RendererCore/Meshes/MeshBufferUtils.h>
+#include <RendererCore/Meshes/MeshResourceDescriptor.h>
+#include <Texture/Image/Image.h>
+
+void ezHeightfieldHeightData::CopyFrom(const ezImage& heightmap)
+{
+  m_uiWidth = heightmap.GetWidth();
+  m_uiHeight = heightmap.GetHeight();
+  m_Heights.SetCountUninitialized(m_uiWidth * m_uiHeight);
+
+  const ezColor* pImgData = heightmap.GetPixelPointer<ezColor>();
+  for (ezUInt32 i = 0; i < m_Heights.GetCount(); ++i)
+  {
+    m_Heights[i] = pImgData[i].r;
+  }
+}
+
+float ezHeightfieldHeightData::Sample(ezVec2 vUv) const
+{
+  const ezInt32 w = m_uiWidth;
+  const ezInt32 h = m_uiHeight;
+
+  vUv = vUv.CompMul(ezVec2(static_cast<float>(w), static_cast<float>(h))) - ezVec2(0.5f);
+  const float floorX = ezMath::Floor(vUv.x);
+  const float floorY = ezMath::Floor(vUv.y);
+  const float fractionX = vUv.x - floorX;
+  const float fractionY = vUv.y - floorY;
+  const ezInt32 intX = (ezInt32)floorX;
+  const ezInt32 intY = (ezInt32)floorY;
+
+  const ezInt32 x0 = ezMath::Clamp(intX, 0, w - 1);
+  const ezInt32 x1 = ezMath::Clamp(intX + 1, 0, w - 1);
+  const float* pRow0 = m_Heights.GetData() + ezMath::Clamp(intY, 0, h - 1) * w;
+  const float* pRow1 = m_Heights.GetData() + ezMath::Clamp(intY + 1, 0, h - 1) * w;
+
+  const float r0 = ezMath::Lerp(pRow0[x0], pRow0[x1], fractionX);
+  const float r1 = ezMath::Lerp(pRow1[x0], pRow1[x1], fractionX);
+
+  return ezMath::Lerp(r0, r1, fractionY);
+}
+
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  /// \brief Returns the grid coordinates of a vertex of the chunk, relative to the chunk, clamped to the heightfield.
+  EZ_ALWAYS_INLINE ezVec2U32 GetGridCoordinates(const ezHeightfieldChunkDesc& desc, ezInt32 x, ezInt32 y)
+  {
+    return ezVec2U32(
+      (ezUInt32)ezMath::Clamp<ezInt32>(desc.m_vFirstQuad.x + x, 0, desc.m_vGridQuads.x),
+      (ezUInt32)ezMath::Clamp<ezInt32>(desc.m_vFirstQuad.y + y, 0, desc.m_vGridQuads.y));
+  }
+
+  EZ_ALWAYS_INLINE ezVec2 GetUV(const ezHeightfieldChunkDesc& desc, ezVec2U32 vGridCoords)
+  {
+    // computed from integer grid coordinates, so that neighboring chunks and the chunks of the next level compute exactly the same
+    // values for their shared vertices
+    return ezVec2((float)vGridCoords.x / (float)desc.m_vGridQuads.x, (float)vGridCoords.y / (float)desc.m_vGridQuads.y);
+  }
+
+  EZ_ALWAYS_INLINE ezVec3 GetPosition(const ezHeightfieldChunkDesc& desc, ezVec2 vUv, float fHeight)
+  {
+    return ezVec3(-desc.m_vHalfExtents.x + vUv.x * desc.m_vHalfExtents.x * 2.0f, -desc.m_vHalfExtents.y + vUv.y * desc.m_vHalfExtents.y * 2.0f, (fHeight - 1.0f) * desc.m_fHeight);
+  }
+
+  /// \brief Samples the heights of all vertices of the chunk plus a border of one vertex around it (for computing normals).
+  ///
+  /// Border vertices that would lie outside the heightfield get the height of the closest vertex inside.
+  void SampleChunkHeights(const ezHeightfieldChunkDesc& desc, const ezHeightfieldHeightData& data, ezDynamicArray<float>& out_heights)
+  {
+    const ezUInt32 uiStride = desc.m_vNumQuads.x + 3;
+    out_heights.SetCountUninitialized(uiStride * (desc.m_vNumQuads.y + 3));
+
+    ezUInt32 uiIdx = 0;
+    for (ezInt32 y = -1; y <= (ezInt32)desc.m_vNumQuads.y + 1; ++y)
+    {
+      for (ezInt32 x = -1; x <= (ezInt32)desc.m_vNumQuads.x + 1; ++x)
+      {
+        out_heights[uiIdx++] = data.Sample(GetUV(desc, GetGridCoordinates(desc, x, y)));
+      }
+    }
+  }
+} // namespace
+
+ezHeightfieldLodLayout ezHeightfieldChunkUtils::ComputeLodLayout(ezVec2U32 vTesselation, ezUInt32 uiChunkTesselation)
+{
+  const ezUInt32 uiChunkQuads = ezMath::Clamp(uiChunkTesselation, 4u, 256u);
+
+  ezHeightfieldLodLayout layout;
+  while (ezMath::Max(vTesselation.x, vTesselation.y) > (uiChunkQuads << (layout.m_uiNumLevels - 1)) && layout.m_uiNumLevels < 8)
+  {
+    ++layout.m_uiNumLevels;
+  }
+
+  const ezUInt32 uiNumLeafChunks = 1u << (layout.m_uiNumLevels - 1);
+  layout.m_vChunkQuads.x = (vTesselation.x + uiNumLeafChunks - 1) / uiNumLeafChunks;
+  layout.m_vChunkQuads.y = (vTesselation.y + uiNumLeafChunks - 1) / uiNumLeafChunks;
+
+  return layout;
+}
+
+void ezHeightfieldChunkUtils::ComputeChunkPositions(const ezHeightfieldChunkDesc& desc, const ezHeightfieldHeightData& data, ezDynamicArray<ezVec3>& out_positions)
+{
+  ezDynamicArray<float> heights;
+  SampleChunkHeights(desc, data, heights);
+
+  const ezUInt32 uiStride = desc.m_vNumQuads.x + 3;
+  out_positions.SetCountUninitialized((desc.m_vNumQuads.x + 1) * (desc.m_vNumQuads.y + 1));
+
+  ezUInt32 uiVertexIdx = 0;
+  for (ezUInt32 y = 0; y <= desc.m_vNumQuads.y; ++y)
+  {
+    for (ezUInt32 x = 0; x <= desc.m_vNumQuads.x; ++x)
+    {
+      const ezVec2 vUv = GetUV(desc, GetGridCoordinates(desc, x, y));
+      out_positions[uiVertexIdx++] = GetPosition(desc, vUv, heights[(y + 1) * uiStride + (x + 1)]);
+    }
+  }
+}
+
+ezBoundingBox ezHeightfieldChunkUtils::BuildChunkMesh(const ezHeightfieldChunkDesc& desc, const ezHeightfieldHeightData& data, ezMeshResourceDescriptor& out_desc, ezUInt32& out_uiNumTriangles)
+{
+  const ezUInt32 uiNumQuadsX = desc.m_vNumQuads.x;
+  const ezUInt32 uiNumQuadsY = desc.m_vNumQuads.y;
+  const ezUInt32 uiNumVerticesX = uiNumQuadsX + 1;
+  const ezUInt32 uiNumVerticesY = uiNumQuadsY + 1;
+  const ezUInt32 uiNumGridVertices = uiNumVerticesX * uiNumVerticesY;
+
+  ezDynamicArray<float> heights;
+  SampleChunkHeights(desc, data, heights);
+  const ezUInt32 uiStride = uiNumQuadsX + 3;
+
+  // the chunk border in counter-clockwise order (seen from above), the outside is always to the right
+  ezDynamicArray<ezUInt32> border;
+  ezDynamicArray<bool> borderSegmentNeedsSkirt;
+
+  if (desc.m_fSkirtDepth > 0.0f)
+  {
+    // no skirts along the outer border of the heightfield, there is no neighbor to stitch to
+    const bool bSouth = desc.m_vFirstQuad.y > 0;
+    const bool bEast = desc.m_vFirstQuad.x + uiNumQuadsX < desc.m_vGridQuads.x;
+    const bool bNorth = desc.m_vFirstQuad.y + uiNumQuadsY < desc.m_vGridQuads.y;
+    const bool bWest = desc.m_vFirstQuad.x > 0;
+
+    for (ezUInt32 x = 0; x < uiNumQuadsX; ++x)
+    {
+      border.PushBack(x);
+      borderSegmentNeedsSkirt.PushBack(bSouth);
+    }
+    for (ezUInt32 y = 0; y < uiNumQuadsY; ++y)
+    {
+      border.PushBack(y * uiNumVerticesX + uiNumQuadsX);
+      borderSegmentNeedsSkirt.PushBack(bEast);
+    }
+    for (ezUInt32 x = uiNumQuadsX; x > 0; --x)
+    {
+      border.PushBack(uiNumQuadsY * uiNumVerticesX + x);
+      borderSegmentNeedsSkirt.PushBack(bNorth);
+    }
+    for (ezUInt32 y = uiNumQuadsY; y > 0; --y)
+    {
+      border.PushBack(y * uiNumVerticesX);
+      borderSegmentNeedsSkirt.PushBack(bWest);
+    }
+  }
+
+  ezUInt32 uiNumSkirtSegments = 0;
+  for (bool b : borderSegmentNeedsSkirt)
+  {
+    uiNumSkirtSegments += b ? 1 : 0;
+  }
+
+  const ezUInt32 uiNumVertices = uiNumGridVertices + border.GetCount();
+  out_uiNumTriangles = uiNumQuadsX * uiNumQuadsY * 2 + uiNumSkirtSegments * 2;
+
+  // Data/Base/Materials/Common/Pattern.ezMaterialAsset
+  out_desc.SetMaterial(0, "{ 1c47ee4c-0379-4280-85f5-b8cda61941d2 }");
+
+  out_desc.MeshBufferDesc().AddCommonStreams();
+  // 0 = position
+  // 1 = texcoord
+  // 2 = normal
+  // 3 = tangent
+
+  auto& mb = out_desc.MeshBufferDesc();
+  mb.AllocateStreams(uiNumVertices, ezGALPrimitiveTopology::Triangles, out_uiNumTriangles);
+
+  const auto texCoordFormat = ezMeshTexCoordPrecision::ToResourceFormat(ezMeshTexCoordPrecision::Default);
+  const auto normalFormat = ezMeshNormalPrecision::ToResourceFormatNormal(ezMeshNormalPrecision::Default);
+  const auto tangentFormat = ezMeshNormalPrecision::ToResourceFormatTangent(ezMeshNormalPrecision::Default);
+
+  // access the vertex data directly, this is way faster than going through SetVertexData
+  auto positionData = mb.GetVertexData(0, 0);
+  auto texcoordData = mb.GetVertexData(1, 0);
+  auto normalData = mb.GetVertexData(2, 0);
+  auto tangentData = mb.GetVertexData(3, 0);
+
+  const size_t uiVertexDataSize = mb.GetVertexDataSize();
+
+  // normals are computed from the sampled heights including the outer border, so that neighboring chunks on the same level
+  // compute the same normals along their shared border
+  {
+    const float fCellSizeX = desc.m_vHalfExtents.x * 2.0f / desc.m_vGridQuads.x;
+    const float fCellSizeY = desc.m_vHalfExtents.y * 2.0f / desc.m_vGridQuads.y;
+
+    ezUInt32 uiVertexIdx = 0;
+    for (ezInt32 y = 0; y < (ezInt32)uiNumVerticesY; ++y)
+    {
+      for (ezInt32 x = 0; x < (ezInt32)uiNumVerticesX; ++x)
+      {
+        const ezVec2U32 vLeft = GetGridCoordinates(desc, x - 1, y);
+        const ezVec2U32 vRight = GetGridCoordinates(desc, x + 1, y);
+        const ezVec2U32 vBottom = GetGridCoordinates(desc, x, y - 1);
+        const ezVec2U32 vTop = GetGridCoordinates(desc, x, y + 1);
+
+        const float fHeightLeft = heights[(y + 1) * uiStride + x];
+        const float fHeightRight = heights[(y + 1) * uiStride + x + 2];
+        const float fHeightBottom = heights[y * uiStride + x + 1];
+        const float fHeightTop = heights[(y + 2) * uiStride + x + 1];
+
+        const float fSlopeX = (fHeightRight - fHeightLeft) * desc.m_fHeight / ((vRight.x - vLeft.x) * fCellSizeX);
+        const float fSlopeY = (fHeightTop - fHeightBottom) * desc.m_fHeight / ((vTop.y - vBottom.y) * fCellSizeY);
+
+        const ezVec3 vNormal = ezVec3(-fSlopeX, -fSlopeY, 1.0f).GetNormalized();
+        const ezVec3 vTangent = ezVec3(1, 0, 0).CrossRH(vNormal).GetNormalized();
+
+        const size_t uiByteOffset = (size_t)uiVertexIdx * uiVertexDataSize;
+        ezMeshBufferUtils::EncodeNormal(vNormal, ezByteArrayPtr(normalData.GetPtr() + uiByteOffset, 32), normalFormat).IgnoreResult();
+        ezMeshBufferUtils::EncodeTangent(vTangent, 1.0f, ezByteArrayPtr(tangentData.GetPtr() + uiByteOffset, 32), tangentFormat).IgnoreResult();
+
+        ++uiVertexIdx;
+      }
+    }
+  }
+
+  ezBoundingBox bounds = ezBoundingBox::MakeInvalid();
+
+  {
+    ezUInt32 uiVertexIdx = 0;
+    for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
+    {
+      for (ezUInt32 x = 0; x < uiNumVerticesX; ++x)
+      {
+        const ezVec2 vUv = GetUV(desc, GetGridCoordinates(desc, x, y));
+        const ezVec3 vPos = GetPosition(desc, vUv, heights[(y + 1) * uiStride + (x + 1)]);
+        const ezVec2 vTexCoord = desc.m_vTexCoordOffset + vUv.CompMul(desc.m_vTexCoordScale);
+
+        const size_t uiByteOffset = (size_t)uiVertexIdx * uiVertexDataSize;
+        *reinterpret_cast<ezVec3*>(positionData.GetPtr() + uiByteOffset) = vPos;
+        ezMeshBufferUtils::EncodeTexCoord(vTexCoord, ezByteArrayPtr(texcoordData.GetPtr() + uiByteOffset, 32), texCoordFormat).IgnoreResult();
+
+        bounds.ExpandToInclude(vPos);
+        ++uiVertexIdx;
+      }
+    }
+  }
+
+  // skirt vertices are copies of the border vertices, moved down, but never below the lowest point of the heightfield
+  for (ezUInt32 i = 0; i < border.GetCount(); ++i)
+  {
+    const size_t uiSrcOffset = (size_t)border[i] * uiVertexDataSize;
+    const size_t uiDstOffset = (size_t)(uiNumGridVertices + i) * uiVertexDataSize;
+
+    ezMemoryUtils::Copy(positionData.GetPtr() + uiDstOffset, positionData.GetPtr() + uiSrcOffset, uiVertexDataSize);
+
+    ezVec3& vPos = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + uiDstOffset);
+    vPos.z = ezMath::Max(vPos.z - desc.m_fSkirtDepth, -desc.m_fHeight);
+
+    bounds.ExpandToInclude(vPos);
+  }
+
+  ezUInt32 uiTriangleIdx = 0;
+
+  {
+    ezUInt32 uiVertexIdx = 0;
+    for (ezUInt32 y = 0; y < uiNumQuadsY; ++y)
+    {
+      for (ezUInt32 x = 0; x < uiNumQuadsX; ++x)
+      {
+        mb.SetTriangleIndices(uiTriangleIdx + 0, uiVertexIdx, uiVertexIdx + 1, uiVertexIdx + uiNumVerticesX);
+        mb.SetTriangleIndices(uiTriangleIdx + 1, uiVertexIdx + 1, uiVertexIdx + uiNumVerticesX + 1, uiVertexIdx + uiNumVerticesX);
+        uiTriangleIdx += 2;
+
+        ++uiVertexIdx;
+      }
+
+      ++uiVertexIdx;
+    }
+  }
+
+  for (ezUInt32 i = 0; i < border.GetCount(); ++i)
+  {
+    if (!borderSegmentNeedsSkirt[i])
+      continue;
+
+    const ezUInt32 uiNext = (i + 1) % border.GetCount();
+
+    const ezUInt32 a = border[i];
+    const ezUInt32 b = border[uiNext];
+    const ezUInt32 a2 = uiNumGridVertices + i;
+    const ezUInt32 b2 = uiNumGridVertices + uiNext;
+
+    mb.SetTriangleIndices(uiTriangleIdx + 0, a2, b2, b);
+    mb.SetTriangleIndices(uiTriangleIdx + 1, a2, b, a);
+    uiTriangleIdx += 2;
+  }
+
+  EZ_ASSERT_DEBUG(uiTriangleIdx == out_uiNumTriangles, "Invalid triangle count");
+
+  out_desc.SetBounds(ezBoundingBoxSphere::MakeFromBox(bounds));
+  out_desc.AddSubMesh(mb.GetPrimitiveCount(), 0, 0);
+
+  return bounds;
+}
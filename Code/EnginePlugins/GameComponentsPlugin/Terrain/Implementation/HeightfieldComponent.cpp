@@ -1,21 +1,30 @@
 #include <GameComponentsPlugin/GameComponentsPCH.h>
 
-#include <Core/Graphics/Geometry.h>
 #include <Core/Interfaces/PhysicsWorldModule.h>
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/SimdMath/SimdBBox.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameComponentsPlugin/Terrain/HeightfieldChunk.h>
 #include <GameComponentsPlugin/Terrain/HeightfieldComponent.h>
 #include <GameEngine/Utils/ImageDataResource.h>
+#include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Meshes/CpuMeshResource.h>
 #include <RendererCore/Meshes/MeshBufferUtils.h>
 #include <RendererCore/Meshes/MeshComponent.h>
 #include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
 #include <RendererCore/Utils/WorldGeoExtractionUtil.h>
 #include <Texture/Image/Image.h>
-#include <Texture/Image/ImageUtils.h>
+
+ezCVarInt cvar_HeightfieldMaxChunkTasks("Heightfield.MaxChunkTasks", 4, ezCVarFlags::Default, "Maximum number of heightfield chunks that are generated at the same time");
+ezCVarBool cvar_HeightfieldShowStats("Heightfield.ShowStats", false, ezCVarFlags::Default, "Displays chunk, triangle and timing statistics of all heightfields");
 
 // clang-format off
-EZ_BEGIN_COMPONENT_TYPE(ezHeightfieldComponent, 2, ezComponentMode::Static)
+EZ_BEGIN_COMPONENT_TYPE(ezHeightfieldComponent, 3, ezComponentMode::Static)
 {
   EZ_BEGIN_PROPERTIES
   {
@@ -24,10 +33,12 @@ EZ_BEGIN_COMPONENT_TYPE(ezHeightfieldComponent, 2, ezComponentMode::Static)
     EZ_ACCESSOR_PROPERTY("HalfExtents", GetHalfExtents, SetHalfExtents)->AddAttributes(new ezDefaultValueAttribute(ezVec2(50))),
     EZ_ACCESSOR_PROPERTY("Height", GetHeight, SetHeight)->AddAttributes(new ezDefaultValueAttribute(50)),
     EZ_ACCESSOR_PROPERTY("Tesselation", GetTesselation, SetTesselation)->AddAttributes(new ezDefaultValueAttribute(ezVec2U32(128))),
+    EZ_ACCESSOR_PROPERTY("ChunkTesselation", GetChunkTesselation, SetChunkTesselation)->AddAttributes(new ezDefaultValueAttribute(32), new ezClampValueAttribute(4, 256)),
+    EZ_ACCESSOR_PROPERTY("LodDistanceScale", GetLodDistanceScale, SetLodDistanceScale)->AddAttributes(new ezDefaultValueAttribute(1.0f), new ezClampValueAttribute(0.1f, 10.0f)),
     EZ_ACCESSOR_PROPERTY("TexCoordOffset", GetTexCoordOffset, SetTexCoordOffset)->AddAttributes(new ezDefaultValueAttribute(ezVec2(0))),
     EZ_ACCESSOR_PROPERTY("TexCoordScale", GetTexCoordScale, SetTexCoordScale)->AddAttributes(new ezDefaultValueAttribute(ezVec2(1))),
     EZ_ACCESSOR_PROPERTY("GenerateCollision", GetGenerateCollision, SetGenerateCollision)->AddAttributes(new ezDefaultValueAttribute(true)),
-    EZ_ACCESSOR_PROPERTY("ColMeshTesselation", GetColMeshTesselation, SetColMeshTesselation)->AddAttributes(new ezDefaultValueAttribute(ezVec2U32(64))),    
+    EZ_ACCESSOR_PROPERTY("ColMeshTesselation", GetColMeshTesselation, SetColMeshTesselation)->AddAttributes(new ezDefaultValueAttribute(ezVec2U32(64))),
     EZ_ACCESSOR_PROPERTY("IncludeInNavmesh", GetIncludeInNavmesh, SetIncludeInNavmesh)->AddAttributes(new ezDefaultValueAttribute(true)),
   }
   EZ_END_PROPERTIES;
@@ -47,6 +58,90 @@ EZ_BEGIN_COMPONENT_TYPE(ezHeightfieldComponent, 2, ezComponentMode::Static)
 EZ_END_COMPONENT_TYPE;
 // clang-format on
 
+//////////////////////////////////////////////////////////////////////////
+
+namespace
+{
+  ezSharedPtr<ezHeightfieldHeightData> CreateHeightData(const ezImageDataResourceHandle& hHeightfield)
+  {
+    EZ_PROFILE_SCOPE("Heightfield: CopyHeightData");
+
+    ezResourceLock<ezImageDataResource> pImageData(hHeightfield, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
+    if (pImageData.GetAcquireResult() != ezResourceAcquireResult::Final)
+    {
+      ezLog::Error("Failed to load heightmap image data '{}'", hHeightfield.GetResourceID());
+      return nullptr;
+    }
+
+    ezSharedPtr<ezHeightfieldHeightData> pData = EZ_DEFAULT_NEW(ezHeightfieldHeightData);
+    pData->CopyFrom(pImageData->GetDescriptor().m_Image);
+    return pData;
+  }
+
+  EZ_ALWAYS_INLINE ezUInt32 GetChunkLevel(ezUInt64 uiChunkKey)
+  {
+    return static_cast<ezUInt32>(uiChunkKey >> 56);
+  }
+
+  constexpr ezUInt64 s_uiFramesUntilChunkRelease = 120;
+} // namespace
+
+/// \brief Builds the mesh of one chunk on a worker thread.
+class ezHeightfieldChunkTask final : public ezTask
+{
+public:
+  ezHeightfieldChunkTask()
+  {
+    ConfigureTask("Heightfield: GenerateChunk", ezTaskNesting::Never);
+  }
+
+  ezSharedPtr<ezHeightfieldHeightData> m_pHeightData;
+  ezHeightfieldChunkDesc m_ChunkDesc;
+  ezUInt64 m_uiChunkKey = 0;
+  ezUInt32 m_uiGeneration = 0;
+  ezString m_sResourceName;
+
+  ezMeshResourceDescriptor m_MeshDesc;
+  ezBoundingBox m_Bounds;
+  ezUInt32 m_uiNumTriangles = 0;
+  ezTime m_GenerationTime;
+
+private:
+  virtual void Execute() override
+  {
+    ezStopwatch sw;
+
+    m_Bounds = ezHeightfieldChunkUtils::BuildChunkMesh(m_ChunkDesc, *m_pHeightData, m_MeshDesc, m_uiNumTriangles);
+    m_pHeightData.Clear();
+
+    m_GenerationTime = sw.GetRunningTotal();
+  }
+};
+
+struct ezHeightfieldComponent::ExtractContext
+{
+  ezMsgExtractRenderData* m_pMsg = nullptr;
+  const ChunkTable* m_pChunks = nullptr;
+  const ezHeightfieldComponentManager* m_pManager = nullptr;
+  bool m_bRequestChunks = false;
+
+  ezSimdTransform m_GlobalTransform;
+  ezFrustum m_Frustum;
+  ezSimdVec4f m_vLodCameraPosition;
+  ezUInt64 m_uiFrameCounter = 0;
+
+  ezMaterialResourceHandle m_hMaterial;
+  ezRenderData::Category m_Category;
+  ezUInt32 m_uiFlipWinding = 0;
+  ezUInt32 m_uiUniformScale = 0;
+  ezUInt32 m_uiUniqueID = 0;
+
+  ezUInt32 m_uiNumExtractedChunks = 0;
+  ezUInt32 m_uiNumExtractedTriangles = 0;
+};
+
+//////////////////////////////////////////////////////////////////////////
+
 ezHeightfieldComponent::ezHeightfieldComponent() = default;
 ezHeightfieldComponent::~ezHeightfieldComponent() = default;
 
@@ -85,6 +180,10 @@ void ezHeightfieldComponent::SerializeComponent(ezWorldWriter& stream) const
   // Version 2
   s << m_bGenerateCollision;
   s << m_bIncludeInNavmesh;
+
+  // Version 3
+  s << m_uiChunkTesselation;
+  s << m_fLodDistanceScale;
 }
 
 void ezHeightfieldComponent::DeserializeComponent(ezWorldReader& stream)
@@ -107,81 +206,181 @@ void ezHeightfieldComponent::DeserializeComponent(ezWorldReader& stream)
     s >> m_bGenerateCollision;
     s >> m_bIncludeInNavmesh;
   }
+
+  if (uiVersion >= 3)
+  {
+    s >> m_uiChunkTesselation;
+    s >> m_fLodDistanceScale;
+  }
 }
 
 void ezHeightfieldComponent::OnActivated()
 {
-  if (!m_hMesh.IsValid())
-  {
-    m_hMesh = GenerateMesh<ezMeshResource>();
-  }
+  UpdateLodSettings();
 
-  // First generate the mesh and then call the base implementation which will update the bounds
   SUPER::OnActivated();
 }
 
+void ezHeightfieldComponent::OnDeactivated()
+{
+  ++m_uiChunkGeneration;
+  m_Chunks.Clear();
+  m_PreviousChunks.Clear();
+
+  SUPER::OnDeactivated();
+}
+
 ezResult ezHeightfieldComponent::GetLocalBounds(ezBoundingBoxSphere& bounds, bool& bAlwaysVisible, ezMsgUpdateLocalBounds& msg)
 {
-  if (m_hMesh.IsValid())
-  {
-    ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
-    bounds = pMesh->GetBounds();
-    return EZ_SUCCESS;
-  }
+  if (!m_hHeightfield.IsValid())
+    return EZ_FAILURE;
 
-  return EZ_FAILURE;
+  // chunks never extend beyond this box, not even their skirts
+  bounds = ezBoundingBoxSphere::MakeFromBox(ezBoundingBox::MakeFromMinMax(ezVec3(-m_vHalfExtents.x, -m_vHalfExtents.y, -m_fHeight), ezVec3(m_vHalfExtents.x, m_vHalfExtents.y, 0.0f)));
+  return EZ_SUCCESS;
 }
 
 void ezHeightfieldComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& msg) const
 {
-  if (!m_hMesh.IsValid())
+  if (!m_hHeightfield.IsValid())
     return;
 
-  const ezUInt32 uiFlipWinding = GetOwner()->GetGlobalTransformSimd().ContainsNegativeScale() ? 1 : 0;
-  const ezUInt32 uiUniformScale = GetOwner()->GetGlobalTransformSimd().ContainsUniformScale() ? 1 : 0;
+  ezStopwatch sw;
 
-  ezResourceLock<ezMeshResource> pMesh(m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
-  ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> parts = pMesh->GetSubMeshes();
+  auto pManager = static_cast<const ezHeightfieldComponentManager*>(GetOwningManager());
 
-  for (ezUInt32 uiPartIndex = 0; uiPartIndex < parts.GetCount(); ++uiPartIndex)
-  {
-    const ezUInt32 uiMaterialIndex = parts[uiPartIndex].m_uiMaterialIndex;
-    ezMaterialResourceHandle hMaterial = m_hMaterial.IsValid() ? m_hMaterial : pMesh->GetMaterials()[uiMaterialIndex];
+  ExtractContext ctx;
+  ctx.m_pMsg = &msg;
+  ctx.m_pChunks = &m_Chunks;
+  ctx.m_pManager = pManager;
+
+  // only the main views decide which chunks are streamed in
+  ctx.m_bRequestChunks = msg.m_OverrideCategory == ezInvalidRenderDataCategory && (msg.m_pView->GetCameraUsageHint() == ezCameraUsageHint::MainView || msg.m_pView->GetCameraUsageHint() == ezCameraUsageHint::EditorView);
+
+  const ezUInt64 uiRootKey = MakeChunkKey(0, 0, 0);
 
-    ezMeshRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezMeshRenderData>(GetOwner());
+  const Chunk* pRoot = nullptr;
+  if (!m_Chunks.TryGetValue(uiRootKey, pRoot) || !pRoot->m_hMesh.IsValid())
+  {
+    if (ctx.m_bRequestChunks)
     {
-      pRenderData->m_GlobalTransform = GetOwner()->GetGlobalTransform();
-      pRenderData->m_GlobalBounds = GetOwner()->GetGlobalBounds();
-      pRenderData->m_hMesh = m_hMesh;
-      pRenderData->m_hMaterial = hMaterial;
-      pRenderData->m_Color = ezColor::White;
+      pManager->RequestChunk(GetHandle(), uiRootKey, 0.0f);
+    }
 
-      pRenderData->m_uiSubMeshIndex = uiPartIndex;
-      pRenderData->m_uiFlipWinding = uiFlipWinding;
-      pRenderData->m_uiUniformScale = uiUniformScale;
+    // show the chunks from before the last edit, but don't request any more of those
+    if (!m_PreviousChunks.TryGetValue(uiRootKey, pRoot) || !pRoot->m_hMesh.IsValid())
+      return;
 
-      pRenderData->m_uiUniqueID = GetUniqueIdForRendering(uiMaterialIndex);
+    ctx.m_pChunks = &m_PreviousChunks;
+    ctx.m_bRequestChunks = false;
+  }
 
-      pRenderData->FillBatchIdAndSortingKey();
-    }
+  ctx.m_GlobalTransform = GetOwner()->GetGlobalTransformSimd();
+  msg.m_pView->ComputeCullingFrustum(ctx.m_Frustum);
+  ctx.m_vLodCameraPosition = ezSimdConversion::ToVec3(msg.m_pView->GetLodCamera()->GetCenterPosition());
+  ctx.m_uiFrameCounter = ezRenderWorld::GetFrameCounter();
+
+  ctx.m_uiFlipWinding = ctx.m_GlobalTransform.ContainsNegativeScale() ? 1 : 0;
+  ctx.m_uiUniformScale = ctx.m_GlobalTransform.ContainsUniformScale() ? 1 : 0;
+  ctx.m_uiUniqueID = GetUniqueIdForRendering();
+
+  ctx.m_hMaterial = m_hMaterial;
+  if (!ctx.m_hMaterial.IsValid())
+  {
+    ezResourceLock<ezMeshResource> pMesh(pRoot->m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
+    ctx.m_hMaterial = pMesh->GetMaterials()[0];
+  }
 
-    bool bDontCacheYet = false;
+  ctx.m_Category = ezDefaultRenderDataCategories::LitOpaque;
+  if (ctx.m_hMaterial.IsValid())
+  {
+    ezResourceLock<ezMaterialResource> pMaterial(ctx.m_hMaterial, ezResourceAcquireMode::AllowLoadingFallback);
+    ctx.m_Category = pMaterial->GetRenderDataCategory();
+  }
+
+  ExtractChunk(ctx, 0, 0, 0);
+
+  if (cvar_HeightfieldShowStats)
+  {
+    pManager->m_iNumExtractedChunks.Add(ctx.m_uiNumExtractedChunks);
+    pManager->m_iNumExtractedTriangles.Add(ctx.m_uiNumExtractedTriangles);
+    pManager->m_iExtractionTimeNS.Add((ezInt64)sw.GetRunningTotal().GetNanoseconds());
+  }
+}
 
-    // Determine render data category.
-    ezRenderData::Category category = ezDefaultRenderDataCategories::LitOpaque;
+void ezHeightfieldComponent::ExtractChunk(ExtractContext& ref_context, ezUInt32 uiLevel, ezUInt32 x, ezUInt32 y) const
+{
+  const Chunk* pChunk = nullptr;
+  ref_context.m_pChunks->TryGetValue(MakeChunkKey(uiLevel, x, y), pChunk);
 
-    if (hMaterial.IsValid())
+  ezSimdBBox bounds = ezSimdBBox::MakeFromMinMax(ezSimdConversion::ToVec3(pChunk->m_LocalBounds.m_vMin), ezSimdConversion::ToVec3(pChunk->m_LocalBounds.m_vMax));
+  bounds.Transform(ref_context.m_GlobalTransform);
+
+  if (!ref_context.m_Frustum.Overlaps(bounds))
+    return;
+
+  // several views may extract at the same time
+  pChunk->m_iLastUsedFrame.Max(static_cast<ezInt64>(ref_context.m_uiFrameCounter));
+
+  if (uiLevel + 1 < m_uiNumLodLevels)
+  {
+    const float fDistance = bounds.GetDistanceTo(ref_context.m_vLodCameraPosition);
+    const float fChunkSize = bounds.GetExtents().HorizontalMax<2>();
+
+    if (fDistance < fChunkSize * m_fLodDistanceScale)
     {
-      ezResourceLock<ezMaterialResource> pMaterial(hMaterial, ezResourceAcquireMode::AllowLoadingFallback);
+      bool bChildrenReady = true;
+
+      for (ezUInt32 i = 0; i < 4; ++i)
+      {
+        const ezUInt64 uiChildKey = MakeChunkKey(uiLevel + 1, x * 2 + (i & 1), y * 2 + (i >> 1));
 
-      if (pMaterial.GetAcquireResult() == ezResourceAcquireResult::LoadingFallback)
-        bDontCacheYet = true;
+        const Chunk* pChild = nullptr;
+        if (!ref_context.m_pChunks->TryGetValue(uiChildKey, pChild) || !pChild->m_hMesh.IsValid())
+        {
+          bChildrenReady = false;
 
-      category = pMaterial->GetRenderDataCategory();
+          if (ref_context.m_bRequestChunks)
+          {
+            ref_context.m_pManager->RequestChunk(GetHandle(), uiChildKey, fDistance);
+          }
+        }
+      }
+
+      if (bChildrenReady)
+      {
+        for (ezUInt32 i = 0; i < 4; ++i)
+        {
+          ExtractChunk(ref_context, uiLevel + 1, x * 2 + (i & 1), y * 2 + (i >> 1));
+        }
+
+        return;
+      }
     }
+  }
+
+  ezMeshRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezMeshRenderData>(GetOwner());
+  {
+    pRenderData->m_GlobalTransform = ezSimdConversion::ToTransform(ref_context.m_GlobalTransform);
+    pRenderData->m_GlobalBounds = ezBoundingBoxSphere::MakeFromBox(ezBoundingBox::MakeFromMinMax(ezSimdConversion::ToVec3(bounds.m_Min), ezSimdConversion::ToVec3(bounds.m_Max)));
+    pRenderData->m_hMesh = pChunk->m_hMesh;
+    pRenderData->m_hMaterial = ref_context.m_hMaterial;
+    pRenderData->m_Color = ezColor::White;
+
+    pRenderData->m_uiSubMeshIndex = 0;
+    pRenderData->m_uiFlipWinding = ref_context.m_uiFlipWinding;
+    pRenderData->m_uiUniformScale = ref_context.m_uiUniformScale;
 
-    msg.AddRenderData(pRenderData, category, bDontCacheYet ? ezRenderData::Caching::Never : ezRenderData::Caching::IfStatic);
+    pRenderData->m_uiUniqueID = ref_context.m_uiUniqueID;
+
+    pRenderData->FillBatchIdAndSortingKey();
   }
+
+  // which chunks are rendered depends on the view, so nothing can be cached
+  ref_context.m_pMsg->AddRenderData(pRenderData, ref_context.m_Category, ezRenderData::Caching::Never);
+
+  ref_context.m_uiNumExtractedChunks++;
+  ref_context.m_uiNumExtractedTriangles += pChunk->m_uiNumTriangles;
 }
 
 void ezHeightfieldComponent::SetTexCoordScale(ezVec2 value) // [ property ]
@@ -234,7 +433,7 @@ const char* ezHeightfieldComponent::GetHeightfieldFile() const
 void ezHeightfieldComponent::SetHeightfield(const ezImageDataResourceHandle& hResource)
 {
   m_hHeightfield = hResource;
-  InvalidateMesh();
+  InvalidateHeightData();
 }
 
 void ezHeightfieldComponent::SetTesselation(ezVec2U32 value)
@@ -243,6 +442,18 @@ void ezHeightfieldComponent::SetTesselation(ezVec2U32 value)
   InvalidateMesh();
 }
 
+void ezHeightfieldComponent::SetChunkTesselation(ezUInt32 value)
+{
+  m_uiChunkTesselation = value;
+  InvalidateMesh();
+}
+
+void ezHeightfieldComponent::SetLodDistanceScale(float fScale)
+{
+  // only affects which chunks are selected, the chunks themselves stay the same
+  m_fLodDistanceScale = fScale;
+}
+
 void ezHeightfieldComponent::SetGenerateCollision(bool b)
 {
   m_bGenerateCollision = b;
@@ -261,33 +472,77 @@ void ezHeightfieldComponent::SetIncludeInNavmesh(bool b)
 
 void ezHeightfieldComponent::OnBuildStaticMesh(ezMsgBuildStaticMesh& msg) const
 {
-  if (!m_bGenerateCollision)
+  if (!m_bGenerateCollision || !m_hHeightfield.IsValid())
     return;
 
-  ezGeometry geom;
-  BuildGeometry(geom);
+  ezSharedPtr<ezHeightfieldHeightData> pHeightData = m_pHeightData != nullptr ? m_pHeightData : CreateHeightData(m_hHeightfield);
+  if (pHeightData == nullptr)
+    return;
+
+  EZ_PROFILE_SCOPE("Heightfield: BuildCollisionMesh");
+
+  // use the same chunk layout as the render mesh, just with the collision mesh tesselation
+  const ezVec2U32 vTesselation(ezMath::Clamp(m_vColMeshTesselation.x, 4u, 511u), ezMath::Clamp(m_vColMeshTesselation.y, 4u, 511u));
+  const ezHeightfieldLodLayout layout = ezHeightfieldChunkUtils::ComputeLodLayout(vTesselation, m_uiChunkTesselation);
+  const ezUInt32 uiNumChunksPerAxis = 1u << (layout.m_uiNumLevels - 1);
+
+  ezHeightfieldChunkDesc chunkDesc;
+  chunkDesc.m_vGridQuads = layout.m_vChunkQuads * uiNumChunksPerAxis;
+  chunkDesc.m_vNumQuads = layout.m_vChunkQuads;
+  chunkDesc.m_vHalfExtents = m_vHalfExtents;
+  chunkDesc.m_fHeight = m_fHeight;
+
+  ezDynamicArray<ezDynamicArray<ezVec3>> chunkPositions;
+  chunkPositions.SetCount(uiNumChunksPerAxis * uiNumChunksPerAxis);
+
+  ezTaskSystem::ParallelForIndexed(
+    0, chunkPositions.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex) {
+      for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+      {
+        ezHeightfieldChunkDesc desc = chunkDesc;
+        desc.m_vFirstQuad = ezVec2U32(i % uiNumChunksPerAxis, i / uiNumChunksPerAxis).CompMul(layout.m_vChunkQuads);
+
+        ezHeightfieldChunkUtils::ComputeChunkPositions(desc, *pHeightData, chunkPositions[i]);
+      }
+    },
+    "Heightfield: BuildCollisionChunks");
 
   auto* pDesc = msg.m_pStaticMeshDescription;
   auto& subMesh = pDesc->m_SubMeshes.ExpandAndGetRef();
   subMesh.m_uiFirstTriangle = pDesc->m_Triangles.GetCount();
 
   const ezTransform trans = GetOwner()->GetGlobalTransform();
+  const ezUInt32 uiNumVerticesX = layout.m_vChunkQuads.x + 1;
 
-  const ezUInt32 uiTriOffset = pDesc->m_Vertices.GetCount();
-
-  for (const auto& verts : geom.GetVertices())
+  for (const auto& positions : chunkPositions)
   {
-    pDesc->m_Vertices.PushBack(trans * verts.m_vPosition);
-  }
+    const ezUInt32 uiTriOffset = pDesc->m_Vertices.GetCount();
 
-  for (const auto& polys : geom.GetPolygons())
-  {
-    for (ezUInt32 t = 0; t < polys.m_Vertices.GetCount() - 2; ++t)
+    for (const ezVec3& vPos : positions)
+    {
+      pDesc->m_Vertices.PushBack(trans * vPos);
+    }
+
+    ezUInt32 uiVertexIdx = uiTriOffset;
+
+    for (ezUInt32 y = 0; y < layout.m_vChunkQuads.y; ++y)
     {
-      auto& tri = pDesc->m_Triangles.ExpandAndGetRef();
-      tri.m_uiVertexIndices[0] = uiTriOffset + polys.m_Vertices[0];
-      tri.m_uiVertexIndices[1] = uiTriOffset + polys.m_Vertices[t + 1];
-      tri.m_uiVertexIndices[2] = uiTriOffset + polys.m_Vertices[t + 2];
+      for (ezUInt32 x = 0; x < layout.m_vChunkQuads.x; ++x)
+      {
+        auto& tri0 = pDesc->m_Triangles.ExpandAndGetRef();
+        tri0.m_uiVertexIndices[0] = uiVertexIdx;
+        tri0.m_uiVertexIndices[1] = uiVertexIdx + 1;
+        tri0.m_uiVertexIndices[2] = uiVertexIdx + uiNumVerticesX + 1;
+
+        auto& tri1 = pDesc->m_Triangles.ExpandAndGetRef();
+        tri1.m_uiVertexIndices[0] = uiVertexIdx;
+        tri1.m_uiVertexIndices[1] = uiVertexIdx + uiNumVerticesX + 1;
+        tri1.m_uiVertexIndices[2] = uiVertexIdx + uiNumVerticesX;
+
+        ++uiVertexIdx;
+      }
+
+      ++uiVertexIdx;
     }
   }
 
@@ -331,286 +586,221 @@ void ezHeightfieldComponent::OnMsgExtractGeometry(ezMsgExtractGeometry& msg) con
   if (msg.m_Mode == ezWorldGeoExtractionUtil::ExtractionMode::NavMeshGeneration && (m_bIncludeInNavmesh == false || GetOwner()->IsDynamic()))
     return;
 
-  msg.AddMeshObject(GetOwner()->GetGlobalTransform(), GenerateMesh<ezCpuMeshResource>());
+  msg.AddMeshObject(GetOwner()->GetGlobalTransform(), GenerateCpuMesh());
 }
 
 void ezHeightfieldComponent::InvalidateMesh()
 {
-  if (m_hMesh.IsValid())
-  {
-    m_hMesh.Invalidate();
-
-    m_hMesh = GenerateMesh<ezMeshResource>();
-
-    TriggerLocalBoundsUpdate();
-  }
-}
-
-void ezHeightfieldComponent::BuildGeometry(ezGeometry& geom) const
-{
-  if (!m_hHeightfield.IsValid())
-    return;
+  UpdateLodSettings();
 
-  EZ_PROFILE_SCOPE("Heightfield: BuildGeometry");
+  // results of chunk tasks that are still running are discarded
+  ++m_uiChunkGeneration;
 
-  ezResourceLock<ezImageDataResource> pImageData(m_hHeightfield, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
-  if (pImageData.GetAcquireResult() != ezResourceAcquireResult::Final)
+  // keep showing the current chunks until the new root chunk is available, so that an edit doesn't make the heightfield disappear
+  const Chunk* pRoot = nullptr;
+  if (m_Chunks.TryGetValue(MakeChunkKey(0, 0, 0), pRoot) && pRoot->m_hMesh.IsValid())
   {
-    ezLog::Error("Failed to load heightmap image data '{}'", m_hHeightfield.GetResourceID());
-    return;
+    m_PreviousChunks.Swap(m_Chunks);
   }
 
-  const ezImage& heightmap = pImageData->GetDescriptor().m_Image;
+  m_Chunks.Clear();
 
-  const ezUInt32 uiNumVerticesX = ezMath::Clamp(m_vColMeshTesselation.x + 1u, 5u, 512u);
-  const ezUInt32 uiNumVerticesY = ezMath::Clamp(m_vColMeshTesselation.y + 1u, 5u, 512u);
-
-  const ezVec3 vSize(m_vHalfExtents.x * 2, m_vHalfExtents.y * 2, m_fHeight);
-  const ezVec2 vToNDC = ezVec2(1.0f / (uiNumVerticesX - 1), 1.0f / (uiNumVerticesY - 1));
-  const ezVec3 vPosOffset(-m_vHalfExtents.x, -m_vHalfExtents.y, 0);
-
-  const ezColor* pImgData = heightmap.GetPixelPointer<ezColor>();
-  const ezUInt32 imgWidth = heightmap.GetWidth();
-  const ezUInt32 imgHeight = heightmap.GetHeight();
-
-  for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
-  {
-    for (ezUInt32 x = 0; x < uiNumVerticesX; ++x)
-    {
-      const ezVec2 ndc = ezVec2((float)x, (float)y).CompMul(vToNDC);
-      const ezVec2 tc = m_vTexCoordOffset + ndc.CompMul(m_vTexCoordScale);
-      const ezVec2 heightTC = ndc;
-
-      const float fHeightScale = 1.0f - ezImageUtils::BilinearSample(pImgData, imgWidth, imgHeight, ezImageAddressMode::Clamp, heightTC).r;
+  TriggerLocalBoundsUpdate();
+}
 
-      const ezVec3 vNewPos = vPosOffset + ezVec3(ndc.x, ndc.y, -fHeightScale).CompMul(vSize);
+void ezHeightfieldComponent::InvalidateHeightData()
+{
+  m_pHeightData.Clear();
+  InvalidateMesh();
+}
 
-      geom.AddVertex(vNewPos, ezVec3(0, 0, 1), tc, ezColor::White);
-    }
-  }
+ezResult ezHeightfieldComponent::EnsureHeightDataIsAvailable()
+{
+  if (m_pHeightData != nullptr)
+    return EZ_SUCCESS;
 
-  ezUInt32 uiVertexIdx = 0;
+  if (!m_hHeightfield.IsValid())
+    return EZ_FAILURE;
 
-  for (ezUInt32 y = 0; y < uiNumVerticesY - 1; ++y)
+  // don't block, if the image isn't loaded yet, the chunk is requested again in the next frame anyway
   {
-    for (ezUInt32 x = 0; x < uiNumVerticesX - 1; ++x)
-    {
-      ezUInt32 indices[4];
-      indices[0] = uiVertexIdx;
-      indices[1] = uiVertexIdx + 1;
-      indices[2] = uiVertexIdx + uiNumVerticesX + 1;
-      indices[3] = uiVertexIdx + uiNumVerticesX;
+    ezResourceLock<ezImageDataResource> pImageData(m_hHeightfield, ezResourceAcquireMode::PointerOnly);
 
-      geom.AddPolygon(indices, false);
+    if (pImageData->GetLoadingState() != ezResourceState::Loaded)
+    {
+      if (pImageData->GetLoadingState() != ezResourceState::LoadedResourceMissing)
+      {
+        ezResourceManager::PreloadResource(m_hHeightfield);
+      }
 
-      ++uiVertexIdx;
+      return EZ_FAILURE;
     }
-
-    ++uiVertexIdx;
   }
+
+  m_pHeightData = CreateHeightData(m_hHeightfield);
+  return m_pHeightData != nullptr ? EZ_SUCCESS : EZ_FAILURE;
 }
 
-ezResult ezHeightfieldComponent::BuildMeshDescriptor(ezMeshResourceDescriptor& desc) const
+void ezHeightfieldComponent::UpdateLodSettings()
 {
-  EZ_PROFILE_SCOPE("Heightfield: GenerateRenderMesh");
-
-  ezResourceLock<ezImageDataResource> pImageData(m_hHeightfield, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
-  if (pImageData.GetAcquireResult() != ezResourceAcquireResult::Final)
-  {
-    ezLog::Error("Failed to load heightmap image data '{}'", m_hHeightfield.GetResourceID());
-    return EZ_FAILURE;
-  }
-
-  const ezImage& heightmap = pImageData->GetDescriptor().m_Image;
-
-  // Data/Base/Materials/Common/Pattern.ezMaterialAsset
-  desc.SetMaterial(0, "{ 1c47ee4c-0379-4280-85f5-b8cda61941d2 }");
+  const ezVec2U32 vTesselation(ezMath::Clamp(m_vTesselation.x, 4u, 16384u), ezMath::Clamp(m_vTesselation.y, 4u, 16384u));
+  const ezHeightfieldLodLayout layout = ezHeightfieldChunkUtils::ComputeLodLayout(vTesselation, m_uiChunkTesselation);
 
-  desc.MeshBufferDesc().AddCommonStreams();
-  // 0 = position
-  // 1 = texcoord
-  // 2 = normal
-  // 3 = tangent
-
-  {
-    auto& mb = desc.MeshBufferDesc();
+  m_uiNumLodLevels = layout.m_uiNumLevels;
+  m_vChunkQuads = layout.m_vChunkQuads;
+}
 
-    const ezUInt32 uiNumVerticesX = ezMath::Clamp(m_vTesselation.x + 1u, 5u, 1024u);
-    const ezUInt32 uiNumVerticesY = ezMath::Clamp(m_vTesselation.y + 1u, 5u, 1024u);
-    const ezUInt32 uiNumTriangles = (uiNumVerticesX - 1) * (uiNumVerticesY - 1) * 2;
+ezCpuMeshResourceHandle ezHeightfieldComponent::GenerateCpuMesh() const
+{
+  if (!m_hHeightfield.IsValid())
+    return ezCpuMeshResourceHandle();
 
-    mb.AllocateStreams(uiNumVerticesX * uiNumVerticesY, ezGALPrimitiveTopology::Triangles, uiNumTriangles);
+  ezStringBuilder sResourceName;
+  sResourceName.Format("Heightfield:{}", ComputeSettingsHash());
 
-    const ezVec3 vSize(m_vHalfExtents.x * 2, m_vHalfExtents.y * 2, m_fHeight);
-    const ezVec2 vToNDC = ezVec2(1.0f / (uiNumVerticesX - 1), 1.0f / (uiNumVerticesY - 1));
-    const ezVec3 vPosOffset(-m_vHalfExtents.x, -m_vHalfExtents.y, -m_fHeight);
+  ezCpuMeshResourceHandle hResource = ezResourceManager::GetExistingResource<ezCpuMeshResource>(sResourceName);
+  if (hResource.IsValid())
+    return hResource;
 
-    const auto texCoordFormat = ezMeshTexCoordPrecision::ToResourceFormat(ezMeshTexCoordPrecision::Default);
-    const auto normalFormat = ezMeshNormalPrecision::ToResourceFormatNormal(ezMeshNormalPrecision::Default);
-    const auto tangentFormat = ezMeshNormalPrecision::ToResourceFormatTangent(ezMeshNormalPrecision::Default);
+  ezSharedPtr<ezHeightfieldHeightData> pHeightData = m_pHeightData != nullptr ? m_pHeightData : CreateHeightData(m_hHeightfield);
+  if (pHeightData == nullptr)
+    return ezCpuMeshResourceHandle();
 
-    // access the vertex data directly
-    // this is way more complicated than going through SetVertexData, but it is ~20% faster
+  EZ_PROFILE_SCOPE("Heightfield: GenerateCpuMesh");
 
-    auto positionData = mb.GetVertexData(0, 0);
-    auto texcoordData = mb.GetVertexData(1, 0);
-    auto normalData = mb.GetVertexData(2, 0);
-    auto tangentData = mb.GetVertexData(3, 0);
+  // a single chunk for the entire heightfield
+  ezHeightfieldChunkDesc chunkDesc;
+  chunkDesc.m_vNumQuads = ezVec2U32(ezMath::Clamp(m_vTesselation.x, 4u, 1023u), ezMath::Clamp(m_vTesselation.y, 4u, 1023u));
+  chunkDesc.m_vGridQuads = chunkDesc.m_vNumQuads;
+  chunkDesc.m_vHalfExtents = m_vHalfExtents;
+  chunkDesc.m_fHeight = m_fHeight;
+  chunkDesc.m_vTexCoordOffset = m_vTexCoordOffset;
+  chunkDesc.m_vTexCoordScale = m_vTexCoordScale;
 
-    const ezUInt32 uiVertexDataSize = mb.GetVertexDataSize();
+  ezMeshResourceDescriptor desc;
+  ezUInt32 uiNumTriangles = 0;
+  ezHeightfieldChunkUtils::BuildChunkMesh(chunkDesc, *pHeightData, desc, uiNumTriangles);
 
-    ezUInt32 uiVertexIdx = 0;
+  return ezResourceManager::CreateResource<ezCpuMeshResource>(sResourceName, std::move(desc), sResourceName);
+}
 
-    const ezColor* pImgData = heightmap.GetPixelPointer<ezColor>();
-    const ezUInt32 imgWidth = heightmap.GetWidth();
-    const ezUInt32 imgHeight = heightmap.GetHeight();
+ezUInt64 ezHeightfieldComponent::MakeChunkKey(ezUInt32 uiLevel, ezUInt32 x, ezUInt32 y)
+{
+  return (static_cast<ezUInt64>(uiLevel) << 56) | (static_cast<ezUInt64>(y) << 28) | static_cast<ezUInt64>(x);
+}
 
-    for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
-    {
-      for (ezUInt32 x = 0; x < uiNumVerticesX; ++x)
-      {
-        const ezVec2 ndc = ezVec2((float)x, (float)y).CompMul(vToNDC);
-        const ezVec2 tc = m_vTexCoordOffset + ndc.CompMul(m_vTexCoordScale);
-        const ezVec2 heightTC = ndc;
+ezUInt64 ezHeightfieldComponent::ComputeSettingsHash() const
+{
+  ezUInt64 uiSettingsHash = m_hHeightfield.GetResourceIDHash() + m_uiHeightfieldChangeCounter;
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_vHalfExtents, sizeof(m_vHalfExtents), uiSettingsHash);
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_fHeight, sizeof(m_fHeight), uiSettingsHash);
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_vTexCoordOffset, sizeof(m_vTexCoordOffset), uiSettingsHash);
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_vTexCoordScale, sizeof(m_vTexCoordScale), uiSettingsHash);
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_vTesselation, sizeof(m_vTesselation), uiSettingsHash);
+  uiSettingsHash = ezHashingUtils::xxHash64(&m_uiChunkTesselation, sizeof(m_uiChunkTesselation), uiSettingsHash);
+  return uiSettingsHash;
+}
 
-        const size_t uiByteOffset = (size_t)uiVertexIdx * (size_t)uiVertexDataSize;
+ezSharedPtr<ezHeightfieldChunkTask> ezHeightfieldComponent::StartChunkGeneration(ezUInt64 uiChunkKey)
+{
+  if (m_Chunks.Contains(uiChunkKey))
+    return nullptr;
 
-        const float fHeightScale = ezImageUtils::BilinearSample(pImgData, imgWidth, imgHeight, ezImageAddressMode::Clamp, heightTC).r;
+  if (EnsureHeightDataIsAvailable().Failed())
+    return nullptr;
 
-        // complicated but faster
-        *reinterpret_cast<ezVec3*>(positionData.GetPtr() + uiByteOffset) = vPosOffset + ezVec3(ndc.x, ndc.y, fHeightScale).CompMul(vSize);
-        ezMeshBufferUtils::EncodeTexCoord(tc, ezByteArrayPtr(texcoordData.GetPtr() + uiByteOffset, 32), texCoordFormat).IgnoreResult();
+  const ezUInt32 uiLevel = GetChunkLevel(uiChunkKey);
+  const ezUInt32 x = static_cast<ezUInt32>(uiChunkKey & 0xFFFFFFF);
+  const ezUInt32 y = static_cast<ezUInt32>((uiChunkKey >> 28) & 0xFFFFFFF);
 
-        // easier to understand, but slower
-        // mb.SetVertexData(0, uiVertexIdx, vPosOffset + ezVec3(ndc.x, ndc.y, -fHeightScale).CompMul(vSize));
-        // ezMeshBufferUtils::EncodeTexCoord(tc, mb.GetVertexData(1, uiVertexIdx), texCoordFormat).IgnoreResult();
+  ezStringBuilder sResourceName;
+  sResourceName.Format("Heightfield:{}-{}-{}-{}", ComputeSettingsHash(), uiLevel, x, y);
 
-        ++uiVertexIdx;
-      }
-    }
+  Chunk& chunk = m_Chunks[uiChunkKey];
+  chunk.m_iLastUsedFrame = static_cast<ezInt64>(ezRenderWorld::GetFrameCounter());
 
-    uiVertexIdx = 0;
+  // another heightfield with the same settings may have generated this chunk already
+  chunk.m_hMesh = ezResourceManager::GetExistingResource<ezMeshResource>(sResourceName);
+  if (chunk.m_hMesh.IsValid())
+  {
+    ezResourceLock<ezMeshResource> pMesh(chunk.m_hMesh, ezResourceAcquireMode::BlockTillLoaded);
+    chunk.m_LocalBounds = pMesh->GetBounds().GetBox();
+    chunk.m_uiNumTriangles = pMesh->GetSubMeshes()[0].m_uiPrimitiveCount;
 
-    for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
+    if (uiLevel == 0)
     {
-      for (ezUInt32 x = 0; x < uiNumVerticesX; ++x)
-      {
-        const size_t uiByteOffset = (size_t)uiVertexIdx * (size_t)uiVertexDataSize;
-
-        const ezInt32 centerIDx = uiVertexIdx;
-        ezInt32 leftIDx = uiVertexIdx - 1;
-        ezInt32 rightIDx = uiVertexIdx + 1;
-        ezInt32 bottomIDx = uiVertexIdx - uiNumVerticesX;
-        ezInt32 topIDx = uiVertexIdx + uiNumVerticesX;
-
-        // clamp the indices
-        if (x == 0)
-          leftIDx = centerIDx;
-        if (x + 1 == uiNumVerticesX)
-          rightIDx = centerIDx;
-        if (y == 0)
-          bottomIDx = centerIDx;
-        if (y + 1 == uiNumVerticesY)
-          topIDx = centerIDx;
-
-        const ezVec3 vPosCenter = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + (size_t)centerIDx * (size_t)uiVertexDataSize);
-        const ezVec3 vPosLeft = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + (size_t)leftIDx * (size_t)uiVertexDataSize);
-        const ezVec3 vPosRight = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + (size_t)rightIDx * (size_t)uiVertexDataSize);
-        const ezVec3 vPosBottom = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + (size_t)bottomIDx * (size_t)uiVertexDataSize);
-        const ezVec3 vPosTop = *reinterpret_cast<ezVec3*>(positionData.GetPtr() + (size_t)topIDx * (size_t)uiVertexDataSize);
-
-        ezVec3 edgeL = vPosLeft - vPosCenter;
-        ezVec3 edgeR = vPosRight - vPosCenter;
-        ezVec3 edgeB = vPosBottom - vPosCenter;
-        ezVec3 edgeT = vPosTop - vPosCenter;
-
-        // rotate edges by 90 degrees, so that they become normals
-        ezMath::Swap(edgeL.x, edgeL.z);
-        ezMath::Swap(edgeR.x, edgeR.z);
-        ezMath::Swap(edgeB.y, edgeB.z);
-        ezMath::Swap(edgeT.y, edgeT.z);
-
-        edgeL.z = -edgeL.z;
-        edgeR.x = -edgeR.x;
-        edgeB.z = -edgeB.z;
-        edgeT.y = -edgeT.y;
-
-        // don't normalize the edges first, if they are longer, they shall have more influence
-        ezVec3 vNormal(0);
-        vNormal += edgeL;
-        vNormal += edgeR;
-        vNormal += edgeB;
-        vNormal += edgeT;
-        vNormal.Normalize();
-
-        ezVec3 vTangent = ezVec3(1, 0, 0).CrossRH(vNormal).GetNormalized();
-
-        // complicated but faster
-        ezMeshBufferUtils::EncodeNormal(vNormal, ezByteArrayPtr(normalData.GetPtr() + uiByteOffset, 32), normalFormat).IgnoreResult();
-        ezMeshBufferUtils::EncodeTangent(vTangent, 1.0f, ezByteArrayPtr(tangentData.GetPtr() + uiByteOffset, 32), tangentFormat).IgnoreResult();
-
-        // easier to understand, but slower
-        // ezMeshBufferUtils::EncodeNormal(ezVec3(0, 0, 1), mb.GetVertexData(2, uiVertexIdx), normalFormat).IgnoreResult();
-        // ezMeshBufferUtils::EncodeTangent(ezVec3(1, 0, 0), 1.0f, mb.GetVertexData(3, uiVertexIdx), tangentFormat).IgnoreResult();
-
-        ++uiVertexIdx;
-      }
+      m_PreviousChunks.Clear();
     }
 
-    desc.SetBounds(ezBoundingBoxSphere::MakeFromBox(ezBoundingBox::MakeFromMinMax(vPosOffset, vPosOffset + vSize)));
-
-    ezUInt32 uiTriangleIdx = 0;
-    uiVertexIdx = 0;
-
-    for (ezUInt32 y = 0; y < uiNumVerticesY - 1; ++y)
-    {
-      for (ezUInt32 x = 0; x < uiNumVerticesX - 1; ++x)
-      {
-        mb.SetTriangleIndices(uiTriangleIdx + 0, uiVertexIdx, uiVertexIdx + 1, uiVertexIdx + uiNumVerticesX);
-        mb.SetTriangleIndices(uiTriangleIdx + 1, uiVertexIdx + 1, uiVertexIdx + uiNumVerticesX + 1, uiVertexIdx + uiNumVerticesX);
-        uiTriangleIdx += 2;
-
-        ++uiVertexIdx;
-      }
+    return nullptr;
+  }
 
-      ++uiVertexIdx;
-    }
+  ezSharedPtr<ezHeightfieldChunkTask> pTask = EZ_DEFAULT_NEW(ezHeightfieldChunkTask);
+  pTask->m_pHeightData = m_pHeightData;
+  pTask->m_uiChunkKey = uiChunkKey;
+  pTask->m_uiGeneration = m_uiChunkGeneration;
+  pTask->m_sResourceName = sResourceName;
+
+  ezHeightfieldChunkDesc& desc = pTask->m_ChunkDesc;
+  desc.m_vNumQuads = m_vChunkQuads;
+  desc.m_vGridQuads = m_vChunkQuads * (1u << uiLevel);
+  desc.m_vFirstQuad = ezVec2U32(x, y).CompMul(m_vChunkQuads);
+  desc.m_vHalfExtents = m_vHalfExtents;
+  desc.m_fHeight = m_fHeight;
+  desc.m_vTexCoordOffset = m_vTexCoordOffset;
+  desc.m_vTexCoordScale = m_vTexCoordScale;
+
+  if (uiLevel > 0)
+  {
+    // the skirt only has to cover the error of coarser neighbors, which grows with the size of their quads
+    const float fQuadSize = ezMath::Max(m_vHalfExtents.x * 2.0f / desc.m_vGridQuads.x, m_vHalfExtents.y * 2.0f / desc.m_vGridQuads.y);
+    desc.m_fSkirtDepth = ezMath::Min(fQuadSize * 2.0f, m_fHeight);
   }
 
-  desc.AddSubMesh(desc.MeshBufferDesc().GetPrimitiveCount(), 0, 0);
-  return EZ_SUCCESS;
+  return pTask;
 }
 
-template <typename ResourceType>
-ezTypedResourceHandle<ResourceType> ezHeightfieldComponent::GenerateMesh() const
+void ezHeightfieldComponent::FinishChunkGeneration(ezHeightfieldChunkTask& ref_task)
 {
-  if (!m_hHeightfield.IsValid())
-    return ezTypedResourceHandle<ResourceType>();
+  if (ref_task.m_uiGeneration != m_uiChunkGeneration)
+    return;
 
-  ezStringBuilder sResourceName;
+  Chunk* pChunk = nullptr;
+  if (!m_Chunks.TryGetValue(ref_task.m_uiChunkKey, pChunk))
+    return;
 
+  pChunk->m_hMesh = ezResourceManager::GetExistingResource<ezMeshResource>(ref_task.m_sResourceName);
+  if (!pChunk->m_hMesh.IsValid())
   {
-    ezUInt64 uiSettingsHash = m_hHeightfield.GetResourceIDHash() + m_uiHeightfieldChangeCounter;
-    uiSettingsHash = ezHashingUtils::xxHash64(&m_vHalfExtents, sizeof(m_vHalfExtents), uiSettingsHash);
-    uiSettingsHash = ezHashingUtils::xxHash64(&m_fHeight, sizeof(m_fHeight), uiSettingsHash);
-    uiSettingsHash = ezHashingUtils::xxHash64(&m_vTexCoordOffset, sizeof(m_vTexCoordOffset), uiSettingsHash);
-    uiSettingsHash = ezHashingUtils::xxHash64(&m_vTexCoordScale, sizeof(m_vTexCoordScale), uiSettingsHash);
-    uiSettingsHash = ezHashingUtils::xxHash64(&m_vTesselation, sizeof(m_vTesselation), uiSettingsHash);
+    pChunk->m_hMesh = ezResourceManager::CreateResource<ezMeshResource>(ref_task.m_sResourceName, std::move(ref_task.m_MeshDesc), ref_task.m_sResourceName);
+  }
 
-    sResourceName.Format("Heightfield:{}", uiSettingsHash);
+  pChunk->m_LocalBounds = ref_task.m_Bounds;
+  pChunk->m_uiNumTriangles = ref_task.m_uiNumTriangles;
+  pChunk->m_iLastUsedFrame = static_cast<ezInt64>(ezRenderWorld::GetFrameCounter());
 
-    ezTypedResourceHandle<ResourceType> hResource = ezResourceManager::GetExistingResource<ResourceType>(sResourceName);
-    if (hResource.IsValid())
-      return hResource;
+  if (GetChunkLevel(ref_task.m_uiChunkKey) == 0)
+  {
+    m_PreviousChunks.Clear();
   }
+}
 
-  ezMeshResourceDescriptor desc;
-  if (BuildMeshDescriptor(desc).Succeeded())
+void ezHeightfieldComponent::ReleaseUnusedChunks(ezUInt64 uiFrameCounter)
+{
+  for (auto it = m_Chunks.GetIterator(); it.IsValid();)
   {
-    return ezResourceManager::CreateResource<ResourceType>(sResourceName, std::move(desc), sResourceName);
-  }
+    const Chunk& chunk = it.Value();
 
-  return ezTypedResourceHandle<ResourceType>();
+    // the root chunk is always kept, chunks that are still being generated are released once they are done
+    if (GetChunkLevel(it.Key()) > 0 && chunk.m_hMesh.IsValid() && static_cast<ezUInt64>(chunk.m_iLastUsedFrame) + s_uiFramesUntilChunkRelease < uiFrameCounter)
+    {
+      it = m_Chunks.Remove(it);
+    }
+    else
+    {
+      ++it;
+    }
+  }
 }
 
 //////////////////////////////////////////////////////////////////////////
@@ -624,6 +814,11 @@ ezHeightfieldComponentManager::ezHeightfieldComponentManager(ezWorld* pWorld)
 ezHeightfieldComponentManager::~ezHeightfieldComponentManager()
 {
   ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&ezHeightfieldComponentManager::ResourceEventHandler, this));
+
+  for (auto& runningTask : m_RunningTasks)
+  {
+    ezTaskSystem::WaitForGroup(runningTask.m_TaskGroupID);
+  }
 }
 
 void ezHeightfieldComponentManager::Initialize()
@@ -663,10 +858,23 @@ void ezHeightfieldComponentManager::Update(const ezWorldModule::UpdateContext& c
     if (!pComponent->IsActive())
       continue;
 
-    pComponent->InvalidateMesh();
+    pComponent->InvalidateHeightData();
   }
 
   m_ComponentsToUpdate.Clear();
+
+  UpdateChunkTasks();
+
+  const ezUInt64 uiFrameCounter = ezRenderWorld::GetFrameCounter();
+  for (auto it = GetComponents(); it.IsValid(); it.Next())
+  {
+    it->ReleaseUnusedChunks(uiFrameCounter);
+  }
+
+  if (cvar_HeightfieldShowStats)
+  {
+    ShowStats();
+  }
 }
 
 void ezHeightfieldComponentManager::AddToUpdateList(ezHeightfieldComponent* pComponent)
@@ -678,3 +886,87 @@ void ezHeightfieldComponentManager::AddToUpdateList(ezHeightfieldComponent* pCom
     m_ComponentsToUpdate.PushBack(hComponent);
   }
 }
+
+void ezHeightfieldComponentManager::RequestChunk(const ezComponentHandle& hComponent, ezUInt64 uiChunkKey, float fDistanceToCamera) const
+{
+  EZ_LOCK(m_ChunkRequestsMutex);
+
+  auto& request = m_ChunkRequests.ExpandAndGetRef();
+  request.m_hComponent = hComponent;
+  request.m_uiChunkKey = uiChunkKey;
+  request.m_fDistanceToCamera = fDistanceToCamera;
+}
+
+void ezHeightfieldComponentManager::UpdateChunkTasks()
+{
+  EZ_PROFILE_SCOPE("Heightfield: UpdateChunkTasks");
+
+  for (ezUInt32 i = 0; i < m_RunningTasks.GetCount();)
+  {
+    RunningTask& runningTask = m_RunningTasks[i];
+
+    if (!ezTaskSystem::IsTaskGroupFinished(runningTask.m_TaskGroupID))
+    {
+      ++i;
+      continue;
+    }
+
+    ezHeightfieldComponent* pComponent = nullptr;
+    if (TryGetComponent(runningTask.m_hComponent, pComponent))
+    {
+      pComponent->FinishChunkGeneration(*runningTask.m_pTask);
+    }
+
+    ++m_uiNumGeneratedChunks;
+    m_GenerationTime += runningTask.m_pTask->m_GenerationTime;
+
+    m_RunningTasks.RemoveAtAndSwap(i);
+  }
+
+  ezDynamicArray<ChunkRequest> requests;
+
+  {
+    EZ_LOCK(m_ChunkRequestsMutex);
+    requests.Swap(m_ChunkRequests);
+  }
+
+  // closest chunks first, requests that don't fit into the budget are repeated in the next frame anyway
+  requests.Sort([](const ChunkRequest& a, const ChunkRequest& b) { return a.m_fDistanceToCamera < b.m_fDistanceToCamera; });
+
+  for (const ChunkRequest& request : requests)
+  {
+    if (m_RunningTasks.GetCount() >= (ezUInt32)ezMath::Max(cvar_HeightfieldMaxChunkTasks.GetValue(), 1))
+      break;
+
+    ezHeightfieldComponent* pComponent = nullptr;
+    if (!TryGetComponent(request.m_hComponent, pComponent) || !pComponent->IsActiveAndInitialized())
+      continue;
+
+    ezSharedPtr<ezHeightfieldChunkTask> pTask = pComponent->StartChunkGeneration(request.m_uiChunkKey);
+    if (pTask == nullptr)
+      continue;
+
+    RunningTask& runningTask = m_RunningTasks.ExpandAndGetRef();
+    runningTask.m_hComponent = request.m_hComponent;
+    runningTask.m_pTask = pTask;
+    runningTask.m_TaskGroupID = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunningHighPriority);
+  }
+}
+
+void ezHeightfieldComponentManager::ShowStats()
+{
+  ezUInt32 uiNumChunks = 0;
+  for (auto it = GetComponents(); it.IsValid(); it.Next())
+  {
+    uiNumChunks += it->m_Chunks.GetCount();
+  }
+
+  const ezTime averageGenerationTime = m_uiNumGeneratedChunks > 0 ? m_GenerationTime / m_uiNumGeneratedChunks : ezTime::MakeZero();
+
+  ezStringBuilder sb;
+  sb.Format("Heightfield Stats:\nChunks: {} ({} generating)\nExtracted chunks: {}, triangles: {}\nExtraction time: {}\nGenerated chunks: {}, avg. generation time: {}",
+    uiNumChunks, m_RunningTasks.GetCount(), m_iNumExtractedChunks.Set(0), m_iNumExtractedTriangles.Set(0), ezTime::MakeFromNanoseconds((double)m_iExtractionTimeNS.Set(0)),
+    m_uiNumGeneratedChunks, averageGenerationTime);
+
+  ezDebugRenderer::DrawInfoText(GetWorld(), ezDebugRenderer::ScreenPlacement::TopLeft, "HeightfieldStats", sb, ezColorScheme::LightUI(ezColorScheme::Lime));
+}
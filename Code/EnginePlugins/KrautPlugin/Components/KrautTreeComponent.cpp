@@ -327,15 +327,29 @@ ezResult ezKrautTreeComponent::CreateGeometry(ezGeometry& geo, ezWorldGeoExtract
   return EZ_SUCCESS;
 }
 
-void ezKrautTreeComponent::EnsureTreeIsGenerated()
+bool ezKrautTreeComponent::EnsureTreeIsGenerated()
 {
   if (!m_hKrautGenerator.IsValid())
-    return;
+    return true;
+
+  // don't block on the generator, it may still be loading when a whole forest streams in
+  {
+    ezResourceLock<ezKrautGeneratorResource> pResource(m_hKrautGenerator, ezResourceAcquireMode::PointerOnly);
+
+    if (pResource->GetLoadingState() == ezResourceState::LoadedResourceMissing)
+      return true;
+
+    if (pResource->GetLoadingState() != ezResourceState::Loaded)
+    {
+      ezResourceManager::PreloadResource(m_hKrautGenerator);
+      return false;
+    }
+  }
 
   ezResourceLock<ezKrautGeneratorResource> pResource(m_hKrautGenerator, ezResourceAcquireMode::BlockTillLoaded_NeverFail);
 
   if (pResource.GetAcquireResult() != ezResourceAcquireResult::Final)
-    return;
+    return true;
 
   ezKrautTreeResourceHandle hNewTree;
 
@@ -355,11 +369,24 @@ void ezKrautTreeComponent::EnsureTreeIsGenerated()
     }
   }
 
-  if (m_hKrautTree != hNewTree)
+  // the tree is generated in the background, keep showing the previous one until the new one is available
+  if (!hNewTree.IsValid())
+    return false;
+
   {
-    m_hKrautTree = hNewTree;
-    TriggerLocalBoundsUpdate();
+    ezResourceLock<ezKrautTreeResource> pTree(hNewTree, ezResourceAcquireMode::PointerOnly);
+
+    // GenerateTree() already queued the tree for loading, if it isn't loaded, it may also need to be generated again
+    if (pTree->GetLoadingState() != ezResourceState::Loaded)
+      return false;
   }
+
+  if (m_hKrautTree == hNewTree)
+    return true;
+
+  m_hKrautTree = hNewTree;
+  TriggerLocalBoundsUpdate();
+  return true;
 }
 
 void ezKrautTreeComponent::ComputeWind() const
@@ -555,14 +582,29 @@ void ezKrautTreeComponentManager::Update(const ezWorldModule::UpdateContext& con
     requireUpdate.Swap(m_RequireUpdate);
   }
 
+  ezDeque<ezComponentHandle> stillPending;
+
   for (const auto& hComp : requireUpdate)
   {
     ezKrautTreeComponent* pComp = nullptr;
     if (!TryGetComponent(hComp, pComp) || !pComp->IsActiveAndInitialized())
       continue;
 
-    // TODO: this could be wrapped into a task
-    pComp->EnsureTreeIsGenerated();
+    if (!pComp->EnsureTreeIsGenerated())
+    {
+      stillPending.PushBack(hComp);
+    }
+  }
+
+  if (!stillPending.IsEmpty())
+  {
+    EZ_LOCK(m_Mutex);
+
+    // no need to check for duplicates, EnsureTreeIsGenerated() doesn't do anything for a tree that is already up to date
+    for (const auto& hComp : stillPending)
+    {
+      m_RequireUpdate.PushBack(hComp);
+    }
   }
 }
 
@@ -594,4 +636,22 @@ void ezKrautTreeComponentManager::ResourceEventHandler(const ezResourceEvent& e)
       }
     }
   }
+
+  if (e.m_Type == ezResourceEvent::Type::ResourceContentUnloading && e.m_pResource->GetDynamicRTTI()->IsDerivedFrom<ezKrautTreeResource>())
+  {
+    EZ_LOCK(m_Mutex);
+
+    // the tree can't be loaded again by the resource manager, it has to go through the generator
+    ezKrautTreeResourceHandle hResource((ezKrautTreeResource*)(e.m_pResource));
+
+    for (auto it = m_Components.GetIterator(); it.IsValid(); ++it)
+    {
+      const ezKrautTreeComponent* pComponent = static_cast<ezKrautTreeComponent*>(it.Value());
+
+      if (pComponent->m_hKrautTree == hResource)
+      {
+        EnqueueUpdate(pComponent->GetHandle());
+      }
+    }
+  }
 }
@@ -89,7 +89,8 @@ public:
 
 private:
   ezResult CreateGeometry(ezGeometry& geo, ezWorldGeoExtractionUtil::ExtractionMode mode) const;
-  void EnsureTreeIsGenerated();
+  /// \brief Returns false, if the generator or the tree are still being loaded or generated and this has to be called again later.
+  bool EnsureTreeIsGenerated();
 
   ezUInt16 m_uiVariationIndex = 0xFFFF;
   ezUInt16 m_uiCustomRandomSeed = 0xFFFF;
@@ -6,8 +6,14 @@
 #include <Core/Assets/AssetFileHeader.h>
 #include <Core/ResourceManager/ResourceTypeLoader.h>
 #include <Foundation/Containers/StaticRingBuffer.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/OSFile.h>
 #include <Foundation/Math/BoundingSphere.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <Foundation/Time/Stopwatch.h>
+#include <Foundation/Types/Uuid.h>
+#include <Foundation/Utilities/ConversionUtils.h>
 #include <KrautGenerator/Description/Physics.h>
 #include <KrautGenerator/Lod/TreeStructureLod.h>
 #include <KrautGenerator/Lod/TreeStructureLodGenerator.h>
@@ -139,6 +145,56 @@ ezKrautTreeResourceHandle ezKrautGeneratorResource::GenerateTreeWithGoodSeed(ezU
   return GenerateTree(m_pDescriptor->m_GoodRandomSeeds[uiGoodSeedIndex]);
 }
 
+// increase this, whenever the generated data changes in a way that makes previously cached trees invalid
+static constexpr ezUInt8 s_uiTreeCacheVersion = 1;
+
+/// \brief Generates the descriptor of one tree variation on a worker thread.
+///
+/// The task only uses its own reference to the generator descriptor and never accesses the resource manager, so it can't end up waiting
+/// for a resource that is queued for loading behind it. The result is stored in serialized form, since that is what the resource loader
+/// has to hand to the tree resource anyway. If a cache file is given, the result is read from it instead of being generated, and written
+/// to it otherwise.
+class ezKrautTreeGenerationTask final : public ezTask
+{
+public:
+  ezKrautTreeGenerationTask()
+  {
+    ConfigureTask("Kraut: GenerateTree", ezTaskNesting::Never);
+  }
+
+  ezSharedPtr<ezKrautGeneratorResourceDescriptor> m_pGeneratorDesc;
+  ezUInt32 m_uiRandomSeed = 0;
+  ezString m_sCacheFile;
+
+  ezDefaultMemoryStreamStorage m_Storage;
+
+private:
+  virtual void Execute() override
+  {
+    if (!m_sCacheFile.IsEmpty() && ezKrautGeneratorResource::ReadTreeFromCache(m_sCacheFile, m_Storage).Succeeded())
+    {
+      m_pGeneratorDesc.Clear();
+      return;
+    }
+
+    ezKrautTreeResourceDescriptor desc;
+    ezKrautGeneratorResource::GenerateTreeDescriptor(*m_pGeneratorDesc, desc, m_uiRandomSeed);
+
+    // not needed anymore
+    m_pGeneratorDesc.Clear();
+
+    ezMemoryStreamWriter writer(&m_Storage);
+    desc.Save(writer);
+
+    if (!m_sCacheFile.IsEmpty())
+    {
+      // the cache is optional, if ':appdata' isn't available, we just regenerate the tree next time
+      ezKrautGeneratorResource::WriteTreeToCache(m_sCacheFile, m_Storage).IgnoreResult();
+    }
+  }
+};
+
+/// \brief Hands the result of a finished ezKrautTreeGenerationTask to the tree resource.
 class ezKrautResourceLoader : public ezResourceTypeLoader
 {
 public:
@@ -157,12 +213,6 @@ public:
   {
     LoadedData* pData = EZ_DEFAULT_NEW(LoadedData);
 
-    ezResourceLock<ezKrautGeneratorResource> pGenerator(m_hGeneratorResource, ezResourceAcquireMode::BlockTillLoaded);
-
-    ezKrautTreeResourceDescriptor desc;
-
-    pGenerator->GenerateTreeDescriptor(desc, m_uiRandomSeed);
-
     ezMemoryStreamWriter writer(&pData->m_Storage);
 
     writer << pResource->GetResourceID();
@@ -170,7 +220,7 @@ public:
     ezAssetFileHeader assetHash;
     assetHash.Write(writer).IgnoreResult();
 
-    desc.Save(writer);
+    m_pGenerationTask->m_Storage.CopyToStream(writer).IgnoreResult();
 
     ezResourceLoadData ld;
     ld.m_pDataStream = &pData->m_Reader;
@@ -186,60 +236,164 @@ public:
     EZ_DEFAULT_DELETE(pData);
 
     // not needed anymore
-    m_hGeneratorResource.Invalidate();
+    m_pGenerationTask.Clear();
   }
 
-  ezUInt32 m_uiRandomSeed = 0;
-  ezKrautGeneratorResourceHandle m_hGeneratorResource;
+  ezSharedPtr<ezKrautTreeGenerationTask> m_pGenerationTask;
 };
 
+ezKrautGeneratorResource::~ezKrautGeneratorResource() = default;
+
 ezKrautTreeResourceHandle ezKrautGeneratorResource::GenerateTree(ezUInt32 uiRandomSeed) const
 {
   EZ_PROFILE_SCOPE("Kraut: GenerateTree");
 
   ezStringBuilder sResourceID = GetResourceID();
-  ezStringBuilder sResourceDesc = GetResourceDescription();
   sResourceID.AppendFormat(":{}@{}", GetCurrentResourceChangeCounter(), uiRandomSeed);
-  sResourceDesc.AppendFormat(":{}@{}", GetCurrentResourceChangeCounter(), uiRandomSeed);
+
+  // identical requests for the same tree must not start the generation twice
+  EZ_LOCK(m_GenerateTreeMutex);
 
   ezKrautTreeResourceHandle hTree = ezResourceManager::GetExistingResource<ezKrautTreeResource>(sResourceID);
   if (hTree.IsValid())
   {
-    return hTree;
+    ezResourceLock<ezKrautTreeResource> pTree(hTree, ezResourceAcquireMode::PointerOnly);
+
+    // The loader of a tree is only used once. If the data was unloaded afterwards, any other load attempt goes through the file loader and
+    // ends up as 'missing'. Either way the tree has to go through a generation task again, which then reads it from the cache.
+    const bool bDataUnloaded = pTree->GetLoadingState() != ezResourceState::Loaded && !pTree->GetBaseResourceFlags().IsAnySet(ezResourceFlags::IsQueuedForLoading | ezResourceFlags::HasCustomDataLoader);
+
+    if (!bDataUnloaded)
+    {
+      return hTree;
+    }
+  }
+
+  PendingTree* pPending = nullptr;
+  if (!m_PendingTrees.TryGetValue(uiRandomSeed, pPending))
+  {
+    ezSharedPtr<ezKrautTreeGenerationTask> pTask = EZ_DEFAULT_NEW(ezKrautTreeGenerationTask);
+    pTask->m_pGeneratorDesc = m_pDescriptor;
+    pTask->m_uiRandomSeed = uiRandomSeed;
+
+    if (m_uiAssetHash != 0)
+    {
+      ezStringBuilder sCacheFile;
+      sCacheFile.Format(":appdata/KrautTreeCache/{}-{}.ezKrautTreeCache", ezArgU(m_uiAssetHash, 16, true, 16), uiRandomSeed);
+      pTask->m_sCacheFile = sCacheFile;
+    }
+
+    PendingTree& pending = m_PendingTrees[uiRandomSeed];
+    pending.m_TaskGroup = ezTaskSystem::StartSingleTask(pTask, ezTaskPriority::LongRunning);
+    pending.m_pTask = pTask;
+
+    return {};
   }
 
+  if (!ezTaskSystem::IsTaskGroupFinished(pPending->m_TaskGroup))
+  {
+    return {};
+  }
+
+  // the data is ready, so the resource can be created and loaded right away
   ezUniquePtr<ezKrautResourceLoader> pLoader = EZ_DEFAULT_NEW(ezKrautResourceLoader);
-  pLoader->m_hGeneratorResource = ezKrautGeneratorResourceHandle(const_cast<ezKrautGeneratorResource*>(this));
-  pLoader->m_uiRandomSeed = uiRandomSeed;
+  pLoader->m_pGenerationTask = pPending->m_pTask;
+
+  m_PendingTrees.Remove(uiRandomSeed);
+
+  if (hTree.IsValid())
+  {
+    ezResourceManager::UpdateResourceWithCustomLoader(hTree, std::move(pLoader));
+  }
+  else
+  {
+    hTree = ezResourceManager::GetExistingResourceOrCreateAsync<ezKrautTreeResource>(sResourceID, std::move(pLoader));
+  }
+
+  ezResourceManager::PreloadResource(hTree);
+
+  return hTree;
+}
+
+ezResult ezKrautGeneratorResource::ReadTreeFromCache(ezStringView sCacheFile, ezDefaultMemoryStreamStorage& out_storage)
+{
+  ezFileReader file;
+  if (file.Open(sCacheFile).Failed())
+    return EZ_FAILURE;
+
+  ezUInt8 uiVersion = 0;
+  file >> uiVersion;
+
+  if (uiVersion != s_uiTreeCacheVersion)
+    return EZ_FAILURE;
+
+  out_storage.Clear();
+  out_storage.ReadAll(file);
+  return out_storage.GetStorageSize64() > 0 ? EZ_SUCCESS : EZ_FAILURE;
+}
+
+ezResult ezKrautGeneratorResource::WriteTreeToCache(ezStringView sCacheFile, const ezDefaultMemoryStreamStorage& storage)
+{
+  ezStringBuilder sTempFile = sCacheFile;
+  {
+    ezStringBuilder sUuid;
+    ezConversionUtils::ToString(ezUuid::MakeUuid(), sUuid);
+    sTempFile.AppendFormat(".{}.tmp", sUuid);
+  }
+
+  {
+    ezFileWriter file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sTempFile));
+
+    file << s_uiTreeCacheVersion;
 
-  auto hRes = ezResourceManager::GetExistingResourceOrCreateAsync<ezKrautTreeResource>(sResourceID, std::move(pLoader), m_hFallbackResource);
+    if (storage.CopyToStream(file).Failed() || file.Flush().Failed())
+    {
+      file.Close();
+      ezFileSystem::DeleteFile(sTempFile);
+      return EZ_FAILURE;
+    }
+  }
+
+  ezStringBuilder sAbsTempFile, sAbsCacheFile;
+  if (ezFileSystem::ResolvePath(sTempFile, &sAbsTempFile, nullptr).Failed() || ezFileSystem::ResolvePath(sCacheFile, &sAbsCacheFile, nullptr).Failed())
+  {
+    ezFileSystem::DeleteFile(sTempFile);
+    return EZ_FAILURE;
+  }
 
-  if (!m_hFallbackResource.IsValid())
+  if (ezOSFile::MoveFileOrDirectory(sAbsTempFile, sAbsCacheFile).Failed())
   {
-    m_hFallbackResource = hRes;
-    ezResourceManager::PreloadResource(m_hFallbackResource);
+    // some platforms don't replace existing files, then another task or process has already written the same tree
+    ezOSFile::DeleteFile(sAbsTempFile).IgnoreResult();
+    return EZ_FAILURE;
   }
 
-  return hRes;
+  return EZ_SUCCESS;
 }
 
 void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescriptor& ref_dstDesc, ezUInt32 uiRandomSeed) const
+{
+  GenerateTreeDescriptor(*m_pDescriptor, ref_dstDesc, uiRandomSeed);
+}
+
+void ezKrautGeneratorResource::GenerateTreeDescriptor(const ezKrautGeneratorResourceDescriptor& generatorDesc, ezKrautTreeResourceDescriptor& ref_dstDesc, ezUInt32 uiRandomSeed)
 {
   EZ_LOG_BLOCK("Generate Kraut Tree");
 
   Kraut::TreeStructure treeStructure;
 
   Kraut::TreeStructureGenerator gen;
-  gen.m_pTreeStructureDesc = &m_pDescriptor->m_TreeStructureDesc;
+  gen.m_pTreeStructureDesc = &generatorDesc.m_TreeStructureDesc;
   gen.m_pTreeStructure = &treeStructure;
 
   gen.GenerateTreeStructure(uiRandomSeed);
 
-  const float fWoodBendiness = 0.1f / m_pDescriptor->m_fTreeStiffness;
+  const float fWoodBendiness = 0.1f / generatorDesc.m_fTreeStiffness;
   const float fTwigBendiness = 0.1f * fWoodBendiness;
 
   TreeStructureExtraData extraData;
-  GenerateExtraData(extraData, m_pDescriptor->m_TreeStructureDesc, treeStructure, uiRandomSeed, fWoodBendiness, fTwigBendiness);
+  GenerateExtraData(extraData, generatorDesc.m_TreeStructureDesc, treeStructure, uiRandomSeed, fWoodBendiness, fTwigBendiness);
 
   auto bbox = treeStructure.ComputeBoundingBox();
   ezBoundingBox bbox2 = ezBoundingBox::MakeFromMinMax(ToEzSwizzle(bbox.m_vMin), ToEzSwizzle(bbox.m_vMax));
@@ -301,7 +455,7 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
 
   for (ezUInt32 lodIdx = 0; lodIdx < ref_dstDesc.m_Lods.GetCapacity(); ++lodIdx)
   {
-    const auto& lodDesc = m_pDescriptor->m_LodDesc[lodIdx];
+    const auto& lodDesc = generatorDesc.m_LodDesc[lodIdx];
 
     if (lodDesc.m_Mode != Kraut::LodMode::Full)
     {
@@ -314,7 +468,7 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
     Kraut::TreeStructureLodGenerator lodGen;
     lodGen.m_pLodDesc = &lodDesc;
     lodGen.m_pTreeStructure = &treeStructure;
-    lodGen.m_pTreeStructureDesc = &m_pDescriptor->m_TreeStructureDesc;
+    lodGen.m_pTreeStructureDesc = &generatorDesc.m_TreeStructureDesc;
     lodGen.m_pTreeStructureLod = &treeLod;
 
     lodGen.GenerateTreeStructureLod();
@@ -334,10 +488,10 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
     dstMesh.m_LodType = ezKrautLodType::Mesh;
 
     dstMesh.m_fMinLodDistance = fPrevMaxLodDistance;
-    dstMesh.m_fMaxLodDistance = lodDesc.m_uiLodDistance * m_pDescriptor->m_fLodDistanceScale * m_pDescriptor->m_fUniformScaling;
+    dstMesh.m_fMaxLodDistance = lodDesc.m_uiLodDistance * generatorDesc.m_fLodDistanceScale * generatorDesc.m_fUniformScaling;
     fPrevMaxLodDistance = dstMesh.m_fMaxLodDistance;
 
-    const float fVertexScale = m_pDescriptor->m_fUniformScaling;
+    const float fVertexScale = generatorDesc.m_fUniformScaling;
 
     ezUInt32 uiMaxVertices = 0;
     ezUInt32 uiMaxTriangles = 0;
@@ -497,7 +651,7 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
 
         uiTriangleInSubmeshes += subMesh.m_uiNumTriangles;
 
-        for (const auto& srcMat : m_pDescriptor->m_Materials)
+        for (const auto& srcMat : generatorDesc.m_Materials)
         {
           if ((ezUInt32)srcMat.m_BranchType == branchType && (ezUInt32)srcMat.m_MaterialType == geometryType)
           {
@@ -550,8 +704,8 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
   ezLog::Debug("AO vertices: {}, checks: {}", uiOccVertices, uiOccChecks);
 
   ref_dstDesc.m_Details.m_Bounds = ezBoundingBoxSphere::MakeFromBox(bbox2);
-  ref_dstDesc.m_Details.m_fStaticColliderRadius = m_pDescriptor->m_fStaticColliderRadius;
-  ref_dstDesc.m_Details.m_sSurfaceResource = m_pDescriptor->m_sSurfaceResource;
+  ref_dstDesc.m_Details.m_fStaticColliderRadius = generatorDesc.m_fStaticColliderRadius;
+  ref_dstDesc.m_Details.m_sSurfaceResource = generatorDesc.m_sSurfaceResource;
   ref_dstDesc.m_Details.m_vLeafCenter = ref_dstDesc.m_Details.m_Bounds.m_vCenter;
 
   if (!vLeafCenter.IsZero())
@@ -562,7 +716,14 @@ void ezKrautGeneratorResource::GenerateTreeDescriptor(ezKrautTreeResourceDescrip
 
 ezResourceLoadDesc ezKrautGeneratorResource::UnloadData(Unload WhatToUnload)
 {
+  {
+    // running tasks keep their own reference to the descriptor, their results are just not used anymore
+    EZ_LOCK(m_GenerateTreeMutex);
+    m_PendingTrees.Clear();
+  }
+
   m_pDescriptor.Clear();
+  m_uiAssetHash = 0;
 
   ezResourceLoadDesc res;
   res.m_uiQualityLevelsDiscardable = 0;
@@ -623,6 +784,8 @@ ezResourceLoadDesc ezKrautGeneratorResource::UpdateContent(ezStreamReader* Strea
     return res;
   }
 
+  m_uiAssetHash = AssetHash.GetFileHash();
+
   m_pDescriptor = EZ_DEFAULT_NEW(ezKrautGeneratorResourceDescriptor);
   if (m_pDescriptor->Deserialize(*Stream).Failed())
   {
@@ -657,7 +820,7 @@ static ezUInt8 GetBranchLevel(const Kraut::TreeStructure& treeStructure, ezUInt3
   return uiLevel;
 }
 
-void ezKrautGeneratorResource::InitializeExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed) const
+void ezKrautGeneratorResource::InitializeExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed)
 {
   extraData.m_Branches.Clear();
   extraData.m_Branches.SetCount(treeStructure.m_BranchStructures.size());
@@ -680,7 +843,7 @@ void ezKrautGeneratorResource::InitializeExtraData(TreeStructureExtraData& extra
   }
 }
 
-void ezKrautGeneratorResource::ComputeDistancesAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const
+void ezKrautGeneratorResource::ComputeDistancesAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure)
 {
   for (ezUInt32 branchIdx = 0; branchIdx < treeStructure.m_BranchStructures.size(); ++branchIdx)
   {
@@ -701,7 +864,7 @@ void ezKrautGeneratorResource::ComputeDistancesAlongBranches(TreeStructureExtraD
   }
 }
 
-void ezKrautGeneratorResource::ComputeDistancesToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const
+void ezKrautGeneratorResource::ComputeDistancesToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure)
 {
   for (ezUInt32 branchIdx = 0; branchIdx < treeStructure.m_BranchStructures.size(); ++branchIdx)
   {
@@ -718,7 +881,7 @@ void ezKrautGeneratorResource::ComputeDistancesToAnchors(TreeStructureExtraData&
   }
 }
 
-void ezKrautGeneratorResource::ComputeBendinessAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, float fWoodBendiness, float fTwigBendiness) const
+void ezKrautGeneratorResource::ComputeBendinessAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, float fWoodBendiness, float fTwigBendiness)
 {
   for (ezUInt32 branchIdx = 0; branchIdx < treeStructure.m_BranchStructures.size(); ++branchIdx)
   {
@@ -760,7 +923,7 @@ void ezKrautGeneratorResource::ComputeBendinessAlongBranches(TreeStructureExtraD
   }
 }
 
-void ezKrautGeneratorResource::ComputeBendinessToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const
+void ezKrautGeneratorResource::ComputeBendinessToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure)
 {
   for (ezUInt32 branchIdx = 0; branchIdx < treeStructure.m_BranchStructures.size(); ++branchIdx)
   {
@@ -777,7 +940,7 @@ void ezKrautGeneratorResource::ComputeBendinessToAnchors(TreeStructureExtraData&
   }
 }
 
-void ezKrautGeneratorResource::GenerateExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructureDesc& treeStructureDesc, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed, float fWoodBendiness, float fTwigBendiness) const
+void ezKrautGeneratorResource::GenerateExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructureDesc& treeStructureDesc, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed, float fWoodBendiness, float fTwigBendiness)
 {
   InitializeExtraData(extraData, treeStructure, uiRandomSeed);
   ComputeDistancesAlongBranches(extraData, treeStructure);
@@ -1,12 +1,17 @@
 #pragma once
 
 #include <Core/ResourceManager/Resource.h>
+#include <Foundation/Containers/HashTable.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Threading/Mutex.h>
+#include <Foundation/Threading/TaskSystem.h>
 #include <KrautPlugin/KrautDeclarations.h>
 
 #include <KrautGenerator/Description/LodDesc.h>
 #include <KrautGenerator/Description/TreeStructureDesc.h>
 
 struct ezKrautTreeResourceDescriptor;
+class ezKrautTreeGenerationTask;
 
 namespace Kraut
 {
@@ -25,7 +30,8 @@ struct ezKrautMaterialDescriptor
   ezMaterialResourceHandle m_hMaterial;
 };
 
-struct EZ_KRAUTPLUGIN_DLL ezKrautGeneratorResourceDescriptor
+/// \brief Reference counted, so that tree generation tasks can keep using it while the generator resource is reloaded or unloaded.
+struct EZ_KRAUTPLUGIN_DLL ezKrautGeneratorResourceDescriptor : public ezRefCounted
 {
   Kraut::TreeStructureDesc m_TreeStructureDesc;
   Kraut::LodDesc m_LodDesc[5];
@@ -52,18 +58,38 @@ class EZ_KRAUTPLUGIN_DLL ezKrautGeneratorResource : public ezResource
 
 public:
   ezKrautGeneratorResource();
-
+  ~ezKrautGeneratorResource();
+
+  /// \brief Returns the tree resource for the given seed, or an invalid handle while the tree is still being generated.
+  ///
+  /// The first call starts a background task that generates the tree, later calls return an invalid handle until the task is done.
+  /// Only then the tree resource is created, so loading it never has to wait for the generation. Generated trees are cached in
+  /// ':appdata/KrautTreeCache', keyed by the asset hash of the generator and the seed, so that later runs only need to read them from disk.
+  /// The same goes for trees whose data was unloaded, they are reloaded through another task, which finds them in the cache.
   ezKrautTreeResourceHandle GenerateTree(ezUInt32 uiRandomSeed) const;
   ezKrautTreeResourceHandle GenerateTreeWithGoodSeed(ezUInt16 uiGoodSeedIndex) const;
 
   void GenerateTreeDescriptor(ezKrautTreeResourceDescriptor& ref_dstDesc, ezUInt32 uiRandomSeed) const;
 
+  /// \brief Generates one tree variation from the given generator descriptor. Doesn't access the resource manager.
+  static void GenerateTreeDescriptor(const ezKrautGeneratorResourceDescriptor& generatorDesc, ezKrautTreeResourceDescriptor& ref_dstDesc, ezUInt32 uiRandomSeed);
+
+  /// \brief Reads a serialized ezKrautTreeResourceDescriptor that was written with WriteTreeToCache().
+  static ezResult ReadTreeFromCache(ezStringView sCacheFile, ezDefaultMemoryStreamStorage& out_storage);
+
+  /// \brief Writes a serialized ezKrautTreeResourceDescriptor to the cache.
+  ///
+  /// The data is written to a temporary file first, which is then renamed, so that the same tree can be written by several
+  /// tasks or processes at the same time and readers never see a partially written file.
+  static ezResult WriteTreeToCache(ezStringView sCacheFile, const ezDefaultMemoryStreamStorage& storage);
+
 private:
   virtual ezResourceLoadDesc UnloadData(Unload WhatToUnload) override;
   virtual ezResourceLoadDesc UpdateContent(ezStreamReader* Stream) override;
   virtual void UpdateMemoryUsage(MemoryUsage& out_NewMemoryUsage) override;
 
-  ezUniquePtr<ezKrautGeneratorResourceDescriptor> m_pDescriptor;
+  ezSharedPtr<ezKrautGeneratorResourceDescriptor> m_pDescriptor;
+  ezUInt64 m_uiAssetHash = 0;
 
   struct BranchNodeExtraData
   {
@@ -88,12 +114,19 @@ private:
     ezDynamicArray<BranchExtraData> m_Branches;
   };
 
-  mutable ezKrautTreeResourceHandle m_hFallbackResource;
+  struct PendingTree
+  {
+    ezSharedPtr<ezKrautTreeGenerationTask> m_pTask;
+    ezTaskGroupID m_TaskGroup;
+  };
+
+  mutable ezMutex m_GenerateTreeMutex;
+  mutable ezHashTable<ezUInt32, PendingTree> m_PendingTrees; // key is the random seed
 
-  void InitializeExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed) const;
-  void ComputeDistancesAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const;
-  void ComputeDistancesToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const;
-  void ComputeBendinessAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, float fWoodBendiness, float fTwigBendiness) const;
-  void ComputeBendinessToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure) const;
-  void GenerateExtraData(TreeStructureExtraData& treeStructureExtraData, const Kraut::TreeStructureDesc& treeStructureDesc, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed, float fWoodBendiness, float fTwigBendiness) const;
+  static void InitializeExtraData(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed);
+  static void ComputeDistancesAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure);
+  static void ComputeDistancesToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure);
+  static void ComputeBendinessAlongBranches(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure, float fWoodBendiness, float fTwigBendiness);
+  static void ComputeBendinessToAnchors(TreeStructureExtraData& extraData, const Kraut::TreeStructure& treeStructure);
+  static void GenerateExtraData(TreeStructureExtraData& treeStructureExtraData, const Kraut::TreeStructureDesc& treeStructureDesc, const Kraut::TreeStructure& treeStructure, ezUInt32 uiRandomSeed, float fWoodBendiness, float fTwigBendiness);
 };
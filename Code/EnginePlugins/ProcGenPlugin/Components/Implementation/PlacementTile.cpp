@@ -3,9 +3,16 @@
 #include <Core/Messages/SetColorMessage.h>
 #include <Core/Prefabs/PrefabReferenceComponent.h>
 #include <Core/World/World.h>
+#include <Foundation/Math/Frustum.h>
 #include <Foundation/SimdMath/SimdConversion.h>
 #include <ProcGenPlugin/Components/Implementation/PlacementTile.h>
 #include <ProcGenPlugin/Tasks/PlacementData.h>
+#include <RendererCore/Material/MaterialResource.h>
+#include <RendererCore/Meshes/InstancedMeshComponent.h>
+#include <RendererCore/Meshes/MeshResource.h>
+#include <RendererCore/Pipeline/InstanceDataProvider.h>
+
+#include <RendererCore/../../../Data/Base/Shaders/Common/ObjectConstants.h>
 
 using namespace ezProcGenInternal;
 
@@ -24,6 +31,10 @@ PlacementTile::PlacementTile(PlacementTile&& other)
   other.m_State = State::Invalid;
 
   m_PlacedObjects = std::move(other.m_PlacedObjects);
+
+  m_InstanceBatches = std::move(other.m_InstanceBatches);
+  m_InstanceBounds = other.m_InstanceBounds;
+  m_uiUniqueIdForRendering = other.m_uiUniqueIdForRendering;
 }
 
 PlacementTile::~PlacementTile()
@@ -39,7 +50,7 @@ void PlacementTile::Initialize(const PlacementTileDesc& desc, ezSharedPtr<const
   m_State = State::Initialized;
 }
 
-void PlacementTile::Deinitialize(ezWorld& ref_world)
+void PlacementTile::Deinitialize(ezWorld& ref_world, ezDynamicArray<ezUniquePtr<ezInstanceData>>& out_instanceDataToDelete)
 {
   for (auto hObject : m_PlacedObjects)
   {
@@ -47,6 +58,13 @@ void PlacementTile::Deinitialize(ezWorld& ref_world)
   }
   m_PlacedObjects.Clear();
 
+  for (auto& instanceBatch : m_InstanceBatches)
+  {
+    out_instanceDataToDelete.PushBack(std::move(instanceBatch.m_pInstanceData));
+  }
+  m_InstanceBatches.Clear();
+  m_InstanceBounds = ezBoundingBoxSphere::MakeInvalid();
+
   m_Desc.m_hComponent.Invalidate();
   m_pOutput = nullptr;
   m_State = State::Invalid;
@@ -72,6 +90,16 @@ ezArrayPtr<const ezGameObjectHandle> PlacementTile::GetPlacedObjects() const
   return m_PlacedObjects;
 }
 
+ezArrayPtr<const PlacementTile::InstanceBatch> PlacementTile::GetInstanceBatches() const
+{
+  return m_InstanceBatches;
+}
+
+const ezBoundingBoxSphere& PlacementTile::GetInstanceBounds() const
+{
+  return m_InstanceBounds;
+}
+
 ezBoundingBox PlacementTile::GetBoundingBox() const
 {
   return m_Desc.GetBoundingBox();
@@ -173,3 +201,144 @@ ezUInt32 PlacementTile::PlaceObjects(ezWorld& ref_world, ezArrayPtr<const Placem
 
   return m_PlacedObjects.GetCount();
 }
+
+ezBoundingBox ezProcGenInternal::FillInstanceData(ezArrayPtr<const PlacementTransform> objectTransforms, ezArrayPtr<const ezBoundingSphere> meshBounds, ezUInt32 uiUniqueIdForRendering, ezArrayPtr<ezArrayPtr<ezPerInstanceData>> out_instanceData)
+{
+  ezHybridArray<ezUInt32, 4> writePositions;
+  writePositions.SetCount(out_instanceData.GetCount());
+
+  ezBoundingBox bounds = ezBoundingBox::MakeInvalid();
+
+  for (auto& objectTransform : objectTransforms)
+  {
+    const ezUInt32 uiMeshIndex = objectTransform.m_uiObjectIndex;
+    ezPerInstanceData& perInstanceData = out_instanceData[uiMeshIndex][writePositions[uiMeshIndex]++];
+
+    const ezTransform transform = ezSimdConversion::ToTransform(objectTransform.m_Transform);
+    const ezMat4 objectToWorld = transform.GetAsMat4();
+
+    perInstanceData.ObjectToWorld = objectToWorld;
+
+    if (transform.ContainsUniformScale())
+    {
+      perInstanceData.ObjectToWorldNormal = objectToWorld;
+    }
+    else
+    {
+      ezMat3 mInverse = objectToWorld.GetRotationalPart();
+      mInverse.Invert(0.0f).IgnoreResult();
+
+      ezShaderTransform shaderT;
+      shaderT = mInverse.GetTranspose();
+      perInstanceData.ObjectToWorldNormal = shaderT;
+    }
+
+    const ezBoundingSphere& meshSphere = meshBounds[uiMeshIndex];
+    const float fRadius = meshSphere.m_fRadius * transform.GetMaxScale();
+
+    perInstanceData.BoundingSphereRadius = fRadius;
+    perInstanceData.GameObjectID = uiUniqueIdForRendering;
+    perInstanceData.VertexColorAccessData = 0;
+    perInstanceData.Reserved = 0;
+
+    // same as the color message that is sent to placed prefabs
+    perInstanceData.Color = objectTransform.m_bHasValidColor ? objectTransform.m_ObjectColor.ToLinearFloat() : ezColor::White;
+
+    bounds.ExpandToInclude(ezBoundingBox::MakeFromCenterAndHalfExtents(transform.TransformPosition(meshSphere.m_vCenter), ezVec3(fRadius)));
+  }
+
+  return bounds;
+}
+
+ezUInt32 PlacementTile::PlaceInstances(ezArrayPtr<const PlacementTransform> objectTransforms, ezUInt32 uiUniqueIdForRendering)
+{
+  EZ_PROFILE_SCOPE("PlacementTile::PlaceInstances");
+
+  auto& meshesToPlace = m_pOutput->m_MeshesToPlace;
+  const ezUInt32 uiNumMeshes = meshesToPlace.GetCount();
+
+  // Count the instances per mesh first so every batch gets a buffer of exactly the right size.
+  ezHybridArray<ezUInt32, 4> instanceCounts;
+  instanceCounts.SetCount(uiNumMeshes);
+
+  for (auto& objectTransform : objectTransforms)
+  {
+    ++instanceCounts[objectTransform.m_uiObjectIndex];
+  }
+
+  ezHybridArray<ezArrayPtr<ezPerInstanceData>, 4> instanceData;
+  instanceData.SetCount(uiNumMeshes);
+
+  ezHybridArray<ezBoundingSphere, 4> meshBounds;
+  meshBounds.SetCount(uiNumMeshes);
+
+  for (ezUInt32 uiMeshIndex = 0; uiMeshIndex < uiNumMeshes; ++uiMeshIndex)
+  {
+    const ezUInt32 uiInstanceCount = instanceCounts[uiMeshIndex];
+    if (uiInstanceCount == 0)
+      continue;
+
+    {
+      ezResourceLock<ezMeshResource> pMesh(meshesToPlace[uiMeshIndex], ezResourceAcquireMode::BlockTillLoaded);
+      meshBounds[uiMeshIndex] = pMesh->GetBounds().GetSphere();
+    }
+
+    auto& instanceBatch = m_InstanceBatches.ExpandAndGetRef();
+    instanceBatch.m_hMesh = meshesToPlace[uiMeshIndex];
+    instanceBatch.m_pInstanceData = EZ_DEFAULT_NEW(ezInstanceData, uiInstanceCount);
+    instanceBatch.m_uiInstanceCount = uiInstanceCount;
+
+    ezUInt32 uiOffset = 0;
+    instanceData[uiMeshIndex] = instanceBatch.m_pInstanceData->GetInstanceData(uiInstanceCount, uiOffset);
+  }
+
+  const ezBoundingBox bounds = FillInstanceData(objectTransforms, meshBounds, uiUniqueIdForRendering, instanceData);
+
+  m_InstanceBounds = bounds.IsValid() ? ezBoundingBoxSphere::MakeFromBox(bounds) : ezBoundingBoxSphere::MakeInvalid();
+  m_uiUniqueIdForRendering = uiUniqueIdForRendering;
+  m_State = State::Finished;
+
+  return objectTransforms.GetCount();
+}
+
+void PlacementTile::ExtractInstanceRenderData(const ezFrustum& frustum, const ezGameObject* pOwner, ezMsgExtractRenderData& ref_msg) const
+{
+  if (m_InstanceBatches.IsEmpty() || frustum.GetObjectPosition(m_InstanceBounds.GetBox()) == ezVolumePosition::Outside)
+    return;
+
+  for (auto& instanceBatch : m_InstanceBatches)
+  {
+    ezResourceLock<ezMeshResource> pMesh(instanceBatch.m_hMesh, ezResourceAcquireMode::AllowLoadingFallback);
+    ezArrayPtr<const ezMeshResourceDescriptor::SubMesh> parts = pMesh->GetSubMeshes();
+
+    for (ezUInt32 uiPartIndex = 0; uiPartIndex < parts.GetCount(); ++uiPartIndex)
+    {
+      const ezUInt32 uiMaterialIndex = parts[uiPartIndex].m_uiMaterialIndex;
+      const ezMaterialResourceHandle& hMaterial = pMesh->GetMaterials()[uiMaterialIndex];
+
+      ezInstancedMeshRenderData* pRenderData = ezCreateRenderDataForThisFrame<ezInstancedMeshRenderData>(pOwner);
+      {
+        // the actual transforms are in the instance data, the global transform is only used for sorting
+        pRenderData->m_GlobalTransform = ezTransform(m_InstanceBounds.m_vCenter);
+        pRenderData->m_GlobalBounds = m_InstanceBounds;
+        pRenderData->m_hMesh = instanceBatch.m_hMesh;
+        pRenderData->m_hMaterial = hMaterial;
+        pRenderData->m_uiSubMeshIndex = uiPartIndex;
+        pRenderData->m_uiUniqueID = m_uiUniqueIdForRendering;
+        pRenderData->m_pExplicitInstanceData = instanceBatch.m_pInstanceData.Borrow();
+        pRenderData->m_uiExplicitInstanceCount = instanceBatch.m_uiInstanceCount;
+
+        pRenderData->FillBatchIdAndSortingKey();
+      }
+
+      ezRenderData::Category category = ezDefaultRenderDataCategories::LitOpaque;
+      if (hMaterial.IsValid())
+      {
+        ezResourceLock<ezMaterialResource> pMaterial(hMaterial, ezResourceAcquireMode::AllowLoadingFallback);
+        category = pMaterial->GetRenderDataCategory();
+      }
+
+      ref_msg.AddRenderData(pRenderData, category, ezRenderData::Caching::Never);
+    }
+  }
+}
@@ -1,13 +1,24 @@
 #pragma once
 
 #include <Core/World/Declarations.h>
+#include <Foundation/Math/BoundingBoxSphere.h>
 #include <Foundation/Types/UniquePtr.h>
 #include <ProcGenPlugin/Declarations.h>
 
+class ezFrustum;
 class ezPhysicsWorldModuleInterface;
+struct ezInstanceData;
+struct ezMsgExtractRenderData;
+struct ezPerInstanceData;
 
 namespace ezProcGenInternal
 {
+  /// \brief Writes the per instance data for all transforms. The instance data of each mesh is written in the same order as the
+  /// transforms, out_instanceData needs one array of the right size per mesh. Returns the global bounds of all instances.
+  ///
+  /// The instances end up with the same transform and color as the prefabs that PlacementTile::PlaceObjects() creates for non-instanced outputs.
+  EZ_PROCGENPLUGIN_DLL ezBoundingBox FillInstanceData(ezArrayPtr<const PlacementTransform> objectTransforms, ezArrayPtr<const ezBoundingSphere> meshBounds, ezUInt32 uiUniqueIdForRendering, ezArrayPtr<ezArrayPtr<ezPerInstanceData>> out_instanceData);
+
   class PlacementTile
   {
   public:
@@ -16,7 +27,10 @@ namespace ezProcGenInternal
     ~PlacementTile();
 
     void Initialize(const PlacementTileDesc& desc, ezSharedPtr<const PlacementOutput>& ref_pOutput);
-    void Deinitialize(ezWorld& ref_world);
+
+    /// \brief Deletes all placed objects. The instance data of instanced tiles might still be in use by the renderer,
+    /// so it is moved to out_instanceDataToDelete and the caller has to delete it once rendering is done with it.
+    void Deinitialize(ezWorld& ref_world, ezDynamicArray<ezUniquePtr<ezInstanceData>>& out_instanceDataToDelete);
 
     bool IsValid() const;
 
@@ -30,6 +44,25 @@ namespace ezProcGenInternal
 
     ezUInt32 PlaceObjects(ezWorld& ref_world, ezArrayPtr<const PlacementTransform> objectTransforms);
 
+    /// \brief Stores the transforms as per instance data, one batch per mesh, instead of creating game objects.
+    /// Only used for instanced outputs. The instance data still needs to be uploaded once, see GetInstanceBatches().
+    ezUInt32 PlaceInstances(ezArrayPtr<const PlacementTransform> objectTransforms, ezUInt32 uiUniqueIdForRendering);
+
+    struct InstanceBatch
+    {
+      ezMeshResourceHandle m_hMesh;
+      ezUniquePtr<ezInstanceData> m_pInstanceData;
+      ezUInt32 m_uiInstanceCount = 0;
+    };
+
+    ezArrayPtr<const InstanceBatch> GetInstanceBatches() const;
+
+    /// \brief The global bounds of all placed instances, only valid for instanced tiles that are finished.
+    const ezBoundingBoxSphere& GetInstanceBounds() const;
+
+    /// \brief Adds one instanced render data per batch and sub-mesh, if the bounds of the placed instances are visible in the given frustum.
+    void ExtractInstanceRenderData(const ezFrustum& frustum, const ezGameObject* pOwner, ezMsgExtractRenderData& ref_msg) const;
+
   private:
     PlacementTileDesc m_Desc;
     ezSharedPtr<const PlacementOutput> m_pOutput;
@@ -47,5 +80,9 @@ namespace ezProcGenInternal
 
     State::Enum m_State = State::Invalid;
     ezDynamicArray<ezGameObjectHandle> m_PlacedObjects;
+
+    ezHybridArray<InstanceBatch, 4> m_InstanceBatches;
+    ezBoundingBoxSphere m_InstanceBounds = ezBoundingBoxSphere::MakeInvalid();
+    ezUInt32 m_uiUniqueIdForRendering = 0;
   };
 } // namespace ezProcGenInternal
@@ -5,6 +5,7 @@
 #include <Core/WorldSerializer/WorldReader.h>
 #include <Core/WorldSerializer/WorldWriter.h>
 #include <Foundation/Configuration/CVar.h>
+#include <Foundation/Math/Frustum.h>
 #include <Foundation/Profiling/Profiling.h>
 #include <ProcGenPlugin/Components/Implementation/PlacementTile.h>
 #include <ProcGenPlugin/Components/ProcPlacementComponent.h>
@@ -12,9 +13,12 @@
 #include <ProcGenPlugin/Tasks/PlacementData.h>
 #include <ProcGenPlugin/Tasks/PlacementTask.h>
 #include <ProcGenPlugin/Tasks/PreparePlacementTask.h>
+#include <RendererCore/Components/RenderComponent.h>
 #include <RendererCore/Debug/DebugRenderer.h>
 #include <RendererCore/Pipeline/ExtractedRenderData.h>
+#include <RendererCore/Pipeline/InstanceDataProvider.h>
 #include <RendererCore/Pipeline/View.h>
+#include <RendererCore/RenderContext/RenderContext.h>
 #include <RendererCore/RenderWorld/RenderWorld.h>
 
 using namespace ezProcGenInternal;
@@ -57,18 +61,24 @@ void ezProcPlacementComponentManager::Initialize()
   }
 
   ezResourceManager::GetResourceEvents().AddEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnResourceEvent, this));
+  ezRenderWorld::GetRenderEvent().AddEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnRenderEvent, this));
 }
 
 void ezProcPlacementComponentManager::Deinitialize()
 {
+  ezRenderWorld::GetRenderEvent().RemoveEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnRenderEvent, this));
   ezResourceManager::GetResourceEvents().RemoveEventHandler(ezMakeDelegate(&ezProcPlacementComponentManager::OnResourceEvent, this));
 
   for (auto& activeTile : m_ActiveTiles)
   {
-    activeTile.Deinitialize(*GetWorld());
+    activeTile.Deinitialize(*GetWorld(), m_ReleasedInstanceData);
   }
   m_ActiveTiles.Clear();
 
+  m_InstanceDataToUpload.Clear();
+  m_InstanceDataToDelete.Clear();
+  m_ReleasedInstanceData.Clear();
+
   SUPER::Deinitialize();
 }
 
@@ -331,7 +341,23 @@ void ezProcPlacementComponentManager::PlaceObjects(const ezWorldModule::UpdateCo
         ezUInt64 uiTileKey = GetTileKey(tileDesc.m_iPosX, tileDesc.m_iPosY);
         if (auto pTile = outputContext.m_TileIndices.GetValue(uiTileKey))
         {
-          uiPlacedObjects = activeTile.PlaceObjects(*GetWorld(), task.m_pPlacementTask->GetOutputTransforms());
+          if (outputContext.m_pOutput->IsInstanced())
+          {
+            // No game objects are created for instanced outputs, so these don't count towards the per frame limit.
+            uiPlacedObjects = activeTile.PlaceInstances(task.m_pPlacementTask->GetOutputTransforms(), ezRenderComponent::GetUniqueIdForRendering(pComponent));
+            EnqueueInstanceDataUpload(activeTile);
+
+            // Instances can stick out of the placement boxes, so the component bounds have to grow or the tile would be culled too early.
+            if (uiPlacedObjects > 0 && !pComponent->GetOwner()->GetGlobalBounds().GetBox().Contains(activeTile.GetInstanceBounds().GetBox()))
+            {
+              pComponent->GetOwner()->UpdateLocalBounds();
+            }
+          }
+          else
+          {
+            uiPlacedObjects = activeTile.PlaceObjects(*GetWorld(), task.m_pPlacementTask->GetOutputTransforms());
+            uiTotalNumPlacedObjects += uiPlacedObjects;
+          }
 
           pTile->m_uiIndex = uiPlacedObjects > 0 ? uiTileIndex : EmptyTileIndex;
           pTile->m_uiLastSeenFrame = ezRenderWorld::GetFrameCounter();
@@ -346,8 +372,6 @@ void ezProcPlacementComponentManager::PlaceObjects(const ezWorldModule::UpdateCo
 
       // mark task for re-use
       DeallocateProcessingTask(sortedTask.m_uiTaskIndex);
-
-      uiTotalNumPlacedObjects += uiPlacedObjects;
     }
 
     if (uiTotalNumPlacedObjects >= (ezUInt32)cvar_ProcGenProcessingMaxNewObjectsPerFrame)
@@ -424,8 +448,33 @@ ezUInt32 ezProcPlacementComponentManager::AllocateTile(const PlacementTileDesc&
 
 void ezProcPlacementComponentManager::DeallocateTile(ezUInt32 uiTileIndex)
 {
-  m_ActiveTiles[uiTileIndex].Deinitialize(*GetWorld());
+  m_ActiveTiles[uiTileIndex].Deinitialize(*GetWorld(), m_ReleasedInstanceData);
   m_FreeTiles.PushBack(uiTileIndex);
+
+  if (m_ReleasedInstanceData.IsEmpty())
+    return;
+
+  EZ_LOCK(m_InstanceDataMutex);
+
+  const ezUInt64 uiCurrentFrame = ezRenderWorld::GetFrameCounter();
+
+  for (auto& pInstanceData : m_ReleasedInstanceData)
+  {
+    for (ezUInt32 i = 0; i < m_InstanceDataToUpload.GetCount(); ++i)
+    {
+      if (m_InstanceDataToUpload[i].m_pInstanceData == pInstanceData.Borrow())
+      {
+        m_InstanceDataToUpload.RemoveAtAndSwap(i);
+        break;
+      }
+    }
+
+    auto& instanceDataToDelete = m_InstanceDataToDelete.ExpandAndGetRef();
+    instanceDataToDelete.m_pInstanceData = std::move(pInstanceData);
+    instanceDataToDelete.m_uiReleasedFrame = uiCurrentFrame;
+  }
+
+  m_ReleasedInstanceData.Clear();
 }
 
 ezUInt32 ezProcPlacementComponentManager::AllocateProcessingTask(ezUInt32 uiTileIndex)
@@ -559,6 +608,111 @@ void ezProcPlacementComponentManager::ClearVisibleComponents()
   m_VisibleComponents.Clear();
 }
 
+void ezProcPlacementComponentManager::ExtractInstanceRenderData(const ezProcPlacementComponent* pComponent, ezMsgExtractRenderData& ref_msg) const
+{
+  ezFrustum frustum;
+  bool bFrustumComputed = false;
+
+  for (auto& outputContext : pComponent->m_OutputContexts)
+  {
+    if (!outputContext.m_pOutput->IsInstanced())
+      continue;
+
+    if (!bFrustumComputed)
+    {
+      ref_msg.m_pView->ComputeCullingFrustum(frustum);
+      bFrustumComputed = true;
+    }
+
+    for (auto it : outputContext.m_TileIndices)
+    {
+      const ezUInt32 uiTileIndex = it.Value().m_uiIndex;
+      if (uiTileIndex == NewTileIndex || uiTileIndex == EmptyTileIndex)
+        continue;
+
+      m_ActiveTiles[uiTileIndex].ExtractInstanceRenderData(frustum, pComponent->GetOwner(), ref_msg);
+    }
+  }
+}
+
+ezBoundingBox ezProcPlacementComponentManager::GetInstanceBounds(const ezProcPlacementComponent* pComponent) const
+{
+  ezBoundingBox bounds = ezBoundingBox::MakeInvalid();
+
+  for (auto& outputContext : pComponent->m_OutputContexts)
+  {
+    if (!outputContext.m_pOutput->IsInstanced())
+      continue;
+
+    for (auto it : outputContext.m_TileIndices)
+    {
+      const ezUInt32 uiTileIndex = it.Value().m_uiIndex;
+      if (uiTileIndex == NewTileIndex || uiTileIndex == EmptyTileIndex)
+        continue;
+
+      const ezBoundingBoxSphere& tileBounds = m_ActiveTiles[uiTileIndex].GetInstanceBounds();
+      if (tileBounds.IsValid())
+      {
+        bounds.ExpandToInclude(tileBounds.GetBox());
+      }
+    }
+  }
+
+  return bounds;
+}
+
+void ezProcPlacementComponentManager::EnqueueInstanceDataUpload(const ezProcGenInternal::PlacementTile& tile)
+{
+  EZ_LOCK(m_InstanceDataMutex);
+
+  for (auto& instanceBatch : tile.GetInstanceBatches())
+  {
+    auto& instanceDataToUpload = m_InstanceDataToUpload.ExpandAndGetRef();
+    instanceDataToUpload.m_pInstanceData = instanceBatch.m_pInstanceData.Borrow();
+    instanceDataToUpload.m_uiInstanceCount = instanceBatch.m_uiInstanceCount;
+  }
+}
+
+void ezProcPlacementComponentManager::OnRenderEvent(const ezRenderWorldRenderEvent& e)
+{
+  if (e.m_Type == ezRenderWorldRenderEvent::Type::BeginRender)
+  {
+    EZ_LOCK(m_InstanceDataMutex);
+
+    if (m_InstanceDataToUpload.IsEmpty())
+      return;
+
+    ezGALDevice* pDevice = ezGALDevice::GetDefaultDevice();
+    ezGALPass* pGALPass = pDevice->BeginPass("Update ProcGen Instance Data");
+
+    ezRenderContext* pRenderContext = ezRenderContext::GetDefaultInstance();
+    pRenderContext->BeginCompute(pGALPass);
+
+    for (auto& instanceDataToUpload : m_InstanceDataToUpload)
+    {
+      instanceDataToUpload.m_pInstanceData->UpdateInstanceData(pRenderContext, instanceDataToUpload.m_uiInstanceCount);
+    }
+
+    pRenderContext->EndCompute();
+    pDevice->EndPass(pGALPass);
+
+    m_InstanceDataToUpload.Clear();
+  }
+  else if (e.m_Type == ezRenderWorldRenderEvent::Type::EndRender)
+  {
+    EZ_LOCK(m_InstanceDataMutex);
+
+    // Data released during the update of a frame can still be referenced by the render data that is currently being rendered.
+    for (ezUInt32 i = m_InstanceDataToDelete.GetCount(); i-- > 0;)
+    {
+      if (m_InstanceDataToDelete[i].m_uiReleasedFrame < e.m_uiFrameCounter)
+      {
+        m_InstanceDataToDelete.RemoveAtAndSwap(i);
+      }
+    }
+  }
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 // clang-format off
@@ -677,15 +831,30 @@ void ezProcPlacementComponent::OnUpdateLocalBounds(ezMsgUpdateLocalBounds& ref_m
     bounds.ExpandToInclude(localBox);
   }
 
+  // Instanced tiles are culled with the bounds of the component, so they have to include everything that was placed.
+  if (auto pManager = static_cast<const ezProcPlacementComponentManager*>(GetOwningManager()))
+  {
+    const ezBoundingBox instanceBounds = pManager->GetInstanceBounds(this);
+    if (instanceBounds.IsValid())
+    {
+      ezBoundingBoxSphere localInstanceBounds = ezBoundingBoxSphere::MakeFromBox(instanceBounds);
+      localInstanceBounds.Transform(GetOwner()->GetGlobalTransform().GetInverse().GetAsMat4());
+
+      bounds.ExpandToInclude(localInstanceBounds);
+    }
+  }
+
   ref_msg.AddBounds(bounds, GetOwner()->IsDynamic() ? ezDefaultSpatialDataCategories::RenderDynamic : ezDefaultSpatialDataCategories::RenderStatic);
 }
 
 void ezProcPlacementComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& ref_msg) const
 {
-  // Don't extract render data for selection or in shadow views.
+  // Don't extract render data for selection. Shadow views are needed for the instanced tiles, see below.
   if (ref_msg.m_OverrideCategory != ezInvalidRenderDataCategory)
     return;
 
+  auto pManager = static_cast<const ezProcPlacementComponentManager*>(GetOwningManager());
+
   if (ref_msg.m_pView->GetCameraUsageHint() == ezCameraUsageHint::MainView || ref_msg.m_pView->GetCameraUsageHint() == ezCameraUsageHint::EditorView)
   {
     const ezCamera* pCamera = ref_msg.m_pView->GetCullingCamera();
@@ -695,10 +864,12 @@ void ezProcPlacementComponent::OnMsgExtractRenderData(ezMsgExtractRenderData& re
 
     if (m_hResource.IsValid())
     {
-      auto pManager = static_cast<const ezProcPlacementComponentManager*>(GetOwningManager());
       pManager->AddVisibleComponent(GetHandle(), cameraPosition, cameraDirection);
     }
   }
+
+  // Instanced tiles are rendered in all views, including shadow views.
+  pManager->ExtractInstanceRenderData(this, ref_msg);
 }
 
 void ezProcPlacementComponent::SerializeComponent(ezWorldWriter& inout_stream) const
@@ -6,8 +6,10 @@
 #include <ProcGenPlugin/Resources/ProcGenGraphResource.h>
 
 class ezProcPlacementComponent;
+struct ezInstanceData;
 struct ezMsgUpdateLocalBounds;
 struct ezMsgExtractRenderData;
+struct ezRenderWorldRenderEvent;
 
 //////////////////////////////////////////////////////////////////////////
 
@@ -45,6 +47,11 @@ private:
   void AddVisibleComponent(const ezComponentHandle& hComponent, const ezVec3& cameraPosition, const ezVec3& cameraDirection) const;
   void ClearVisibleComponents();
 
+  void ExtractInstanceRenderData(const ezProcPlacementComponent* pComponent, ezMsgExtractRenderData& ref_msg) const;
+  ezBoundingBox GetInstanceBounds(const ezProcPlacementComponent* pComponent) const;
+  void EnqueueInstanceDataUpload(const ezProcGenInternal::PlacementTile& tile);
+  void OnRenderEvent(const ezRenderWorldRenderEvent& e);
+
   struct VisibleComponent
   {
     ezComponentHandle m_hComponent;
@@ -92,6 +99,25 @@ private:
 
   ezDynamicArray<ezProcGenInternal::PlacementTileDesc, ezAlignedAllocatorWrapper> m_NewTiles;
   ezTaskGroupID m_UpdateTilesTaskGroupID;
+
+  // Instanced tiles upload their instance data once, at the beginning of the next rendered frame.
+  // Released instance data is only deleted after all frames that could still reference it have been rendered.
+  struct InstanceDataToUpload
+  {
+    ezInstanceData* m_pInstanceData = nullptr;
+    ezUInt32 m_uiInstanceCount = 0;
+  };
+
+  struct InstanceDataToDelete
+  {
+    ezUniquePtr<ezInstanceData> m_pInstanceData;
+    ezUInt64 m_uiReleasedFrame = 0;
+  };
+
+  ezMutex m_InstanceDataMutex;
+  ezDynamicArray<InstanceDataToUpload> m_InstanceDataToUpload;
+  ezDynamicArray<InstanceDataToDelete> m_InstanceDataToDelete;
+  ezDynamicArray<ezUniquePtr<ezInstanceData>> m_ReleasedInstanceData;
 };
 
 //////////////////////////////////////////////////////////////////////////
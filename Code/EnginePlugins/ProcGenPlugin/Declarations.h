@@ -10,6 +10,7 @@
 
 class ezExpressionByteCode;
 using ezColorGradientResourceHandle = ezTypedResourceHandle<class ezColorGradientResource>;
+using ezMeshResourceHandle = ezTypedResourceHandle<class ezMeshResource>;
 using ezPrefabResourceHandle = ezTypedResourceHandle<class ezPrefabResource>;
 using ezSurfaceResourceHandle = ezTypedResourceHandle<class ezSurfaceResource>;
 
@@ -169,11 +170,17 @@ namespace ezProcGenInternal
 
     bool IsValid() const
     {
-      return !m_ObjectsToPlace.IsEmpty() && m_pPattern != nullptr && m_fFootprint > 0.0f && m_fCullDistance > 0.0f && m_pByteCode != nullptr;
+      return (!m_ObjectsToPlace.IsEmpty() || !m_MeshesToPlace.IsEmpty()) && m_pPattern != nullptr && m_fFootprint > 0.0f && m_fCullDistance > 0.0f && m_pByteCode != nullptr;
     }
 
+    /// \brief Instanced outputs don't create any game objects, the placed meshes are rendered directly from the tiles instead.
+    bool IsInstanced() const { return !m_MeshesToPlace.IsEmpty(); }
+
     ezHybridArray<ezPrefabResourceHandle, 4> m_ObjectsToPlace;
 
+    /// If set, these meshes are placed as instances and m_ObjectsToPlace is ignored.
+    ezHybridArray<ezMeshResourceHandle, 4> m_MeshesToPlace;
+
     const Pattern* m_pPattern = nullptr;
     float m_fFootprint = 1.0f;
 
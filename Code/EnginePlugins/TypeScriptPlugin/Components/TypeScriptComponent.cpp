@@ -143,31 +143,14 @@ void ezTypeScriptComponent::BroadcastEventMsg(ezEventMessage& ref_msg)
   sender.m_Sender.SendEventMessage(ref_msg, this, GetOwner()->GetParent());
 }
 
-bool ezTypeScriptComponent::CallTsFunc(const char* szFuncName)
+bool ezTypeScriptComponent::CallTsFunc(ezTypeScriptComponentFunction::Enum func)
 {
   if (GetUserFlag(UserFlag::ScriptFailure))
     return false;
 
   ezTypeScriptBinding& binding = static_cast<ezTypeScriptComponentManager*>(GetOwningManager())->GetTsBinding();
 
-  ezDuktapeHelper duk(binding.GetDukTapeContext());
-
-  binding.DukPutComponentObject(this); // [ comp ]
-
-  if (duk.PrepareMethodCall(szFuncName).Succeeded()) // [ comp func comp ]
-  {
-    duk.CallPreparedMethod().IgnoreResult(); // [ comp result ]
-    duk.PopStack(2);                         // [ ]
-
-    EZ_DUK_RETURN_AND_VERIFY_STACK(duk, true, 0);
-  }
-  else
-  {
-    // remove 'this'   [ comp ]
-    duk.PopStack(); // [ ]
-
-    EZ_DUK_RETURN_AND_VERIFY_STACK(duk, false, 0);
-  }
+  return binding.CallComponentFunction(m_ComponentTypeInfo, func, m_uiStashIdx);
 }
 
 void ezTypeScriptComponent::SetExposedVariables()
@@ -201,7 +184,7 @@ void ezTypeScriptComponent::Initialize()
   {
     SetUserFlag(UserFlag::InitializedTS, true);
 
-    CallTsFunc("Initialize");
+    CallTsFunc(ezTypeScriptComponentFunction::Initialize);
   }
 }
 
@@ -218,7 +201,7 @@ void ezTypeScriptComponent::Deinitialize()
 
   if (GetUserFlag(UserFlag::InitializedTS))
   {
-    CallTsFunc("Deinitialize");
+    CallTsFunc(ezTypeScriptComponentFunction::Deinitialize);
   }
 
   SetUserFlag(UserFlag::InitializedTS, false);
@@ -235,14 +218,14 @@ void ezTypeScriptComponent::OnActivated()
 
   SetUserFlag(UserFlag::OnActivatedTS, true);
 
-  CallTsFunc("OnActivated");
+  CallTsFunc(ezTypeScriptComponentFunction::OnActivated);
 }
 
 void ezTypeScriptComponent::OnDeactivated()
 {
   if (GetUserFlag(UserFlag::OnActivatedTS))
   {
-    CallTsFunc("OnDeactivated");
+    CallTsFunc(ezTypeScriptComponentFunction::OnDeactivated);
   }
 
   SetUserFlag(UserFlag::OnActivatedTS, false);
@@ -263,8 +246,7 @@ void ezTypeScriptComponent::OnSimulationStarted()
     return;
   }
 
-  ezUInt32 uiStashIdx = 0;
-  if (binding.RegisterComponent(m_ComponentTypeInfo.Value().m_sComponentTypeName, GetHandle(), uiStashIdx, false).Failed())
+  if (binding.RegisterComponent(m_ComponentTypeInfo.Value().m_sComponentTypeName, GetHandle(), m_uiStashIdx, false).Failed())
   {
     SetUserFlag(UserFlag::ScriptFailure, true);
     ezLog::Error("Failed to register TS component type '{}'. Class may not exist under that name.", m_ComponentTypeInfo.Value().m_sComponentTypeName);
@@ -278,44 +260,30 @@ void ezTypeScriptComponent::OnSimulationStarted()
 
   ezTypeScriptComponent::OnActivated();
 
-  CallTsFunc("OnSimulationStarted");
+  CallTsFunc(ezTypeScriptComponentFunction::OnSimulationStarted);
 }
 
-void ezTypeScriptComponent::Update(ezTypeScriptBinding& binding)
+bool ezTypeScriptComponent::ShouldTick(ezTime tNow)
 {
   if (GetUserFlag(UserFlag::ScriptFailure) || GetUserFlag(UserFlag::NoTsTick))
-    return;
+    return false;
 
   if (m_UpdateInterval.IsNegative())
-    return;
-
-  const ezTime tNow = GetWorld()->GetClock().GetAccumulatedTime();
-
-  if (m_LastUpdate + m_UpdateInterval > tNow)
-    return;
-
-  EZ_PROFILE_SCOPE(GetOwner()->GetName());
-
-  m_LastUpdate = tNow;
-
-  ezDuktapeHelper duk(binding.GetDukTapeContext());
+    return false;
 
-  binding.DukPutComponentObject(this); // [ comp ]
+  const ezTypeScriptBinding& binding = static_cast<ezTypeScriptComponentManager*>(GetOwningManager())->GetTsBinding();
 
-  if (duk.PrepareMethodCall("Tick").Succeeded()) // [ comp func comp ]
-  {
-    duk.CallPreparedMethod().IgnoreResult(); // [ comp result ]
-    duk.PopStack(2);                         // [ ]
-  }
-  else
+  if (!binding.HasComponentFunction(m_ComponentTypeInfo, ezTypeScriptComponentFunction::Tick))
   {
-    // remove 'this'   [ comp ]
-    duk.PopStack(); // [ ]
-
     SetUserFlag(UserFlag::NoTsTick, true);
+    return false;
   }
 
-  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+  if (m_LastUpdate + m_UpdateInterval > tNow)
+    return false;
+
+  m_LastUpdate = tNow;
+  return true;
 }
 
 void ezTypeScriptComponent::SetTypeScriptComponentFile(const char* szFile)
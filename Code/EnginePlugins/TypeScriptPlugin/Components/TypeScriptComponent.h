@@ -39,6 +39,18 @@ private:
   void Update(const ezWorldModule::UpdateContext& context);
 
   mutable ezTypeScriptBinding m_TsBinding;
+
+  struct TickBucket
+  {
+    const ezTypeScriptBinding::TsComponentTypeInfo* m_pTypeInfo = nullptr;
+    ezUInt32 m_uiFirstComponent = 0;
+    ezUInt32 m_uiNumComponents = 0;
+  };
+
+  ezDynamicArray<ezTypeScriptComponent*> m_DueComponents;
+  ezDynamicArray<ezUInt32> m_DueComponentBuckets;
+  ezDynamicArray<ezTypeScriptComponent*> m_ComponentsToTick;
+  ezHybridArray<TickBucket, 16> m_TickBuckets;
 };
 
 //////////////////////////////////////////////////////////////////////////
@@ -47,6 +59,8 @@ class EZ_TYPESCRIPTPLUGIN_DLL ezTypeScriptComponent : public ezEventMessageHandl
 {
   EZ_DECLARE_COMPONENT_TYPE(ezTypeScriptComponent, ezEventMessageHandlerComponent, ezTypeScriptComponentManager);
 
+  friend class ezTypeScriptComponentManager;
+
   //////////////////////////////////////////////////////////////////////////
   // ezComponent
 
@@ -88,11 +102,12 @@ private:
 
   ezHybridArray<EventSender, 2> m_EventSenders;
 
-  bool CallTsFunc(const char* szFuncName);
-  void Update(ezTypeScriptBinding& script);
+  bool CallTsFunc(ezTypeScriptComponentFunction::Enum func);
+  bool ShouldTick(ezTime tNow);
   void SetExposedVariables();
 
   ezTypeScriptBinding::TsComponentTypeInfo m_ComponentTypeInfo;
+  ezUInt32 m_uiStashIdx = 0;
 
   void SetTypeScriptComponentFile(const char* szFile); // [ property ]
   const char* GetTypeScriptComponentFile() const;      // [ property ]
@@ -40,13 +40,85 @@ void ezTypeScriptComponentManager::Update(const ezWorldModule::UpdateContext& co
 
   m_TsBinding.Update();
 
+  const ezTime tNow = GetWorld()->GetClock().GetAccumulatedTime();
+
+  // Group the due components by script type, so that the Tick function only needs to be pushed once per type.
+  // The buckets are ordered by the first component of each type and every bucket keeps the storage order of its components,
+  // so the tick order stays deterministic and only differs from the storage order where different types are interleaved.
+  m_DueComponents.Clear();
+  m_DueComponentBuckets.Clear();
+  m_TickBuckets.Clear();
+
   for (auto it = this->m_ComponentStorage.GetIterator(context.m_uiFirstComponentIndex, context.m_uiComponentCount); it.IsValid(); ++it)
   {
-    if (it->IsActiveAndSimulating())
+    if (!it->IsActiveAndSimulating() || !it->ShouldTick(tNow))
+      continue;
+
+    const ezTypeScriptBinding::TsComponentTypeInfo* pTypeInfo = &it->m_ComponentTypeInfo;
+
+    ezUInt32 uiBucket = 0;
+    while (uiBucket < m_TickBuckets.GetCount() && &m_TickBuckets[uiBucket].m_pTypeInfo->Value() != &pTypeInfo->Value())
+    {
+      ++uiBucket;
+    }
+
+    if (uiBucket == m_TickBuckets.GetCount())
+    {
+      m_TickBuckets.ExpandAndGetRef().m_pTypeInfo = pTypeInfo;
+    }
+
+    m_TickBuckets[uiBucket].m_uiNumComponents++;
+
+    m_DueComponents.PushBack(it);
+    m_DueComponentBuckets.PushBack(uiBucket);
+  }
+
+  {
+    ezUInt32 uiFirstComponent = 0;
+    for (TickBucket& bucket : m_TickBuckets)
+    {
+      bucket.m_uiFirstComponent = uiFirstComponent;
+      uiFirstComponent += bucket.m_uiNumComponents;
+      bucket.m_uiNumComponents = 0;
+    }
+
+    m_ComponentsToTick.SetCountUninitialized(m_DueComponents.GetCount());
+
+    for (ezUInt32 i = 0; i < m_DueComponents.GetCount(); ++i)
+    {
+      TickBucket& bucket = m_TickBuckets[m_DueComponentBuckets[i]];
+      m_ComponentsToTick[bucket.m_uiFirstComponent + bucket.m_uiNumComponents] = m_DueComponents[i];
+      bucket.m_uiNumComponents++;
+    }
+  }
+
+  ezDuktapeHelper duk(m_TsBinding.GetDukTapeContext());
+
+  for (const TickBucket& bucket : m_TickBuckets)
+  {
+    const ezTypeScriptBinding::TsComponentTypeInfo& typeInfo = *bucket.m_pTypeInfo;
+
+    EZ_PROFILE_SCOPE(typeInfo.Value().m_sComponentTypeName);
+
+    m_TsBinding.DukPushComponentFunction(typeInfo, ezTypeScriptComponentFunction::Tick); // [ func ]
+
+    for (ezUInt32 i = bucket.m_uiFirstComponent; i < bucket.m_uiFirstComponent + bucket.m_uiNumComponents; ++i)
     {
-      it->Update(m_TsBinding);
+      ezTypeScriptComponent* pComponent = m_ComponentsToTick[i];
+
+      // an earlier Tick may have deactivated or deleted this component
+      if (!pComponent->IsActiveAndSimulating() || pComponent->GetUserFlag(ezTypeScriptComponent::UserFlag::ScriptFailure))
+        continue;
+
+      EZ_PROFILE_SCOPE(pComponent->GetOwner()->GetName());
+
+      m_TsBinding.DukCallComponentFunction(pComponent->m_uiStashIdx); // [ func ]
     }
+
+    duk.PopStack(); // [ ]
   }
 
+  EZ_DUK_VERIFY_STACK(duk, 0);
+
   m_TsBinding.CleanupStash(10);
 }
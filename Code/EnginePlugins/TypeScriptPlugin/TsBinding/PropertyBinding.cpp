@@ -4,6 +4,7 @@
 #include <TypeScriptPlugin/TsBinding/TsBinding.h>
 
 ezHashTable<ezUInt32, ezTypeScriptBinding::PropertyBinding> ezTypeScriptBinding::s_BoundProperties;
+ezHashTable<const ezRTTI*, ezTypeScriptBinding::MarshalingInfo> ezTypeScriptBinding::s_MarshalingInfos;
 
 static int __CPP_ComponentProperty_get(duk_context* pDuk);
 static int __CPP_ComponentProperty_set(duk_context* pDuk);
@@ -45,6 +46,93 @@ void ezTypeScriptBinding::SetupRttiPropertyBindings()
     });
 }
 
+void ezTypeScriptBinding::SetupRttiMarshalingInfos()
+{
+  if (!s_MarshalingInfos.IsEmpty())
+    return;
+
+  ezRTTI::ForEachDerivedType<ezMessage>(
+    [&](const ezRTTI* pRtti) {
+      CreateMarshalingInfo(pRtti, s_MarshalingInfos[pRtti]);
+    });
+}
+
+void ezTypeScriptBinding::CreateMarshalingInfo(const ezRTTI* pRtti, MarshalingInfo& out_info)
+{
+  using Conversion = MarshalingInfo::Conversion;
+
+  out_info.m_Properties.Clear();
+
+  ezHybridArray<ezAbstractProperty*, 32> properties;
+  pRtti->GetAllProperties(properties);
+
+  for (ezAbstractProperty* pProp : properties)
+  {
+    if (pProp->GetCategory() != ezPropertyCategory::Member)
+      continue;
+
+    ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
+    const ezRTTI* pType = pMember->GetSpecificType();
+
+    MarshalingInfo::Property prop;
+    prop.m_pMember = pMember;
+    prop.m_szName = pMember->GetPropertyName();
+    prop.m_bSyncToEz = !pMember->GetFlags().IsSet(ezPropertyFlags::ReadOnly);
+
+    if (pType->GetTypeFlags().IsAnySet(ezTypeFlags::IsEnum | ezTypeFlags::Bitflags))
+    {
+      prop.m_Conversion = Conversion::Variant;
+    }
+    else if (pType->GetVariantType() == ezVariant::Type::Invalid)
+    {
+      // only variants can be written back, everything else without a variant type isn't exposed to TypeScript
+      if (pType != ezGetStaticRTTI<ezVariant>())
+        continue;
+
+      prop.m_Conversion = Conversion::Variant;
+      prop.m_bSyncToTs = false;
+    }
+    else if (!pMember->GetFlags().IsSet(ezPropertyFlags::StandardType) || pMember->GetFlags().IsSet(ezPropertyFlags::Pointer))
+    {
+      prop.m_Conversion = Conversion::Variant;
+    }
+    else if (pType == ezGetStaticRTTI<bool>())
+      prop.m_Conversion = Conversion::Bool;
+    else if (pType == ezGetStaticRTTI<ezInt32>())
+      prop.m_Conversion = Conversion::Int32;
+    else if (pType == ezGetStaticRTTI<ezUInt32>())
+      prop.m_Conversion = Conversion::UInt32;
+    else if (pType == ezGetStaticRTTI<float>())
+      prop.m_Conversion = Conversion::Float;
+    else if (pType == ezGetStaticRTTI<double>())
+      prop.m_Conversion = Conversion::Double;
+    else if (pType == ezGetStaticRTTI<ezAngle>())
+      prop.m_Conversion = Conversion::Angle;
+    else if (pType == ezGetStaticRTTI<ezTime>())
+      prop.m_Conversion = Conversion::Time;
+    else if (pType == ezGetStaticRTTI<ezString>())
+      prop.m_Conversion = Conversion::String;
+    else if (pType == ezGetStaticRTTI<ezVec2>())
+      prop.m_Conversion = Conversion::Vec2;
+    else if (pType == ezGetStaticRTTI<ezVec3>())
+      prop.m_Conversion = Conversion::Vec3;
+    else if (pType == ezGetStaticRTTI<ezQuat>())
+      prop.m_Conversion = Conversion::Quat;
+    else if (pType == ezGetStaticRTTI<ezColor>())
+      prop.m_Conversion = Conversion::Color;
+    else if (pType == ezGetStaticRTTI<ezMat3>())
+      prop.m_Conversion = Conversion::Mat3;
+    else if (pType == ezGetStaticRTTI<ezMat4>())
+      prop.m_Conversion = Conversion::Mat4;
+    else if (pType == ezGetStaticRTTI<ezTransform>())
+      prop.m_Conversion = Conversion::Transform;
+    else
+      prop.m_Conversion = Conversion::Variant;
+
+    out_info.m_Properties.PushBack(prop);
+  }
+}
+
 void ezTypeScriptBinding::GeneratePropertiesCode(ezStringBuilder& out_Code, const ezRTTI* pRtti)
 {
   ezStringBuilder sProp;
@@ -91,8 +91,10 @@ ezResult ezTypeScriptBinding::Initialize(ezWorld& ref_world)
 
   SetupRttiFunctionBindings();
   SetupRttiPropertyBindings();
+  SetupRttiMarshalingInfos();
 
   EZ_SUCCEED_OR_RETURN(Init_RequireModules());
+  EZ_SUCCEED_OR_RETURN(Init_MathTypes());
   EZ_SUCCEED_OR_RETURN(Init_Log());
   EZ_SUCCEED_OR_RETURN(Init_Utils());
   EZ_SUCCEED_OR_RETURN(Init_Time());
@@ -164,6 +166,7 @@ ezResult ezTypeScriptBinding::LoadComponent(const ezUuid& typeGuid, TsComponentT
 
   m_TsComponentTypes[typeGuid].m_sComponentTypeName = sComponentName;
   RegisterMessageHandlersForComponentType(sComponentName, typeGuid);
+  CacheComponentFunctions(typeGuid);
 
   bLoaded = true;
 
@@ -191,6 +194,107 @@ void ezTypeScriptBinding::Update()
   ExecuteConsoleFuncs();
 }
 
+void ezTypeScriptBinding::CacheComponentFunctions(const ezUuid& typeGuid)
+{
+  static const char* s_szFunctionNames[ezTypeScriptComponentFunction::ENUM_COUNT] = {
+    "Initialize",
+    "Deinitialize",
+    "OnActivated",
+    "OnDeactivated",
+    "OnSimulationStarted",
+    "Tick",
+  };
+
+  TsComponentInfo& tsc = m_TsComponentTypes[typeGuid];
+
+  ezDuktapeHelper duk(m_Duk);
+
+  const ezStringBuilder sCompModule("__", tsc.m_sComponentTypeName);
+
+  duk.PushGlobalObject();                            // [ global ]
+  if (duk.PushLocalObject(sCompModule).Failed())     // [ global __CompModule ]
+  {
+    duk.PopStack(); // [ ]
+    EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+  }
+
+  if (duk.PushLocalObject(tsc.m_sComponentTypeName).Failed()) // [ global __CompModule class ]
+  {
+    duk.PopStack(2); // [ ]
+    EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+  }
+
+  // the functions are looked up on the prototype, so all instances of the class share them
+  duk_get_prop_string(duk, -1, "prototype"); // [ global __CompModule class proto ]
+
+  auto CacheFunction = [&](const char* szName) -> ezUInt32
+  {
+    ezUInt32 uiStashIdx = 0;
+
+    duk_get_prop_string(duk, -1, szName); // [ ... proto func/undef ]
+
+    if (duk_is_function(duk, -1))
+    {
+      uiStashIdx = AcquireStashObjIndex();
+      StoreReferenceInStash(duk, uiStashIdx); // [ ... proto func ]
+    }
+
+    duk.PopStack(); // [ ... proto ]
+    return uiStashIdx;
+  };
+
+  for (ezUInt32 i = 0; i < ezTypeScriptComponentFunction::ENUM_COUNT; ++i)
+  {
+    tsc.m_FunctionStashIdx[i] = CacheFunction(s_szFunctionNames[i]);
+  }
+
+  for (TsMessageHandler& mh : tsc.m_MessageHandlers)
+  {
+    mh.m_uiHandlerFuncStashIdx = CacheFunction(mh.m_sHandlerFunc);
+  }
+
+  duk.PopStack(4); // [ ]
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+}
+
+bool ezTypeScriptBinding::HasComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func) const
+{
+  return typeInfo.IsValid() && typeInfo.Value().m_FunctionStashIdx[func] != 0;
+}
+
+bool ezTypeScriptBinding::CallComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func, ezUInt32 uiComponentStashIdx)
+{
+  if (!DukPushComponentFunction(typeInfo, func)) // [ func ]
+    return false;
+
+  DukCallComponentFunction(uiComponentStashIdx); // [ func ]
+  m_Duk.PopStack();                              // [ ]
+
+  return true;
+}
+
+bool ezTypeScriptBinding::DukPushComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func)
+{
+  if (!HasComponentFunction(typeInfo, func))
+    return false;
+
+  DukPushStashObject(m_Duk, typeInfo.Value().m_FunctionStashIdx[func]); // [ func ]
+  return true;
+}
+
+void ezTypeScriptBinding::DukCallComponentFunction(ezUInt32 uiComponentStashIdx)
+{
+  ezDuktapeHelper duk(m_Duk); // [ func ]
+
+  duk_dup(duk, -1);                             // [ func func ]
+  DukPushStashObject(duk, uiComponentStashIdx); // [ func func comp ]
+  duk.CallPreparedMethod().IgnoreResult();      // [ func result ]
+  duk.PopStack();                               // [ func ]
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
+}
+
 void ezTypeScriptBinding::CleanupStash(ezUInt32 uiNumIterations)
 {
   if (!m_LastCleanupObj.IsValid())
@@ -297,56 +401,302 @@ bool ezTypeScriptBinding::DukPushStashObject(duk_context* pDuk, ezUInt32 uiStash
 
 void ezTypeScriptBinding::SyncTsObjectEzTsObject(duk_context* pDuk, const ezRTTI* pRtti, void* pObject, ezInt32 iObjIdx)
 {
-  ezHybridArray<ezAbstractProperty*, 32> properties;
-  pRtti->GetAllProperties(properties);
+  ezDuktapeHelper duk(pDuk);
 
-  for (ezAbstractProperty* pProp : properties)
+  MarshalingInfo tmpInfo;
+  const MarshalingInfo* pInfo = s_MarshalingInfos.GetValue(pRtti);
+  if (pInfo == nullptr)
   {
-    if (pProp->GetCategory() != ezPropertyCategory::Member)
+    // types that got registered after the binding was set up
+    CreateMarshalingInfo(pRtti, tmpInfo);
+    pInfo = &tmpInfo;
+  }
+
+  for (const MarshalingInfo::Property& prop : pInfo->m_Properties)
+  {
+    if (!prop.m_bSyncToEz)
       continue;
 
-    ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
+    if (!duk_get_prop_string(duk, iObjIdx, prop.m_szName)) // [ undef ]
+    {
+      duk_pop(duk); // [ ]
+      continue;
+    }
 
-    const ezVariant value = ezTypeScriptBinding::GetVariantProperty(pDuk, pProp->GetPropertyName(), iObjIdx, pMember->GetSpecificType());
+    // [ value ]
 
-    if (value.IsValid())
+    switch (prop.m_Conversion)
     {
-      ezReflectionUtils::SetMemberPropertyValue(pMember, pObject, value);
+      case MarshalingInfo::Conversion::Variant:
+      {
+        const ezVariant value = GetVariant(pDuk, -1, prop.m_pMember->GetSpecificType());
+
+        if (value.IsValid())
+        {
+          ezReflectionUtils::SetMemberPropertyValue(prop.m_pMember, pObject, value);
+        }
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Bool:
+      {
+        const bool value = duk.GetBoolValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Int32:
+      {
+        const ezInt32 value = duk.GetIntValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::UInt32:
+      {
+        const ezUInt32 value = duk.GetUIntValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Float:
+      {
+        const float value = duk.GetFloatValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Double:
+      {
+        const double value = duk.GetNumberValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Angle:
+      {
+        const ezAngle value = ezAngle::MakeFromRadian(duk.GetFloatValue(-1));
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Time:
+      {
+        const ezTime value = ezTime::MakeFromSeconds(duk.GetFloatValue(-1));
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::String:
+      {
+        const ezString value = duk.GetStringValue(-1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Vec2:
+      {
+        const ezVec2 value = GetVec2(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Vec3:
+      {
+        const ezVec3 value = GetVec3(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Quat:
+      {
+        const ezQuat value = GetQuat(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Color:
+      {
+        const ezColor value = GetColor(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Mat3:
+      {
+        const ezMat3 value = GetMat3(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Mat4:
+      {
+        const ezMat4 value = GetMat4(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Transform:
+      {
+        const ezTransform value = GetTransform(pDuk, -1);
+        prop.m_pMember->SetValuePtr(pObject, &value);
+        break;
+      }
     }
+
+    duk_pop(duk); // [ ]
   }
+
+  EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
 }
 
 void ezTypeScriptBinding::SyncEzObjectToTsObject(duk_context* pDuk, const ezRTTI* pRtti, const void* pObject, ezInt32 iObjIdx)
 {
   ezDuktapeHelper duk(pDuk);
 
-  ezHybridArray<ezAbstractProperty*, 32> properties;
-  pRtti->GetAllProperties(properties);
+  MarshalingInfo tmpInfo;
+  const MarshalingInfo* pInfo = s_MarshalingInfos.GetValue(pRtti);
+  if (pInfo == nullptr)
+  {
+    // types that got registered after the binding was set up
+    CreateMarshalingInfo(pRtti, tmpInfo);
+    pInfo = &tmpInfo;
+  }
 
-  for (ezAbstractProperty* pProp : properties)
+  for (const MarshalingInfo::Property& prop : pInfo->m_Properties)
   {
-    if (pProp->GetCategory() != ezPropertyCategory::Member)
+    if (!prop.m_bSyncToTs)
       continue;
 
-    ezAbstractMemberProperty* pMember = static_cast<ezAbstractMemberProperty*>(pProp);
-
-    const ezRTTI* pType = pMember->GetSpecificType();
-
-    if (pType->GetTypeFlags().IsAnySet(ezTypeFlags::IsEnum | ezTypeFlags::Bitflags))
+    switch (prop.m_Conversion)
     {
-      const ezVariant val = ezReflectionUtils::GetMemberPropertyValue(pMember, pObject);
-
-      SetVariantProperty(duk, pMember->GetPropertyName(), -1, val);
+      case MarshalingInfo::Conversion::Variant:
+        PushVariant(pDuk, ezReflectionUtils::GetMemberPropertyValue(prop.m_pMember, pObject));
+        break;
+
+      case MarshalingInfo::Conversion::Bool:
+      {
+        bool value = false;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushBool(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Int32:
+      {
+        ezInt32 value = 0;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushInt(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::UInt32:
+      {
+        ezUInt32 value = 0;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushUInt(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Float:
+      {
+        float value = 0.0f;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushNumber(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Double:
+      {
+        double value = 0.0;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushNumber(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Angle:
+      {
+        ezAngle value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushNumber(value.GetRadian());
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Time:
+      {
+        ezTime value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushNumber(value.GetSeconds());
+        break;
+      }
+
+      case MarshalingInfo::Conversion::String:
+      {
+        ezString value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        duk.PushString(value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Vec2:
+      {
+        ezVec2 value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushVec2(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Vec3:
+      {
+        ezVec3 value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushVec3(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Quat:
+      {
+        ezQuat value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushQuat(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Color:
+      {
+        ezColor value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushColor(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Mat3:
+      {
+        ezMat3 value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushMat3(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Mat4:
+      {
+        ezMat4 value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushMat4(pDuk, value);
+        break;
+      }
+
+      case MarshalingInfo::Conversion::Transform:
+      {
+        ezTransform value;
+        prop.m_pMember->GetValuePtr(pObject, &value);
+        PushTransform(pDuk, value);
+        break;
+      }
     }
-    else
-    {
-      if (pType->GetVariantType() == ezVariant::Type::Invalid)
-        continue;
 
-      const ezVariant val = ezReflectionUtils::GetMemberPropertyValue(pMember, pObject);
-
-      SetVariantProperty(duk, pMember->GetPropertyName(), -1, val);
-    }
+    // [ value ]
+    duk.SetCustomProperty(prop.m_szName, iObjIdx); // [ ]
   }
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, 0);
@@ -26,6 +26,24 @@ enum ezTypeScriptBindingIndexProperty
   GameObjectHandle
 };
 
+/// \brief The functions of a TypeScript component that are called from C++.
+///
+/// The function objects are looked up once per component type and kept in the DukTape stash, instead of looking them up by name for every call.
+struct ezTypeScriptComponentFunction
+{
+  enum Enum
+  {
+    Initialize,
+    Deinitialize,
+    OnActivated,
+    OnDeactivated,
+    OnSimulationStarted,
+    Tick,
+
+    ENUM_COUNT
+  };
+};
+
 class EZ_TYPESCRIPTPLUGIN_DLL ezTypeScriptBinding
 {
 public:
@@ -33,6 +51,7 @@ public:
   {
     const ezRTTI* m_pMessageType = nullptr;
     ezUInt32 m_uiMessageTypeNameHash = 0;
+    ezUInt32 m_uiHandlerFuncStashIdx = 0; ///< 0, if the handler function could not be found on the component class
     ezString m_sHandlerFunc;
   };
 
@@ -40,6 +59,7 @@ public:
   {
     ezString m_sComponentTypeName;
     ezHybridArray<TsMessageHandler, 4> m_MessageHandlers;
+    ezUInt32 m_FunctionStashIdx[ezTypeScriptComponentFunction::ENUM_COUNT] = {}; ///< 0, if the component class does not implement the function
   };
 
   using TsComponentTypeInfo = ezMap<ezUuid, TsComponentInfo>::ConstIterator;
@@ -63,8 +83,23 @@ public:
 
   void Update();
 
+  /// \brief Returns whether the component class implements the given function.
+  bool HasComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func) const;
+
+  /// \brief Calls the given function on the component that was registered at uiComponentStashIdx. Returns false, if the class does not implement the function.
+  bool CallComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func, ezUInt32 uiComponentStashIdx);
+
+  /// \brief Pushes the cached function object onto the DukTape stack, so that it can be called on many components of the same type with DukCallComponentFunction().
+  ///
+  /// Returns false and pushes nothing, if the component class does not implement the function.
+  bool DukPushComponentFunction(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponentFunction::Enum func);
+
+  /// \brief Calls the function on top of the DukTape stack on the component that was registered at uiComponentStashIdx. The function stays on the stack.
+  void DukCallComponentFunction(ezUInt32 uiComponentStashIdx);
+
 private:
   static void GetTsName(const ezRTTI* pRtti, ezStringBuilder& out_sName);
+  void CacheComponentFunctions(const ezUuid& typeGuid);
 
   ezDuktapeContext m_Duk;
   bool m_bInitialized = false;
@@ -138,6 +173,48 @@ private:
 
   static ezHashTable<ezUInt32, PropertyBinding> s_BoundProperties;
 
+  /// \brief The member properties of a reflected type that are synchronized with TypeScript objects, together with how to convert each of them.
+  ///
+  /// Created once for all message types, so that synchronizing messages doesn't need to walk the reflection data and go through ezVariant every time.
+  struct MarshalingInfo
+  {
+    enum class Conversion : ezUInt8
+    {
+      Variant, ///< Goes through ezVariant and ezReflectionUtils, used for all types without a direct conversion.
+      Bool,
+      Int32,
+      UInt32,
+      Float,
+      Double,
+      Angle,
+      Time,
+      String,
+      Vec2,
+      Vec3,
+      Quat,
+      Color,
+      Mat3,
+      Mat4,
+      Transform,
+    };
+
+    struct Property
+    {
+      ezAbstractMemberProperty* m_pMember = nullptr;
+      const char* m_szName = nullptr;
+      Conversion m_Conversion = Conversion::Variant;
+      bool m_bSyncToTs = true;
+      bool m_bSyncToEz = true;
+    };
+
+    ezHybridArray<Property, 8> m_Properties;
+  };
+
+  static void SetupRttiMarshalingInfos();
+  static void CreateMarshalingInfo(const ezRTTI* pRtti, MarshalingInfo& out_info);
+
+  static ezHashTable<const ezRTTI*, MarshalingInfo> s_MarshalingInfos;
+
   ///@}
   /// \name Message Binding
   ///@{
@@ -151,6 +228,9 @@ public:
   bool DeliverTsMessage(const TsComponentTypeInfo& typeInfo, ezTypeScriptComponent* pComponent, const ezMsgTypeScriptMsgProxy& msg);
 
 private:
+  /// \brief Expects the component on top of the stack and prepares the call of the message handler function with the component as 'this'.
+  ezResult PrepareMessageHandlerCall(ezDuktapeHelper& ref_duk, const TsMessageHandler& mh);
+
   static void GenerateMessagesFile(const char* szFile);
   static void GenerateAllMessagesCode(ezStringBuilder& out_Code);
   static void GenerateMessageCode(ezStringBuilder& out_Code, const ezRTTI* pRtti);
@@ -159,6 +239,7 @@ private:
   ezInt32 m_iMsgDeliveryRecursion = 0;
   ezUuid m_CurrentTsMsgHandlerRegistrator;
   ezMap<ezUuid, TsComponentInfo> m_TsComponentTypes;
+  ezHashTable<const ezRTTI*, ezUInt32> m_MessageConstructorStashIdx;
 
 
   ///@}
@@ -172,6 +253,7 @@ private:
   ///@{
 private:
   ezResult Init_RequireModules();
+  ezResult Init_MathTypes();
   ezResult Init_Log();
   ezResult Init_Utils();
   ezResult Init_Time();
@@ -322,6 +404,20 @@ private:
   static void StoreReferenceInStash(duk_context* pDuk, ezUInt32 uiStashIdx);
   static bool DukPushStashObject(duk_context* pDuk, ezUInt32 uiStashIdx);
 
+  /// \brief Fixed stash indices for the constructors of the math types, see Init_MathTypes().
+  enum StashMathTypeIdx : ezUInt32
+  {
+    c_uiStashVec2Idx = 1,
+    c_uiStashVec3Idx,
+    c_uiStashQuatIdx,
+    c_uiStashMat3Idx,
+    c_uiStashMat4Idx,
+    c_uiStashColorIdx,
+    c_uiStashTransformIdx,
+  };
+
+  static void DukPushMathTypeConstructor(duk_context* pDuk, StashMathTypeIdx idx);
+
   static constexpr ezUInt32 c_uiMaxMsgStash = 512;
   static constexpr ezUInt32 c_uiFirstStashMsgIdx = 512;
   static constexpr ezUInt32 c_uiLastStashMsgIdx = c_uiFirstStashMsgIdx + c_uiFirstStashMsgIdx;
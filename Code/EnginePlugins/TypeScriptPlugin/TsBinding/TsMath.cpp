@@ -3,20 +3,63 @@
 #include <Duktape/duktape.h>
 #include <TypeScriptPlugin/TsBinding/TsBinding.h>
 
+ezResult ezTypeScriptBinding::Init_MathTypes()
+{
+  struct MathType
+  {
+    StashMathTypeIdx m_StashIdx;
+    const char* m_szModule;
+    const char* m_szType;
+  };
+
+  const MathType types[] = {
+    {c_uiStashVec2Idx, "__Vec2", "Vec2"},
+    {c_uiStashVec3Idx, "__Vec3", "Vec3"},
+    {c_uiStashQuatIdx, "__Quat", "Quat"},
+    {c_uiStashMat3Idx, "__Mat3", "Mat3"},
+    {c_uiStashMat4Idx, "__Mat4", "Mat4"},
+    {c_uiStashColorIdx, "__Color", "Color"},
+    {c_uiStashTransformIdx, "__Transform", "Transform"},
+  };
+
+  ezDuktapeHelper duk(m_Duk);
+
+  duk.PushGlobalObject(); // [ global ]
+
+  for (const MathType& type : types)
+  {
+    if (duk.PushLocalObject(type.m_szModule).Failed()) // [ global module ]
+    {
+      ezLog::Error("Math type module '{}' has not been loaded.", type.m_szModule);
+      duk.PopStack(); // [ ]
+      EZ_DUK_RETURN_AND_VERIFY_STACK(duk, EZ_FAILURE, 0);
+    }
+
+    duk_get_prop_string(duk, -1, type.m_szType); // [ global module ctor ]
+    StoreReferenceInStash(duk, type.m_StashIdx); // [ global module ctor ]
+    duk.PopStack(2);                             // [ global ]
+  }
+
+  duk.PopStack(); // [ ]
+
+  EZ_DUK_RETURN_AND_VERIFY_STACK(duk, EZ_SUCCESS, 0);
+}
+
+void ezTypeScriptBinding::DukPushMathTypeConstructor(duk_context* pDuk, StashMathTypeIdx idx)
+{
+  EZ_VERIFY(DukPushStashObject(pDuk, idx), "Math types have not been initialized."); // [ ctor ]
+}
+
 //////////////////////////////////////////////////////////////////////////
 
 void ezTypeScriptBinding::PushVec2(duk_context* pDuk, const ezVec2& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Vec2").Succeeded(), ""); // [ global __Vec2 ]
-  duk_get_prop_string(duk, -1, "Vec2");                     // [ global __Vec2 Vec2 ]
-  duk_push_number(duk, value.x);                            // [ global __Vec2 Vec2 x ]
-  duk_push_number(duk, value.y);                            // [ global __Vec2 Vec2 x y ]
-  duk_new(duk, 2);                                          // [ global __Vec2 result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  DukPushMathTypeConstructor(duk, c_uiStashVec2Idx); // [ Vec2 ]
+  duk_push_number(duk, value.x);                     // [ Vec2 x ]
+  duk_push_number(duk, value.y);                     // [ Vec2 x y ]
+  duk_new(duk, 2);                                   // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -80,15 +123,11 @@ void ezTypeScriptBinding::PushVec3(duk_context* pDuk, const ezVec3& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Vec3").Succeeded(), ""); // [ global __Vec3 ]
-  duk_get_prop_string(duk, -1, "Vec3");                     // [ global __Vec3 Vec3 ]
-  duk_push_number(duk, value.x);                            // [ global __Vec3 Vec3 x ]
-  duk_push_number(duk, value.y);                            // [ global __Vec3 Vec3 x y ]
-  duk_push_number(duk, value.z);                            // [ global __Vec3 Vec3 x y z ]
-  duk_new(duk, 3);                                          // [ global __Vec3 result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  DukPushMathTypeConstructor(duk, c_uiStashVec3Idx); // [ Vec3 ]
+  duk_push_number(duk, value.x);                     // [ Vec3 x ]
+  duk_push_number(duk, value.y);                     // [ Vec3 x y ]
+  duk_push_number(duk, value.z);                     // [ Vec3 x y z ]
+  duk_new(duk, 3);                                   // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -155,21 +194,17 @@ void ezTypeScriptBinding::PushMat3(duk_context* pDuk, const ezMat3& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Mat3").Succeeded(), ""); // [ global __Mat3 ]
-  duk_get_prop_string(duk, -1, "Mat3");                     // [ global __Mat3 Mat3 ]
+  DukPushMathTypeConstructor(duk, c_uiStashMat3Idx); // [ Mat3 ]
 
   float rm[9];
   value.GetAsArray(rm, ezMatrixLayout::RowMajor);
 
   for (ezUInt32 i = 0; i < 9; ++i)
   {
-    duk_push_number(duk, rm[i]); // [ global __Mat3 Mat3 9params ]
+    duk_push_number(duk, rm[i]); // [ Mat3 9params ]
   }
 
-  duk_new(duk, 9);     // [ global __Mat3 result ]
-  duk_remove(duk, -2); // [ global result ]
-  duk_remove(duk, -2); // [ result ]
+  duk_new(duk, 9); // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -252,21 +287,17 @@ void ezTypeScriptBinding::PushMat4(duk_context* pDuk, const ezMat4& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Mat4").Succeeded(), ""); // [ global __Mat4 ]
-  duk_get_prop_string(duk, -1, "Mat4");                     // [ global __Mat4 Mat4 ]
+  DukPushMathTypeConstructor(duk, c_uiStashMat4Idx); // [ Mat4 ]
 
   float rm[16];
   value.GetAsArray(rm, ezMatrixLayout::RowMajor);
 
   for (ezUInt32 i = 0; i < 16; ++i)
   {
-    duk_push_number(duk, rm[i]); // [ global __Mat4 Mat4 16params ]
+    duk_push_number(duk, rm[i]); // [ Mat4 16params ]
   }
 
-  duk_new(duk, 16);    // [ global __Mat4 result ]
-  duk_remove(duk, -2); // [ global result ]
-  duk_remove(duk, -2); // [ result ]
+  duk_new(duk, 16); // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -363,16 +394,12 @@ void ezTypeScriptBinding::PushQuat(duk_context* pDuk, const ezQuat& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                   // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Quat").Succeeded(), ""); // [ global __Quat ]
-  duk_get_prop_string(duk, -1, "Quat");                     // [ global __Quat Quat ]
-  duk_push_number(duk, value.x);                            // [ global __Quat Quat x ]
-  duk_push_number(duk, value.y);                            // [ global __Quat Quat x y ]
-  duk_push_number(duk, value.z);                            // [ global __Quat Quat x y z ]
-  duk_push_number(duk, value.w);                            // [ global __Quat Quat x y z w ]
-  duk_new(duk, 4);                                          // [ global __Quat result ]
-  duk_remove(duk, -2);                                      // [ global result ]
-  duk_remove(duk, -2);                                      // [ result ]
+  DukPushMathTypeConstructor(duk, c_uiStashQuatIdx); // [ Quat ]
+  duk_push_number(duk, value.x);                     // [ Quat x ]
+  duk_push_number(duk, value.y);                     // [ Quat x y ]
+  duk_push_number(duk, value.z);                     // [ Quat x y z ]
+  duk_push_number(duk, value.w);                     // [ Quat x y z w ]
+  duk_new(duk, 4);                                   // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -442,16 +469,12 @@ void ezTypeScriptBinding::PushColor(duk_context* pDuk, const ezColor& value)
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                    // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Color").Succeeded(), ""); // [ global __Color ]
-  duk_get_prop_string(duk, -1, "Color");                     // [ global __Color Color ]
-  duk_push_number(duk, value.r);                             // [ global __Color Color r ]
-  duk_push_number(duk, value.g);                             // [ global __Color Color r g ]
-  duk_push_number(duk, value.b);                             // [ global __Color Color r g b ]
-  duk_push_number(duk, value.a);                             // [ global __Color Color r g b a ]
-  duk_new(duk, 4);                                           // [ global __Color result ]
-  duk_remove(duk, -2);                                       // [ global result ]
-  duk_remove(duk, -2);                                       // [ result ]
+  DukPushMathTypeConstructor(duk, c_uiStashColorIdx); // [ Color ]
+  duk_push_number(duk, value.r);                      // [ Color r ]
+  duk_push_number(duk, value.g);                      // [ Color r g ]
+  duk_push_number(duk, value.b);                      // [ Color r g b ]
+  duk_push_number(duk, value.a);                      // [ Color r g b a ]
+  duk_new(duk, 4);                                    // [ result ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -513,15 +536,11 @@ void ezTypeScriptBinding::PushTransform(duk_context* pDuk, const ezTransform& va
 {
   ezDuktapeHelper duk(pDuk);
 
-  duk.PushGlobalObject();                                        // [ global ]
-  EZ_VERIFY(duk.PushLocalObject("__Transform").Succeeded(), ""); // [ global __Transform ]
-  duk_get_prop_string(duk, -1, "Transform");                     // [ global __Transform Transform ]
-  duk_new(duk, 0);                                               // [ global __Transform object ]
-  SetVec3Property(pDuk, "position", -1, value.m_vPosition);      // [ global __Transform object ]
-  SetQuatProperty(pDuk, "rotation", -1, value.m_qRotation);      // [ global __Transform object ]
-  SetVec3Property(pDuk, "scale", -1, value.m_vScale);            // [ global __Transform object ]
-  duk_remove(duk, -2);                                           // [ global object ]
-  duk_remove(duk, -2);                                           // [ object ]
+  DukPushMathTypeConstructor(duk, c_uiStashTransformIdx);   // [ Transform ]
+  duk_new(duk, 0);                                          // [ object ]
+  SetVec3Property(pDuk, "position", -1, value.m_vPosition); // [ object ]
+  SetQuatProperty(pDuk, "rotation", -1, value.m_qRotation); // [ object ]
+  SetVec3Property(pDuk, "scale", -1, value.m_vScale);       // [ object ]
 
   EZ_DUK_RETURN_VOID_AND_VERIFY_STACK(duk, +1);
 }
@@ -252,15 +252,28 @@ void ezTypeScriptBinding::DukPutMessage(duk_context* pDuk, const ezMessage& msg)
   ezDuktapeHelper duk(pDuk);
 
   const ezRTTI* pRtti = msg.GetDynamicRTTI();
-  ezStringBuilder sMsgName = pRtti->GetTypeName();
-  sMsgName.TrimWordStart("ez");
 
-  duk.PushGlobalObject();                              // [ global ]
-  duk.PushLocalObject("__AllMessages").IgnoreResult(); // [ global __AllMessages ]
-  duk_get_prop_string(duk, -1, sMsgName.GetData());    // [ global __AllMessages msgname ]
-  duk_new(duk, 0);                                     // [ global __AllMessages msg ]
-  duk_remove(duk, -2);                                 // [ global msg ]
-  duk_remove(duk, -2);                                 // [ msg ]
+  ezTypeScriptBinding* pBinding = RetrieveBinding(pDuk);
+
+  ezUInt32 uiCtorStashIdx = 0;
+  if (!pBinding->m_MessageConstructorStashIdx.TryGetValue(pRtti, uiCtorStashIdx))
+  {
+    ezStringBuilder sMsgName = pRtti->GetTypeName();
+    sMsgName.TrimWordStart("ez");
+
+    duk.PushGlobalObject();                              // [ global ]
+    duk.PushLocalObject("__AllMessages").IgnoreResult(); // [ global __AllMessages ]
+    duk_get_prop_string(duk, -1, sMsgName.GetData());    // [ global __AllMessages msgname ]
+
+    uiCtorStashIdx = pBinding->AcquireStashObjIndex();
+    StoreReferenceInStash(duk, uiCtorStashIdx); // [ global __AllMessages msgname ]
+    duk.PopStack(3);                            // [ ]
+
+    pBinding->m_MessageConstructorStashIdx.Insert(pRtti, uiCtorStashIdx);
+  }
+
+  DukPushStashObject(duk, uiCtorStashIdx); // [ msgname ]
+  duk_new(duk, 0);                         // [ msg ]
 
   SyncEzObjectToTsObject(pDuk, pRtti, &msg, -1);
 
@@ -329,6 +342,19 @@ int ezTypeScriptBinding::__CPP_Binding_RegisterMessageHandler(duk_context* pDuk)
   EZ_DUK_RETURN_AND_VERIFY_STACK(duk, duk.ReturnVoid(), 0);
 }
 
+ezResult ezTypeScriptBinding::PrepareMessageHandlerCall(ezDuktapeHelper& ref_duk, const TsMessageHandler& mh)
+{
+  if (mh.m_uiHandlerFuncStashIdx == 0)
+  {
+    // fall back to looking up the function by name, this logs an error if it doesn't exist
+    return ref_duk.PrepareMethodCall(mh.m_sHandlerFunc); // [ comp func comp ]
+  }
+
+  DukPushStashObject(ref_duk, mh.m_uiHandlerFuncStashIdx); // [ comp func ]
+  duk_dup(ref_duk, -2);                                     // [ comp func comp ]
+  return EZ_SUCCESS;
+}
+
 bool ezTypeScriptBinding::HasMessageHandler(const TsComponentTypeInfo& typeInfo, const ezRTTI* pMsgRtti) const
 {
   if (!typeInfo.IsValid())
@@ -370,7 +396,7 @@ bool ezTypeScriptBinding::DeliverMessage(const TsComponentTypeInfo& typeInfo, ez
 
       DukPutComponentObject(pComponent); // [ comp ]
 
-      if (duk.PrepareMethodCall(mh.m_sHandlerFunc).Succeeded()) // [ comp func comp ]
+      if (PrepareMessageHandlerCall(duk, mh).Succeeded()) // [ comp func comp ]
       {
         ezTypeScriptBinding::DukPutMessage(duk, ref_msg); // [ comp func comp msg ]
 
@@ -434,7 +460,7 @@ bool ezTypeScriptBinding::DeliverTsMessage(const TsComponentTypeInfo& typeInfo,
 
       DukPutComponentObject(pComponent); // [ comp ]
 
-      if (duk.PrepareMethodCall(mh.m_sHandlerFunc).Succeeded()) // [ comp func comp ]
+      if (PrepareMessageHandlerCall(duk, mh).Succeeded()) // [ comp func comp ]
       {
         DukPushStashObject(duk, msg.m_uiStashIndex); // [ comp func comp msg ]
         duk.PushCustom();                            // [ comp func comp msg ]
@@ -36,6 +36,17 @@
     Example:
       -pack "path/to/folder" "path/to/another/folder"
 
+-seekable <bool> = false
+    Stores compressed files as independently compressed frames with a seek table.
+
+    Such files can be read at any position without decompressing everything in front of it,
+    and large files are decompressed in parallel.
+
+-dictionary <int> = 0
+    Size of a zstd dictionary in KB, that is trained from the small files and shared by all of them.
+
+    Small files compress much better with a shared dictionary. Only has an effect together with -seekable.
+
 Description:
     -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)
     or to unpack multiple archives at the same time.
@@ -56,6 +67,9 @@ Examples:
 
     ArchiveTool.exe "C:/Stuff.ezArchive" -out "C:/MyStuff"
       Unpacks all data from the archive into "C:/MyStuff"
+
+    ArchiveTool.exe -pack "C:/Stuff" -seekable -dictionary 112
+      Packs all data in "C:/Stuff" into seekable entries, small files share a 112 KB dictionary
 */
 
 ezCommandLineOptionPath opt_Out("_ArchiveTool", "-out", "\
@@ -85,6 +99,21 @@ Example:\n\
 ",
   "");
 
+ezCommandLineOptionBool opt_Seekable("_ArchiveTool", "-seekable", "\
+Stores compressed files as independently compressed frames with a seek table.\n\
+\n\
+Such files can be read at any position without decompressing everything in front of it,\n\
+and large files are decompressed in parallel.\n\
+",
+  false);
+
+ezCommandLineOptionInt opt_Dictionary("_ArchiveTool", "-dictionary", "\
+Size of a zstd dictionary in KB, that is trained from the small files and shared by all of them.\n\
+\n\
+Small files compress much better with a shared dictionary. Only has an effect together with -seekable.\n\
+",
+  0, 0, 1024);
+
 ezCommandLineOptionDoc opt_Desc("_ArchiveTool", "Description:", "", "\
 -pack and -unpack can take multiple inputs to either aggregate multiple folders into one archive (pack)\n\
 or to unpack multiple archives at the same time.\n\
@@ -107,6 +136,9 @@ ArchiveTool.exe \"C:/Stuff.ezArchive\"\n\
 \n\
 ArchiveTool.exe \"C:/Stuff.ezArchive\" -out \"C:/MyStuff\"\n\
   Unpacks all data from the archive into \"C:/MyStuff\"\n\
+\n\
+ArchiveTool.exe -pack \"C:/Stuff\" -seekable -dictionary 112\n\
+  Packs all data in \"C:/Stuff\" into seekable entries, small files share a 112 KB dictionary\n\
 ",
   "");
 
@@ -227,7 +259,8 @@ public:
       {
         const ezStringView sArg = GetArgument(a);
 
-        if (sArg.IsEqual_NoCase("-out"))
+        // all options follow the inputs
+        if (sArg.StartsWith("-"))
           break;
 
         m_sInputs.PushBack(ezOSFile::MakePathAbsoluteWithCWD(sArg));
@@ -308,9 +341,16 @@ public:
   {
     ezArchiveBuilderImpl archive;
 
+    const ezArchiveCompressionMode compression = opt_Seekable.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified) ? ezArchiveCompressionMode::Compressed_zstd_seekable : ezArchiveCompressionMode::Compressed_zstd;
+
+    if (compression == ezArchiveCompressionMode::Compressed_zstd_seekable)
+    {
+      archive.m_uiZstdDictionarySize = static_cast<ezUInt32>(opt_Dictionary.GetOptionValue(ezCommandLineOption::LogMode::AlwaysIfSpecified)) * 1024;
+    }
+
     for (const auto& folder : m_sInputs)
     {
-      archive.AddFolder(folder, ezArchiveCompressionMode::Compressed_zstd, PackFileCallback);
+      archive.AddFolder(folder, compression, PackFileCallback);
     }
 
     if (m_sOutput.IsEmpty())
@@ -1,6 +1,7 @@
 #include <Fileserve/FileservePCH.h>
 
 #include <Fileserve/Fileserve.h>
+#include <FileservePlugin/Client/FileserveClient.h>
 #include <FileservePlugin/Fileserver/Fileserver.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
@@ -17,6 +18,9 @@ void ezFileserverApp::AfterCoreSystemsStartup()
   // Add the empty data directory to access files via absolute paths
   ezFileSystem::AddDataDirectory("", "App", ":", ezFileSystem::AllowWrites).IgnoreResult();
 
+  // the files that are served must not be redirected through fileserve again
+  ezFileserveClient::DisabledFileserveClient();
+
   EZ_DEFAULT_NEW(ezFileserver);
 
   ezFileserver::GetSingleton()->m_Events.AddEventHandler(ezMakeDelegate(&ezFileserverApp::FileserverEventHandler, this));
@@ -0,0 +1,206 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/Utils/Blackboard.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  struct EventRecorder
+  {
+    void OnEntryEvent(const ezBlackboard::EntryEvent& e)
+    {
+      m_Names.PushBack(e.m_sName);
+      m_OldValues.PushBack(e.m_OldValue);
+      m_NewValues.PushBack(e.m_pEntry->m_Value);
+    }
+
+    ezDynamicArray<ezHashedString> m_Names;
+    ezDynamicArray<ezVariant> m_OldValues;
+    ezDynamicArray<ezVariant> m_NewValues;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Utils, Blackboard)
+{
+  const ezHashedString sBool = ezMakeHashedString("Bool");
+  const ezHashedString sInt = ezMakeHashedString("Int");
+  const ezHashedString sFloat = ezMakeHashedString("Float");
+  const ezHashedString sVec3 = ezMakeHashedString("Vec3");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Slots match the name-based API")
+  {
+    ezSharedPtr<ezBlackboard> pBoard = ezBlackboard::Create();
+    pBoard->RegisterEntry(sBool, true);
+    pBoard->RegisterEntry(sInt, 3);
+    pBoard->RegisterEntry(sFloat, 1.5f);
+
+    const ezBlackboardSlot boolSlot = pBoard->ResolveSlot(sBool);
+    const ezBlackboardSlot intSlot = pBoard->ResolveSlot(sInt);
+    const ezBlackboardSlot floatSlot = pBoard->ResolveSlot(sFloat);
+
+    EZ_TEST_INT(pBoard->ResolveSlot(sInt).m_uiIndex, intSlot.m_uiIndex);
+
+    EZ_TEST_BOOL(pBoard->GetSlotValue<bool>(boolSlot));
+    EZ_TEST_INT(pBoard->GetSlotValue<ezInt32>(intSlot), 3);
+    EZ_TEST_FLOAT(pBoard->GetSlotValue<float>(floatSlot), 1.5f, 0.0f);
+
+    // conversion
+    EZ_TEST_FLOAT(pBoard->GetSlotValue<float>(intSlot), 3.0f, 0.0f);
+
+    EZ_TEST_BOOL(pBoard->SetSlotValue(intSlot, 7).Succeeded());
+    EZ_TEST_INT(pBoard->GetEntryValue(sInt).Get<ezInt32>(), 7);
+    EZ_TEST_INT(pBoard->GetSlotEntry(intSlot)->m_uiChangeCounter, 1);
+
+    EZ_TEST_BOOL(pBoard->SetEntryValue(sFloat, 2.5f).Succeeded());
+    EZ_TEST_FLOAT(pBoard->GetSlotValue<float>(floatSlot), 2.5f, 0.0f);
+
+    // setting a value of a different type changes the type of the entry
+    EZ_TEST_BOOL(pBoard->SetSlotValue(floatSlot, ezVec3(1, 2, 3)).Succeeded());
+    EZ_TEST_VEC3(pBoard->GetEntryValue(sFloat).Get<ezVec3>(), ezVec3(1, 2, 3), 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Slots survive registration changes")
+  {
+    ezSharedPtr<ezBlackboard> pBoard = ezBlackboard::Create();
+
+    // resolved before the entry exists
+    const ezBlackboardSlot vecSlot = pBoard->ResolveSlot(sVec3);
+    EZ_TEST_BOOL(vecSlot.IsValid());
+    EZ_TEST_BOOL(pBoard->GetSlotEntry(vecSlot) == nullptr);
+    EZ_TEST_BOOL(pBoard->SetSlotValue(vecSlot, ezVec3(1, 0, 0)).Failed());
+    EZ_TEST_VEC3(pBoard->GetSlotValue(vecSlot, ezVec3(0, 0, 1)), ezVec3(0, 0, 1), 0.0f);
+
+    pBoard->RegisterEntry(sVec3, ezVec3(0, 1, 0));
+    EZ_TEST_VEC3(pBoard->GetSlotValue<ezVec3>(vecSlot), ezVec3(0, 1, 0), 0.0f);
+
+    // adding many entries rehashes the entry table
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      ezStringBuilder sName;
+      sName.Format("Entry{}", i);
+
+      ezHashedString sNameHashed;
+      sNameHashed.Assign(sName);
+      pBoard->RegisterEntry(sNameHashed, i);
+    }
+
+    EZ_TEST_VEC3(pBoard->GetSlotValue<ezVec3>(vecSlot), ezVec3(0, 1, 0), 0.0f);
+
+    pBoard->UnregisterEntry(sVec3);
+    EZ_TEST_BOOL(pBoard->GetSlotEntry(vecSlot) == nullptr);
+
+    pBoard->RegisterEntry(sVec3, ezVec3(0, 0, 2));
+    EZ_TEST_VEC3(pBoard->GetSlotValue<ezVec3>(vecSlot), ezVec3(0, 0, 2), 0.0f);
+
+    pBoard->UnregisterAllEntries();
+    EZ_TEST_BOOL(pBoard->GetSlotEntry(vecSlot) == nullptr);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched change events")
+  {
+    ezSharedPtr<ezBlackboard> pBoard = ezBlackboard::Create();
+    pBoard->RegisterEntry(sInt, 0, ezBlackboardEntryFlags::OnChangeEvent);
+    pBoard->RegisterEntry(sFloat, 0.0f, ezBlackboardEntryFlags::OnChangeEvent);
+    pBoard->RegisterEntry(sBool, false);
+
+    EventRecorder recorder;
+    pBoard->OnEntryEvent().AddEventHandler(ezMakeDelegate(&EventRecorder::OnEntryEvent, &recorder));
+
+    const ezBlackboardSlot intSlot = pBoard->ResolveSlot(sInt);
+    const ezBlackboardSlot floatSlot = pBoard->ResolveSlot(sFloat);
+    const ezBlackboardSlot boolSlot = pBoard->ResolveSlot(sBool);
+
+    for (ezInt32 i = 1; i <= 10; ++i)
+    {
+      EZ_TEST_BOOL(pBoard->SetSlotValue(intSlot, i).Succeeded());
+    }
+
+    EZ_TEST_BOOL(pBoard->SetSlotValue(floatSlot, 1.0f).Succeeded());
+    EZ_TEST_BOOL(pBoard->SetSlotValue(floatSlot, 0.0f).Succeeded());
+    EZ_TEST_BOOL(pBoard->SetSlotValue(boolSlot, true).Succeeded());
+
+    EZ_TEST_INT(pBoard->GetSlotEntry(intSlot)->m_uiChangeCounter, 10);
+    EZ_TEST_BOOL(pBoard->HasPendingEntryEvents());
+    EZ_TEST_INT(recorder.m_Names.GetCount(), 0);
+
+    pBoard->BroadcastPendingEntryEvents();
+    EZ_TEST_BOOL(!pBoard->HasPendingEntryEvents());
+
+    // one event for the int, none for the float, since it ended up with its original value, none for the bool, since it has no event flag
+    EZ_TEST_INT(recorder.m_Names.GetCount(), 1);
+    if (recorder.m_Names.GetCount() == 1)
+    {
+      EZ_TEST_BOOL(recorder.m_Names[0] == sInt);
+      EZ_TEST_INT(recorder.m_OldValues[0].Get<ezInt32>(), 0);
+      EZ_TEST_INT(recorder.m_NewValues[0].Get<ezInt32>(), 10);
+    }
+
+    pBoard->BroadcastPendingEntryEvents();
+    EZ_TEST_INT(recorder.m_Names.GetCount(), 1);
+
+    // the name-based API still broadcasts right away
+    EZ_TEST_BOOL(pBoard->SetEntryValue(sFloat, 5.0f).Succeeded());
+    EZ_TEST_INT(recorder.m_Names.GetCount(), 2);
+
+    pBoard->OnEntryEvent().RemoveEventHandler(ezMakeDelegate(&EventRecorder::OnEntryEvent, &recorder));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumEntries = 32;
+    constexpr ezUInt32 uiNumIterations = 10000;
+
+    ezSharedPtr<ezBlackboard> pBoard = ezBlackboard::Create();
+
+    ezHybridArray<ezHashedString, uiNumEntries> names;
+    ezHybridArray<ezBlackboardSlot, uiNumEntries> slots;
+
+    for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+    {
+      ezStringBuilder sName;
+      sName.Format("AgentValue{}", i);
+
+      names.ExpandAndGetRef().Assign(sName);
+      pBoard->RegisterEntry(names[i], 0.0f, ezBlackboardEntryFlags::OnChangeEvent);
+      slots.PushBack(pBoard->ResolveSlot(names[i]));
+    }
+
+    float fSum = 0.0f;
+    ezTime tNames, tSlots;
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 uiIteration = 0; uiIteration < uiNumIterations; ++uiIteration)
+      {
+        for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+        {
+          const float fValue = pBoard->GetEntryValue(ezTempHashedString(names[i]), 0.0f).Get<float>();
+          pBoard->SetEntryValue(ezTempHashedString(names[i]), fValue + 1.0f).IgnoreResult();
+          fSum += fValue;
+        }
+      }
+      tNames = sw.GetRunningTotal();
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 uiIteration = 0; uiIteration < uiNumIterations; ++uiIteration)
+      {
+        for (ezUInt32 i = 0; i < uiNumEntries; ++i)
+        {
+          const float fValue = pBoard->GetSlotValue<float>(slots[i]);
+          pBoard->SetSlotValue(slots[i], fValue + 1.0f).IgnoreResult();
+          fSum += fValue;
+        }
+
+        pBoard->BroadcastPendingEntryEvents();
+      }
+      tSlots = sw.GetRunningTotal();
+    }
+
+    EZ_TEST_FLOAT(pBoard->GetSlotValue<float>(slots[0]), uiNumIterations * 2.0f, 0.0f);
+    EZ_TEST_BOOL(fSum > 0.0f);
+
+    ezLog::Info("[test]{} reads and writes of {} entries: name-based {}, slots {}", uiNumIterations, uiNumEntries, tNames, tSlots);
+  }
+}
@@ -0,0 +1,687 @@
+#include <CoreTest/CoreTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Strings/StringBuilder.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  enum ParallelTestFunction
+  {
+    WriteA,
+    ReadA,
+    Independent,
+    Barrier,
+    AfterBarrier,
+    DependsOnAfterBarrier,
+    Count
+  };
+
+  struct ParallelUpdateRecorder
+  {
+    void Reset()
+    {
+      m_iCounter = 0;
+      for (ezUInt32 i = 0; i < ParallelTestFunction::Count; ++i)
+      {
+        m_iStart[i] = -1;
+        m_iEnd[i] = -1;
+      }
+    }
+
+    void Begin(ParallelTestFunction function) { m_iStart[function] = m_iCounter.Increment(); }
+    void End(ParallelTestFunction function) { m_iEnd[function] = m_iCounter.Increment(); }
+
+    bool WasCalled(ParallelTestFunction function) const { return m_iStart[function] >= 0 && m_iEnd[function] >= 0; }
+    bool RanBefore(ParallelTestFunction first, ParallelTestFunction second) const { return m_iEnd[first] < m_iStart[second]; }
+
+    ezAtomicInteger32 m_iCounter;
+    ezInt32 m_iStart[ParallelTestFunction::Count];
+    ezInt32 m_iEnd[ParallelTestFunction::Count];
+  };
+
+  ParallelUpdateRecorder s_Recorder;
+
+  float DoSomeWork(float fSeed, ezUInt32 uiIterations)
+  {
+    float fValue = fSeed;
+    for (ezUInt32 i = 0; i < uiIterations; ++i)
+    {
+      fValue = ezMath::Mod(fValue * 1.0001f + 0.37f, 1000.0f);
+    }
+
+    return fValue;
+  }
+
+  class ParallelTestModuleA : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ParallelTestModuleA, ezWorldModule);
+    EZ_DECLARE_WORLD_MODULE();
+
+  public:
+    ParallelTestModuleA(ezWorld* pWorld)
+      : ezWorldModule(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      {
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleA::Write, this);
+        desc.m_bDeclaresDataAccess = true;
+        desc.m_fPriority = 10.0f;
+        RegisterUpdateFunction(desc);
+      }
+
+      {
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleA::AfterBarrier, this);
+        desc.m_bDeclaresDataAccess = true;
+        desc.m_fPriority = 4.0f;
+        RegisterUpdateFunction(desc);
+      }
+    }
+
+    void Write(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::WriteA);
+      m_fValue = DoSomeWork(m_fValue, 10000);
+      s_Recorder.End(ParallelTestFunction::WriteA);
+    }
+
+    void AfterBarrier(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::AfterBarrier);
+      DoSomeWork(m_fValue, 1000);
+      s_Recorder.End(ParallelTestFunction::AfterBarrier);
+    }
+
+    float m_fValue = 1.0f;
+  };
+
+  class ParallelTestModuleB : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ParallelTestModuleB, ezWorldModule);
+    EZ_DECLARE_WORLD_MODULE();
+
+  public:
+    ParallelTestModuleB(ezWorld* pWorld)
+      : ezWorldModule(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      {
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleB::ReadA, this);
+        desc.m_bDeclaresDataAccess = true;
+        desc.m_ReadsFrom.PushBack(ezGetStaticRTTI<ParallelTestModuleA>());
+        desc.m_fPriority = 9.0f;
+        RegisterUpdateFunction(desc);
+      }
+
+      {
+        // no data overlap, only ordered by the explicit dependency
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleB::DependsOnAfterBarrier, this);
+        desc.m_bDeclaresDataAccess = true;
+        desc.m_DependsOn.PushBack(ezMakeHashedString("ParallelTestModuleA::AfterBarrier"));
+        desc.m_fPriority = 3.0f;
+        RegisterUpdateFunction(desc);
+      }
+    }
+
+    void ReadA(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::ReadA);
+      const ezWorld* pWorld = GetWorld();
+      m_fCopiedValue = pWorld->GetModule<ParallelTestModuleA>()->m_fValue;
+      s_Recorder.End(ParallelTestFunction::ReadA);
+    }
+
+    void DependsOnAfterBarrier(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::DependsOnAfterBarrier);
+      s_Recorder.End(ParallelTestFunction::DependsOnAfterBarrier);
+    }
+
+    float m_fCopiedValue = 0.0f;
+  };
+
+  class ParallelTestModuleC : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ParallelTestModuleC, ezWorldModule);
+    EZ_DECLARE_WORLD_MODULE();
+
+  public:
+    ParallelTestModuleC(ezWorld* pWorld)
+      : ezWorldModule(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      {
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleC::Independent, this);
+        desc.m_bDeclaresDataAccess = true;
+        desc.m_fPriority = 9.0f;
+        RegisterUpdateFunction(desc);
+      }
+
+      {
+        // doesn't declare its data access and thus splits the phase into two parallel batches
+        auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ParallelTestModuleC::Barrier, this);
+        desc.m_fPriority = 5.0f;
+        RegisterUpdateFunction(desc);
+      }
+    }
+
+    void Independent(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::Independent);
+      m_fValue = DoSomeWork(m_fValue, 10000);
+      s_Recorder.End(ParallelTestFunction::Independent);
+    }
+
+    void Barrier(const UpdateContext&)
+    {
+      s_Recorder.Begin(ParallelTestFunction::Barrier);
+      s_Recorder.End(ParallelTestFunction::Barrier);
+    }
+
+    float m_fValue = 2.0f;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelTestModuleA, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  EZ_IMPLEMENT_WORLD_MODULE(ParallelTestModuleA);
+
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelTestModuleB, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  EZ_IMPLEMENT_WORLD_MODULE(ParallelTestModuleB);
+
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelTestModuleC, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  EZ_IMPLEMENT_WORLD_MODULE(ParallelTestModuleC);
+  // clang-format on
+
+  class ParallelTestDataModule : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ParallelTestDataModule, ezWorldModule);
+    EZ_DECLARE_WORLD_MODULE();
+
+  public:
+    ParallelTestDataModule(ezWorld* pWorld)
+      : ezWorldModule(pWorld)
+    {
+    }
+
+    float m_fValue = 3.0f;
+  };
+
+  enum class ValidationScenario
+  {
+    UndeclaredRead,
+    WriteThroughReadDeclaration,
+    DeclaredRead,
+    DeclaredWrite,
+    DeclaredObjectWrite,
+    UndeclaredObjectWrite,
+    StructureChange,
+  };
+
+  ValidationScenario s_ValidationScenario = ValidationScenario::UndeclaredRead;
+  ezAtomicInteger32 s_iNumFailedChecks;
+
+  bool CountingAssertHandler(const char* szSourceFile, ezUInt32 uiLine, const char* szFunction, const char* szExpression, const char* szAssertMsg)
+  {
+    s_iNumFailedChecks.Increment();
+    return false;
+  }
+
+  // Registers one update function with declared data access, which accesses the world depending on s_ValidationScenario.
+  class ValidationTestModule : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ValidationTestModule, ezWorldModule);
+    EZ_DECLARE_WORLD_MODULE();
+
+  public:
+    ValidationTestModule(ezWorld* pWorld)
+      : ezWorldModule(pWorld)
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(ValidationTestModule::Update, this);
+      desc.m_bDeclaresDataAccess = true;
+
+      switch (s_ValidationScenario)
+      {
+        case ValidationScenario::WriteThroughReadDeclaration:
+        case ValidationScenario::DeclaredRead:
+          desc.m_ReadsFrom.PushBack(ezGetStaticRTTI<ParallelTestDataModule>());
+          break;
+        case ValidationScenario::DeclaredWrite:
+          desc.m_WritesTo.PushBack(ezGetStaticRTTI<ParallelTestDataModule>());
+          break;
+        case ValidationScenario::DeclaredObjectWrite:
+          desc.m_WritesTo.PushBack(ezGetStaticRTTI<ezGameObject>());
+          break;
+        case ValidationScenario::UndeclaredObjectWrite:
+          desc.m_ReadsFrom.PushBack(ezGetStaticRTTI<ezGameObject>());
+          break;
+        default:
+          break;
+      }
+
+      RegisterUpdateFunction(desc);
+    }
+
+    void Update(const UpdateContext&)
+    {
+      ezWorld* pWorld = GetWorld();
+      const ezWorld* pConstWorld = pWorld;
+
+      switch (s_ValidationScenario)
+      {
+        case ValidationScenario::UndeclaredRead:
+        case ValidationScenario::DeclaredRead:
+          m_fValue = pConstWorld->GetModule<ParallelTestDataModule>()->m_fValue;
+          break;
+        case ValidationScenario::WriteThroughReadDeclaration:
+        case ValidationScenario::DeclaredWrite:
+          pWorld->GetModule<ParallelTestDataModule>()->m_fValue += 1.0f;
+          break;
+        case ValidationScenario::DeclaredObjectWrite:
+        case ValidationScenario::UndeclaredObjectWrite:
+          for (auto it = pWorld->GetObjects(); it.IsValid(); ++it)
+          {
+            it->SetLocalUniformScaling(2.0f);
+          }
+          break;
+        case ValidationScenario::StructureChange:
+        {
+          ezGameObjectDesc desc;
+          pWorld->CreateObject(desc);
+          break;
+        }
+      }
+    }
+
+    float m_fValue = 0.0f;
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelTestDataModule, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  EZ_IMPLEMENT_WORLD_MODULE(ParallelTestDataModule);
+
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ValidationTestModule, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  EZ_IMPLEMENT_WORLD_MODULE(ValidationTestModule);
+  // clang-format on
+
+  // Independent modules with one expensive update function each, to compare serial and parallel execution.
+#define DECLARE_BENCHMARK_MODULE(name, seed)                                                     \
+  class name : public ezWorldModule                                                              \
+  {                                                                                              \
+    EZ_ADD_DYNAMIC_REFLECTION(name, ezWorldModule);                                              \
+    EZ_DECLARE_WORLD_MODULE();                                                                   \
+                                                                                                 \
+  public:                                                                                        \
+    name(ezWorld* pWorld)                                                                        \
+      : ezWorldModule(pWorld)                                                                    \
+    {                                                                                            \
+    }                                                                                            \
+                                                                                                 \
+    virtual void Initialize() override                                                           \
+    {                                                                                            \
+      auto desc = EZ_CREATE_MODULE_UPDATE_FUNCTION_DESC(name::Update, this);                     \
+      desc.m_bDeclaresDataAccess = true;                                                         \
+      RegisterUpdateFunction(desc);                                                              \
+    }                                                                                            \
+                                                                                                 \
+    void Update(const UpdateContext&) { m_fValue = DoSomeWork(m_fValue, 200000); }               \
+                                                                                                 \
+    float m_fValue = seed;                                                                       \
+  };                                                                                             \
+                                                                                                 \
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(name, 1, ezRTTINoAllocator)                                    \
+  EZ_END_DYNAMIC_REFLECTED_TYPE;                                                                 \
+  EZ_IMPLEMENT_WORLD_MODULE(name)
+
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule0, 0.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule1, 1.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule2, 2.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule3, 3.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule4, 4.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule5, 5.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule6, 6.0f);
+  DECLARE_BENCHMARK_MODULE(ParallelBenchmarkModule7, 7.0f);
+
+#undef DECLARE_BENCHMARK_MODULE
+
+  void CreateBenchmarkModules(ezWorld& ref_world)
+  {
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule0>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule1>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule2>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule3>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule4>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule5>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule6>();
+    ref_world.GetOrCreateModule<ParallelBenchmarkModule7>();
+  }
+
+  float SumBenchmarkModules(ezWorld& ref_world)
+  {
+    float fSum = 0.0f;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule0>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule1>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule2>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule3>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule4>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule5>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule6>()->m_fValue;
+    fSum += ref_world.GetModule<ParallelBenchmarkModule7>()->m_fValue;
+    return fSum;
+  }
+  // A larger setup with many modules that register several update functions each. Every function writes its own module and reads one
+  // or two other modules. The priorities interleave the functions of all modules, so the conflicts form a non-trivial dependency graph.
+  constexpr ezUInt32 s_uiNumScenarioModules = 8;
+  constexpr ezUInt32 s_uiFunctionsPerScenarioModule = 6;
+
+  const ezRTTI* GetScenarioModuleType(ezUInt32 uiModuleIndex);
+
+  class ParallelScenarioModule : public ezWorldModule
+  {
+    EZ_ADD_DYNAMIC_REFLECTION(ParallelScenarioModule, ezWorldModule);
+
+  public:
+    ParallelScenarioModule(ezWorld* pWorld, ezUInt32 uiModuleIndex)
+      : ezWorldModule(pWorld)
+      , m_uiModuleIndex(uiModuleIndex)
+      , m_fValue(static_cast<float>(uiModuleIndex))
+    {
+    }
+
+    virtual void Initialize() override
+    {
+      RegisterScenarioFunctions(std::make_integer_sequence<ezUInt32, s_uiFunctionsPerScenarioModule>());
+    }
+
+    template <ezUInt32... LocalIndices>
+    void RegisterScenarioFunctions(std::integer_sequence<ezUInt32, LocalIndices...>)
+    {
+      (RegisterScenarioFunction(UpdateFunction(&ParallelScenarioModule::Update<LocalIndices>, this), LocalIndices), ...);
+    }
+
+    void RegisterScenarioFunction(const UpdateFunction& function, ezUInt32 uiLocalIndex)
+    {
+      const ezUInt32 uiFunctionIndex = m_uiModuleIndex * s_uiFunctionsPerScenarioModule + uiLocalIndex;
+
+      auto& readsFrom = m_ReadsFrom[uiLocalIndex];
+      readsFrom.PushBack(GetScenarioModuleType((m_uiModuleIndex + 1 + uiLocalIndex % 3) % s_uiNumScenarioModules));
+      if (uiLocalIndex % 2 != 0)
+      {
+        readsFrom.PushBack(GetScenarioModuleType((m_uiModuleIndex + 5) % s_uiNumScenarioModules));
+      }
+
+      ezStringBuilder sName;
+      sName.Format("ParallelScenarioModule{}::Update{}", m_uiModuleIndex, uiLocalIndex);
+
+      UpdateFunctionDesc desc(function, sName);
+      desc.m_bDeclaresDataAccess = true;
+      desc.m_ReadsFrom = readsFrom;
+      desc.m_fPriority = static_cast<float>((uiFunctionIndex * 29) % (s_uiNumScenarioModules * s_uiFunctionsPerScenarioModule));
+      RegisterUpdateFunction(desc);
+    }
+
+    template <ezUInt32 LocalIndex>
+    void Update(const UpdateContext&)
+    {
+      const ezWorld* pWorld = GetWorld();
+
+      float fInput = m_fValue;
+      for (const ezRTTI* pType : m_ReadsFrom[LocalIndex])
+      {
+        fInput += static_cast<const ParallelScenarioModule*>(pWorld->GetModule(pType))->m_fValue;
+      }
+
+      m_fValue = DoSomeWork(fInput * 0.5f, 20000);
+    }
+
+    const ezUInt32 m_uiModuleIndex;
+    float m_fValue;
+    ezHybridArray<const ezRTTI*, 2> m_ReadsFrom[s_uiFunctionsPerScenarioModule];
+  };
+
+  // clang-format off
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(ParallelScenarioModule, 1, ezRTTINoAllocator)
+  EZ_END_DYNAMIC_REFLECTED_TYPE;
+  // clang-format on
+
+#define DECLARE_SCENARIO_MODULE(name, index)                   \
+  class name : public ParallelScenarioModule                   \
+  {                                                            \
+    EZ_ADD_DYNAMIC_REFLECTION(name, ParallelScenarioModule);   \
+    EZ_DECLARE_WORLD_MODULE();                                 \
+                                                               \
+  public:                                                      \
+    name(ezWorld* pWorld)                                      \
+      : ParallelScenarioModule(pWorld, index)                  \
+    {                                                          \
+    }                                                          \
+  };                                                           \
+                                                               \
+  EZ_BEGIN_DYNAMIC_REFLECTED_TYPE(name, 1, ezRTTINoAllocator)  \
+  EZ_END_DYNAMIC_REFLECTED_TYPE;                               \
+  EZ_IMPLEMENT_WORLD_MODULE(name)
+
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule0, 0);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule1, 1);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule2, 2);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule3, 3);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule4, 4);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule5, 5);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule6, 6);
+  DECLARE_SCENARIO_MODULE(ParallelScenarioModule7, 7);
+
+#undef DECLARE_SCENARIO_MODULE
+
+  const ezRTTI* GetScenarioModuleType(ezUInt32 uiModuleIndex)
+  {
+    static const ezRTTI* s_Types[s_uiNumScenarioModules] = {
+      ezGetStaticRTTI<ParallelScenarioModule0>(),
+      ezGetStaticRTTI<ParallelScenarioModule1>(),
+      ezGetStaticRTTI<ParallelScenarioModule2>(),
+      ezGetStaticRTTI<ParallelScenarioModule3>(),
+      ezGetStaticRTTI<ParallelScenarioModule4>(),
+      ezGetStaticRTTI<ParallelScenarioModule5>(),
+      ezGetStaticRTTI<ParallelScenarioModule6>(),
+      ezGetStaticRTTI<ParallelScenarioModule7>(),
+    };
+
+    return s_Types[uiModuleIndex];
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(World, ParallelUpdate)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Order of conflicting functions")
+  {
+    for (bool bParallel : {false, true})
+    {
+      ezWorldDesc worldDesc("Test");
+      worldDesc.m_bParallelSynchronousUpdates = bParallel;
+      ezWorld world(worldDesc);
+
+      EZ_LOCK(world.GetWriteMarker());
+      world.GetOrCreateModule<ParallelTestModuleA>();
+      world.GetOrCreateModule<ParallelTestModuleB>();
+      world.GetOrCreateModule<ParallelTestModuleC>();
+
+      for (ezUInt32 uiFrame = 0; uiFrame < 10; ++uiFrame)
+      {
+        s_Recorder.Reset();
+        world.Update();
+
+        for (ezUInt32 i = 0; i < ParallelTestFunction::Count; ++i)
+        {
+          EZ_TEST_BOOL(s_Recorder.WasCalled(static_cast<ParallelTestFunction>(i)));
+        }
+
+        // read after write of the same module
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::WriteA, ParallelTestFunction::ReadA));
+
+        // functions without declared access wait for everything before them and block everything after them
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::WriteA, ParallelTestFunction::Barrier));
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::ReadA, ParallelTestFunction::Barrier));
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::Independent, ParallelTestFunction::Barrier));
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::Barrier, ParallelTestFunction::AfterBarrier));
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::Barrier, ParallelTestFunction::DependsOnAfterBarrier));
+
+        // explicit dependency
+        EZ_TEST_BOOL(s_Recorder.RanBefore(ParallelTestFunction::AfterBarrier, ParallelTestFunction::DependsOnAfterBarrier));
+
+        EZ_TEST_FLOAT(world.GetModule<ParallelTestModuleB>()->m_fCopiedValue, world.GetModule<ParallelTestModuleA>()->m_fValue, 0.0f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Access validation")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+    struct
+    {
+      ValidationScenario m_Scenario;
+      bool m_bExpectFailedCheck;
+    } scenarios[] = {
+      {ValidationScenario::UndeclaredRead, true},
+      {ValidationScenario::WriteThroughReadDeclaration, true},
+      {ValidationScenario::DeclaredRead, false},
+      {ValidationScenario::DeclaredWrite, false},
+      {ValidationScenario::DeclaredObjectWrite, false},
+      {ValidationScenario::UndeclaredObjectWrite, true},
+      {ValidationScenario::StructureChange, true},
+    };
+
+    for (const auto& scenario : scenarios)
+    {
+      s_ValidationScenario = scenario.m_Scenario;
+
+      ezWorldDesc worldDesc("Test");
+      ezWorld world(worldDesc);
+
+      EZ_LOCK(world.GetWriteMarker());
+
+      ezGameObjectDesc objectDesc;
+      objectDesc.m_bDynamic = true;
+      world.CreateObject(objectDesc);
+
+      world.GetOrCreateModule<ParallelTestDataModule>();
+      world.GetOrCreateModule<ValidationTestModule>();
+
+      ezAssertHandler previousAssertHandler = ezGetAssertHandler();
+      ezSetAssertHandler(CountingAssertHandler);
+      s_iNumFailedChecks = 0;
+
+      world.Update();
+
+      ezSetAssertHandler(previousAssertHandler);
+
+      EZ_TEST_BOOL_MSG((s_iNumFailedChecks > 0) == scenario.m_bExpectFailedCheck, "Scenario %i: %i failed checks", static_cast<int>(scenario.m_Scenario),
+        static_cast<int>(s_iNumFailedChecks));
+    }
+#endif
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Many update functions")
+  {
+    constexpr ezUInt32 uiNumFrames = 10;
+
+    float fResults[2][s_uiNumScenarioModules] = {};
+    ezTime times[2];
+
+    for (ezUInt32 uiParallel = 0; uiParallel < 2; ++uiParallel)
+    {
+      ezWorldDesc worldDesc("Test");
+      worldDesc.m_bParallelSynchronousUpdates = uiParallel != 0;
+      ezWorld world(worldDesc);
+
+      EZ_LOCK(world.GetWriteMarker());
+      for (ezUInt32 i = 0; i < s_uiNumScenarioModules; ++i)
+      {
+        world.GetOrCreateModule(GetScenarioModuleType(i));
+      }
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      // all accesses are declared, the validation must not fire
+      ezAssertHandler previousAssertHandler = ezGetAssertHandler();
+      ezSetAssertHandler(CountingAssertHandler);
+      s_iNumFailedChecks = 0;
+#endif
+
+      ezStopwatch sw;
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        world.Update();
+      }
+      times[uiParallel] = sw.GetRunningTotal();
+
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEVELOPMENT)
+      ezSetAssertHandler(previousAssertHandler);
+      EZ_TEST_INT(s_iNumFailedChecks, 0);
+#endif
+
+      for (ezUInt32 i = 0; i < s_uiNumScenarioModules; ++i)
+      {
+        fResults[uiParallel][i] = static_cast<const ParallelScenarioModule*>(world.GetModule(GetScenarioModuleType(i)))->m_fValue;
+      }
+    }
+
+    // conflicting functions keep their serial order, so the results have to be exactly the same
+    for (ezUInt32 i = 0; i < s_uiNumScenarioModules; ++i)
+    {
+      EZ_TEST_FLOAT(fResults[0][i], fResults[1][i], 0.0f);
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u frames with %u update functions: serial %.2fms, parallel %.2fms", uiNumFrames,
+      s_uiNumScenarioModules * s_uiFunctionsPerScenarioModule, times[0].GetMilliseconds(), times[1].GetMilliseconds());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Serial vs. parallel")
+  {
+    constexpr ezUInt32 uiNumFrames = 20;
+
+    float fResults[2] = {};
+    ezTime times[2];
+
+    for (ezUInt32 uiParallel = 0; uiParallel < 2; ++uiParallel)
+    {
+      ezWorldDesc worldDesc("Test");
+      worldDesc.m_bParallelSynchronousUpdates = uiParallel != 0;
+      ezWorld world(worldDesc);
+
+      EZ_LOCK(world.GetWriteMarker());
+      CreateBenchmarkModules(world);
+
+      // the first update registers the update functions
+      world.Update();
+
+      ezStopwatch sw;
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        world.Update();
+      }
+      times[uiParallel] = sw.GetRunningTotal();
+
+      fResults[uiParallel] = SumBenchmarkModules(world);
+    }
+
+    EZ_TEST_FLOAT(fResults[0], fResults[1], 0.0f);
+
+    ezTestFramework::Output(ezTestOutput::Duration, "%u frames with 8 independent update functions: serial %.2fms, parallel %.2fms", uiNumFrames,
+      times[0].GetMilliseconds(), times[1].GetMilliseconds());
+  }
+}
@@ -1,12 +1,14 @@
 #include <CoreTest/CoreTestPCH.h>
 
 #include <Core/Messages/UpdateLocalBoundsMessage.h>
+#include <Core/World/SpatialSystem_AabbTree.h>
 #include <Core/World/World.h>
 #include <Foundation/Containers/HashSet.h>
 #include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Profiling/Profiling.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Utilities/GraphicsUtils.h>
 
 namespace
@@ -57,12 +59,11 @@ namespace
   // clang-format on
 } // namespace
 
-EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+static void TestSpatialSystem(ezWorldDesc& ref_worldDesc)
 {
-  ezWorldDesc worldDesc("Test");
-  worldDesc.m_uiRandomNumberGeneratorSeed = 5;
+  ref_worldDesc.m_uiRandomNumberGeneratorSeed = 5;
 
-  ezWorld world(worldDesc);
+  ezWorld world(ref_worldDesc);
   EZ_LOCK(world.GetWriteMarker());
 
   auto& rng = world.GetRandomNumberGenerator();
@@ -293,6 +294,58 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     }
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ModificationCounter")
+  {
+    const ezUInt32 uiStaticBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask();
+    const ezUInt32 uiDynamicBitmask = ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+    const ezSpatialSystem* pSpatialSystem = world.GetSpatialSystem();
+
+    ezUInt64 uiStaticCounter = pSpatialSystem->GetModificationCounter(uiStaticBitmask);
+    ezUInt64 uiDynamicCounter = pSpatialSystem->GetModificationCounter(uiDynamicBitmask);
+
+    // nothing changed
+    world.Update();
+    EZ_TEST_INT(pSpatialSystem->GetModificationCounter(uiStaticBitmask), uiStaticCounter);
+    EZ_TEST_INT(pSpatialSystem->GetModificationCounter(uiDynamicBitmask), uiDynamicCounter);
+
+    // moving a dynamic object only affects the dynamic category
+    objects[600]->SetLocalPosition(objects[600]->GetLocalPosition() + ezVec3(10, 0, 0));
+    world.Update();
+    EZ_TEST_INT(pSpatialSystem->GetModificationCounter(uiStaticBitmask), uiStaticCounter);
+    EZ_TEST_BOOL(pSpatialSystem->GetModificationCounter(uiDynamicBitmask) != uiDynamicCounter);
+    uiDynamicCounter = pSpatialSystem->GetModificationCounter(uiDynamicBitmask);
+
+    // creating a static object only affects the static category
+    {
+      ezGameObjectDesc desc;
+      desc.m_LocalPosition = objects[100]->GetLocalPosition();
+
+      ezGameObject* pObject = nullptr;
+      world.CreateObject(desc, pObject);
+
+      TestBoundsComponent* pComponent = nullptr;
+      TestBoundsComponent::CreateComponent(pObject, pComponent);
+
+      objects.PushBack(pObject);
+    }
+    world.Update();
+    EZ_TEST_BOOL(pSpatialSystem->GetModificationCounter(uiStaticBitmask) != uiStaticCounter);
+    EZ_TEST_INT(pSpatialSystem->GetModificationCounter(uiDynamicBitmask), uiDynamicCounter);
+    uiStaticCounter = pSpatialSystem->GetModificationCounter(uiStaticBitmask);
+
+    // both categories together change when either one changes
+    const ezUInt64 uiCombinedCounter = pSpatialSystem->GetModificationCounter(uiStaticBitmask | uiDynamicBitmask);
+    objects[601]->SetLocalPosition(objects[601]->GetLocalPosition() + ezVec3(10, 0, 0));
+    world.Update();
+    EZ_TEST_BOOL(pSpatialSystem->GetModificationCounter(uiStaticBitmask | uiDynamicBitmask) != uiCombinedCounter);
+
+    // deleting an object, this might also move other objects in memory which changes their categories as well
+    world.DeleteObjectNow(objects[101]->GetHandle());
+    objects.RemoveAtAndCopy(101);
+    world.Update();
+    EZ_TEST_BOOL(pSpatialSystem->GetModificationCounter(uiStaticBitmask) != uiStaticCounter);
+  }
+
   // Test multiple categories for spatial data
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "MultipleCategories")
   {
@@ -323,3 +376,128 @@ EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
     world.Update();
   }
 }
+
+static void BenchmarkSpatialSystem(bool bUseAabbTree, bool bClustered)
+{
+  ezWorldDesc worldDesc("Benchmark");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 11;
+  if (bUseAabbTree)
+  {
+    worldDesc.m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_AabbTree);
+  }
+
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  auto& rng = world.GetRandomNumberGenerator();
+
+  constexpr ezUInt32 uiNumObjects = 10000;
+  constexpr ezUInt32 uiNumClusters = 16;
+  constexpr double range = 10000.0;
+  constexpr double clusterRange = 300.0;
+
+  auto RandomPosition = [&](double fRange) {
+    return ezVec3((float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange), (float)rng.DoubleMinMax(-fRange, fRange));
+  };
+
+  ezHybridArray<ezVec3, uiNumClusters> clusterCenters;
+  for (ezUInt32 i = 0; i < uiNumClusters; ++i)
+  {
+    clusterCenters.PushBack(RandomPosition(range));
+  }
+
+  auto RandomSamplePosition = [&](ezUInt32 i) {
+    return bClustered ? clusterCenters[i % uiNumClusters] + RandomPosition(clusterRange) : RandomPosition(range);
+  };
+
+  ezStopwatch sw;
+
+  ezDynamicArray<ezGameObject*> dynamicObjects;
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    ezGameObjectDesc desc;
+    desc.m_bDynamic = (i % 4 == 0);
+    desc.m_LocalPosition = RandomSamplePosition(i);
+
+    ezGameObject* pObject = nullptr;
+    world.CreateObject(desc, pObject);
+
+    TestBoundsComponent* pComponent = nullptr;
+    TestBoundsComponent::CreateComponent(pObject, pComponent);
+
+    if (desc.m_bDynamic)
+    {
+      dynamicObjects.PushBack(pObject);
+    }
+  }
+
+  world.Update();
+  const ezTime tCreate = sw.Checkpoint();
+
+  ezSpatialSystem::QueryParams queryParams;
+  queryParams.m_uiCategoryBitmask = ezDefaultSpatialDataCategories::RenderStatic.GetBitmask() | ezDefaultSpatialDataCategories::RenderDynamic.GetBitmask();
+
+  ezUInt32 uiNumInSphere = 0;
+  for (ezUInt32 i = 0; i < 200; ++i)
+  {
+    ezBoundingSphere sphere = ezBoundingSphere::MakeFromCenterAndRadius(RandomSamplePosition(i), 500.0f);
+    world.GetSpatialSystem()->FindObjectsInSphere(sphere, queryParams, [&](ezGameObject*) {
+      ++uiNumInSphere;
+      return ezVisitorExecution::Continue; });
+  }
+  const ezTime tSphere = sw.Checkpoint();
+
+  ezUInt32 uiNumVisible = 0;
+  ezDynamicArray<const ezGameObject*> visibleObjects;
+  for (ezUInt32 i = 0; i < 20; ++i)
+  {
+    const ezVec3 vCameraPos = RandomSamplePosition(i);
+    ezMat4 lookAt = ezGraphicsUtils::CreateLookAtViewMatrix(vCameraPos, vCameraPos + ezVec3::MakeRandomDirection(rng), ezVec3::MakeAxisZ());
+    ezMat4 projection = ezGraphicsUtils::CreatePerspectiveProjectionMatrixFromFovX(ezAngle::MakeFromDegree(80.0f), 1.0f, 1.0f, 5000.0f);
+
+    visibleObjects.Clear();
+    world.GetSpatialSystem()->FindVisibleObjects(ezFrustum::MakeFromMVP(projection * lookAt), queryParams, visibleObjects, {}, ezVisibilityState::Direct);
+    uiNumVisible += visibleObjects.GetCount();
+  }
+  const ezTime tFrustum = sw.Checkpoint();
+
+  for (ezUInt32 i = 0; i < 10; ++i)
+  {
+    for (ezGameObject* pObject : dynamicObjects)
+    {
+      pObject->SetLocalPosition(pObject->GetLocalPosition() + RandomPosition(20.0));
+    }
+
+    world.Update();
+  }
+  const ezTime tMove = sw.Checkpoint();
+
+  ezLog::Info("[test]{} {}: create {}, 200 sphere queries {} ({} found), 20 frustum queries {} ({} visible), 10 frames with moving objects {}",
+    bClustered ? "Clustered" : "Uniform", bUseAabbTree ? "AabbTree" : "RegularGrid", tCreate, tSphere, uiNumInSphere, tFrustum, uiNumVisible, tMove);
+
+  // make sure the benchmark actually measures something
+  EZ_TEST_BOOL(uiNumInSphere > 0);
+  EZ_TEST_BOOL(uiNumVisible > 0);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystem)
+{
+  ezWorldDesc worldDesc("Test");
+  TestSpatialSystem(worldDesc);
+}
+
+EZ_CREATE_SIMPLE_TEST(World, SpatialSystemAabbTree)
+{
+  ezWorldDesc worldDesc("Test");
+  worldDesc.m_pSpatialSystem = EZ_NEW(ezFoundation::GetAlignedAllocator(), ezSpatialSystem_AabbTree);
+  TestSpatialSystem(worldDesc);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    for (bool bClustered : {false, true})
+    {
+      BenchmarkSpatialSystem(false, bClustered);
+      BenchmarkSpatialSystem(true, bClustered);
+    }
+  }
+}
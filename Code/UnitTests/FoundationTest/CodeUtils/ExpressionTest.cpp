@@ -7,6 +7,7 @@
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
 #include <Foundation/Math/Float16.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <Foundation/Types/UniquePtr.h>
 
 namespace
@@ -464,6 +465,52 @@ namespace
     &TestFunc2,
   };
 
+  struct FloatStreams
+  {
+    void Init(ezUInt32 uiCount)
+    {
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_Inputs); ++i)
+      {
+        m_Inputs[i].SetCountUninitialized(uiCount);
+        for (ezUInt32 j = 0; j < uiCount; ++j)
+        {
+          // deterministic values in the range [-2, 2]
+          m_Inputs[i][j] = ezMath::Sin(ezAngle::MakeFromRadian(0.37f * j + 1.3f * i)) * 2.0f;
+        }
+      }
+
+      m_Output.SetCount(uiCount);
+    }
+
+    ezResult Execute(ezExpressionVM& ref_vm, const ezExpressionByteCode& byteCode, ezUInt32 uiFirstInstance, ezUInt32 uiNumInstances)
+    {
+      const ezHashedString names[] = {s_sA, s_sB, s_sC, s_sD};
+
+      ezProcessingStream inputs[EZ_ARRAY_SIZE(m_Inputs)];
+      for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(m_Inputs); ++i)
+      {
+        inputs[i] = ezProcessingStream(names[i], m_Inputs[i].GetArrayPtr().GetSubArray(uiFirstInstance, uiNumInstances).ToByteArray(), ezProcessingStream::DataType::Float);
+      }
+
+      ezProcessingStream outputs[] = {
+        ezProcessingStream(s_sOutput, m_Output.GetArrayPtr().GetSubArray(uiFirstInstance, uiNumInstances).ToByteArray(), ezProcessingStream::DataType::Float),
+      };
+
+      return ref_vm.Execute(byteCode, inputs, outputs, uiNumInstances);
+    }
+
+    ezDynamicArray<float> m_Inputs[4];
+    ezDynamicArray<float> m_Output;
+  };
+
+  // Resembles the kind of expressions generated from procedural placement and vertex color graphs.
+  static const char* s_szProcGenLikeCode = "var h = a * 0.5 + 0.5\n"
+                                           "var s = saturate((b - 0.2) * 4.0)\n"
+                                           "var n = PerlinNoise(a * 3.0, b * 3.0, c, 2) * 0.25 + d * d\n"
+                                           "var m = lerp(h, s, c) + n - a * d\n"
+                                           "var k = m > 0.5 ? m * 2 - 1 : sqrt(abs(m)) + floor(d * 4) / 4\n"
+                                           "output = clamp(k * b + c * 0.3, -1, 1) + min(a, d) * 0.1";
+
 } // namespace
 
 EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
@@ -1171,4 +1218,97 @@ EZ_CREATE_SIMPLE_TEST(CodeUtils, Expression)
     Compile<ezVec3>(testCode, testByteCode);
     EZ_TEST_VEC3(Execute<ezVec3>(testByteCode), ezVec3(61, 54, 54), ezMath::DefaultEpsilon<float>());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Chunked, parallel and wide execution")
+  {
+    s_pParser->RegisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+    EZ_SCOPE_EXIT(s_pParser->UnregisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc));
+
+    ezExpressionByteCode byteCode;
+    Compile<float>(s_szProcGenLikeCode, byteCode);
+
+    // not a multiple of 8 to test the remainder handling
+    constexpr ezUInt32 uiNumInstances = 50001;
+
+    FloatStreams reference;
+    reference.Init(uiNumInstances);
+
+    ezExpressionVM vm;
+    vm.SetEnableWideSimd(false);
+    vm.SetParallelExecutionThreshold(ezInvalidIndex);
+    EZ_TEST_BOOL(reference.Execute(vm, byteCode, 0, uiNumInstances).Succeeded());
+
+    // Executing single instances must give the same results as executing all instances at once in chunks
+    {
+      FloatStreams single;
+      single.Init(uiNumInstances);
+
+      for (ezUInt32 i = 0; i < uiNumInstances; i += 997)
+      {
+        EZ_TEST_BOOL(single.Execute(vm, byteCode, i, 1).Succeeded());
+        EZ_TEST_BOOL(ezMemoryUtils::RawByteCompare(&single.m_Output[i], &reference.m_Output[i], sizeof(float)) == 0);
+      }
+    }
+
+    for (ezUInt32 uiParallel = 0; uiParallel < 2; ++uiParallel)
+    {
+      for (ezUInt32 uiWide = 0; uiWide < 2; ++uiWide)
+      {
+        vm.SetParallelExecutionThreshold(uiParallel ? 0 : ezInvalidIndex);
+        vm.SetEnableWideSimd(uiWide != 0);
+
+        FloatStreams test;
+        test.Init(uiNumInstances);
+        EZ_TEST_BOOL(test.Execute(vm, byteCode, 0, uiNumInstances).Succeeded());
+
+        // The results must be bit-identical
+        EZ_TEST_BOOL_MSG(ezMemoryUtils::RawByteCompare(test.m_Output.GetData(), reference.m_Output.GetData(), uiNumInstances * sizeof(float)) == 0, "parallel: %u, wide: %u", uiParallel, uiWide);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    s_pParser->RegisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc);
+    EZ_SCOPE_EXIT(s_pParser->UnregisterFunction(ezDefaultExpressionFunctions::s_PerlinNoiseFunc.m_Desc));
+
+    ezExpressionByteCode byteCode;
+    Compile<float>(s_szProcGenLikeCode, byteCode);
+
+    constexpr ezUInt32 uiNumInstances = 256 * 1024;
+    constexpr ezUInt32 uiNumRuns = 10;
+
+    FloatStreams streams;
+    streams.Init(uiNumInstances);
+
+    struct Config
+    {
+      const char* m_szName;
+      bool m_bWide;
+      bool m_bParallel;
+    };
+
+    const Config configs[] = {
+      {"4-wide", false, false},
+      {"8-wide", true, false},
+      {"8-wide, parallel", true, true},
+    };
+
+    ezLog::Info("[test]{} instances, {} runs, {} instructions, native 8-wide: {}", uiNumInstances, uiNumRuns, byteCode.GetNumInstructions(), EZ_ENABLED(EZ_SIMD_VEC8_NATIVE) ? "yes" : "no");
+
+    ezExpressionVM vm;
+    for (auto& config : configs)
+    {
+      vm.SetEnableWideSimd(config.m_bWide);
+      vm.SetParallelExecutionThreshold(config.m_bParallel ? 0 : ezInvalidIndex);
+
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumRuns; ++i)
+      {
+        EZ_TEST_BOOL(streams.Execute(vm, byteCode, 0, uiNumInstances).Succeeded());
+      }
+
+      ezLog::Info("[test]{}: {}", config.m_szName, sw.GetRunningTotal());
+    }
+  }
 }
@@ -0,0 +1,333 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+#  include <Foundation/Communication/Implementation/NetworkMessageBatch.h>
+#  include <Foundation/Communication/RemoteInterfaceEnet.h>
+#  include <Foundation/Time/Stopwatch.h>
+#  include <Foundation/Types/UniquePtr.h>
+
+namespace
+{
+  constexpr ezUInt32 s_uiConnectionToken = 'EZRT';
+  constexpr ezUInt32 s_uiSystemID = 'TEST';
+
+  struct TestReceiver
+  {
+    void OnMessage(ezRemoteMessage& ref_msg)
+    {
+      ezUInt32 uiSequence = 0;
+      ref_msg.GetReader() >> uiSequence;
+
+      m_bInOrder = m_bInOrder && (uiSequence == m_uiNumReceived);
+      m_uiBytesReceived += ref_msg.GetMessageData().GetCount();
+      ++m_uiNumReceived;
+
+      if (ref_msg.GetMessageID() == 'LRGE')
+      {
+        m_LastLargeMessage = ref_msg.GetMessageData();
+      }
+    }
+
+    ezUInt32 m_uiNumReceived = 0;
+    ezUInt64 m_uiBytesReceived = 0;
+    bool m_bInOrder = true;
+    ezDynamicArray<ezUInt8> m_LastLargeMessage;
+  };
+
+  /// A server and a client in the same process, both are updated manually on the calling thread.
+  class LoopbackConnection
+  {
+  public:
+    LoopbackConnection(const ezNetworkBatchingSettings& serverSettings, const ezNetworkBatchingSettings& clientSettings)
+    {
+      m_pServer = ezRemoteInterfaceEnet::Make();
+      m_pClient = ezRemoteInterfaceEnet::Make();
+
+      m_pServer->SetBatchingSettings(serverSettings);
+      m_pClient->SetBatchingSettings(clientSettings);
+
+      m_pServer->SetMessageHandler(s_uiSystemID, ezMakeDelegate(&TestReceiver::OnMessage, &m_ServerReceiver));
+      m_pClient->SetMessageHandler(s_uiSystemID, ezMakeDelegate(&TestReceiver::OnMessage, &m_ClientReceiver));
+    }
+
+    ~LoopbackConnection()
+    {
+      m_pClient->ShutdownConnection();
+      m_pServer->ShutdownConnection();
+    }
+
+    ezResult Connect()
+    {
+      EZ_SUCCEED_OR_RETURN(m_pServer->StartServer(s_uiConnectionToken, "1060", false));
+      EZ_SUCCEED_OR_RETURN(m_pClient->ConnectToServer(s_uiConnectionToken, "localhost:1060", false));
+
+      return Update([this]() { return m_pClient->IsConnectedToServer() && m_pServer->IsConnectedToClients(); });
+    }
+
+    template <typename Condition>
+    ezResult Update(Condition condition)
+    {
+      const ezTime tStart = ezTime::Now();
+
+      while (!condition())
+      {
+        if (ezTime::Now() - tStart > ezTime::MakeFromSeconds(10))
+          return EZ_FAILURE;
+
+        m_pClient->UpdateRemoteInterface();
+        m_pServer->UpdateRemoteInterface();
+        m_pServer->ExecuteAllMessageHandlers();
+        m_pClient->ExecuteAllMessageHandlers();
+      }
+
+      return EZ_SUCCESS;
+    }
+
+    ezUniquePtr<ezRemoteInterfaceEnet> m_pServer;
+    ezUniquePtr<ezRemoteInterfaceEnet> m_pClient;
+    TestReceiver m_ServerReceiver;
+    TestReceiver m_ClientReceiver;
+  };
+
+  /// Sends many small messages, similar to the per-frame statistics of the inspector.
+  void SendSmallMessages(ezRemoteInterface& ref_sender, ezUInt32 uiNumMessages, ezRemoteTransmitMode tm = ezRemoteTransmitMode::Reliable)
+  {
+    for (ezUInt32 i = 0; i < uiNumMessages; ++i)
+    {
+      ezRemoteMessage msg(s_uiSystemID, 'SMLL');
+      msg.GetWriter() << i;
+      msg.GetWriter() << static_cast<float>(i) * 0.5f;
+      msg.GetWriter() << "Stat";
+
+      ref_sender.Send(tm, msg);
+    }
+  }
+
+  struct ThroughputResult
+  {
+    ezTime m_Duration;
+    ezNetworkTrafficStats m_Stats;
+  };
+
+  ThroughputResult MeasureThroughput(const ezNetworkBatchingSettings& settings, ezUInt32 uiNumMessages)
+  {
+    ThroughputResult res;
+
+    LoopbackConnection con(settings, settings);
+    if (!EZ_TEST_BOOL(con.Connect().Succeeded()))
+      return res;
+
+    const ezNetworkTrafficStats statsBefore = con.m_pServer->GetTrafficStats();
+
+    // the time covers the work of both sides, until everything has been received
+    ezStopwatch sw;
+
+    SendSmallMessages(*con.m_pServer, uiNumMessages);
+    EZ_TEST_BOOL(con.Update([&]() { return con.m_ClientReceiver.m_uiNumReceived == uiNumMessages; }).Succeeded());
+
+    res.m_Duration = sw.GetRunningTotal();
+    res.m_Stats = con.m_pServer->GetTrafficStats();
+    res.m_Stats.m_uiMessagesSent -= statsBefore.m_uiMessagesSent;
+    res.m_Stats.m_uiPacketsSent -= statsBefore.m_uiPacketsSent;
+    res.m_Stats.m_uiBytesSent -= statsBefore.m_uiBytesSent;
+
+    EZ_TEST_BOOL(con.m_ClientReceiver.m_bInOrder);
+    return res;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Communication, RemoteInterface)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezNetworkMessageBatch")
+  {
+    ezNetworkMessageBatch batch(8);
+    EZ_TEST_BOOL(batch.IsEmpty());
+
+    const char* szText = "Some text that is long enough to be compressed. Some text that is long enough to be compressed.";
+    for (ezUInt32 i = 0; i < 100; ++i)
+    {
+      batch.AddMessage(i, 'MSG1', ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szText), i % 50));
+    }
+
+    batch.AddMessage(1234, 'EMPT', {});
+
+    EZ_TEST_INT(batch.GetNumMessages(), 101);
+
+    for (ezUInt32 uiThreshold : {0u, 1024u})
+    {
+      ezUInt32 uiMsgID = 0;
+      ezArrayPtr<ezUInt8> packet = batch.GetPacket(uiThreshold, uiMsgID);
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      EZ_TEST_INT(uiMsgID, uiThreshold == 0 ? ezNetworkMessageBatch::BatchMsgID : ezNetworkMessageBatch::CompressedBatchMsgID);
+#  endif
+
+      ezDynamicArray<ezUInt8> decompressed;
+      ezDynamicArray<ezNetworkMessageBatch::Message> messages;
+      if (EZ_TEST_BOOL(ezNetworkMessageBatch::Unpack(uiMsgID, packet.GetSubArray(8), decompressed, messages).Succeeded()))
+      {
+        if (EZ_TEST_INT(messages.GetCount(), 101))
+        {
+          for (ezUInt32 i = 0; i < 100; ++i)
+          {
+            EZ_TEST_INT(messages[i].m_uiSystemID, i);
+            EZ_TEST_INT(messages[i].m_uiMsgID, 'MSG1');
+            EZ_TEST_BOOL(messages[i].m_Data == ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(szText), i % 50));
+          }
+
+          EZ_TEST_INT(messages[100].m_uiSystemID, 1234);
+          EZ_TEST_INT(messages[100].m_uiMsgID, 'EMPT');
+          EZ_TEST_BOOL(messages[100].m_Data.IsEmpty());
+        }
+      }
+
+      // truncated data must be detected
+      EZ_TEST_BOOL(ezNetworkMessageBatch::Unpack(ezNetworkMessageBatch::BatchMsgID, batch.GetPacket(0, uiMsgID).GetSubArray(8, 100), decompressed, messages).Failed());
+    }
+
+    batch.Clear();
+    EZ_TEST_BOOL(batch.IsEmpty());
+    EZ_TEST_INT(batch.GetPacketSize(), 8);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Combined Messages")
+  {
+    LoopbackConnection con({}, {});
+    if (EZ_TEST_BOOL(con.Connect().Succeeded()))
+    {
+      const ezUInt32 uiNumMessages = 10000;
+
+      SendSmallMessages(*con.m_pClient, uiNumMessages);
+      SendSmallMessages(*con.m_pServer, uiNumMessages);
+
+      EZ_TEST_BOOL(con.Update([&]() { return con.m_ServerReceiver.m_uiNumReceived == uiNumMessages && con.m_ClientReceiver.m_uiNumReceived == uiNumMessages; }).Succeeded());
+
+      EZ_TEST_BOOL(con.m_ServerReceiver.m_bInOrder);
+      EZ_TEST_BOOL(con.m_ClientReceiver.m_bInOrder);
+
+      // the handshake messages are counted as well
+      EZ_TEST_BOOL(con.m_pClient->GetTrafficStats().m_uiMessagesSent > uiNumMessages);
+      EZ_TEST_BOOL(con.m_pServer->GetTrafficStats().m_uiMessagesSent > uiNumMessages);
+      EZ_TEST_BOOL(con.m_pClient->GetTrafficStats().m_uiPacketsSent < uiNumMessages / 50);
+      EZ_TEST_BOOL(con.m_pServer->GetTrafficStats().m_uiPacketsSent < uiNumMessages / 50);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unreliable Batch Size")
+  {
+    ezNetworkBatchingSettings settings;
+    settings.m_uiMaxUnreliableBatchSize = 256;
+
+    LoopbackConnection con(settings, settings);
+    if (EZ_TEST_BOOL(con.Connect().Succeeded()))
+    {
+      const ezNetworkTrafficStats statsBefore = con.m_pClient->GetTrafficStats();
+
+      // 12 bytes of message header and 16 bytes of data each
+      const ezUInt32 uiNumMessages = 100;
+      SendSmallMessages(*con.m_pClient, uiNumMessages, ezRemoteTransmitMode::Unreliable);
+      con.m_pClient->UpdateRemoteInterface();
+
+      const ezUInt64 uiPackets = con.m_pClient->GetTrafficStats().m_uiPacketsSent - statsBefore.m_uiPacketsSent;
+      const ezUInt64 uiBytes = con.m_pClient->GetTrafficStats().m_uiBytesSent - statsBefore.m_uiBytesSent;
+
+      EZ_TEST_BOOL(uiPackets >= uiNumMessages * 28 / 256);
+      EZ_TEST_BOOL(uiPackets < uiNumMessages / 4);
+      EZ_TEST_BOOL(uiBytes <= uiPackets * 256);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Large Messages")
+  {
+    LoopbackConnection con({}, {});
+    if (EZ_TEST_BOOL(con.Connect().Succeeded()))
+    {
+      const ezNetworkTrafficStats statsBefore = con.m_pClient->GetTrafficStats();
+
+      ezRemoteMessage compressible(s_uiSystemID, 'LRGE');
+      compressible.GetWriter() << 0u;
+      for (ezUInt32 i = 0; i < 10000; ++i)
+      {
+        compressible.GetWriter() << (i % 100);
+      }
+
+      ezRemoteMessage random(s_uiSystemID, 'LRGE');
+      random.GetWriter() << 1u;
+      ezUInt32 uiValue = 42;
+      for (ezUInt32 i = 0; i < 10000; ++i)
+      {
+        uiValue = uiValue * 1664525u + 1013904223u;
+        random.GetWriter() << uiValue;
+      }
+
+      con.m_pClient->Send(ezRemoteTransmitMode::Reliable, compressible);
+      EZ_TEST_BOOL(con.Update([&]() { return con.m_ServerReceiver.m_uiNumReceived == 1; }).Succeeded());
+      EZ_TEST_BOOL(con.m_ServerReceiver.m_LastLargeMessage.GetArrayPtr() == compressible.GetMessageData());
+
+      const ezUInt64 uiCompressibleBytes = con.m_pClient->GetTrafficStats().m_uiBytesSent - statsBefore.m_uiBytesSent;
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+      EZ_TEST_BOOL(uiCompressibleBytes < compressible.GetMessageData().GetCount() / 4);
+#  else
+      EZ_TEST_BOOL(uiCompressibleBytes > compressible.GetMessageData().GetCount());
+#  endif
+
+      con.m_pClient->Send(ezRemoteTransmitMode::Reliable, random);
+      EZ_TEST_BOOL(con.Update([&]() { return con.m_ServerReceiver.m_uiNumReceived == 2; }).Succeeded());
+      EZ_TEST_BOOL(con.m_ServerReceiver.m_LastLargeMessage.GetArrayPtr() == random.GetMessageData());
+
+      EZ_TEST_BOOL(con.m_ServerReceiver.m_bInOrder);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Peer Without Batching")
+  {
+    // a peer that has batching disabled behaves like an application that doesn't know about it
+    ezNetworkBatchingSettings oldPeer;
+    oldPeer.m_bCombineMessages = false;
+
+    for (ezUInt32 uiOldSide = 0; uiOldSide < 2; ++uiOldSide)
+    {
+      LoopbackConnection con(uiOldSide == 0 ? oldPeer : ezNetworkBatchingSettings(), uiOldSide == 1 ? oldPeer : ezNetworkBatchingSettings());
+      if (!EZ_TEST_BOOL(con.Connect().Succeeded()))
+        continue;
+
+      const ezUInt32 uiNumMessages = 500;
+
+      SendSmallMessages(*con.m_pClient, uiNumMessages);
+      SendSmallMessages(*con.m_pServer, uiNumMessages);
+
+      EZ_TEST_BOOL(con.Update([&]() { return con.m_ServerReceiver.m_uiNumReceived == uiNumMessages && con.m_ClientReceiver.m_uiNumReceived == uiNumMessages; }).Succeeded());
+
+      EZ_TEST_BOOL(con.m_ServerReceiver.m_bInOrder);
+      EZ_TEST_BOOL(con.m_ClientReceiver.m_bInOrder);
+
+      // every message was sent as its own packet, in both directions
+      EZ_TEST_INT(con.m_pClient->GetTrafficStats().m_uiPacketsSent, con.m_pClient->GetTrafficStats().m_uiMessagesSent);
+      EZ_TEST_INT(con.m_pServer->GetTrafficStats().m_uiPacketsSent, con.m_pServer->GetTrafficStats().m_uiMessagesSent);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Throughput")
+  {
+    const ezUInt32 uiNumMessages = 10000;
+
+    ezNetworkBatchingSettings separate;
+    separate.m_bCombineMessages = false;
+
+    const ThroughputResult resSeparate = MeasureThroughput(separate, uiNumMessages);
+    const ThroughputResult resCombined = MeasureThroughput(ezNetworkBatchingSettings(), uiNumMessages);
+
+    EZ_TEST_BOOL(resCombined.m_Stats.m_uiPacketsSent * 50 < resSeparate.m_Stats.m_uiPacketsSent);
+    EZ_TEST_BOOL(resCombined.m_Stats.m_uiBytesSent < resSeparate.m_Stats.m_uiBytesSent);
+
+    for (const ThroughputResult* pRes : {&resSeparate, &resCombined})
+    {
+      ezLog::Info("[test]{} {} messages: {} packets, {} bytes, {} for sending and receiving ({} messages/sec)", pRes == &resSeparate ? "Separate" : "Combined", pRes->m_Stats.m_uiMessagesSent, pRes->m_Stats.m_uiPacketsSent,
+        pRes->m_Stats.m_uiBytesSent, pRes->m_Duration, ezArgF(pRes->m_Stats.m_uiMessagesSent / ezMath::Max(pRes->m_Duration.GetSeconds(), 0.001), 0));
+    }
+  }
+}
+
+#endif
@@ -0,0 +1,240 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/Archive/ArchiveUtils.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Time/Stopwatch.h>
+
+#if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+
+namespace
+{
+  void WriteSourceFile(ezStringView sPath, ezUInt32 uiSize, ezUInt32 uiSeed, ezDynamicArray<ezUInt8>& out_data)
+  {
+    out_data.SetCountUninitialized(uiSize);
+
+    ezUInt32 uiValue = uiSeed;
+    for (ezUInt32 i = 0; i < uiSize; ++i)
+    {
+      uiValue = uiValue * 1664525u + 1013904223u;
+      out_data[i] = static_cast<ezUInt8>(uiValue >> 24);
+    }
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write(out_data.GetData(), out_data.GetCount()).Succeeded());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveMappedData)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("ArchiveMappedData");
+  sOutputFolder.MakeCleanPath();
+
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveMappedData", "mappedout", ezFileSystem::AllowWrites).Succeeded()))
+    return;
+
+  const ezUInt32 uiAlignment = 256;
+  const ezUInt32 uiLargeFileSize = 32 * 1024 * 1024;
+  const ezUInt32 uiFileSizes[] = {13, 1000, 4097, 77};
+
+  ezDynamicArray<ezUInt8> largeData;
+  ezDynamicArray<ezDynamicArray<ezUInt8>> smallData;
+
+  const ezStringBuilder sArchive(sOutputFolder, "/Mapped.ezArchive");
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Build Aligned Archive")
+  {
+    ezArchiveBuilder builder;
+    builder.m_uiDataAlignment = uiAlignment;
+
+    ezStringBuilder sPath;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(uiFileSizes); ++i)
+    {
+      sPath.Format("{}/Source/File{}.bin", sOutputFolder, i);
+      WriteSourceFile(sPath, uiFileSizes[i], i, smallData.ExpandAndGetRef());
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = sPath;
+      sPath.Format("File{}.bin", i);
+      e.m_sRelTargetPath = sPath;
+    }
+
+    {
+      sPath.Set(sOutputFolder, "/Source/Large.bin");
+      WriteSourceFile(sPath, uiLargeFileSize, 42, largeData);
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = sPath;
+      e.m_sRelTargetPath = "Large.bin";
+    }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    {
+      // compressed entries cannot be accessed in place
+      sPath.Set(sOutputFolder, "/Source/Compressed.txt");
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        EZ_TEST_BOOL(file.Write("compressible text ", 18).Succeeded());
+      }
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = sPath;
+      e.m_sRelTargetPath = "Compressed.txt";
+      e.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd;
+      e.m_iCompressionLevel = 1;
+    }
+#  endif
+
+    EZ_TEST_BOOL(builder.WriteArchive(":mappedout/Mapped.ezArchive").Succeeded());
+
+    ezArchiveReader reader;
+    if (EZ_TEST_BOOL(reader.OpenArchive(sArchive).Succeeded()))
+    {
+      for (const ezArchiveEntry& entry : reader.GetArchiveTOC().m_Entries)
+      {
+        EZ_TEST_INT((ezArchiveUtils::HeaderSize + entry.m_uiDataStartOffset) % uiAlignment, 0);
+      }
+    }
+  }
+
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchive, "ArchiveMappedData", "mapped").Succeeded()))
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "GetMappedFileData")
+  {
+    ezStringBuilder sPath;
+
+    for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(uiFileSizes); ++i)
+    {
+      sPath.Format(":mapped/File{}.bin", i);
+
+      ezFileReader file;
+      if (!EZ_TEST_BOOL(file.Open(sPath).Succeeded()))
+        continue;
+
+      ezArrayPtr<const ezUInt8> mapped = file.GetMappedFileData();
+      EZ_TEST_INT(mapped.GetCount(), uiFileSizes[i]);
+      EZ_TEST_BOOL(ezMemoryUtils::IsAligned(mapped.GetPtr(), uiAlignment));
+      EZ_TEST_BOOL(mapped == smallData[i].GetArrayPtr());
+
+      // reading through the stream interface works as well and returns the same data
+      ezDynamicArray<ezUInt8> content;
+      content.SetCountUninitialized(uiFileSizes[i] + 10);
+      EZ_TEST_INT(file.ReadBytes(content.GetData(), 7), 7);
+      EZ_TEST_INT(file.ReadBytes(content.GetData() + 7, content.GetCount() - 7), uiFileSizes[i] - 7);
+      EZ_TEST_INT(file.ReadBytes(content.GetData(), 1), 0);
+      content.SetCount(uiFileSizes[i]);
+      EZ_TEST_BOOL(content == smallData[i]);
+    }
+
+#  ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+    {
+      ezFileReader file;
+      if (EZ_TEST_BOOL(file.Open(":mapped/Compressed.txt").Succeeded()))
+      {
+        EZ_TEST_BOOL(file.GetMappedFileData().IsEmpty());
+        EZ_TEST_INT(file.GetFileSize(), 18 * 1000);
+
+        char szText[18];
+        EZ_TEST_INT(file.ReadBytes(szText, 18), 18);
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szText, "compressible text ", 18));
+      }
+    }
+#  endif
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Allocations and Time")
+  {
+    ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+
+    ezUInt64 uiCopyAllocations = 0;
+    ezUInt64 uiCopyBytes = 0;
+    ezTime tCopy;
+
+    ezUInt64 uiMappedAllocations = 0;
+    ezUInt64 uiMappedBytes = 0;
+    ezTime tMapped;
+
+    // the way the data used to be loaded: read everything into a temporary buffer
+    {
+      const ezAllocatorBase::Stats before = pAllocator->GetStats();
+      ezStopwatch sw;
+
+      ezDynamicArray<ezUInt8> content;
+
+      {
+        ezFileReader file;
+        EZ_TEST_BOOL(file.Open(":mapped/Large.bin").Succeeded());
+
+        content.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+        EZ_TEST_INT(file.ReadBytes(content.GetData(), content.GetCount()), uiLargeFileSize);
+      }
+
+      tCopy = sw.GetRunningTotal();
+
+      const ezAllocatorBase::Stats after = pAllocator->GetStats();
+      uiCopyAllocations = after.m_uiNumAllocations - before.m_uiNumAllocations;
+      uiCopyBytes = after.m_uiAllocationSize - before.m_uiAllocationSize;
+
+      EZ_TEST_BOOL(content == largeData);
+    }
+
+    // use the data in place
+    {
+      const ezAllocatorBase::Stats before = pAllocator->GetStats();
+      ezStopwatch sw;
+
+      ezFileReader file;
+      EZ_TEST_BOOL(file.Open(":mapped/Large.bin").Succeeded());
+
+      ezArrayPtr<const ezUInt8> content = file.GetMappedFileData();
+
+      tMapped = sw.GetRunningTotal();
+
+      const ezAllocatorBase::Stats after = pAllocator->GetStats();
+      uiMappedAllocations = after.m_uiNumAllocations - before.m_uiNumAllocations;
+      uiMappedBytes = after.m_uiAllocationSize - before.m_uiAllocationSize;
+
+      EZ_TEST_BOOL(content == largeData.GetArrayPtr());
+    }
+
+    EZ_TEST_BOOL(uiCopyBytes >= uiLargeFileSize);
+    EZ_TEST_BOOL(uiMappedBytes < 4 * 1024);
+    EZ_TEST_BOOL(uiMappedAllocations < uiCopyAllocations);
+
+    ezLog::Info("[test]Loading {} MB: copy: {} allocations, {} bytes, {}. In place: {} allocations, {} bytes, {}", uiLargeFileSize / (1024 * 1024), uiCopyAllocations, uiCopyBytes, tCopy, uiMappedAllocations, uiMappedBytes, tMapped);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Pinned While Open")
+  {
+    ezFileReader file;
+    if (EZ_TEST_BOOL(file.Open(":mapped/File2.bin").Succeeded()))
+    {
+      ezArrayPtr<const ezUInt8> mapped = file.GetMappedFileData();
+
+      // the archive stays mapped until the file is closed
+      EZ_TEST_BOOL(ezFileSystem::RemoveDataDirectory("mapped"));
+      EZ_TEST_BOOL(ezFileSystem::FindDataDirectoryWithRoot("mapped") == nullptr);
+
+      EZ_TEST_BOOL(mapped == smallData[2].GetArrayPtr());
+
+      file.Close();
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("ArchiveMappedData");
+}
+
+#endif
@@ -0,0 +1,524 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/Archive/ArchiveBuilder.h>
+#include <Foundation/IO/Archive/ArchiveReader.h>
+#include <Foundation/IO/Archive/ArchiveSeekableZstd.h>
+#include <Foundation/IO/CompressedStreamZstd.h>
+#include <Foundation/IO/FileSystem/FileReader.h>
+#include <Foundation/IO/FileSystem/FileSystem.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ZSTD_SUPPORT
+
+namespace
+{
+  // compressible, but not trivially: short random runs mixed with repetitions of earlier data
+  void GenerateTestData(ezDynamicArray<ezUInt8>& out_data, ezUInt32 uiSize, ezUInt32 uiSeed)
+  {
+    out_data.SetCountUninitialized(uiSize);
+
+    ezUInt32 uiState = uiSeed * 747796405u + 2891336453u;
+    auto Rand = [&]() {
+      uiState = uiState * 1664525u + 1013904223u;
+      return uiState >> 8;
+    };
+
+    ezUInt32 uiPos = 0;
+    while (uiPos < uiSize)
+    {
+      const ezUInt32 uiRun = ezMath::Min(uiSize - uiPos, 8 + Rand() % 64);
+
+      if (uiPos > 1024 && (Rand() % 4) != 0)
+      {
+        const ezUInt32 uiSrc = Rand() % (uiPos - uiRun);
+        for (ezUInt32 i = 0; i < uiRun; ++i)
+        {
+          out_data[uiPos + i] = out_data[uiSrc + i];
+        }
+      }
+      else
+      {
+        for (ezUInt32 i = 0; i < uiRun; ++i)
+        {
+          out_data[uiPos + i] = static_cast<ezUInt8>('a' + Rand() % 26);
+        }
+      }
+
+      uiPos += uiRun;
+    }
+  }
+
+  // small text files with a lot of common structure, like many small asset files would have
+  void GenerateSmallFile(ezStringBuilder& out_sText, ezUInt32 uiIndex)
+  {
+    out_sText.Clear();
+    out_sText.AppendFormat("{{\n  \"Type\": \"ezMaterialResource\",\n  \"Guid\": \"{}-{}\",\n", uiIndex * 7919, uiIndex * 31);
+
+    for (ezUInt32 i = 0; i < 8 + uiIndex % 5; ++i)
+    {
+      out_sText.AppendFormat("  \"Parameter{}\": {{ \"Value\": {}, \"Default\": 1.0, \"Shader\": \"Shaders/Materials/DefaultMaterial.ezShader\" }},\n", i, (uiIndex * 13 + i) % 100);
+    }
+
+    out_sText.Append("  \"BaseMaterial\": \"Materials/Common/Default.ezMaterial\"\n}\n");
+  }
+
+  void Compress(ezArrayPtr<const ezUInt8> data, ezDynamicArray<ezUInt8>& out_compressed, const ezArchiveZstdDictionary* pDictionary, ezUInt32 uiFrameSize = ezArchiveSeekableZstdWriter::DefaultFrameSize)
+  {
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter memWriter(&storage);
+
+    ezArchiveSeekableZstdWriter writer;
+    writer.SetOutputStream(&memWriter, 3, pDictionary, uiFrameSize);
+
+    // odd write sizes, so that frames are assembled from multiple writes
+    for (ezUInt32 uiPos = 0; uiPos < data.GetCount();)
+    {
+      const ezUInt32 uiWrite = ezMath::Min(data.GetCount() - uiPos, 12345u);
+      EZ_TEST_BOOL(writer.WriteBytes(data.GetPtr() + uiPos, uiWrite).Succeeded());
+      uiPos += uiWrite;
+    }
+
+    EZ_TEST_BOOL(writer.FinishCompressedStream().Succeeded());
+    EZ_TEST_INT(writer.GetUncompressedSize(), data.GetCount());
+    EZ_TEST_INT(writer.GetWrittenBytes(), storage.GetStorageSize64());
+
+    out_compressed.SetCountUninitialized(storage.GetStorageSize32());
+    ezMemoryStreamReader memReader(&storage);
+    memReader.ReadBytes(out_compressed.GetData(), out_compressed.GetCount());
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, ArchiveSeekableZstd)
+{
+  const ezUInt32 uiFrameSize = 64 * 1024;
+
+  ezDynamicArray<ezUInt8> data;
+  GenerateTestData(data, 1024 * 1024 + 1234, 1);
+
+  ezDynamicArray<ezUInt8> compressed;
+  Compress(data, compressed, nullptr, uiFrameSize);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Round Trip")
+  {
+    EZ_TEST_BOOL(compressed.GetCount() < data.GetCount());
+
+    ezArchiveSeekableZstdReader reader;
+    EZ_TEST_BOOL(reader.SetInputData(compressed).Succeeded());
+    EZ_TEST_INT(reader.GetUncompressedSize(), data.GetCount());
+    EZ_TEST_INT(reader.GetNumFrames(), 17);
+    EZ_TEST_BOOL(!reader.UsesDictionary());
+
+    ezDynamicArray<ezUInt8> result;
+    result.SetCountUninitialized(data.GetCount() + 100);
+
+    ezUInt64 uiRead = 0;
+    ezUInt32 uiChunk = 1;
+    while (true)
+    {
+      const ezUInt64 uiNow = reader.ReadBytes(result.GetData() + uiRead, ezMath::Min<ezUInt64>(uiChunk, result.GetCount() - uiRead));
+      if (uiNow == 0)
+        break;
+
+      uiRead += uiNow;
+      uiChunk = (uiChunk * 3 + 7) % 100000;
+    }
+
+    EZ_TEST_INT(uiRead, data.GetCount());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data.GetData(), data.GetCount()));
+
+    // the same reader can be used for other data
+    ezDynamicArray<ezUInt8> data2;
+    GenerateTestData(data2, 1000, 2);
+
+    ezDynamicArray<ezUInt8> compressed2;
+    Compress(data2, compressed2, nullptr, uiFrameSize);
+
+    EZ_TEST_BOOL(reader.SetInputData(compressed2).Succeeded());
+    EZ_TEST_INT(reader.GetNumFrames(), 1);
+    EZ_TEST_INT(reader.ReadBytes(result.GetData(), result.GetCount()), data2.GetCount());
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data2.GetData(), data2.GetCount()));
+
+    // empty data
+    ezDynamicArray<ezUInt8> compressed3;
+    Compress(ezArrayPtr<const ezUInt8>(), compressed3, nullptr);
+
+    EZ_TEST_BOOL(reader.SetInputData(compressed3).Succeeded());
+    EZ_TEST_INT(reader.GetUncompressedSize(), 0);
+    EZ_TEST_INT(reader.ReadBytes(result.GetData(), result.GetCount()), 0);
+
+    // corrupted seek table
+    {
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+      log.ExpectMessage("Seek table not found", ezLogMsgType::ErrorMsg);
+
+      compressed2.PopBack();
+      EZ_TEST_BOOL(reader.SetInputData(compressed2).Failed());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Random Access")
+  {
+    ezArchiveSeekableZstdReader reader;
+    EZ_TEST_BOOL(reader.SetInputData(compressed).Succeeded());
+
+    ezDynamicArray<ezUInt8> result;
+    result.SetCountUninitialized(data.GetCount());
+
+    struct Range
+    {
+      ezUInt64 m_uiOffset;
+      ezUInt64 m_uiSize;
+    };
+
+    const Range ranges[] = {
+      {0, 10},                                // start of the first frame
+      {uiFrameSize - 5, 10},                  // across a frame border
+      {uiFrameSize, uiFrameSize},             // exactly one frame
+      {3 * uiFrameSize + 17, 5 * uiFrameSize}, // partial frames around multiple full ones (decompressed in parallel)
+      {1000, data.GetCount() - 1000},         // up to the end
+      {data.GetCount() - 3, 100},             // cut off at the end
+      {0, data.GetCount()},                   // everything
+    };
+
+    for (const Range& r : ranges)
+    {
+      const ezUInt64 uiExpected = ezMath::Min<ezUInt64>(r.m_uiSize, data.GetCount() - r.m_uiOffset);
+
+      ezMemoryUtils::ZeroFill(result.GetData(), result.GetCount());
+
+      EZ_TEST_INT(reader.ReadAt(r.m_uiOffset, result.GetData(), ezMath::Min<ezUInt64>(r.m_uiSize, result.GetCount())), uiExpected);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data.GetData() + r.m_uiOffset, static_cast<size_t>(uiExpected)));
+    }
+
+    // beyond the end
+    EZ_TEST_INT(reader.ReadAt(data.GetCount(), result.GetData(), 10), 0);
+    EZ_TEST_INT(reader.ReadAt(data.GetCount() + 100, result.GetData(), 10), 0);
+
+    // ReadAt doesn't change the read position
+    EZ_TEST_INT(reader.GetReadPosition(), 0);
+
+    // skipping doesn't decompress anything, reading continues at the new position
+    EZ_TEST_INT(reader.SkipBytes(5 * uiFrameSize + 3), 5 * uiFrameSize + 3);
+    EZ_TEST_INT(reader.ReadBytes(result.GetData(), 100), 100);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data.GetData() + 5 * uiFrameSize + 3, 100));
+
+    reader.SetReadPosition(42);
+    EZ_TEST_INT(reader.ReadBytes(result.GetData(), 100), 100);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data.GetData() + 42, 100));
+
+    EZ_TEST_INT(reader.SkipBytes(data.GetCount()), data.GetCount() - 142);
+    EZ_TEST_INT(reader.ReadBytes(result.GetData(), 100), 0);
+  }
+
+  ezDynamicArray<ezDynamicArray<ezUInt8>> smallFiles;
+  {
+    ezStringBuilder sText;
+    for (ezUInt32 i = 0; i < 200; ++i)
+    {
+      GenerateSmallFile(sText, i);
+      smallFiles.ExpandAndGetRef().PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Dictionary")
+  {
+    ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+    for (const auto& file : smallFiles)
+    {
+      samples.PushBack(file.GetArrayPtr());
+    }
+
+    ezDynamicArray<ezUInt8> dictionaryData;
+    ezArchiveZstdDictionary::Train(samples, 4 * 1024, dictionaryData);
+    EZ_TEST_BOOL(!dictionaryData.IsEmpty());
+    EZ_TEST_BOOL(dictionaryData.GetCount() <= 4 * 1024);
+
+    ezArchiveZstdDictionary dictionary;
+    EZ_TEST_BOOL(dictionary.InitializeForWriting(dictionaryData, 3).Succeeded());
+    EZ_TEST_BOOL(dictionary.IsValid());
+    EZ_TEST_INT(dictionary.GetCompressionLevel(), 3);
+
+    ezArchiveZstdDictionary readDictionary;
+    EZ_TEST_BOOL(readDictionary.InitializeForReading(dictionaryData).Succeeded());
+
+    ezUInt64 uiSizeWithout = 0;
+    ezUInt64 uiSizeWith = 0;
+
+    ezDynamicArray<ezUInt8> compressedSmall;
+    ezDynamicArray<ezUInt8> result;
+
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+    log.ExpectMessage("no dictionary is available", ezLogMsgType::ErrorMsg, 10);
+
+    // also test files that were not part of the training data
+    for (ezUInt32 i = 190; i < smallFiles.GetCount(); ++i)
+    {
+      const auto& file = smallFiles[i];
+
+      Compress(file, compressedSmall, nullptr);
+      uiSizeWithout += compressedSmall.GetCount();
+
+      Compress(file, compressedSmall, &dictionary);
+      uiSizeWith += compressedSmall.GetCount();
+
+      EZ_TEST_BOOL(ezArchiveSeekableZstdReader::RequiresDictionary(compressedSmall));
+
+      ezArchiveSeekableZstdReader reader;
+      EZ_TEST_BOOL(reader.SetInputData(compressedSmall).Failed());
+      EZ_TEST_BOOL(reader.SetInputData(compressedSmall, &readDictionary).Succeeded());
+      EZ_TEST_BOOL(reader.UsesDictionary());
+
+      result.SetCountUninitialized(file.GetCount());
+      EZ_TEST_INT(reader.ReadBytes(result.GetData(), result.GetCount()), file.GetCount());
+      EZ_TEST_BOOL(result == file);
+    }
+
+    EZ_TEST_BOOL(uiSizeWith * 2 < uiSizeWithout);
+
+    EZ_TEST_BOOL(!ezArchiveSeekableZstdReader::RequiresDictionary(compressed));
+
+    dictionary.Clear();
+    EZ_TEST_BOOL(!dictionary.IsValid());
+  }
+
+#  if EZ_ENABLED(EZ_SUPPORTS_MEMORY_MAPPED_FILE)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Archive")
+  {
+    ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputFolder.AppendPath("ArchiveSeekableZstd");
+    sOutputFolder.MakeCleanPath();
+
+    ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+    ezOSFile::CreateDirectoryStructure(sOutputFolder).IgnoreResult();
+
+    if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "ArchiveSeekableZstd", "seekable", ezFileSystem::AllowWrites).Succeeded()))
+      return;
+
+    ezArchiveBuilder builder;
+    builder.m_uiZstdDictionarySize = 4 * 1024;
+
+    ezStringBuilder sPath;
+
+    // one large file, many small ones
+    {
+      sPath.Set(sOutputFolder, "/Source/Large.bin");
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write(data.GetData(), data.GetCount()).Succeeded());
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = sPath;
+      e.m_sRelTargetPath = "Large.bin";
+      e.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_seekable;
+      e.m_iCompressionLevel = 3;
+    }
+
+    for (ezUInt32 i = 0; i < smallFiles.GetCount(); ++i)
+    {
+      sPath.Format("{}/Source/Small/{}.json", sOutputFolder, i);
+
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+      EZ_TEST_BOOL(file.Write(smallFiles[i].GetData(), smallFiles[i].GetCount()).Succeeded());
+
+      auto& e = builder.m_Entries.ExpandAndGetRef();
+      e.m_sAbsSourcePath = sPath;
+      sPath.Format("Small/{}.json", i);
+      e.m_sRelTargetPath = sPath;
+      e.m_CompressionMode = ezArchiveCompressionMode::Compressed_zstd_seekable;
+      e.m_iCompressionLevel = 3;
+    }
+
+    EZ_TEST_BOOL(builder.WriteArchive(":seekable/Seekable.ezArchive").Succeeded());
+
+    ezStringBuilder sArchive(sOutputFolder, "/Seekable.ezArchive");
+
+    {
+      ezArchiveReader reader;
+      if (!EZ_TEST_BOOL(reader.OpenArchive(sArchive).Succeeded()))
+        return;
+
+      const ezArchiveTOC& toc = reader.GetArchiveTOC();
+      EZ_TEST_INT(toc.m_Entries.GetCount(), 1 + smallFiles.GetCount());
+      EZ_TEST_BOOL(toc.m_uiDictionaryDataSize > 0);
+      EZ_TEST_BOOL(reader.GetZstdDictionary() != nullptr);
+
+      const ezUInt32 uiLarge = toc.FindEntry("Large.bin");
+      if (EZ_TEST_BOOL(uiLarge != ezInvalidIndex))
+      {
+        EZ_TEST_BOOL(toc.m_Entries[uiLarge].m_CompressionMode == ezArchiveCompressionMode::Compressed_zstd_seekable);
+        EZ_TEST_INT(toc.m_Entries[uiLarge].m_uiUncompressedDataSize, data.GetCount());
+
+        ezDynamicArray<ezUInt8> result;
+        result.SetCountUninitialized(1000);
+        EZ_TEST_INT(reader.ReadEntryRange(uiLarge, 500000, result), 1000);
+        EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), data.GetData() + 500000, 1000));
+
+        EZ_TEST_INT(reader.ReadEntryRange(uiLarge, data.GetCount() - 10, result), 10);
+      }
+
+      ezDynamicArray<ezUInt8> result;
+      for (ezUInt32 i = 0; i < smallFiles.GetCount(); i += 17)
+      {
+        sPath.Format("Small/{}.json", i);
+        const ezUInt32 uiEntry = toc.FindEntry(sPath);
+
+        if (!EZ_TEST_BOOL(uiEntry != ezInvalidIndex))
+          continue;
+
+        ezUniquePtr<ezStreamReader> pEntryReader = reader.CreateEntryReader(uiEntry);
+        if (!EZ_TEST_BOOL(pEntryReader != nullptr))
+          continue;
+
+        result.SetCountUninitialized(smallFiles[i].GetCount());
+        EZ_TEST_INT(pEntryReader->ReadBytes(result.GetData(), result.GetCount()), smallFiles[i].GetCount());
+        EZ_TEST_BOOL(result == smallFiles[i]);
+      }
+    }
+
+    // read through the file system
+    if (EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sArchive, "ArchiveSeekableZstd", "seekarchive").Succeeded()))
+    {
+      ezDynamicArray<ezUInt8> result;
+      result.SetCountUninitialized(data.GetCount());
+
+      for (ezUInt32 uiRun = 0; uiRun < 2; ++uiRun)
+      {
+        ezFileReader file;
+        if (EZ_TEST_BOOL(file.Open(":seekarchive/Large.bin").Succeeded()))
+        {
+          EZ_TEST_INT(file.ReadBytes(result.GetData(), result.GetCount()), data.GetCount());
+          EZ_TEST_BOOL(result == data);
+        }
+
+        ezFileReader file2;
+        if (EZ_TEST_BOOL(file2.Open(":seekarchive/Small/3.json").Succeeded()))
+        {
+          EZ_TEST_INT(file2.GetFileSize(), smallFiles[3].GetCount());
+          EZ_TEST_INT(file2.ReadBytes(result.GetData(), smallFiles[3].GetCount()), smallFiles[3].GetCount());
+          EZ_TEST_BOOL(ezMemoryUtils::IsEqual(result.GetData(), smallFiles[3].GetData(), smallFiles[3].GetCount()));
+        }
+      }
+    }
+
+    ezFileSystem::RemoveDataDirectoryGroup("ArchiveSeekableZstd");
+    ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+  }
+#  endif
+
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Performance: Ratio and Throughput")
+  {
+    ezDynamicArray<ezUInt8> bigData;
+    GenerateTestData(bigData, 256 * 1024 * 1024, 3);
+
+    ezDynamicArray<ezUInt8> result;
+    result.SetCountUninitialized(bigData.GetCount());
+
+    // a single zstd stream, as used by Compressed_zstd
+    {
+      ezDefaultMemoryStreamStorage storage;
+      ezMemoryStreamWriter memWriter(&storage);
+
+      ezCompressedStreamWriterZstd writer;
+      writer.SetOutputStream(&memWriter, 12, ezCompressedStreamWriterZstd::Compression::Average);
+
+      ezStopwatch sw;
+      EZ_TEST_BOOL(writer.WriteBytes(bigData.GetData(), bigData.GetCount()).Succeeded());
+      EZ_TEST_BOOL(writer.FinishCompressedStream().Succeeded());
+      const ezTime tCompress = sw.Checkpoint();
+
+      ezMemoryStreamReader memReader(&storage);
+      ezCompressedStreamReaderZstd reader(&memReader);
+      EZ_TEST_INT(reader.ReadBytes(result.GetData(), result.GetCount()), bigData.GetCount());
+      const ezTime tDecompress = sw.Checkpoint();
+
+      ezLog::Info("[test]zstd stream: {}% of {}, compress {}, decompress {} ({} MB/s)", ezArgF(100.0 * storage.GetStorageSize64() / bigData.GetCount(), 1), ezArgFileSize(bigData.GetCount()), tCompress, tDecompress, ezArgF(bigData.GetCount() / tDecompress.GetSeconds() / (1024 * 1024), 0));
+    }
+
+    for (ezUInt32 uiBenchFrameSize : {64 * 1024u, 256 * 1024u, 1024 * 1024u})
+    {
+      ezStopwatch sw;
+
+      ezDynamicArray<ezUInt8> bigCompressed;
+      Compress(bigData, bigCompressed, nullptr, uiBenchFrameSize);
+      const ezTime tCompress = sw.Checkpoint();
+
+      ezArchiveSeekableZstdReader reader;
+      EZ_TEST_BOOL(reader.SetInputData(bigCompressed).Succeeded());
+
+      sw.Checkpoint();
+      EZ_TEST_INT(reader.ReadAt(0, result.GetData(), result.GetCount()), bigData.GetCount());
+      const ezTime tParallel = sw.Checkpoint();
+
+      for (ezUInt64 uiPos = 0; uiPos < result.GetCount(); uiPos += 8 * 1024)
+      {
+        reader.ReadBytes(result.GetData() + uiPos, 8 * 1024);
+      }
+      const ezTime tSequential = sw.Checkpoint();
+
+      // random 4 KB reads
+      for (ezUInt32 i = 0; i < 1000; ++i)
+      {
+        const ezUInt64 uiOffset = (static_cast<ezUInt64>(i) * 2654435761u) % (bigData.GetCount() - 4096);
+        reader.ReadAt(uiOffset, result.GetData(), 4096);
+      }
+      const ezTime tRandom = sw.Checkpoint();
+
+      ezLog::Info("[test]seekable zstd, {} frames: {}% of {}, compress {}, parallel decompress {} ({} MB/s), sequential {}, 1000 random reads {}", ezArgFileSize(uiBenchFrameSize), ezArgF(100.0 * bigCompressed.GetCount() / bigData.GetCount(), 1), ezArgFileSize(bigData.GetCount()), tCompress, tParallel, ezArgF(bigData.GetCount() / tParallel.GetSeconds() / (1024 * 1024), 0), tSequential, tRandom);
+    }
+
+    // small files with and without a shared dictionary
+    {
+      ezDynamicArray<ezDynamicArray<ezUInt8>> manySmallFiles;
+      ezDynamicArray<ezArrayPtr<const ezUInt8>> samples;
+      ezStringBuilder sText;
+      ezUInt64 uiTotalSize = 0;
+
+      for (ezUInt32 i = 0; i < 10000; ++i)
+      {
+        GenerateSmallFile(sText, i);
+        manySmallFiles.ExpandAndGetRef().PushBackRange(ezArrayPtr<const ezUInt8>(reinterpret_cast<const ezUInt8*>(sText.GetData()), sText.GetElementCount()));
+        uiTotalSize += sText.GetElementCount();
+      }
+
+      for (const auto& file : manySmallFiles)
+      {
+        samples.PushBack(file.GetArrayPtr());
+      }
+
+      for (ezUInt32 uiDictSize : {0u, 16 * 1024u, 64 * 1024u, 112 * 1024u})
+      {
+        ezStopwatch sw;
+
+        ezDynamicArray<ezUInt8> dictionaryData;
+        ezArchiveZstdDictionary dictionary;
+
+        if (uiDictSize > 0)
+        {
+          ezArchiveZstdDictionary::Train(samples, uiDictSize, dictionaryData);
+          EZ_TEST_BOOL(dictionary.InitializeForWriting(dictionaryData, 3).Succeeded());
+        }
+
+        const ezTime tTrain = sw.Checkpoint();
+
+        ezUInt64 uiCompressedSize = dictionaryData.GetCount();
+        ezDynamicArray<ezUInt8> compressedSmall;
+
+        for (const auto& file : manySmallFiles)
+        {
+          Compress(file, compressedSmall, dictionary.IsValid() ? &dictionary : nullptr);
+          uiCompressedSize += compressedSmall.GetCount();
+        }
+
+        ezLog::Info("[test]{} small files, dictionary {}: {}% of {}, training {}, compress {}", manySmallFiles.GetCount(), ezArgFileSize(dictionaryData.GetCount()), ezArgF(100.0 * uiCompressedSize / uiTotalSize, 1), ezArgFileSize(uiTotalSize), tTrain, sw.Checkpoint());
+      }
+    }
+  }
+}
+
+#endif
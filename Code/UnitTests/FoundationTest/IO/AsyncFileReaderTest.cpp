@@ -0,0 +1,253 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/AsyncFileReader.h>
+#include <Foundation/IO/OSFile.h>
+#include <Foundation/Time/Stopwatch.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <fcntl.h>
+#endif
+
+namespace
+{
+  ezResult WriteTestFile(ezStringView sFile, ezUInt32 uiSize)
+  {
+    ezDynamicArray<ezUInt8> data;
+    data.SetCountUninitialized(uiSize);
+
+    for (ezUInt32 i = 0; i < uiSize; ++i)
+    {
+      data[i] = static_cast<ezUInt8>((i * 7) ^ (i >> 8));
+    }
+
+    ezOSFile file;
+    EZ_SUCCEED_OR_RETURN(file.Open(sFile, ezFileOpenMode::Write));
+    return file.Write(data.GetData(), data.GetCount());
+  }
+
+  bool IsExpectedContent(const ezUInt8* pData, ezUInt64 uiOffset, ezUInt64 uiBytes)
+  {
+    for (ezUInt64 i = 0; i < uiBytes; ++i)
+    {
+      const ezUInt32 uiPos = static_cast<ezUInt32>(uiOffset + i);
+      if (pData[i] != static_cast<ezUInt8>((uiPos * 7) ^ (uiPos >> 8)))
+        return false;
+    }
+
+    return true;
+  }
+
+  void TestBackend(ezStringView sFile, ezUInt32 uiFileSize, ezAsyncFileReader::Backend backend)
+  {
+    ezAsyncFileReader reader;
+    EZ_TEST_BOOL(reader.Open(sFile, 8, backend).Succeeded());
+    EZ_TEST_BOOL(reader.IsOpen());
+    EZ_TEST_INT(reader.GetFileSize(), uiFileSize);
+
+    // more requests than the queue depth, the last one is cut off by the end of the file
+    const ezUInt32 uiChunkSize = 4096;
+    const ezUInt32 uiNumChunks = (uiFileSize + uiChunkSize - 1) / uiChunkSize;
+
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCount(uiNumChunks * uiChunkSize);
+
+    ezDynamicArray<ezAsyncFileReadRequest> requests;
+    for (ezUInt32 i = 0; i < uiNumChunks; ++i)
+    {
+      ezAsyncFileReadRequest& req = requests.ExpandAndGetRef();
+      req.m_uiOffset = i * uiChunkSize;
+      req.m_Buffer = buffer.GetArrayPtr().GetSubArray(i * uiChunkSize, uiChunkSize);
+      req.m_uiUserData = i;
+    }
+
+    reader.Submit(requests);
+    EZ_TEST_INT(reader.GetNumOutstanding(), uiNumChunks);
+
+    ezDynamicArray<ezAsyncFileReadResult> results;
+    EZ_TEST_BOOL(reader.Poll(results, 1) >= 1);
+
+    reader.WaitForAll(results);
+    EZ_TEST_INT(reader.GetNumOutstanding(), 0);
+    EZ_TEST_INT(results.GetCount(), uiNumChunks);
+
+    ezUInt64 uiTotalBytes = 0;
+    for (const ezAsyncFileReadResult& res : results)
+    {
+      EZ_TEST_BOOL(res.m_Result.Succeeded());
+      EZ_TEST_BOOL(res.m_uiUserData < uiNumChunks);
+
+      const ezUInt64 uiExpected = ezMath::Min<ezUInt64>(uiChunkSize, uiFileSize - res.m_uiUserData * uiChunkSize);
+      EZ_TEST_INT(res.m_uiBytesRead, uiExpected);
+
+      uiTotalBytes += res.m_uiBytesRead;
+    }
+
+    EZ_TEST_INT(uiTotalBytes, uiFileSize);
+    EZ_TEST_BOOL(IsExpectedContent(buffer.GetData(), 0, uiFileSize));
+
+    // a read that starts beyond the end of the file returns zero bytes
+    {
+      ezUInt8 temp[16];
+      ezAsyncFileReadRequest req;
+      req.m_uiOffset = uiFileSize + 100;
+      req.m_Buffer = ezArrayPtr<ezUInt8>(temp);
+      req.m_uiUserData = 42;
+
+      reader.Submit(ezMakeArrayPtr(&req, 1));
+
+      results.Clear();
+      reader.WaitForAll(results);
+
+      if (EZ_TEST_INT(results.GetCount(), 1))
+      {
+        EZ_TEST_INT(results[0].m_uiUserData, 42);
+        EZ_TEST_INT(results[0].m_uiBytesRead, 0);
+      }
+    }
+
+    // results that were never polled are discarded
+    reader.Submit(requests);
+    reader.Close();
+    EZ_TEST_BOOL(!reader.IsOpen());
+    EZ_TEST_INT(reader.GetNumOutstanding(), 0);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(IO, AsyncFileReader)
+{
+  ezStringBuilder sOutputFile = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFile.MakeCleanPath();
+  sOutputFile.AppendPath("IO", "AsyncFileReader.bin");
+
+  const ezUInt32 uiFileSize = 100 * 1024 + 123;
+
+  if (!EZ_TEST_BOOL(WriteTestFile(sOutputFile, uiFileSize).Succeeded()))
+    return;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ThreadPool")
+  {
+    TestBackend(sOutputFile, uiFileSize, ezAsyncFileReader::Backend::ThreadPool);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "IoUring")
+  {
+    if (ezAsyncFileReader::IsIoUringSupported())
+    {
+      ezAsyncFileReader reader;
+      EZ_TEST_BOOL(reader.Open(sOutputFile, 4, ezAsyncFileReader::Backend::Default).Succeeded());
+      EZ_TEST_BOOL(reader.GetBackend() == ezAsyncFileReader::Backend::IoUring);
+      reader.Close();
+
+      TestBackend(sOutputFile, uiFileSize, ezAsyncFileReader::Backend::IoUring);
+
+      // the kernel can't write into an invalid buffer, the read fails instead of being retried forever
+      EZ_TEST_BOOL(reader.Open(sOutputFile, 4, ezAsyncFileReader::Backend::IoUring).Succeeded());
+      {
+        ezAsyncFileReadRequest req;
+        req.m_Buffer = ezArrayPtr<ezUInt8>(reinterpret_cast<ezUInt8*>(ezUInt64(16)), 1024);
+        req.m_uiUserData = 7;
+        reader.Submit(ezMakeArrayPtr(&req, 1));
+
+        ezDynamicArray<ezAsyncFileReadResult> results;
+        reader.WaitForAll(results);
+
+        if (EZ_TEST_INT(results.GetCount(), 1))
+        {
+          EZ_TEST_INT(results[0].m_uiUserData, 7);
+          EZ_TEST_BOOL(results[0].m_Result.Failed());
+        }
+      }
+      reader.Close();
+    }
+    else
+    {
+      // falls back to the thread pool
+      ezAsyncFileReader reader;
+      EZ_TEST_BOOL(reader.Open(sOutputFile, 4, ezAsyncFileReader::Backend::IoUring).Succeeded());
+      EZ_TEST_BOOL(reader.GetBackend() == ezAsyncFileReader::Backend::ThreadPool);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Open Invalid File")
+  {
+    ezAsyncFileReader reader;
+    EZ_TEST_BOOL(reader.Open(":does/not/exist.bin").Failed());
+    EZ_TEST_BOOL(!reader.IsOpen());
+  }
+
+  ezOSFile::DeleteFile(sOutputFile).IgnoreResult();
+
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Performance: Queue Depth")
+  {
+    ezStringBuilder sBigFile = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sBigFile.AppendPath("IO", "AsyncFileReaderPerf.bin");
+
+    const ezUInt32 uiBigFileSize = 256 * 1024 * 1024;
+    const ezUInt32 uiBlockSize = 64 * 1024;
+    const ezUInt32 uiNumBlocks = uiBigFileSize / uiBlockSize;
+
+    if (!EZ_TEST_BOOL(WriteTestFile(sBigFile, uiBigFileSize).Succeeded()))
+      return;
+
+    ezDynamicArray<ezUInt8> buffer;
+    buffer.SetCountUninitialized(uiBigFileSize);
+
+    // read the blocks in a shuffled order, like a resource loader would
+    ezDynamicArray<ezAsyncFileReadRequest> requests;
+    for (ezUInt32 i = 0; i < uiNumBlocks; ++i)
+    {
+      const ezUInt32 uiBlock = (i * 7919) % uiNumBlocks;
+
+      ezAsyncFileReadRequest& req = requests.ExpandAndGetRef();
+      req.m_uiOffset = static_cast<ezUInt64>(uiBlock) * uiBlockSize;
+      req.m_Buffer = buffer.GetArrayPtr().GetSubArray(uiBlock * uiBlockSize, uiBlockSize);
+      req.m_uiUserData = uiBlock;
+    }
+
+    ezDynamicArray<ezAsyncFileReadResult> results;
+    results.Reserve(uiNumBlocks);
+
+    for (ezUInt32 uiCold = 0; uiCold < 2; ++uiCold)
+    {
+      for (ezAsyncFileReader::Backend backend : {ezAsyncFileReader::Backend::ThreadPool, ezAsyncFileReader::Backend::IoUring})
+      {
+        if (backend == ezAsyncFileReader::Backend::IoUring && !ezAsyncFileReader::IsIoUringSupported())
+          continue;
+
+        for (ezUInt32 uiQueueDepth = 1; uiQueueDepth <= 64; uiQueueDepth *= 2)
+        {
+#if EZ_ENABLED(EZ_PLATFORM_LINUX)
+          if (uiCold)
+          {
+            // drop the file from the page cache, so that the reads have to go to the device
+            int fd = open(sBigFile.GetData(), O_RDONLY);
+            fdatasync(fd);
+            posix_fadvise(fd, 0, 0, POSIX_FADV_DONTNEED);
+            close(fd);
+          }
+#else
+          if (uiCold)
+            continue;
+#endif
+
+          ezAsyncFileReader reader;
+          if (!EZ_TEST_BOOL(reader.Open(sBigFile, uiQueueDepth, backend).Succeeded()))
+            return;
+
+          results.Clear();
+
+          ezStopwatch sw;
+          reader.Submit(requests);
+          reader.WaitForAll(results);
+          const ezTime t = sw.GetRunningTotal();
+
+          EZ_TEST_INT(results.GetCount(), uiNumBlocks);
+
+          ezLog::Info("[test]{} {} cache, QD {}: {} MB/s", backend == ezAsyncFileReader::Backend::IoUring ? "io_uring" : "thread pool", uiCold ? "cold" : "warm", uiQueueDepth, ezArgF((uiBigFileSize / (1024.0 * 1024.0)) / t.GetSeconds(), 1));
+        }
+      }
+    }
+
+    ezOSFile::DeleteFile(sBigFile).IgnoreResult();
+  }
+}
@@ -5,7 +5,9 @@
 #include <Foundation/IO/OpenDdlReader.h>
 #include <Foundation/IO/OpenDdlUtils.h>
 #include <Foundation/IO/OpenDdlWriter.h>
+#include <Foundation/Math/Random.h>
 #include <Foundation/Strings/StringUtils.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <FoundationTest/IO/JSONTestHelpers.h>
 #include <TestFramework/Utilities/TestLogInterface.h>
 
@@ -178,6 +180,140 @@ static void TestDoc(const ezOpenDdlReader& doc, const char* szOriginal)
   TestEqual(szOriginal, recreation);
 }
 
+
+/// Hands out the data in small pieces. With a maximum of one byte per read, the parser has to go through its byte-wise code path.
+class PieceWiseStringStream : public ezStreamReader
+{
+public:
+  PieceWiseStringStream(ezStringView sData, ezUInt32 uiMaxBytesPerRead)
+    : m_sData(sData)
+    , m_uiMaxBytesPerRead(uiMaxBytesPerRead)
+  {
+  }
+
+  virtual ezUInt64 ReadBytes(void* pReadBuffer, ezUInt64 uiBytesToRead) override
+  {
+    const ezUInt32 uiBytes = ezMath::Min<ezUInt32>((ezUInt32)uiBytesToRead, m_uiMaxBytesPerRead, m_sData.GetElementCount());
+
+    ezMemoryUtils::Copy((char*)pReadBuffer, m_sData.GetStartPointer(), uiBytes);
+    m_sData.Shrink(uiBytes, 0);
+
+    return uiBytes;
+  }
+
+private:
+  ezStringView m_sData;
+  ezUInt32 m_uiMaxBytesPerRead;
+};
+
+static ezUInt32 GetPrimitiveSize(ezOpenDdlPrimitiveType type)
+{
+  switch (type)
+  {
+    case ezOpenDdlPrimitiveType::Bool:
+      return sizeof(bool);
+    case ezOpenDdlPrimitiveType::Int8:
+    case ezOpenDdlPrimitiveType::UInt8:
+      return 1;
+    case ezOpenDdlPrimitiveType::Int16:
+    case ezOpenDdlPrimitiveType::UInt16:
+      return 2;
+    case ezOpenDdlPrimitiveType::Int32:
+    case ezOpenDdlPrimitiveType::UInt32:
+    case ezOpenDdlPrimitiveType::Float:
+      return 4;
+    case ezOpenDdlPrimitiveType::Int64:
+    case ezOpenDdlPrimitiveType::UInt64:
+    case ezOpenDdlPrimitiveType::Double:
+      return 8;
+    default:
+      return 0;
+  }
+}
+
+/// Checks that two element trees are identical, including the exact bits of all primitives.
+static bool CompareElements(const ezOpenDdlReaderElement* pElement1, const ezOpenDdlReaderElement* pElement2)
+{
+  if (pElement1->GetPrimitivesType() != pElement2->GetPrimitivesType() || pElement1->GetName() != pElement2->GetName() ||
+      pElement1->IsNameGlobal() != pElement2->IsNameGlobal() || pElement1->GetNumChildObjects() != pElement2->GetNumChildObjects() ||
+      pElement1->GetNumPrimitives() != pElement2->GetNumPrimitives())
+    return false;
+
+  if (pElement1->IsCustomType())
+  {
+    if (pElement1->GetCustomType() != pElement2->GetCustomType())
+      return false;
+
+    auto pChild1 = pElement1->GetFirstChild();
+    auto pChild2 = pElement2->GetFirstChild();
+
+    while (pChild1 && pChild2)
+    {
+      if (!CompareElements(pChild1, pChild2))
+        return false;
+
+      pChild1 = pChild1->GetSibling();
+      pChild2 = pChild2->GetSibling();
+    }
+
+    return pChild1 == pChild2;
+  }
+
+  if (pElement1->GetPrimitivesType() == ezOpenDdlPrimitiveType::String)
+  {
+    for (ezUInt32 i = 0; i < pElement1->GetNumPrimitives(); ++i)
+    {
+      if (pElement1->GetPrimitivesString()[i] != pElement2->GetPrimitivesString()[i])
+        return false;
+    }
+
+    return true;
+  }
+
+  const ezUInt32 uiBytes = pElement1->GetNumPrimitives() * GetPrimitiveSize(pElement1->GetPrimitivesType());
+  return uiBytes == 0 || ezMemoryUtils::IsEqual((const ezUInt8*)pElement1->GetPrimitivesBool(), (const ezUInt8*)pElement2->GetPrimitivesBool(), uiBytes);
+}
+
+/// Generates a document that looks like an ezAbstractObjectGraph scene, followed by mesh data stored as large primitive lists.
+static void GenerateSceneDocument(ezStringBuilder& out_sDocument, ezUInt32 uiNumObjects, ezUInt32 uiNumVertices)
+{
+  ezRandom rnd;
+  rnd.Initialize(42);
+
+  out_sDocument.Clear();
+  out_sDocument.Append("Objects\n{\n");
+
+  for (ezUInt32 i = 0; i < uiNumObjects; ++i)
+  {
+    out_sDocument.AppendFormat("\to\n\t{\n\t\tUuid %%id{u4{{0},{1}}}\n", rnd.UInt(), rnd.UInt());
+    out_sDocument.Append("\t\ts %t{\"ezGameObject\"}\n\t\tu3 %v{1}\n\t\tp\n\t\t{\n");
+    out_sDocument.AppendFormat("\t\t\ts %%Name{\"Object{0}\"}\n\t\t\tbool %%Active{true}\n", i);
+    out_sDocument.AppendFormat("\t\t\tVec3 %%LocalPosition{float{{0},{1},{2}}}\n", rnd.DoubleMinMax(-1000, 1000), rnd.DoubleMinMax(-1000, 1000), rnd.DoubleMinMax(-10, 10));
+    out_sDocument.AppendFormat("\t\t\tQuat %%LocalRotation{float{0,0,{0},{1}}}\n", rnd.DoubleMinMax(-1, 1), rnd.DoubleMinMax(-1, 1));
+    out_sDocument.Append("\t\t\tVec3 %LocalScaling{float{1,1,1}}\n\t\t\tfloat %LocalUniformScaling{1}\n");
+    out_sDocument.AppendFormat("\t\t\tVarArray %%Components{Uuid{u4{{0},{1}}}}\n\t\t}\n\t}\n", rnd.UInt(), rnd.UInt());
+  }
+
+  out_sDocument.Append("}\nMesh\n{\n\tfloat %Positions\n\t{\n\t\t");
+
+  for (ezUInt32 i = 0; i < uiNumVertices * 3; ++i)
+  {
+    out_sDocument.AppendFormat("{0},", ezArgF(rnd.DoubleMinMax(-100, 100), 6));
+
+    if (i % 12 == 11)
+      out_sDocument.Append("\n\t\t");
+  }
+
+  out_sDocument.Append("0\n\t}\n\tunsigned_int32 %Indices\n\t{\n\t\t");
+
+  for (ezUInt32 i = 0; i < uiNumVertices * 2; ++i)
+  {
+    out_sDocument.AppendFormat("{0},", rnd.UIntInRange(uiNumVertices));
+  }
+
+  out_sDocument.Append("0\n\t}\n}\n");
+}
+
 EZ_CREATE_SIMPLE_TEST(IO, DdlReader)
 {
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "Basics and Comments")
@@ -331,4 +467,136 @@ string{\"s\\2\",\"bla\"}\n\
     ezOpenDdlReader doc;
     EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Numbers")
+  {
+    const char* szTestData = "\
+float %F{1.5,-2,+3.25,1e3,2.5E-2,-1.5e+1,12345678.87654321,.5,1_000.5,4.,0x3F800000,7 8/*c*/,9,, 10 // comment\n\
+, 11}\n\
+double %D{1.5,-2,0.1,123456789012345678,3.14159265358979323846,-0.000001, 1e-300, 5}\n\
+int8 %I8{0,-1,127,-128,200}\n\
+int16 %I16{12345,-12345,1_000}\n\
+int32 %I32{2147483647,-2147483647,0}\n\
+int64 %I64{-9223372036854775807,1234567890123456789}\n\
+unsigned_int8 %U8{255,256}\n\
+unsigned_int16 %U16{65535}\n\
+unsigned_int32 %U32{4294967295,12345678}\n\
+unsigned_int64 %U64{18446744073709551615,1234567890123456789}\n\
+";
+
+    ezOpenDdlReader doc;
+    StringStream stream(szTestData);
+    EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+
+    const ezOpenDdlReaderElement* pRoot = doc.GetRootElement();
+
+    const ezOpenDdlReaderElement* pFloats = pRoot->FindChild("F");
+    EZ_TEST_INT(pFloats->GetNumPrimitives(), 16);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[0], 1.5f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[1], -2.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[2], 3.25f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[3], 1000.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[4], 0.025f, 0.000001f);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[5], -15.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[6], 12345678.87654321f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[7], 0.5f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[8], 1000.5f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[9], 4.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[11], 7.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[12], 8.0f, 0);
+    EZ_TEST_FLOAT(pFloats->GetPrimitivesFloat()[15], 11.0f, 0);
+
+    const ezOpenDdlReaderElement* pInt8 = pRoot->FindChild("I8");
+    EZ_TEST_INT(pInt8->GetPrimitivesInt8()[1], -1);
+    EZ_TEST_INT(pInt8->GetPrimitivesInt8()[3], -128);
+    EZ_TEST_INT(pInt8->GetPrimitivesInt8()[4], -56); // out of range values wrap around
+    EZ_TEST_INT(pRoot->FindChild("I16")->GetPrimitivesInt16()[2], 1000);
+    EZ_TEST_INT(pRoot->FindChild("I64")->GetPrimitivesInt64()[0], -9223372036854775807ll);
+    EZ_TEST_INT(pRoot->FindChild("U8")->GetPrimitivesUInt8()[1], 0);
+    EZ_TEST_BOOL(pRoot->FindChild("U64")->GetPrimitivesUInt64()[0] == 18446744073709551615ull);
+
+    // the byte-wise code path has to produce exactly the same result, also when the buffer boundaries fall into the middle of the values
+    for (ezUInt32 uiMaxBytesPerRead : {1, 2, 3, 7, 16, 61})
+    {
+      ezOpenDdlReader doc2;
+      PieceWiseStringStream stream2(szTestData, uiMaxBytesPerRead);
+      EZ_TEST_BOOL(doc2.ParseDocument(stream2).Succeeded());
+      EZ_TEST_BOOL_MSG(CompareElements(pRoot, doc2.GetRootElement()), "Different result with %u bytes per read", uiMaxBytesPerRead);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Numbers - Errors")
+  {
+    // the error location must not depend on how the numbers are parsed
+    const char* szTestData = "float{1,2,3,\n  4.5, 5x, 6}\n";
+
+    for (ezUInt32 uiMaxBytesPerRead : {1, 1024})
+    {
+      ezTestLogInterface log;
+      ezTestLogSystemScope logSystemScope(&log);
+
+      log.ExpectMessage("Line 2 (10): Malformed float literal", ezLogMsgType::ErrorMsg);
+
+      ezOpenDdlReader doc;
+      PieceWiseStringStream stream(szTestData, uiMaxBytesPerRead);
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Failed());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Equivalence with byte-wise parsing")
+  {
+    ezStringBuilder sDocument;
+    GenerateSceneDocument(sDocument, 500, 5000);
+
+    ezOpenDdlReader doc;
+    StringStream stream(sDocument.GetData());
+    EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+
+    ezOpenDdlReader docByteWise;
+    PieceWiseStringStream streamByteWise(sDocument, 1);
+    EZ_TEST_BOOL(docByteWise.ParseDocument(streamByteWise).Succeeded());
+
+    EZ_TEST_BOOL(CompareElements(doc.GetRootElement(), docByteWise.GetRootElement()));
+    EZ_TEST_INT(doc.GetRootElement()->FindChildOfType("Objects")->GetNumChildObjects(), 500);
+    EZ_TEST_INT(doc.GetRootElement()->FindChildOfType("Mesh")->FindChild("Positions")->GetNumPrimitives(), 5000 * 3 + 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    ezStringBuilder sDocument;
+    GenerateSceneDocument(sDocument, 10000, 100000);
+
+    ezAllocatorBase* pAllocator = ezFoundation::GetDefaultAllocator();
+
+    ezTime tByteWise;
+    {
+      ezStopwatch sw;
+
+      ezOpenDdlReader doc;
+      PieceWiseStringStream stream(sDocument, 1);
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+
+      tByteWise = sw.GetRunningTotal();
+    }
+
+    ezTime tBuffered;
+    ezUInt64 uiAllocations = 0;
+    {
+      const ezAllocatorBase::Stats before = pAllocator->GetStats();
+      ezStopwatch sw;
+
+      ezOpenDdlReader doc;
+      StringStream stream(sDocument.GetData());
+      EZ_TEST_BOOL(doc.ParseDocument(stream).Succeeded());
+
+      tBuffered = sw.GetRunningTotal();
+      uiAllocations = pAllocator->GetStats().m_uiNumAllocations - before.m_uiNumAllocations;
+    }
+
+    // all elements, names and values are stored in a few large blocks
+    EZ_TEST_BOOL(uiAllocations < 100);
+
+    ezLog::Info("[test]Parsing a {0} DDL scene: {1} ms when reading byte-wise, {2} ms when reading from a buffer, {3} allocations",
+      ezArgFileSize(sDocument.GetElementCount()), ezArgF(tByteWise.GetMilliseconds(), 1), ezArgF(tBuffered.GetMilliseconds(), 1), uiAllocations);
+  }
 }
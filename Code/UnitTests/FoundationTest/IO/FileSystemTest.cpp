@@ -4,6 +4,12 @@
 #include <Foundation/IO/FileSystem/FileReader.h>
 #include <Foundation/IO/FileSystem/FileSystem.h>
 #include <Foundation/IO/FileSystem/FileWriter.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Threading/ThreadUtils.h>
+
+#if EZ_ENABLED(EZ_PLATFORM_OSX) || EZ_ENABLED(EZ_PLATFORM_LINUX)
+#  include <unistd.h>
+#endif
 
 #if EZ_ENABLED(EZ_SUPPORTS_LONG_PATHS)
 #  define LongPath                                                                                                                                   \
@@ -364,3 +370,328 @@ Only concrete and clocks.\n\
     ezFileSystem::RemoveDataDirectoryGroup("remove");
   }
 }
+
+EZ_CREATE_SIMPLE_TEST(IO, FileSystemFileIndex)
+{
+  ezStringBuilder sOutputFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sOutputFolder.AppendPath("IO", "FileIndex");
+  sOutputFolder.MakeCleanPath();
+
+  ezStringBuilder sTemp;
+
+  // create a few files in the test folder
+  for (const char* szFile : {"a.txt", "Sub/b.txt", "Sub/Deeper/C.txt"})
+  {
+    sTemp.Set(sOutputFolder, "/", szFile);
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sTemp, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write("test", 4).Succeeded());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ezDataDirFileIndex")
+  {
+    ezDataDirFileIndex index;
+    EZ_TEST_BOOL(!index.IsValid());
+    EZ_TEST_BOOL(index.MayContainEntry("anything.txt"));
+
+    EZ_TEST_BOOL(index.Build(sOutputFolder).Succeeded());
+    EZ_TEST_BOOL(index.IsValid());
+    EZ_TEST_INT(index.GetCount(), 5);
+
+    EZ_TEST_BOOL(index.MayContainEntry("a.txt"));
+    EZ_TEST_BOOL(index.MayContainEntry("A.TXT"));
+    EZ_TEST_BOOL(index.MayContainEntry("Sub"));
+    EZ_TEST_BOOL(index.MayContainEntry("Sub/"));
+    EZ_TEST_BOOL(index.MayContainEntry("sub\\deeper/c.txt"));
+    EZ_TEST_BOOL(index.MayContainEntry("Sub/../a.txt"));
+    EZ_TEST_BOOL(!index.MayContainEntry("b.txt"));
+    EZ_TEST_BOOL(!index.MayContainEntry("Sub/Deeper/b.txt"));
+
+    // paths that the index cannot answer
+    EZ_TEST_BOOL(index.MayContainEntry("../a.txt"));
+    EZ_TEST_BOOL(index.MayContainEntry(sOutputFolder));
+
+    index.AddEntry("New/Folder/file.txt");
+    EZ_TEST_INT(index.GetCount(), 8);
+    EZ_TEST_BOOL(index.MayContainEntry("New"));
+    EZ_TEST_BOOL(index.MayContainEntry("New/Folder"));
+    EZ_TEST_BOOL(index.MayContainEntry("New/Folder/file.txt"));
+
+    index.RemoveEntry("New/Folder/file.txt");
+    EZ_TEST_INT(index.GetCount(), 7);
+    EZ_TEST_BOOL(!index.MayContainEntry("New/Folder/file.txt"));
+    EZ_TEST_BOOL(index.MayContainEntry("New/Folder"));
+
+    // enough entries to force the table to grow multiple times
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      sTemp.Format("Generated/File{}.txt", i);
+      index.AddEntry(sTemp);
+    }
+
+    EZ_TEST_INT(index.GetCount(), 1008);
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+    {
+      sTemp.Format("Generated/File{}.txt", i);
+      EZ_TEST_BOOL(index.MayContainEntry(sTemp));
+    }
+
+    ezDefaultMemoryStreamStorage storage;
+    ezMemoryStreamWriter writer(&storage);
+    ezMemoryStreamReader reader(&storage);
+
+    EZ_TEST_BOOL(index.WriteToStream(writer).Succeeded());
+
+    ezDataDirFileIndex index2;
+    EZ_TEST_BOOL(index2.ReadFromStream(reader).Succeeded());
+    EZ_TEST_INT(index2.GetCount(), 1008);
+    EZ_TEST_BOOL(index2.MayContainEntry("Generated/File999.txt"));
+    EZ_TEST_BOOL(index2.MayContainEntry("Sub/b.txt"));
+    EZ_TEST_BOOL(!index2.MayContainEntry("New/Folder/file.txt"));
+
+    index2.Clear();
+    EZ_TEST_BOOL(!index2.IsValid());
+    EZ_TEST_INT(index2.GetCount(), 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Mounted Folder")
+  {
+    ezDataDirectory::FolderType::s_bUseFileIndex = true;
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "FileIndex", "fileindex", ezFileSystem::AllowWrites).Succeeded());
+    ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+    auto pDataDir = static_cast<ezDataDirectory::FolderType*>(ezFileSystem::FindDataDirectoryWithRoot("fileindex"));
+    if (EZ_TEST_BOOL(pDataDir != nullptr))
+    {
+      const ezDataDirFileIndex& index = pDataDir->GetFileIndex();
+      EZ_TEST_BOOL(index.IsValid());
+
+      const_cast<ezDataDirFileIndex&>(index).ResetStats();
+
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/a.txt"));
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/Sub/Deeper/C.txt"));
+      EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":fileindex/missing.txt"));
+      EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":fileindex/Sub/missing.txt"));
+
+      {
+        ezFileReader file;
+        EZ_TEST_BOOL(file.Open(":fileindex/Sub/b.txt").Succeeded());
+
+        ezFileReader file2;
+        EZ_TEST_BOOL(file2.Open(":fileindex/Sub/c.txt").Failed());
+      }
+
+      ezFileStats stats;
+      EZ_TEST_BOOL(ezFileSystem::GetFileStats(":fileindex/Sub", stats).Succeeded());
+      EZ_TEST_BOOL(stats.m_bIsDirectory);
+      EZ_TEST_BOOL(ezFileSystem::GetFileStats(":fileindex/Nope", stats).Failed());
+
+      // the negative lookups did not need to ask the OS
+      EZ_TEST_INT(index.GetStats().m_uiNumLookups, 8);
+      EZ_TEST_INT(index.GetStats().m_uiNumRejected, 4);
+
+      // files written through the file system are added to the index immediately
+      {
+        ezFileWriter file;
+        EZ_TEST_BOOL(file.Open(":fileindex/Written/d.txt").Succeeded());
+        EZ_TEST_BOOL(file.WriteBytes("test", 4).Succeeded());
+      }
+
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/Written/d.txt"));
+
+      ezFileSystem::DeleteFile(":fileindex/Written/d.txt");
+      EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":fileindex/Written/d.txt"));
+
+#if EZ_ENABLED(EZ_SUPPORTS_DIRECTORY_WATCHER)
+      // files created outside of ezFileSystem are picked up through the directory watcher
+      {
+        sTemp.Set(sOutputFolder, "/External.txt");
+
+        ezOSFile file;
+        EZ_TEST_BOOL(file.Open(sTemp, ezFileOpenMode::Write).Succeeded());
+        EZ_TEST_BOOL(file.Write("test", 4).Succeeded());
+        file.Close();
+
+        for (ezUInt32 i = 0; i < 10 && !index.MayContainEntry("External.txt"); ++i)
+        {
+          ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(20));
+          ezFileSystem::UpdateAllDataDirectoryFileIndices();
+        }
+
+        EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/External.txt"));
+
+        ezOSFile::DeleteFile(sTemp).IgnoreResult();
+      }
+#endif
+    }
+
+    ezFileSystem::RemoveDataDirectoryGroup("FileIndex");
+  }
+
+#if EZ_ENABLED(EZ_PLATFORM_OSX) || EZ_ENABLED(EZ_PLATFORM_LINUX)
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Symlinked Folder")
+  {
+    // a folder that is only reachable through a symlink must be indexed like a regular folder
+    ezStringBuilder sLinkTarget = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sLinkTarget.AppendPath("IO", "FileIndexLinkTarget");
+    sLinkTarget.MakeCleanPath();
+
+    sTemp.Set(sLinkTarget, "/Inner/e.txt");
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sTemp, ezFileOpenMode::Write).Succeeded());
+    }
+
+    ezStringBuilder sLink(sOutputFolder, "/Linked");
+    unlink(sLink.GetData());
+    if (EZ_TEST_BOOL(symlink(sLinkTarget.GetData(), sLink.GetData()) == 0))
+    {
+      ezDataDirFileIndex index;
+      EZ_TEST_BOOL(index.Build(sOutputFolder).Succeeded());
+      EZ_TEST_BOOL(index.MayContainEntry("Linked"));
+      EZ_TEST_BOOL(index.MayContainEntry("Linked/Inner"));
+      EZ_TEST_BOOL(index.MayContainEntry("Linked/Inner/e.txt"));
+      EZ_TEST_BOOL(!index.MayContainEntry("Linked/Inner/f.txt"));
+
+      ezDataDirectory::FolderType::s_bUseFileIndex = true;
+      EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "FileIndex", "fileindex").Succeeded());
+      ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+      EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/Linked/Inner/e.txt"));
+
+      ezFileStats stats;
+      EZ_TEST_BOOL(ezFileSystem::GetFileStats(":fileindex/Linked/Inner", stats).Succeeded());
+      EZ_TEST_BOOL(stats.m_bIsDirectory);
+
+      ezFileSystem::RemoveDataDirectoryGroup("FileIndex");
+
+      // a link back to the target forms a cycle, which must not be followed forever
+      ezStringBuilder sLoop(sLinkTarget, "/Inner/Loop");
+      unlink(sLoop.GetData());
+      if (EZ_TEST_BOOL(symlink(sLinkTarget.GetData(), sLoop.GetData()) == 0))
+      {
+        ezDataDirFileIndex loopIndex;
+        EZ_TEST_BOOL(loopIndex.Build(sOutputFolder).Succeeded());
+        EZ_TEST_BOOL(loopIndex.MayContainEntry("Linked/Inner/e.txt"));
+        EZ_TEST_BOOL(loopIndex.MayContainEntry("Linked/Inner/Loop"));
+        EZ_TEST_BOOL(!loopIndex.MayContainEntry("Linked/Inner/Loop/Inner/e.txt"));
+      }
+
+      // without the explicit flag, links are reported as files and not recursed into
+      {
+        bool bFoundLink = false;
+        bool bEnteredLink = false;
+
+        ezFileSystemIterator it;
+        for (it.StartSearch(sOutputFolder, ezFileSystemIteratorFlags::ReportFilesAndFoldersRecursive); it.IsValid(); it.Next())
+        {
+          if (it.GetStats().m_sName == "Linked")
+          {
+            bFoundLink = true;
+            EZ_TEST_BOOL(!it.GetStats().m_bIsDirectory);
+          }
+
+          bEnteredLink |= it.GetStats().m_sName == "e.txt";
+        }
+
+        EZ_TEST_BOOL(bFoundLink);
+        EZ_TEST_BOOL(!bEnteredLink);
+      }
+
+      // deleting a folder only removes the link, not the files in the link target
+      ezStringBuilder sDeleteFolder(sOutputFolder, "/DeleteWithLink");
+      ezStringBuilder sDeleteLink(sDeleteFolder, "/Linked");
+      EZ_TEST_BOOL(ezOSFile::CreateDirectoryStructure(sDeleteFolder).Succeeded());
+      if (EZ_TEST_BOOL(symlink(sLinkTarget.GetData(), sDeleteLink.GetData()) == 0))
+      {
+        EZ_TEST_BOOL(ezOSFile::DeleteFolder(sDeleteFolder).Succeeded());
+        EZ_TEST_BOOL(!ezOSFile::ExistsDirectory(sDeleteFolder));
+        EZ_TEST_BOOL(ezOSFile::ExistsFile(sTemp));
+      }
+
+      unlink(sLoop.GetData());
+      unlink(sLink.GetData());
+    }
+
+    ezOSFile::DeleteFolder(sLinkTarget).IgnoreResult();
+  }
+#endif
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Manifest")
+  {
+    EZ_TEST_BOOL(ezDataDirectory::FolderType::WriteFileIndexManifest(sOutputFolder).Succeeded());
+
+    // a file that is not in the manifest cannot be found, that proves that the manifest is used
+    sTemp.Set(sOutputFolder, "/NotInManifest.txt");
+    {
+      ezOSFile file;
+      EZ_TEST_BOOL(file.Open(sTemp, ezFileOpenMode::Write).Succeeded());
+    }
+
+    ezDataDirectory::FolderType::s_bUseFileIndex = true;
+    EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "FileIndex", "fileindex").Succeeded());
+    ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/Sub/b.txt"));
+    EZ_TEST_BOOL(ezFileSystem::ExistsFile(":fileindex/ezFileIndex.ezIndex"));
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":fileindex/NotInManifest.txt"));
+
+    ezFileSystem::RemoveDataDirectoryGroup("FileIndex");
+
+    ezOSFile::DeleteFile(sTemp).IgnoreResult();
+    sTemp.Set(sOutputFolder, "/ezFileIndex.ezIndex");
+    ezOSFile::DeleteFile(sTemp).IgnoreResult();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Performance: Negative Lookups")
+  {
+    // mounts the same folder many times and measures how long it takes to find out that files do not exist
+    constexpr ezUInt32 uiNumDataDirs = 12;
+    constexpr ezUInt32 uiNumLookups = 10000;
+
+    for (bool bUseIndex : {false, true})
+    {
+      ezDataDirectory::FolderType::s_bUseFileIndex = bUseIndex;
+
+      for (ezUInt32 i = 0; i < uiNumDataDirs; ++i)
+      {
+        EZ_TEST_BOOL(ezFileSystem::AddDataDirectory(sOutputFolder, "FileIndexPerf").Succeeded());
+      }
+
+      ezDataDirectory::FolderType::s_bUseFileIndex = false;
+
+      ezUInt32 uiFound = 0;
+      const ezTime t0 = ezTime::Now();
+
+      for (ezUInt32 i = 0; i < uiNumLookups; ++i)
+      {
+        sTemp.Format("Sub/Missing{}.txt", i);
+        uiFound += ezFileSystem::ExistsFile(sTemp) ? 1 : 0;
+      }
+
+      const ezTime t1 = ezTime::Now();
+
+      EZ_TEST_INT(uiFound, 0);
+
+      // without the index, every data directory does one OS call per lookup
+      ezUInt64 uiOSLookups = uiNumDataDirs * uiNumLookups;
+      if (bUseIndex)
+      {
+        uiOSLookups = 0;
+        for (ezUInt32 i = ezFileSystem::GetNumDataDirectories() - uiNumDataDirs; i < ezFileSystem::GetNumDataDirectories(); ++i)
+        {
+          const auto stats = static_cast<ezDataDirectory::FolderType*>(ezFileSystem::GetDataDirectory(i))->GetFileIndex().GetStats();
+          uiOSLookups += stats.m_uiNumLookups - stats.m_uiNumRejected;
+        }
+      }
+
+      ezLog::Info("[test]{} data dirs, {} negative lookups {}: {}ms, {} OS lookups", uiNumDataDirs, uiNumLookups, bUseIndex ? "with file index" : "without file index", ezArgF((t1 - t0).GetMilliseconds(), 2), uiOSLookups);
+
+      ezFileSystem::RemoveDataDirectoryGroup("FileIndexPerf");
+    }
+  }
+
+  ezOSFile::DeleteFolder(sOutputFolder).IgnoreResult();
+}
@@ -0,0 +1,500 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/IO/JSONDocument.h>
+#include <Foundation/IO/JSONReader.h>
+#include <Foundation/IO/MemoryStream.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <TestFramework/Utilities/TestLogInterface.h>
+
+namespace JSONDocumentTestDetail
+{
+  /// Generates a document that looks like a profiling capture with roughly the given size.
+  void GenerateDocument(ezUInt32 uiTargetSize, ezStringBuilder& out_sJson)
+  {
+    out_sJson = "{\n  \"version\": 3,\n  \"traceEvents\": [\n";
+
+    for (ezUInt32 i = 0; out_sJson.GetElementCount() < uiTargetSize; ++i)
+    {
+      out_sJson.AppendFormat("    {\"name\": \"Task {0}\", \"cat\": \"Render\\/Pass\", \"ph\": \"X\", \"ts\": {1}.{2}, \"dur\": {3}, \"pid\": 1, \"tid\": {4}, "
+                             "\"args\": {\"visible\": {5}, \"parent\": null, \"ids\": [{0}, {6}, -{7}, 1.5e-3]}},\n",
+        i, i * 17, i % 1000, (i * 7) % 113, i % 8, (i % 3) == 0 ? "true" : "false", i + 1, i % 29);
+    }
+
+    out_sJson.Append("    {}\n  ]\n}\n");
+  }
+} // namespace JSONDocumentTestDetail
+
+EZ_CREATE_SIMPLE_TEST(IO, JSONDocument)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Basics")
+  {
+    const char* szJson = "{\n\
+  \"name\": \"Object\",\n\
+  \"enabled\": true,\n\
+  \"hidden\": false,\n\
+  \"parent\": null,\n\
+  \"position\": [1, -2.5, 3e2],\n\
+  \"components\": [{\"type\": \"Mesh\", \"lod\": [0, 1]}, {\"type\": \"Light\"}, {}],\n\
+  \"count\": 9007199254740993,\n\
+  \"empty\": []\n\
+}";
+
+    ezJSONDocument doc;
+    EZ_TEST_BOOL(doc.Parse(szJson).Succeeded());
+
+    ezJSONDocument::Value root = doc.GetRoot();
+    EZ_TEST_BOOL(root.IsObject());
+    EZ_TEST_INT(root.GetCount(), 8);
+
+    EZ_TEST_STRING(ezString(root["name"].GetString()), "Object");
+    EZ_TEST_BOOL(root["enabled"].IsBool());
+    EZ_TEST_BOOL(root["enabled"].GetBool() == true);
+    EZ_TEST_BOOL(root["hidden"].GetBool(true) == false);
+    EZ_TEST_BOOL(root["parent"].IsNull());
+
+    ezJSONDocument::Value position = root["position"];
+    EZ_TEST_BOOL(position.IsArray());
+    EZ_TEST_INT(position.GetCount(), 3);
+    EZ_TEST_DOUBLE(position[0].GetNumber(), 1.0, 0.0);
+    EZ_TEST_DOUBLE(position[1].GetNumber(), -2.5, 0.0);
+    EZ_TEST_DOUBLE(position[2].GetNumber(), 300.0, 0.0);
+    EZ_TEST_INT(position[2].GetInt64(), 300);
+    EZ_TEST_STRING(ezString(position[2].GetNumberText()), "3e2");
+
+    // integers are not converted through double
+    EZ_TEST_BOOL(root["count"].GetInt64() == 9007199254740993ll);
+
+    ezJSONDocument::Value components = root["components"];
+    EZ_TEST_INT(components.GetCount(), 3);
+    EZ_TEST_STRING(ezString(components[0]["type"].GetString()), "Mesh");
+    EZ_TEST_INT(components[0]["lod"][1].GetInt64(), 1);
+    EZ_TEST_STRING(ezString(components[1]["type"].GetString()), "Light");
+    EZ_TEST_BOOL(components[2].IsObject());
+    EZ_TEST_INT(components[2].GetCount(), 0);
+    EZ_TEST_BOOL(root["empty"].IsArray());
+    EZ_TEST_INT(root["empty"].GetCount(), 0);
+
+    // missing values and wrong types fall back to defaults, without any checks in between
+    EZ_TEST_BOOL(!root["missing"].IsValid());
+    EZ_TEST_BOOL(!root["missing"]["deeper"][3].IsValid());
+    EZ_TEST_BOOL(!components[3].IsValid());
+    EZ_TEST_BOOL(!root["name"][0].IsValid());
+    EZ_TEST_DOUBLE(root["name"].GetNumber(42.0), 42.0, 0.0);
+    EZ_TEST_INT(root["missing"].GetInt64(-1), -1);
+    EZ_TEST_BOOL(root["position"].GetString().IsEmpty());
+    EZ_TEST_INT(root["enabled"].GetCount(), 0);
+
+    // iteration in document order
+    {
+      const char* szNames[] = {"name", "enabled", "hidden", "parent", "position", "components", "count", "empty"};
+      ezUInt32 uiMember = 0;
+
+      for (ezJSONDocument::Member member : root.GetMembers())
+      {
+        EZ_TEST_STRING(ezString(member.m_sName), szNames[uiMember]);
+        ++uiMember;
+      }
+
+      EZ_TEST_INT(uiMember, 8);
+    }
+
+    {
+      ezUInt32 uiElement = 0;
+      for (ezJSONDocument::Value element : components.GetElements())
+      {
+        EZ_TEST_BOOL(element.IsObject());
+        ++uiElement;
+      }
+
+      EZ_TEST_INT(uiElement, 3);
+    }
+
+    {
+      ezUInt32 uiCount = 0;
+      for (ezJSONDocument::Value element : root["name"].GetElements())
+      {
+        EZ_IGNORE_UNUSED(element);
+        ++uiCount;
+      }
+      for (ezJSONDocument::Member member : position.GetMembers())
+      {
+        EZ_IGNORE_UNUSED(member);
+        ++uiCount;
+      }
+
+      EZ_TEST_INT(uiCount, 0);
+    }
+
+    // root, 8 names and 8 values, 3 position elements, 3 components with 3 names and 3 values, 2 lod elements
+    EZ_TEST_INT(doc.GetNodeCount(), 1 + 8 + 8 + 3 + 3 + 3 + 3 + 2);
+
+    doc.Clear();
+    EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Top-level values")
+  {
+    ezJSONDocument doc;
+
+    EZ_TEST_BOOL(doc.Parse("42").Succeeded());
+    EZ_TEST_INT(doc.GetRoot().GetInt64(), 42);
+
+    EZ_TEST_BOOL(doc.Parse(" \"text\" ").Succeeded());
+    EZ_TEST_STRING(ezString(doc.GetRoot().GetString()), "text");
+
+    EZ_TEST_BOOL(doc.Parse("null").Succeeded());
+    EZ_TEST_BOOL(doc.GetRoot().IsNull());
+
+    EZ_TEST_BOOL(doc.Parse("[true]").Succeeded());
+    EZ_TEST_BOOL(doc.GetRoot()[0].GetBool());
+
+    // UTF-8 BOM
+    EZ_TEST_BOOL(doc.Parse("\xEF\xBB\xBF{\"a\":1}").Succeeded());
+    EZ_TEST_INT(doc.GetRoot()["a"].GetInt64(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Strings")
+  {
+    const char* szJson = "{\"plain\": \"no escapes\", \"escapes\": \"\\\"\\\\\\/\\b\\f\\n\\r\\t\", \"a\\u0062c\": \"\\u0061\\u03f6a\\u2AD7z\\ud83e\\uDD86\", "
+                         "\"utf8\": \"\xCF\xB6\xF0\x9F\xA6\x86\", \"nul\": \"a\\u0000b\"}";
+
+    ezJSONDocument doc;
+    EZ_TEST_BOOL(doc.Parse(szJson).Succeeded());
+
+    ezJSONDocument::Value root = doc.GetRoot();
+
+    // strings without escape sequences point directly into the source
+    ezStringView sPlain = root["plain"].GetString();
+    EZ_TEST_BOOL(sPlain == "no escapes");
+    EZ_TEST_BOOL(sPlain.GetStartPointer() >= szJson && sPlain.GetEndPointer() <= szJson + ezStringUtils::GetStringElementCount(szJson));
+
+    EZ_TEST_BOOL(root["escapes"].GetString() == "\"\\/\b\f\n\r\t");
+    EZ_TEST_BOOL(root["abc"].GetString() == "a\xCF\xB6" "a\xE2\xAB\x97z\xF0\x9F\xA6\x86");
+    EZ_TEST_BOOL(root["utf8"].GetString() == "\xCF\xB6\xF0\x9F\xA6\x86");
+
+    ezStringView sNul = root["nul"].GetString();
+    EZ_TEST_INT(sNul.GetElementCount(), 3);
+    EZ_TEST_BOOL(sNul.GetStartPointer()[1] == '\0');
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Block boundaries")
+  {
+    // strings, escape sequences and numbers at every position relative to the 64 byte blocks of the structural search
+    ezStringBuilder sJson;
+    ezJSONDocument doc;
+
+    for (ezUInt32 uiPadding = 0; uiPadding < 140; ++uiPadding)
+    {
+      sJson.Clear();
+      sJson.Append("[");
+      for (ezUInt32 i = 0; i < uiPadding; ++i)
+        sJson.Append(" ");
+      sJson.Append("\"a\\\\\\\"b\\\\\", \"\\\\\\\\\", 1234567, {\"k\\\"\":\"\\\\\"}, \"", "x\\\"y\\\\\\\\\\\"z\\\\\"", "]");
+
+      EZ_TEST_BOOL(doc.Parse(sJson).Succeeded());
+
+      ezJSONDocument::Value root = doc.GetRoot();
+      EZ_TEST_INT(root.GetCount(), 5);
+      EZ_TEST_BOOL(root[0].GetString() == "a\\\"b\\");
+      EZ_TEST_BOOL(root[1].GetString() == "\\\\");
+      EZ_TEST_INT(root[2].GetInt64(), 1234567);
+      EZ_TEST_BOOL(root[3]["k\""].GetString() == "\\");
+      EZ_TEST_BOOL(root[4].GetString() == "x\"y\\\\\"z\\");
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Conformance - Valid")
+  {
+    // a selection of the accepted cases of the JSONTestSuite
+    const char* szValid[] = {
+      "[[]   ]",
+      "[]",
+      "[\"\"]",
+      "[\"a\"]",
+      "[false]",
+      "[null, 1, \"1\", {}]",
+      "[1\n]",
+      " [1]",
+      "[1,null,null,null,2]",
+      "[2] ",
+      "[123e65]",
+      "[0e+1]",
+      "[0e1]",
+      "[ 4]",
+      "[-0.000000000000000000000000000000000000000000000000000000000000000000000000000001]\n",
+      "[20e1]",
+      "[-0]",
+      "[-123]",
+      "[-1]",
+      "[1E22]",
+      "[1E-2]",
+      "[1E+2]",
+      "[123.456e78]",
+      "[1e-2]",
+      "[123.456789]",
+      "[100000000000000000000]",
+      "{\"asd\":\"sdf\", \"dfg\":\"fgh\"}",
+      "{\"a\":\"b\",\"a\":\"c\"}",
+      "{}",
+      "{\"\":0}",
+      "{\"foo\\u0000bar\": 42}",
+      "{ \"min\": -1.0e+28, \"max\": 1.0e+28 }",
+      "{\"x\":[{\"id\": \"xxx\"}], \"id\": \"xxx\"}",
+      "{\"a\":[]}",
+      "{\"title\":\"\\u041f\\u043e\\u043b\\u0442\\u043e\\u0440\\u0430 \\u0417\\u0435\\u043c\\u043b\\u0435\\u043a\\u043e\\u043f\\u0430\" }",
+      "{\n\"a\": \"b\"\n}",
+      "[\"\\u0060\\u012a\\u12AB\"]",
+      "[\"\\uD801\\udc37\"]",
+      "[\"\\\\u0000\"]",
+      "[\"\\\"\"]",
+      "[\"\\\\a\"]",
+      "[\"\\u0012\"]",
+      "[\"\\uFFFF\"]",
+      "[\"\\uDBFF\\uDFFF\"]",
+      "[\"new\\u00A0line\"]",
+      "[\"\xCF\x80\"]",
+      "[\"\xF0\x9B\xBF\xBF\"]",
+      "[\"\\\"\\\\\\/\\b\\f\\n\\r\\t\"]",
+      "[\"\x7F\"]",
+      "\"asd\"",
+      "42",
+      "-0.1",
+      "null",
+      "true",
+      "false",
+      "\"\"",
+      " [] ",
+      "[\r\n\t 1 \r\n\t]",
+      "{\"a\":[1,{\"b\":[{}]}]}",
+    };
+
+    ezJSONDocument doc;
+
+    for (const char* szJson : szValid)
+    {
+      EZ_TEST_BOOL_MSG(doc.Parse(szJson).Succeeded(), "Valid document was rejected: '%s'", szJson);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Conformance - Invalid")
+  {
+    // a selection of the rejected cases of the JSONTestSuite
+    const char* szInvalid[] = {
+      "",
+      " ",
+      "\xEF\xBB\xBF",
+      "[1 true]",
+      "[\"\": 1]",
+      "[\"\"],",
+      "[,1]",
+      "[1,,2]",
+      "[\"x\",,]",
+      "[\"x\"]]",
+      "[\"\",]",
+      "[\"x\"",
+      "[x",
+      "[3[4]]",
+      "[1:2]",
+      "[,]",
+      "[-]",
+      "[   , \"\"]",
+      "[\"a\",\n4\n,1,",
+      "[1,]",
+      "[1,,]",
+      "[*]",
+      "[\"\"",
+      "[1,",
+      "[{}",
+      "[\"a\" \"b\"]",
+      "[-1.0.]",
+      "[.123]",
+      "[012]",
+      "[-01]",
+      "[1.]",
+      "[1.e1]",
+      "[+1]",
+      "[1e]",
+      "[1e+]",
+      "[0x1]",
+      "[Infinity]",
+      "[NaN]",
+      "[-Infinity]",
+      "[2.e3]",
+      "[1eE2]",
+      "[- 1]",
+      "[-foo]",
+      "[1_000]",
+      "[nul]",
+      "[tru]",
+      "[truth]",
+      "[True]",
+      "[NULL]",
+      "{\"a\" b}",
+      "{key: 'value'}",
+      "{\"a\":\"a\" 123}",
+      "{\"a\" \"b\"}",
+      "{1:1}",
+      "{\"a\":\"b\",}",
+      "{\"a\":\"b\"}/**/",
+      "{\"a\":\"b\"}//",
+      "{\"a\":\"b\"}#",
+      "{\"a\":/*comment*/\"b\"}",
+      "{\"a\"",
+      "{\"a\":",
+      "{\"a\":\"a",
+      "{,}",
+      "{'a':0}",
+      "{\"id\":0,,,,,}",
+      "{\"a\":1,,\"b\":2}",
+      "{}}",
+      "[][]",
+      "[1]x",
+      "{\"a\":1}{\"b\":2}",
+      "[\"\\x00\"]",
+      "[\"\\a\"]",
+      "[\"\\uD800\\u\"]",
+      "[\"\\u00G0\"]",
+      "[\"\\u12\"]",
+      "[\"\t\"]",
+      "[\"new\nline\"]",
+      "[\"a\x01\"]",
+      "[\x01]",
+      "[\"\\\"]",
+      "[\\\"a\"]",
+      "[\"\xFF\"]",
+      "[\"\xC0\xAF\"]",
+      "[\"\xED\xA0\x80\"]",
+      "[\xCF\x80]",
+      // lone surrogates in escape sequences are implementation defined, they can't be represented in UTF-8, so they are rejected
+      "[\"\\ud800\"]",
+      "[\"\\udc00abc\"]",
+      "[\"\\ud800\\u0041\"]",
+    };
+
+    ezMuteLog logErrorSink;
+    ezLogSystemScope ls(&logErrorSink);
+
+    ezJSONDocument doc;
+
+    for (const char* szJson : szInvalid)
+    {
+      EZ_TEST_BOOL_MSG(doc.Parse(szJson).Failed(), "Invalid document was accepted: '%s'", szJson);
+      EZ_TEST_BOOL(!doc.GetRoot().IsValid());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Nesting")
+  {
+    ezStringBuilder sJson;
+    ezJSONDocument doc;
+
+    for (ezUInt32 i = 0; i < 1000; ++i)
+      sJson.Append("[");
+    for (ezUInt32 i = 0; i < 1000; ++i)
+      sJson.Append("]");
+
+    EZ_TEST_BOOL(doc.Parse(sJson).Succeeded());
+    EZ_TEST_INT(doc.GetNodeCount(), 1000);
+
+    ezMuteLog logErrorSink;
+    ezLogSystemScope ls(&logErrorSink);
+
+    sJson.Clear();
+    for (ezUInt32 i = 0; i < 100000; ++i)
+      sJson.Append("[");
+
+    EZ_TEST_BOOL(doc.Parse(sJson).Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Error Messages")
+  {
+    ezTestLogInterface log;
+    ezTestLogSystemScope logSystemScope(&log);
+
+    log.ExpectMessage("Line 3 (10): Expected ',' or '}'", ezLogMsgType::ErrorMsg);
+    log.ExpectMessage("Line 1 (2): Invalid value 'tru'", ezLogMsgType::ErrorMsg);
+
+    ezJSONDocument doc;
+    EZ_TEST_BOOL(doc.Parse("{\n  \"a\": 1,\n  \"b\": 2 \"c\": 3\n}").Failed());
+    EZ_TEST_BOOL(doc.Parse("[tru]").Failed());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Stream and ToVariant")
+  {
+    ezStringBuilder sJson;
+    JSONDocumentTestDetail::GenerateDocument(4 * 1024, sJson);
+    sJson.ReplaceLast("    {}\n", "    {\"nested\": {\"a\": [[], {}, \"\\u00e4\", 0.25]}, \"nothing\": null, \"a\": 1, \"a\": 2}\n");
+
+    ezJSONReader reader;
+    {
+      ezRawMemoryStreamReader stream(sJson.GetData(), sJson.GetElementCount());
+      EZ_TEST_BOOL(reader.Parse(stream).Succeeded());
+    }
+
+    ezJSONDocument doc;
+    {
+      ezRawMemoryStreamReader stream(sJson.GetData(), sJson.GetElementCount());
+      EZ_TEST_BOOL(doc.Parse(stream).Succeeded());
+    }
+
+    // the document keeps its own copy of the stream data
+    sJson.Clear();
+
+    const ezVariant result = doc.GetRoot().ToVariant();
+    EZ_TEST_BOOL(result.IsA<ezVariantDictionary>());
+    EZ_TEST_BOOL(result == ezVariant(reader.GetTopLevelObject()));
+
+    const ezVariantArray& events = result.Get<ezVariantDictionary>().GetValue("traceEvents")->Get<ezVariantArray>();
+    const ezVariantDictionary& last = events.PeekBack().Get<ezVariantDictionary>();
+    EZ_TEST_DOUBLE(last.GetValue("a")->Get<double>(), 2.0, 0.0);
+    EZ_TEST_BOOL(!last.GetValue("nothing")->IsValid());
+    EZ_TEST_STRING(last.GetValue("nested")->Get<ezVariantDictionary>().GetValue("a")->Get<ezVariantArray>()[2].Get<ezString>(), "\xC3\xA4");
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    ezStringBuilder sJson;
+
+    for (ezUInt32 uiSize : {1024 * 1024, 4 * 1024 * 1024})
+    {
+      JSONDocumentTestDetail::GenerateDocument(uiSize, sJson);
+
+      ezTime tReader, tDocument, tDocumentVariant;
+      double fSum = 0.0;
+
+      {
+        ezStopwatch sw;
+        ezJSONReader reader;
+        ezRawMemoryStreamReader stream(sJson.GetData(), sJson.GetElementCount());
+        EZ_TEST_BOOL(reader.Parse(stream).Succeeded());
+        tReader = sw.GetRunningTotal();
+      }
+
+      ezJSONDocument doc;
+
+      {
+        ezStopwatch sw;
+        EZ_TEST_BOOL(doc.Parse(sJson).Succeeded());
+
+        // on-demand access: only read the durations
+        for (ezJSONDocument::Value event : doc.GetRoot()["traceEvents"].GetElements())
+        {
+          fSum += event["dur"].GetNumber();
+        }
+
+        tDocument = sw.GetRunningTotal();
+      }
+
+      {
+        ezStopwatch sw;
+        EZ_TEST_BOOL(doc.Parse(sJson).Succeeded());
+        const ezVariant result = doc.GetRoot().ToVariant();
+        EZ_TEST_BOOL(result.IsA<ezVariantDictionary>());
+        tDocumentVariant = sw.GetRunningTotal();
+      }
+
+      ezLog::Info("[test]{} KB, {} nodes, sum {}", sJson.GetElementCount() / 1024, doc.GetNodeCount(), fSum);
+      ezLog::Info("[test]ezJSONReader: {}, ezJSONDocument: {}, ezJSONDocument + ToVariant: {}", tReader, tDocument, tDocumentVariant);
+    }
+  }
+}
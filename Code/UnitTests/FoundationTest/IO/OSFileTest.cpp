@@ -118,6 +118,27 @@ Only concrete and clocks.\n\
     f.Close();
   }
 
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ReadAt")
+  {
+    ezOSFile f;
+    EZ_TEST_BOOL(f.Open(sOutputFile, ezFileOpenMode::Read) == EZ_SUCCESS);
+
+    char szTemp[32] = {};
+
+    EZ_TEST_INT(f.ReadAt(szTemp, 10, uiTextLen + 5), 10);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szTemp, &sFileContent.GetData()[5], 10));
+
+    // the file position is not affected
+    EZ_TEST_INT(f.GetFilePosition(), 0);
+
+    // reading past the end returns only the remaining bytes
+    EZ_TEST_INT(f.ReadAt(szTemp, 32, uiTextLen * 2 - 3), 3);
+    EZ_TEST_BOOL(ezMemoryUtils::IsEqual(szTemp, &sFileContent.GetData()[uiTextLen - 3], 3));
+    EZ_TEST_INT(f.ReadAt(szTemp, 32, uiTextLen * 2 + 100), 0);
+
+    f.Close();
+  }
+
 #if EZ_ENABLED(EZ_SUPPORTS_FILE_STATS)
   EZ_TEST_BLOCK(ezTestBlock::Enabled, "File Stats")
   {
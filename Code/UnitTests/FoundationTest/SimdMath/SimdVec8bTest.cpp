@@ -0,0 +1,98 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdVec8b.h>
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec8b)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+    // Make sure the class didn't accidentally change in size.
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezSimdVec8b) == 32);
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+    EZ_CHECK_AT_COMPILETIME(EZ_ALIGNMENT_OF(ezSimdVec8b) == 32);
+#endif
+
+    ezSimdVec8b vInit1B(true);
+    EZ_TEST_BOOL(vInit1B.AllSet());
+    EZ_TEST_INT(vInit1B.GetMask(), 0xFF);
+
+    ezSimdVec8b vInit1F(false);
+    EZ_TEST_BOOL(vInit1F.NoneSet());
+    EZ_TEST_INT(vInit1F.GetMask(), 0);
+
+    ezSimdVec8b vInit8B(false, true, false, true, true, true, false, false);
+    EZ_TEST_BOOL(!vInit8B.GetComponent<0>() && vInit8B.GetComponent<1>() && !vInit8B.GetComponent<2>() && vInit8B.GetComponent<3>());
+    EZ_TEST_BOOL(vInit8B.GetComponent<4>() && vInit8B.GetComponent<5>() && !vInit8B.GetComponent<6>() && !vInit8B.GetComponent<7>());
+    EZ_TEST_INT(vInit8B.GetMask(), 0x3A);
+
+    ezSimdVec8b vCopy(vInit8B);
+    EZ_TEST_INT(vCopy.GetMask(), 0x3A);
+
+    ezSimdVec8b vHalves(ezSimdVec4b(true, false, false, true), ezSimdVec4b(false, false, true, true));
+    EZ_TEST_INT(vHalves.GetMask(), 0xC9);
+
+    ezSimdVec4b vLow = vHalves.GetLow();
+    ezSimdVec4b vHigh = vHalves.GetHigh();
+    EZ_TEST_BOOL(vLow.x() && !vLow.y() && !vLow.z() && vLow.w());
+    EZ_TEST_BOOL(!vHigh.x() && !vHigh.y() && vHigh.z() && vHigh.w());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Operators")
+  {
+    ezSimdVec8b a(true, false, true, false, true, true, false, false);
+    ezSimdVec8b b(false, true, true, false, true, false, true, false);
+
+    ezSimdVec8b c = a && b;
+    EZ_TEST_INT(c.GetMask(), 0x14);
+
+    c = a || b;
+    EZ_TEST_INT(c.GetMask(), 0x77);
+
+    c = !a;
+    EZ_TEST_INT(c.GetMask(), 0xCA);
+    EZ_TEST_BOOL(c.AnySet<2>());
+    EZ_TEST_BOOL(!c.AnySet<1>());
+    EZ_TEST_BOOL(!c.AllSet());
+    EZ_TEST_BOOL(!c.NoneSet());
+    EZ_TEST_BOOL(c.NoneSet<1>());
+
+    c = c || a;
+    EZ_TEST_BOOL(c.AllSet());
+    EZ_TEST_BOOL(c.AnySet());
+    EZ_TEST_BOOL(!c.NoneSet());
+
+    c = !c;
+    EZ_TEST_BOOL(!c.AllSet());
+    EZ_TEST_BOOL(!c.AnySet());
+    EZ_TEST_BOOL(c.NoneSet());
+
+    c = a == b;
+    EZ_TEST_INT(c.GetMask(), 0x9C);
+
+    c = a != b;
+    EZ_TEST_INT(c.GetMask(), 0x63);
+
+    EZ_TEST_BOOL(a.AllSet<1>());
+    EZ_TEST_BOOL(!a.AllSet<2>());
+    EZ_TEST_BOOL(b.AnySet<5>());
+    EZ_TEST_BOOL(!b.AnySet<1>());
+    EZ_TEST_BOOL(!b.NoneSet<7>());
+
+    // the upper half on its own
+    ezSimdVec8b d(false, false, false, false, true, true, true, true);
+    EZ_TEST_BOOL(d.NoneSet<4>());
+    EZ_TEST_BOOL(!d.NoneSet<5>());
+    EZ_TEST_BOOL(!d.AllSet<5>());
+    EZ_TEST_BOOL(d.AnySet<5>());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Select")
+  {
+    ezSimdVec8b cmp(false, true, false, true, true, false, true, false);
+    ezSimdVec8b ifTrue(true, false, true, false, true, true, true, true);
+    ezSimdVec8b ifFalse(false, true, false, true, false, false, false, false);
+
+    ezSimdVec8b r = ezSimdVec8b::Select(cmp, ifTrue, ifFalse);
+    EZ_TEST_INT(r.GetMask(), 0x50);
+  }
+}
@@ -0,0 +1,572 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdVec8f.h>
+#include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  static bool AllCompSame(const ezSimdFloat& a)
+  {
+    // Make sure all components are the same
+    ezSimdVec4f test;
+    test.m_v = a.m_v;
+    return test.x() == test.y() && test.x() == test.z() && test.x() == test.w();
+  }
+
+  static bool IsEqual(const ezSimdVec8f& v, float f0, float f1, float f2, float f3, float f4, float f5, float f6, float f7, float fEpsilon = 0.0f)
+  {
+    return v.IsEqual(ezSimdVec8f(f0, f1, f2, f3, f4, f5, f6, f7), fEpsilon).AllSet();
+  }
+
+  struct ParticleStreams
+  {
+    void Init(ezUInt32 uiCount)
+    {
+      for (ezDynamicArray<float>* pStream : {&m_PosX, &m_PosY, &m_PosZ, &m_VelX, &m_VelY, &m_VelZ})
+      {
+        pStream->SetCountUninitialized(uiCount);
+      }
+
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        m_PosX[i] = static_cast<float>(i % 97);
+        m_PosY[i] = static_cast<float>(i % 89);
+        m_PosZ[i] = static_cast<float>(i % 83);
+        m_VelX[i] = static_cast<float>(i % 7) - 3.0f;
+        m_VelY[i] = static_cast<float>(i % 11);
+        m_VelZ[i] = static_cast<float>(i % 5) - 2.0f;
+      }
+    }
+
+    ezDynamicArray<float> m_PosX, m_PosY, m_PosZ;
+    ezDynamicArray<float> m_VelX, m_VelY, m_VelZ;
+  };
+
+  constexpr float s_fGravity = -9.81f;
+  constexpr float s_fDeltaTime = 1.0f / 60.0f;
+
+  void IntegrateScalar(ParticleStreams& ref_p)
+  {
+    for (ezUInt32 i = 0; i < ref_p.m_PosX.GetCount(); ++i)
+    {
+      ref_p.m_VelY[i] += s_fGravity * s_fDeltaTime;
+
+      ref_p.m_PosX[i] += ref_p.m_VelX[i] * s_fDeltaTime;
+      ref_p.m_PosY[i] += ref_p.m_VelY[i] * s_fDeltaTime;
+      ref_p.m_PosZ[i] += ref_p.m_VelZ[i] * s_fDeltaTime;
+    }
+  }
+
+  template <typename VEC, int WIDTH>
+  void IntegrateSimd(ParticleStreams& ref_p)
+  {
+    const VEC gravityDt(s_fGravity * s_fDeltaTime);
+    const ezSimdFloat dt(s_fDeltaTime);
+
+    for (ezUInt32 i = 0; i < ref_p.m_PosX.GetCount(); i += WIDTH)
+    {
+      VEC pos, vel;
+
+      vel.template Load<WIDTH>(&ref_p.m_VelY[i]);
+      vel += gravityDt;
+      vel.template Store<WIDTH>(&ref_p.m_VelY[i]);
+
+      pos.template Load<WIDTH>(&ref_p.m_PosY[i]);
+      pos = VEC::MulAdd(vel, dt, pos);
+      pos.template Store<WIDTH>(&ref_p.m_PosY[i]);
+
+      vel.template Load<WIDTH>(&ref_p.m_VelX[i]);
+      pos.template Load<WIDTH>(&ref_p.m_PosX[i]);
+      pos = VEC::MulAdd(vel, dt, pos);
+      pos.template Store<WIDTH>(&ref_p.m_PosX[i]);
+
+      vel.template Load<WIDTH>(&ref_p.m_VelZ[i]);
+      pos.template Load<WIDTH>(&ref_p.m_PosZ[i]);
+      pos = VEC::MulAdd(vel, dt, pos);
+      pos.template Store<WIDTH>(&ref_p.m_PosZ[i]);
+    }
+  }
+
+  /// Counts the spheres that are at least partially on the positive side of all planes, like frustum culling does.
+  ezUInt32 CullSpheresScalar(const ParticleStreams& p, const ezVec4* pPlanes, ezUInt32 uiNumPlanes)
+  {
+    ezUInt32 uiVisible = 0;
+
+    for (ezUInt32 i = 0; i < p.m_PosX.GetCount(); ++i)
+    {
+      bool bVisible = true;
+      for (ezUInt32 j = 0; j < uiNumPlanes; ++j)
+      {
+        const float fDist = pPlanes[j].x * p.m_PosX[i] + pPlanes[j].y * p.m_PosY[i] + pPlanes[j].z * p.m_PosZ[i] + pPlanes[j].w;
+        bVisible &= fDist > -ezMath::Abs(p.m_VelZ[i]);
+      }
+
+      uiVisible += bVisible ? 1 : 0;
+    }
+
+    return uiVisible;
+  }
+
+  ezUInt32 CullSpheres4(const ParticleStreams& p, const ezVec4* pPlanes, ezUInt32 uiNumPlanes)
+  {
+    ezUInt32 uiVisible = 0;
+
+    for (ezUInt32 i = 0; i < p.m_PosX.GetCount(); i += 4)
+    {
+      ezSimdVec4f x, y, z, r;
+      x.Load<4>(&p.m_PosX[i]);
+      y.Load<4>(&p.m_PosY[i]);
+      z.Load<4>(&p.m_PosZ[i]);
+      r.Load<4>(&p.m_VelZ[i]);
+      r = -r.Abs();
+
+      ezSimdVec4b visible(true);
+      for (ezUInt32 j = 0; j < uiNumPlanes; ++j)
+      {
+        ezSimdVec4f dist = ezSimdVec4f::MulAdd(x, ezSimdFloat(pPlanes[j].x), ezSimdVec4f(pPlanes[j].w));
+        dist = ezSimdVec4f::MulAdd(y, ezSimdFloat(pPlanes[j].y), dist);
+        dist = ezSimdVec4f::MulAdd(z, ezSimdFloat(pPlanes[j].z), dist);
+        visible = visible && (dist > r);
+      }
+
+      uiVisible += (visible.x() ? 1 : 0) + (visible.y() ? 1 : 0) + (visible.z() ? 1 : 0) + (visible.w() ? 1 : 0);
+    }
+
+    return uiVisible;
+  }
+
+  ezUInt32 CullSpheres8(const ParticleStreams& p, const ezVec4* pPlanes, ezUInt32 uiNumPlanes)
+  {
+    ezUInt32 uiVisible = 0;
+
+    for (ezUInt32 i = 0; i < p.m_PosX.GetCount(); i += 8)
+    {
+      ezSimdVec8f x, y, z, r;
+      x.Load(&p.m_PosX[i]);
+      y.Load(&p.m_PosY[i]);
+      z.Load(&p.m_PosZ[i]);
+      r.Load(&p.m_VelZ[i]);
+      r = -r.Abs();
+
+      ezSimdVec8b visible(true);
+      for (ezUInt32 j = 0; j < uiNumPlanes; ++j)
+      {
+        ezSimdVec8f dist = ezSimdVec8f::MulAdd(x, ezSimdFloat(pPlanes[j].x), ezSimdVec8f(pPlanes[j].w));
+        dist = ezSimdVec8f::MulAdd(y, ezSimdFloat(pPlanes[j].y), dist);
+        dist = ezSimdVec8f::MulAdd(z, ezSimdFloat(pPlanes[j].z), dist);
+        visible = visible && (dist > r);
+      }
+
+      uiVisible += ezMath::CountBits(visible.GetMask());
+    }
+
+    return uiVisible;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec8f)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG)
+    // In debug the default constructor initializes everything with NaN.
+    ezSimdVec8f vDefCtor;
+    EZ_TEST_BOOL(vDefCtor.IsNaN());
+#endif
+
+    // Make sure the class didn't accidentally change in size.
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezSimdVec8f) == 32);
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+    EZ_CHECK_AT_COMPILETIME(EZ_ALIGNMENT_OF(ezSimdVec8f) == 32);
+#endif
+
+    ezSimdVec8f vInit1F(2.0f);
+    EZ_TEST_BOOL(IsEqual(vInit1F, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f));
+
+    ezSimdFloat a(3.0f);
+    ezSimdVec8f vInit1SF(a);
+    EZ_TEST_BOOL(IsEqual(vInit1SF, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f, 3.0f));
+
+    ezSimdVec8f vInit8F(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+    EZ_TEST_FLOAT(vInit8F.GetComponent<0>(), 1.0f, 0.0f);
+    EZ_TEST_FLOAT(vInit8F.GetComponent<3>(), 4.0f, 0.0f);
+    EZ_TEST_FLOAT(vInit8F.GetComponent<4>(), 5.0f, 0.0f);
+    EZ_TEST_FLOAT(vInit8F.GetComponent<7>(), 8.0f, 0.0f);
+    EZ_TEST_BOOL(AllCompSame(vInit8F.GetComponent<5>()));
+
+    for (int i = 0; i < 8; ++i)
+    {
+      EZ_TEST_FLOAT(vInit8F.GetComponent(i), static_cast<float>(i + 1), 0.0f);
+    }
+
+    ezSimdVec8f vCopy(vInit8F);
+    EZ_TEST_BOOL(IsEqual(vCopy, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f));
+
+    ezSimdVec8f vHalves(ezSimdVec4f(1.0f, 2.0f, 3.0f, 4.0f), ezSimdVec4f(5.0f, 6.0f, 7.0f, 8.0f));
+    EZ_TEST_BOOL(IsEqual(vHalves, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f));
+    EZ_TEST_BOOL((vHalves.GetLow() == ezSimdVec4f(1.0f, 2.0f, 3.0f, 4.0f)).AllSet());
+    EZ_TEST_BOOL((vHalves.GetHigh() == ezSimdVec4f(5.0f, 6.0f, 7.0f, 8.0f)).AllSet());
+
+    ezSimdVec8f vZero = ezSimdVec8f::MakeZero();
+    EZ_TEST_BOOL(vZero.IsZero());
+
+    ezSimdVec8f vNaN = ezSimdVec8f::MakeNaN();
+    EZ_TEST_BOOL(vNaN.IsNaN());
+    EZ_TEST_BOOL(!vNaN.IsValid());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setter")
+  {
+    ezSimdVec8f a;
+    a.Set(2.0f);
+    EZ_TEST_BOOL(IsEqual(a, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f, 2.0f));
+
+    ezSimdVec8f b;
+    b.Set(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+    EZ_TEST_BOOL(IsEqual(b, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f));
+
+    ezSimdVec8f vSetZero;
+    vSetZero.SetZero();
+    EZ_TEST_BOOL(vSetZero.IsZero());
+
+    {
+      const float testBlock[8] = {1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f};
+
+      ezSimdVec8f v;
+      v.Load<1>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+
+      v.Load<2>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 2.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+
+      v.Load<4>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 2.0f, 3.0f, 4.0f, 0.0f, 0.0f, 0.0f, 0.0f));
+
+      v.Load<6>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 0.0f, 0.0f));
+
+      v.Load<7>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 0.0f));
+
+      v.Load(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f));
+    }
+
+    {
+      ezSimdVec8f v(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+
+      float mem[8];
+
+      for (float& f : mem)
+        f = 42.0f;
+      v.Store<3>(mem);
+      EZ_TEST_BOOL(mem[0] == 1.0f && mem[2] == 3.0f && mem[3] == 42.0f && mem[7] == 42.0f);
+
+      for (float& f : mem)
+        f = 42.0f;
+      v.Store<5>(mem);
+      EZ_TEST_BOOL(mem[0] == 1.0f && mem[4] == 5.0f && mem[5] == 42.0f && mem[7] == 42.0f);
+
+      for (float& f : mem)
+        f = 42.0f;
+      v.Store(mem);
+      EZ_TEST_BOOL(mem[0] == 1.0f && mem[3] == 4.0f && mem[4] == 5.0f && mem[7] == 8.0f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Functions")
+  {
+    {
+      ezSimdVec8f a(1.0f, 2.0f, 4.0f, 8.0f, 16.0f, 0.5f, 0.25f, 10.0f);
+      ezSimdVec8f b(1.0f, 0.5f, 0.25f, 0.125f, 0.0625f, 2.0f, 4.0f, 0.1f);
+
+      EZ_TEST_BOOL(a.GetReciprocal().IsEqual(b, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetReciprocal<ezMathAcc::FULL>().IsEqual(b, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetReciprocal<ezMathAcc::BITS_23>().IsEqual(b, ezMath::DefaultEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetReciprocal<ezMathAcc::BITS_12>().IsEqual(b, ezMath::HugeEpsilon<float>()).AllSet());
+    }
+
+    {
+      ezSimdVec8f a(1.0f, 2.0f, 4.0f, 8.0f, 9.0f, 0.25f, 3.0f, 100.0f);
+      ezSimdVec8f b(1.0f, ezMath::Sqrt(2.0f), 2.0f, ezMath::Sqrt(8.0f), 3.0f, 0.5f, ezMath::Sqrt(3.0f), 10.0f);
+
+      EZ_TEST_BOOL(a.GetSqrt().IsEqual(b, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetSqrt<ezMathAcc::FULL>().IsEqual(b, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetSqrt<ezMathAcc::BITS_23>().IsEqual(b, ezMath::DefaultEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetSqrt<ezMathAcc::BITS_12>().IsEqual(b, 0.01f).AllSet());
+
+      ezSimdVec8f c = b.GetReciprocal();
+      EZ_TEST_BOOL(a.GetInvSqrt().IsEqual(c, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetInvSqrt<ezMathAcc::FULL>().IsEqual(c, ezMath::SmallEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetInvSqrt<ezMathAcc::BITS_23>().IsEqual(c, ezMath::DefaultEpsilon<float>()).AllSet());
+      EZ_TEST_BOOL(a.GetInvSqrt<ezMathAcc::BITS_12>().IsEqual(c, ezMath::HugeEpsilon<float>()).AllSet());
+    }
+
+    {
+      ezSimdVec8f a(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 1.0f);
+      EZ_TEST_BOOL(a.IsZero<7>());
+      EZ_TEST_BOOL(!a.IsZero());
+
+      ezSimdVec8f b(0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.0f, 0.1f, 0.0f);
+      EZ_TEST_BOOL(b.IsZero<6>());
+      EZ_TEST_BOOL(!b.IsZero<7>());
+      EZ_TEST_BOOL(b.IsZero(ezSimdFloat(0.2f)));
+      EZ_TEST_BOOL(!b.IsZero(ezSimdFloat(0.05f)));
+    }
+
+    {
+      ezSimdVec8f a(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+      EZ_TEST_BOOL(!a.IsNaN());
+      EZ_TEST_BOOL(a.IsValid());
+
+      a = ezSimdVec8f(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, ezMath::NaN<float>(), 7.0f, 8.0f);
+      EZ_TEST_BOOL(a.IsNaN());
+      EZ_TEST_BOOL(!a.IsNaN<5>());
+      EZ_TEST_BOOL(!a.IsValid());
+      EZ_TEST_BOOL(a.IsValid<5>());
+
+      a = ezSimdVec8f(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, ezMath::Infinity<float>());
+      EZ_TEST_BOOL(!a.IsNaN());
+      EZ_TEST_BOOL(!a.IsValid());
+      EZ_TEST_BOOL(a.IsValid<7>());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Operators")
+  {
+    {
+      ezSimdVec8f a(-3.4f, 5.4f, -7.4f, 9.4f, 1.5f, -2.5f, 0.0f, 100.0f);
+
+      ezSimdVec8f b = -a;
+      EZ_TEST_BOOL(IsEqual(b, 3.4f, -5.4f, 7.4f, -9.4f, -1.5f, 2.5f, 0.0f, -100.0f));
+    }
+
+    {
+      ezSimdVec8f a(-3.4f, 5.4f, -7.4f, 9.4f, 1.5f, -2.5f, 0.5f, 100.0f);
+      ezSimdVec8f b(8.0f, 6.0f, 4.0f, 2.0f, 1.0f, 3.0f, 5.0f, 7.0f);
+
+      ezSimdVec8f c = a + b;
+      EZ_TEST_BOOL(IsEqual(c, 4.6f, 11.4f, -3.4f, 11.4f, 2.5f, 0.5f, 5.5f, 107.0f, ezMath::SmallEpsilon<float>()));
+
+      c = a - b;
+      EZ_TEST_BOOL(IsEqual(c, -11.4f, -0.6f, -11.4f, 7.4f, 0.5f, -5.5f, -4.5f, 93.0f, ezMath::SmallEpsilon<float>()));
+
+      c = a * ezSimdFloat(2.0f);
+      EZ_TEST_BOOL(IsEqual(c, -6.8f, 10.8f, -14.8f, 18.8f, 3.0f, -5.0f, 1.0f, 200.0f));
+
+      c = a / ezSimdFloat(2.0f);
+      EZ_TEST_BOOL(IsEqual(c, -1.7f, 2.7f, -3.7f, 4.7f, 0.75f, -1.25f, 0.25f, 50.0f));
+
+      c = a.CompMul(b);
+      EZ_TEST_BOOL(IsEqual(c, -27.2f, 32.4f, -29.6f, 18.8f, 1.5f, -7.5f, 2.5f, 700.0f, ezMath::SmallEpsilon<float>()));
+
+      ezSimdVec8f divRes(-0.425f, 0.9f, -1.85f, 4.7f, 1.5f, -0.8333333f, 0.1f, 14.285714f);
+      c = a.CompDiv(b);
+      EZ_TEST_BOOL(c.IsEqual(divRes, ezMath::SmallEpsilon<float>()).AllSet());
+      c = a.CompDiv<ezMathAcc::BITS_23>(b);
+      EZ_TEST_BOOL(c.IsEqual(divRes, ezMath::DefaultEpsilon<float>()).AllSet());
+      c = a.CompDiv<ezMathAcc::BITS_12>(b);
+      EZ_TEST_BOOL(c.IsEqual(divRes, 0.01f).AllSet());
+
+      c = a.CompMin(b);
+      EZ_TEST_BOOL(IsEqual(c, -3.4f, 5.4f, -7.4f, 2.0f, 1.0f, -2.5f, 0.5f, 7.0f));
+
+      c = a.CompMax(b);
+      EZ_TEST_BOOL(IsEqual(c, 8.0f, 6.0f, 4.0f, 9.4f, 1.5f, 3.0f, 5.0f, 100.0f));
+
+      c = a.Abs();
+      EZ_TEST_BOOL(IsEqual(c, 3.4f, 5.4f, 7.4f, 9.4f, 1.5f, 2.5f, 0.5f, 100.0f));
+
+      c = a;
+      c += b;
+      EZ_TEST_BOOL(IsEqual(c, 4.6f, 11.4f, -3.4f, 11.4f, 2.5f, 0.5f, 5.5f, 107.0f, ezMath::SmallEpsilon<float>()));
+
+      c = a;
+      c -= b;
+      EZ_TEST_BOOL(IsEqual(c, -11.4f, -0.6f, -11.4f, 7.4f, 0.5f, -5.5f, -4.5f, 93.0f, ezMath::SmallEpsilon<float>()));
+
+      c = a;
+      c *= ezSimdFloat(2.0f);
+      EZ_TEST_BOOL(IsEqual(c, -6.8f, 10.8f, -14.8f, 18.8f, 3.0f, -5.0f, 1.0f, 200.0f));
+
+      c = a;
+      c /= ezSimdFloat(2.0f);
+      EZ_TEST_BOOL(IsEqual(c, -1.7f, 2.7f, -3.7f, 4.7f, 0.75f, -1.25f, 0.25f, 50.0f));
+    }
+
+    {
+      ezSimdVec8f a(-3.4f, 5.4f, -7.6f, 9.6f, 2.25f, -2.75f, 0.49f, 100.0f);
+
+      ezSimdVec8f b = a.Round();
+      EZ_TEST_BOOL(IsEqual(b, -3.0f, 5.0f, -8.0f, 10.0f, 2.0f, -3.0f, 0.0f, 100.0f));
+
+      b = a.Floor();
+      EZ_TEST_BOOL(IsEqual(b, -4.0f, 5.0f, -8.0f, 9.0f, 2.0f, -3.0f, 0.0f, 100.0f));
+
+      b = a.Ceil();
+      EZ_TEST_BOOL(IsEqual(b, -3.0f, 6.0f, -7.0f, 10.0f, 3.0f, -2.0f, 1.0f, 100.0f));
+
+      b = a.Trunc();
+      EZ_TEST_BOOL(IsEqual(b, -3.0f, 5.0f, -7.0f, 9.0f, 2.0f, -2.0f, 0.0f, 100.0f));
+
+      b = a.Fraction();
+      EZ_TEST_BOOL(IsEqual(b, -0.4f, 0.4f, -0.6f, 0.6f, 0.25f, -0.75f, 0.49f, 0.0f, ezMath::SmallEpsilon<float>()));
+    }
+
+    {
+      ezSimdVec8f a(-3.4f, 5.4f, -7.4f, 9.4f, 1.0f, -2.0f, 3.0f, -4.0f);
+      ezSimdVec8b cmp(true, false, false, true, true, true, false, false);
+
+      ezSimdVec8f b = a.FlipSign(cmp);
+      EZ_TEST_BOOL(IsEqual(b, 3.4f, 5.4f, -7.4f, -9.4f, -1.0f, 2.0f, 3.0f, -4.0f));
+    }
+
+    {
+      ezSimdVec8f a(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+      ezSimdVec8f b(-1.0f, -2.0f, -3.0f, -4.0f, -5.0f, -6.0f, -7.0f, -8.0f);
+      ezSimdVec8b cmp(false, true, false, true, true, false, true, false);
+
+      ezSimdVec8f c = ezSimdVec8f::Select(cmp, a, b);
+      EZ_TEST_BOOL(IsEqual(c, -1.0f, 2.0f, -3.0f, 4.0f, 5.0f, -6.0f, 7.0f, -8.0f));
+    }
+
+    {
+      ezSimdVec8f a(0.0f, 0.0f, 10.0f, 10.0f, -1.0f, 2.0f, 4.0f, 4.0f);
+      ezSimdVec8f b(10.0f, 10.0f, 0.0f, 20.0f, 1.0f, 2.0f, 8.0f, 0.0f);
+      ezSimdVec8f t(0.5f, 1.0f, 0.25f, 0.1f, 0.5f, 0.9f, 0.0f, 0.75f);
+
+      ezSimdVec8f c = ezSimdVec8f::Lerp(a, b, t);
+      EZ_TEST_BOOL(IsEqual(c, 5.0f, 10.0f, 7.5f, 11.0f, 0.0f, 2.0f, 4.0f, 1.0f, ezMath::SmallEpsilon<float>()));
+    }
+
+    {
+      ezSimdVec8f a(-3.4f, 5.4f, -7.4f, 9.4f, 1.0f, -2.0f, 3.0f, -4.0f);
+
+      EZ_TEST_FLOAT(a.HorizontalSum(), 2.0f, ezMath::SmallEpsilon<float>());
+      EZ_TEST_FLOAT(a.HorizontalMin(), -7.4f, 0.0f);
+      EZ_TEST_FLOAT(a.HorizontalMax(), 9.4f, 0.0f);
+      EZ_TEST_BOOL(AllCompSame(a.HorizontalSum()));
+      EZ_TEST_BOOL(AllCompSame(a.HorizontalMin()));
+      EZ_TEST_BOOL(AllCompSame(a.HorizontalMax()));
+    }
+
+    {
+      ezSimdVec8f a(1.0f, 2.0f, 3.0f, 4.0f, 5.0f, 6.0f, 7.0f, 8.0f);
+      ezSimdVec8f b(2.0f, 2.0f, 2.0f, 2.0f, 0.5f, 0.5f, 0.5f, 0.5f);
+      ezSimdVec8f c(1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f, 1.0f, -1.0f);
+
+      EZ_TEST_BOOL(IsEqual(ezSimdVec8f::MulAdd(a, b, c), 3.0f, 3.0f, 7.0f, 7.0f, 3.5f, 2.0f, 4.5f, 3.0f));
+      EZ_TEST_BOOL(IsEqual(ezSimdVec8f::MulAdd(a, ezSimdFloat(2.0f), c), 3.0f, 3.0f, 7.0f, 7.0f, 11.0f, 11.0f, 15.0f, 15.0f));
+      EZ_TEST_BOOL(IsEqual(ezSimdVec8f::MulSub(a, b, c), 1.0f, 5.0f, 5.0f, 9.0f, 1.5f, 4.0f, 2.5f, 5.0f));
+      EZ_TEST_BOOL(IsEqual(ezSimdVec8f::MulSub(a, ezSimdFloat(2.0f), c), 1.0f, 5.0f, 5.0f, 9.0f, 9.0f, 13.0f, 13.0f, 17.0f));
+      EZ_TEST_BOOL(IsEqual(ezSimdVec8f::CopySign(a, c), 1.0f, -2.0f, 3.0f, -4.0f, 5.0f, -6.0f, 7.0f, -8.0f));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison")
+  {
+    ezSimdVec8f a(7.0f, 5.0f, 4.0f, 3.0f, 0.0f, -1.0f, ezMath::NaN<float>(), 2.0f);
+    ezSimdVec8f b(8.0f, 6.0f, 4.0f, 2.0f, 0.0f, -2.0f, 1.0f, 3.0f);
+
+    // NaN compares unequal to everything
+    EZ_TEST_INT((a == b).GetMask(), 0x14);
+    EZ_TEST_INT((a != b).GetMask(), 0xEB);
+    EZ_TEST_INT((a <= b).GetMask(), 0x97);
+    EZ_TEST_INT((a < b).GetMask(), 0x83);
+    EZ_TEST_INT((a >= b).GetMask(), 0x3C);
+    EZ_TEST_INT((a > b).GetMask(), 0x28);
+
+    ezSimdVec8f c(7.1f, 5.0f, 4.0f, 3.0f, 0.0f, -1.0f, 1.0f, 2.0f);
+    EZ_TEST_INT(c.IsEqual(a, ezSimdFloat(0.2f)).GetMask(), 0xBF);
+    EZ_TEST_INT(c.IsEqual(a, ezSimdFloat(0.01f)).GetMask(), 0xBE);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Benchmark")
+  {
+    constexpr ezUInt32 uiNumParticles = 64 * 1024;
+    constexpr ezUInt32 uiNumSteps = 50;
+
+    // the same kernels with 1, 4 and 8 values at a time
+    ParticleStreams particles[3];
+    ezTime tIntegrate[3];
+    ezTime tCull[3];
+    ezUInt32 uiVisible[3] = {};
+
+    for (ParticleStreams& p : particles)
+    {
+      p.Init(uiNumParticles);
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        IntegrateScalar(particles[0]);
+      tIntegrate[0] = sw.GetRunningTotal();
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        IntegrateSimd<ezSimdVec4f, 4>(particles[1]);
+      tIntegrate[1] = sw.GetRunningTotal();
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        IntegrateSimd<ezSimdVec8f, 8>(particles[2]);
+      tIntegrate[2] = sw.GetRunningTotal();
+    }
+
+    for (ezUInt32 i = 1; i < 3; ++i)
+    {
+      for (ezUInt32 j = 0; j < uiNumParticles; j += 997)
+      {
+        // the SIMD versions may use fused multiply-add
+        EZ_TEST_FLOAT(particles[i].m_PosX[j], particles[0].m_PosX[j], 0.001f);
+        EZ_TEST_FLOAT(particles[i].m_PosY[j], particles[0].m_PosY[j], 0.001f);
+        EZ_TEST_FLOAT(particles[i].m_VelY[j], particles[0].m_VelY[j], 0.001f);
+      }
+    }
+
+    const ezVec4 planes[6] = {
+      ezVec4(1, 0, 0, 0),
+      ezVec4(-1, 0, 0, 90),
+      ezVec4(0, 1, 0, 0),
+      ezVec4(0, -1, 0, 70),
+      ezVec4(0.70710678f, 0, 0.70710678f, -10),
+      ezVec4(0, 0, -1, 60),
+    };
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        uiVisible[0] = CullSpheresScalar(particles[0], planes, EZ_ARRAY_SIZE(planes));
+      tCull[0] = sw.GetRunningTotal();
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        uiVisible[1] = CullSpheres4(particles[0], planes, EZ_ARRAY_SIZE(planes));
+      tCull[1] = sw.GetRunningTotal();
+    }
+
+    {
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumSteps; ++i)
+        uiVisible[2] = CullSpheres8(particles[0], planes, EZ_ARRAY_SIZE(planes));
+      tCull[2] = sw.GetRunningTotal();
+    }
+
+    EZ_TEST_BOOL(uiVisible[0] > 0 && uiVisible[0] < uiNumParticles);
+
+    // distances right at the plane may be classified differently with fused multiply-add
+    EZ_TEST_BOOL(ezMath::Abs(static_cast<ezInt32>(uiVisible[1]) - static_cast<ezInt32>(uiVisible[0])) < 10);
+    EZ_TEST_BOOL(ezMath::Abs(static_cast<ezInt32>(uiVisible[2]) - static_cast<ezInt32>(uiVisible[0])) < 10);
+
+    ezLog::Info("[test]{} particles, {} steps, native 8-wide: {}", uiNumParticles, uiNumSteps, EZ_ENABLED(EZ_SIMD_VEC8_NATIVE) ? "yes" : "no");
+    ezLog::Info("[test]Integration: scalar {}, ezSimdVec4f {}, ezSimdVec8f {}", tIntegrate[0], tIntegrate[1], tIntegrate[2]);
+    ezLog::Info("[test]Sphere culling: scalar {}, ezSimdVec4f {}, ezSimdVec8f {}", tCull[0], tCull[1], tCull[2]);
+  }
+}
@@ -0,0 +1,253 @@
+#include <FoundationTest/FoundationTestPCH.h>
+
+#include <Foundation/SimdMath/SimdVec8i.h>
+
+namespace
+{
+  static bool IsEqual(const ezSimdVec8i& v, ezInt32 i0, ezInt32 i1, ezInt32 i2, ezInt32 i3, ezInt32 i4, ezInt32 i5, ezInt32 i6, ezInt32 i7)
+  {
+    ezInt32 stored[8];
+    v.Store(stored);
+
+    const ezInt32 expected[8] = {i0, i1, i2, i3, i4, i5, i6, i7};
+    return ezMemoryUtils::IsEqual(stored, expected, 8);
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(SimdMath, SimdVec8i)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Constructor")
+  {
+#if EZ_ENABLED(EZ_COMPILE_FOR_DEBUG) && EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+    // In debug the default constructor initializes everything with 0xCDCDCDCD.
+    ezSimdVec8i vDefCtor;
+    EZ_TEST_BOOL(IsEqual(vDefCtor, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD, 0xCDCDCDCD));
+#endif
+
+    // Make sure the class didn't accidentally change in size.
+    EZ_CHECK_AT_COMPILETIME(sizeof(ezSimdVec8i) == 32);
+#if EZ_ENABLED(EZ_SIMD_VEC8_NATIVE)
+    EZ_CHECK_AT_COMPILETIME(EZ_ALIGNMENT_OF(ezSimdVec8i) == 32);
+#endif
+
+    ezSimdVec8i a(2);
+    EZ_TEST_BOOL(IsEqual(a, 2, 2, 2, 2, 2, 2, 2, 2));
+
+    ezSimdVec8i b(1, 2, 3, 4, 5, 6, 7, 8);
+    EZ_TEST_BOOL(IsEqual(b, 1, 2, 3, 4, 5, 6, 7, 8));
+
+    ezSimdVec8i copy(b);
+    EZ_TEST_BOOL(IsEqual(copy, 1, 2, 3, 4, 5, 6, 7, 8));
+
+    EZ_TEST_INT(copy.GetComponent<0>(), 1);
+    EZ_TEST_INT(copy.GetComponent<3>(), 4);
+    EZ_TEST_INT(copy.GetComponent<4>(), 5);
+    EZ_TEST_INT(copy.GetComponent<7>(), 8);
+
+    ezSimdVec8i halves(ezSimdVec4i(1, 2, 3, 4), ezSimdVec4i(5, 6, 7, 8));
+    EZ_TEST_BOOL(IsEqual(halves, 1, 2, 3, 4, 5, 6, 7, 8));
+
+    ezSimdVec4i vLow = halves.GetLow();
+    ezSimdVec4i vHigh = halves.GetHigh();
+    EZ_TEST_BOOL(vLow.x() == 1 && vLow.y() == 2 && vLow.z() == 3 && vLow.w() == 4);
+    EZ_TEST_BOOL(vHigh.x() == 5 && vHigh.y() == 6 && vHigh.z() == 7 && vHigh.w() == 8);
+
+    ezSimdVec8i vZero = ezSimdVec8i::MakeZero();
+    EZ_TEST_BOOL(IsEqual(vZero, 0, 0, 0, 0, 0, 0, 0, 0));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Setter")
+  {
+    ezSimdVec8i a;
+    a.Set(2);
+    EZ_TEST_BOOL(IsEqual(a, 2, 2, 2, 2, 2, 2, 2, 2));
+
+    ezSimdVec8i b;
+    b.Set(1, 2, 3, 4, 5, 6, 7, 8);
+    EZ_TEST_BOOL(IsEqual(b, 1, 2, 3, 4, 5, 6, 7, 8));
+
+    ezSimdVec8i vSetZero;
+    vSetZero.SetZero();
+    EZ_TEST_BOOL(IsEqual(vSetZero, 0, 0, 0, 0, 0, 0, 0, 0));
+
+    {
+      const ezInt32 testBlock[8] = {1, 2, 3, 4, 5, 6, 7, 8};
+
+      ezSimdVec8i v;
+      v.Load<1>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 0, 0, 0, 0, 0, 0, 0));
+
+      v.Load<3>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 2, 3, 0, 0, 0, 0, 0));
+
+      v.Load<4>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 2, 3, 4, 0, 0, 0, 0));
+
+      v.Load<5>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 2, 3, 4, 5, 0, 0, 0));
+
+      v.Load<7>(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 2, 3, 4, 5, 6, 7, 0));
+
+      v.Load(testBlock);
+      EZ_TEST_BOOL(IsEqual(v, 1, 2, 3, 4, 5, 6, 7, 8));
+    }
+
+    {
+      ezSimdVec8i v(1, 2, 3, 4, 5, 6, 7, 8);
+
+      ezInt32 mem[8];
+
+      ezMemoryUtils::PatternFillArray(mem, 0x07);
+      v.Store<2>(mem);
+      EZ_TEST_BOOL(mem[0] == 1 && mem[1] == 2 && mem[2] == 0x07070707 && mem[7] == 0x07070707);
+
+      ezMemoryUtils::PatternFillArray(mem, 0x07);
+      v.Store<4>(mem);
+      EZ_TEST_BOOL(mem[3] == 4 && mem[4] == 0x07070707);
+
+      ezMemoryUtils::PatternFillArray(mem, 0x07);
+      v.Store<6>(mem);
+      EZ_TEST_BOOL(mem[0] == 1 && mem[5] == 6 && mem[6] == 0x07070707 && mem[7] == 0x07070707);
+
+      ezMemoryUtils::PatternFillArray(mem, 0x07);
+      v.Store(mem);
+      EZ_TEST_BOOL(mem[0] == 1 && mem[7] == 8);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Conversion")
+  {
+    ezSimdVec8i ia(-3, 5, -7, 11, 0, 1, -1, 100000);
+
+    ezSimdVec8f fa = ia.ToFloat();
+    EZ_TEST_BOOL((fa == ezSimdVec8f(-3.0f, 5.0f, -7.0f, 11.0f, 0.0f, 1.0f, -1.0f, 100000.0f)).AllSet());
+
+    fa = ezSimdVec8f(-2.3f, 5.7f, -2147483520.0f, 2147483520.0f, 0.5f, -0.5f, 1.99f, -1.99f);
+    ezSimdVec8i b = ezSimdVec8i::Truncate(fa);
+    EZ_TEST_BOOL(IsEqual(b, -2, 5, -2147483520, 2147483520, 0, 0, 1, -1));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Operators")
+  {
+    {
+      ezSimdVec8i a(-3, 5, -7, 9, 2, -4, 6, -8);
+
+      ezSimdVec8i b = -a;
+      EZ_TEST_BOOL(IsEqual(b, 3, -5, 7, -9, -2, 4, -6, 8));
+    }
+
+    {
+      ezSimdVec8i a(-3, 5, -7, 9, 2, -4, 6, -8);
+      ezSimdVec8i b(8, 6, 4, 2, 1, 3, 5, 7);
+
+      ezSimdVec8i c = a + b;
+      EZ_TEST_BOOL(IsEqual(c, 5, 11, -3, 11, 3, -1, 11, -1));
+
+      c = a - b;
+      EZ_TEST_BOOL(IsEqual(c, -11, -1, -11, 7, 1, -7, 1, -15));
+
+      c = a.CompMul(b);
+      EZ_TEST_BOOL(IsEqual(c, -24, 30, -28, 18, 2, -12, 30, -56));
+
+      c = a;
+      c += b;
+      EZ_TEST_BOOL(IsEqual(c, 5, 11, -3, 11, 3, -1, 11, -1));
+
+      c = a;
+      c -= b;
+      EZ_TEST_BOOL(IsEqual(c, -11, -1, -11, 7, 1, -7, 1, -15));
+    }
+
+    {
+      ezSimdVec8i a(0x7, 0x70, 0x700, 0x7000, 0x70000, 0x700000, 0x7000000, 0x70000000);
+      ezSimdVec8i b(0x5, 0x50, 0x500, 0x5000, 0x5, 0x50, 0x500, 0x5000);
+
+      ezSimdVec8i c = a | b;
+      EZ_TEST_BOOL(IsEqual(c, 0x7, 0x70, 0x700, 0x7000, 0x70005, 0x700050, 0x7000500, 0x70005000));
+
+      c = a & b;
+      EZ_TEST_BOOL(IsEqual(c, 0x5, 0x50, 0x500, 0x5000, 0, 0, 0, 0));
+
+      c = a ^ b;
+      EZ_TEST_BOOL(IsEqual(c, 0x2, 0x20, 0x200, 0x2000, 0x70005, 0x700050, 0x7000500, 0x70005000));
+
+      c = ~a;
+      EZ_TEST_BOOL(IsEqual(c, ~0x7, ~0x70, ~0x700, ~0x7000, ~0x70000, ~0x700000, ~0x7000000, ~0x70000000));
+
+      c = a;
+      c |= b;
+      EZ_TEST_BOOL(IsEqual(c, 0x7, 0x70, 0x700, 0x7000, 0x70005, 0x700050, 0x7000500, 0x70005000));
+
+      c = a;
+      c &= b;
+      EZ_TEST_BOOL(IsEqual(c, 0x5, 0x50, 0x500, 0x5000, 0, 0, 0, 0));
+
+      c = a;
+      c ^= b;
+      EZ_TEST_BOOL(IsEqual(c, 0x2, 0x20, 0x200, 0x2000, 0x70005, 0x700050, 0x7000500, 0x70005000));
+    }
+
+    {
+      ezSimdVec8i a(1, 2, 3, 4, -1, -2, -16, 0x40000000);
+
+      ezSimdVec8i c = a << 3;
+      EZ_TEST_BOOL(IsEqual(c, 8, 16, 24, 32, -8, -16, -128, 0));
+
+      c = a >> 1;
+      EZ_TEST_BOOL(IsEqual(c, 0, 1, 1, 2, -1, -1, -8, 0x20000000));
+
+      c = a;
+      c <<= 3;
+      EZ_TEST_BOOL(IsEqual(c, 8, 16, 24, 32, -8, -16, -128, 0));
+
+      c = a;
+      c >>= 1;
+      EZ_TEST_BOOL(IsEqual(c, 0, 1, 1, 2, -1, -1, -8, 0x20000000));
+
+      ezSimdVec8i s(0, 1, 2, 3, 0, 1, 2, 3);
+
+      c = a << s;
+      EZ_TEST_BOOL(IsEqual(c, 1, 4, 12, 32, -1, -4, -64, 0));
+
+      c = a >> s;
+      EZ_TEST_BOOL(IsEqual(c, 1, 1, 0, 0, -1, -1, -4, 0x08000000));
+    }
+
+    {
+      ezSimdVec8i a(-3, 5, -7, 9, 2, -4, 6, -8);
+      ezSimdVec8i b(8, 6, 4, 2, 1, 3, 5, 7);
+
+      ezSimdVec8i c = a.CompMin(b);
+      EZ_TEST_BOOL(IsEqual(c, -3, 5, -7, 2, 1, -4, 5, -8));
+
+      c = a.CompMax(b);
+      EZ_TEST_BOOL(IsEqual(c, 8, 6, 4, 9, 2, 3, 6, 7));
+
+      c = a.Abs();
+      EZ_TEST_BOOL(IsEqual(c, 3, 5, 7, 9, 2, 4, 6, 8));
+    }
+
+    {
+      ezSimdVec8b cmp(false, true, false, true, true, false, true, false);
+      ezSimdVec8i a(1, 2, 3, 4, 5, 6, 7, 8);
+      ezSimdVec8i b(-1, -2, -3, -4, -5, -6, -7, -8);
+
+      ezSimdVec8i c = ezSimdVec8i::Select(cmp, a, b);
+      EZ_TEST_BOOL(IsEqual(c, -1, 2, -3, 4, 5, -6, 7, -8));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Comparison")
+  {
+    ezSimdVec8i a(-7, 5, 4, 3, 0, 10, -10, 1);
+    ezSimdVec8i b(8, 6, 4, 2, 0, -10, 10, 2);
+
+    EZ_TEST_INT((a == b).GetMask(), 0x14);
+    EZ_TEST_INT((a != b).GetMask(), 0xEB);
+    EZ_TEST_INT((a <= b).GetMask(), 0xD7);
+    EZ_TEST_INT((a < b).GetMask(), 0xC3);
+    EZ_TEST_INT((a >= b).GetMask(), 0x3C);
+    EZ_TEST_INT((a > b).GetMask(), 0x28);
+  }
+}
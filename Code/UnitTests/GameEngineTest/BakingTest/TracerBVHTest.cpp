@@ -0,0 +1,301 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <BakingPlugin/Tracer/TracerBVH.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Baking);
+
+namespace
+{
+  using Ray = ezTracerInterface::Ray;
+  using Hit = ezTracerInterface::Hit;
+
+  struct TriangleSoup
+  {
+    ezDynamicArray<ezVec3> m_Positions;
+    ezDynamicArray<ezVec3> m_Normals;
+    ezDynamicArray<ezUInt32> m_Indices;
+
+    void AddTriangle(const ezVec3& a, const ezVec3& b, const ezVec3& c)
+    {
+      const ezVec3 vNormal = (b - a).CrossRH(c - a).GetNormalized();
+
+      for (const ezVec3& v : {a, b, c})
+      {
+        m_Indices.PushBack(m_Positions.GetCount());
+        m_Positions.PushBack(v);
+        m_Normals.PushBack(vNormal);
+      }
+    }
+
+    void AddQuad(const ezVec3& a, const ezVec3& b, const ezVec3& c, const ezVec3& d)
+    {
+      AddTriangle(a, b, c);
+      AddTriangle(a, c, d);
+    }
+
+    /// \brief Adds an axis aligned box with outward facing normals.
+    void AddBox(const ezVec3& vMin, const ezVec3& vMax)
+    {
+      const ezVec3 p[8] = {
+        ezVec3(vMin.x, vMin.y, vMin.z), ezVec3(vMax.x, vMin.y, vMin.z), ezVec3(vMax.x, vMax.y, vMin.z), ezVec3(vMin.x, vMax.y, vMin.z),
+        ezVec3(vMin.x, vMin.y, vMax.z), ezVec3(vMax.x, vMin.y, vMax.z), ezVec3(vMax.x, vMax.y, vMax.z), ezVec3(vMin.x, vMax.y, vMax.z)};
+
+      AddQuad(p[0], p[3], p[2], p[1]); // -z
+      AddQuad(p[4], p[5], p[6], p[7]); // +z
+      AddQuad(p[0], p[1], p[5], p[4]); // -y
+      AddQuad(p[3], p[7], p[6], p[2]); // +y
+      AddQuad(p[0], p[4], p[7], p[3]); // -x
+      AddQuad(p[1], p[2], p[6], p[5]); // +x
+    }
+
+    void AddRandomTriangles(ezRandom& ref_rnd, ezUInt32 uiCount, const ezVec3& vMin, const ezVec3& vMax, float fSize)
+    {
+      for (ezUInt32 i = 0; i < uiCount; ++i)
+      {
+        const ezVec3 vCenter(ref_rnd.FloatMinMax(vMin.x, vMax.x), ref_rnd.FloatMinMax(vMin.y, vMax.y), ref_rnd.FloatMinMax(vMin.z, vMax.z));
+
+        ezVec3 v[3];
+        for (ezVec3& vCorner : v)
+        {
+          vCorner = vCenter + ezVec3(ref_rnd.FloatMinMax(-fSize, fSize), ref_rnd.FloatMinMax(-fSize, fSize), ref_rnd.FloatMinMax(-fSize, fSize));
+        }
+
+        AddTriangle(v[0], v[1], v[2]);
+      }
+    }
+  };
+
+  /// \brief Tests the ray against every triangle, the reference for ezTracerBVH.
+  void TraceBruteForce(const TriangleSoup& soup, const Ray& ray, Hit& out_hit)
+  {
+    out_hit.m_vPosition.SetZero();
+    out_hit.m_vNormal.SetZero();
+    out_hit.m_fDistance = -1.0f;
+
+    float fClosest = ray.m_fDistance;
+
+    for (ezUInt32 i = 0; i < soup.m_Indices.GetCount(); i += 3)
+    {
+      const ezVec3& v0 = soup.m_Positions[soup.m_Indices[i + 0]];
+      const ezVec3 e1 = soup.m_Positions[soup.m_Indices[i + 1]] - v0;
+      const ezVec3 e2 = soup.m_Positions[soup.m_Indices[i + 2]] - v0;
+
+      const ezVec3 p = ray.m_vDir.CrossRH(e2);
+      const float fDet = e1.Dot(p);
+      if (fDet == 0.0f)
+        continue;
+
+      const float fInvDet = 1.0f / fDet;
+      const ezVec3 t = ray.m_vStartPos - v0;
+      const float u = t.Dot(p) * fInvDet;
+      if (u < 0.0f || u > 1.0f)
+        continue;
+
+      const ezVec3 q = t.CrossRH(e1);
+      const float v = ray.m_vDir.Dot(q) * fInvDet;
+      if (v < 0.0f || u + v > 1.0f)
+        continue;
+
+      const float fDistance = e2.Dot(q) * fInvDet;
+      if (fDistance < 0.0f || fDistance >= fClosest)
+        continue;
+
+      fClosest = fDistance;
+
+      const ezVec3* pNormals = &soup.m_Normals[soup.m_Indices[i]];
+      out_hit.m_vNormal = (pNormals[0] * (1.0f - u - v) + pNormals[1] * u + pNormals[2] * v).GetNormalized();
+      out_hit.m_fDistance = fDistance;
+      out_hit.m_vPosition = ray.m_vStartPos + ray.m_vDir * fDistance;
+    }
+  }
+
+  Ray MakeRay(const ezVec3& vStart, const ezVec3& vDir, float fDistance = 1000.0f)
+  {
+    Ray ray;
+    ray.m_vStartPos = vStart;
+    ray.m_vDir = vDir.GetNormalized();
+    ray.m_fDistance = fDistance;
+    return ray;
+  }
+
+  void CreateRandomRays(ezRandom& ref_rnd, ezUInt32 uiCount, float fRange, ezDynamicArray<Ray>& out_rays)
+  {
+    out_rays.SetCountUninitialized(uiCount);
+    for (Ray& ray : out_rays)
+    {
+      ezVec3 vDir;
+      do
+      {
+        vDir.Set(ref_rnd.FloatMinMax(-1, 1), ref_rnd.FloatMinMax(-1, 1), ref_rnd.FloatMinMax(-1, 1));
+      } while (vDir.GetLengthSquared() < 0.01f);
+
+      ray = MakeRay(ezVec3(ref_rnd.FloatMinMax(-fRange, fRange), ref_rnd.FloatMinMax(-fRange, fRange), ref_rnd.FloatMinMax(-fRange, fRange)), vDir);
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Baking, TracerBVH)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty Scene")
+  {
+    ezTracerBVH tracer;
+    EZ_TEST_BOOL(tracer.BuildScene(ezArrayPtr<const ezVec3>(), ezArrayPtr<const ezVec3>(), ezArrayPtr<const ezUInt32>()).Succeeded());
+
+    const Ray ray = MakeRay(ezVec3::MakeZero(), ezVec3(0, 0, 1));
+    Hit hit;
+    tracer.TraceRays(ezMakeArrayPtr(&ray, 1), ezMakeArrayPtr(&hit, 1));
+    EZ_TEST_FLOAT(hit.m_fDistance, -1.0f, 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Box on a Plane")
+  {
+    // a 2x2x2 box standing on a 20x20 ground plane at z = 0
+    TriangleSoup soup;
+    soup.AddQuad(ezVec3(-10, -10, 0), ezVec3(10, -10, 0), ezVec3(10, 10, 0), ezVec3(-10, 10, 0));
+    soup.AddBox(ezVec3(-1, -1, 0), ezVec3(1, 1, 2));
+
+    ezTracerBVH tracer;
+    EZ_TEST_BOOL(tracer.BuildScene(soup.m_Positions, soup.m_Normals, soup.m_Indices).Succeeded());
+
+    struct Expected
+    {
+      Ray m_Ray;
+      float m_fDistance;
+      ezVec3 m_vNormal;
+    };
+
+    const Expected expected[] = {
+      {MakeRay(ezVec3(0.3f, -0.2f, 10), ezVec3(0, 0, -1)), 8.0f, ezVec3(0, 0, 1)},    // box top
+      {MakeRay(ezVec3(5, 5, 10), ezVec3(0, 0, -1)), 10.0f, ezVec3(0, 0, 1)},          // ground next to the box
+      {MakeRay(ezVec3(-6, 0.5f, 1), ezVec3(1, 0, 0)), 5.0f, ezVec3(-1, 0, 0)},        // box side
+      {MakeRay(ezVec3(0, 7, 1.5f), ezVec3(0, -1, 0)), 6.0f, ezVec3(0, 1, 0)},         // opposite box side
+      {MakeRay(ezVec3(4, 0, 4), ezVec3(-1, 0, -1)), ezMath::Sqrt(18.0f), ezVec3(1, 0, 0)}, // diagonal onto the box side at (1, 0, 1)
+      {MakeRay(ezVec3(0, 0, 10), ezVec3(0, 0, -1), 5.0f), -1.0f, ezVec3::MakeZero()}, // too short
+      {MakeRay(ezVec3(0, 0, 10), ezVec3(0, 0, 1)), -1.0f, ezVec3::MakeZero()},        // pointing away
+      {MakeRay(ezVec3(20, 0, 1), ezVec3(0, 0, -1)), -1.0f, ezVec3::MakeZero()},       // beside the plane
+      {MakeRay(ezVec3(5, 5, -5), ezVec3(0, 0, 1)), 5.0f, ezVec3(0, 0, 1)},            // back faces are hit as well
+    };
+
+    for (const Expected& e : expected)
+    {
+      Hit hit;
+      tracer.TraceRays(ezMakeArrayPtr(&e.m_Ray, 1), ezMakeArrayPtr(&hit, 1));
+
+      Hit reference;
+      TraceBruteForce(soup, e.m_Ray, reference);
+
+      EZ_TEST_FLOAT(hit.m_fDistance, e.m_fDistance, 0.0001f);
+      EZ_TEST_FLOAT(reference.m_fDistance, e.m_fDistance, 0.0001f);
+
+      if (e.m_fDistance >= 0.0f)
+      {
+        EZ_TEST_VEC3(hit.m_vNormal, e.m_vNormal, 0.0001f);
+        EZ_TEST_VEC3(hit.m_vPosition, e.m_Ray.m_vStartPos + e.m_Ray.m_vDir * e.m_fDistance, 0.0001f);
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compare to Brute Force")
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    // boxes and random triangles of very different sizes, so that the hierarchy has empty space and overlapping nodes
+    TriangleSoup soup;
+    soup.AddQuad(ezVec3(-50, -50, -20), ezVec3(50, -50, -20), ezVec3(50, 50, -20), ezVec3(-50, 50, -20));
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      const ezVec3 vMin(rnd.FloatMinMax(-20, 15), rnd.FloatMinMax(-20, 15), rnd.FloatMinMax(-20, 15));
+      soup.AddBox(vMin, vMin + ezVec3(rnd.FloatMinMax(0.5f, 5), rnd.FloatMinMax(0.5f, 5), rnd.FloatMinMax(0.5f, 5)));
+    }
+    soup.AddRandomTriangles(rnd, 2000, ezVec3(-20), ezVec3(20), 0.5f);
+    soup.AddRandomTriangles(rnd, 50, ezVec3(-20), ezVec3(20), 8.0f);
+
+    ezTracerBVH tracer;
+    EZ_TEST_BOOL(tracer.BuildScene(soup.m_Positions, soup.m_Normals, soup.m_Indices).Succeeded());
+
+    ezDynamicArray<Ray> rays;
+    CreateRandomRays(rnd, 5000, 25.0f, rays);
+
+    ezDynamicArray<Hit> hits;
+    hits.SetCountUninitialized(rays.GetCount());
+    tracer.TraceRays(rays, hits);
+
+    ezUInt32 uiNumHits = 0;
+    ezUInt32 uiNumMismatches = 0;
+
+    for (ezUInt32 i = 0; i < rays.GetCount(); ++i)
+    {
+      Hit reference;
+      TraceBruteForce(soup, rays[i], reference);
+
+      const bool bSameDistance = ezMath::IsEqual(hits[i].m_fDistance, reference.m_fDistance, 0.0001f);
+
+      // rays that hit an edge exactly may report either of the adjacent triangles
+      const bool bSameNormal = reference.m_fDistance < 0.0f || hits[i].m_vNormal.IsEqual(reference.m_vNormal, 0.001f);
+
+      if (!bSameDistance || !bSameNormal)
+      {
+        ++uiNumMismatches;
+      }
+
+      if (reference.m_fDistance >= 0.0f)
+      {
+        ++uiNumHits;
+      }
+    }
+
+    // make sure the rays actually test something
+    EZ_TEST_BOOL(uiNumHits > rays.GetCount() / 4);
+    EZ_TEST_BOOL(uiNumHits < rays.GetCount());
+    EZ_TEST_INT(uiNumMismatches, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    ezRandom rnd;
+    rnd.Initialize(13);
+
+    TriangleSoup soup;
+    soup.AddRandomTriangles(rnd, 100000, ezVec3(-50), ezVec3(50), 1.0f);
+
+    ezStopwatch sw;
+    ezTracerBVH tracer;
+    EZ_TEST_BOOL(tracer.BuildScene(soup.m_Positions, soup.m_Normals, soup.m_Indices).Succeeded());
+    const ezTime buildTime = sw.GetRunningTotal();
+
+    ezDynamicArray<Ray> rays;
+    CreateRandomRays(rnd, 200000, 60.0f, rays);
+
+    ezDynamicArray<Hit> hits;
+    hits.SetCountUninitialized(rays.GetCount());
+
+    sw.StopAndReset();
+    sw.Resume();
+    tracer.TraceRays(rays, hits);
+    const ezTime bvhTime = sw.GetRunningTotal();
+
+    // the brute force tracer is way too slow for all rays
+    const ezUInt32 uiNumBruteForceRays = 100;
+
+    sw.StopAndReset();
+    sw.Resume();
+    for (ezUInt32 i = 0; i < uiNumBruteForceRays; ++i)
+    {
+      Hit reference;
+      TraceBruteForce(soup, rays[i], reference);
+      EZ_TEST_FLOAT(hits[i].m_fDistance, reference.m_fDistance, 0.0001f);
+    }
+    const ezTime bruteForceTime = sw.GetRunningTotal();
+
+    const double fBvhRaysPerSecond = rays.GetCount() / bvhTime.GetSeconds();
+    const double fBruteForceRaysPerSecond = uiNumBruteForceRays / bruteForceTime.GetSeconds();
+
+    ezLog::Info("[test]{} triangles, BVH build: {}ms", soup.m_Indices.GetCount() / 3, ezArgF(buildTime.GetMilliseconds(), 1));
+    ezLog::Info("[test]BVH: {} rays/s, brute force: {} rays/s", ezArgF(fBvhRaysPerSecond, 0), ezArgF(fBruteForceRaysPerSecond, 0));
+
+    EZ_TEST_BOOL(fBvhRaysPerSecond > fBruteForceRaysPerSecond);
+  }
+}
@@ -0,0 +1,385 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <Utilities/PathFinding/GraphSearch.h>
+#include <Utilities/PathFinding/GridNavmesh.h>
+
+namespace PathSearchTestDetail
+{
+  /// Cell value is the cost to enter the cell, zero means blocked.
+  using CostGrid = ezGameGrid<ezUInt8>;
+
+  static void CreateGrid(CostGrid& ref_grid, ezUInt16 uiSize, ezUInt32 uiSeed)
+  {
+    ezRandom rnd;
+    rnd.Initialize(uiSeed);
+
+    ref_grid.CreateGrid(uiSize, uiSize);
+
+    // terrain patches of different costs
+    constexpr ezUInt32 uiPatchSize = 8;
+    for (ezUInt32 py = 0; py < uiSize; py += uiPatchSize)
+    {
+      for (ezUInt32 px = 0; px < uiSize; px += uiPatchSize)
+      {
+        const ezUInt8 uiCost = static_cast<ezUInt8>(1 + rnd.UIntInRange(3));
+
+        for (ezUInt32 y = py; y < ezMath::Min<ezUInt32>(py + uiPatchSize, uiSize); ++y)
+        {
+          for (ezUInt32 x = px; x < ezMath::Min<ezUInt32>(px + uiPatchSize, uiSize); ++x)
+          {
+            ref_grid.GetCell(ezVec2I32(x, y)) = uiCost;
+          }
+        }
+      }
+    }
+
+    // walls
+    const ezUInt32 uiNumWalls = uiSize * uiSize / 128;
+    for (ezUInt32 i = 0; i < uiNumWalls; ++i)
+    {
+      const ezInt32 x = rnd.IntInRange(0, uiSize);
+      const ezInt32 y = rnd.IntInRange(0, uiSize);
+      const ezInt32 iLength = rnd.IntMinMax(4, 16);
+      const bool bHorizontal = rnd.Bool();
+
+      for (ezInt32 l = 0; l < iLength; ++l)
+      {
+        const ezVec2I32 vCoord = bHorizontal ? ezVec2I32(x + l, y) : ezVec2I32(x, y + l);
+
+        if (ref_grid.IsValidCellCoordinate(vCoord))
+        {
+          ref_grid.GetCell(vCoord) = 0;
+        }
+      }
+    }
+
+    // keep the corners free, they are used as start and target
+    ref_grid.GetCell(ezVec2I32(0, 0)) = 1;
+    ref_grid.GetCell(ezVec2I32(uiSize - 1, uiSize - 1)) = 1;
+  }
+
+  static bool IsSameCellType(ezUInt32 uiCell1, ezUInt32 uiCell2, void* pPassThrough)
+  {
+    const CostGrid* pGrid = static_cast<const CostGrid*>(pPassThrough);
+    return pGrid->GetCell(uiCell1) == pGrid->GetCell(uiCell2);
+  }
+
+  static bool IsCellBlocked(ezUInt32 uiCell, void* pPassThrough)
+  {
+    const CostGrid* pGrid = static_cast<const CostGrid*>(pPassThrough);
+    return pGrid->GetCell(uiCell) == 0;
+  }
+
+  class GridStateGenerator : public ezPathStateGenerator<ezPathState>
+  {
+  public:
+    GridStateGenerator(const CostGrid& grid)
+      : m_Grid(grid)
+    {
+    }
+
+    virtual void StartSearch(ezInt64 iStartNodeIndex, const ezPathState* pStartState, ezInt64 iTargetNodeIndex) override
+    {
+      m_vTarget = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iTargetNodeIndex));
+    }
+
+    virtual void GenerateAdjacentStates(ezInt64 iNodeIndex, const ezPathState& StartState, ezPathSearch<ezPathState>* pPathSearch) override
+    {
+      const ezVec2I32 vCoord = m_Grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(iNodeIndex));
+      const ezVec2I32 neighbors[4] = {ezVec2I32(vCoord.x - 1, vCoord.y), ezVec2I32(vCoord.x + 1, vCoord.y), ezVec2I32(vCoord.x, vCoord.y - 1), ezVec2I32(vCoord.x, vCoord.y + 1)};
+
+      for (const ezVec2I32& vNeighbor : neighbors)
+      {
+        if (!m_Grid.IsValidCellCoordinate(vNeighbor))
+          continue;
+
+        const ezUInt8 uiCost = m_Grid.GetCell(vNeighbor);
+        if (uiCost == 0)
+          continue;
+
+        if (m_pCorridor != nullptr && !m_pCorridor->IsBitSet(m_pNavmesh->GetAreaAt(vNeighbor)))
+          continue;
+
+        // the cheapest cell costs 1, so the manhattan distance never overestimates
+        ezPathState state;
+        state.m_fCostToNode = StartState.m_fCostToNode + uiCost;
+        state.m_fEstimatedCostToTarget = state.m_fCostToNode + ezMath::Abs(m_vTarget.x - vNeighbor.x) + ezMath::Abs(m_vTarget.y - vNeighbor.y);
+
+        pPathSearch->AddPathNode(m_Grid.ConvertCellCoordinateToIndex(vNeighbor), state);
+      }
+    }
+
+    const CostGrid& m_Grid;
+    ezVec2I32 m_vTarget = ezVec2I32(0, 0);
+
+    const ezGridNavmesh* m_pNavmesh = nullptr;
+    const ezDynamicBitfield* m_pCorridor = nullptr;
+  };
+
+  /// Plain Dijkstra with a linear search for the next node, used as the reference for the path costs.
+  static float FindReferencePathCost(const CostGrid& grid, const ezVec2I32& vStart, const ezVec2I32& vTarget)
+  {
+    ezDynamicArray<float> costs;
+    costs.SetCount(grid.GetNumCells(), ezMath::Infinity<float>());
+
+    ezDynamicBitfield done;
+    done.SetCount(grid.GetNumCells());
+
+    ezDynamicArray<ezUInt32> open;
+
+    costs[grid.ConvertCellCoordinateToIndex(vStart)] = 0.0f;
+    open.PushBack(grid.ConvertCellCoordinateToIndex(vStart));
+
+    while (!open.IsEmpty())
+    {
+      ezUInt32 uiBest = 0;
+      for (ezUInt32 i = 1; i < open.GetCount(); ++i)
+      {
+        if (costs[open[i]] < costs[open[uiBest]])
+          uiBest = i;
+      }
+
+      const ezUInt32 uiCell = open[uiBest];
+      open.RemoveAtAndSwap(uiBest);
+
+      if (done.IsBitSet(uiCell))
+        continue;
+
+      done.SetBit(uiCell);
+
+      const ezVec2I32 vCoord = grid.ConvertCellIndexToCoordinate(uiCell);
+      if (vCoord == vTarget)
+        return costs[uiCell];
+
+      const ezVec2I32 neighbors[4] = {ezVec2I32(vCoord.x - 1, vCoord.y), ezVec2I32(vCoord.x + 1, vCoord.y), ezVec2I32(vCoord.x, vCoord.y - 1), ezVec2I32(vCoord.x, vCoord.y + 1)};
+
+      for (const ezVec2I32& vNeighbor : neighbors)
+      {
+        if (!grid.IsValidCellCoordinate(vNeighbor) || grid.GetCell(vNeighbor) == 0)
+          continue;
+
+        const ezUInt32 uiNeighbor = grid.ConvertCellCoordinateToIndex(vNeighbor);
+        const float fCost = costs[uiCell] + grid.GetCell(vNeighbor);
+
+        if (fCost < costs[uiNeighbor])
+        {
+          costs[uiNeighbor] = fCost;
+          open.PushBack(uiNeighbor);
+        }
+      }
+    }
+
+    return ezMath::Infinity<float>();
+  }
+
+  static bool IsValidPath(const CostGrid& grid, const ezDeque<ezPathSearch<ezPathState>::PathResultData>& path)
+  {
+    for (ezUInt32 i = 1; i < path.GetCount(); ++i)
+    {
+      const ezVec2I32 vPrev = grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(path[i - 1].m_iNodeIndex));
+      const ezVec2I32 vCur = grid.ConvertCellIndexToCoordinate(static_cast<ezUInt32>(path[i].m_iNodeIndex));
+
+      if (ezMath::Abs(vPrev.x - vCur.x) + ezMath::Abs(vPrev.y - vCur.y) != 1 || grid.GetCell(vCur) == 0)
+        return false;
+
+      if (path[i].m_pPathState->m_fCostToNode != path[i - 1].m_pPathState->m_fCostToNode + grid.GetCell(vCur))
+        return false;
+    }
+
+    return true;
+  }
+
+  static ezResult FindHierarchicalPath(const CostGrid& grid, const ezGridNavmesh& navmesh, const ezVec2I32& vStart, const ezVec2I32& vTarget,
+    ezPathSearch<ezPathState>& ref_search, GridStateGenerator& ref_generator, ezDeque<ezPathSearch<ezPathState>::PathResultData>& out_Path)
+  {
+    ezDynamicArray<ezInt32> areaPath;
+    EZ_SUCCEED_OR_RETURN(navmesh.FindAreaPath(vStart, vTarget, areaPath));
+
+    ezDynamicBitfield corridor;
+    navmesh.MarkAreaCorridor(areaPath, corridor);
+
+    ref_generator.m_pNavmesh = &navmesh;
+    ref_generator.m_pCorridor = &corridor;
+
+    const ezResult res = ref_search.FindPath(grid.ConvertCellCoordinateToIndex(vStart), ezPathState(), grid.ConvertCellCoordinateToIndex(vTarget), out_Path);
+
+    ref_generator.m_pNavmesh = nullptr;
+    ref_generator.m_pCorridor = nullptr;
+
+    return res;
+  }
+} // namespace PathSearchTestDetail
+
+using namespace PathSearchTestDetail;
+
+EZ_CREATE_SIMPLE_TEST(DataStructures, PathSearch)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Path costs match reference")
+  {
+    CostGrid grid;
+    CreateGrid(grid, 64, 7);
+
+    GridStateGenerator generator(grid);
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    ezPathSearch<ezPathState> sparseSearch;
+    sparseSearch.SetPathStateGenerator(&generator);
+
+    ezPathSearch<ezPathState> denseSearch;
+    denseSearch.SetPathStateGenerator(&generator);
+    denseSearch.SetDenseNodeIndexRange(grid.GetNumCells());
+
+    ezRandom rnd;
+    rnd.Initialize(11);
+
+    ezUInt32 uiNumFound = 0;
+
+    for (ezUInt32 i = 0; i < 20; ++i)
+    {
+      const ezVec2I32 vStart(rnd.IntInRange(0, 64), rnd.IntInRange(0, 64));
+      const ezVec2I32 vTarget(rnd.IntInRange(0, 64), rnd.IntInRange(0, 64));
+
+      if (grid.GetCell(vStart) == 0 || grid.GetCell(vTarget) == 0)
+        continue;
+
+      const float fReferenceCost = FindReferencePathCost(grid, vStart, vTarget);
+      const ezUInt32 uiStart = grid.ConvertCellCoordinateToIndex(vStart);
+      const ezUInt32 uiTarget = grid.ConvertCellCoordinateToIndex(vTarget);
+
+      for (ezPathSearch<ezPathState>* pSearch : {&sparseSearch, &denseSearch})
+      {
+        if (pSearch->FindPath(uiStart, ezPathState(), uiTarget, path).Succeeded())
+        {
+          EZ_TEST_FLOAT(path.PeekBack().m_pPathState->m_fCostToNode, fReferenceCost, 0.0f);
+          EZ_TEST_INT(path.PeekFront().m_iNodeIndex, uiStart);
+          EZ_TEST_INT(path.PeekBack().m_iNodeIndex, uiTarget);
+          EZ_TEST_BOOL(IsValidPath(grid, path));
+          ++uiNumFound;
+        }
+        else
+        {
+          EZ_TEST_BOOL(fReferenceCost == ezMath::Infinity<float>());
+        }
+      }
+    }
+
+    EZ_TEST_BOOL(uiNumFound > 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Max path cost")
+  {
+    CostGrid grid;
+    CreateGrid(grid, 64, 7);
+
+    GridStateGenerator generator(grid);
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+    search.SetDenseNodeIndexRange(grid.GetNumCells());
+
+    const float fReferenceCost = FindReferencePathCost(grid, ezVec2I32(0, 0), ezVec2I32(63, 63));
+    EZ_TEST_BOOL(fReferenceCost < ezMath::Infinity<float>());
+
+    EZ_TEST_BOOL(search.FindPath(0, ezPathState(), grid.GetNumCells() - 1, path, fReferenceCost * 0.5f).Failed());
+    EZ_TEST_BOOL(search.FindPath(0, ezPathState(), grid.GetNumCells() - 1, path, fReferenceCost + 1.0f).Succeeded());
+    EZ_TEST_BOOL(search.FindPath(0, ezPathState(), 0, path).Succeeded());
+    EZ_TEST_INT(path.GetCount(), 1);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Hierarchical search")
+  {
+    CostGrid grid;
+    CreateGrid(grid, 128, 3);
+
+    ezGridNavmesh navmesh;
+    navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+
+    GridStateGenerator generator(grid);
+    ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+    ezPathSearch<ezPathState> search;
+    search.SetPathStateGenerator(&generator);
+    search.SetDenseNodeIndexRange(grid.GetNumCells());
+
+    ezDynamicArray<ezInt32> areaPath;
+    EZ_TEST_BOOL(navmesh.FindAreaPath(ezVec2I32(0, 0), ezVec2I32(127, 127), areaPath).Succeeded());
+    EZ_TEST_INT(areaPath[0], navmesh.GetAreaAt(ezVec2I32(0, 0)));
+    EZ_TEST_INT(areaPath.PeekBack(), navmesh.GetAreaAt(ezVec2I32(127, 127)));
+
+    ezRandom rnd;
+    rnd.Initialize(5);
+
+    for (ezUInt32 i = 0; i < 10; ++i)
+    {
+      const ezVec2I32 vStart(rnd.IntInRange(0, 128), rnd.IntInRange(0, 128));
+      const ezVec2I32 vTarget(rnd.IntInRange(0, 128), rnd.IntInRange(0, 128));
+
+      if (grid.GetCell(vStart) == 0 || grid.GetCell(vTarget) == 0)
+        continue;
+
+      const float fReferenceCost = FindReferencePathCost(grid, vStart, vTarget);
+
+      if (FindHierarchicalPath(grid, navmesh, vStart, vTarget, search, generator, path).Succeeded())
+      {
+        // the corridor may exclude the optimal path, but never produces a cheaper one
+        EZ_TEST_BOOL(path.PeekBack().m_pPathState->m_fCostToNode >= fReferenceCost);
+        EZ_TEST_BOOL(IsValidPath(grid, path));
+      }
+      else
+      {
+        EZ_TEST_BOOL(fReferenceCost == ezMath::Infinity<float>());
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    for (ezUInt16 uiSize : {64, 256, 1024, 2048})
+    {
+      CostGrid grid;
+      CreateGrid(grid, uiSize, 1);
+
+      const ezVec2I32 vStart(0, 0);
+      const ezVec2I32 vTarget(uiSize - 1, uiSize - 1);
+
+      GridStateGenerator generator(grid);
+      ezDeque<ezPathSearch<ezPathState>::PathResultData> path;
+
+      ezPathSearch<ezPathState> search;
+      search.SetPathStateGenerator(&generator);
+
+      ezStopwatch sw;
+
+      const bool bSparseFound = search.FindPath(0, ezPathState(), grid.GetNumCells() - 1, path).Succeeded();
+      const float fSparseCost = bSparseFound ? path.PeekBack().m_pPathState->m_fCostToNode : 0.0f;
+      const ezTime tSparse = sw.Checkpoint();
+
+      search.SetDenseNodeIndexRange(grid.GetNumCells());
+      sw.Checkpoint();
+
+      const bool bDenseFound = search.FindPath(0, ezPathState(), grid.GetNumCells() - 1, path).Succeeded();
+      const ezTime tDense = sw.Checkpoint();
+
+      EZ_TEST_BOOL(bSparseFound == bDenseFound);
+      if (bDenseFound)
+      {
+        EZ_TEST_FLOAT(path.PeekBack().m_pPathState->m_fCostToNode, fSparseCost, 0.0f);
+      }
+
+      ezGridNavmesh navmesh;
+      navmesh.CreateFromGrid(grid, IsSameCellType, &grid, IsCellBlocked, &grid);
+      const ezTime tNavmesh = sw.Checkpoint();
+
+      const bool bHierarchicalFound = FindHierarchicalPath(grid, navmesh, vStart, vTarget, search, generator, path).Succeeded();
+      const ezTime tHierarchical = sw.Checkpoint();
+
+      EZ_TEST_BOOL(bHierarchicalFound == bDenseFound);
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Path search on %ux%u grid: hash table %.2fms, dense %.2fms, hierarchical %.2fms (%u areas, built in %.2fms)", uiSize, uiSize,
+        tSparse.GetMilliseconds(), tDense.GetMilliseconds(), tHierarchical.GetMilliseconds(), navmesh.GetNumConvexAreas(), tNavmesh.GetMilliseconds());
+    }
+  }
+}
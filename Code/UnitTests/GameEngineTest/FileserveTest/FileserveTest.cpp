@@ -0,0 +1,347 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_ENET_SUPPORT
+
+#  include <FileservePlugin/Client/FileserveClient.h>
+#  include <FileservePlugin/Fileserver/Fileserver.h>
+#  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <Foundation/Threading/Thread.h>
+#  include <Foundation/Time/Stopwatch.h>
+
+namespace
+{
+  constexpr ezUInt16 s_uiFileservePort = 1050;
+
+  /// The client blocks while it waits for answers, so the server has to be updated on another thread.
+  class FileserverThread : public ezThread
+  {
+  public:
+    FileserverThread(ezFileserver& ref_server)
+      : ezThread("Fileserver")
+      , m_Server(ref_server)
+    {
+    }
+
+    ezAtomicBool m_bRun = true;
+
+    /// Stops answering the clients for a while, to simulate a server that is stuck.
+    void Pause()
+    {
+      m_bPause = true;
+
+      while (!m_bPaused)
+        ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+    }
+
+  private:
+    virtual ezUInt32 Run() override
+    {
+      while (m_bRun)
+      {
+        if (m_bPause)
+        {
+          m_bPaused = true;
+          ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(500));
+          m_bPause = false;
+          m_bPaused = false;
+        }
+
+        if (!m_Server.UpdateServer())
+          ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1));
+      }
+
+      return 0;
+    }
+
+    ezFileserver& m_Server;
+    ezAtomicBool m_bPause = false;
+    ezAtomicBool m_bPaused = false;
+  };
+
+  void WriteServerFile(ezStringView sServerFolder, ezStringView sFile, ezUInt32 uiVersion)
+  {
+    ezStringBuilder sPath(sServerFolder, "/", sFile);
+    ezStringBuilder sContent;
+    sContent.Format("Content of '{}' in version {}", sFile, uiVersion);
+
+    ezOSFile file;
+    EZ_TEST_BOOL(file.Open(sPath, ezFileOpenMode::Write).Succeeded());
+    EZ_TEST_BOOL(file.Write(sContent.GetData(), sContent.GetElementCount()).Succeeded());
+  }
+
+  void WriteServerFiles(ezStringView sServerFolder, ezUInt32 uiNumFiles, ezDynamicArray<ezString>& out_files)
+  {
+    out_files.Clear();
+
+    ezStringBuilder sFile;
+    for (ezUInt32 i = 0; i < uiNumFiles; ++i)
+    {
+      sFile.Format("Folder{}/File{}.txt", i % 16, i);
+      WriteServerFile(sServerFolder, sFile, 1);
+      out_files.PushBack(sFile);
+    }
+  }
+
+  bool ReadClientFile(ezStringView sFile, ezStringBuilder& out_sContent)
+  {
+    ezStringBuilder sPath(":fileservetest/", sFile);
+
+    ezFileReader file;
+    if (file.Open(sPath).Failed())
+      return false;
+
+    ezDynamicArray<ezUInt8> content;
+    content.SetCountUninitialized(static_cast<ezUInt32>(file.GetFileSize()));
+    file.ReadBytes(content.GetData(), content.GetCount());
+
+    out_sContent.Set(ezStringView(reinterpret_cast<const char*>(content.GetData()), content.GetCount()));
+    return true;
+  }
+
+  /// Simulates a new run of the application: The client starts without any knowledge about the data directory, except for what is cached on disk.
+  ezResult RemountDataDirectory(bool bClearCache)
+  {
+    ezFileSystem::RemoveDataDirectoryGroup("FileserveTest");
+    EZ_SUCCEED_OR_RETURN(ezFileSystem::AddDataDirectory(">fileservetest/", "FileserveTest", "fileservetest"));
+
+    ezDataDirectoryType* pDataDir = ezFileSystem::FindDataDirectoryWithRoot("fileservetest");
+
+    // make sure the files are served and not read directly from the folder
+    if (pDataDir == nullptr || pDataDir->GetRedirectedDataDirectoryPath() == pDataDir->GetDataDirectoryPath())
+      return EZ_FAILURE;
+
+    if (bClearCache)
+    {
+      EZ_SUCCEED_OR_RETURN(ezOSFile::DeleteFolder(pDataDir->GetRedirectedDataDirectoryPath()));
+    }
+
+    return EZ_SUCCESS;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Fileserve);
+
+EZ_CREATE_SIMPLE_TEST(Fileserve, Prefetch)
+{
+  if (ezFileserveClient::GetSingleton() != nullptr)
+  {
+    // the test framework itself runs through fileserve
+    return;
+  }
+
+  ezStringBuilder sServerFolder = ezTestFramework::GetInstance()->GetAbsOutputPath();
+  sServerFolder.AppendPath("FileserveTest");
+  sServerFolder.MakeCleanPath();
+
+  ezOSFile::DeleteFolder(sServerFolder).IgnoreResult();
+  ezFileSystem::SetSpecialDirectory("fileservetest", sServerFolder);
+
+  // the server reads the served files through absolute paths, just like the Fileserve application
+  if (!EZ_TEST_BOOL(ezFileSystem::AddDataDirectory("", "FileserveTestServer").Succeeded()))
+    return;
+
+  ezFileserver server;
+  server.SetPort(s_uiFileservePort);
+  server.StartServer();
+
+  ezAtomicInteger32 iNumRequests;
+  server.m_Events.AddEventHandler([&iNumRequests](const ezFileserverEvent& e) {
+    if (e.m_Type == ezFileserverEvent::Type::FileDownloadRequest)
+      iNumRequests.Increment();
+  });
+
+  FileserverThread serverThread(server);
+  serverThread.Start();
+
+  ezUniquePtr<ezFileserveClient> pClient = EZ_DEFAULT_NEW(ezFileserveClient);
+
+  {
+    ezStringBuilder sAddress;
+    sAddress.Format("localhost:{}", s_uiFileservePort);
+    pClient->AddServerAddressToTry(sAddress);
+  }
+
+  ezDynamicArray<ezString> files;
+  WriteServerFiles(sServerFolder, 300, files);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cold Prefetch")
+  {
+    if (EZ_TEST_BOOL(pClient->EnsureConnected(ezTime::MakeFromSeconds(10)).Succeeded()) && EZ_TEST_BOOL(RemountDataDirectory(true).Succeeded()))
+    {
+      ezDynamicArray<ezString> prefetch = files;
+      prefetch.PushBack("DoesNotExist.txt");
+      prefetch.PushBack(":unknownroot/Folder0/File0.txt");
+
+      ezFileserveClient::PrefetchResult res;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(prefetch, &res, 64, 2).Succeeded());
+
+      EZ_TEST_INT(res.m_uiNumFiles, 302);
+      EZ_TEST_INT(res.m_uiNumDownloaded, 300);
+      EZ_TEST_INT(res.m_uiNumUpToDate, 0);
+      EZ_TEST_INT(res.m_uiNumMissing, 2);
+      EZ_TEST_INT(res.m_uiNumRoundTrips, 5);
+      EZ_TEST_BOOL(res.m_uiNumBytesDownloaded > 0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Read Prefetched Files")
+  {
+    const ezInt32 iRequestsBefore = iNumRequests;
+
+    ezStringBuilder sContent, sExpected;
+    for (const ezString& sFile : files)
+    {
+      sExpected.Format("Content of '{}' in version {}", sFile, 1);
+
+      EZ_TEST_BOOL(ReadClientFile(sFile, sContent));
+      EZ_TEST_STRING(sContent, sExpected);
+    }
+
+    EZ_TEST_BOOL(!ezFileSystem::ExistsFile(":fileservetest/DoesNotExist.txt"));
+
+    // everything was validated by the prefetch, no further requests were necessary
+    EZ_TEST_INT(iNumRequests, iRequestsBefore);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Repeated Prefetch")
+  {
+    // all files were checked only recently
+    ezFileserveClient::PrefetchResult res;
+    EZ_TEST_BOOL(pClient->PrefetchFiles(files, &res).Succeeded());
+
+    EZ_TEST_INT(res.m_uiNumUpToDate, 300);
+    EZ_TEST_INT(res.m_uiNumRoundTrips, 0);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Warm Prefetch")
+  {
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      const ezInt32 iRequestsBefore = iNumRequests;
+
+      ezFileserveClient::PrefetchResult res;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &res, 64, 4).Succeeded());
+
+      EZ_TEST_INT(res.m_uiNumDownloaded, 0);
+      EZ_TEST_INT(res.m_uiNumUpToDate, 300);
+      EZ_TEST_INT(res.m_uiNumMissing, 0);
+      EZ_TEST_INT(res.m_uiNumRoundTrips, 5);
+      EZ_TEST_INT(res.m_uiNumBytesDownloaded, 0);
+      EZ_TEST_INT(iNumRequests - iRequestsBefore, 300);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Changed Files")
+  {
+    // file timestamps may only have a resolution of one second
+    ezThreadUtils::Sleep(ezTime::MakeFromMilliseconds(1100));
+
+    WriteServerFile(sServerFolder, files[3], 2);
+    WriteServerFile(sServerFolder, files[100], 2);
+    WriteServerFile(sServerFolder, files[299], 2);
+
+    ezStringBuilder sDeleted(sServerFolder, "/", files[42]);
+    EZ_TEST_BOOL(ezOSFile::DeleteFile(sDeleted).Succeeded());
+
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      ezFileserveClient::PrefetchResult res;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &res, 64, 4).Succeeded());
+
+      EZ_TEST_INT(res.m_uiNumDownloaded, 3);
+      EZ_TEST_INT(res.m_uiNumUpToDate, 296);
+      EZ_TEST_INT(res.m_uiNumMissing, 1);
+      EZ_TEST_INT(res.m_uiNumRoundTrips, 5);
+
+      ezStringBuilder sContent, sExpected;
+      sExpected.Format("Content of '{}' in version {}", files[100], 2);
+      EZ_TEST_BOOL(ReadClientFile(files[100], sContent));
+      EZ_TEST_STRING(sContent, sExpected);
+
+      sExpected.Format("Content of '{}' in version {}", files[101], 1);
+      EZ_TEST_BOOL(ReadClientFile(files[101], sContent));
+      EZ_TEST_STRING(sContent, sExpected);
+
+      EZ_TEST_BOOL(!ReadClientFile(files[42], sContent));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::DisabledNoWarning, "Benchmark")
+  {
+    WriteServerFiles(sServerFolder, 5000, files);
+
+    ezTime tCold, tWarm, tSingle;
+    ezFileserveClient::PrefetchResult cold, warm;
+
+    if (EZ_TEST_BOOL(RemountDataDirectory(true).Succeeded()))
+    {
+      ezStopwatch sw;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &cold).Succeeded());
+      tCold = sw.GetRunningTotal();
+    }
+
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      ezStopwatch sw;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &warm).Succeeded());
+      tWarm = sw.GetRunningTotal();
+    }
+
+    // the same warm sync without prefetching, every file is validated separately when it is accessed
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      ezStopwatch sw;
+      for (const ezString& sFile : files)
+      {
+        ezStringBuilder sPath(":fileservetest/", sFile);
+        EZ_TEST_BOOL(ezFileSystem::ExistsFile(sPath));
+      }
+      tSingle = sw.GetRunningTotal();
+    }
+
+    ezLog::Info("[test]Fileserve sync of {} files: cold prefetch: {}, {} round trips. Warm prefetch: {}, {} round trips. Warm, one file at a time: {}, {} round trips", files.GetCount(), tCold, cold.m_uiNumRoundTrips, tWarm, warm.m_uiNumRoundTrips, tSingle, files.GetCount());
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Server Timeout")
+  {
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      // the batches are not answered in time, so every file is requested one by one, once the server is back
+      serverThread.Pause();
+
+      ezFileserveClient::PrefetchResult res;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &res, 64, 4, ezTime::MakeFromMilliseconds(100)).Succeeded());
+
+      EZ_TEST_INT(res.m_uiNumSingleRequests, files.GetCount());
+      EZ_TEST_INT(res.m_uiNumDownloaded + res.m_uiNumUpToDate + res.m_uiNumMissing, files.GetCount());
+
+      ezStringBuilder sContent, sExpected;
+      sExpected.Format("Content of '{}' in version {}", files[7], 1);
+      EZ_TEST_BOOL(ReadClientFile(files[7], sContent));
+      EZ_TEST_STRING(sContent, sExpected);
+    }
+
+    if (EZ_TEST_BOOL(RemountDataDirectory(false).Succeeded()))
+    {
+      // the server is not asked to prefetch anything on this connection anymore
+      ezFileserveClient::PrefetchResult res;
+      EZ_TEST_BOOL(pClient->PrefetchFiles(files, &res, 64, 4, ezTime::MakeFromMilliseconds(100)).Succeeded());
+
+      EZ_TEST_INT(res.m_uiNumSingleRequests, files.GetCount());
+      EZ_TEST_INT(res.m_uiNumRoundTrips, files.GetCount());
+    }
+  }
+
+  ezFileSystem::RemoveDataDirectoryGroup("FileserveTest");
+  pClient.Clear();
+
+  serverThread.m_bRun = false;
+  serverThread.Join();
+  server.StopServer();
+
+  ezFileSystem::RemoveDataDirectoryGroup("FileserveTestServer");
+}
+
+#endif
@@ -0,0 +1,148 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#ifdef BUILDSYSTEM_ENABLE_KRAUT_SUPPORT
+
+#  include <Foundation/IO/FileSystem/DataDirTypeFolder.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/MemoryStream.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <KrautPlugin/Resources/KrautGeneratorResource.h>
+#  include <KrautPlugin/Resources/KrautTreeResource.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Kraut);
+
+namespace
+{
+  ezSharedPtr<ezKrautGeneratorResourceDescriptor> CreateGeneratorDesc()
+  {
+    ezSharedPtr<ezKrautGeneratorResourceDescriptor> pDesc = EZ_DEFAULT_NEW(ezKrautGeneratorResourceDescriptor);
+
+    // the spawn node defaults depend on the branch type, which is only set after the nodes were constructed
+    for (Kraut::SpawnNodeDesc& spawnNode : pDesc->m_TreeStructureDesc.m_BranchTypes)
+    {
+      spawnNode.Reset();
+    }
+
+    // a trunk with one level of branches, everything else uses the Kraut defaults
+    pDesc->m_TreeStructureDesc.m_BranchTypes[Kraut::BranchType::Trunk1].m_bUsed = true;
+
+    // the defaults don't have any random deviation, so the seed would have no effect
+    Kraut::SpawnNodeDesc& branches = pDesc->m_TreeStructureDesc.m_BranchTypes[Kraut::BranchType::MainBranches1];
+    branches.m_bUsed = true;
+    branches.m_uiMinBranches = 3;
+    branches.m_uiMaxBranches = 8;
+    branches.m_uiMinBranchLengthInCM = 50;
+    branches.m_uiMaxBranchLengthInCM = 150;
+    branches.m_fMaxRotationalDeviation = 30.0f;
+    branches.m_fMaxBranchAngleDeviation = 20.0f;
+
+    pDesc->m_LodDesc[0].m_Mode = Kraut::LodMode::Full;
+    pDesc->m_LodDesc[1].m_Mode = Kraut::LodMode::Disabled;
+
+    return pDesc;
+  }
+
+  void GenerateTree(const ezKrautGeneratorResourceDescriptor& generatorDesc, ezUInt32 uiRandomSeed, ezDefaultMemoryStreamStorage& out_storage)
+  {
+    ezKrautTreeResourceDescriptor treeDesc;
+    ezKrautGeneratorResource::GenerateTreeDescriptor(generatorDesc, treeDesc, uiRandomSeed);
+
+    EZ_TEST_BOOL(!treeDesc.m_Lods.IsEmpty());
+    EZ_TEST_BOOL(!treeDesc.m_Lods.IsEmpty() && !treeDesc.m_Lods[0].m_Triangles.IsEmpty());
+
+    out_storage.Clear();
+    ezMemoryStreamWriter writer(&out_storage);
+    treeDesc.Save(writer);
+  }
+
+  bool IsEqual(const ezDefaultMemoryStreamStorage& a, const ezDefaultMemoryStreamStorage& b)
+  {
+    if (a.GetStorageSize64() != b.GetStorageSize64())
+      return false;
+
+    ezMemoryStreamReader readerA(&a);
+    ezMemoryStreamReader readerB(&b);
+
+    ezUInt8 bufferA[1024];
+    ezUInt8 bufferB[1024];
+
+    while (true)
+    {
+      const ezUInt64 uiReadA = readerA.ReadBytes(bufferA, EZ_ARRAY_SIZE(bufferA));
+      const ezUInt64 uiReadB = readerB.ReadBytes(bufferB, EZ_ARRAY_SIZE(bufferB));
+
+      if (uiReadA != uiReadB || ezMemoryUtils::RawByteCompare(bufferA, bufferB, static_cast<size_t>(uiReadA)) != 0)
+        return false;
+
+      if (uiReadA == 0)
+        return true;
+    }
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Kraut, TreeGeneration)
+{
+  ezSharedPtr<ezKrautGeneratorResourceDescriptor> pGeneratorDesc = CreateGeneratorDesc();
+
+  ezDefaultMemoryStreamStorage tree42;
+  GenerateTree(*pGeneratorDesc, 42, tree42);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Determinism")
+  {
+    ezDefaultMemoryStreamStorage tree42Again;
+    GenerateTree(*pGeneratorDesc, 42, tree42Again);
+    EZ_TEST_BOOL(IsEqual(tree42, tree42Again));
+
+    ezDefaultMemoryStreamStorage tree43;
+    GenerateTree(*pGeneratorDesc, 43, tree43);
+    EZ_TEST_BOOL(!IsEqual(tree42, tree43));
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Cache Roundtrip")
+  {
+    ezFileSystem::RegisterDataDirectoryFactory(ezDataDirectory::FolderType::Factory);
+
+    ezStringBuilder sOutputDir = ezTestFramework::GetInstance()->GetAbsOutputPath();
+    sOutputDir.AppendPath("KrautTreeCache");
+    EZ_TEST_RESULT(ezOSFile::CreateDirectoryStructure(sOutputDir));
+    EZ_TEST_RESULT(ezFileSystem::AddDataDirectory(sOutputDir, "KrautTest", "krautcache", ezFileSystem::AllowWrites));
+
+    const char* szCacheFile = ":krautcache/generator-42.ezKrautTreeCache";
+    ezFileSystem::DeleteFile(szCacheFile);
+
+    ezDefaultMemoryStreamStorage cached;
+    EZ_TEST_BOOL(ezKrautGeneratorResource::ReadTreeFromCache(szCacheFile, cached).Failed());
+
+    EZ_TEST_RESULT(ezKrautGeneratorResource::WriteTreeToCache(szCacheFile, tree42));
+    EZ_TEST_RESULT(ezKrautGeneratorResource::ReadTreeFromCache(szCacheFile, cached));
+    EZ_TEST_BOOL(IsEqual(tree42, cached));
+
+    // the cached data must load into the same tree
+    {
+      ezMemoryStreamReader reader(&cached);
+      ezKrautTreeResourceDescriptor treeDesc;
+      EZ_TEST_RESULT(treeDesc.Load(reader));
+
+      ezDefaultMemoryStreamStorage resaved;
+      ezMemoryStreamWriter writer(&resaved);
+      treeDesc.Save(writer);
+      EZ_TEST_BOOL(IsEqual(tree42, resaved));
+    }
+
+    // no temporary files are left behind
+    {
+      ezUInt32 uiNumFiles = 0;
+      ezFileSystemIterator it;
+      for (it.StartSearch(sOutputDir, ezFileSystemIteratorFlags::ReportFiles); it.IsValid(); it.Next())
+      {
+        ++uiNumFiles;
+      }
+      EZ_TEST_INT(uiNumFiles, 1);
+    }
+
+    ezFileSystem::DeleteFile(szCacheFile);
+    ezFileSystem::RemoveDataDirectoryGroup("KrautTest");
+  }
+}
+
+#endif
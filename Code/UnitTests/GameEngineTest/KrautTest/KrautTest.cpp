@@ -5,10 +5,17 @@
 #  include "KrautTest.h"
 #  include <Core/WorldSerializer/WorldReader.h>
 #  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/IO/FileSystem/FileSystem.h>
+#  include <Foundation/IO/OSFile.h>
+#  include <KrautPlugin/Components/KrautTreeComponent.h>
+#  include <KrautPlugin/Resources/KrautTreeResource.h>
 #  include <ParticlePlugin/Components/ParticleComponent.h>
 
 static ezGameEngineTestKraut s_GameEngineTestAnimations;
 
+static constexpr ezUInt32 s_uiNumActivationTrees = 500;
+static constexpr ezUInt16 s_uiFirstActivationSeed = 1000;
+
 const char* ezGameEngineTestKraut::GetTestName() const
 {
   return "Kraut Tests";
@@ -23,6 +30,8 @@ ezGameEngineTestApplication* ezGameEngineTestKraut::CreateApplication()
 void ezGameEngineTestKraut::SetupSubTests()
 {
   AddSubTest("TreeRendering", SubTests::TreeRendering);
+  AddSubTest("TreeActivationCold", SubTests::TreeActivationCold);
+  AddSubTest("TreeActivationWarm", SubTests::TreeActivationWarm);
 }
 
 ezResult ezGameEngineTestKraut::InitializeSubTest(ezInt32 iIdentifier)
@@ -42,6 +51,24 @@ ezResult ezGameEngineTestKraut::InitializeSubTest(ezInt32 iIdentifier)
     return EZ_SUCCESS;
   }
 
+  if (iIdentifier == SubTests::TreeActivationCold || iIdentifier == SubTests::TreeActivationWarm)
+  {
+    // replaces the trees of the previous sub-test, so that they can be freed and have to be loaded again
+    EZ_SUCCEED_OR_RETURN(m_pOwnApplication->LoadScene("PlatformWin/AssetCache/Common/Kraut/Kraut.ezObjectGraph"));
+    ezResourceManager::FreeAllUnusedResources();
+
+    if (iIdentifier == SubTests::TreeActivationCold)
+    {
+      ezStringBuilder sCacheDir;
+      if (ezFileSystem::ResolvePath(":appdata/KrautTreeCache", &sCacheDir, nullptr).Succeeded())
+      {
+        ezOSFile::DeleteFolder(sCacheDir).IgnoreResult();
+      }
+    }
+
+    return SpawnTrees();
+  }
+
   return EZ_FAILURE;
 }
 
@@ -49,6 +76,30 @@ ezTestAppRun ezGameEngineTestKraut::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiI
 {
   ++m_iFrame;
 
+  if (iIdentifier == SubTests::TreeActivationCold || iIdentifier == SubTests::TreeActivationWarm)
+  {
+    ezStopwatch frameTimer;
+
+    if (m_pOwnApplication->Run() == ezApplication::Execution::Quit)
+      return ezTestAppRun::Quit;
+
+    m_LongestFrame = ezMath::Max(m_LongestFrame, frameTimer.GetRunningTotal());
+
+    if (AreAllTreesActivated())
+    {
+      ezLog::Info("[test]Activating {} Kraut trees ({} cache): {}, {} frames, longest frame {}", s_uiNumActivationTrees, iIdentifier == SubTests::TreeActivationCold ? "cold" : "warm", m_ActivationTimer.GetRunningTotal(), m_iFrame + 1, m_LongestFrame);
+      return ezTestAppRun::Quit;
+    }
+
+    if (m_ActivationTimer.GetRunningTotal() > ezTime::MakeFromMinutes(5))
+    {
+      EZ_TEST_FAILURE("Kraut trees were not activated in time", "");
+      return ezTestAppRun::Quit;
+    }
+
+    return ezTestAppRun::Continue;
+  }
+
   if (m_pOwnApplication->Run() == ezApplication::Execution::Quit)
     return ezTestAppRun::Quit;
 
@@ -66,4 +117,69 @@ ezTestAppRun ezGameEngineTestKraut::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiI
   return ezTestAppRun::Continue;
 }
 
+ezResult ezGameEngineTestKraut::SpawnTrees()
+{
+  ezWorld* pWorld = m_pOwnApplication->GetWorld();
+  EZ_LOCK(pWorld->GetWriteMarker());
+
+  ezKrautTreeComponentManager* pManager = pWorld->GetOrCreateComponentManager<ezKrautTreeComponentManager>();
+
+  // use the generator of the trees in the scene, every spawned tree gets its own seed
+  m_hGenerator.Invalidate();
+  for (auto it = pManager->GetComponents(); it.IsValid(); ++it)
+  {
+    if (it->GetKrautGeneratorResource().IsValid())
+    {
+      m_hGenerator = it->GetKrautGeneratorResource();
+      break;
+    }
+  }
+
+  if (!m_hGenerator.IsValid())
+    return EZ_FAILURE;
+
+  for (ezUInt32 i = 0; i < s_uiNumActivationTrees; ++i)
+  {
+    ezGameObjectDesc go;
+    go.m_LocalPosition.Set(10.0f + (i % 25) * 5.0f, (i / 25) * 5.0f - 50.0f, 0.0f);
+
+    ezGameObject* pObject;
+    pWorld->CreateObject(go, pObject);
+
+    ezKrautTreeComponent* pTree;
+    pManager->CreateComponent(pObject, pTree);
+
+    pTree->SetKrautGeneratorResource(m_hGenerator);
+    pTree->SetCustomRandomSeed(static_cast<ezUInt16>(s_uiFirstActivationSeed + i));
+  }
+
+  m_LongestFrame = ezTime::MakeZero();
+  m_ActivationTimer.StopAndReset();
+  m_ActivationTimer.Resume();
+
+  return EZ_SUCCESS;
+}
+
+bool ezGameEngineTestKraut::AreAllTreesActivated() const
+{
+  ezResourceLock<ezKrautGeneratorResource> pGenerator(m_hGenerator, ezResourceAcquireMode::PointerOnly);
+
+  if (pGenerator->GetLoadingState() != ezResourceState::Loaded)
+    return false;
+
+  // these are the same calls the components make, so they only return trees that were already generated
+  for (ezUInt32 i = 0; i < s_uiNumActivationTrees; ++i)
+  {
+    ezKrautTreeResourceHandle hTree = pGenerator->GenerateTree(s_uiFirstActivationSeed + i);
+    if (!hTree.IsValid())
+      return false;
+
+    ezResourceLock<ezKrautTreeResource> pTree(hTree, ezResourceAcquireMode::PointerOnly);
+    if (pTree->GetLoadingState() != ezResourceState::Loaded)
+      return false;
+  }
+
+  return true;
+}
+
 #endif
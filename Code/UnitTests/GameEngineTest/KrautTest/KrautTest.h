@@ -6,6 +6,9 @@
 
 #if EZ_ENABLED(EZ_PLATFORM_WINDOWS_DESKTOP)
 
+#  include <Foundation/Time/Stopwatch.h>
+#  include <KrautPlugin/Resources/KrautGeneratorResource.h>
+
 class ezGameEngineTestKraut : public ezGameEngineTest
 {
   using SUPER = ezGameEngineTest;
@@ -18,6 +21,8 @@ protected:
   enum SubTests
   {
     TreeRendering,
+    TreeActivationCold,
+    TreeActivationWarm,
   };
 
   virtual void SetupSubTests() override;
@@ -29,6 +34,13 @@ protected:
 
   ezUInt32 m_uiImgCompIdx = 0;
   ezHybridArray<ezUInt32, 8> m_ImgCompFrames;
+
+  ezResult SpawnTrees();
+  bool AreAllTreesActivated() const;
+
+  ezKrautGeneratorResourceHandle m_hGenerator;
+  ezStopwatch m_ActivationTimer;
+  ezTime m_LongestFrame;
 };
 
 #endif
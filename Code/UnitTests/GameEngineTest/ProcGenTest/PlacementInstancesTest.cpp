@@ -0,0 +1,186 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Core/Messages/SetColorMessage.h>
+#include <Core/World/World.h>
+#include <Foundation/Math/Random.h>
+#include <Foundation/SimdMath/SimdConversion.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <ProcGenPlugin/Components/Implementation/PlacementTile.h>
+#include <RendererCore/Meshes/MeshComponent.h>
+
+#include <RendererCore/../../../Data/Base/Shaders/Common/ObjectConstants.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(ProcGen);
+
+namespace
+{
+  constexpr ezUInt32 s_uiNumMeshes = 3;
+
+  void CreateTransforms(ezUInt32 uiCount, ezDynamicArray<ezProcGenInternal::PlacementTransform>& out_transforms)
+  {
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    out_transforms.SetCount(uiCount);
+
+    for (ezUInt32 i = 0; i < uiCount; ++i)
+    {
+      const ezVec3 vPos(rnd.FloatMinMax(-500.0f, 500.0f), rnd.FloatMinMax(-500.0f, 500.0f), rnd.FloatMinMax(-10.0f, 10.0f));
+      const ezVec3 vAxis = ezVec3::MakeRandomDirection(rnd);
+      const ezQuat qRot = ezQuat::MakeFromAxisAndAngle(vAxis, ezAngle::MakeFromDegree(rnd.FloatMinMax(0.0f, 360.0f)));
+
+      // every fourth object is scaled non-uniformly, which needs a different normal transform
+      ezVec3 vScale = ezVec3(rnd.FloatMinMax(0.5f, 2.0f));
+      if (i % 4 == 0)
+      {
+        vScale.z *= 1.5f;
+      }
+
+      auto& transform = out_transforms[i];
+      transform.m_Transform = ezSimdConversion::ToTransform(ezTransform(vPos, qRot, vScale));
+      transform.m_uiObjectIndex = static_cast<ezUInt8>(i % s_uiNumMeshes);
+      transform.m_bHasValidColor = (i % 2) == 0;
+      transform.m_ObjectColor = ezColor(rnd.FloatZeroToOneInclusive(), rnd.FloatZeroToOneInclusive(), rnd.FloatZeroToOneInclusive());
+      transform.m_uiPointIndex = static_cast<ezUInt16>(i);
+    }
+  }
+
+  struct InstanceBuffers
+  {
+    void Allocate(ezArrayPtr<const ezProcGenInternal::PlacementTransform> transforms)
+    {
+      ezUInt32 counts[s_uiNumMeshes] = {};
+      for (auto& transform : transforms)
+      {
+        ++counts[transform.m_uiObjectIndex];
+      }
+
+      for (ezUInt32 i = 0; i < s_uiNumMeshes; ++i)
+      {
+        m_Data[i].SetCountUninitialized(counts[i]);
+        m_Views[i] = m_Data[i];
+      }
+    }
+
+    ezDynamicArray<ezPerInstanceData> m_Data[s_uiNumMeshes];
+    ezArrayPtr<ezPerInstanceData> m_Views[s_uiNumMeshes];
+  };
+
+  ezVec3 TransformNormal(const ezMat4& mNormal, const ezVec3& vNormal)
+  {
+    return mNormal.TransformDirection(vNormal).GetNormalized();
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(ProcGen, PlacementInstances)
+{
+  const ezBoundingSphere meshBounds[s_uiNumMeshes] = {
+    ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(0), 1.0f),
+    ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(0, 0, 2), 2.5f),
+    ezBoundingSphere::MakeFromCenterAndRadius(ezVec3(1, -1, 0), 0.5f),
+  };
+
+  const ezUInt32 uiUniqueId = 1234;
+
+  ezDynamicArray<ezProcGenInternal::PlacementTransform> transforms;
+  CreateTransforms(100000, transforms);
+
+  InstanceBuffers instances;
+  instances.Allocate(transforms);
+
+  ezStopwatch sw;
+  const ezBoundingBox bounds = ezProcGenInternal::FillInstanceData(transforms, meshBounds, uiUniqueId, instances.m_Views);
+  const ezTime instanceTime = sw.GetRunningTotal();
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Compare to Placed Objects")
+  {
+    ezWorldDesc worldDesc("PlacementInstancesTest");
+    ezWorld world(worldDesc);
+    EZ_LOCK(world.GetWriteMarker());
+
+    ezMeshComponentManager* pMeshManager = world.GetOrCreateComponentManager<ezMeshComponentManager>();
+
+    // this is what PlacementTile::PlaceObjects() does for every placed object, minus the prefab overhead
+    ezDynamicArray<ezGameObject*> objects;
+    objects.SetCount(transforms.GetCount());
+
+    sw.StopAndReset();
+    sw.Resume();
+
+    for (ezUInt32 i = 0; i < transforms.GetCount(); ++i)
+    {
+      const auto& objectTransform = transforms[i];
+      const ezTransform transform = ezSimdConversion::ToTransform(objectTransform.m_Transform);
+
+      ezGameObjectDesc desc;
+      desc.m_LocalPosition = transform.m_vPosition;
+      desc.m_LocalRotation = transform.m_qRotation;
+      desc.m_LocalScaling = transform.m_vScale;
+
+      world.CreateObject(desc, objects[i]);
+
+      ezMeshComponent* pMeshComponent = nullptr;
+      pMeshManager->CreateComponent(objects[i], pMeshComponent);
+
+      if (objectTransform.m_bHasValidColor)
+      {
+        ezMsgSetColor msg;
+        msg.m_Color = objectTransform.m_ObjectColor.ToLinearFloat();
+        objects[i]->PostMessageRecursive(msg, ezTime::MakeZero(), ezObjectMsgQueueType::AfterInitialized);
+      }
+    }
+
+    // initializes the components and delivers the color messages
+    world.Update();
+
+    const ezTime objectTime = sw.GetRunningTotal();
+
+    ezLog::Info("[test]{} placements: instance data {}ms, game objects {}ms", transforms.GetCount(), ezArgF(instanceTime.GetMilliseconds(), 1), ezArgF(objectTime.GetMilliseconds(), 1));
+
+    ezUInt32 writePositions[s_uiNumMeshes] = {};
+    bool bAllEqual = true;
+
+    for (ezUInt32 i = 0; i < transforms.GetCount(); ++i)
+    {
+      const ezUInt32 uiMeshIndex = transforms[i].m_uiObjectIndex;
+      const ezPerInstanceData& instance = instances.m_Data[uiMeshIndex][writePositions[uiMeshIndex]++];
+
+      const ezGameObject* pObject = objects[i];
+      const ezMat4 mObjectToWorld = pObject->GetGlobalTransform().GetAsMat4();
+      const ezMeshComponent* pMeshComponent = nullptr;
+      pObject->TryGetComponentOfBaseType(pMeshComponent);
+
+      bAllEqual &= instance.ObjectToWorld.GetAsMat4().IsEqual(mObjectToWorld, 0.0001f);
+      bAllEqual &= instance.Color.IsEqualRGBA(pMeshComponent->GetColor(), 0.0001f);
+      bAllEqual &= instance.GameObjectID == uiUniqueId;
+
+      // the normals of the game objects are transformed with the inverse transpose in the shader
+      const ezMat4 mNormal = mObjectToWorld.GetInverse(0.0f).GetTranspose();
+      for (const ezVec3& vNormal : {ezVec3(1, 0, 0), ezVec3(0, 1, 0), ezVec3(0, 0, 1), ezVec3(1, 1, 1).GetNormalized()})
+      {
+        bAllEqual &= TransformNormal(instance.ObjectToWorldNormal.GetAsMat4(), vNormal).IsEqual(TransformNormal(mNormal, vNormal), 0.001f);
+      }
+
+      // the bounding sphere of the instance must cover the mesh, which the culling relies on
+      const ezBoundingSphere& meshSphere = meshBounds[uiMeshIndex];
+      const ezVec3 vCenter = mObjectToWorld.TransformPosition(meshSphere.m_vCenter);
+      const float fRadius = instance.BoundingSphereRadius;
+      bAllEqual &= fRadius >= meshSphere.m_fRadius * pObject->GetGlobalTransform().GetMaxScale() - 0.0001f;
+      bAllEqual &= bounds.Contains(ezBoundingBox::MakeFromCenterAndHalfExtents(vCenter, ezVec3(fRadius - 0.001f)));
+    }
+
+    EZ_TEST_BOOL(bAllEqual);
+
+    for (ezUInt32 i = 0; i < s_uiNumMeshes; ++i)
+    {
+      EZ_TEST_INT(writePositions[i], instances.m_Data[i].GetCount());
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Empty")
+  {
+    InstanceBuffers empty;
+    const ezBoundingBox emptyBounds = ezProcGenInternal::FillInstanceData({}, meshBounds, uiUniqueId, empty.m_Views);
+    EZ_TEST_BOOL(!emptyBounds.IsValid());
+  }
+}
@@ -1,6 +1,9 @@
 #include <GameEngineTest/GameEngineTestPCH.h>
 
 #include "StateMachineTest.h"
+#include <Foundation/Math/Random.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
 #include <GameEngine/StateMachine/StateMachineBuiltins.h>
 
 namespace
@@ -97,6 +100,118 @@ namespace
   ezUInt32 TestTransition::InstanceData::s_uiConstructionCounter = 0;
   ezUInt32 TestTransition::InstanceData::s_uiDestructionCounter = 0;
 
+  /// Forwards to another transition and counts how often the condition is checked, if a counter is given.
+  /// With bPoll it hides the dependencies of the inner transition and thus forces evaluation every frame.
+  class ForwardingTransition : public ezStateMachineTransition
+  {
+  public:
+    ForwardingTransition(ezUniquePtr<ezStateMachineTransition>&& pInner, bool bPoll, ezUInt32* pConditionCounter)
+      : m_pInner(std::move(pInner))
+      , m_bPoll(bPoll)
+      , m_pConditionCounter(pConditionCounter)
+    {
+    }
+
+    bool IsConditionMet(ezStateMachineInstance& ref_instance, void* pInstanceData) const override
+    {
+      if (m_pConditionCounter != nullptr)
+      {
+        ++(*m_pConditionCounter);
+      }
+
+      return m_pInner->IsConditionMet(ref_instance, pInstanceData);
+    }
+
+    bool GetInstanceDataDesc(ezInstanceDataDesc& out_desc) override { return m_pInner->GetInstanceDataDesc(out_desc); }
+
+    void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const override
+    {
+      if (m_bPoll)
+      {
+        ezStateMachineTransition::GetDependencies(inout_dependencies);
+      }
+      else
+      {
+        m_pInner->GetDependencies(inout_dependencies);
+      }
+    }
+
+    ezUniquePtr<ezStateMachineTransition> m_pInner;
+    bool m_bPoll = false;
+    ezUInt32* m_pConditionCounter = nullptr;
+  };
+
+  /// A state that only has enter and exit logic.
+  class PassiveState : public ezStateMachineState
+  {
+  public:
+    PassiveState(ezStringView sName)
+      : ezStateMachineState(sName)
+    {
+    }
+
+    virtual void OnEnter(ezStateMachineInstance& ref_instance, void* pInstanceData, const ezStateMachineState* pFromState) const override {}
+    virtual bool NeedsUpdate() const override { return false; }
+  };
+
+  static ezUniquePtr<ezStateMachineTransition> CreateBlackboardTransition(const ezHashedString& sEntryName, ezComparisonOperator::Enum op, double fValue)
+  {
+    ezUniquePtr<ezStateMachineTransition_BlackboardConditions> pTransition = ezGetStaticRTTI<ezStateMachineTransition_BlackboardConditions>()->GetAllocator()->Allocate<ezStateMachineTransition_BlackboardConditions>();
+    auto& cond = pTransition->m_Conditions.ExpandAndGetRef();
+    cond.m_sEntryName = sEntryName;
+    cond.m_fComparisonValue = fValue;
+    cond.m_Operator = op;
+    return pTransition;
+  }
+
+  static ezUniquePtr<ezStateMachineTransition> CreateTimeoutTransition(ezTime timeout)
+  {
+    ezUniquePtr<ezStateMachineTransition_Timeout> pTransition = ezGetStaticRTTI<ezStateMachineTransition_Timeout>()->GetAllocator()->Allocate<ezStateMachineTransition_Timeout>();
+    pTransition->m_Timeout = timeout;
+    return pTransition;
+  }
+
+  /// Idle -> Alert once the blackboard reports an alert, Alert -> Search after a timeout, Search -> Idle after a timeout if the alert is gone.
+  /// From any state -> Dead once the health drops to zero.
+  static ezSharedPtr<ezStateMachineDescription> CreateAgentDescription(bool bPoll, ezUInt32* pConditionCounter)
+  {
+    const ezHashedString sAlert = ezMakeHashedString("Alert");
+    const ezHashedString sHealth = ezMakeHashedString("Health");
+
+    ezSharedPtr<ezStateMachineDescription> pDesc = EZ_DEFAULT_NEW(ezStateMachineDescription);
+    pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "Idle"));
+    pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "Alert"));
+    pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "Search"));
+    pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "Dead"));
+
+    auto AddTransition = [&](ezUInt32 uiFrom, ezUInt32 uiTo, ezUniquePtr<ezStateMachineTransition>&& pInner)
+    {
+      pDesc->AddTransition(uiFrom, uiTo, EZ_DEFAULT_NEW(ForwardingTransition, std::move(pInner), bPoll, pConditionCounter));
+    };
+
+    AddTransition(0, 1, CreateBlackboardTransition(sAlert, ezComparisonOperator::Greater, 0));
+    AddTransition(1, 2, CreateTimeoutTransition(ezTime::MakeFromMilliseconds(55)));
+
+    {
+      auto pCompound = EZ_DEFAULT_NEW(ezStateMachineTransition_Compound);
+      pCompound->m_SubTransitions.PushBack(CreateTimeoutTransition(ezTime::MakeFromMilliseconds(30)).Release());
+      pCompound->m_SubTransitions.PushBack(CreateBlackboardTransition(sAlert, ezComparisonOperator::Equal, 0).Release());
+      AddTransition(2, 0, pCompound);
+    }
+
+    AddTransition(ezInvalidIndex, 3, CreateBlackboardTransition(sHealth, ezComparisonOperator::LessEqual, 0));
+
+    return pDesc;
+  }
+
+  static ezSharedPtr<ezBlackboard> CreateAgentBlackboard()
+  {
+    ezSharedPtr<ezBlackboard> pBlackboard = ezBlackboard::Create();
+    pBlackboard->RegisterEntry(ezMakeHashedString("Alert"), 0);
+    pBlackboard->RegisterEntry(ezMakeHashedString("Health"), 100);
+    return pBlackboard;
+  }
+
   static void ResetCounter()
   {
     TestState::InstanceData::s_uiConstructionCounter = 0;
@@ -380,4 +495,198 @@ void ezGameEngineTestStateMachine::RunBuiltinsTest()
 
     EZ_TEST_INT(TestState::InstanceData::s_uiDestructionCounter, 3);
   }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Event-driven Transitions")
+  {
+    const ezHashedString sAlert = ezMakeHashedString("Alert");
+    const ezHashedString sHealth = ezMakeHashedString("Health");
+
+    ezUInt32 uiPollCounter = 0;
+    ezUInt32 uiEventCounter = 0;
+
+    auto pPollDesc = CreateAgentDescription(true, &uiPollCounter);
+    auto pEventDesc = CreateAgentDescription(false, &uiEventCounter);
+
+    auto pPollBlackboard = CreateAgentBlackboard();
+    auto pEventBlackboard = CreateAgentBlackboard();
+
+    ezStateMachineInstance pollSm(fakeOwner, pPollDesc);
+    pollSm.SetBlackboard(pPollBlackboard);
+    EZ_TEST_BOOL(pollSm.SetState(0u).Succeeded());
+
+    ezStateMachineInstance eventSm(fakeOwner, pEventDesc);
+    eventSm.SetBlackboard(pEventBlackboard);
+    EZ_TEST_BOOL(eventSm.SetState(0u).Succeeded());
+
+    ezRandom rng;
+    rng.Initialize(42);
+
+    ezUInt32 uiNumStateChanges = 0;
+
+    for (ezUInt32 uiFrame = 0; uiFrame < 1000; ++uiFrame)
+    {
+      // a result that was evaluated before the blackboard changed must not be used
+      if (uiFrame % 3 == 0)
+      {
+        eventSm.EvaluateTransitions();
+      }
+
+      // change the blackboard every now and then, sometimes to the same value
+      if (rng.UIntInRange(8) == 0)
+      {
+        const ezInt32 iAlert = rng.IntInRange(0, 2);
+        EZ_TEST_BOOL(pPollBlackboard->SetEntryValue(sAlert, iAlert).Succeeded());
+        EZ_TEST_BOOL(pEventBlackboard->SetEntryValue(sAlert, iAlert).Succeeded());
+      }
+
+      if (uiFrame == 900)
+      {
+        EZ_TEST_BOOL(pPollBlackboard->SetEntryValue(sHealth, 0).Succeeded());
+        EZ_TEST_BOOL(pEventBlackboard->SetEntryValue(sHealth, 0).Succeeded());
+      }
+
+      // sometimes the transitions are evaluated up front, the way the component manager does it
+      if (uiFrame % 3 == 1)
+      {
+        eventSm.EvaluateTransitions();
+      }
+
+      const ezUInt32 uiPrevState = pollSm.GetCurrentStateIndex();
+
+      pollSm.Update(s_TimeStep);
+      eventSm.Update(s_TimeStep);
+
+      EZ_TEST_INT(eventSm.GetCurrentStateIndex(), pollSm.GetCurrentStateIndex());
+      EZ_TEST_FLOAT(eventSm.GetTimeInCurrentState().GetSeconds(), pollSm.GetTimeInCurrentState().GetSeconds(), 0.0);
+
+      if (uiPrevState != pollSm.GetCurrentStateIndex())
+      {
+        ++uiNumStateChanges;
+      }
+    }
+
+    EZ_TEST_INT(pollSm.GetCurrentStateIndex(), 3);
+    EZ_TEST_BOOL(uiNumStateChanges > 20);
+    EZ_TEST_BOOL(uiEventCounter < uiPollCounter / 2);
+
+    // a transition without declared dependencies is only evaluated when requested
+    {
+      bool bCondition = false;
+      ezUInt32 uiConditionCounter = 0;
+
+      class FlagTransition : public ezStateMachineTransition
+      {
+      public:
+        bool IsConditionMet(ezStateMachineInstance& ref_instance, void* pInstanceData) const override
+        {
+          ++(*m_pCounter);
+          return *m_pFlag;
+        }
+
+        void GetDependencies(ezStateMachineTransitionDependencies& inout_dependencies) const override {}
+
+        bool* m_pFlag = nullptr;
+        ezUInt32* m_pCounter = nullptr;
+      };
+
+      ezSharedPtr<ezStateMachineDescription> pDesc = EZ_DEFAULT_NEW(ezStateMachineDescription);
+      pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "A"));
+      pDesc->AddState(EZ_DEFAULT_NEW(PassiveState, "B"));
+
+      auto pTransition = EZ_DEFAULT_NEW(FlagTransition);
+      pTransition->m_pFlag = &bCondition;
+      pTransition->m_pCounter = &uiConditionCounter;
+      pDesc->AddTransition(0, 1, pTransition);
+
+      ezStateMachineInstance sm(fakeOwner, pDesc);
+      EZ_TEST_BOOL(sm.SetState(0u).Succeeded());
+
+      sm.Update(s_TimeStep);
+      sm.Update(s_TimeStep);
+      EZ_TEST_INT(uiConditionCounter, 1);
+
+      bCondition = true;
+      sm.Update(s_TimeStep);
+      EZ_TEST_INT(sm.GetCurrentStateIndex(), 0);
+
+      sm.RequestTransitionEvaluation();
+      sm.Update(s_TimeStep);
+      EZ_TEST_INT(uiConditionCounter, 2);
+      EZ_TEST_INT(sm.GetCurrentStateIndex(), 1);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumInstances = 10000;
+    constexpr ezUInt32 uiNumFrames = 100;
+
+    const ezHashedString sAlert = ezMakeHashedString("Alert");
+
+    ezUInt32 uiPollCounter = 0;
+    ezUInt32 uiEventCounter = 0;
+
+    auto pPollDesc = CreateAgentDescription(true, &uiPollCounter);
+    auto pEventDesc = CreateAgentDescription(false, &uiEventCounter);
+    auto pParallelDesc = CreateAgentDescription(false, nullptr);
+
+    auto RunFrames = [&](const ezSharedPtr<ezStateMachineDescription>& pDesc, bool bParallel) -> ezTime
+    {
+      auto pBlackboard = CreateAgentBlackboard();
+
+      ezDynamicArray<ezUniquePtr<ezStateMachineInstance>> instances;
+      instances.Reserve(uiNumInstances);
+      for (ezUInt32 i = 0; i < uiNumInstances; ++i)
+      {
+        auto& pInstance = instances.ExpandAndGetRef();
+        pInstance = EZ_DEFAULT_NEW(ezStateMachineInstance, fakeOwner, pDesc);
+        pInstance->SetBlackboard(pBlackboard);
+        pInstance->SetState(0u).IgnoreResult();
+      }
+
+      ezStopwatch sw;
+
+      for (ezUInt32 uiFrame = 0; uiFrame < uiNumFrames; ++uiFrame)
+      {
+        if (uiFrame % 25 == 0)
+        {
+          pBlackboard->SetEntryValue(sAlert, (uiFrame / 25) % 2).IgnoreResult();
+        }
+
+        if (bParallel)
+        {
+          ezTaskSystem::ParallelForIndexed(0, instances.GetCount(), [&](ezUInt32 uiStartIndex, ezUInt32 uiEndIndex)
+            {
+              for (ezUInt32 i = uiStartIndex; i < uiEndIndex; ++i)
+              {
+                instances[i]->EvaluateTransitions();
+              } });
+        }
+
+        for (auto& pInstance : instances)
+        {
+          pInstance->Update(s_TimeStep);
+        }
+      }
+
+      const ezTime t = sw.GetRunningTotal();
+
+      // all instances see the same blackboard and time, so they must all end up in the same state
+      for (auto& pInstance : instances)
+      {
+        EZ_TEST_INT(pInstance->GetCurrentStateIndex(), instances[0]->GetCurrentStateIndex());
+      }
+
+      return t;
+    };
+
+    const ezTime tPoll = RunFrames(pPollDesc, false);
+    const ezTime tEvent = RunFrames(pEventDesc, false);
+    const ezTime tEventParallel = RunFrames(pParallelDesc, true);
+
+    EZ_TEST_BOOL(uiEventCounter < uiPollCounter);
+
+    ezLog::Info("[test]{} instances, {} frames: polling {} ({} checks), event-driven {} ({} checks), event-driven parallel {}", uiNumInstances,
+      uiNumFrames, tPoll, uiPollCounter, tEvent, uiEventCounter, tEventParallel);
+  }
 }
@@ -0,0 +1,207 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <GameComponentsPlugin/Terrain/HeightfieldChunk.h>
+#include <RendererCore/Meshes/MeshResourceDescriptor.h>
+#include <Texture/Image/ImageUtils.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Terrain);
+
+namespace
+{
+  constexpr float s_fHeight = 40.0f;
+  const ezVec2 s_vHalfExtents(100.0f, 60.0f);
+
+  void CreateHeightmap(ezImage& out_image)
+  {
+    ezImageHeader header;
+    header.SetWidth(37);
+    header.SetHeight(29);
+    header.SetImageFormat(ezImageFormat::R32G32B32A32_FLOAT);
+    out_image.ResetAndAlloc(header);
+
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    ezColor* pPixels = out_image.GetPixelPointer<ezColor>();
+    for (ezUInt32 i = 0; i < header.GetWidth() * header.GetHeight(); ++i)
+    {
+      pPixels[i] = ezColor(static_cast<float>(rnd.DoubleZeroToOneInclusive()), 0, 0, 1);
+    }
+  }
+
+  /// \brief The vertex position that the previous single-mesh implementation computed for a heightfield with the given tesselation.
+  ezVec3 ComputeSingleMeshPosition(const ezImage& heightmap, ezVec2U32 vTesselation, ezUInt32 x, ezUInt32 y)
+  {
+    const ezVec3 vSize(s_vHalfExtents.x * 2, s_vHalfExtents.y * 2, s_fHeight);
+    const ezVec2 vToNDC = ezVec2(1.0f / vTesselation.x, 1.0f / vTesselation.y);
+    const ezVec3 vPosOffset(-s_vHalfExtents.x, -s_vHalfExtents.y, -s_fHeight);
+
+    const ezVec2 ndc = ezVec2((float)x, (float)y).CompMul(vToNDC);
+    const float fHeightScale = ezImageUtils::BilinearSample(heightmap.GetPixelPointer<ezColor>(), heightmap.GetWidth(), heightmap.GetHeight(), ezImageAddressMode::Clamp, ndc).r;
+
+    return vPosOffset + ezVec3(ndc.x, ndc.y, fHeightScale).CompMul(vSize);
+  }
+
+  /// \brief Sets up the chunk the same way ezHeightfieldComponent does for rendering.
+  ezHeightfieldChunkDesc MakeRenderChunkDesc(const ezHeightfieldLodLayout& layout, ezUInt32 uiLevel, ezUInt32 x, ezUInt32 y)
+  {
+    ezHeightfieldChunkDesc desc;
+    desc.m_vNumQuads = layout.m_vChunkQuads;
+    desc.m_vGridQuads = layout.m_vChunkQuads * (1u << uiLevel);
+    desc.m_vFirstQuad = ezVec2U32(x, y).CompMul(layout.m_vChunkQuads);
+    desc.m_fSkirtDepth = uiLevel > 0 ? 2.0f : 0.0f;
+    desc.m_vHalfExtents = s_vHalfExtents;
+    desc.m_fHeight = s_fHeight;
+    desc.m_vTexCoordOffset = ezVec2(0);
+    desc.m_vTexCoordScale = ezVec2(1);
+    return desc;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Terrain, HeightfieldChunks)
+{
+  ezImage heightmap;
+  CreateHeightmap(heightmap);
+
+  ezHeightfieldHeightData heightData;
+  heightData.CopyFrom(heightmap);
+
+  // divisible by the number of leaf chunks, so that the deepest level has exactly the same vertices as the single mesh had
+  const ezVec2U32 vTesselation(128, 64);
+  const ezHeightfieldLodLayout layout = ezHeightfieldChunkUtils::ComputeLodLayout(vTesselation, 32);
+  const ezUInt32 uiNumLeafChunks = 1u << (layout.m_uiNumLevels - 1);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "ComputeLodLayout")
+  {
+    EZ_TEST_INT(layout.m_uiNumLevels, 3);
+    EZ_TEST_INT(layout.m_vChunkQuads.x, 32);
+    EZ_TEST_INT(layout.m_vChunkQuads.y, 16);
+
+    const ezHeightfieldLodLayout small = ezHeightfieldChunkUtils::ComputeLodLayout(ezVec2U32(20, 10), 32);
+    EZ_TEST_INT(small.m_uiNumLevels, 1);
+    EZ_TEST_INT(small.m_vChunkQuads.x, 20);
+    EZ_TEST_INT(small.m_vChunkQuads.y, 10);
+
+    const ezHeightfieldLodLayout odd = ezHeightfieldChunkUtils::ComputeLodLayout(ezVec2U32(21, 9), 32);
+    EZ_TEST_INT(odd.m_uiNumLevels, 1);
+    EZ_TEST_INT(odd.m_vChunkQuads.x, 21);
+    EZ_TEST_INT(odd.m_vChunkQuads.y, 9);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Sample")
+  {
+    for (ezVec2 vUv : {ezVec2(0, 0), ezVec2(1, 1), ezVec2(0.3f, 0.7f), ezVec2(0.51f, 0.02f), ezVec2(-0.1f, 1.2f)})
+    {
+      const float fExpected = ezImageUtils::BilinearSample(heightmap.GetPixelPointer<ezColor>(), heightmap.GetWidth(), heightmap.GetHeight(), ezImageAddressMode::Clamp, vUv).r;
+      EZ_TEST_FLOAT(heightData.Sample(vUv), fExpected, 0.0001f);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Full detail collision chunks")
+  {
+    // the collision mesh uses the deepest level, so every vertex has to match the single mesh
+    ezHeightfieldChunkDesc chunkDesc = MakeRenderChunkDesc(layout, layout.m_uiNumLevels - 1, 0, 0);
+    chunkDesc.m_fSkirtDepth = 0.0f;
+
+    ezDynamicArray<ezVec3> positions;
+
+    for (ezUInt32 cy = 0; cy < uiNumLeafChunks; ++cy)
+    {
+      for (ezUInt32 cx = 0; cx < uiNumLeafChunks; ++cx)
+      {
+        chunkDesc.m_vFirstQuad = ezVec2U32(cx, cy).CompMul(layout.m_vChunkQuads);
+        ezHeightfieldChunkUtils::ComputeChunkPositions(chunkDesc, heightData, positions);
+
+        EZ_TEST_INT(positions.GetCount(), (layout.m_vChunkQuads.x + 1) * (layout.m_vChunkQuads.y + 1));
+
+        ezUInt32 uiVertexIdx = 0;
+        for (ezUInt32 y = 0; y <= layout.m_vChunkQuads.y; ++y)
+        {
+          for (ezUInt32 x = 0; x <= layout.m_vChunkQuads.x; ++x)
+          {
+            const ezVec3 vExpected = ComputeSingleMeshPosition(heightmap, vTesselation, chunkDesc.m_vFirstQuad.x + x, chunkDesc.m_vFirstQuad.y + y);
+            EZ_TEST_VEC3(positions[uiVertexIdx], vExpected, 0.001f);
+            ++uiVertexIdx;
+          }
+        }
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Full detail render chunks")
+  {
+    for (ezUInt32 cy = 0; cy < uiNumLeafChunks; ++cy)
+    {
+      for (ezUInt32 cx = 0; cx < uiNumLeafChunks; ++cx)
+      {
+        const ezHeightfieldChunkDesc chunkDesc = MakeRenderChunkDesc(layout, layout.m_uiNumLevels - 1, cx, cy);
+
+        ezMeshResourceDescriptor meshDesc;
+        ezUInt32 uiNumTriangles = 0;
+        ezHeightfieldChunkUtils::BuildChunkMesh(chunkDesc, heightData, meshDesc, uiNumTriangles);
+
+        auto& mb = meshDesc.MeshBufferDesc();
+        EZ_TEST_INT(mb.GetPrimitiveCount(), uiNumTriangles);
+
+        const ezUInt32 uiNumVerticesX = layout.m_vChunkQuads.x + 1;
+        const ezUInt32 uiNumVerticesY = layout.m_vChunkQuads.y + 1;
+        auto GetPos = [&](ezUInt32 x, ezUInt32 y) -> ezVec3 { return *reinterpret_cast<const ezVec3*>(mb.GetVertexData(0, y * uiNumVerticesX + x).GetPtr()); };
+
+        for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
+        {
+          for (ezUInt32 x = 0; x < uiNumVerticesX; ++x)
+          {
+            // the border is not modified either, so the seams between neighboring chunks have exactly the sampled heights
+            const ezVec3 vExpected = ComputeSingleMeshPosition(heightmap, vTesselation, chunkDesc.m_vFirstQuad.x + x, chunkDesc.m_vFirstQuad.y + y);
+            EZ_TEST_VEC3(GetPos(x, y), vExpected, 0.001f);
+          }
+        }
+
+        // seams with the next chunk use bit-identical positions on both sides
+        if (cx + 1 < uiNumLeafChunks)
+        {
+          ezMeshResourceDescriptor neighborDesc;
+          ezUInt32 uiNeighborTriangles = 0;
+          ezHeightfieldChunkUtils::BuildChunkMesh(MakeRenderChunkDesc(layout, layout.m_uiNumLevels - 1, cx + 1, cy), heightData, neighborDesc, uiNeighborTriangles);
+
+          for (ezUInt32 y = 0; y < uiNumVerticesY; ++y)
+          {
+            const ezVec3 vNeighborPos = *reinterpret_cast<const ezVec3*>(neighborDesc.MeshBufferDesc().GetVertexData(0, y * uiNumVerticesX).GetPtr());
+            EZ_TEST_BOOL(GetPos(uiNumVerticesX - 1, y) == vNeighborPos);
+          }
+        }
+
+        // the finest chunks may border coarser ones, so they need a skirt wherever they have a neighbor
+        const ezUInt32 uiNumSkirtVertices = 2 * (layout.m_vChunkQuads.x + layout.m_vChunkQuads.y);
+        EZ_TEST_INT(mb.GetVertexCount(), uiNumVerticesX * uiNumVerticesY + uiNumSkirtVertices);
+
+        // skirt vertices hang below the border, but never below the lowest possible height
+        for (ezUInt32 i = uiNumVerticesX * uiNumVerticesY; i < mb.GetVertexCount(); ++i)
+        {
+          const ezVec3 vPos = *reinterpret_cast<const ezVec3*>(mb.GetVertexData(0, i).GetPtr());
+          EZ_TEST_BOOL(vPos.z >= -s_fHeight);
+        }
+      }
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Root chunk")
+  {
+    // the root chunk is the single mesh with the chunk tesselation
+    const ezHeightfieldChunkDesc chunkDesc = MakeRenderChunkDesc(layout, 0, 0, 0);
+
+    ezDynamicArray<ezVec3> positions;
+    ezHeightfieldChunkUtils::ComputeChunkPositions(chunkDesc, heightData, positions);
+
+    ezUInt32 uiVertexIdx = 0;
+    for (ezUInt32 y = 0; y <= layout.m_vChunkQuads.y; ++y)
+    {
+      for (ezUInt32 x = 0; x <= layout.m_vChunkQuads.x; ++x)
+      {
+        EZ_TEST_VEC3(positions[uiVertexIdx], ComputeSingleMeshPosition(heightmap, layout.m_vChunkQuads, x, y), 0.001f);
+        ++uiVertexIdx;
+      }
+    }
+  }
+}
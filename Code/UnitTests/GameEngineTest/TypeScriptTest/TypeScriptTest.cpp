@@ -9,6 +9,7 @@
 #  include <Core/Scripting/DuktapeHelper.h>
 #  include <Core/WorldSerializer/WorldReader.h>
 #  include <Foundation/IO/FileSystem/FileReader.h>
+#  include <Foundation/Time/Stopwatch.h>
 #  include <TypeScriptPlugin/Components/TypeScriptComponent.h>
 
 static ezGameEngineTestTypeScript s_GameEngineTestTypeScript;
@@ -40,16 +41,28 @@ void ezGameEngineTestTypeScript::SetupSubTests()
   AddSubTest("Messaging", SubTests::Messaging);
   AddSubTest("World", SubTests::World);
   AddSubTest("Utils", SubTests::Utils);
+  AddSubTest("Benchmark", SubTests::Benchmark);
 }
 
 ezResult ezGameEngineTestTypeScript::InitializeSubTest(ezInt32 iIdentifier)
 {
+  if (iIdentifier == SubTests::Benchmark)
+  {
+    m_pOwnApplication->SubTestBenchmarkSetup();
+    return EZ_SUCCESS;
+  }
+
   m_pOwnApplication->SubTestBasicsSetup();
   return EZ_SUCCESS;
 }
 
 ezTestAppRun ezGameEngineTestTypeScript::RunSubTest(ezInt32 iIdentifier, ezUInt32 uiInvocationCount)
 {
+  if (iIdentifier == SubTests::Benchmark)
+  {
+    return m_pOwnApplication->SubTestBenchmarkExec(uiInvocationCount);
+  }
+
   return m_pOwnApplication->SubTestBasisExec(GetSubTestName(iIdentifier));
 }
 
@@ -114,4 +127,84 @@ ezTestAppRun ezGameEngineTestApplication_TypeScript::SubTestBasisExec(const char
   return ezTestAppRun::Quit;
 }
 
+void ezGameEngineTestApplication_TypeScript::SubTestBenchmarkSetup()
+{
+  SubTestBasicsSetup();
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  // Scripts/TestBenchmark.ezTypeScriptAsset
+  const ezUuid benchmarkScript(15080671082316587235ull, 4879259821866750563ull);
+
+  ezTypeScriptComponentManager* pMan = m_pWorld->GetOrCreateComponentManager<ezTypeScriptComponentManager>();
+
+  ezGameObjectDesc desc;
+  desc.m_bDynamic = true;
+  desc.m_sName.Assign("Benchmark");
+
+  for (ezUInt32 i = 0; i < 1000; ++i)
+  {
+    desc.m_LocalPosition.Set(static_cast<float>(i % 32), static_cast<float>(i / 32), 0.0f);
+
+    ezGameObject* pObject = nullptr;
+    const ezGameObjectHandle hObject = m_pWorld->CreateObject(desc, pObject);
+
+    ezTypeScriptComponent* pComponent = nullptr;
+    pMan->CreateComponent(pObject, pComponent);
+    pComponent->SetTypeScriptComponentGuid(benchmarkScript);
+
+    if (i == 0)
+    {
+      m_hBenchmarkObject = hObject;
+    }
+  }
+
+  m_BenchmarkTime = ezTime::MakeZero();
+}
+
+ezTestAppRun ezGameEngineTestApplication_TypeScript::SubTestBenchmarkExec(ezUInt32 uiInvocationCount)
+{
+  constexpr ezUInt32 uiWarmupFrames = 10;
+  constexpr ezUInt32 uiMeasuredFrames = 50;
+
+  ezStopwatch sw;
+
+  if (Run() == ezApplication::Execution::Quit)
+    return ezTestAppRun::Quit;
+
+  if (uiInvocationCount >= uiWarmupFrames)
+  {
+    m_BenchmarkTime += sw.GetRunningTotal();
+  }
+
+  if (uiInvocationCount + 1 < uiWarmupFrames + uiMeasuredFrames)
+    return ezTestAppRun::Continue;
+
+  EZ_LOCK(m_pWorld->GetWriteMarker());
+
+  ezGameObject* pObject = nullptr;
+  if (m_pWorld->TryGetObject(m_hBenchmarkObject, pObject) == false)
+  {
+    EZ_TEST_FAILURE("Failed to retrieve TypeScript Benchmark-Object", "");
+    return ezTestAppRun::Quit;
+  }
+
+  ezMsgGenericEvent msg;
+  msg.m_sMessage.Assign("GetTicks");
+  pObject->SendMessage(msg);
+  const ezInt32 iTicks = msg.m_Value.ConvertTo<ezInt32>();
+
+  msg.m_sMessage.Assign("GetReceived");
+  pObject->SendMessage(msg);
+  const ezInt32 iReceived = msg.m_Value.ConvertTo<ezInt32>();
+
+  // the components start ticking in the first frame
+  EZ_TEST_BOOL(iTicks >= static_cast<ezInt32>(uiMeasuredFrames));
+  EZ_TEST_INT(iReceived, iTicks * 4);
+
+  ezTestFramework::Output(ezTestOutput::Duration, "1000 ticked TypeScript components, 4 messages each: %.3fms per frame", (m_BenchmarkTime / uiMeasuredFrames).GetMilliseconds());
+
+  return ezTestAppRun::Quit;
+}
+
 #endif
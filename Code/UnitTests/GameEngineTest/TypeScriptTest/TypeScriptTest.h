@@ -11,6 +11,13 @@ public:
 
   void SubTestBasicsSetup();
   ezTestAppRun SubTestBasisExec(const char* szSubTestName);
+
+  void SubTestBenchmarkSetup();
+  ezTestAppRun SubTestBenchmarkExec(ezUInt32 uiInvocationCount);
+
+private:
+  ezGameObjectHandle m_hBenchmarkObject;
+  ezTime m_BenchmarkTime;
 };
 
 class ezGameEngineTestTypeScript : public ezGameEngineTest
@@ -37,6 +44,7 @@ public:
     Messaging,
     World,
     Utils,
+    Benchmark,
   };
 
 private:
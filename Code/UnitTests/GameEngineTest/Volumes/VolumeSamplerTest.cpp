@@ -0,0 +1,192 @@
+#include <GameEngineTest/GameEngineTestPCH.h>
+
+#include <Core/World/World.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <GameEngine/Volumes/VolumeComponent.h>
+#include <GameEngine/Volumes/VolumeSampler.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Volumes);
+
+namespace VolumeSamplerTestDetail
+{
+  static void CreateVolumes(ezWorld& ref_world, ezUInt32 uiNumVolumes)
+  {
+    auto& rng = ref_world.GetRandomNumberGenerator();
+
+    for (ezUInt32 i = 0; i < uiNumVolumes; ++i)
+    {
+      ezGameObjectDesc desc;
+      desc.m_LocalPosition = ezVec3((float)rng.DoubleMinMax(-20.0, 20.0), (float)rng.DoubleMinMax(-20.0, 20.0), (float)rng.DoubleMinMax(-5.0, 5.0));
+      desc.m_LocalRotation = ezQuat::MakeFromAxisAndAngle(ezVec3::MakeAxisZ(), ezAngle::MakeFromDegree((float)rng.DoubleMinMax(0.0, 360.0)));
+      desc.m_LocalScaling = ezVec3((float)rng.DoubleMinMax(0.5, 2.0));
+
+      ezGameObject* pObject = nullptr;
+      ref_world.CreateObject(desc, pObject);
+
+      ezVolumeComponent* pVolume = nullptr;
+      if (i % 2 == 0)
+      {
+        ezVolumeSphereComponent* pSphere = nullptr;
+        ezVolumeSphereComponent::CreateComponent(pObject, pSphere);
+        pSphere->SetRadius((float)rng.DoubleMinMax(2.0, 8.0));
+        pSphere->SetFalloff((float)rng.DoubleMinMax(0.1, 1.0));
+        pVolume = pSphere;
+      }
+      else
+      {
+        ezVolumeBoxComponent* pBox = nullptr;
+        ezVolumeBoxComponent::CreateComponent(pObject, pBox);
+        pBox->SetExtents(ezVec3((float)rng.DoubleMinMax(2.0, 10.0), (float)rng.DoubleMinMax(2.0, 10.0), (float)rng.DoubleMinMax(2.0, 10.0)));
+        pBox->SetFalloff(ezVec3((float)rng.DoubleMinMax(0.1, 1.0)));
+        pVolume = pBox;
+      }
+
+      pVolume->SetVolumeType("GenericVolume");
+      pVolume->SetSortOrder(i * 0.25f - 16.0f);
+
+      // not every volume sets every value
+      if (i % 3 != 0)
+        pVolume->SetValue(ezMakeHashedString("Fog"), (float)rng.DoubleMinMax(0.0, 1.0));
+      if (i % 3 != 1)
+        pVolume->SetValue(ezMakeHashedString("Wind"), ezVec3((float)rng.DoubleMinMax(-1.0, 1.0), (float)rng.DoubleMinMax(-1.0, 1.0), 0.0f));
+      if (i % 3 != 2)
+        pVolume->SetValue(ezMakeHashedString("Tint"), ezColor((float)rng.DoubleMinMax(0.0, 1.0), (float)rng.DoubleMinMax(0.0, 1.0), (float)rng.DoubleMinMax(0.0, 1.0)));
+    }
+
+    ref_world.Update();
+  }
+
+  static void CreatePositions(ezWorld& ref_world, ezUInt32 uiNumPositions, ezDynamicArray<ezVec3>& out_positions)
+  {
+    auto& rng = ref_world.GetRandomNumberGenerator();
+
+    out_positions.SetCountUninitialized(uiNumPositions);
+    for (ezVec3& vPos : out_positions)
+    {
+      vPos = ezVec3((float)rng.DoubleMinMax(-25.0, 25.0), (float)rng.DoubleMinMax(-25.0, 25.0), (float)rng.DoubleMinMax(-6.0, 6.0));
+    }
+  }
+
+  static void RegisterValues(ezVolumeSampler& ref_sampler)
+  {
+    ref_sampler.RegisterValue(ezMakeHashedString("Fog"), 0.5f);
+    ref_sampler.RegisterValue(ezMakeHashedString("Wind"), ezVec3(0, 0, 1));
+    ref_sampler.RegisterValue(ezMakeHashedString("Tint"), ezColor::White);
+  }
+} // namespace VolumeSamplerTestDetail
+
+EZ_CREATE_SIMPLE_TEST(Volumes, VolumeSampler)
+{
+  using namespace VolumeSamplerTestDetail;
+
+  ezWorldDesc worldDesc("VolumeSamplerTest");
+  worldDesc.m_uiRandomNumberGeneratorSeed = 7;
+
+  ezWorld world(worldDesc);
+  EZ_LOCK(world.GetWriteMarker());
+
+  CreateVolumes(world, 64);
+
+  const ezSpatialData::Category category = ezSpatialData::RegisterCategory("GenericVolume", ezSpatialData::Flags::None);
+
+  ezVolumeSampler sampler;
+  RegisterValues(sampler);
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "SampleAtPositions matches SampleAtPosition")
+  {
+    ezDynamicArray<ezVec3> positions;
+    CreatePositions(world, 2000, positions);
+
+    ezDynamicArray<float> fog;
+    ezDynamicArray<ezVec3> wind;
+    ezDynamicArray<ezColor> tint;
+    fog.SetCountUninitialized(positions.GetCount());
+    wind.SetCountUninitialized(positions.GetCount());
+    tint.SetCountUninitialized(positions.GetCount());
+
+    ezVolumeSampler::BatchValue values[3];
+    values[0].m_sName = ezTempHashedString("Fog");
+    values[0].m_FloatResults = fog;
+    values[1].m_sName = ezTempHashedString("Wind");
+    values[1].m_Vec3Results = wind;
+    values[2].m_sName = ezTempHashedString("Tint");
+    values[2].m_ColorResults = tint;
+
+    sampler.SampleAtPositions(world, category, positions, values);
+
+    ezUInt32 uiNumInsideVolumes = 0;
+    for (ezUInt32 i = 0; i < positions.GetCount(); ++i)
+    {
+      sampler.SampleAtPosition(world, category, positions[i], ezTime::MakeZero());
+
+      const float fFog = sampler.GetValue("Fog").Get<float>();
+      EZ_TEST_FLOAT(fog[i], fFog, 0.0001f);
+      EZ_TEST_VEC3(wind[i], sampler.GetValue("Wind").Get<ezVec3>(), 0.0001f);
+      EZ_TEST_BOOL(tint[i].IsEqualRGBA(sampler.GetValue("Tint").Get<ezColor>(), 0.0001f));
+
+      if (fFog != 0.5f)
+      {
+        ++uiNumInsideVolumes;
+      }
+    }
+
+    // make sure the test actually covers blending
+    EZ_TEST_BOOL(uiNumInsideVolumes > positions.GetCount() / 10);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Unregistered values and empty input")
+  {
+    ezVec3 vPos = ezVec3(100, 100, 100);
+    float fResult = -1.0f;
+
+    ezVolumeSampler::BatchValue value;
+    value.m_sName = ezTempHashedString("Unknown");
+    value.m_FloatResults = ezMakeArrayPtr(&fResult, 1);
+
+    sampler.SampleAtPositions(world, category, ezMakeArrayPtr(&vPos, 1), ezMakeArrayPtr(&value, 1));
+    EZ_TEST_FLOAT(fResult, 0.0f, 0.0f);
+
+    fResult = -1.0f;
+    sampler.SampleAtPositions(world, category, ezArrayPtr<const ezVec3>(), ezMakeArrayPtr(&value, 1));
+    EZ_TEST_FLOAT(fResult, -1.0f, 0.0f);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    for (ezUInt32 uiNumPositions : {1, 10, 100, 1000, 10000})
+    {
+      ezDynamicArray<ezVec3> positions;
+      CreatePositions(world, uiNumPositions, positions);
+
+      ezDynamicArray<float> fog;
+      ezDynamicArray<ezVec3> wind;
+      fog.SetCountUninitialized(uiNumPositions);
+      wind.SetCountUninitialized(uiNumPositions);
+
+      ezVolumeSampler::BatchValue values[2];
+      values[0].m_sName = ezTempHashedString("Fog");
+      values[0].m_FloatResults = fog;
+      values[1].m_sName = ezTempHashedString("Wind");
+      values[1].m_Vec3Results = wind;
+
+      ezTime tSingle, tBatch;
+
+      {
+        ezStopwatch sw;
+        for (const ezVec3& vPos : positions)
+        {
+          sampler.SampleAtPosition(world, category, vPos, ezTime::MakeZero());
+        }
+        tSingle = sw.GetRunningTotal();
+      }
+
+      {
+        ezStopwatch sw;
+        sampler.SampleAtPositions(world, category, positions, values);
+        tBatch = sw.GetRunningTotal();
+      }
+
+      ezLog::Info("[test]{} positions: SampleAtPosition {}, SampleAtPositions {}", uiNumPositions, tSingle, tBatch);
+    }
+  }
+}
@@ -0,0 +1,161 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Configuration/CVar.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Debug/DebugRenderer.h>
+#include <RendererCore/RenderWorld/RenderWorld.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Debug);
+
+namespace
+{
+  static void DrawDebugShapes(const ezDebugRendererContext& context, ezUInt32 uiStart, ezUInt32 uiEnd)
+  {
+    ezDebugRenderer::Line lines[8];
+    ezDebugRenderer::Triangle triangles[4];
+
+    for (ezUInt32 i = uiStart; i < uiEnd; ++i)
+    {
+      const ezVec3 vPos((float)(i % 64), (float)(i / 64), 0.0f);
+      const ezTransform transform(vPos);
+
+      for (ezUInt32 l = 0; l < EZ_ARRAY_SIZE(lines); ++l)
+      {
+        lines[l] = ezDebugRenderer::Line(vPos, vPos + ezVec3((float)l, 1.0f, 0.0f));
+      }
+
+      for (ezUInt32 t = 0; t < EZ_ARRAY_SIZE(triangles); ++t)
+      {
+        triangles[t] = ezDebugRenderer::Triangle(vPos, vPos + ezVec3(1, 0, 0), vPos + ezVec3(0, (float)t, 1));
+      }
+
+      ezDebugRenderer::DrawLines(context, lines, ezColor::Red);
+      ezDebugRenderer::DrawSolidTriangles(context, triangles, ezColor::Green);
+      ezDebugRenderer::DrawLineBox(context, ezBoundingBox::MakeFromMinMax(ezVec3(-1), ezVec3(1)), ezColor::Blue, transform);
+      ezDebugRenderer::DrawCross(context, vPos, 1.0f, ezColor::Yellow);
+
+      if (i % 8 == 0)
+      {
+        ezDebugRenderer::DrawLineSphere(context, ezBoundingSphere::MakeFromCenterAndRadius(ezVec3::MakeZero(), 1.0f), ezColor::White, transform);
+      }
+    }
+  }
+
+  struct RenderedFrameStats
+  {
+    ezDebugRenderer::RenderDataStats m_AtBeginRender;
+    ezDebugRenderer::RenderDataStats m_AtEndRender;
+  };
+
+  /// \brief Finishes the current frame and renders it without any views, i.e. only the debug renderer merges and clears its data.
+  static RenderedFrameStats RenderFrame(const ezDebugRendererContext& context)
+  {
+    RenderedFrameStats stats;
+
+    // the debug renderer registers its handler at core startup, so this one is called after the data was merged or cleared
+    ezEventSubscriptionID subscriptionID = ezRenderWorld::GetRenderEvent().AddEventHandler([&](const ezRenderWorldRenderEvent& e)
+      {
+        if (e.m_Type == ezRenderWorldRenderEvent::Type::BeginRender)
+          stats.m_AtBeginRender = ezDebugRenderer::GetRenderDataStats(context);
+        else if (e.m_Type == ezRenderWorldRenderEvent::Type::EndRender)
+          stats.m_AtEndRender = ezDebugRenderer::GetRenderDataStats(context); });
+
+    // the data that was extracted in a frame is rendered after the frame counter was incremented
+    ezRenderWorld::EndFrame();
+    ezRenderWorld::Render(nullptr);
+
+    ezRenderWorld::GetRenderEvent().RemoveEventHandler(subscriptionID);
+
+    return stats;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Debug, DebugRenderer)
+{
+  ezCVarBool* pThreadLocalRecording = static_cast<ezCVarBool*>(ezCVar::FindCVarByName("Debug.DebugRenderer.ThreadLocalRecording"));
+  if (!EZ_TEST_BOOL(pThreadLocalRecording != nullptr))
+    return;
+
+  const bool bOriginalValue = *pThreadLocalRecording;
+
+  // a context that is never rendered, so the recorded geometry doesn't show up anywhere
+  const ezDebugRendererContext context;
+
+  constexpr ezUInt32 uiNumItems = 4096;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Multithreaded stress test")
+  {
+    // the shapes repeat every 8 items, so one set of 8 items is the reference for everything that is drawn below
+    constexpr ezUInt32 uiNumItemsPerSet = 8;
+
+    // discard anything that was recorded before
+    RenderFrame(context);
+
+    *pThreadLocalRecording = true;
+    DrawDebugShapes(context, 0, uiNumItemsPerSet);
+    const ezDebugRenderer::RenderDataStats reference = RenderFrame(context).m_AtBeginRender;
+
+    EZ_TEST_INT(reference.m_uiNumTriangles, uiNumItemsPerSet * 4);
+    EZ_TEST_INT(reference.m_uiNumLineBoxes, uiNumItemsPerSet);
+    EZ_TEST_BOOL(reference.m_uiNumLines > uiNumItemsPerSet * 11);
+
+    for (bool bThreadLocal : {true, false})
+    {
+      *pThreadLocalRecording = bThreadLocal;
+
+      ezParallelForParams params;
+      params.m_uiBinSize = 16;
+      params.m_uiMaxTasksPerThread = 4;
+
+      ezTaskSystem::ParallelForIndexed(0u, uiNumItems, [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+        { DrawDebugShapes(context, uiStart, uiEnd); },
+        "DebugRendererStressTest", params);
+
+      const ezUInt32 uiNumSets = uiNumItems / uiNumItemsPerSet;
+
+      const RenderedFrameStats stats = RenderFrame(context);
+      EZ_TEST_INT(stats.m_AtBeginRender.m_uiNumLines, reference.m_uiNumLines * uiNumSets);
+      EZ_TEST_INT(stats.m_AtBeginRender.m_uiNumTriangles, reference.m_uiNumTriangles * uiNumSets);
+      EZ_TEST_INT(stats.m_AtBeginRender.m_uiNumLineBoxes, reference.m_uiNumLineBoxes * uiNumSets);
+      EZ_TEST_INT(stats.m_AtBeginRender.m_uiNumSolidBoxes, 0);
+
+      EZ_TEST_INT(stats.m_AtEndRender.m_uiNumLines, 0);
+      EZ_TEST_INT(stats.m_AtEndRender.m_uiNumTriangles, 0);
+      EZ_TEST_INT(stats.m_AtEndRender.m_uiNumLineBoxes, 0);
+
+      // nothing leaks into the next frame
+      const RenderedFrameStats nextFrame = RenderFrame(context);
+      EZ_TEST_INT(nextFrame.m_AtBeginRender.m_uiNumLines, 0);
+      EZ_TEST_INT(nextFrame.m_AtBeginRender.m_uiNumTriangles, 0);
+      EZ_TEST_INT(nextFrame.m_AtBeginRender.m_uiNumLineBoxes, 0);
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumIterations = 3;
+
+    ezTime tDuration[2];
+
+    for (ezUInt32 uiMode = 0; uiMode < 2; ++uiMode)
+    {
+      *pThreadLocalRecording = (uiMode == 0);
+
+      ezStopwatch sw;
+
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        ezTaskSystem::ParallelForIndexed(0u, uiNumItems, [&](ezUInt32 uiStart, ezUInt32 uiEnd)
+          { DrawDebugShapes(context, uiStart, uiEnd); },
+          "DebugRendererBenchmark");
+      }
+
+      tDuration[uiMode] = sw.GetRunningTotal() / uiNumIterations;
+    }
+
+    ezTestFramework::Output(ezTestOutput::Duration, "Drawing %u debug shape sets from worker threads: thread local %.2fms, global mutex %.2fms", uiNumItems, tDuration[0].GetMilliseconds(), tDuration[1].GetMilliseconds());
+  }
+
+  *pThreadLocalRecording = bOriginalValue;
+}
@@ -0,0 +1,205 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <Foundation/Threading/TaskSystem.h>
+#include <Foundation/Time/Stopwatch.h>
+#include <RendererCore/Lights/Implementation/ClusteredDataUtils.h>
+
+EZ_CREATE_SIMPLE_TEST_GROUP(Lights);
+
+namespace
+{
+  enum
+  {
+    MAX_TEST_ITEMS = 4096
+  };
+
+  struct TestCluster
+  {
+    EZ_DECLARE_POD_TYPE();
+
+    ezUInt32 m_BitMask[MAX_TEST_ITEMS / 32];
+  };
+
+  struct TestItem
+  {
+    ezClusteredDataShape::Type m_Type;
+    ezSimdBSphere m_Sphere;
+    BoundingCone m_Cone;
+    ezTransform m_Transform;
+  };
+
+  struct ClusterTestSetup
+  {
+    ClusterTestSetup()
+    {
+      m_Camera.SetCameraMode(ezCameraMode::PerspectiveFixedFovY, 70.0f, 0.1f, 1000.0f);
+      m_Camera.LookAt(ezVec3(0, 0, 2), ezVec3(100, 20, 0), ezVec3(0, 0, 1));
+
+      const float fAspectRatio = 16.0f / 9.0f;
+
+      m_ClusterBoundingSpheres.SetCountUninitialized(NUM_CLUSTERS);
+      m_ClusterBoundingSphereGroups.SetCountUninitialized(NUM_CLUSTERS / 4);
+      FillClusterBoundingSpheres(m_Camera, fAspectRatio, m_ClusterBoundingSpheres);
+      FillClusterBoundingSphereGroups(m_ClusterBoundingSpheres, m_ClusterBoundingSphereGroups);
+
+      ezMat4 tmp = m_Camera.GetViewMatrix();
+      m_ViewMatrix = ezSimdConversion::ToMat4(tmp);
+
+      m_Camera.GetProjectionMatrix(fAspectRatio, tmp);
+      m_ProjectionMatrix = ezSimdConversion::ToMat4(tmp);
+
+      m_ViewProjectionMatrix = m_ProjectionMatrix * m_ViewMatrix;
+    }
+
+    void CreateItems(ezUInt32 uiNumItems)
+    {
+      ezRandom rnd;
+      rnd.Initialize(42);
+
+      m_Items.Clear();
+      m_Shapes.Clear();
+
+      for (ezUInt32 i = 0; i < uiNumItems; ++i)
+      {
+        const ezVec3 vPosition(rnd.FloatMinMax(-50.0f, 300.0f), rnd.FloatMinMax(-150.0f, 150.0f), rnd.FloatMinMax(-20.0f, 40.0f));
+        const ezQuat qRotation = ezQuat::MakeFromAxisAndAngle(ezVec3(rnd.FloatMinMax(-1.0f, 1.0f), rnd.FloatMinMax(-1.0f, 1.0f), 1.0f).GetNormalized(), ezAngle::MakeFromDegree(rnd.FloatMinMax(0.0f, 360.0f)));
+
+        TestItem& item = m_Items.ExpandAndGetRef();
+
+        const ezUInt32 uiType = rnd.UIntInRange(100);
+        if (uiType < 45)
+        {
+          item.m_Type = ezClusteredDataShape::Sphere;
+          item.m_Sphere = ezSimdBSphere(ezSimdConversion::ToVec3(vPosition), rnd.FloatMinMax(0.5f, 20.0f));
+          m_Shapes.PushBack(MakeSphereShape(item.m_Sphere, i, m_ViewMatrix, m_ProjectionMatrix));
+        }
+        else if (uiType < 80)
+        {
+          const ezAngle halfAngle = ezAngle::MakeFromDegree(rnd.FloatMinMax(5.0f, 80.0f));
+
+          item.m_Type = ezClusteredDataShape::SpotLight;
+          item.m_Cone.m_PositionAndRange = ezSimdConversion::ToVec3(vPosition);
+          item.m_Cone.m_PositionAndRange.SetW(rnd.FloatMinMax(1.0f, 30.0f));
+          item.m_Cone.m_ForwardDir = ezSimdConversion::ToVec3(qRotation * ezVec3(1.0f, 0.0f, 0.0f));
+          item.m_Cone.m_SinCosAngle = ezSimdVec4f(ezMath::Sin(halfAngle), ezMath::Cos(halfAngle), 0.0f);
+          m_Shapes.PushBack(MakeSpotLightShape(item.m_Cone, i, m_ViewMatrix, m_ProjectionMatrix));
+        }
+        else if (uiType < 99)
+        {
+          item.m_Type = ezClusteredDataShape::Box;
+          item.m_Transform = ezTransform(vPosition, qRotation, ezVec3(rnd.FloatMinMax(0.5f, 10.0f), rnd.FloatMinMax(0.5f, 10.0f), rnd.FloatMinMax(0.5f, 10.0f)));
+          m_Shapes.PushBack(MakeBoxShape(item.m_Transform, i, m_ViewProjectionMatrix));
+        }
+        else
+        {
+          item.m_Type = ezClusteredDataShape::All;
+          m_Shapes.PushBack(MakeAllShape(i));
+        }
+      }
+    }
+
+    void RasterizeReference(ezDynamicArray<TestCluster>& ref_clusters)
+    {
+      ref_clusters.SetCountUninitialized(NUM_CLUSTERS);
+      ezMemoryUtils::ZeroFill(ref_clusters.GetData(), NUM_CLUSTERS);
+
+      for (ezUInt32 i = 0; i < m_Items.GetCount(); ++i)
+      {
+        const TestItem& item = m_Items[i];
+        switch (item.m_Type)
+        {
+          case ezClusteredDataShape::Sphere:
+            RasterizeSphere(item.m_Sphere, i, m_ViewMatrix, m_ProjectionMatrix, ref_clusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            break;
+          case ezClusteredDataShape::SpotLight:
+            RasterizeSpotLight(item.m_Cone, i, m_ViewMatrix, m_ProjectionMatrix, ref_clusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            break;
+          case ezClusteredDataShape::Box:
+            RasterizeBox(item.m_Transform, i, m_ViewProjectionMatrix, ref_clusters.GetData(), m_ClusterBoundingSpheres.GetData());
+            break;
+          case ezClusteredDataShape::All:
+            RasterizeDirLight(nullptr, i, ref_clusters.GetArrayPtr());
+            break;
+        }
+      }
+    }
+
+    void RasterizeBatched(ezDynamicArray<TestCluster>& ref_clusters)
+    {
+      ref_clusters.SetCountUninitialized(NUM_CLUSTERS);
+
+      ezTaskSystem::ParallelForIndexed(0u, static_cast<ezUInt32>(NUM_CLUSTERS_Z), [&](ezUInt32 uiStartSlice, ezUInt32 uiEndSlice)
+        {
+          ezMemoryUtils::ZeroFill(ref_clusters.GetData() + uiStartSlice * NUM_CLUSTERS_XY, (uiEndSlice - uiStartSlice) * NUM_CLUSTERS_XY);
+          RasterizeShapes(m_Shapes.GetArrayPtr(), uiStartSlice, uiEndSlice, ref_clusters.GetData(), m_ClusterBoundingSpheres.GetData(), m_ClusterBoundingSphereGroups.GetData()); });
+    }
+
+    ezCamera m_Camera;
+    ezSimdMat4f m_ViewMatrix;
+    ezSimdMat4f m_ProjectionMatrix;
+    ezSimdMat4f m_ViewProjectionMatrix;
+
+    ezDynamicArray<ezSimdBSphere, ezAlignedAllocatorWrapper> m_ClusterBoundingSpheres;
+    ezDynamicArray<ezClusterBoundingSphereGroup, ezAlignedAllocatorWrapper> m_ClusterBoundingSphereGroups;
+
+    ezDynamicArray<TestItem, ezAlignedAllocatorWrapper> m_Items;
+    ezDynamicArray<ezClusteredDataShape, ezAlignedAllocatorWrapper> m_Shapes;
+  };
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Lights, ClusteredData)
+{
+  ClusterTestSetup setup;
+  ezDynamicArray<TestCluster> referenceClusters;
+  ezDynamicArray<TestCluster> batchedClusters;
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Batched rasterization matches reference")
+  {
+    for (ezUInt32 uiNumItems : {1u, 100u, 1000u})
+    {
+      setup.CreateItems(uiNumItems);
+      setup.RasterizeReference(referenceClusters);
+      setup.RasterizeBatched(batchedClusters);
+
+      ezUInt32 uiNumSetBits = 0;
+      for (const TestCluster& cluster : referenceClusters)
+      {
+        for (ezUInt32 uiMask : cluster.m_BitMask)
+        {
+          uiNumSetBits += ezMath::CountBits(uiMask);
+        }
+      }
+
+      EZ_TEST_BOOL(uiNumSetBits > 0);
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(referenceClusters.GetData(), batchedClusters.GetData(), NUM_CLUSTERS));
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Performance")
+  {
+    constexpr ezUInt32 uiNumIterations = 5;
+
+    for (ezUInt32 uiNumItems : {100u, 1000u, 4000u})
+    {
+      setup.CreateItems(uiNumItems);
+
+      ezStopwatch sw;
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        setup.RasterizeReference(referenceClusters);
+      }
+      const ezTime tReference = sw.Checkpoint() / uiNumIterations;
+
+      for (ezUInt32 i = 0; i < uiNumIterations; ++i)
+      {
+        setup.RasterizeBatched(batchedClusters);
+      }
+      const ezTime tBatched = sw.Checkpoint() / uiNumIterations;
+
+      EZ_TEST_BOOL(ezMemoryUtils::IsEqual(referenceClusters.GetData(), batchedClusters.GetData(), NUM_CLUSTERS));
+
+      ezTestFramework::Output(ezTestOutput::Duration, "Clustering %u items: one by one %.3fms, batched %.3fms", uiNumItems, tReference.GetMilliseconds(), tBatched.GetMilliseconds());
+    }
+  }
+}
@@ -0,0 +1,398 @@
+#include <RendererTest/RendererTestPCH.h>
+
+#include <Foundation/Math/Random.h>
+#include <RendererCore/Lights/Implementation/ShadowMapCache.h>
+
+namespace
+{
+  bool Overlaps(const ezRectU32& a, const ezRectU32& b)
+  {
+    return a.x < b.x + b.width && b.x < a.x + a.width && a.y < b.y + b.height && b.y < a.y + a.height;
+  }
+
+  void CheckAllocations(const ezShadowAtlasAllocator& allocator, const ezDynamicArray<ezUInt32>& cells)
+  {
+    ezUInt64 uiArea = 0;
+    for (ezUInt32 a = 0; a < cells.GetCount(); ++a)
+    {
+      const ezRectU32 rectA = allocator.GetRect(cells[a]);
+      EZ_TEST_BOOL(rectA.x + rectA.width <= allocator.GetAtlasSize() && rectA.y + rectA.height <= allocator.GetAtlasSize());
+      uiArea += ezUInt64(rectA.width) * rectA.height;
+
+      for (ezUInt32 b = a + 1; b < cells.GetCount(); ++b)
+      {
+        EZ_TEST_BOOL(!Overlaps(rectA, allocator.GetRect(cells[b])));
+      }
+    }
+
+    EZ_TEST_INT(allocator.GetNumAllocations(), cells.GetCount());
+    EZ_TEST_INT(allocator.GetAllocatedArea(), uiArea);
+  }
+
+  ezShadowMapCache::Request MakeRequest(ezUInt64 uiKey, ezUInt32 uiNumViews, ezUInt32 uiShadowMapSize, float fScreenSpaceSize)
+  {
+    ezShadowMapCache::Request request;
+    request.m_uiKey = uiKey;
+    request.m_uiNumViews = uiNumViews;
+    request.m_uiShadowMapSize = uiShadowMapSize;
+    request.m_fScreenSpaceSize = fScreenSpaceSize;
+    request.m_uiCameraHash = uiKey * 31;
+    request.m_uiStaticCasterHash = uiKey * 17;
+    return request;
+  }
+} // namespace
+
+EZ_CREATE_SIMPLE_TEST(Lights, ShadowMapCache)
+{
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Atlas allocator")
+  {
+    ezShadowAtlasAllocator allocator;
+    allocator.Initialize(1024, 64);
+
+    ezDynamicArray<ezUInt32> cells;
+
+    // 2 x 512 + 4 x 256 + 16 x 128 fill the atlas exactly
+    cells.PushBack(allocator.Allocate(512));
+    cells.PushBack(allocator.Allocate(512));
+    for (ezUInt32 i = 0; i < 4; ++i)
+    {
+      cells.PushBack(allocator.Allocate(256));
+    }
+    for (ezUInt32 i = 0; i < 16; ++i)
+    {
+      cells.PushBack(allocator.Allocate(128));
+    }
+
+    EZ_TEST_BOOL(!cells.Contains(ezInvalidIndex));
+    EZ_TEST_INT(allocator.GetAllocatedArea(), 1024 * 1024);
+    EZ_TEST_INT(allocator.Allocate(64), ezInvalidIndex);
+    CheckAllocations(allocator, cells);
+
+    // freeing everything merges the cells again, so the whole atlas can be allocated at once
+    for (ezUInt32 uiCell : cells)
+    {
+      allocator.Free(uiCell);
+    }
+    cells.Clear();
+
+    EZ_TEST_INT(allocator.GetAllocatedArea(), 0);
+
+    const ezUInt32 uiWholeAtlas = allocator.Allocate(1024);
+    EZ_TEST_BOOL(uiWholeAtlas != ezInvalidIndex);
+    EZ_TEST_BOOL(allocator.GetRect(uiWholeAtlas) == ezRectU32(0, 0, 1024, 1024));
+    allocator.Free(uiWholeAtlas);
+
+    // random allocations and frees
+    ezRandom rnd;
+    rnd.Initialize(42);
+
+    for (ezUInt32 uiIteration = 0; uiIteration < 2000; ++uiIteration)
+    {
+      if (!cells.IsEmpty() && rnd.UIntInRange(3) == 0)
+      {
+        const ezUInt32 uiIndex = rnd.UIntInRange(cells.GetCount());
+        allocator.Free(cells[uiIndex]);
+        cells.RemoveAtAndSwap(uiIndex);
+      }
+      else
+      {
+        const ezUInt32 uiCell = allocator.Allocate(64u << rnd.UIntInRange(4));
+        if (uiCell != ezInvalidIndex)
+        {
+          cells.PushBack(uiCell);
+        }
+      }
+
+      if (uiIteration % 100 == 0)
+      {
+        CheckAllocations(allocator, cells);
+      }
+    }
+
+    CheckAllocations(allocator, cells);
+
+    for (ezUInt32 uiCell : cells)
+    {
+      allocator.Free(uiCell);
+    }
+
+    EZ_TEST_INT(allocator.GetNumAllocations(), 0);
+    EZ_TEST_BOOL(allocator.Allocate(1024) != ezInvalidIndex);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Invalidation")
+  {
+    ezShadowMapCache cache;
+
+    ezUInt64 uiFrame = 0;
+    auto Update = [&](const ezShadowMapCache::Request& request)
+    {
+      cache.BeginFrame(++uiFrame);
+      ezShadowMapCache::Result result = cache.Update(request);
+      cache.EndFrame();
+      return result;
+    };
+
+    ezShadowMapCache::Request request = MakeRequest(1, 6, 512, 1.0f);
+
+    ezShadowMapCache::Result result = Update(request);
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::NewAllocation);
+    EZ_TEST_INT(cache.GetEntry(result.m_uiEntryIndex).m_AtlasCells.GetCount(), 6);
+    EZ_TEST_INT(cache.GetAtlasRect(result.m_uiEntryIndex, 0).width, 512);
+
+    const ezRectU32 firstRect = cache.GetAtlasRect(result.m_uiEntryIndex, 0);
+
+    // nothing changed
+    result = Update(request);
+    EZ_TEST_BOOL(!result.m_bRender);
+    EZ_TEST_INT(cache.GetStats().m_uiNumCachedViews, 6);
+    EZ_TEST_BOOL(cache.GetAtlasRect(result.m_uiEntryIndex, 0) == firstRect);
+
+    request.m_uiStaticCasterHash++;
+    result = Update(request);
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::StaticCastersChanged);
+    EZ_TEST_BOOL(cache.GetAtlasRect(result.m_uiEntryIndex, 0) == firstRect);
+
+    request.m_uiCameraHash++;
+    result = Update(request);
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::LightChanged);
+
+    EZ_TEST_BOOL(!Update(request).m_bRender);
+
+    // dynamic casters refresh the shadow map every frame
+    request.m_bHasDynamicCasters = true;
+    for (ezUInt32 i = 0; i < 3; ++i)
+    {
+      result = Update(request);
+      EZ_TEST_BOOL(result.m_bRender);
+      EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::DynamicCasters);
+    }
+    request.m_bHasDynamicCasters = false;
+
+    EZ_TEST_BOOL(!Update(request).m_bRender);
+
+    cache.InvalidateAll();
+    EZ_TEST_BOOL(Update(request).m_Reason == ezShadowMapCache::UpdateReason::NewAllocation);
+
+    ezShadowMapCache::Settings settings = cache.GetSettings();
+    settings.m_bEnableCaching = false;
+    cache.SetSettings(settings);
+    EZ_TEST_BOOL(Update(request).m_Reason == ezShadowMapCache::UpdateReason::CachingDisabled);
+
+    settings.m_bEnableCaching = true;
+    cache.SetSettings(settings);
+    EZ_TEST_BOOL(!Update(request).m_bRender);
+
+    // a larger size requested by another reference view is applied in the next frame
+    cache.RequestShadowMapSizeForNextFrame(result.m_uiEntryIndex, 1024);
+    result = Update(request);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::NewAllocation);
+    EZ_TEST_INT(cache.GetEntry(result.m_uiEntryIndex).m_uiShadowMapSize, 1024);
+
+    // and the entry shrinks again once no view requests it anymore
+    result = Update(request);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::NewAllocation);
+    EZ_TEST_INT(cache.GetEntry(result.m_uiEntryIndex).m_uiShadowMapSize, 512);
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Eviction")
+  {
+    ezShadowMapCache::Settings settings;
+    settings.m_uiAtlasSize = 1024;
+    settings.m_uiFramesToKeepUnused = 5;
+
+    ezShadowMapCache cache;
+    cache.Initialize(settings);
+
+    // four lights fill the atlas
+    cache.BeginFrame(1);
+    for (ezUInt64 uiKey = 0; uiKey < 4; ++uiKey)
+    {
+      EZ_TEST_BOOL(cache.Update(MakeRequest(uiKey, 1, 512, 1.0f)).m_bRender);
+    }
+    cache.EndFrame();
+    EZ_TEST_INT(cache.GetAllocator().GetAllocatedArea(), 1024 * 1024);
+
+    // a new light takes the space of the least recently used one
+    cache.BeginFrame(2);
+    for (ezUInt64 uiKey = 1; uiKey < 4; ++uiKey)
+    {
+      EZ_TEST_BOOL(!cache.Update(MakeRequest(uiKey, 1, 512, 1.0f)).m_bRender);
+    }
+    ezShadowMapCache::Result result = cache.Update(MakeRequest(4, 1, 512, 1.0f));
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_INT(cache.GetEntry(result.m_uiEntryIndex).m_uiShadowMapSize, 512);
+
+    // if all lights are in use, the new one gets a smaller shadow map
+    result = cache.Update(MakeRequest(5, 1, 512, 1.0f));
+    EZ_TEST_BOOL(!result.m_bRender);
+    EZ_TEST_INT(cache.GetStats().m_uiNumViewsWithoutSpace, 1);
+    cache.EndFrame();
+
+    cache.BeginFrame(3);
+    cache.Update(MakeRequest(1, 1, 512, 1.0f));
+    cache.EndFrame();
+
+    // entries that are not requested anymore release their cells after a while
+    cache.BeginFrame(10);
+    cache.EndFrame();
+    EZ_TEST_INT(cache.GetAllocator().GetNumAllocations(), 0);
+
+    cache.BeginFrame(11);
+    result = cache.Update(MakeRequest(1, 1, 512, 1.0f));
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_BOOL(result.m_Reason == ezShadowMapCache::UpdateReason::NewAllocation);
+    cache.EndFrame();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Degrade when full")
+  {
+    ezShadowMapCache::Settings settings;
+    settings.m_uiAtlasSize = 1024;
+    settings.m_uiMinShadowMapSize = 256;
+
+    ezShadowMapCache cache;
+    cache.Initialize(settings);
+
+    cache.BeginFrame(1);
+    EZ_TEST_INT(cache.Update(MakeRequest(0, 3, 512, 1.0f)).m_uiEntryIndex, 0);
+
+    // only one 512 cell is left, so the point light falls back to 256
+    ezShadowMapCache::Result result = cache.Update(MakeRequest(1, 4, 512, 1.0f));
+    EZ_TEST_BOOL(result.m_bRender);
+    EZ_TEST_INT(cache.GetEntry(result.m_uiEntryIndex).m_uiShadowMapSize, 256);
+
+    result = cache.Update(MakeRequest(2, 1, 256, 1.0f));
+    EZ_TEST_BOOL(!result.m_bRender);
+    EZ_TEST_BOOL(cache.GetAtlasRect(result.m_uiEntryIndex, 0) == ezRectU32(0, 0, 0, 0));
+    cache.EndFrame();
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Time slicing")
+  {
+    ezShadowMapCache::Settings settings;
+    settings.m_uiTimeSlicedViewsPerFrame = 8;
+    settings.m_fTimeSliceScreenSpaceSize = 0.25f;
+    settings.m_uiMaxFramesStale = 6;
+
+    ezShadowMapCache cache;
+    cache.Initialize(settings);
+
+    // 4 large and 40 small spot lights, all with moving casters
+    constexpr ezUInt32 uiNumLights = 44;
+    ezUInt64 lastRendered[uiNumLights] = {};
+
+    for (ezUInt64 uiFrame = 1; uiFrame <= 60; ++uiFrame)
+    {
+      cache.BeginFrame(uiFrame);
+
+      ezUInt32 uiNumRenderedSmall = 0;
+      for (ezUInt32 i = 0; i < uiNumLights; ++i)
+      {
+        ezShadowMapCache::Request request = MakeRequest(i, 1, 128, i < 4 ? 1.0f : 0.1f);
+        request.m_bHasDynamicCasters = true;
+
+        const ezShadowMapCache::Result result = cache.Update(request);
+        if (result.m_bRender)
+        {
+          lastRendered[i] = uiFrame;
+
+          if (i >= 4 && result.m_Reason != ezShadowMapCache::UpdateReason::NewAllocation)
+          {
+            ++uiNumRenderedSmall;
+          }
+        }
+
+        // large lights are always up to date, small ones are never older than the limit
+        if (i < 4)
+        {
+          EZ_TEST_INT(lastRendered[i], uiFrame);
+        }
+        else
+        {
+          EZ_TEST_BOOL(uiFrame - lastRendered[i] < settings.m_uiMaxFramesStale);
+        }
+      }
+
+      if (uiFrame > 1)
+      {
+        // besides the stale lights that are forced, only the budget is rendered
+        EZ_TEST_BOOL(uiNumRenderedSmall >= settings.m_uiTimeSlicedViewsPerFrame);
+        EZ_TEST_BOOL(cache.GetStats().m_uiNumTimeSlicedViews <= settings.m_uiTimeSlicedViewsPerFrame);
+        EZ_TEST_INT(cache.GetStats().m_uiNumRenderedViews + cache.GetStats().m_uiNumDeferredViews, uiNumLights);
+      }
+
+      cache.EndFrame();
+    }
+  }
+
+  EZ_TEST_BLOCK(ezTestBlock::Enabled, "Scene stats")
+  {
+    // A typical scene: mostly static lights, a few of them see moving objects, the camera moves every now and then.
+    ezRandom rnd;
+    rnd.Initialize(7);
+
+    constexpr ezUInt32 uiNumSpotLights = 60;
+    constexpr ezUInt32 uiNumPointLights = 20;
+    constexpr ezUInt32 uiNumFrames = 100;
+
+    float screenSpaceSizes[uiNumSpotLights + uiNumPointLights];
+    for (float& fSize : screenSpaceSizes)
+    {
+      fSize = rnd.FloatMinMax(0.05f, 1.0f);
+    }
+
+    for (bool bCaching : {false, true})
+    {
+      ezShadowMapCache::Settings settings;
+      settings.m_bEnableCaching = bCaching;
+
+      ezShadowMapCache cache;
+      cache.Initialize(settings);
+
+      ezUInt32 uiTotalViews = 0;
+      ezUInt32 uiRenderedViews = 0;
+
+      for (ezUInt64 uiFrame = 1; uiFrame <= uiNumFrames; ++uiFrame)
+      {
+        cache.BeginFrame(uiFrame);
+
+        for (ezUInt32 i = 0; i < EZ_ARRAY_SIZE(screenSpaceSizes); ++i)
+        {
+          const bool bPointLight = i >= uiNumSpotLights;
+          ezShadowMapCache::Request request = MakeRequest(i, bPointLight ? 6 : 1, 256, screenSpaceSizes[i]);
+          request.m_bHasDynamicCasters = (i % 10) == 0;
+
+          // a static object is moved every 20 frames
+          if (i == (uiFrame / 20) % EZ_ARRAY_SIZE(screenSpaceSizes))
+          {
+            request.m_uiStaticCasterHash += uiFrame / 20;
+          }
+
+          cache.Update(request);
+        }
+
+        EZ_TEST_INT(cache.GetStats().m_uiNumViewsWithoutSpace, 0);
+
+        uiTotalViews += cache.GetStats().m_uiNumViews;
+        uiRenderedViews += cache.GetStats().m_uiNumRenderedViews;
+
+        cache.EndFrame();
+      }
+
+      if (bCaching)
+      {
+        EZ_TEST_BOOL(uiRenderedViews * 4 < uiTotalViews);
+      }
+      else
+      {
+        EZ_TEST_INT(uiRenderedViews, uiTotalViews);
+      }
+
+      ezTestFramework::Output(ezTestOutput::Details, "Shadow views per frame with caching %s: %.1f of %.1f rendered", bCaching ? "enabled" : "disabled", float(uiRenderedViews) / uiNumFrames, float(uiTotalViews) / uiNumFrames);
+    }
+  }
+}
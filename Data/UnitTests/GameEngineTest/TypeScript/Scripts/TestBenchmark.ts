@@ -0,0 +1,54 @@
+import ez = require("TypeScript/ez")
+
+export class TestBenchmark extends ez.TickedTypescriptComponent {
+
+    /* BEGIN AUTO-GENERATED: VARIABLES */
+    /* END AUTO-GENERATED: VARIABLES */
+
+    constructor() {
+        super()
+    }
+
+    static RegisterMessageHandlers() {
+
+        ez.TypescriptComponent.RegisterMessageHandler(ez.MsgSetFloatParameter, "OnMsgSetFloatParameter");
+        ez.TypescriptComponent.RegisterMessageHandler(ez.MsgGenericEvent, "OnMsgGenericEvent");
+    }
+
+    ticks: number = 0;
+    received: number = 0;
+    msg: ez.MsgSetFloatParameter = new ez.MsgSetFloatParameter();
+
+    OnSimulationStarted(): void {
+        this.SetTickInterval(ez.Time.Milliseconds(0));
+        this.msg.Name = "Benchmark";
+    }
+
+    OnMsgSetFloatParameter(msg: ez.MsgSetFloatParameter): void {
+        this.received += msg.Value;
+    }
+
+    OnMsgGenericEvent(msg: ez.MsgGenericEvent): void {
+
+        if (msg.Message == "GetTicks") {
+            msg.Value = this.ticks;
+        }
+        else if (msg.Message == "GetReceived") {
+            msg.Value = this.received;
+        }
+    }
+
+    Tick(): void {
+        this.ticks += 1;
+
+        // every message goes through the native marshaling twice, once into C++ and once back into the handler
+        for (let i = 0; i < 4; ++i) {
+            this.msg.Value = 1;
+            this.SendMessage(this.msg);
+        }
+
+        let pos = this.GetOwner().GetLocalPosition();
+        pos.z = this.ticks * 0.01;
+        this.GetOwner().SetLocalPosition(pos);
+    }
+}